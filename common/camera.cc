@@ -29,6 +29,10 @@
 
 #include <openastro/demosaic.h>
 
+extern "C" {
+#include <openastro/video.h>
+}
+
 #include "captureSettings.h"
 #include "fitsSettings.h"
 #include "demosaicSettings.h"
@@ -293,7 +297,10 @@ Camera::getTemperature ( void )
   if ( !cameraControls( OA_CAM_CTRL_TEMPERATURE )) {
     return -273.15;
   }
-  cameraFuncs.readControl ( cameraContext, OA_CAM_CTRL_TEMPERATURE, &v );
+  if ( oaReadCachedControl ( cameraContext, OA_CAM_CTRL_TEMPERATURE, &v ) !=
+      OA_ERR_NONE ) {
+    cameraFuncs.readControl ( cameraContext, OA_CAM_CTRL_TEMPERATURE, &v );
+  }
   float tempReading = v.int32;
   tempReading /= 10;
   return tempReading;
@@ -455,6 +462,19 @@ Camera::initialise ( oaCameraDevice* device, const char* appName,
 
   if (( cameraContext = device->initCamera ( device ))) {
     initialised = 1;
+    // Cameras that can't bin in hardware have it done in software
+    ( void ) oaEnableSoftwareBinning ( cameraContext, OA_BIN_AVERAGE );
+    // Status values the UI polls are refreshed in the background instead
+    if ( cameraControls ( OA_CAM_CTRL_TEMPERATURE )) {
+      ( void ) oaCacheControl ( cameraContext, OA_CAM_CTRL_TEMPERATURE, 1000 );
+    }
+    if ( cameraControls ( OA_CAM_CTRL_DROPPED )) {
+      ( void ) oaCacheControl ( cameraContext, OA_CAM_CTRL_DROPPED, 1000 );
+    }
+    if ( cameraControls ( OA_CAM_CTRL_BATTERY_LEVEL )) {
+      ( void ) oaCacheControl ( cameraContext, OA_CAM_CTRL_BATTERY_LEVEL,
+          5000 );
+    }
     return 0;
   }
   return -1;
@@ -486,6 +506,37 @@ Camera::setControl ( int control, int64_t value )
 }
 
 
+static void
+_asyncControlDone ( void* arg, oaControlRequest* request, int control,
+    oaControlValue* value, int result )
+{
+  if ( result != OA_ERR_NONE ) {
+    qWarning() << "error" << result << "trying to set control" << control;
+  }
+  oaReleaseControlRequest ( request );
+}
+
+
+// Returns as soon as the change is queued.  Changes made faster than the
+// camera can take them are merged, so this suits controls driven by
+// sliders
+
+int
+Camera::setControlAsync ( int control, int64_t value )
+{
+  oaControlValue v;
+
+  if ( !initialised ) {
+    qWarning() << __func__ << " called with camera uninitialised";
+    return -1;
+  }
+
+  populateControlValue ( &v, control, value );
+  return oaSetControlAsync ( cameraContext, control, &v, _asyncControlDone,
+      0 ) ? 0 : -1;
+}
+
+
 int64_t
 Camera::readControl ( int control )
 {
@@ -505,6 +556,50 @@ Camera::readControl ( int control )
 }
 
 
+// Returns the last value the background refresh saw without going near
+// the camera, falling back to a normal read for controls not cached
+
+int64_t
+Camera::readCachedControl ( int control )
+{
+  oaControlValue v;
+
+  if ( !initialised ) {
+    qWarning() << __func__ << " called with camera uninitialised";
+    return 0;
+  }
+
+  if ( oaReadCachedControl ( cameraContext, control, &v ) == OA_ERR_NONE ) {
+    return unpackControlValue ( &v );
+  }
+  return readControl ( control );
+}
+
+
+int
+Camera::getStats ( oaCameraStats* stats )
+{
+  if ( !initialised ) {
+    qWarning() << __func__ << " called with camera uninitialised";
+    return -OA_ERR_INVALID_CAMERA;
+  }
+
+  return oaGetCameraStats ( cameraContext, stats );
+}
+
+
+void
+Camera::resetStats ( void )
+{
+  if ( !initialised ) {
+    qWarning() << __func__ << " called with camera uninitialised";
+    return;
+  }
+
+  oaResetCameraStats ( cameraContext );
+}
+
+
 int
 Camera::setResolution ( int x, int y )
 {
@@ -93,7 +93,11 @@ class Camera : public QObject
 				int64_t );
     int64_t		unpackControlValue ( oaControlValue* );
     int			setControl ( int, int64_t );
+    int			setControlAsync ( int, int64_t );
     int64_t		readControl ( int );
+    int64_t		readCachedControl ( int );
+    int			getStats ( oaCameraStats* );
+    void		resetStats ( void );
     int			getAWBManualSetting ( void );
     int			setResolution ( int, int );
     int			setROI ( int, int );
@@ -81,6 +81,10 @@ GeneralSettings::GeneralSettings ( QWidget* parent, QString appName,
       "Write capture settings to file" ));
   saveCaptureSettings->setChecked ( generalConf.saveCaptureSettings );
 
+  saveCameraStats = new QCheckBox ( tr (
+      "Write camera statistics to file" ));
+  saveCameraStats->setChecked ( generalConf.saveCameraStats );
+
   connectSole = new QCheckBox ( tr (
       "Connect single camera on startup" ));
   connectSole->setChecked ( generalConf.connectSoleCamera );
@@ -111,6 +115,19 @@ GeneralSettings::GeneralSettings ( QWidget* parent, QString appName,
     fpsbox->addWidget ( fpsLabel );
     fpsbox->addWidget ( fpsCountLabel );
     fpsbox->addWidget ( fpsSlider );
+
+    // Item indexes follow the OA_STRETCH_* values
+    stretchLabel = new QLabel ( tr ( "Preview stretch" ), this );
+    stretchMenu = new QComboBox ( this );
+    stretchMenu->addItem ( tr ( "Linear" ));
+    stretchMenu->addItem ( tr ( "Asinh" ));
+    stretchMenu->addItem ( tr ( "Auto" ));
+    stretchMenu->setCurrentIndex ( generalConf.displayStretch );
+
+    stretchbox = new QHBoxLayout();
+    stretchbox->addWidget ( stretchLabel );
+    stretchbox->addWidget ( stretchMenu );
+    stretchbox->addStretch ( 1 );
   }
 
   box = new QVBoxLayout ( this );
@@ -133,6 +150,7 @@ GeneralSettings::GeneralSettings ( QWidget* parent, QString appName,
   rightBox->addWidget ( degFButton );
   rightBox->addSpacing ( 15 );
   rightBox->addWidget ( saveCaptureSettings );
+  rightBox->addWidget ( saveCameraStats );
   rightBox->addSpacing ( 15 );
   rightBox->addWidget ( connectSole );
 	if ( splitControls ) {
@@ -149,6 +167,7 @@ GeneralSettings::GeneralSettings ( QWidget* parent, QString appName,
   box->addLayout ( topBox );
 	if ( fpsControls ) {
     box->addLayout ( fpsbox );
+    box->addLayout ( stretchbox );
 	}
   box->addStretch ( 1 );
   setLayout ( box );
@@ -161,6 +180,8 @@ GeneralSettings::GeneralSettings ( QWidget* parent, QString appName,
       SLOT ( dataChanged()));
   connect ( saveCaptureSettings, SIGNAL ( stateChanged ( int )), parentWidget,
       SLOT ( dataChanged()));
+  connect ( saveCameraStats, SIGNAL ( stateChanged ( int )), parentWidget,
+      SLOT ( dataChanged()));
   connect ( connectSole, SIGNAL ( stateChanged ( int )), parentWidget,
       SLOT ( dataChanged()));
 	if ( splitControls ) {
@@ -176,6 +197,8 @@ GeneralSettings::GeneralSettings ( QWidget* parent, QString appName,
         SLOT ( dataChanged()));
     connect ( fpsSlider, SIGNAL ( valueChanged ( int )), this,
         SLOT ( updateFPSLabel ( int )));
+    connect ( stretchMenu, SIGNAL ( currentIndexChanged ( int )),
+        parentWidget, SLOT ( dataChanged()));
 	}
 	  connect ( recentreButton, SIGNAL ( clicked()), commonState.viewerWidget,
       SLOT ( recentreReticle()));
@@ -210,11 +233,14 @@ GeneralSettings::storeSettings ( void )
   generalConf.tempsInC = degCButton->isChecked();
   trampolines->resetTemperatureLabel();
   generalConf.saveCaptureSettings = saveCaptureSettings->isChecked() ? 1 : 0;
+  generalConf.saveCameraStats = saveCameraStats->isChecked() ? 1 : 0;
   generalConf.connectSoleCamera = connectSole->isChecked() ? 1 : 0;
 
 	if ( fpsControls ) {
     generalConf.displayFPS = fpsSlider->value();
     trampolines->setDisplayFPS ( generalConf.displayFPS );
+    generalConf.displayStretch = stretchMenu->currentIndex();
+    trampolines->setDisplayStretch ( generalConf.displayStretch );
 	}
   if ( splitControls ) {
     generalConf.dockableControls = dockable->isChecked() ? 1 : 0;
@@ -44,6 +44,7 @@ typedef struct {
 	int				saveSettings;
 	int				tempsInC;
 	int				saveCaptureSettings;
+	int				saveCameraStats;
 	int				connectSoleCamera;
 	// window layout
 	int				dockableControls;
@@ -51,6 +52,7 @@ typedef struct {
 	int				separateControls;
 	// display config
 	int				displayFPS;
+	int				displayStretch;
 	// reticle config
 	int				reticleStyle;
 } generalConfig;
@@ -74,6 +76,7 @@ class GeneralSettings : public QWidget
   private:
     QCheckBox*		saveBox;
     QCheckBox*		saveCaptureSettings;
+    QCheckBox*		saveCameraStats;
     QCheckBox*		connectSole;
     QCheckBox*		dockable;
     QCheckBox*		controlPosn;
@@ -94,6 +97,9 @@ class GeneralSettings : public QWidget
     QLabel*		fpsLabel;
     QLabel*		fpsCountLabel;
     QSlider*		fpsSlider;
+    QHBoxLayout*	stretchbox;
+    QLabel*		stretchLabel;
+    QComboBox*		stretchMenu;
     QPushButton*	recentreButton;
     QPushButton*	derotateButton;
 		QString				applicationName;
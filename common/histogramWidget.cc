@@ -31,6 +31,7 @@
 
 extern "C" {
 #include <openastro/camera.h>
+#include <openastro/imgproc.h>
 }
 
 #include "histogramWidget.h"
@@ -55,6 +56,7 @@ int		HistogramWidget::blue[256];
 int*	HistogramWidget::grey;
 int		HistogramWidget::histogramMin;
 int		HistogramWidget::histogramMax;
+oaFrameStats*	HistogramWidget::frameStats = 0;
 
 
 HistogramWidget::HistogramWidget ( const char* appName, QWidget* parent ) :
@@ -91,23 +93,102 @@ HistogramWidget::sizeHint() const
 	return size;
 }
 
+// About 40000 samples is plenty for a 256-bin histogram
+
+unsigned int
+HistogramWidget::statsSubsample ( unsigned int width, unsigned int height )
+{
+  unsigned int	subsample = 1;
+
+  while (( width / subsample ) * ( height / subsample ) > 40000 ) {
+    subsample++;
+  }
+  return subsample;
+}
+
+
+// Flags for oaFrameStatsCompute() that give the histogram it needs
+
+int
+HistogramWidget::statsFlags ( void )
+{
+  return histogramConf.rawRGBHistogram ? OA_STATS_SPLIT_CFA : 0;
+}
+
+
 void
 HistogramWidget::process ( void* imageData, unsigned int width,
     unsigned int height, unsigned int length, int format )
 {
-  fullIntensity = 0xff;
-  minIntensity = 0xffff;
+  oaImage	image;
+  unsigned int	subsample;
+
+  if ( !frameStats && !( frameStats = oaFrameStatsCreate())) {
+    qWarning() << __func__ << "can't allocate frame statistics";
+    return;
+  }
+
+  subsample = statsSubsample ( width, height );
+
+  // Formats the statistics code can't handle are treated as a run of
+  // 8-bit values
+  if ( oaFrameFormats[ format ].lumChrom || oaFrameFormats[ format ].packed ||
+      oaFrameFormats[ format ].planar || oaFrameFormats[ format ].hasAlpha ) {
+    format = OA_PIX_FMT_GREY8;
+    width = length;
+    height = 1;
+    subsample *= subsample;
+  }
+  if ( oaImageInit ( &image, imageData, width, height, format ) ||
+      oaFrameStatsCompute ( frameStats, &image, 256, subsample,
+      statsFlags())) {
+    return;
+  }
+
+  process ( frameStats );
+}
+
+
+/*
+ * Take the histogram from statistics already computed for the frame,
+ * which should have 256 bins
+ */
+
+void
+HistogramWidget::process ( const oaFrameStats* stats )
+{
+  int			maxCount = 1;
+  unsigned int	i;
+
   doneProcess = 1;
+  colours = stats->channels;
+  fullIntensity = stats->maxValue;
+  minIntensity = stats->all.min;
+  maxIntensity = stats->all.max;
+  maxRedIntensity = stats->channel[0].max;
+  if ( colours > 1 ) {
+    maxGreenIntensity = stats->channel[1].max;
+    maxBlueIntensity = stats->channel[2].max;
+  }
 
-  if ( OA_PIX_FMT_RGB24 == format || OA_PIX_FMT_BGR24 == format ) {
-    _processRGBHistogram ( imageData, width, height, length, format );
-  } else {
-    if ( oaFrameFormats[ format ].rawColour && histogramConf.rawRGBHistogram ) {
-      _processMosaicHistogram ( imageData, width, height, length, format );
-    } else {
-      _processGreyscaleHistogram ( imageData, width, height, length, format );
+  bzero ( red, sizeof( int ) * 256 );
+  bzero ( green, sizeof( int ) * 256 );
+  bzero ( blue, sizeof( int ) * 256 );
+  for ( i = 0; i < 256 && i < stats->bins; i++ ) {
+    red[i] = stats->channel[0].histogram[i];
+    maxCount = ( red[i] > maxCount ) ? red[i] : maxCount;
+    if ( colours > 1 ) {
+      green[i] = stats->channel[1].histogram[i];
+      blue[i] = stats->channel[2].histogram[i];
+      maxCount = ( green[i] > maxCount ) ? green[i] : maxCount;
+      maxCount = ( blue[i] > maxCount ) ? blue[i] : maxCount;
     }
   }
+  for ( i = 0; i < 256; i++ ) {
+    red[i] = red[i] * 100 / maxCount;
+    green[i] = green[i] * 100 / maxCount;
+    blue[i] = blue[i] * 100 / maxCount;
+  }
 
   if ( statsEnabled ) {
     histogramMin = minIntensity < histogramMin ? minIntensity : histogramMin;
@@ -250,258 +331,3 @@ HistogramWidget::stopStats ( void )
 {
   statsEnabled = 0;
 }
-
-
-void
-HistogramWidget::_processGreyscaleHistogram ( void* imageData,
-    unsigned int width __attribute((unused)),
-		unsigned int height __attribute((unused)), unsigned int length,
-		int format )
-{
-  int maxCount = 1;
-  int intensity, step;
-  unsigned int i;
-
-  colours = 1;
-  step = length / 10000;
-  if ( step < 1 ) {
-    step = 1;
-  }
-
-  maxIntensity = 0;
-  bzero ( grey, sizeof( int ) * 256 );
-
-  if ( 2 == oaFrameFormats[ format ].bytesPerPixel ) {
-    step *= 2;
-    fullIntensity = 0xffff;
-    if ( oaFrameFormats[ format ].littleEndian ) {
-      int b1, b2;
-      for ( i = 0; i < length; i += step ) {
-        b1 = *( static_cast<uint8_t*>( imageData ) + i );
-        b2 = *( static_cast<uint8_t*>( imageData ) + i + 1 );
-        intensity = b1 + ( b2 << 8 );
-        maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-        minIntensity = intensity < minIntensity ? intensity : minIntensity;
-        grey[ b2 ]++;
-      }
-    } else {
-      int b1, b2;
-      for ( i = 0; i < length; i += step ) {
-        b1 = *( static_cast<uint8_t*>( imageData ) + i );
-        b2 = *( static_cast<uint8_t*>( imageData ) + i + 1 );
-        intensity = ( b1 << 8 ) + b2;
-        maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-        minIntensity = intensity < minIntensity ? intensity : minIntensity;
-        grey[ b1 ]++;
-      }
-    }
-  } else {
-    for ( i = 0; i < length; i += step ) {
-      intensity = *( static_cast<uint8_t*>( imageData ) + i );
-      maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-      minIntensity = intensity < minIntensity ? intensity : minIntensity;
-      grey[ intensity ]++;
-    }
-  }
-  for ( i = 0; i < 256; i++ ) {
-    maxCount = ( grey[i] > maxCount ) ? grey[i] : maxCount;
-  }
-  for ( i = 0; i < 256; i++ ) {
-    grey[i] = grey[i] * 100 / maxCount;
-  }
-}
-
-
-void
-HistogramWidget::_processRGBHistogram ( void* imageData,
-    unsigned int width __attribute((unused)),
-		unsigned int height __attribute((unused)), unsigned int length,
-		int format )
-{
-  int* swapRed = red;
-  int* swapBlue = blue;
-  int maxCount = 1;
-  int step;
-  unsigned int i;
-
-  colours = 3;
-  step = ( length / colours ) / 10000;
-  step *= colours;
-  if ( step < 1 ) {
-    step = 1;
-  }
-
-  if ( OA_PIX_FMT_BGR24 == format ) {
-    swapRed = blue;
-    swapBlue = red;
-  }
-
-  maxRedIntensity = 0;
-  maxGreenIntensity = 0;
-  maxBlueIntensity = 0;
-  bzero ( red, sizeof( int ) * 256 );
-  bzero ( green, sizeof( int ) * 256 );
-  bzero ( blue, sizeof( int ) * 256 );
-  int intensity;
-  for ( i = 0; i < length; i += step ) {
-    intensity = *( static_cast<uint8_t*>( imageData ) + i );
-    maxRedIntensity = intensity > maxRedIntensity ? intensity :
-        maxRedIntensity;
-    maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-    minIntensity = intensity < minIntensity ? intensity : minIntensity;
-    swapRed[ intensity ]++;
-
-    intensity = *( static_cast<uint8_t*>( imageData ) + i + 1 );
-    maxGreenIntensity = intensity > maxGreenIntensity ? intensity :
-        maxGreenIntensity;
-    maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-    minIntensity = intensity < minIntensity ? intensity : minIntensity;
-    green[ intensity ]++;
-
-    intensity = *( static_cast<uint8_t*>( imageData ) + i + 2 );
-    maxBlueIntensity = intensity > maxBlueIntensity ? intensity :
-        maxBlueIntensity;
-    maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-    minIntensity = intensity < minIntensity ? intensity : minIntensity;
-    swapBlue[ intensity ]++;
-  }
-  for ( i = 0; i < 256; i++ ) {
-    maxCount = ( red[i] > maxCount ) ? red[i] : maxCount;
-    maxCount = ( green[i] > maxCount ) ? green[i] : maxCount;
-    maxCount = ( blue[i] > maxCount ) ? blue[i] : maxCount;
-  }
-  for ( i = 0; i < 256; i++ ) {
-    red[i] = red[i] * 100 / maxCount;
-    green[i] = green[i] * 100 / maxCount;
-    blue[i] = blue[i] * 100 / maxCount;
-  }
-  if ( OA_PIX_FMT_BGR24 == format ) {
-    int s = maxBlueIntensity;
-    maxBlueIntensity = maxRedIntensity;
-    maxRedIntensity = s;
-  }
-}
-
-
-void
-HistogramWidget::_processMosaicHistogram ( void* imageData,
-    unsigned int width, unsigned int height __attribute((unused)),
-		unsigned int length, int format )
-{
-  unsigned int i, x, y, bytesPerLine, bytesPerPixel;
-  int maxCount = 1;
-  int step;
-  char colour;
-  const char* pattern = "    ";
-
-  bytesPerPixel = oaFrameFormats[ format ].bytesPerPixel;
-  bytesPerLine = width * bytesPerPixel;
-  colours = 3;
-  step = length / 10000;
-  if ( step < 1 ) {
-    step = 1;
-  }
-  // make sure step is odd, so we pick up all photosite colours
-  step &= 1;
-  // and step whole photosites
-  step *= bytesPerPixel;
-
-  maxRedIntensity = 0;
-  maxGreenIntensity = 0;
-  maxBlueIntensity = 0;
-  bzero ( red, sizeof( int ) * 256 );
-  bzero ( green, sizeof( int ) * 256 );
-  bzero ( blue, sizeof( int ) * 256 );
-
-  fullIntensity = ( 1 << oaFrameFormats[ format ].bitsPerPixel ) - 1;
-
-  int intensity = 0;
-  for ( i = 0; i < length; i += step ) {
-    x = ( i % bytesPerLine ) / bytesPerPixel;
-    y = i / bytesPerLine;
-    switch ( format ) {
-      case OA_PIX_FMT_BGGR8:
-      case OA_PIX_FMT_BGGR16LE:
-      case OA_PIX_FMT_BGGR16BE:
-        pattern = "BGGR";
-        break;
-
-      case OA_PIX_FMT_RGGB8:
-      case OA_PIX_FMT_RGGB16LE:
-      case OA_PIX_FMT_RGGB16BE:
-        pattern = "RGGB";
-        break;
-
-      case OA_PIX_FMT_GBRG8:
-      case OA_PIX_FMT_GBRG16LE:
-      case OA_PIX_FMT_GBRG16BE:
-        pattern = "GBRG";
-        break;
-
-      case OA_PIX_FMT_GRBG8:
-      case OA_PIX_FMT_GRBG16LE:
-      case OA_PIX_FMT_GRBG16BE:
-        pattern = "GRBG";
-        break;
-    }
-    colour = pattern[ 2 * ( y % 2 ) + ( x % 2 )];
-
-    if ( oaFrameFormats[ format ].bitsPerPixel == 16 ) {
-      if ( oaFrameFormats[ format ].littleEndian ) {
-        int b1, b2;
-        b1 = *( static_cast<uint8_t*>( imageData ) + i );
-        b2 = *( static_cast<uint8_t*>( imageData ) + i + 1 );
-        intensity = b1 + ( b2 << 8 );
-      } else {
-        int b1, b2;
-        b1 = *( static_cast<uint8_t*>( imageData ) + i );
-        b2 = *( static_cast<uint8_t*>( imageData ) + i + 1 );
-        intensity = ( b1 << 8 ) + b2;
-      }
-    } else {
-      if ( oaFrameFormats[ format ].bitsPerPixel == 8 ) {
-        intensity = *( static_cast<uint8_t*>( imageData ) + i );
-      } else {
-        qWarning() << __func__ << "can't handle bit depth" <<
-            oaFrameFormats[ format ].bitsPerPixel;
-      }
-    }
-
-    switch ( colour ) {
-      case 'R':
-        maxRedIntensity = intensity > maxRedIntensity ? intensity :
-            maxRedIntensity;
-        maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-        minIntensity = intensity < minIntensity ? intensity : minIntensity;
-        red[ intensity ]++;
-        break;
-
-      case 'G':
-        maxGreenIntensity = intensity > maxGreenIntensity ? intensity :
-            maxGreenIntensity;
-        maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-        minIntensity = intensity < minIntensity ? intensity : minIntensity;
-        green[ intensity ]++;
-        break;
-
-      case 'B':
-        maxBlueIntensity = intensity > maxBlueIntensity ? intensity :
-            maxBlueIntensity;
-        maxIntensity = intensity > maxIntensity ? intensity : maxIntensity;
-        minIntensity = intensity < minIntensity ? intensity : minIntensity;
-        blue[ intensity ]++;
-        break;
-    }
-  }
-
-  for ( i = 0; i < 256; i++ ) {
-    maxCount = ( red[i] > maxCount ) ? red[i] : maxCount;
-    maxCount = ( green[i] > maxCount ) ? green[i] : maxCount;
-    maxCount = ( blue[i] > maxCount ) ? blue[i] : maxCount;
-  }
-  for ( i = 0; i < 256; i++ ) {
-    red[i] = red[i] * 100 / maxCount;
-    green[i] = green[i] * 100 / maxCount;
-    blue[i] = blue[i] * 100 / maxCount;
-  }
-}
@@ -36,6 +36,10 @@
 #include <QtCore>
 #include <QtGui>
 
+extern "C" {
+#include <openastro/imgproc.h>
+}
+
 
 class HistogramWidget : public QWidget
 {
@@ -46,6 +50,9 @@ class HistogramWidget : public QWidget
     			~HistogramWidget();
     void		process ( void*, unsigned int, unsigned int,
 			    unsigned int, int );
+    void		process ( const oaFrameStats* );
+    static int		statsFlags ( void );
+    static unsigned int	statsSubsample ( unsigned int, unsigned int );
     void		updateLayout();
     void		resetStats();
     void		stopStats();
@@ -54,6 +61,8 @@ class HistogramWidget : public QWidget
     static int			histogramMin;
     static int			histogramMax;
     static int			fullIntensity;
+    // statistics computed by process() when it isn't handed them
+    static oaFrameStats*	frameStats;
 
   protected:
     void		paintEvent ( QPaintEvent* );
@@ -76,11 +85,4 @@ class HistogramWidget : public QWidget
     static int			statsEnabled;
 		int							windowSizeX;
 		int							windowSizeY;
-
-    void		_processRGBHistogram ( void*, unsigned int,
-			    unsigned int, unsigned int, int );
-    void		_processGreyscaleHistogram ( void*, unsigned int,
-			    unsigned int, unsigned int, int );
-    void		_processMosaicHistogram ( void*, unsigned int,
-			    unsigned int, unsigned int, int );
 };
@@ -64,6 +64,7 @@ OutputFITS::OutputFITS ( int x, int y, int n, int d, int fmt,
   firstByte = reinterpret_cast<uint8_t*>( &byteOrderTest );
 
   writesDiscreteFiles = 1;
+  usesFrameStats = 1;
   frameCount = 0;
   xSize = x;
   ySize = y;
@@ -602,6 +603,29 @@ OutputFITS::addFrame ( void* frame, const char* constTimestampStr,
 		fits_write_key_lng ( fptr, "FRAMESEQ", metadata->frameCounter, "",
 				&status );
 	}
+	if ( metadata && metadata->sequence ) {
+		fits_write_key_lng ( fptr, "OASEQNO", metadata->sequence,
+				"frame sequence number", &status );
+		fits_write_key_lng ( fptr, "OADROPS", metadata->droppedFrames,
+				"frames dropped since previous frame", &status );
+		fits_write_key_lng ( fptr, "OAMONOTS", metadata->timestamp,
+				"monotonic dequeue time, ns", &status );
+	}
+	if ( metadata && metadata->hwTimestampValid ) {
+		fits_write_key_lng ( fptr, "OAHWTS", metadata->hwTimestamp,
+				"camera timestamp", &status );
+	}
+
+	if ( frameStats ) {
+		fits_write_key_lng ( fptr, "DATAMIN", frameStats->all.min,
+				"minimum pixel value", &status );
+		fits_write_key_lng ( fptr, "DATAMAX", frameStats->all.max,
+				"maximum pixel value", &status );
+		fits_write_key_lng ( fptr, "OASATPIX", frameStats->all.saturated,
+				"saturated samples", &status );
+		// they only describe this frame
+		frameStats = 0;
+	}
 
 	if ( timerData ) {
 		if ( timerData->statusValid ) {
@@ -45,6 +45,9 @@ OutputHandler::OutputHandler ( int x, int y, int n, int d,
   Q_UNUSED( n );
   Q_UNUSED( d );
 
+  usesFrameStats = 0;
+  frameStats = 0;
+
 	if ( nameTemplate == "" ) {
 		filenameTemplate = commonConfig.fileNameTemplate.toStdString().c_str();
     generateFilename();
@@ -181,3 +184,15 @@ OutputHandler::getRecordingBasename ( void )
 {
   return filenameRoot;
 }
+
+
+/*
+ * Give the handler statistics computed from exactly the pixels that the
+ * next addFrame() will write, or 0 if there are none
+ */
+
+void
+OutputHandler::setFrameStats ( const oaFrameStats* stats )
+{
+  frameStats = stats;
+}
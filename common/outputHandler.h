@@ -38,6 +38,7 @@
 
 extern "C" {
 #include <openastro/camera.h>
+#include <openastro/imgproc.h>
 #include <openastro/timer.h>
 }
 
@@ -61,7 +62,9 @@ class OutputHandler
     QString		getNewFilename ( void );
     QString		getRecordingFilename ( void );
     QString		getRecordingBasename ( void );
+    void		setFrameStats ( const oaFrameStats* );
     int			writesDiscreteFiles;
+    int			usesFrameStats;
 
   protected:
     int			frameCount;
@@ -69,6 +72,8 @@ class OutputHandler
     QString		filenameRoot;
     void		generateFilename ( void );
 		trampolineFuncs*	trampolines;
+    // statistics of the next frame to be added, if known
+    const oaFrameStats*	frameStats;
 
   private:
     QString		filename;
@@ -196,9 +196,9 @@ OutputPNG::addFrame ( void* frame, const char* timestampStr,
   unsigned char*	s;
   unsigned char*	t;
   unsigned int		pngTransforms;
-  png_text		pngComments[ 30 ];
+  png_text		pngComments[ 34 ];
   int			numComments = 0;
-  char			stringBuffs[30][ PNG_KEYWORD_MAX_LENGTH + 1 ];
+  char			stringBuffs[34][ PNG_KEYWORD_MAX_LENGTH + 1 ];
   int       xorg, yorg;
 
   filenameRoot = getNewFilename();
@@ -553,6 +553,30 @@ OutputPNG::addFrame ( void* frame, const char* timestampStr,
 		pngComments[ numComments ].text = stringBuffs[ numComments ];
 		numComments++;
 	}
+	if ( metadata && metadata->sequence ) {
+		pngComments[ numComments ].key = const_cast<char *>( "OASEQNO" );
+		( void ) sprintf ( stringBuffs[ numComments ], "%llu",
+				( unsigned long long ) metadata->sequence );
+		pngComments[ numComments ].text = stringBuffs[ numComments ];
+		numComments++;
+		pngComments[ numComments ].key = const_cast<char *>( "OADROPS" );
+		( void ) sprintf ( stringBuffs[ numComments ], "%u",
+				metadata->droppedFrames );
+		pngComments[ numComments ].text = stringBuffs[ numComments ];
+		numComments++;
+		pngComments[ numComments ].key = const_cast<char *>( "OAMONOTS" );
+		( void ) sprintf ( stringBuffs[ numComments ], "%llu",
+				( unsigned long long ) metadata->timestamp );
+		pngComments[ numComments ].text = stringBuffs[ numComments ];
+		numComments++;
+	}
+	if ( metadata && metadata->hwTimestampValid ) {
+		pngComments[ numComments ].key = const_cast<char *>( "OAHWTS" );
+		( void ) sprintf ( stringBuffs[ numComments ], "%llu",
+				( unsigned long long ) metadata->hwTimestamp );
+		pngComments[ numComments ].text = stringBuffs[ numComments ];
+		numComments++;
+	}
 
 	if ( timerData ) {
 		if ( timerData->statusValid ) {
@@ -64,6 +64,7 @@ typedef struct {
 	void ( *reloadProfiles )( void );
 	void ( *resetTemperatureLabel )( void );
 	void ( *setDisplayFPS )( int );
+	void ( *setDisplayStretch )( int );
 	void ( *enableTIFFCapture )( int );
 	void ( *enableMOVCapture )( int );
 	void ( *enablePNGCapture )( int );
@@ -32,6 +32,18 @@
 #include <openastro/openastro.h>
 #include <openastro/camera/controls.h>
 #include <openastro/camera/features.h>
+#include <openastro/camera/buffers.h>
+#include <openastro/camera/dummy.h>
+#include <openastro/camera/replay.h>
+#include <openastro/camera/async.h>
+#include <openastro/camera/cache.h>
+#include <openastro/camera/threads.h>
+#include <openastro/camera/binning.h>
+#include <openastro/camera/stats.h>
+#include <openastro/camera/group.h>
+#include <openastro/camera/sequence.h>
+#include <openastro/camera/hotplug.h>
+#include <openastro/camera/bandwidth.h>
 #include <openastro/video/formats.h>
 
 enum oaCameraInterfaceType {
@@ -65,7 +77,8 @@ enum oaCameraInterfaceType {
   OA_CAM_IF_OGMACAM			= 28,
   OA_CAM_IF_TSCAM				= 29,
   OA_CAM_IF_PLAYERONE				= 30,
-  OA_CAM_IF_COUNT			= 31
+  OA_CAM_IF_REPLAY				= 31,
+  OA_CAM_IF_COUNT			= 32
 };
 
 extern oaInterface	oaCameraInterfaces[ OA_CAM_IF_COUNT + 1 ];
@@ -90,11 +103,39 @@ typedef struct FRAMERATES {
   FRAMERATE*		rates;
 } FRAMERATES;
 
+// sequence, timestamp and droppedFrames are filled in for every frame.
+// sequence counts every frame the driver saw since streaming started, so
+// a gap between consecutive frames equals droppedFrames.  timestamp is
+// CLOCK_MONOTONIC in nanoseconds, taken when the frame was dequeued.  The
+// remaining fields are only meaningful when their valid bit is set.
+// exposure is in microseconds, as for OA_CAM_CTRL_EXPOSURE_ABSOLUTE, and
+// hwTimestamp is in the camera's or SDK's own nanosecond timebase.  The
+// sequence fields are set for frames taken by an exposure sequence ( see
+// include/openastro/camera/sequence.h ).  dmabufFd is a dma-buf file
+// descriptor for the driver buffer holding the frame, which may be passed
+// to another device or process instead of copying the frame.  It belongs
+// to the camera and is only good while the frame ( or its lease ) is held.
+
 typedef struct FRAME_METADATA {
 	unsigned int		frameCounterValid : 1;
 	unsigned int		gpsTimeValid : 1;
+	unsigned int		hwTimestampValid : 1;
+	unsigned int		exposureValid : 1;
+	unsigned int		gainValid : 1;
+	unsigned int		sequenceStepValid : 1;
+	unsigned int		dmabufValid : 1;
 	unsigned int		frameCounter;
 	char						gpsTime[ 64 ];
+	uint64_t				sequence;
+	uint64_t				timestamp;
+	unsigned int		droppedFrames;
+	uint64_t				hwTimestamp;
+	int64_t					exposure;
+	int64_t					gain;
+	unsigned int		sequenceStep;
+	unsigned int		sequenceFrame;
+	unsigned int		sequenceLoop;
+	int							dmabufFd;
 } FRAME_METADATA;
 
 struct oaCamera;
@@ -119,6 +160,8 @@ typedef struct oaCameraFuncs {
                        void* (*)(void*, void*, int, void* ), void* );
   int              ( *stopStreaming )( struct oaCamera* );
   int              ( *isStreaming )( struct oaCamera* );
+  int              ( *startStreamingLeased )( struct oaCamera*,
+                       void* (*)(void*, oaFrameLease* ), void* );
 
 //int              ( *hasLoadableFirmware )( struct oaCamera* );
 //int              ( *isFirmwareLoaded )( struct oaCamera* );
@@ -168,6 +211,8 @@ typedef struct oaCameraDevice {
   unsigned char			cameraInterface;
   unsigned long			cameraInterfaceInfo;
   void*				_private;
+  // the driver's own initCamera, which initCamera above calls on to
+  oaCamera*			( *_driverInitCamera )( struct oaCameraDevice* );
 } oaCameraDevice;
 
 /**
@@ -185,6 +230,29 @@ typedef struct oaCameraDevice {
 extern int		oaGetCameras ( oaCameraDevice***, unsigned long );
 
 extern void		oaReleaseCameras ( oaCameraDevice** );
+
+#define	OA_CAM_ENUM_PARALLEL			0x01
+#define	OA_CAM_ENUM_CACHE					0x02
+
+/**
+ * @brief Choose how oaGetCameras() finds cameras
+ *
+ * With OA_CAM_ENUM_PARALLEL each camera interface is enumerated on its own
+ * thread.  The merged list is always in interface order.  With
+ * OA_CAM_ENUM_CACHE each interface's result is kept and returned again by
+ * later calls, and only the interfaces whose USB devices have changed are
+ * enumerated again.  A change of feature flags rescans everything.
+ * Cameras on other buses (eg. GigE) are only found after a USB change
+ * affecting that interface or oaFlushCameraCache().
+ *
+ * @param policy [in] OA_CAM_ENUM_* flags, OA_CAM_ENUM_PARALLEL by default
+ */
+extern int		oaSetCameraEnumeration ( unsigned int );
+
+/**
+ * @brief Force the next oaGetCameras() to enumerate every interface
+ */
+extern void		oaFlushCameraCache ( void );
 extern unsigned		oaGetCameraAPIVersion ( void );
 extern const char*	oaGetCameraAPIVersionStr ( void );
 extern int		oaGetAutoForControl ( int );
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ *
+ * async.h -- asynchronous camera control requests
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_ASYNC_H
+#define OPENASTRO_CAMERA_ASYNC_H
+
+// Asynchronous control requests return at once and are carried out in
+// order by a per-camera worker thread, which calls the camera's own
+// setControl() or readControl().  A write to the same control as the
+// last request queued, while that request is still waiting to start, is
+// merged into it rather than queued, so a burst of changes (eg. from a
+// slider being dragged) costs one driver call per call the driver can
+// actually complete.  Writes are never merged past requests for other
+// controls, so the camera sees them in the order they were made.  Every
+// request merged in this way completes with the value and result of the
+// write that was eventually made.
+//
+// Once a camera has had an asynchronous request, its setControl() first
+// waits for any earlier asynchronous writes to the same control to be
+// made, so an older queued value can never overwrite a newer one set
+// directly.
+//
+// Completion is reported to the callback, if one is given, on the
+// worker thread, and may also be polled or waited for.  Each request
+// must be handed back with oaReleaseControlRequest(), which may be done
+// at any time, including from the callback or before the request has
+// completed.  Requests still waiting when the camera is closed complete
+// with -OA_ERR_INVALID_CAMERA.
+
+struct oaCamera;
+struct oaControlRequest;
+
+typedef struct oaControlRequest		oaControlRequest;
+
+// arguments are the callback argument, the request, the control, the
+// value written or read and the result
+typedef void	( *oaControlRequestCallback )( void*, oaControlRequest*, int,
+									oaControlValue*, int );
+
+extern oaControlRequest*	oaSetControlAsync ( struct oaCamera*, int,
+									oaControlValue*, oaControlRequestCallback, void* );
+extern oaControlRequest*	oaReadControlAsync ( struct oaCamera*, int,
+									oaControlRequestCallback, void* );
+
+/**
+ * @brief Check whether a request has completed
+ *
+ * @return 1 if it has, filling in the result and value if wanted, or 0
+ */
+extern int		oaPollControlRequest ( oaControlRequest*, int*,
+									oaControlValue* );
+
+/**
+ * @brief Block until a request completes
+ *
+ * @return the result of the request
+ */
+extern int		oaWaitControlRequest ( oaControlRequest*, oaControlValue* );
+extern void		oaReleaseControlRequest ( oaControlRequest* );
+
+#endif	/* OPENASTRO_CAMERA_ASYNC_H */
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *
+ * bandwidth.h -- USB bandwidth tuned from the camera's drop rate
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#ifndef OPENASTRO_CAMERA_BANDWIDTH_H
+#define OPENASTRO_CAMERA_BANDWIDTH_H
+
+#include <stdint.h>
+
+// The bandwidth tuner samples a streaming camera's delivered frame rate
+// and dropped frames ( see include/openastro/camera/stats.h, plus
+// OA_CAM_CTRL_DROPPED where the camera has it ) every interval.  It gives
+// the camera less USB bandwidth when frames are being dropped and, after
+// several clean intervals, more when the frame rate is short of that the
+// exposure time allows.  A setting that dropped frames, or a step up that
+// gained nothing, is not tried again for OA_BW_RETRY_INTERVALS intervals.
+// Each change is logged at info level for OA_LOG_CAMERA.
+//
+// Drivers don't agree on which way OA_CAM_CTRL_USBTRAFFIC runs, so
+// OA_BW_MORE_IS_FASTER or OA_BW_MORE_IS_SLOWER says whether larger values
+// give the camera more bandwidth.  Without either the direction is known
+// for the ZWO, SVBONY and QHY drivers only.  With OA_BW_HIGHSPEED the
+// tuner may also turn OA_CAM_CTRL_HIGHSPEED on, as the step beyond the
+// most USB traffic allowed.
+
+#define	OA_BW_MORE_IS_FASTER		0x01
+#define	OA_BW_MORE_IS_SLOWER		0x02
+#define	OA_BW_HIGHSPEED					0x04
+
+#define	OA_BW_DEFAULT_INTERVAL	2000
+#define	OA_BW_RETRY_INTERVALS		30
+
+typedef struct oaBandwidthStatus {
+	int						running;
+	int						error;
+	int64_t				usbTraffic;
+	int						highSpeed;
+	double				deliveredFps;
+	double				expectedFps;
+	double				dropRate;
+	uint64_t			increases;
+	uint64_t			decreases;
+} oaBandwidthStatus;
+
+struct oaCamera;
+
+/**
+ * @brief Start adjusting a camera's USB bandwidth to suit its drop rate
+ *
+ * @param camera [in] camera to tune, which need not be streaming yet
+ *
+ * @param flags [in] OA_BW_* flags
+ *
+ * @param intervalMs [in] sampling interval, or zero for
+ * OA_BW_DEFAULT_INTERVAL
+ *
+ * Any automatic USB traffic setting the camera has is turned off.  The
+ * tuner must be stopped with oaStopBandwidthTuning() before the camera is
+ * closed.
+ */
+extern int		oaStartBandwidthTuning ( struct oaCamera*, unsigned int,
+									unsigned int );
+extern int		oaStopBandwidthTuning ( struct oaCamera* );
+extern int		oaGetBandwidthTuningStatus ( struct oaCamera*,
+									oaBandwidthStatus* );
+
+#endif	/* OPENASTRO_CAMERA_BANDWIDTH_H */
@@ -0,0 +1,53 @@
+/*****************************************************************************
+ *
+ * binning.h -- camera API (sub)header for emulated binning
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_BINNING_H
+#define OPENASTRO_CAMERA_BINNING_H
+
+struct oaCamera;
+
+/**
+ * @brief Emulate OA_CAM_CTRL_BINNING for a camera that can't bin
+ *
+ * Adds a discrete OA_CAM_CTRL_BINNING control offering OA_BIN_MODE_NONE
+ * to OA_BIN_MODE_4x4.  While binning, frame sizes are reported and set
+ * in binned pixels, and frames are binned in software before they reach
+ * the application, so later processing and writing handle 4 to 16 times
+ * less data.  Raw colour frames stay a mosaic with the same CFA pattern.
+ * The control is only offered while the frame format is one that can be
+ * binned (see oaCanBinFormat()).  Changing to a format that can't be
+ * binned withdraws it and turns binning off.  Call after initCamera() and
+ * before streaming starts.  It may be called again to change the mode.
+ *
+ * @param camera [in] the camera
+ *
+ * @param mode [in] OA_BIN_SUM or OA_BIN_AVERAGE (from openastro/video.h)
+ *
+ * @return OA_ERR_NONE, or -OA_ERR_IGNORED if the camera bins in hardware
+ */
+extern int		oaEnableSoftwareBinning ( struct oaCamera*, int );
+
+#endif	/* OPENASTRO_CAMERA_BINNING_H */
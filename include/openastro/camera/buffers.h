@@ -0,0 +1,98 @@
+/*****************************************************************************
+ *
+ * oacam-buffers.h -- camera API (sub)header for frame buffer pools
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_BUFFERS_H
+#define OPENASTRO_CAMERA_BUFFERS_H
+
+#include <stddef.h>
+
+// Memory policy flags for the frame buffer pool.  These may be combined.
+// A policy that cannot be honoured (eg. no huge pages configured, or
+// RLIMIT_MEMLOCK too small) is dropped with a warning rather than failing
+// camera initialisation, and the policy actually in effect is reported
+// in oaBufferPoolStats.
+
+#define	OA_BUFFER_POLICY_PLAIN						0x00
+#define	OA_BUFFER_POLICY_ALIGNED					0x01	// cache line aligned
+#define	OA_BUFFER_POLICY_LOCKED						0x02	// mlock()ed
+#define	OA_BUFFER_POLICY_HUGEPAGE					0x04	// 2MB huge pages
+
+typedef struct oaBufferPoolStats {
+	unsigned int	count;
+	unsigned int	policy;
+	size_t				bufferSize;
+	unsigned int	inUse;
+	unsigned int	highWater;
+	unsigned long	exhausted;
+} oaBufferPoolStats;
+
+struct oaCamera;
+
+/**
+ * @brief Set the frame buffer pool used by cameras initialised afterwards
+ *
+ * The count and policy are library-wide settings, not per camera.  Each
+ * camera takes them as it is initialised and keeps its own pool built to
+ * them, so changing them has no effect on cameras already open.  To give
+ * cameras different pools, set the pool before initialising each one.
+ *
+ * @param count [in] number of frame buffers, 1 to OA_CAM_MAX_BUFFERS
+ *
+ * @param policy [in] OA_BUFFER_POLICY_* flags
+ */
+extern int		oaSetCameraBufferPool ( unsigned int, unsigned int );
+extern void		oaGetCameraBufferPool ( unsigned int*, unsigned int* );
+
+/**
+ * @brief Report the size and usage of a camera's frame buffer pool
+ *
+ * highWater is the largest number of buffers that have been waiting for
+ * (or held by) the application at once, and exhausted counts the times
+ * every buffer has been in use, after which further frames are dropped.
+ */
+extern int		oaGetCameraBufferPoolStats ( struct oaCamera*,
+									oaBufferPoolStats* );
+extern void		oaResetCameraBufferPoolStats ( struct oaCamera* );
+
+// A frame delivered by startStreamingLeased() stays in driver memory,
+// and the buffer is not reused until the lease is handed back with
+// oaReleaseFrameLease(), which may be done from any thread.  Buffers are
+// recycled in the order their frames arrived, so holding on to one frame
+// also holds back those behind it.  All leases must be released before
+// the camera is closed, and for some drivers before stopStreaming() can
+// return.
+
+typedef struct oaFrameLease {
+	void*					buffer;
+	int						length;
+	void*					metadata;
+	void*					_state;
+	unsigned int	_slot;
+} oaFrameLease;
+
+extern void		oaReleaseFrameLease ( oaFrameLease* );
+
+#endif	/* OPENASTRO_CAMERA_BUFFERS_H */
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *
+ * cache.h -- cached camera control values
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_CACHE_H
+#define OPENASTRO_CAMERA_CACHE_H
+
+// A cached control is read by the camera's control worker (the same
+// thread that carries out asynchronous requests) every interval
+// milliseconds, and also picks up any value written or read through the
+// camera's setControl() and readControl().  oaReadCachedControl() never
+// blocks or touches the camera, so it is cheap enough to call from a UI
+// timer however often is convenient.
+//
+// Subscribers are called whenever a control's value is seen to change,
+// whether or not the control is cached.  Callbacks may arrive on the
+// control worker or on whichever thread called setControl() or
+// readControl(), so they should do no more than hand the value on.
+
+#define	OA_CONTROL_MAX_SUBSCRIPTIONS		16
+
+struct oaCamera;
+
+// arguments are the callback argument, the control and its new value
+typedef void	( *oaControlChangeCallback )( void*, int, oaControlValue* );
+
+/**
+ * @brief Start, change or stop refreshing a control in the cache
+ *
+ * The control is read once before returning, so the cache always has a
+ * value for it.  An interval of 0 removes it from the cache.
+ */
+extern int		oaCacheControl ( struct oaCamera*, int, unsigned int );
+
+/**
+ * @brief Read the cached value of a control without blocking
+ *
+ * @return -OA_ERR_INVALID_CONTROL if the control isn't cached
+ */
+extern int		oaReadCachedControl ( struct oaCamera*, int, oaControlValue* );
+
+extern int		oaSubscribeControl ( struct oaCamera*, int,
+									oaControlChangeCallback, void* );
+extern int		oaUnsubscribeControl ( struct oaCamera*, int,
+									oaControlChangeCallback, void* );
+
+#endif	/* OPENASTRO_CAMERA_CACHE_H */
@@ -0,0 +1,63 @@
+/*****************************************************************************
+ *
+ * dummy.h -- synthetic scene settings for the dummy cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_DUMMY_H
+#define OPENASTRO_CAMERA_DUMMY_H
+
+// The dummy cameras render a synthetic scene into every frame, so they
+// can stand in for real hardware when exercising the capture, stacking
+// and output paths.  Brightness values are fractions of full scale at
+// the camera's default exposure and gain, and change in proportion to
+// both.  Noise is given in 16-bit ADU and scaled for 8-bit formats.
+
+#define	OA_DUMMY_SCENE_DEFAULT		0		// planet or stars by camera type
+#define	OA_DUMMY_SCENE_STARS			1
+#define	OA_DUMMY_SCENE_PLANET			2
+#define	OA_DUMMY_SCENE_FLAT				3		// background and noise only
+
+typedef struct oaDummyScene {
+	unsigned int	scene;
+	unsigned int	numStars;
+	double				psfSigma;			// star profile, pixels
+	double				driftX;				// field drift, pixels per frame
+	double				driftY;
+	double				planetRadius;	// pixels, 0 for a size to suit the frame
+	double				seeing;				// rms image motion, pixels
+	double				background;
+	double				readNoise;
+	int						shotNoise;		// non-zero adds photon noise
+	double				frameRate;		// 0 to follow the exposure time
+	int						unthrottled;	// non-zero ignores frameRate and exposure
+	unsigned int	seed;
+} oaDummyScene;
+
+/**
+ * @brief Set the scene rendered by dummy cameras opened afterwards
+ */
+extern int		oaSetDummyScene ( const oaDummyScene* );
+extern void		oaGetDummyScene ( oaDummyScene* );
+
+#endif	/* OPENASTRO_CAMERA_DUMMY_H */
@@ -0,0 +1,108 @@
+/*****************************************************************************
+ *
+ * group.h -- streaming from several cameras at once
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#ifndef OPENASTRO_CAMERA_GROUP_H
+#define OPENASTRO_CAMERA_GROUP_H
+
+#include <stdint.h>
+
+// A camera group streams from several open cameras at once.  Each camera
+// keeps its own threads and frame buffer pool and delivers leased frames
+// as usual, but the group holds them until every camera has a frame whose
+// timestamp ( see FRAME_METADATA ) lies within the tolerance given to
+// oaStartCameraGroup() of the others, and then hands them to the
+// application together as a frame set.  frames[n] is the frame from the
+// n'th camera added to the group, or null in a partial set.  timestamp
+// is the earliest of the frames' timestamps and spreadNs the difference
+// between the earliest and the latest.
+//
+// A frame that cannot be matched is released straight back to its camera
+// unless the group was started with OA_CAM_GROUP_PARTIAL, in which case
+// it is delivered in a set of its own.  A camera never has more than half
+// of its buffer pool waiting for partners.
+//
+// The cameras' own state is independent, but the drivers that load a
+// vendor SDK with the older dynamic loaders keep one library handle and
+// one set of SDK entry points shared by every camera using that driver.
+// Cameras from such a driver should be opened and closed one at a time,
+// even when they are then streamed together in a group.
+
+#define	OA_CAM_GROUP_MAX			8
+
+#define	OA_CAM_GROUP_PARTIAL	0x01
+
+struct oaCamera;
+struct oaFrameLease;
+
+typedef struct oaFrameSet {
+	uint64_t							sequence;
+	uint64_t							timestamp;
+	uint64_t							spreadNs;
+	unsigned int					numFrames;
+	struct oaFrameLease*	frames[ OA_CAM_GROUP_MAX ];
+	void*									_group;
+	unsigned int					_slot;
+} oaFrameSet;
+
+typedef struct oaCameraGroup oaCameraGroup;
+
+extern oaCameraGroup*	oaCreateCameraGroup ( void );
+extern int				oaAddCameraToGroup ( oaCameraGroup*, struct oaCamera* );
+
+/**
+ * @brief Start every camera in the group streaming
+ *
+ * @param group [in] group to start
+ *
+ * @param toleranceNs [in] largest difference between the timestamps of
+ * frames in a set
+ *
+ * @param callback [in] called with each frame set.  Calls are never made
+ * concurrently, but may come from any of the cameras' threads
+ *
+ * @param flags [in] OA_CAM_GROUP_PARTIAL or zero
+ *
+ * Each set must be handed back with oaReleaseFrameSet(), which may be
+ * done from any thread and need not be done before the callback returns.
+ */
+extern int				oaStartCameraGroup ( oaCameraGroup*, uint64_t,
+											void* (*)( void*, oaFrameSet* ), void*, unsigned int );
+
+/**
+ * @brief Stop every camera in the group
+ *
+ * Frames still waiting for partners are released first.  The cameras
+ * can't finish stopping while the application holds frame sets, so every
+ * set must have been handed back with oaReleaseFrameSet() before this is
+ * called.
+ */
+extern int				oaStopCameraGroup ( oaCameraGroup* );
+extern void				oaReleaseFrameSet ( oaFrameSet* );
+extern uint64_t		oaCameraGroupUnmatched ( oaCameraGroup* );
+extern void				oaDestroyCameraGroup ( oaCameraGroup* );
+
+#endif	/* OPENASTRO_CAMERA_GROUP_H */
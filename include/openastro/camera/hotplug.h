@@ -0,0 +1,88 @@
+/*****************************************************************************
+ *
+ * hotplug.h -- camera hotplug events and reconnection
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#ifndef OPENASTRO_CAMERA_HOTPLUG_H
+#define OPENASTRO_CAMERA_HOTPLUG_H
+
+// USB devices arriving and leaving are reported to the callback given to
+// oaStartCameraHotplug(), from a thread of its own, after the camera cache
+// ( see oaSetCameraEnumeration() ) has been flushed so that the next
+// oaGetCameras() sees the change.  Every USB device is reported, not just
+// cameras, as many cameras can't be recognised until a driver has looked
+// at them.  When a device is removed only busNumber and deviceAddress are
+// certain to be set.
+
+#define	OA_HOTPLUG_ADDED			1
+#define	OA_HOTPLUG_REMOVED		2
+
+typedef struct oaHotplugEvent {
+	int						event;
+	unsigned int	busNumber;
+	unsigned int	deviceAddress;
+	unsigned int	vendorId;
+	unsigned int	productId;
+} oaHotplugEvent;
+
+struct oaCamera;
+struct oaCameraDevice;
+
+/**
+ * @brief Start reporting USB devices being plugged in and unplugged
+ *
+ * @return OA_ERR_NONE, -OA_ERR_UNIMPLEMENTED without libudev, or
+ * -OA_ERR_INVALID_COMMAND if hotplug events are already being reported
+ */
+extern int		oaStartCameraHotplug ( void (*)( void*, const oaHotplugEvent* ),
+									void* );
+extern void		oaStopCameraHotplug ( void );
+
+/**
+ * @brief Remember how a camera is set up so it can be reconnected
+ *
+ * From now on the frame size, ROI, frame interval, control values and
+ * streaming state the application sets are recorded.  Call it straight
+ * after initCamera() with the device the camera was opened from.
+ */
+extern int		oaEnableCameraReconnect ( struct oaCamera*,
+									struct oaCameraDevice* );
+
+/**
+ * @brief Close a camera and open the same device again as it was
+ *
+ * Waits up to timeoutMs for the device to be found again, then opens it,
+ * restores the recorded settings and restarts streaming with the same
+ * callback if it was streaming before.  The frame buffers are handed from
+ * the old camera to the new one when the frame size and pool settings
+ * allow.  All frame leases must have been released.  The old camera is
+ * closed whether or not this succeeds, so it must not be used again.
+ *
+ * @return the new camera, or null with the error in *error
+ */
+extern struct oaCamera*	oaReconnectCamera ( struct oaCamera*, unsigned int,
+									int* );
+
+#endif	/* OPENASTRO_CAMERA_HOTPLUG_H */
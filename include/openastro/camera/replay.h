@@ -0,0 +1,59 @@
+/*****************************************************************************
+ *
+ * replay.h -- recorded sessions played back as cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_REPLAY_H
+#define OPENASTRO_CAMERA_REPLAY_H
+
+// Each replay source appears as a streaming camera on the
+// OA_CAM_IF_REPLAY interface.  A source is a SER file, a single FITS or
+// PNG image, or a directory of FITS or PNG images played in name order.
+// Frames are delivered at the pace of their recorded timestamps (SER
+// trailer or FITS OAMONOTS) or, failing those, at the given frame rate.
+// A frame rate of zero, or OA_REPLAY_MAX_RATE, delivers them as fast as
+// the application returns buffers.
+
+#define	OA_REPLAY_MAX_RATE					0x01
+#define	OA_REPLAY_LOOP							0x02
+
+#define	OA_REPLAY_MAX_SOURCES				16
+
+/**
+ * @brief Add a file or directory to be enumerated as a replay camera
+ */
+extern int		oaAddReplaySource ( const char* );
+extern void		oaClearReplaySources ( void );
+
+/**
+ * @brief Set how replay cameras opened afterwards pace their frames
+ *
+ * @param flags [in] OA_REPLAY_* flags
+ *
+ * @param frameRate [in] frames per second for sources without timestamps
+ */
+extern int		oaSetReplayOptions ( unsigned int, double );
+extern void		oaGetReplayOptions ( unsigned int*, double* );
+
+#endif	/* OPENASTRO_CAMERA_REPLAY_H */
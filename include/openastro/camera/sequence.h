@@ -0,0 +1,107 @@
+/*****************************************************************************
+ *
+ * sequence.h -- exposure sequences run by the library
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#ifndef OPENASTRO_CAMERA_SEQUENCE_H
+#define OPENASTRO_CAMERA_SEQUENCE_H
+
+#include <stdint.h>
+
+// An exposure sequence is a list of steps, each taking count frames at
+// the given exposure ( in microseconds, as OA_CAM_CTRL_EXPOSURE_ABSOLUTE )
+// and gain.  OA_SEQ_UNCHANGED leaves the exposure or gain as it was.  The
+// steps are repeated loops times, or until the sequence is stopped if
+// loops is zero.
+//
+// With OA_SEQ_SINGLE_SHOT, or by default for a camera offering single
+// shot exposures, each frame is a separate exposure and the controls are
+// changed between them.  Otherwise the camera streams and the changes are
+// made by the camera's own threads while it does so.  Frames that arrive
+// before a change has taken effect are not delivered, but are counted in
+// transitionFrames.
+//
+// Every frame delivered has sequenceStepValid set in its FRAME_METADATA
+// and sequenceStep, sequenceFrame and sequenceLoop filled in.  The time
+// taken to switch is measured from the last frame of one step to the
+// first of the next, less the new step's exposure.
+
+#define	OA_SEQ_MAX_STEPS				64
+#define	OA_SEQ_UNCHANGED				INT64_MIN
+
+#define	OA_SEQ_SINGLE_SHOT			0x01
+#define	OA_SEQ_STREAMING				0x02
+
+typedef struct oaExposureStep {
+	int64_t				exposure;
+	int64_t				gain;
+	unsigned int	count;
+} oaExposureStep;
+
+typedef struct oaExposureSequenceStatus {
+	int						running;
+	int						error;
+	int						mode;
+	unsigned int	step;
+	unsigned int	frame;
+	unsigned int	loop;
+	uint64_t			framesDelivered;
+	uint64_t			transitionFrames;
+	uint64_t			switches;
+	uint64_t			minSwitchNs;
+	uint64_t			maxSwitchNs;
+	uint64_t			totalSwitchNs;
+} oaExposureSequenceStatus;
+
+struct oaCamera;
+
+/**
+ * @brief Run a sequence of exposures
+ *
+ * @param camera [in] camera to use, which must not already be streaming
+ *
+ * @param steps [in] steps to take, copied before the call returns
+ *
+ * @param numSteps [in] number of steps, up to OA_SEQ_MAX_STEPS
+ *
+ * @param loops [in] number of times to run through the steps, or zero
+ * to run until stopped
+ *
+ * @param flags [in] OA_SEQ_SINGLE_SHOT, OA_SEQ_STREAMING or zero
+ *
+ * @param callback [in] called with each frame as for startStreaming()
+ *
+ * The first step's settings are made before the call returns.  The
+ * sequence must be stopped with oaStopExposureSequence(), even once it has
+ * finished, before the camera is closed.
+ */
+extern int		oaStartExposureSequence ( struct oaCamera*,
+									const oaExposureStep*, unsigned int, unsigned int, unsigned int,
+									void* (*)( void*, void*, int, void* ), void* );
+extern int		oaStopExposureSequence ( struct oaCamera* );
+extern int		oaGetExposureSequenceStatus ( struct oaCamera*,
+									oaExposureSequenceStatus* );
+
+#endif	/* OPENASTRO_CAMERA_SEQUENCE_H */
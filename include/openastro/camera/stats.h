@@ -0,0 +1,89 @@
+/*****************************************************************************
+ *
+ * stats.h -- camera API (sub)header for throughput and latency statistics
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_STATS_H
+#define OPENASTRO_CAMERA_STATS_H
+
+#include <stdint.h>
+
+// Latencies are counted in power-of-two buckets of microseconds.  Bucket
+// 0 holds anything under 1us and bucket n ( n > 0 ) anything from
+// 2^(n-1) up to 2^n us.  The last bucket also takes everything longer.
+
+#define	OA_LATENCY_BUCKETS		24
+
+typedef struct oaLatencyHistogram {
+	uint64_t			count;
+	uint64_t			totalNs;
+	uint64_t			maxNs;
+	uint64_t			bucket[ OA_LATENCY_BUCKETS ];
+} oaLatencyHistogram;
+
+// framesDelivered counts frames handed to the application's callback,
+// whether or not they were leased.  driverDrops are frames the camera,
+// its SDK or the kernel lost or the driver discarded as damaged, and
+// bufferDrops those discarded because every frame buffer was still
+// waiting for (or held by) the application.  queueLatency runs from the
+// frame being dequeued from the camera to the callback being entered,
+// and callbackDuration is the time spent in the callback.  elapsedNs is
+// the time since the statistics were last reset.
+
+typedef struct oaCameraStats {
+	uint64_t							framesDelivered;
+	uint64_t							driverDrops;
+	uint64_t							bufferDrops;
+	uint64_t							elapsedNs;
+	oaLatencyHistogram		queueLatency;
+	oaLatencyHistogram		callbackDuration;
+} oaCameraStats;
+
+struct oaCamera;
+
+/**
+ * @brief Take a snapshot of a camera's frame statistics
+ *
+ * The counters are updated without locking by the camera's threads, so
+ * the snapshot is cheap enough to take several times a second.  Each
+ * value is read atomically, but frames may arrive while it is being
+ * taken, so the totals are not guaranteed to agree with each other.
+ */
+extern int				oaGetCameraStats ( struct oaCamera*, oaCameraStats* );
+extern void				oaResetCameraStats ( struct oaCamera* );
+
+/**
+ * @brief Estimate a percentile from a latency histogram
+ *
+ * @param hist [in] histogram from oaGetCameraStats()
+ *
+ * @param fraction [in] percentile required, between 0.0 and 1.0
+ *
+ * @return upper bound in nanoseconds of the bucket containing the
+ * percentile, never more than the largest latency seen
+ */
+extern uint64_t		oaLatencyPercentile ( const oaLatencyHistogram*, double );
+extern uint64_t		oaLatencyBucketLimit ( unsigned int );
+
+#endif	/* OPENASTRO_CAMERA_STATS_H */
@@ -0,0 +1,72 @@
+/*****************************************************************************
+ *
+ * threads.h -- camera API (sub)header for camera thread scheduling
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_CAMERA_THREADS_H
+#define OPENASTRO_CAMERA_THREADS_H
+
+#include <stdint.h>
+
+// The threads each camera runs.  Events is the libusb event handling
+// thread used by the drivers that talk to USB devices directly.
+
+#define	OA_CAM_THREAD_CONTROLLER		0
+#define	OA_CAM_THREAD_CALLBACK			1
+#define	OA_CAM_THREAD_TIMER					2
+#define	OA_CAM_THREAD_EVENTS				3
+#define	OA_CAM_THREAD_ROLES					4
+
+#define	OA_THREAD_SCHED_DEFAULT			0
+#define	OA_THREAD_SCHED_FIFO				1
+#define	OA_THREAD_SCHED_RR					2
+
+#define	OA_THREAD_NAME_LEN					15
+
+typedef struct oaCameraThreadPolicy {
+	uint64_t			cpuMask;		// bit n allows CPU n, 0 for any CPU
+	unsigned int	scheduler;	// OA_THREAD_SCHED_*
+	int						priority;		// for FIFO and RR, clamped to the valid range
+	char					name[ OA_THREAD_NAME_LEN + 1 ];	// empty for the default
+} oaCameraThreadPolicy;
+
+/**
+ * @brief Set the scheduling of one kind of camera thread
+ *
+ * The policy applies to threads started after the call, so it should be
+ * set before cameras are initialised.  Real-time scheduling that the
+ * process is not permitted to use (eg. no CAP_SYS_NICE or RLIMIT_RTPRIO)
+ * is dropped with a warning and the thread runs with default scheduling.
+ * CPU affinity and thread names are only supported on Linux and are
+ * ignored elsewhere.
+ *
+ * @param role [in] OA_CAM_THREAD_*
+ *
+ * @param policy [in] the policy, or NULL to restore the default
+ */
+extern int		oaSetCameraThreadPolicy ( unsigned int,
+									const oaCameraThreadPolicy* );
+extern int		oaGetCameraThreadPolicy ( unsigned int, oaCameraThreadPolicy* );
+
+#endif	/* OPENASTRO_CAMERA_THREADS_H */
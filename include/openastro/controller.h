@@ -72,7 +72,8 @@ typedef struct {
 
 #define OA_CALLBACK_NEW_FRAME           0x01
 
-#define OA_CAM_BUFFERS                  8
+#define OA_CAM_BUFFERS                  8	// default pool size
+#define OA_CAM_MAX_BUFFERS              64
 
 
 #endif	/* OPENASTRO_CONTROLLER_H */
@@ -27,6 +27,8 @@
 #ifndef OPENASTRO_DEMOSAIC_H
 #define OPENASTRO_DEMOSAIC_H
 
+#include <openastro/image.h>
+
 #define OA_DEMOSAIC_RGGB	1
 #define OA_DEMOSAIC_BGGR	2
 #define OA_DEMOSAIC_GRBG	3
@@ -45,6 +47,7 @@
 #define OA_DEMOSAIC_LAST_P1		( OA_DEMOSAIC_VNG + 1 )
 
 extern int		oademosaic ( void*, void*, int, int, int, int, int );
+extern int		oademosaicImage ( const oaImage*, oaImage*, int, int );
 extern const char*	oademosaicMethodName ( int );
 
 #endif	/* OPENASTRO_DEMOSAIC_H */
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ *
+ * image.h -- image descriptor API header
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_IMAGE_H
+#define OPENASTRO_IMAGE_H
+
+#include <stdint.h>
+
+/*
+ * Describes an image in memory without owning it.  "data" points at the
+ * first pixel of the image, "stride" is the distance in bytes between the
+ * start of consecutive rows (which may be greater than the width of a row
+ * for padded driver buffers), and originX/originY give the position of the
+ * first pixel in the frame the image was taken from, so sub-images of raw
+ * colour frames can still be related back to the sensor's CFA pattern.
+ */
+
+typedef struct oaImage {
+	void*					data;
+	unsigned int	width;
+	unsigned int	height;
+	unsigned int	stride;
+	int						format;
+	unsigned int	originX;
+	unsigned int	originY;
+} oaImage;
+
+extern int			oaImageInit ( oaImage*, void*, unsigned int, unsigned int,
+										int );
+extern int			oaImageInitStrided ( oaImage*, void*, unsigned int,
+										unsigned int, unsigned int, int );
+extern int			oaImageSubView ( const oaImage*, oaImage*, unsigned int,
+										unsigned int, unsigned int, unsigned int );
+extern int			oaImageCentredView ( const oaImage*, oaImage*, unsigned int,
+										unsigned int );
+extern int			oaImageCopy ( const oaImage*, oaImage* );
+extern unsigned int	oaImageRowLength ( const oaImage* );
+extern int			oaImageIsPacked ( const oaImage* );
+extern int			oaCFAFormatAtOffset ( int, unsigned int, unsigned int );
+extern int			oaCFAFormatForPattern ( int, int );
+
+#define oaImageRow(i,y) \
+	(( uint8_t* )( i )->data + ( size_t )( y ) * ( i )->stride )
+
+#endif	/* OPENASTRO_IMAGE_H */
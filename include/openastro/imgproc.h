@@ -27,6 +27,48 @@
 #ifndef OPENASTRO_IMGPROC_H
 #define OPENASTRO_IMGPROC_H
 
+#include <openastro/image.h>
+
+#define	OA_STATS_MAX_CHANNELS	3
+
+// flags for oaFrameStatsCompute()
+#define	OA_STATS_MEDIAN				0x01
+#define	OA_STATS_SPLIT_CFA		0x02
+
+// Per-channel results.  Channels are red, green and blue for colour and
+// split CFA frames.  Values are in the units of the frame format, so
+// maxValue for a 12-bit format is 4095.
+
+typedef struct oaChannelStats {
+	uint32_t*			histogram;
+	unsigned long	count;
+	unsigned int	min;
+	unsigned int	max;
+	double				mean;
+	double				variance;
+	unsigned long	saturated;
+	unsigned int	median;
+	unsigned int	mad;
+} oaChannelStats;
+
+typedef struct oaFrameStats {
+	int							format;
+	unsigned int		channels;
+	unsigned int		maxValue;
+	unsigned int		bins;
+	unsigned int		binShift;
+	unsigned int		subsample;
+	int							medianValid;
+	oaChannelStats	channel[ OA_STATS_MAX_CHANNELS ];
+	oaChannelStats	all;
+	uint32_t*				fullHistograms;
+	uint32_t*				binnedHistograms;
+	uint32_t*				scratch;
+	unsigned int		binnedSize;
+	unsigned int		usedMin;
+	unsigned int		usedMax;
+} oaFrameStats;
+
 extern int	oaFocusScore ( void*, void*, int, int, int );
 
 extern int	oaStackSum ( void**, unsigned int, void*, unsigned int,
@@ -42,6 +84,22 @@ extern int	oaStackKappaSigma ( void**, unsigned int, void*, unsigned int,
 extern int	oaStackMedianKappaSigma ( void**, unsigned int, void*,
 								unsigned int, double, unsigned int );
 
+extern int	oaFocusScoreImage ( const oaImage* );
+
+extern int	oaStackSumImage ( const oaImage*, unsigned int, oaImage* );
+extern int	oaStackMeanImage ( const oaImage*, unsigned int, oaImage* );
+extern int	oaStackMedianImage ( const oaImage*, unsigned int, oaImage* );
+extern int	oaStackMaximumImage ( const oaImage*, unsigned int, oaImage* );
+extern int	oaStackKappaSigmaImage ( const oaImage*, unsigned int, oaImage*,
+								double );
+extern int	oaStackMedianKappaSigmaImage ( const oaImage*, unsigned int,
+								oaImage*, double );
+
+extern oaFrameStats*	oaFrameStatsCreate ( void );
+extern void	oaFrameStatsDestroy ( oaFrameStats* );
+extern int	oaFrameStatsCompute ( oaFrameStats*, const oaImage*, unsigned int,
+								unsigned int, int );
+
 extern int	oaContrastTransform ( void*, void*, int, int, int, int );
 
 extern int		oaclamp ( int, int, int );
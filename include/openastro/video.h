@@ -27,12 +27,40 @@
 #ifndef OPENASTRO_VIDEO_H
 #define OPENASTRO_VIDEO_H
 
+#include <openastro/image.h>
+
 #define		OA_FLIP_X	0x01
 #define		OA_FLIP_Y	0x02
+#define		OA_FLIP_TRANSPOSE	0x04
+
+#define		OA_ROTATE_180			( OA_FLIP_X | OA_FLIP_Y )
+#define		OA_ROTATE_90_CW		( OA_FLIP_TRANSPOSE | OA_FLIP_X )
+#define		OA_ROTATE_90_CCW	( OA_FLIP_TRANSPOSE | OA_FLIP_Y )
+
+#define		OA_BIN_SUM				0
+#define		OA_BIN_AVERAGE		1
+#define		OA_BIN_MAX_FACTOR	4
+
+#define		OA_FIELDS_INTERLEAVE	0
+#define		OA_FIELDS_SUM					1
 
 extern int		oaconvert ( void*, void*, int, int, int, int );
 extern int		oaFlipImage ( void*, unsigned int, unsigned int, int, int );
 extern int		oaInplaceCrop ( void*, unsigned int, unsigned int, unsigned int,
 		unsigned int, int );
 
+extern int		oaconvertImage ( const oaImage*, oaImage* );
+extern int		oaFlipImageView ( oaImage*, int );
+extern int		oaFlipImageCopy ( const oaImage*, oaImage*, int );
+extern int		oaCanBinFormat ( int );
+extern int		oaBinnedImageSize ( const oaImage*, unsigned int, unsigned int*,
+		unsigned int* );
+extern int		oaBinImage ( const oaImage*, oaImage*, unsigned int, int );
+extern int		oaMergeFields ( const oaImage*, const oaImage*, oaImage*, int );
+
+extern int		oaSetVideoThreads ( unsigned int );
+extern unsigned int	oaGetVideoThreads ( void );
+extern void		oaSetVideoThreadThreshold ( unsigned int );
+extern unsigned int	oaGetVideoThreadThreshold ( void );
+
 #endif	/* OPENASTRO_VIDEO_H */
@@ -216,4 +216,12 @@ typedef struct {
 
 extern frameFormatInfo oaFrameFormats[ OA_PIX_FMT_LAST_P1 ];
 
+// Not every format with a fractional number of bytes per pixel is flagged
+// as packed (eg. MONO10 packed), so code that steps through the pixels a
+// whole number of bytes at a time needs to check this as well
+
+#define OA_WHOLE_BYTES_PER_PIXEL(f) \
+    ( oaFrameFormats[f].bytesPerPixel == \
+    ( unsigned int ) oaFrameFormats[f].bytesPerPixel )
+
 #endif	/* OPENASTRO_CAMERA_FORMATS_H */
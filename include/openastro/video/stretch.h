@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *
+ * stretch.h -- video API (sub)header for 16-bit to 8-bit stretching
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_VIDEO_STRETCH_H
+#define OPENASTRO_VIDEO_STRETCH_H
+
+#define	OA_STRETCH_LINEAR		0
+#define	OA_STRETCH_ASINH		1
+#define	OA_STRETCH_AUTO			2
+
+// Black and white points are given as fractions of the full scale of the
+// frame format, so the same parameters work for 10-, 12- and 16-bit data
+
+typedef struct oaStretchParams {
+	int						mode;
+	double				blackPoint;
+	double				whitePoint;
+	double				asinhStretch;
+	double				autoBackground;
+	double				autoShadowClip;
+} oaStretchParams;
+
+// The LUT maps every possible 16-bit sample value straight to its 8-bit
+// output and is only rebuilt when the parameters, the bit depth of the
+// frames or (for OA_STRETCH_AUTO) the frame statistics change
+
+typedef struct oaStretch {
+	oaStretchParams	params;
+	unsigned int		maxValue;
+	unsigned int		median;
+	unsigned int		mad;
+	int							lutValid;
+	unsigned int		lutRebuilds;
+	int							haveStatistics;
+	unsigned int		suppliedMedian;
+	unsigned int		suppliedMAD;
+	uint32_t*				histogram;
+	uint8_t					lut[ 65536 ];
+} oaStretch;
+
+extern void				oaStretchDefaultParams ( oaStretchParams* );
+extern oaStretch*	oaStretchCreate ( const oaStretchParams* );
+extern void				oaStretchDestroy ( oaStretch* );
+extern void				oaStretchSetParams ( oaStretch*, const oaStretchParams* );
+extern void				oaStretchSetStatistics ( oaStretch*, unsigned int,
+											unsigned int );
+extern int				oaStretchOutputFormat ( int );
+extern int				oaStretchFrame ( oaStretch*, const void*, void*,
+											unsigned int, unsigned int, int );
+
+#endif	/* OPENASTRO_VIDEO_STRETCH_H */
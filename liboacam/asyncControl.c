@@ -0,0 +1,504 @@
+/*****************************************************************************
+ *
+ * asyncControl.c -- asynchronous camera control requests
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "asyncControl.h"
+#include "controlCache.h"
+
+
+#define	ASYNC_SET		1
+#define	ASYNC_READ	2
+
+struct oaControlRequest {
+	int												type;
+	int												control;
+	oaControlValue						value;
+	int												result;
+	int												done;
+	int												refs;
+	oaControlRequestCallback	callback;
+	void*											callbackArg;
+	oaControlRequest*					next;
+	oaControlRequest*					merged;
+};
+
+// Completion is tracked outside the camera so that a request can still be
+// polled, waited for and released after the camera has been closed
+
+static pthread_mutex_t	requestMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t		requestDone = PTHREAD_COND_INITIALIZER;
+
+
+void
+oacamAsyncControlsInit ( SHARED_STATE* cameraInfo )
+{
+	OA_ASYNC_CONTROLS*	async = &cameraInfo->asyncControls;
+
+	pthread_mutex_init ( &async->mutex, 0 );
+	pthread_cond_init ( &async->queued, 0 );
+	pthread_cond_init ( &async->drained, 0 );
+	async->head = async->tail = async->current = 0;
+	async->running = async->stop = async->rescan = 0;
+	async->camera = 0;
+	async->waiting = 0;
+	async->inRequest = 0;
+}
+
+
+static void
+_release ( oaControlRequest* request )
+{
+	int		refs;
+
+	pthread_mutex_lock ( &requestMutex );
+	refs = --request->refs;
+	pthread_mutex_unlock ( &requestMutex );
+	if ( !refs ) {
+		free (( void* ) request );
+	}
+}
+
+
+static void
+_complete ( oaControlRequest* request, int result, oaControlValue* value )
+{
+	oaControlRequest*		next;
+
+	for ( ; request; request = next ) {
+		next = request->merged;
+		pthread_mutex_lock ( &requestMutex );
+		request->value = *value;
+		request->result = result;
+		request->done = 1;
+		pthread_mutex_unlock ( &requestMutex );
+		pthread_cond_broadcast ( &requestDone );
+		if ( request->callback ) {
+			request->callback ( request->callbackArg, request, request->control,
+					&request->value, result );
+		}
+		_release ( request );
+	}
+}
+
+
+static void
+_waitUntil ( OA_ASYNC_CONTROLS* async, uint64_t when )
+{
+	struct timespec		wall;
+	uint64_t					now, delay;
+
+	// The condition variable runs on the wall clock, which can't be changed
+	// portably, so the monotonic deadline becomes a delay from now
+	now = oacamMonotonicTime();
+	if ( when <= now ) {
+		return;
+	}
+	delay = when - now;
+	clock_gettime ( CLOCK_REALTIME, &wall );
+	delay += wall.tv_nsec;
+	wall.tv_sec += delay / 1000000000ULL;
+	wall.tv_nsec = delay % 1000000000ULL;
+	pthread_cond_timedwait ( &async->queued, &async->mutex, &wall );
+}
+
+
+// Called with the mutex held, which is dropped while the request is
+// carried out.  Nothing more can be merged once the request is off the
+// queue.  It stops being current before it is completed, as completing
+// it may free it.
+
+static void
+_runNext ( OA_ASYNC_CONTROLS* async )
+{
+	oaCamera*						camera = async->camera;
+	oaControlRequest*		request = async->head;
+	oaControlValue			value;
+	int									result;
+
+	if (!( async->head = request->next )) {
+		async->tail = 0;
+	}
+	async->current = request;
+	value = request->value;
+	pthread_mutex_unlock ( &async->mutex );
+
+	if ( ASYNC_SET == request->type ) {
+		async->inRequest = 1;
+		result = camera->funcs.setControl ( camera, request->control, &value,
+				0 );
+		async->inRequest = 0;
+	} else {
+		result = camera->funcs.readControl ( camera, request->control, &value );
+	}
+	pthread_mutex_lock ( &async->mutex );
+	async->current = 0;
+	pthread_mutex_unlock ( &async->mutex );
+	pthread_cond_broadcast ( &async->drained );
+	_complete ( request, result, &value );
+
+	pthread_mutex_lock ( &async->mutex );
+}
+
+
+static void*
+_asyncWorker ( void* param )
+{
+	OA_ASYNC_CONTROLS*	async = param;
+	oaCamera*						camera = async->camera;
+	oaControlRequest*		request;
+	oaControlValue			value;
+	uint64_t						nextRefresh;
+
+	pthread_mutex_lock ( &async->mutex );
+	while ( !async->stop ) {
+		if ( async->head ) {
+			_runNext ( async );
+			continue;
+		}
+
+		// Requests always go first, so the cache is only refreshed when the
+		// queue is empty
+		async->rescan = 0;
+		pthread_mutex_unlock ( &async->mutex );
+		nextRefresh = oacamControlCacheRefresh ( camera );
+		pthread_mutex_lock ( &async->mutex );
+		if ( async->head || async->stop || async->rescan ) {
+			continue;
+		}
+		if ( nextRefresh ) {
+			_waitUntil ( async, nextRefresh );
+		} else {
+			pthread_cond_wait ( &async->queued, &async->mutex );
+		}
+	}
+
+	// Whatever is left never reaches the camera
+	while (( request = async->head )) {
+		async->head = request->next;
+		value = request->value;
+		pthread_mutex_unlock ( &async->mutex );
+		_complete ( request, -OA_ERR_INVALID_CAMERA, &value );
+		pthread_mutex_lock ( &async->mutex );
+	}
+	async->tail = 0;
+	pthread_cond_broadcast ( &async->drained );
+	pthread_mutex_unlock ( &async->mutex );
+	return 0;
+}
+
+
+// Called with the mutex held
+
+static int
+_writePending ( OA_ASYNC_CONTROLS* async, int control )
+{
+	oaControlRequest*		request;
+
+	if (( request = async->current ) && ASYNC_SET == request->type &&
+			request->control == control ) {
+		return 1;
+	}
+	for ( request = async->head; request; request = request->next ) {
+		if ( ASYNC_SET == request->type && request->control == control ) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+// A direct write must not be overtaken by an older queued write to the
+// same control, so those are made first.  From a request's callback the
+// worker can't make them, so everything queued up to the last of them is
+// carried out here, in order, instead.
+
+static int
+_setControl ( oaCamera* camera, int control, oaControlValue* val,
+		int dontWait )
+{
+	SHARED_STATE*				cameraInfo = camera->_private;
+	OA_ASYNC_CONTROLS*	async = &cameraInfo->asyncControls;
+	oaControlRequest*		request;
+	oaControlRequest*		last = 0;
+	int									final, worker;
+
+	pthread_mutex_lock ( &async->mutex );
+	worker = async->running && pthread_equal ( pthread_self(), async->thread );
+	if ( worker && async->inRequest ) {
+		// The worker carrying out a queued write
+		pthread_mutex_unlock ( &async->mutex );
+		return oacamHookNext ( camera, OA_HOOK_ASYNC_CONTROL )->setControl (
+				camera, control, val, dontWait );
+	}
+
+	if ( worker ) {
+		for ( request = async->head; request; request = request->next ) {
+			if ( ASYNC_SET == request->type && request->control == control ) {
+				last = request;
+			}
+		}
+		while ( last && async->head ) {
+			final = ( async->head == last ) ? 1 : 0;
+			_runNext ( async );
+			if ( final ) {
+				break;
+			}
+		}
+	} else if ( _writePending ( async, control )) {
+		async->waiting++;
+		while ( !async->stop && _writePending ( async, control )) {
+			pthread_cond_wait ( &async->drained, &async->mutex );
+		}
+		if ( !--async->waiting && async->stop ) {
+			pthread_cond_broadcast ( &async->drained );
+		}
+	}
+	pthread_mutex_unlock ( &async->mutex );
+
+	return oacamHookNext ( camera, OA_HOOK_ASYNC_CONTROL )->setControl (
+			camera, control, val, dontWait );
+}
+
+
+static int
+_closeCamera ( oaCamera* camera )
+{
+	SHARED_STATE*				cameraInfo = camera->_private;
+	OA_ASYNC_CONTROLS*	async = &cameraInfo->asyncControls;
+	int									running;
+
+	pthread_mutex_lock ( &async->mutex );
+	running = async->running;
+	async->stop = 1;
+	pthread_mutex_unlock ( &async->mutex );
+	if ( running ) {
+		pthread_cond_broadcast ( &async->queued );
+		pthread_join ( async->thread, 0 );
+	}
+
+	// The worker wakes any direct writes still waiting as it stops, but
+	// they have to be done with the lock before it can go
+	pthread_mutex_lock ( &async->mutex );
+	pthread_cond_broadcast ( &async->drained );
+	while ( async->waiting ) {
+		pthread_cond_wait ( &async->drained, &async->mutex );
+	}
+	async->running = 0;
+	pthread_mutex_unlock ( &async->mutex );
+
+	pthread_mutex_destroy ( &async->mutex );
+	pthread_cond_destroy ( &async->queued );
+	pthread_cond_destroy ( &async->drained );
+	return oacamHookNext ( camera, OA_HOOK_ASYNC_CONTROL )->closeCamera (
+			camera );
+}
+
+
+const oaCameraFuncs	oacamAsyncControlHooks = {
+	.closeCamera = _closeCamera,
+	.setControl = _setControl
+};
+
+
+int
+oacamAsyncControlsStart ( oaCamera* camera )
+{
+	SHARED_STATE*				cameraInfo = camera->_private;
+	OA_ASYNC_CONTROLS*	async = &cameraInfo->asyncControls;
+
+	pthread_mutex_lock ( &async->mutex );
+	if ( async->stop ) {
+		pthread_mutex_unlock ( &async->mutex );
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	if ( !async->running ) {
+		async->camera = camera;
+		if ( pthread_create ( &async->thread, 0, _asyncWorker, async )) {
+			pthread_mutex_unlock ( &async->mutex );
+			oaLogError ( OA_LOG_CAMERA, "%s: can't start worker thread",
+					__func__ );
+			return -OA_ERR_SYSTEM_ERROR;
+		}
+		async->running = 1;
+	}
+	pthread_mutex_unlock ( &async->mutex );
+	return OA_ERR_NONE;
+}
+
+
+void
+oacamAsyncControlsWake ( SHARED_STATE* cameraInfo )
+{
+	OA_ASYNC_CONTROLS*	async = &cameraInfo->asyncControls;
+
+	pthread_mutex_lock ( &async->mutex );
+	async->rescan = 1;
+	pthread_mutex_unlock ( &async->mutex );
+	pthread_cond_signal ( &async->queued );
+}
+
+
+static oaControlRequest*
+_queueRequest ( oaCamera* camera, int type, int control,
+		oaControlValue* value, oaControlRequestCallback callback,
+		void* callbackArg )
+{
+	SHARED_STATE*				cameraInfo;
+	OA_ASYNC_CONTROLS*	async;
+	oaControlRequest*		request;
+	oaControlRequest*		lead;
+	oaControlRequest*		last;
+
+	if ( !camera ) {
+		return 0;
+	}
+	cameraInfo = camera->_private;
+	async = &cameraInfo->asyncControls;
+
+	if (!( request = calloc ( 1, sizeof ( oaControlRequest )))) {
+		oaLogError ( OA_LOG_CAMERA, "%s: calloc failed", __func__ );
+		return 0;
+	}
+	request->type = type;
+	request->control = control;
+	if ( value ) {
+		request->value = *value;
+	}
+	request->callback = callback;
+	request->callbackArg = callbackArg;
+	// one reference for the caller and one for the worker
+	request->refs = 2;
+
+	if ( oacamAsyncControlsStart ( camera ) != OA_ERR_NONE ) {
+		free (( void* ) request );
+		return 0;
+	}
+
+	// Only the last request queued can take another in, or the camera
+	// would see writes to different controls out of order
+
+	pthread_mutex_lock ( &async->mutex );
+	if (( lead = async->tail ) && ( lead->type != type ||
+			lead->control != control )) {
+		lead = 0;
+	}
+	if ( lead ) {
+		// The newest value wins, and everyone gets told the same outcome
+		if ( ASYNC_SET == type ) {
+			lead->value = *value;
+		}
+		for ( last = lead; last->merged; last = last->merged );
+		last->merged = request;
+	} else {
+		if ( async->tail ) {
+			async->tail->next = request;
+		} else {
+			async->head = request;
+		}
+		async->tail = request;
+	}
+	pthread_mutex_unlock ( &async->mutex );
+	pthread_cond_signal ( &async->queued );
+
+	return request;
+}
+
+
+oaControlRequest*
+oaSetControlAsync ( oaCamera* camera, int control, oaControlValue* value,
+		oaControlRequestCallback callback, void* callbackArg )
+{
+	if ( !value ) {
+		return 0;
+	}
+	return _queueRequest ( camera, ASYNC_SET, control, value, callback,
+			callbackArg );
+}
+
+
+oaControlRequest*
+oaReadControlAsync ( oaCamera* camera, int control,
+		oaControlRequestCallback callback, void* callbackArg )
+{
+	return _queueRequest ( camera, ASYNC_READ, control, 0, callback,
+			callbackArg );
+}
+
+
+int
+oaPollControlRequest ( oaControlRequest* request, int* result,
+		oaControlValue* value )
+{
+	int		done;
+
+	pthread_mutex_lock ( &requestMutex );
+	if (( done = request->done )) {
+		if ( result ) {
+			*result = request->result;
+		}
+		if ( value ) {
+			*value = request->value;
+		}
+	}
+	pthread_mutex_unlock ( &requestMutex );
+	return done;
+}
+
+
+int
+oaWaitControlRequest ( oaControlRequest* request, oaControlValue* value )
+{
+	int		result;
+
+	pthread_mutex_lock ( &requestMutex );
+	while ( !request->done ) {
+		pthread_cond_wait ( &requestDone, &requestMutex );
+	}
+	result = request->result;
+	if ( value ) {
+		*value = request->value;
+	}
+	pthread_mutex_unlock ( &requestMutex );
+	return result;
+}
+
+
+void
+oaReleaseControlRequest ( oaControlRequest* request )
+{
+	if ( request ) {
+		_release ( request );
+	}
+}
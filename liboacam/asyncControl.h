@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *
+ * asyncControl.h -- per-camera worker for asynchronous control requests
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_ASYNC_CONTROL_H
+#define OA_CAMERA_ASYNC_CONTROL_H
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+
+struct SHARED_STATE;
+
+// The worker is only started by the first asynchronous request or cached
+// control.  The layer this adds over the camera functions stops it before
+// the driver frees the camera, and makes direct writes wait for queued
+// writes to the same control.  queue holds the requests not yet started,
+// each with any later requests merged into it chained from it.  current
+// is the request the worker is carrying out, and drained is signalled
+// each time one finishes.  waiting counts the direct writes blocked on
+// drained, which closing the camera must let go before the lock can be
+// destroyed.  inRequest is only touched by the worker, and is set while
+// it makes a queued write.  Between requests the worker refreshes the
+// control cache, and rescan tells it the cache has changed while it
+// wasn't looking.
+
+typedef struct OA_ASYNC_CONTROLS {
+	pthread_mutex_t					mutex;
+	pthread_cond_t					queued;
+	pthread_cond_t					drained;
+	oaControlRequest*				head;
+	oaControlRequest*				tail;
+	oaControlRequest*				current;
+	int											inRequest;
+	pthread_t								thread;
+	int											running;
+	int											stop;
+	int											rescan;
+	int											waiting;
+	oaCamera*								camera;
+} OA_ASYNC_CONTROLS;
+
+extern void	oacamAsyncControlsInit ( struct SHARED_STATE* );
+extern int	oacamAsyncControlsStart ( oaCamera* );
+extern void	oacamAsyncControlsWake ( struct SHARED_STATE* );
+
+#endif	/* OA_CAMERA_ASYNC_CONTROL_H */
@@ -59,7 +59,7 @@ oaCamera*
 oaAtikSerialInitCamera ( oaCameraDevice* device )
 {
   oaCamera*		camera;
-  int			numRead, i, j, useFIFO, matched, ret;
+  int			numRead, i, useFIFO, matched, ret;
   int                   deviceAddr, deviceBus, numUSBDevices;
   DEVICE_INFO*		devInfo;
   AtikSerial_STATE*	cameraInfo;
@@ -396,9 +396,9 @@ oaAtikSerialInitCamera ( oaCameraDevice* device )
     return 0;
   }
 
-  if (!( cameraInfo->buffers = calloc ( OA_CAM_BUFFERS,
-      sizeof ( frameBuffer )))) {
-    oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffer array failed", __func__ );
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: buffer allocation failed", __func__ );
     ftdi_usb_close ( cameraInfo->ftdiContext );
     ftdi_free ( cameraInfo->ftdiContext );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
@@ -407,34 +407,6 @@ oaAtikSerialInitCamera ( oaCameraDevice* device )
     return 0;
   }
 
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-      ftdi_usb_close ( cameraInfo->ftdiContext );
-      ftdi_free ( cameraInfo->ftdiContext );
-			if ( i ) {
-				for ( j = 0; j < i; j++ ) {
-					free (( void* ) cameraInfo->buffers[j].start );
-				}
-			}
-      free (( void* ) cameraInfo->buffers );
-      free (( void* ) cameraInfo->xferBuffer );
-      free (( void* ) cameraInfo->frameSizes[1].sizes );
-      FREE_DATA_STRUCTS;
-      return 0;
-    }
-  }
-
-  cameraInfo->buffersFree = cameraInfo->configuredBuffers;
   cameraInfo->nextBuffer = 0;
 
   cameraInfo->currentExposure = DEFAULT_EXPOSURE;
@@ -483,24 +455,23 @@ oaAtikSerialInitCamera ( oaCameraDevice* device )
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamAtikSerialcontroller, ( void* ) camera )) {
     ftdi_usb_close ( cameraInfo->ftdiContext );
     ftdi_free ( cameraInfo->ftdiContext );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->xferBuffer );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
 
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamAtikSerialcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -509,14 +480,11 @@ oaAtikSerialInitCamera ( oaCameraDevice* device )
     pthread_join ( cameraInfo->controllerThread, &dummy );
     ftdi_usb_close ( cameraInfo->ftdiContext );
     ftdi_free ( cameraInfo->ftdiContext );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->xferBuffer );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -545,7 +513,6 @@ _atikSerialInitFunctionPointers ( oaCamera* camera )
 int
 oaAtikSerialCloseCamera ( oaCamera* camera )
 {
-  int                   j;
   void*                 dummy;
   AtikSerial_STATE*     cameraInfo;
 
@@ -558,26 +525,19 @@ oaAtikSerialCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     ftdi_usb_close ( cameraInfo->ftdiContext );
     ftdi_free ( cameraInfo->ftdiContext );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
     free (( void* ) cameraInfo->frameSizes[1].sizes );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->xferBuffer );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
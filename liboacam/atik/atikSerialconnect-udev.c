@@ -55,7 +55,7 @@ oaAtikSerialInitCamera ( oaCameraDevice* device )
   oaCamera*		camera;
   int                   camDesc;
   struct termios        tio;
-  int			numRead, i, j, useFIFO;
+  int			numRead, useFIFO;
   DEVICE_INFO*		devInfo;
   AtikSerial_STATE*	cameraInfo;
   COMMON_INFO*		commonInfo;
@@ -323,36 +323,15 @@ oaAtikSerialInitCamera ( oaCameraDevice* device )
     return 0;
   }
 
-  if (!( cameraInfo->buffers = calloc ( OA_CAM_BUFFERS,
-      sizeof ( frameBuffer )))) {
-    oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffer array failed", __func__ );
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: buffer allocation failed", __func__ );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     free (( void* ) cameraInfo->xferBuffer );
     FREE_DATA_STRUCTS;
     return 0;
   }
 
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-      free (( void* ) cameraInfo->buffers );
-      free (( void* ) cameraInfo->xferBuffer );
-      free (( void* ) cameraInfo->frameSizes[1].sizes );
-      FREE_DATA_STRUCTS;
-      return 0;
-    }
-  }
-
-  cameraInfo->buffersFree = cameraInfo->configuredBuffers;
   cameraInfo->nextBuffer = 0;
 
   cameraInfo->currentExposure = DEFAULT_EXPOSURE;
@@ -401,36 +380,32 @@ oaAtikSerialInitCamera ( oaCameraDevice* device )
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamAtikSerialcontroller, ( void* ) camera )) {
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->xferBuffer );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
 
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamAtikSerialcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
     cameraInfo->stopControllerThread = 1;
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->xferBuffer );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -459,7 +434,6 @@ _atikSerialInitFunctionPointers ( oaCamera* camera )
 int
 oaAtikSerialCloseCamera ( oaCamera* camera )
 {
-  int			j;
   void*			dummy;
   AtikSerial_STATE*	cameraInfo;
 
@@ -472,25 +446,18 @@ oaAtikSerialCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     close ( cameraInfo->fd );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
     free (( void* ) cameraInfo->frameSizes[1].sizes );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->xferBuffer );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
@@ -61,6 +61,7 @@ oacamAtikSerialcontroller ( void* param )
   int			streaming = 0;
   int			maxWaitTime, frameWait;
   int			nextBuffer, buffersFree;
+  FRAME_METADATA*	metadata;
   unsigned char		ampOnCmd[5] = { 'C', 'M', 'D', ATIK_CMD_SET_AMP, 1 };
 
   do {
@@ -151,9 +152,7 @@ oacamAtikSerialcontroller ( void* param )
 
       if ( !exitThread ) {
         if ( !_doReadExposure ( cameraInfo )) {
-          pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-          buffersFree = cameraInfo->buffersFree;
-          pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+          buffersFree = OA_BUFFERS_FREE ( cameraInfo );
           pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
 					streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ? 1 : 0 );
           pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
@@ -161,6 +160,11 @@ oacamAtikSerialcontroller ( void* param )
             nextBuffer = cameraInfo->nextBuffer;
             memcpy ( cameraInfo->buffers[ nextBuffer ].start,
                 cameraInfo->xferBuffer, cameraInfo->imageBufferLength );
+            metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+                nextBuffer );
+            metadata->exposure = cameraInfo->currentExposure;
+            metadata->exposureValid = 1;
+            cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
             cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
                 OA_CALLBACK_NEW_FRAME;
             cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -171,14 +175,13 @@ oacamAtikSerialcontroller ( void* param )
                 cameraInfo->buffers[ nextBuffer ].start;
             cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
                 cameraInfo->imageBufferLength;
-            pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-            oaDLListAddToTail ( cameraInfo->callbackQueue,
+            oacamCallbackRingPush ( &cameraInfo->callbackRing,
                 &cameraInfo->frameCallbacks[ nextBuffer ]);
-            cameraInfo->buffersFree--;
+            OA_CLAIM_BUFFER ( cameraInfo );
             cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
                 cameraInfo->configuredBuffers;
-            pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-            pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+          } else if ( streaming ) {
+            OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
           }
         }
       }
@@ -330,9 +333,7 @@ _processStreamingStop ( AtikSerial_STATE* cameraInfo, OA_COMMAND* command )
 
   queueEmpty = 0;
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( OA_CAM_BUFFERS == cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    queueEmpty = ( cameraInfo->configuredBuffers == OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
     if ( !queueEmpty ) {
       usleep ( 100 );
     }
@@ -468,6 +469,7 @@ _doReadExposure ( AtikSerial_STATE* cameraInfo )
 				__func__, cameraInfo->imageBufferLength,
 				( int ) ( p - cameraInfo->xferBuffer ));
     cameraInfo->droppedFrames++;
+    OA_DROP_FRAME ( cameraInfo );
   }
 
   if ( cameraInfo->write ( cameraInfo, ampOffCmd, 5 )) {
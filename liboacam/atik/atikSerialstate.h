@@ -54,8 +54,6 @@ typedef struct AtikSerial_STATE {
   int			( *readBlock )( struct AtikSerial_STATE*,
                             unsigned char*, int );
   // video mode settings
-  // buffering for image transfers
-  frameBuffer*		buffers;
   // camera status
   unsigned int    cameraFlags;
   unsigned int		hardwareType;
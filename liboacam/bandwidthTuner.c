@@ -0,0 +1,532 @@
+/*****************************************************************************
+ *
+ * bandwidthTuner.c -- adjust USB bandwidth to suit the camera's drop rate
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "bandwidthTuner.h"
+
+
+// More than DROP_HIGH of the frames lost in an interval means less
+// bandwidth, and no more than DROP_LOW counts as a clean interval.  The
+// gap between them is the hysteresis.  A step up has to raise the frame
+// rate by MIN_GAIN to be kept, and the frame rate is close enough once it
+// reaches NEAR_EXPECTED of that the exposure time allows.
+
+#define	DROP_HIGH					0.01
+#define	DROP_LOW					0.001
+#define	MIN_GAIN					1.02
+#define	NEAR_EXPECTED			0.97
+#define	CLEAN_INTERVALS		3
+#define	MAX_STRIDES				10
+
+
+void
+oacamBandwidthTunerInit ( SHARED_STATE* cameraInfo )
+{
+	OA_BANDWIDTH_TUNER*	tuner = &cameraInfo->bandwidthTuner;
+
+	pthread_mutex_init ( &tuner->mutex, 0 );
+	pthread_cond_init ( &tuner->wake, 0 );
+}
+
+
+static int
+_readInt ( oaCamera* camera, int control, int64_t* value )
+{
+	oaControlValue	val;
+	int							ret;
+
+	if ( !camera->OA_CAM_CTRL_TYPE( control )) {
+		return -OA_ERR_INVALID_CONTROL;
+	}
+	if (( ret = camera->funcs.readControl ( camera, control, &val )) !=
+			OA_ERR_NONE ) {
+		return ret;
+	}
+	switch ( val.valueType ) {
+		case OA_CTRL_TYPE_INT32:
+			*value = val.int32;
+			break;
+		case OA_CTRL_TYPE_INT64:
+			*value = val.int64;
+			break;
+		case OA_CTRL_TYPE_BOOLEAN:
+			*value = val.boolean;
+			break;
+		case OA_CTRL_TYPE_READONLY:
+			*value = val.readonly;
+			break;
+		default:
+			return -OA_ERR_INVALID_CONTROL_TYPE;
+	}
+	return OA_ERR_NONE;
+}
+
+
+static int
+_setInt ( oaCamera* camera, int control, int64_t value )
+{
+	oaControlValue	val;
+
+	OA_CLEAR ( val );
+	val.valueType = camera->OA_CAM_CTRL_TYPE( control );
+	switch ( val.valueType ) {
+		case OA_CTRL_TYPE_INT32:
+			val.int32 = value;
+			break;
+		case OA_CTRL_TYPE_INT64:
+			val.int64 = value;
+			break;
+		case OA_CTRL_TYPE_BOOLEAN:
+			val.boolean = value ? 1 : 0;
+			break;
+		default:
+			return -OA_ERR_INVALID_CONTROL_TYPE;
+	}
+	return camera->funcs.setControl ( camera, control, &val, 0 );
+}
+
+
+static int64_t
+_trafficValue ( OA_BANDWIDTH_TUNER* tuner, unsigned int level )
+{
+	if ( level >= tuner->trafficLevels ) {
+		level = tuner->trafficLevels - 1;
+	}
+	return tuner->moreIsFaster ? tuner->trafficMin + level * tuner->trafficStep :
+			tuner->trafficMax - level * tuner->trafficStep;
+}
+
+
+// Called with the mutex held, which is dropped while the controls are
+// changed
+
+static int
+_setLevel ( OA_BANDWIDTH_TUNER* tuner, unsigned int level )
+{
+	oaCamera*			camera = tuner->camera;
+	int64_t				traffic = _trafficValue ( tuner, level );
+	int						highSpeed = ( level >= tuner->trafficLevels ) ? 1 : 0;
+	int						ret = OA_ERR_NONE;
+
+	pthread_mutex_unlock ( &tuner->mutex );
+	// Turn high speed off before cutting the traffic and on after raising it
+	if ( tuner->haveHighSpeed && !highSpeed ) {
+		ret = _setInt ( camera, OA_CAM_CTRL_HIGHSPEED, 0 );
+	}
+	if ( ret == OA_ERR_NONE && tuner->haveTraffic ) {
+		ret = _setInt ( camera, OA_CAM_CTRL_USBTRAFFIC, traffic );
+	}
+	if ( ret == OA_ERR_NONE && highSpeed ) {
+		ret = _setInt ( camera, OA_CAM_CTRL_HIGHSPEED, 1 );
+	}
+	pthread_mutex_lock ( &tuner->mutex );
+
+	if ( ret != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't set USB traffic %lld: %d",
+				__func__, ( long long ) traffic, ret );
+		return ret;
+	}
+	if ( level > tuner->level ) {
+		tuner->status.increases++;
+	} else {
+		tuner->status.decreases++;
+	}
+	tuner->level = level;
+	tuner->status.usbTraffic = traffic;
+	tuner->status.highSpeed = highSpeed;
+	tuner->settling = 1;
+	tuner->cleanIntervals = 0;
+	return OA_ERR_NONE;
+}
+
+
+// Called with the mutex held.  Works out what happened over the last
+// interval and moves the level if need be.
+
+static int
+_sample ( OA_BANDWIDTH_TUNER* tuner )
+{
+	oaCamera*			camera = tuner->camera;
+	oaCameraStats	stats;
+	uint64_t			delivered, drops, total;
+	int64_t				dropped, exposure;
+	double				seconds, fps, expected = 0.0, rate;
+	unsigned int	level, previous;
+
+	( void ) oaGetCameraStats ( camera, &stats );
+	delivered = stats.framesDelivered - tuner->lastDelivered;
+	drops = stats.driverDrops - tuner->lastDrops;
+	tuner->lastDelivered = stats.framesDelivered;
+	tuner->lastDrops = stats.driverDrops;
+
+	// Not every driver feeds its own drop counter into the statistics, so
+	// whichever saw more is believed
+
+	if ( _readInt ( camera, OA_CAM_CTRL_DROPPED, &dropped ) == OA_ERR_NONE ) {
+		if ( dropped >= tuner->lastDroppedControl &&
+				( uint64_t )( dropped - tuner->lastDroppedControl ) > drops ) {
+			drops = dropped - tuner->lastDroppedControl;
+		}
+		tuner->lastDroppedControl = dropped;
+	}
+
+	if ( tuner->settling ) {
+		tuner->settling = 0;
+		return OA_ERR_NONE;
+	}
+
+	if ( tuner->ceiling < tuner->numLevels - 1 &&
+			++tuner->ceilingAge >= OA_BW_RETRY_INTERVALS ) {
+		tuner->ceiling = tuner->numLevels - 1;
+		tuner->ceilingAge = 0;
+		oaLogInfo ( OA_LOG_CAMERA, "%s: %s: allowing more USB traffic again",
+				__func__, camera->deviceName );
+	}
+
+	total = delivered + drops;
+	if ( !total ) {
+		// Not streaming
+		tuner->cleanIntervals = 0;
+		tuner->raised = 0;
+		return OA_ERR_NONE;
+	}
+
+	seconds = tuner->intervalMs / 1000.0;
+	fps = delivered / seconds;
+	rate = ( double ) drops / total;
+	if ( _readInt ( camera, OA_CAM_CTRL_EXPOSURE_ABSOLUTE, &exposure ) ==
+			OA_ERR_NONE && exposure > 0 ) {
+		expected = 1000000.0 / exposure;
+	}
+	tuner->status.deliveredFps = fps;
+	tuner->status.expectedFps = expected;
+	tuner->status.dropRate = rate;
+
+	if ( rate > DROP_HIGH ) {
+		tuner->raised = 0;
+		if ( !tuner->level ) {
+			return OA_ERR_NONE;
+		}
+		level = ( tuner->level > tuner->stride ) ? tuner->level - tuner->stride :
+				0;
+		tuner->ceiling = level;
+		tuner->ceilingAge = 0;
+		oaLogInfo ( OA_LOG_CAMERA, "%s: %s: %.1f%% of frames dropped at "
+				"%.1f fps, USB traffic %lld -> %lld", __func__, camera->deviceName,
+				rate * 100.0, fps, ( long long ) _trafficValue ( tuner,
+				tuner->level ), ( long long ) _trafficValue ( tuner, level ));
+		return _setLevel ( tuner, level );
+	}
+
+	if ( rate > DROP_LOW ) {
+		tuner->cleanIntervals = 0;
+		tuner->raised = 0;
+		return OA_ERR_NONE;
+	}
+
+	// A step up that made no difference is taken back, so the camera uses
+	// no more of the bus than it needs
+
+	if ( tuner->raised ) {
+		tuner->raised = 0;
+		if ( fps < tuner->previousFps * MIN_GAIN ) {
+			previous = tuner->previousLevel;
+			tuner->ceiling = previous;
+			tuner->ceilingAge = 0;
+			oaLogInfo ( OA_LOG_CAMERA, "%s: %s: %.1f fps is no better than %.1f, "
+					"USB traffic back to %lld", __func__, camera->deviceName, fps,
+					tuner->previousFps, ( long long ) _trafficValue ( tuner,
+					previous ));
+			return _setLevel ( tuner, previous );
+		}
+	}
+
+	if ( ++tuner->cleanIntervals < CLEAN_INTERVALS ||
+			tuner->level >= tuner->ceiling ||
+			( expected > 0.0 && fps >= expected * NEAR_EXPECTED )) {
+		return OA_ERR_NONE;
+	}
+
+	level = tuner->level + tuner->stride;
+	if ( level > tuner->ceiling ) {
+		level = tuner->ceiling;
+	}
+	tuner->previousLevel = tuner->level;
+	tuner->previousFps = fps;
+	tuner->raised = 1;
+	if ( expected > 0.0 ) {
+		oaLogInfo ( OA_LOG_CAMERA, "%s: %s: %.1f of %.1f fps with no drops, "
+				"USB traffic %lld -> %lld%s", __func__, camera->deviceName, fps,
+				expected, ( long long ) _trafficValue ( tuner, tuner->level ),
+				( long long ) _trafficValue ( tuner, level ),
+				( level >= tuner->trafficLevels ) ? ", high speed" : "" );
+	} else {
+		oaLogInfo ( OA_LOG_CAMERA, "%s: %s: %.1f fps with no drops, USB traffic "
+				"%lld -> %lld%s", __func__, camera->deviceName, fps,
+				( long long ) _trafficValue ( tuner, tuner->level ),
+				( long long ) _trafficValue ( tuner, level ),
+				( level >= tuner->trafficLevels ) ? ", high speed" : "" );
+	}
+	return _setLevel ( tuner, level );
+}
+
+
+static void*
+_tunerThread ( void* param )
+{
+	SHARED_STATE*				cameraInfo = param;
+	OA_BANDWIDTH_TUNER*	tuner = &cameraInfo->bandwidthTuner;
+	struct timespec			deadline;
+	uint64_t						timeout;
+	int									ret;
+
+	pthread_mutex_lock ( &tuner->mutex );
+	while ( !tuner->stop ) {
+		// The condition variable runs on the wall clock
+		timeout = tuner->intervalMs * 1000000ULL;
+		( void ) clock_gettime ( CLOCK_REALTIME, &deadline );
+		timeout += deadline.tv_nsec;
+		deadline.tv_sec += timeout / 1000000000ULL;
+		deadline.tv_nsec = timeout % 1000000000ULL;
+		ret = 0;
+		while ( !tuner->stop && ret != ETIMEDOUT ) {
+			ret = pthread_cond_timedwait ( &tuner->wake, &tuner->mutex,
+					&deadline );
+		}
+		if ( !tuner->stop && ( ret = _sample ( tuner )) != OA_ERR_NONE ) {
+			tuner->status.error = ret;
+			break;
+		}
+	}
+	tuner->status.running = 0;
+	pthread_mutex_unlock ( &tuner->mutex );
+	return 0;
+}
+
+
+static int
+_defaultDirection ( oaCamera* camera )
+{
+	switch ( camera->interface ) {
+		case OA_CAM_IF_ZWASI:
+		case OA_CAM_IF_ZWASI2:
+		case OA_CAM_IF_SVB:
+			return OA_BW_MORE_IS_FASTER;
+		case OA_CAM_IF_QHY:
+		case OA_CAM_IF_QHYCCD:
+			return OA_BW_MORE_IS_SLOWER;
+		default:
+			break;
+	}
+	return 0;
+}
+
+
+int
+oaStartBandwidthTuning ( oaCamera* camera, unsigned int flags,
+		unsigned int intervalMs )
+{
+	SHARED_STATE*				cameraInfo;
+	OA_BANDWIDTH_TUNER*	tuner;
+	oaCameraStats				stats;
+	int64_t							min, max, step, def, traffic = 0, highSpeed = 0;
+	unsigned int				level;
+	int									direction, ret;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	if (( flags & ~( OA_BW_MORE_IS_FASTER | OA_BW_MORE_IS_SLOWER |
+			OA_BW_HIGHSPEED )) || (( flags & OA_BW_MORE_IS_FASTER ) &&
+			( flags & OA_BW_MORE_IS_SLOWER ))) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	cameraInfo = camera->_private;
+	tuner = &cameraInfo->bandwidthTuner;
+	if ( tuner->threadStarted ) {
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	tuner->camera = camera;
+	tuner->intervalMs = intervalMs ? intervalMs : OA_BW_DEFAULT_INTERVAL;
+	tuner->haveTraffic = 0;
+	tuner->haveHighSpeed = 0;
+	tuner->moreIsFaster = 1;
+	tuner->trafficMin = tuner->trafficMax = 0;
+	tuner->trafficStep = 1;
+	tuner->trafficLevels = 1;
+
+	if ( camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_USBTRAFFIC ) ==
+			OA_CTRL_TYPE_INT32 || camera->OA_CAM_CTRL_TYPE(
+			OA_CAM_CTRL_USBTRAFFIC ) == OA_CTRL_TYPE_INT64 ) {
+		direction = flags & ( OA_BW_MORE_IS_FASTER | OA_BW_MORE_IS_SLOWER );
+		if ( !direction && !( direction = _defaultDirection ( camera ))) {
+			oaLogError ( OA_LOG_CAMERA, "%s: don't know which way USB traffic "
+					"runs for %s", __func__, camera->deviceName );
+			return -OA_ERR_INVALID_COMMAND;
+		}
+		if (( ret = camera->funcs.getControlRange ( camera,
+				OA_CAM_CTRL_USBTRAFFIC, &min, &max, &step, &def )) != OA_ERR_NONE ) {
+			return ret;
+		}
+		if (( ret = _readInt ( camera, OA_CAM_CTRL_USBTRAFFIC, &traffic )) !=
+				OA_ERR_NONE ) {
+			return ret;
+		}
+		if ( step < 1 ) {
+			step = 1;
+		}
+		if ( max > min ) {
+			tuner->haveTraffic = 1;
+			tuner->moreIsFaster = ( direction == OA_BW_MORE_IS_FASTER ) ? 1 : 0;
+			tuner->trafficMin = min;
+			tuner->trafficMax = max;
+			tuner->trafficStep = step;
+			tuner->trafficLevels = ( max - min ) / step + 1;
+		}
+	}
+
+	if (( flags & OA_BW_HIGHSPEED ) &&
+			camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_HIGHSPEED ) &&
+			_readInt ( camera, OA_CAM_CTRL_HIGHSPEED, &highSpeed ) ==
+			OA_ERR_NONE ) {
+		tuner->haveHighSpeed = 1;
+	}
+
+	if ( !tuner->haveTraffic && !tuner->haveHighSpeed ) {
+		return -OA_ERR_INVALID_CONTROL;
+	}
+
+	if ( tuner->haveTraffic && camera->OA_CAM_CTRL_AUTO_TYPE(
+			OA_CAM_CTRL_USBTRAFFIC )) {
+		( void ) _setInt ( camera, OA_CAM_CTRL_MODE_AUTO(
+				OA_CAM_CTRL_USBTRAFFIC ), 0 );
+	}
+
+	// Work out where the camera is now, rounding towards less bandwidth
+
+	if ( highSpeed ) {
+		level = tuner->trafficLevels;
+	} else if ( tuner->haveTraffic ) {
+		if ( traffic < tuner->trafficMin ) {
+			traffic = tuner->trafficMin;
+		}
+		if ( traffic > tuner->trafficMax ) {
+			traffic = tuner->trafficMax;
+		}
+		if ( tuner->moreIsFaster ) {
+			level = ( traffic - tuner->trafficMin ) / tuner->trafficStep;
+		} else {
+			level = ( tuner->trafficMax - traffic + tuner->trafficStep - 1 ) /
+					tuner->trafficStep;
+		}
+	} else {
+		level = 0;
+	}
+
+	( void ) oaGetCameraStats ( camera, &stats );
+
+	pthread_mutex_lock ( &tuner->mutex );
+	tuner->numLevels = tuner->trafficLevels + ( tuner->haveHighSpeed ? 1 : 0 );
+	tuner->stride = ( tuner->numLevels + MAX_STRIDES - 1 ) / MAX_STRIDES;
+	tuner->stop = 0;
+	tuner->level = level;
+	tuner->ceiling = tuner->numLevels - 1;
+	tuner->ceilingAge = 0;
+	tuner->raised = 0;
+	tuner->settling = 0;
+	tuner->cleanIntervals = 0;
+	tuner->lastDelivered = stats.framesDelivered;
+	tuner->lastDrops = stats.driverDrops;
+	tuner->lastDroppedControl = 0;
+	( void ) _readInt ( camera, OA_CAM_CTRL_DROPPED,
+			&tuner->lastDroppedControl );
+	OA_CLEAR ( tuner->status );
+	tuner->status.usbTraffic = _trafficValue ( tuner, level );
+	tuner->status.highSpeed = highSpeed ? 1 : 0;
+	tuner->status.running = 1;
+	pthread_mutex_unlock ( &tuner->mutex );
+
+	if ( pthread_create ( &tuner->thread, 0, _tunerThread, cameraInfo )) {
+		tuner->status.running = 0;
+		return -OA_ERR_SYSTEM_ERROR;
+	}
+	tuner->threadStarted = 1;
+	oaLogInfo ( OA_LOG_CAMERA, "%s: %s: tuning from USB traffic %lld%s",
+			__func__, camera->deviceName, ( long long ) tuner->status.usbTraffic,
+			highSpeed ? ", high speed" : "" );
+	return OA_ERR_NONE;
+}
+
+
+int
+oaStopBandwidthTuning ( oaCamera* camera )
+{
+	OA_BANDWIDTH_TUNER*	tuner;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	tuner = &(( SHARED_STATE* ) camera->_private )->bandwidthTuner;
+
+	pthread_mutex_lock ( &tuner->mutex );
+	tuner->stop = 1;
+	pthread_cond_signal ( &tuner->wake );
+	pthread_mutex_unlock ( &tuner->mutex );
+
+	if ( tuner->threadStarted ) {
+		( void ) pthread_join ( tuner->thread, 0 );
+		tuner->threadStarted = 0;
+	}
+	return OA_ERR_NONE;
+}
+
+
+int
+oaGetBandwidthTuningStatus ( oaCamera* camera, oaBandwidthStatus* status )
+{
+	OA_BANDWIDTH_TUNER*	tuner;
+
+	if ( !camera || !status ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	tuner = &(( SHARED_STATE* ) camera->_private )->bandwidthTuner;
+
+	pthread_mutex_lock ( &tuner->mutex );
+	*status = tuner->status;
+	pthread_mutex_unlock ( &tuner->mutex );
+	return OA_ERR_NONE;
+}
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ *
+ * bandwidthTuner.h -- USB bandwidth tuner state
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#ifndef OA_CAMERA_BANDWIDTH_TUNER_H
+#define OA_CAMERA_BANDWIDTH_TUNER_H
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+
+struct SHARED_STATE;
+
+// The settings the tuner can choose between are numbered as levels from
+// the least bandwidth to the most.  Levels below trafficLevels are USB
+// traffic settings with high speed off, and the level above them, if
+// high speed may be used, is the most traffic with high speed on.
+// ceiling is the highest level currently allowed, and ceilingAge the
+// number of intervals since it was last lowered.  Everything from stop
+// onwards is protected by mutex.
+
+typedef struct OA_BANDWIDTH_TUNER {
+	pthread_mutex_t			mutex;
+	pthread_cond_t			wake;
+	pthread_t						thread;
+	int									threadStarted;
+	oaCamera*						camera;
+	unsigned int				intervalMs;
+	int									moreIsFaster;
+	int									haveTraffic;
+	int									haveHighSpeed;
+	int64_t							trafficMin;
+	int64_t							trafficMax;
+	int64_t							trafficStep;
+	unsigned int				trafficLevels;
+	unsigned int				numLevels;
+	unsigned int				stride;
+	int									stop;
+	unsigned int				level;
+	unsigned int				ceiling;
+	unsigned int				ceilingAge;
+	unsigned int				previousLevel;
+	double							previousFps;
+	int									raised;
+	int									settling;
+	unsigned int				cleanIntervals;
+	uint64_t						lastDelivered;
+	uint64_t						lastDrops;
+	int64_t							lastDroppedControl;
+	oaBandwidthStatus		status;
+} OA_BANDWIDTH_TUNER;
+
+extern void	oacamBandwidthTunerInit ( struct SHARED_STATE* );
+
+#endif	/* OA_CAMERA_BANDWIDTH_TUNER_H */
@@ -0,0 +1,408 @@
+/*****************************************************************************
+ *
+ * bufferPool.c -- frame buffer pool shared by the camera drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "bufferPool.h"
+
+
+#define	OA_HUGE_PAGE_SIZE		( 2 * 1024 * 1024 )
+#define	OA_CACHE_LINE_SIZE	64
+
+static unsigned int		poolCount = OA_CAM_BUFFERS;
+static unsigned int		poolPolicy = OA_BUFFER_POLICY_PLAIN;
+
+// Only the thread reopening a device sees the buffers parked for it
+static __thread OA_PARKED_BUFFERS*	offeredBuffers = 0;
+
+static int	_adoptParkedBuffers ( SHARED_STATE*, unsigned int, size_t,
+								size_t );
+
+
+int
+oaSetCameraBufferPool ( unsigned int count, unsigned int policy )
+{
+	if ( count < 1 || count > OA_CAM_MAX_BUFFERS ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	if ( policy & ~( OA_BUFFER_POLICY_ALIGNED | OA_BUFFER_POLICY_LOCKED |
+			OA_BUFFER_POLICY_HUGEPAGE )) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	poolCount = count;
+	poolPolicy = policy;
+	return OA_ERR_NONE;
+}
+
+
+void
+oaGetCameraBufferPool ( unsigned int* count, unsigned int* policy )
+{
+	if ( count ) {
+		*count = poolCount;
+	}
+	if ( policy ) {
+		*policy = poolPolicy;
+	}
+}
+
+
+int
+oaGetCameraBufferPoolStats ( oaCamera* camera, oaBufferPoolStats* stats )
+{
+	SHARED_STATE*		cameraInfo;
+
+	if ( !camera || !stats ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	cameraInfo = camera->_private;
+	stats->count = cameraInfo->bufferPool.count;
+	stats->policy = cameraInfo->bufferPool.policy;
+	stats->bufferSize = cameraInfo->bufferPool.bufferSize;
+	stats->inUse = cameraInfo->configuredBuffers -
+			OA_BUFFERS_FREE ( cameraInfo );
+	stats->highWater = __atomic_load_n ( &cameraInfo->bufferPool.highWater,
+			__ATOMIC_RELAXED );
+	stats->exhausted = __atomic_load_n ( &cameraInfo->bufferPool.exhausted,
+			__ATOMIC_RELAXED );
+	return OA_ERR_NONE;
+}
+
+
+void
+oaResetCameraBufferPoolStats ( oaCamera* camera )
+{
+	SHARED_STATE*		cameraInfo;
+
+	if ( camera ) {
+		cameraInfo = camera->_private;
+		__atomic_store_n ( &cameraInfo->bufferPool.highWater, 0,
+				__ATOMIC_RELAXED );
+		__atomic_store_n ( &cameraInfo->bufferPool.exhausted, 0,
+				__ATOMIC_RELAXED );
+	}
+}
+
+
+static size_t
+_mapLength ( size_t size )
+{
+	return ( size + OA_HUGE_PAGE_SIZE - 1 ) & ~(( size_t ) OA_HUGE_PAGE_SIZE - 1 );
+}
+
+
+static void*
+_allocBuffer ( OA_BUFFER_POOL* pool, unsigned int n, size_t size )
+{
+	void*		m = 0;
+
+	pool->mapped[ n ] = pool->locked[ n ] = 0;
+
+	if ( pool->policy & OA_BUFFER_POLICY_HUGEPAGE ) {
+#ifdef MAP_HUGETLB
+		m = mmap ( 0, _mapLength ( size ), PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+		if ( MAP_FAILED == m ) {
+			m = 0;
+#ifdef MADV_HUGEPAGE
+			// No reserved huge pages, so fall back to transparent ones
+			m = mmap ( 0, _mapLength ( size ), PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+			if ( MAP_FAILED == m ) {
+				m = 0;
+			} else {
+				( void ) madvise ( m, _mapLength ( size ), MADV_HUGEPAGE );
+			}
+#endif
+		}
+#endif
+		if ( m ) {
+			pool->mapped[ n ] = 1;
+		} else {
+			oaLogWarning ( OA_LOG_CAMERA, "%s: huge pages unavailable", __func__ );
+			pool->policy &= ~OA_BUFFER_POLICY_HUGEPAGE;
+		}
+	}
+
+	if ( !m ) {
+		if (( pool->policy & OA_BUFFER_POLICY_ALIGNED ) || pool->alignment ) {
+			if ( posix_memalign ( &m, pool->alignment > OA_CACHE_LINE_SIZE ?
+					pool->alignment : OA_CACHE_LINE_SIZE, size )) {
+				m = 0;
+			}
+		} else {
+			m = malloc ( size );
+		}
+		if ( !m ) {
+			return 0;
+		}
+	}
+
+	if ( pool->policy & OA_BUFFER_POLICY_LOCKED ) {
+		if ( mlock ( m, size )) {
+			oaLogWarning ( OA_LOG_CAMERA, "%s: mlock failed, errno = %d",
+					__func__, errno );
+			pool->policy &= ~OA_BUFFER_POLICY_LOCKED;
+		} else {
+			pool->locked[ n ] = 1;
+		}
+	}
+
+	return m;
+}
+
+
+static void
+_freeBuffer ( OA_BUFFER_POOL* pool, unsigned int n, frameBuffer* buffer )
+{
+	if ( buffer->start ) {
+		if ( pool->locked[ n ] ) {
+			( void ) munlock ( buffer->start, buffer->length );
+		}
+		if ( pool->mapped[ n ] ) {
+			( void ) munmap ( buffer->start, _mapLength ( buffer->length ));
+		} else {
+			free ( buffer->start );
+		}
+	}
+	buffer->start = 0;
+	buffer->length = 0;
+	pool->mapped[ n ] = pool->locked[ n ] = 0;
+}
+
+
+int
+oacamAllocBuffers ( SHARED_STATE* cameraInfo, size_t size )
+{
+	return oacamAllocDeviceBuffers ( cameraInfo, poolCount, size, 0 );
+}
+
+
+int
+oacamAllocDeviceBuffers ( SHARED_STATE* cameraInfo, unsigned int count,
+		size_t size, size_t alignment )
+{
+	OA_BUFFER_POOL*	pool = &cameraInfo->bufferPool;
+	unsigned int		i;
+
+	if ( count < 1 || count > OA_CAM_MAX_BUFFERS ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	if ( size && _adoptParkedBuffers ( cameraInfo, count, size, alignment )) {
+		return OA_ERR_NONE;
+	}
+	if (!( cameraInfo->buffers = calloc ( count, sizeof ( frameBuffer )))) {
+		oaLogError ( OA_LOG_CAMERA, "%s: calloc of buffers failed", __func__ );
+		return -OA_ERR_MEM_ALLOC;
+	}
+
+	pool->count = count;
+	pool->policy = poolPolicy;
+	pool->bufferSize = size;
+	pool->alignment = alignment;
+	pool->owned = 1;
+	pool->highWater = 0;
+	pool->exhausted = 0;
+	if ( size ) {
+		for ( i = 0; i < pool->count; i++ ) {
+			if (!( cameraInfo->buffers[i].start = _allocBuffer ( pool, i, size ))) {
+				oaLogError ( OA_LOG_CAMERA, "%s: allocation of %u buffers failed",
+						__func__, pool->count );
+				oacamFreeBuffers ( cameraInfo );
+				return -OA_ERR_MEM_ALLOC;
+			}
+			cameraInfo->buffers[i].length = size;
+		}
+	}
+
+	cameraInfo->configuredBuffers = pool->count;
+	cameraInfo->buffersFree = pool->count;
+	cameraInfo->nextBuffer = 0;
+	return OA_ERR_NONE;
+}
+
+
+int
+oacamResizeBuffer ( SHARED_STATE* cameraInfo, unsigned int n, size_t size )
+{
+	OA_BUFFER_POOL*	pool = &cameraInfo->bufferPool;
+	void*						m;
+
+	if ( n >= pool->count ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	_freeBuffer ( pool, n, &cameraInfo->buffers[n] );
+	if (!( m = _allocBuffer ( pool, n, size ))) {
+		return -OA_ERR_MEM_ALLOC;
+	}
+	cameraInfo->buffers[n].start = m;
+	cameraInfo->buffers[n].length = size;
+	if ( size > pool->bufferSize ) {
+		pool->bufferSize = size;
+	}
+	return OA_ERR_NONE;
+}
+
+
+void
+oacamFreeBuffers ( SHARED_STATE* cameraInfo )
+{
+	OA_BUFFER_POOL*	pool = &cameraInfo->bufferPool;
+	unsigned int		i;
+
+	if ( cameraInfo->buffers ) {
+		for ( i = 0; i < pool->count; i++ ) {
+			_freeBuffer ( pool, i, &cameraInfo->buffers[i] );
+		}
+		free (( void* ) cameraInfo->buffers );
+		cameraInfo->buffers = 0;
+	}
+	cameraInfo->configuredBuffers = 0;
+	cameraInfo->buffersFree = 0;
+	pool->count = 0;
+	pool->owned = 0;
+}
+
+
+void
+oacamParkBuffers ( SHARED_STATE* cameraInfo, OA_PARKED_BUFFERS* parked )
+{
+	OA_BUFFER_POOL*	pool = &cameraInfo->bufferPool;
+
+	// Buffers that belong to the kernel or an SDK can't outlive the camera
+
+	if ( !cameraInfo->buffers || !pool->owned ) {
+		return;
+	}
+	oacamFreeParkedBuffers ( parked );
+	parked->buffers = cameraInfo->buffers;
+	parked->pool = *pool;
+	cameraInfo->buffers = 0;
+	cameraInfo->configuredBuffers = 0;
+	cameraInfo->buffersFree = 0;
+	pool->count = 0;
+	pool->owned = 0;
+}
+
+
+void
+oacamOfferParkedBuffers ( OA_PARKED_BUFFERS* parked )
+{
+	offeredBuffers = parked;
+}
+
+
+// Called as each camera's structures are initialised, so the offer goes
+// to the first camera opened after it is made
+
+void
+oacamClaimParkedBuffers ( SHARED_STATE* cameraInfo )
+{
+	cameraInfo->parkedBuffers = offeredBuffers;
+	offeredBuffers = 0;
+}
+
+
+static int
+_adoptParkedBuffers ( SHARED_STATE* cameraInfo, unsigned int count,
+		size_t size, size_t alignment )
+{
+	OA_PARKED_BUFFERS*	parked = cameraInfo->parkedBuffers;
+	OA_BUFFER_POOL*			pool = &cameraInfo->bufferPool;
+	unsigned int				i;
+
+	if ( !parked || !parked->buffers || parked->pool.count != count ||
+			parked->pool.alignment != alignment ||
+			( parked->pool.policy & ~poolPolicy )) {
+		return 0;
+	}
+	for ( i = 0; i < count; i++ ) {
+		if ( parked->buffers[i].length != size ) {
+			return 0;
+		}
+	}
+
+	cameraInfo->buffers = parked->buffers;
+	*pool = parked->pool;
+	parked->buffers = 0;
+	pool->highWater = 0;
+	pool->exhausted = 0;
+	cameraInfo->configuredBuffers = pool->count;
+	cameraInfo->buffersFree = pool->count;
+	cameraInfo->nextBuffer = 0;
+	oaLogInfo ( OA_LOG_CAMERA, "%s: reusing %u parked buffers", __func__,
+			count );
+	return 1;
+}
+
+
+void
+oacamFreeParkedBuffers ( OA_PARKED_BUFFERS* parked )
+{
+	unsigned int		i;
+
+	if ( parked->buffers ) {
+		for ( i = 0; i < parked->pool.count; i++ ) {
+			_freeBuffer ( &parked->pool, i, &parked->buffers[i] );
+		}
+		free (( void* ) parked->buffers );
+		parked->buffers = 0;
+	}
+}
+
+
+unsigned int
+oacamBufferPoolCount ( void )
+{
+	return poolCount;
+}
+
+
+void
+oacamInitBufferPool ( SHARED_STATE* cameraInfo, unsigned int count,
+		size_t size )
+{
+	OA_BUFFER_POOL*	pool = &cameraInfo->bufferPool;
+
+	pool->count = count;
+	pool->policy = OA_BUFFER_POLICY_PLAIN;
+	pool->bufferSize = size;
+	pool->alignment = 0;
+	pool->owned = 0;
+	pool->highWater = 0;
+	pool->exhausted = 0;
+	cameraInfo->configuredBuffers = count;
+	cameraInfo->buffersFree = count;
+	cameraInfo->nextBuffer = 0;
+}
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ *
+ * bufferPool.h -- frame buffer pool shared by the camera drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_BUFFER_POOL_H
+#define OA_CAMERA_BUFFER_POOL_H
+
+#include <stddef.h>
+
+#include <openastro/controller.h>
+
+typedef struct OA_BUFFER_POOL {
+	unsigned int		count;
+	unsigned int		policy;
+	size_t					bufferSize;
+	size_t					alignment;
+	unsigned int		owned;
+	unsigned int		highWater;
+	unsigned long		exhausted;
+	unsigned char		mapped[ OA_CAM_MAX_BUFFERS ];
+	unsigned char		locked[ OA_CAM_MAX_BUFFERS ];
+} OA_BUFFER_POOL;
+
+struct SHARED_STATE;
+
+// Drivers that own their frame memory call oacamAllocBuffers() once the
+// frame size is known.  It fills in buffers[], configuredBuffers,
+// buffersFree and nextBuffer from the application's pool settings.
+// Drivers whose buffers belong to the kernel or an SDK use
+// oacamBufferPoolCount() to size their own allocation and then
+// oacamInitBufferPool() so the accounting is the same.  A size of zero
+// to oacamAllocBuffers() defers allocating the frame memory itself to
+// oacamResizeBuffer(), for drivers that only learn it when streaming.
+// Drivers that lend the pool's memory to a kernel driver, which may
+// grant fewer buffers than the pool holds and want them on particular
+// boundaries, use oacamAllocDeviceBuffers() with the granted count and
+// the alignment instead.
+
+extern int					oacamAllocBuffers ( struct SHARED_STATE*, size_t );
+extern int					oacamAllocDeviceBuffers ( struct SHARED_STATE*,
+												unsigned int, size_t, size_t );
+extern int					oacamResizeBuffer ( struct SHARED_STATE*, unsigned int,
+												size_t );
+extern void					oacamFreeBuffers ( struct SHARED_STATE* );
+extern unsigned int	oacamBufferPoolCount ( void );
+extern void					oacamInitBufferPool ( struct SHARED_STATE*, unsigned int,
+												size_t );
+
+// A camera that is being reconnected parks the buffers it allocated in
+// its reconnect record rather than freeing them when it is closed.  The
+// record is then offered to the camera structures initialised next on
+// the same thread, which is the reopening of that device, and that
+// camera's first allocation of the same number and size of buffers, with
+// no more of a memory policy, adopts them.  No other camera can see them.
+// Whatever wasn't adopted is freed with oacamFreeParkedBuffers().
+
+typedef struct OA_PARKED_BUFFERS {
+	struct FRAME_BUFFER*	buffers;
+	OA_BUFFER_POOL				pool;
+} OA_PARKED_BUFFERS;
+
+extern void					oacamParkBuffers ( struct SHARED_STATE*,
+												OA_PARKED_BUFFERS* );
+extern void					oacamOfferParkedBuffers ( OA_PARKED_BUFFERS* );
+extern void					oacamClaimParkedBuffers ( struct SHARED_STATE* );
+extern void					oacamFreeParkedBuffers ( OA_PARKED_BUFFERS* );
+
+// buffersFree is decremented by the producer and incremented by the
+// callback thread, so it is updated atomically rather than under
+// callbackQueueMutex.  Only the producer updates the high-water mark.
+
+#define	OA_BUFFERS_FREE(s) \
+	__atomic_load_n ( &( s )->buffersFree, __ATOMIC_ACQUIRE )
+#define	OA_CLAIM_BUFFER(s) \
+	oacamNoteBuffersInUse ( &( s )->bufferPool, ( s )->configuredBuffers - \
+			__atomic_sub_fetch ( &( s )->buffersFree, 1, __ATOMIC_ACQ_REL ))
+#define	OA_RELEASE_BUFFER(s) \
+	( void ) __atomic_add_fetch ( &( s )->buffersFree, 1, __ATOMIC_ACQ_REL )
+
+static inline void
+oacamNoteBuffersInUse ( OA_BUFFER_POOL* pool, int inUse )
+{
+	if ( inUse > ( int ) __atomic_load_n ( &pool->highWater, __ATOMIC_RELAXED )) {
+		__atomic_store_n ( &pool->highWater, inUse, __ATOMIC_RELAXED );
+	}
+	if ( inUse >= ( int ) pool->count ) {
+		__atomic_add_fetch ( &pool->exhausted, 1, __ATOMIC_RELAXED );
+	}
+}
+
+#endif	/* OA_CAMERA_BUFFER_POOL_H */
@@ -0,0 +1,165 @@
+/*****************************************************************************
+ *
+ * callbackRing.c -- lock-free frame callback ring shared by the camera drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "callbackRing.h"
+
+
+#define	RING_MASK	( OA_CALLBACK_RING_SIZE - 1 )
+
+
+static void
+_ringSleep ( CALLBACK_RING* ring, uint32_t seq )
+{
+#ifdef __linux__
+	// returns immediately with EAGAIN if wakeSeq has already moved on
+	( void ) syscall ( SYS_futex, &ring->wakeSeq, FUTEX_WAIT_PRIVATE, seq,
+			0, 0, 0 );
+#else
+	pthread_mutex_lock ( &ring->wakeMutex );
+	while ( __atomic_load_n ( &ring->wakeSeq, __ATOMIC_ACQUIRE ) == seq ) {
+		pthread_cond_wait ( &ring->wakeCond, &ring->wakeMutex );
+	}
+	pthread_mutex_unlock ( &ring->wakeMutex );
+#endif
+}
+
+
+static void
+_ringWake ( CALLBACK_RING* ring )
+{
+#ifdef __linux__
+	__atomic_add_fetch ( &ring->wakeSeq, 1, __ATOMIC_RELEASE );
+	( void ) syscall ( SYS_futex, &ring->wakeSeq, FUTEX_WAKE_PRIVATE, 1,
+			0, 0, 0 );
+#else
+	pthread_mutex_lock ( &ring->wakeMutex );
+	__atomic_add_fetch ( &ring->wakeSeq, 1, __ATOMIC_RELEASE );
+	pthread_cond_broadcast ( &ring->wakeCond );
+	pthread_mutex_unlock ( &ring->wakeMutex );
+#endif
+}
+
+
+void
+oacamCallbackRingInit ( CALLBACK_RING* ring )
+{
+	ring->head = ring->tail = 0;
+	ring->waiting = ring->stop = 0;
+	ring->wakeSeq = 0;
+#ifndef __linux__
+	pthread_mutex_init ( &ring->wakeMutex, 0 );
+	pthread_cond_init ( &ring->wakeCond, 0 );
+#endif
+}
+
+
+void
+oacamCallbackRingDestroy ( CALLBACK_RING* ring )
+{
+#ifndef __linux__
+	pthread_mutex_destroy ( &ring->wakeMutex );
+	pthread_cond_destroy ( &ring->wakeCond );
+#endif
+	ring->head = ring->tail = 0;
+}
+
+
+int
+oacamCallbackRingPush ( CALLBACK_RING* ring, CALLBACK* callback )
+{
+	unsigned int		tail;
+
+	tail = __atomic_load_n ( &ring->tail, __ATOMIC_RELAXED );
+	if (( tail - __atomic_load_n ( &ring->head, __ATOMIC_ACQUIRE )) >=
+			OA_CALLBACK_RING_SIZE ) {
+		// Can only happen if a driver has more buffers than ring slots
+		oaLogError ( OA_LOG_CAMERA, "%s: callback ring full", __func__ );
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	ring->slots[ tail & RING_MASK ] = callback;
+
+	// The tail store and the load of the waiting flag pair with the
+	// consumer's store to waiting and reload of the tail in
+	// oacamCallbackRingWait().  With both sequentially consistent at least
+	// one side must see the other, so a wakeup can never be lost.
+	__atomic_store_n ( &ring->tail, tail + 1, __ATOMIC_SEQ_CST );
+	if ( __atomic_load_n ( &ring->waiting, __ATOMIC_SEQ_CST )) {
+		_ringWake ( ring );
+	}
+	return OA_ERR_NONE;
+}
+
+
+CALLBACK*
+oacamCallbackRingWait ( CALLBACK_RING* ring )
+{
+	unsigned int		head;
+	uint32_t				seq;
+
+	head = __atomic_load_n ( &ring->head, __ATOMIC_RELAXED );
+	do {
+		if ( __atomic_load_n ( &ring->stop, __ATOMIC_ACQUIRE )) {
+			return 0;
+		}
+		if ( __atomic_load_n ( &ring->tail, __ATOMIC_ACQUIRE ) != head ) {
+			return ring->slots[ head & RING_MASK ];
+		}
+
+		seq = __atomic_load_n ( &ring->wakeSeq, __ATOMIC_ACQUIRE );
+		__atomic_store_n ( &ring->waiting, 1, __ATOMIC_SEQ_CST );
+		if ( __atomic_load_n ( &ring->tail, __ATOMIC_SEQ_CST ) == head &&
+				!__atomic_load_n ( &ring->stop, __ATOMIC_SEQ_CST )) {
+			_ringSleep ( ring, seq );
+		}
+		__atomic_store_n ( &ring->waiting, 0, __ATOMIC_RELAXED );
+	} while ( 1 );
+}
+
+
+void
+oacamCallbackRingRelease ( CALLBACK_RING* ring )
+{
+	__atomic_add_fetch ( &ring->head, 1, __ATOMIC_RELEASE );
+}
+
+
+void
+oacamCallbackRingStop ( CALLBACK_RING* ring )
+{
+	__atomic_store_n ( &ring->stop, 1, __ATOMIC_SEQ_CST );
+	_ringWake ( ring );
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************
+ *
+ * callbackRing.h -- lock-free frame callback ring shared by the camera drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_CALLBACK_RING_H
+#define OA_CAMERA_CALLBACK_RING_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <openastro/controller.h>
+
+// Frames are handed from a driver's producing thread (its controller,
+// timer or SDK/libusb callback) to its callback thread through a ring of
+// pointers to the driver's frameCallbacks[] slots.  There is exactly one
+// consumer and pushes must be serialised: drivers that can queue a frame
+// from more than one thread only do so in mutually exclusive modes
+// (streaming vs. single exposure) that are switched via the command
+// queue.  Neither side takes a lock or allocates memory per frame.  The
+// consumer only enters the kernel when the ring is empty, and the producer
+// only does so when it knows the consumer is sleeping.
+
+#define OA_CALLBACK_RING_SIZE		OA_CAM_MAX_BUFFERS	// a power of two
+
+typedef struct CALLBACK_RING {
+	CALLBACK*					slots[ OA_CALLBACK_RING_SIZE ];
+	unsigned int			head;
+	unsigned int			tail;
+	int								waiting;
+	int								stop;
+	uint32_t					wakeSeq;
+#ifndef __linux__
+	pthread_mutex_t		wakeMutex;
+	pthread_cond_t		wakeCond;
+#endif
+} CALLBACK_RING;
+
+extern void				oacamCallbackRingInit ( CALLBACK_RING* );
+extern void				oacamCallbackRingDestroy ( CALLBACK_RING* );
+extern int				oacamCallbackRingPush ( CALLBACK_RING*, CALLBACK* );
+extern CALLBACK*	oacamCallbackRingWait ( CALLBACK_RING* );
+extern void				oacamCallbackRingRelease ( CALLBACK_RING* );
+extern void				oacamCallbackRingStop ( CALLBACK_RING* );
+
+#endif	/* OA_CAMERA_CALLBACK_RING_H */
@@ -0,0 +1,265 @@
+/*****************************************************************************
+ *
+ * cameraCache.c -- cache of the last camera enumeration
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <libusb-1.0/libusb.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "cameraCache.h"
+
+
+#define	USB_MAX_VENDORS		6
+#define	FNV_OFFSET			2166136261U
+#define	FNV_PRIME				16777619U
+
+// USB vendor ids of the interfaces that only ever find cameras from known
+// vendors, taken from the drivers and the udev rules.  Adding or removing
+// a device from another vendor listed here leaves these interfaces'
+// cached lists alone.  A vendor not listed anywhere might be a camera
+// sold under some other id, so a device from one of those affects every
+// interface, and any interface not listed here is rescanned whenever
+// anything on any USB bus changes.
+
+typedef struct {
+	int							interfaceType;
+	unsigned short	vendorIds[ USB_MAX_VENDORS ];
+} INTERFACE_VENDORS;
+
+static const INTERFACE_VENDORS	interfaceVendors[] = {
+	{ OA_CAM_IF_PWC, { 0x0471 }},
+	{ OA_CAM_IF_QHYCCD, { 0x04b4, 0x0547, 0x1618, 0x16c0, 0x1856 }},
+	{ OA_CAM_IF_QHY, { 0x04b4, 0x0547, 0x1618, 0x16c0, 0x1856 }},
+	{ OA_CAM_IF_SX, { 0x1278 }},
+	{ OA_CAM_IF_ATIK_SERIAL, { 0x0403 }},
+	{ OA_CAM_IF_ZWASI2, { 0x03c3 }},
+	{ OA_CAM_IF_EUVC, { 0x199e }},
+	{ OA_CAM_IF_TOUPCAM, { 0x0547, 0x232f }},
+	{ OA_CAM_IF_ALTAIRCAM, { 0x0547, 0x16d0 }},
+	{ 0, { 0 }}
+};
+
+// Each interface has a signature built from the bus, port path, address
+// and ids of the USB devices it cares about, so a device arriving, leaving
+// or being re-enumerated changes the signature of just those interfaces.
+// A changed signature bumps the interface's generation, and the cached
+// list for an interface is only used while it was built at the current
+// generation.  Generation 0 means there is no cached list.
+
+static unsigned long		cacheFeatureFlags;
+static CAMERA_LIST			cacheLists[ OA_CAM_IF_COUNT ];
+static unsigned int			cacheGeneration[ OA_CAM_IF_COUNT ];
+static unsigned int			generation[ OA_CAM_IF_COUNT ];
+static uint32_t					signature[ OA_CAM_IF_COUNT ];
+
+
+static uint32_t
+_hash ( uint32_t h, const uint8_t* data, int len )
+{
+	while ( len-- ) {
+		h ^= *data++;
+		h *= FNV_PRIME;
+	}
+	return h;
+}
+
+
+static const unsigned short*
+_vendorsForInterface ( int interfaceType )
+{
+	const INTERFACE_VENDORS*		v;
+
+	for ( v = interfaceVendors; v->interfaceType; v++ ) {
+		if ( v->interfaceType == interfaceType ) {
+			return v->vendorIds;
+		}
+	}
+	return 0;
+}
+
+
+static int
+_wantsVendor ( const unsigned short* vendors, unsigned short vendorId )
+{
+	int			i;
+
+	if ( !vendors ) {
+		return 1;
+	}
+	for ( i = 0; i < USB_MAX_VENDORS && vendors[i]; i++ ) {
+		if ( vendors[i] == vendorId ) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+static int
+_knownVendor ( unsigned short vendorId )
+{
+	const INTERFACE_VENDORS*	v;
+
+	for ( v = interfaceVendors; v->interfaceType; v++ ) {
+		if ( _wantsVendor ( v->vendorIds, vendorId )) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+static int
+_readTopology ( void )
+{
+	libusb_context*		ctx = 0;
+	libusb_device**		devlist;
+	libusb_device*		device;
+	struct libusb_device_descriptor	desc;
+	const unsigned short*	vendors[ OA_CAM_IF_COUNT ];
+	uint32_t					current[ OA_CAM_IF_COUNT ];
+	uint8_t						ports[ 8 ], key[ 14 ];
+	int								numDevices, numPorts, known, i, j;
+
+	if ( libusb_init ( &ctx )) {
+		return -OA_ERR_SYSTEM_ERROR;
+	}
+	if (( numDevices = libusb_get_device_list ( ctx, &devlist )) < 0 ) {
+		libusb_exit ( ctx );
+		return -OA_ERR_SYSTEM_ERROR;
+	}
+
+	for ( j = 0; j < OA_CAM_IF_COUNT; j++ ) {
+		vendors[j] = _vendorsForInterface ( oaCameraInterfaces[j].interfaceType );
+		current[j] = FNV_OFFSET;
+	}
+
+	for ( i = 0; i < numDevices; i++ ) {
+		device = devlist[i];
+		if ( libusb_get_device_descriptor ( device, &desc )) {
+			OA_CLEAR ( desc );
+		}
+		if (( numPorts = libusb_get_port_numbers ( device, ports,
+				sizeof ( ports ))) < 0 ) {
+			numPorts = 0;
+		}
+		OA_CLEAR ( key );
+		key[0] = libusb_get_bus_number ( device );
+		key[1] = libusb_get_device_address ( device );
+		key[2] = desc.idVendor >> 8;
+		key[3] = desc.idVendor & 0xff;
+		key[4] = desc.idProduct >> 8;
+		key[5] = desc.idProduct & 0xff;
+		memcpy ( key + 6, ports, numPorts );
+		known = _knownVendor ( desc.idVendor );
+		for ( j = 0; j < OA_CAM_IF_COUNT; j++ ) {
+			if ( !known || _wantsVendor ( vendors[j], desc.idVendor )) {
+				current[j] = _hash ( current[j], key, 6 + numPorts );
+			}
+		}
+	}
+
+	libusb_free_device_list ( devlist, 1 );
+	libusb_exit ( ctx );
+
+	for ( j = 0; j < OA_CAM_IF_COUNT; j++ ) {
+		if ( current[j] != signature[j] || !generation[j] ) {
+			if ( generation[j] && oaCameraInterfaces[j].interfaceType ) {
+				oaLogDebug ( OA_LOG_CAMERA, "%s: USB devices for %s have changed",
+						__func__, oaCameraInterfaces[j].name );
+			}
+			signature[j] = current[j];
+			if ( !++generation[j] ) {
+				generation[j] = 1;
+			}
+		}
+	}
+	return OA_ERR_NONE;
+}
+
+
+int
+oacamCameraCacheLookup ( unsigned long featureFlags, CAMERA_LIST* lists,
+		unsigned char* stale )
+{
+	int			i, numStale = 0;
+
+	if ( _readTopology() != OA_ERR_NONE || featureFlags != cacheFeatureFlags ) {
+		for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+			OA_CLEAR ( lists[i] );
+			stale[i] = 1;
+		}
+		return OA_CAM_IF_COUNT;
+	}
+
+	for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+		if ( cacheGeneration[i] && cacheGeneration[i] == generation[i] ) {
+			lists[i] = cacheLists[i];
+			stale[i] = 0;
+		} else {
+			OA_CLEAR ( lists[i] );
+			stale[i] = 1;
+			numStale++;
+		}
+	}
+	return numStale;
+}
+
+
+void
+oacamCameraCacheStore ( unsigned long featureFlags, CAMERA_LIST* lists,
+		const unsigned char* stale )
+{
+	int			i;
+
+	if ( featureFlags != cacheFeatureFlags ) {
+		oacamCameraCacheFlush();
+		cacheFeatureFlags = featureFlags;
+	}
+	for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+		if ( stale[i] ) {
+			_oaFreeCameraDeviceList ( &cacheLists[i] );
+			cacheLists[i] = lists[i];
+			cacheGeneration[i] = generation[i];
+		}
+	}
+}
+
+
+void
+oacamCameraCacheFlush ( void )
+{
+	int			i;
+
+	for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+		_oaFreeCameraDeviceList ( &cacheLists[i] );
+		cacheGeneration[i] = 0;
+	}
+}
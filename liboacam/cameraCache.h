@@ -0,0 +1,46 @@
+/*****************************************************************************
+ *
+ * cameraCache.h -- cache of the last camera enumeration
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_CACHE_H
+#define OA_CAMERA_CACHE_H
+
+#include "oacamprivate.h"
+
+// The cache holds one device list per camera interface.  Each interface
+// has a generation that changes whenever the USB devices it might claim
+// change, and a cached list is only valid at the generation it was built.
+// Lookup copies the valid lists (not the devices they point to) into the
+// caller's array, flags the rest as stale and returns how many are stale.
+// A change of feature flags makes them all stale.  Store takes ownership
+// of the devices in the stale lists passed to it, replacing those lists.
+
+extern int		oacamCameraCacheLookup ( unsigned long, CAMERA_LIST*,
+									unsigned char* );
+extern void		oacamCameraCacheStore ( unsigned long, CAMERA_LIST*,
+									const unsigned char* );
+extern void		oacamCameraCacheFlush ( void );
+
+#endif	/* OA_CAMERA_CACHE_H */
@@ -0,0 +1,461 @@
+/*****************************************************************************
+ *
+ * cameraGroup.c -- synchronised streaming from several cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+
+
+// A set never has fewer than one frame and each frame is from one of the
+// cameras' pools, so there can be no more sets than this outstanding
+
+#define	SET_SLOTS		( OA_CAM_GROUP_MAX * OA_CAM_MAX_BUFFERS )
+
+typedef struct GROUP_MEMBER {
+	oaCamera*							camera;
+	struct oaCameraGroup*	group;
+	unsigned int					index;
+	oaFrameLease*					pending[ OA_CAM_MAX_BUFFERS ];
+	uint64_t							timestamp[ OA_CAM_MAX_BUFFERS ];
+	unsigned int					head;
+	unsigned int					count;
+	unsigned int					limit;
+} GROUP_MEMBER;
+
+// mutex protects the pending frames and is taken by each camera's
+// callback thread in turn.  deliveryMutex is taken before mutex is
+// dropped so that sets reach the application one at a time and in the
+// order they were made.  setMutex only guards the set slots, so that
+// oaReleaseFrameSet() may be called from within the callback.
+
+struct oaCameraGroup {
+	pthread_mutex_t				mutex;
+	pthread_mutex_t				deliveryMutex;
+	pthread_mutex_t				setMutex;
+	unsigned int					numCameras;
+	GROUP_MEMBER					member[ OA_CAM_GROUP_MAX ];
+	int										running;
+	uint64_t							toleranceNs;
+	unsigned int					flags;
+	void*									( *callback )( void*, oaFrameSet* );
+	void*									callbackArg;
+	uint64_t							sequence;
+	uint64_t							unmatched;
+	unsigned int					nextSet;
+	oaFrameSet						set[ SET_SLOTS ];
+	unsigned char					setHeld[ SET_SLOTS ];
+};
+
+
+oaCameraGroup*
+oaCreateCameraGroup ( void )
+{
+	oaCameraGroup*	group;
+
+	if (!( group = calloc ( 1, sizeof ( oaCameraGroup )))) {
+		oaLogError ( OA_LOG_CAMERA, "%s: calloc of group failed", __func__ );
+		return 0;
+	}
+	pthread_mutex_init ( &group->mutex, 0 );
+	pthread_mutex_init ( &group->deliveryMutex, 0 );
+	pthread_mutex_init ( &group->setMutex, 0 );
+	return group;
+}
+
+
+int
+oaAddCameraToGroup ( oaCameraGroup* group, oaCamera* camera )
+{
+	unsigned int		i;
+
+	if ( !group || !camera || !camera->funcs.startStreamingLeased ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	if ( group->running ) {
+		return -OA_ERR_INVALID_COMMAND;
+	}
+	if ( group->numCameras >= OA_CAM_GROUP_MAX ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	for ( i = 0; i < group->numCameras; i++ ) {
+		if ( group->member[i].camera == camera ) {
+			return -OA_ERR_INVALID_CAMERA;
+		}
+	}
+	OA_CLEAR ( group->member[ group->numCameras ]);
+	group->member[ group->numCameras ].camera = camera;
+	group->member[ group->numCameras ].group = group;
+	group->member[ group->numCameras ].index = group->numCameras;
+	group->numCameras++;
+	return OA_ERR_NONE;
+}
+
+
+static uint64_t
+_frameTime ( oaFrameLease* lease )
+{
+	FRAME_METADATA*		metadata = lease->metadata;
+
+	if ( metadata && metadata->timestamp ) {
+		return metadata->timestamp;
+	}
+	return oacamMonotonicTime();
+}
+
+
+static oaFrameLease*
+_popFrame ( GROUP_MEMBER* member )
+{
+	oaFrameLease*		lease = member->pending[ member->head ];
+
+	member->head = ( member->head + 1 ) % OA_CAM_MAX_BUFFERS;
+	member->count--;
+	return lease;
+}
+
+
+// Called with mutex held.  Returns the new set, or null if every slot is
+// held by the application, in which case the frames are left alone.
+
+static oaFrameSet*
+_newSet ( oaCameraGroup* group )
+{
+	oaFrameSet*			set = 0;
+	unsigned int		i, slot;
+
+	pthread_mutex_lock ( &group->setMutex );
+	for ( i = 0; !set && i < SET_SLOTS; i++ ) {
+		slot = ( group->nextSet + i ) % SET_SLOTS;
+		if ( !group->setHeld[ slot ]) {
+			group->setHeld[ slot ] = 1;
+			group->nextSet = ( slot + 1 ) % SET_SLOTS;
+			set = &group->set[ slot ];
+			OA_CLEAR ( *set );
+			set->_group = group;
+			set->_slot = slot;
+		}
+	}
+	pthread_mutex_unlock ( &group->setMutex );
+	return set;
+}
+
+
+static void
+_addToSet ( oaFrameSet* set, unsigned int index, oaFrameLease* lease,
+		uint64_t timestamp )
+{
+	if ( !set->numFrames || timestamp < set->timestamp ) {
+		if ( set->numFrames ) {
+			set->spreadNs += set->timestamp - timestamp;
+		}
+		set->timestamp = timestamp;
+	} else if ( timestamp - set->timestamp > set->spreadNs ) {
+		set->spreadNs = timestamp - set->timestamp;
+	}
+	set->frames[ index ] = lease;
+	set->numFrames++;
+}
+
+
+// Called with mutex held.  The frame at the head of a member's queue
+// is either put in a set of its own or queued to be handed back.
+
+static void
+_unmatched ( oaCameraGroup* group, GROUP_MEMBER* member, oaFrameSet** ready,
+		unsigned int* numReady, oaFrameLease** discard, unsigned int* numDiscard )
+{
+	oaFrameSet*			set = 0;
+	uint64_t				timestamp = member->timestamp[ member->head ];
+
+	group->unmatched++;
+	if ( group->flags & OA_CAM_GROUP_PARTIAL ) {
+		set = _newSet ( group );
+	}
+	if ( set ) {
+		_addToSet ( set, member->index, _popFrame ( member ), timestamp );
+		set->sequence = group->sequence++;
+		ready[ ( *numReady )++ ] = set;
+	} else {
+		discard[ ( *numDiscard )++ ] = _popFrame ( member );
+	}
+}
+
+
+static void*
+_groupFrame ( void* arg, oaFrameLease* lease )
+{
+	GROUP_MEMBER*		member = arg;
+	oaCameraGroup*	group = member->group;
+	oaFrameSet*			ready[ SET_SLOTS ];
+	oaFrameLease*		discard[ SET_SLOTS ];
+	oaFrameSet*			set;
+	GROUP_MEMBER*		earliest;
+	unsigned int		numReady = 0, numDiscard = 0, i, slot;
+	uint64_t				first, last, t;
+
+	pthread_mutex_lock ( &group->mutex );
+	if ( !group->running ) {
+		pthread_mutex_unlock ( &group->mutex );
+		oaReleaseFrameLease ( lease );
+		return 0;
+	}
+
+	slot = ( member->head + member->count ) % OA_CAM_MAX_BUFFERS;
+	member->pending[ slot ] = lease;
+	member->timestamp[ slot ] = _frameTime ( lease );
+	member->count++;
+
+	// Don't let one camera's frames use up its pool while another camera
+	// has stopped delivering
+
+	if ( member->count > member->limit ) {
+		_unmatched ( group, member, ready, &numReady, discard, &numDiscard );
+	}
+
+	// When the earliest frames waiting don't all lie within the tolerance,
+	// the very earliest can never be matched: any frame from the camera
+	// with the latest one would have arrived earlier
+
+	for (;;) {
+		earliest = 0;
+		first = last = 0;
+		for ( i = 0; i < group->numCameras; i++ ) {
+			if ( !group->member[i].count ) {
+				break;
+			}
+			t = group->member[i].timestamp[ group->member[i].head ];
+			if ( !earliest || t < first ) {
+				earliest = &group->member[i];
+				first = t;
+			}
+			if ( t > last ) {
+				last = t;
+			}
+		}
+		if ( i < group->numCameras ) {
+			break;
+		}
+		if ( last - first > group->toleranceNs ) {
+			_unmatched ( group, earliest, ready, &numReady, discard, &numDiscard );
+			continue;
+		}
+		if (!( set = _newSet ( group ))) {
+			// The application is holding every set, so make room
+			for ( i = 0; i < group->numCameras; i++ ) {
+				discard[ numDiscard++ ] = _popFrame ( &group->member[i] );
+			}
+			group->unmatched += group->numCameras;
+			continue;
+		}
+		for ( i = 0; i < group->numCameras; i++ ) {
+			t = group->member[i].timestamp[ group->member[i].head ];
+			_addToSet ( set, i, _popFrame ( &group->member[i] ), t );
+		}
+		set->sequence = group->sequence++;
+		ready[ numReady++ ] = set;
+	}
+
+	pthread_mutex_lock ( &group->deliveryMutex );
+	pthread_mutex_unlock ( &group->mutex );
+
+	for ( i = 0; i < numDiscard; i++ ) {
+		oaReleaseFrameLease ( discard[i] );
+	}
+	for ( i = 0; i < numReady; i++ ) {
+		group->callback ( group->callbackArg, ready[i] );
+	}
+	pthread_mutex_unlock ( &group->deliveryMutex );
+
+	return 0;
+}
+
+
+static void
+_releasePending ( oaCameraGroup* group )
+{
+	unsigned int		i;
+
+	for ( i = 0; i < group->numCameras; i++ ) {
+		while ( group->member[i].count ) {
+			oaReleaseFrameLease ( _popFrame ( &group->member[i] ));
+		}
+	}
+}
+
+
+// Drivers don't finish stopping until every frame buffer is back in
+// their pool, so the frames waiting for partners have to be released
+// first.  Once running is clear any frame still arriving is released by
+// _groupFrame() straight away.
+
+static int
+_stopMembers ( oaCameraGroup* group, unsigned int numStarted )
+{
+	unsigned int		i;
+	int							ret, err = OA_ERR_NONE;
+
+	pthread_mutex_lock ( &group->mutex );
+	group->running = 0;
+	_releasePending ( group );
+	pthread_mutex_unlock ( &group->mutex );
+
+	for ( i = 0; i < numStarted; i++ ) {
+		if (( ret = group->member[i].camera->funcs.stopStreaming (
+				group->member[i].camera )) != OA_ERR_NONE && err == OA_ERR_NONE ) {
+			err = ret;
+		}
+	}
+	return err;
+}
+
+
+int
+oaStartCameraGroup ( oaCameraGroup* group, uint64_t toleranceNs,
+		void* (*callback)( void*, oaFrameSet* ), void* callbackArg,
+		unsigned int flags )
+{
+	GROUP_MEMBER*		member;
+	SHARED_STATE*		cameraInfo;
+	unsigned int		i, buffers;
+	int							ret;
+
+	if ( !group || !callback ) {
+		return -OA_ERR_INVALID_COMMAND;
+	}
+	if ( flags & ~OA_CAM_GROUP_PARTIAL ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	if ( group->running || !group->numCameras ) {
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	pthread_mutex_lock ( &group->mutex );
+	group->toleranceNs = toleranceNs;
+	group->flags = flags;
+	group->callback = callback;
+	group->callbackArg = callbackArg;
+	group->sequence = 0;
+	group->unmatched = 0;
+	for ( i = 0; i < group->numCameras; i++ ) {
+		member = &group->member[i];
+		cameraInfo = member->camera->_private;
+		buffers = cameraInfo->configuredBuffers;
+		if ( !buffers ) {
+			buffers = oacamBufferPoolCount();
+		}
+		member->limit = buffers > 1 ? buffers / 2 : 1;
+		member->head = member->count = 0;
+	}
+	group->running = 1;
+	pthread_mutex_unlock ( &group->mutex );
+
+	for ( i = 0; i < group->numCameras; i++ ) {
+		member = &group->member[i];
+		if (( ret = member->camera->funcs.startStreamingLeased ( member->camera,
+				_groupFrame, member )) != OA_ERR_NONE ) {
+			oaLogError ( OA_LOG_CAMERA, "%s: camera %u failed to start, err = %d",
+					__func__, i, ret );
+			( void ) _stopMembers ( group, i );
+			return ret;
+		}
+	}
+
+	return OA_ERR_NONE;
+}
+
+
+int
+oaStopCameraGroup ( oaCameraGroup* group )
+{
+	if ( !group || !group->running ) {
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	return _stopMembers ( group, group->numCameras );
+}
+
+
+void
+oaReleaseFrameSet ( oaFrameSet* set )
+{
+	oaCameraGroup*	group = set->_group;
+	oaFrameLease*		frames[ OA_CAM_GROUP_MAX ];
+	unsigned int		i;
+
+	pthread_mutex_lock ( &group->setMutex );
+	if ( !group->setHeld[ set->_slot ]) {
+		pthread_mutex_unlock ( &group->setMutex );
+		oaLogWarning ( OA_LOG_CAMERA, "%s: frame set %p is not held", __func__,
+				set );
+		return;
+	}
+	for ( i = 0; i < OA_CAM_GROUP_MAX; i++ ) {
+		frames[i] = set->frames[i];
+	}
+	group->setHeld[ set->_slot ] = 0;
+	pthread_mutex_unlock ( &group->setMutex );
+
+	for ( i = 0; i < OA_CAM_GROUP_MAX; i++ ) {
+		if ( frames[i] ) {
+			oaReleaseFrameLease ( frames[i] );
+		}
+	}
+}
+
+
+uint64_t
+oaCameraGroupUnmatched ( oaCameraGroup* group )
+{
+	uint64_t				unmatched;
+
+	pthread_mutex_lock ( &group->mutex );
+	unmatched = group->unmatched;
+	pthread_mutex_unlock ( &group->mutex );
+	return unmatched;
+}
+
+
+void
+oaDestroyCameraGroup ( oaCameraGroup* group )
+{
+	if ( group ) {
+		if ( group->running ) {
+			( void ) oaStopCameraGroup ( group );
+		}
+		pthread_mutex_destroy ( &group->mutex );
+		pthread_mutex_destroy ( &group->deliveryMutex );
+		pthread_mutex_destroy ( &group->setMutex );
+		free (( void* ) group );
+	}
+}
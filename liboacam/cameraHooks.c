@@ -0,0 +1,132 @@
+/*****************************************************************************
+ *
+ * cameraHooks.c -- the library's layers over the driver camera functions
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "cameraHooks.h"
+
+
+static const oaCameraFuncs*	layers[ OA_HOOK_COUNT ] = {
+	&oacamReconnectHooks,
+	&oacamAsyncControlHooks,
+	&oacamSoftBinningHooks
+};
+
+#define	OVERLAY(f)	if ( layer->f && funcs->f ) { funcs->f = layer->f; }
+
+static void
+_overlay ( oaCameraFuncs* funcs, const oaCameraFuncs* layer )
+{
+	OVERLAY( closeCamera );
+	OVERLAY( readControl );
+	OVERLAY( setControl );
+	OVERLAY( testControl );
+	OVERLAY( getControlRange );
+	OVERLAY( getControlDiscreteSet );
+	OVERLAY( startStreaming );
+	OVERLAY( stopStreaming );
+	OVERLAY( isStreaming );
+	OVERLAY( startStreamingLeased );
+	OVERLAY( setResolution );
+	OVERLAY( setROI );
+	OVERLAY( setFrameInterval );
+	OVERLAY( enumerateFrameSizes );
+	OVERLAY( enumerateFrameRates );
+	OVERLAY( getFramePixelFormat );
+	OVERLAY( testROISize );
+	OVERLAY( getMenuString );
+	OVERLAY( getAutoWBManualSetting );
+	OVERLAY( hasAuto );
+	OVERLAY( isAuto );
+	OVERLAY( startExposure );
+	OVERLAY( abortExposure );
+	OVERLAY( exposureTimeLeft );
+}
+
+
+/*
+ * Stack the layers over the functions the driver has just set up.  Each
+ * layer calls on through the functions as they were before it was added.
+ */
+
+static void
+_installHooks ( oaCamera* camera )
+{
+	SHARED_STATE*		cameraInfo = camera->_private;
+	oaCameraFuncs		funcs = camera->funcs;
+	int							i;
+
+	for ( i = OA_HOOK_COUNT - 1; i >= 0; i-- ) {
+		cameraInfo->hookNext[i] = funcs;
+		_overlay ( &funcs, layers[i] );
+	}
+	camera->funcs = funcs;
+}
+
+
+static oaCamera*
+_initCamera ( oaCameraDevice* device )
+{
+	oaCamera*		camera;
+
+	if (( camera = device->_driverInitCamera ( device ))) {
+		_installHooks ( camera );
+	}
+	return camera;
+}
+
+
+/*
+ * Called on each newly enumerated list of devices, so that every camera
+ * is opened with the layers in place before anything else can see it
+ */
+
+void
+oacamHookDevices ( CAMERA_LIST* list )
+{
+	oaCameraDevice*		device;
+	unsigned int			i;
+
+	for ( i = 0; i < list->numCameras; i++ ) {
+		device = list->cameraList[i];
+		if ( device->initCamera != _initCamera ) {
+			device->_driverInitCamera = device->initCamera;
+			device->initCamera = _initCamera;
+		}
+	}
+}
+
+
+const oaCameraFuncs*
+oacamHookNext ( oaCamera* camera, int layer )
+{
+	return &(( SHARED_STATE* ) camera->_private )->hookNext[ layer ];
+}
@@ -0,0 +1,53 @@
+/*****************************************************************************
+ *
+ * cameraHooks.h -- the library's layers over the driver camera functions
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_HOOKS_H
+#define OA_CAMERA_HOOKS_H
+
+#include <openastro/camera.h>
+
+#include "oacamprivate.h"
+
+// Reconnection, asynchronous controls and software binning each supply a
+// layer of camera functions.  They are stacked over the driver's in this
+// order, outermost first, when the camera is opened, and camera->funcs is
+// never changed again after that.  A layer only replaces the functions
+// the driver has, and passes calls straight on to the layer below until
+// its feature is in use.
+
+#define	OA_HOOK_RECONNECT				0
+#define	OA_HOOK_ASYNC_CONTROL		1
+#define	OA_HOOK_SOFT_BINNING		2
+#define	OA_HOOK_COUNT						3
+
+extern const oaCameraFuncs	oacamReconnectHooks;
+extern const oaCameraFuncs	oacamAsyncControlHooks;
+extern const oaCameraFuncs	oacamSoftBinningHooks;
+
+extern void									oacamHookDevices ( CAMERA_LIST* );
+extern const oaCameraFuncs*	oacamHookNext ( oaCamera*, int );
+
+#endif	/* OA_CAMERA_HOOKS_H */
@@ -0,0 +1,198 @@
+/*****************************************************************************
+ *
+ * cameraStats.c -- per-camera frame throughput and latency counters
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "cameraStats.h"
+
+
+static void
+_record ( oaLatencyHistogram* hist, uint64_t ns )
+{
+	uint64_t			us = ns / 1000;
+	unsigned int	b;
+
+	b = us ? 64 - __builtin_clzll ( us ) : 0;
+	if ( b >= OA_LATENCY_BUCKETS ) {
+		b = OA_LATENCY_BUCKETS - 1;
+	}
+	( void ) __atomic_add_fetch ( &hist->bucket[ b ], 1, __ATOMIC_RELAXED );
+	( void ) __atomic_add_fetch ( &hist->totalNs, ns, __ATOMIC_RELAXED );
+	( void ) __atomic_add_fetch ( &hist->count, 1, __ATOMIC_RELAXED );
+	// Only the callback thread records, so this needn't be a CAS
+	if ( ns > __atomic_load_n ( &hist->maxNs, __ATOMIC_RELAXED )) {
+		__atomic_store_n ( &hist->maxNs, ns, __ATOMIC_RELAXED );
+	}
+}
+
+
+static void
+_snapshot ( oaLatencyHistogram* tgt, oaLatencyHistogram* src )
+{
+	unsigned int	b;
+
+	tgt->count = __atomic_load_n ( &src->count, __ATOMIC_RELAXED );
+	tgt->totalNs = __atomic_load_n ( &src->totalNs, __ATOMIC_RELAXED );
+	tgt->maxNs = __atomic_load_n ( &src->maxNs, __ATOMIC_RELAXED );
+	for ( b = 0; b < OA_LATENCY_BUCKETS; b++ ) {
+		tgt->bucket[ b ] = __atomic_load_n ( &src->bucket[ b ],
+				__ATOMIC_RELAXED );
+	}
+}
+
+
+static void
+_clear ( oaLatencyHistogram* hist )
+{
+	unsigned int	b;
+
+	__atomic_store_n ( &hist->count, 0, __ATOMIC_RELAXED );
+	__atomic_store_n ( &hist->totalNs, 0, __ATOMIC_RELAXED );
+	__atomic_store_n ( &hist->maxNs, 0, __ATOMIC_RELAXED );
+	for ( b = 0; b < OA_LATENCY_BUCKETS; b++ ) {
+		__atomic_store_n ( &hist->bucket[ b ], 0, __ATOMIC_RELAXED );
+	}
+}
+
+
+void
+oacamCameraStatsInit ( SHARED_STATE* cameraInfo )
+{
+	cameraInfo->stats.resetTime = oacamMonotonicTime();
+}
+
+
+uint64_t
+oacamCallbackStarted ( SHARED_STATE* cameraInfo, CALLBACK* frame )
+{
+	OA_CAMERA_STATS*	stats = &cameraInfo->stats;
+	FRAME_METADATA*		metadata = frame->metadata;
+	uint64_t					now = oacamMonotonicTime();
+
+	( void ) __atomic_add_fetch ( &stats->framesDelivered, 1,
+			__ATOMIC_RELAXED );
+	if ( metadata && metadata->timestamp && now >= metadata->timestamp ) {
+		_record ( &stats->queueLatency, now - metadata->timestamp );
+	}
+	return now;
+}
+
+
+void
+oacamCallbackFinished ( SHARED_STATE* cameraInfo, uint64_t started )
+{
+	_record ( &cameraInfo->stats.callbackDuration,
+			oacamMonotonicTime() - started );
+}
+
+
+int
+oaGetCameraStats ( oaCamera* camera, oaCameraStats* snapshot )
+{
+	OA_CAMERA_STATS*		stats;
+
+	if ( !camera || !snapshot ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	stats = &(( SHARED_STATE* ) camera->_private )->stats;
+	snapshot->framesDelivered = __atomic_load_n ( &stats->framesDelivered,
+			__ATOMIC_RELAXED );
+	snapshot->driverDrops = __atomic_load_n ( &stats->driverDrops,
+			__ATOMIC_RELAXED );
+	snapshot->bufferDrops = __atomic_load_n ( &stats->bufferDrops,
+			__ATOMIC_RELAXED );
+	snapshot->elapsedNs = oacamMonotonicTime() - __atomic_load_n (
+			&stats->resetTime, __ATOMIC_RELAXED );
+	_snapshot ( &snapshot->queueLatency, &stats->queueLatency );
+	_snapshot ( &snapshot->callbackDuration, &stats->callbackDuration );
+	return OA_ERR_NONE;
+}
+
+
+void
+oaResetCameraStats ( oaCamera* camera )
+{
+	OA_CAMERA_STATS*		stats;
+
+	if ( camera ) {
+		stats = &(( SHARED_STATE* ) camera->_private )->stats;
+		__atomic_store_n ( &stats->framesDelivered, 0, __ATOMIC_RELAXED );
+		__atomic_store_n ( &stats->driverDrops, 0, __ATOMIC_RELAXED );
+		__atomic_store_n ( &stats->bufferDrops, 0, __ATOMIC_RELAXED );
+		_clear ( &stats->queueLatency );
+		_clear ( &stats->callbackDuration );
+		__atomic_store_n ( &stats->resetTime, oacamMonotonicTime(),
+				__ATOMIC_RELAXED );
+	}
+}
+
+
+uint64_t
+oaLatencyBucketLimit ( unsigned int b )
+{
+	if ( b >= OA_LATENCY_BUCKETS - 1 ) {
+		return UINT64_MAX;
+	}
+	return ( 1ULL << b ) * 1000;
+}
+
+
+uint64_t
+oaLatencyPercentile ( const oaLatencyHistogram* hist, double fraction )
+{
+	uint64_t			wanted, seen = 0, limit;
+	unsigned int	b;
+
+	if ( !hist || !hist->count ) {
+		return 0;
+	}
+	if ( fraction < 0.0 ) {
+		fraction = 0.0;
+	}
+	if ( fraction > 1.0 ) {
+		fraction = 1.0;
+	}
+	wanted = ( uint64_t )( fraction * hist->count + 0.5 );
+	if ( !wanted ) {
+		wanted = 1;
+	}
+	for ( b = 0; b < OA_LATENCY_BUCKETS; b++ ) {
+		seen += hist->bucket[ b ];
+		if ( seen >= wanted ) {
+			break;
+		}
+	}
+	limit = oaLatencyBucketLimit ( b );
+	return ( limit < hist->maxNs ) ? limit : hist->maxNs;
+}
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ *
+ * cameraStats.h -- per-camera frame throughput and latency counters
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_STATS_H
+#define OA_CAMERA_STATS_H
+
+#include <stdint.h>
+
+#include <openastro/camera.h>
+#include <openastro/controller.h>
+
+struct SHARED_STATE;
+
+// Every field is updated with relaxed atomics and never under a lock.
+// The drop counters may be bumped from any of a driver's threads; the
+// delivery counter and histograms only from its callback thread.
+
+typedef struct OA_CAMERA_STATS {
+	uint64_t							framesDelivered;
+	uint64_t							driverDrops;
+	uint64_t							bufferDrops;
+	uint64_t							resetTime;
+	oaLatencyHistogram		queueLatency;
+	oaLatencyHistogram		callbackDuration;
+} OA_CAMERA_STATS;
+
+// Callback threads bracket each call into the application with these.
+// The frame's metadata timestamp, if the driver stamped it, is taken as
+// the time it was dequeued.
+
+extern void				oacamCameraStatsInit ( struct SHARED_STATE* );
+extern uint64_t		oacamCallbackStarted ( struct SHARED_STATE*, CALLBACK* );
+extern void				oacamCallbackFinished ( struct SHARED_STATE*, uint64_t );
+
+#endif	/* OA_CAMERA_STATS_H */
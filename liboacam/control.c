@@ -372,6 +372,9 @@ oacamReadControl ( oaCamera* camera, int control,
   }
   pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
   retval = command.resultCode;
+  if ( OA_ERR_NONE == retval ) {
+    oacamControlCacheStore ( cameraInfo, control, val );
+  }
 
   return retval;
 }
@@ -389,6 +392,8 @@ oacamStartStreaming ( oaCamera* camera,
   oaLogInfo ( OA_LOG_CAMERA, "%s ( %p, %p, %p ): entered", __func__, camera,
 			callback, callbackArg );
 
+  oacamResetFrameMetadata ( cameraInfo );
+
   OA_CLEAR ( command );
   callbackData.callback = callback;
   callbackData.callbackArg = callbackArg;
@@ -486,6 +491,9 @@ oacamSetControl ( oaCamera* camera, int control, oaControlValue* val,
     }
     pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
     retval = command.resultCode;
+    if ( OA_ERR_NONE == retval ) {
+      oacamControlCacheStore ( cameraInfo, control, val );
+    }
   }
 
 	oaLogInfo ( OA_LOG_CAMERA, "%s: exiting", __func__ );
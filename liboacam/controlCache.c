@@ -0,0 +1,325 @@
+/*****************************************************************************
+ *
+ * controlCache.c -- per-camera cache of control values
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "controlCache.h"
+
+
+void
+oacamControlCacheInit ( SHARED_STATE* cameraInfo )
+{
+	pthread_mutex_init ( &cameraInfo->controlCache.mutex, 0 );
+}
+
+
+static OA_CACHED_CONTROL*
+_entry ( SHARED_STATE* cameraInfo, int control )
+{
+	int		modifier = OA_CAM_CTRL_MODIFIER( control );
+	int		baseVal = OA_CAM_CTRL_MODE_BASE( control );
+
+	if ( control < 0 || modifier >= OA_CAM_CTRL_MODIFIERS_LAST_P1 ||
+			baseVal >= OA_CAM_CTRL_LAST_P1 ) {
+		return 0;
+	}
+	return &cameraInfo->controlCache.entry[ modifier ][ baseVal ];
+}
+
+
+static void
+_setValue ( oaControlValue* v, unsigned int valueType, int64_t value )
+{
+	v->valueType = valueType;
+	switch ( valueType ) {
+		case OA_CTRL_TYPE_INT32:
+			v->int32 = value;
+			break;
+		case OA_CTRL_TYPE_BOOLEAN:
+			v->boolean = value;
+			break;
+		case OA_CTRL_TYPE_MENU:
+			v->menu = value;
+			break;
+		case OA_CTRL_TYPE_DISCRETE:
+			v->discrete = value;
+			break;
+		case OA_CTRL_TYPE_READONLY:
+			v->readonly = value;
+			break;
+		default:
+			v->int64 = value;
+			break;
+	}
+}
+
+
+// Called with the value just written to or read from the camera.  Only
+// the holder of the cache mutex ever writes an entry.
+
+void
+oacamControlCacheStore ( SHARED_STATE* cameraInfo, int control,
+		oaControlValue* val )
+{
+	OA_CONTROL_CACHE*					cache = &cameraInfo->controlCache;
+	OA_CACHED_CONTROL*				entry;
+	OA_CONTROL_SUBSCRIPTION		notify[ OA_CONTROL_MAX_SUBSCRIPTIONS ];
+	unsigned int							i, numNotify = 0, seq;
+	int64_t										value;
+	int												changed;
+
+	if (!( entry = _entry ( cameraInfo, control ))) {
+		return;
+	}
+	switch ( val->valueType ) {
+		case OA_CTRL_TYPE_INT32:
+		case OA_CTRL_TYPE_BOOLEAN:
+		case OA_CTRL_TYPE_MENU:
+		case OA_CTRL_TYPE_INT64:
+		case OA_CTRL_TYPE_DISCRETE:
+		case OA_CTRL_TYPE_READONLY:
+			break;
+		default:
+			return;
+	}
+	value = oacamGetControlValue ( val );
+
+	pthread_mutex_lock ( &cache->mutex );
+	changed = ( entry->value != value || entry->valueType != val->valueType ||
+			!entry->seq );
+	if ( changed ) {
+		seq = entry->seq;
+		__atomic_store_n ( &entry->seq, seq + 1, __ATOMIC_RELAXED );
+		__atomic_thread_fence ( __ATOMIC_RELEASE );
+		__atomic_store_n ( &entry->valueType, val->valueType, __ATOMIC_RELAXED );
+		__atomic_store_n ( &entry->value, value, __ATOMIC_RELAXED );
+		__atomic_store_n ( &entry->seq, seq + 2, __ATOMIC_RELEASE );
+		for ( i = 0; i < cache->numSubscriptions; i++ ) {
+			if ( cache->subscription[i].control == control ) {
+				notify[ numNotify++ ] = cache->subscription[i];
+			}
+		}
+	}
+	pthread_mutex_unlock ( &cache->mutex );
+
+	for ( i = 0; i < numNotify; i++ ) {
+		notify[i].callback ( notify[i].callbackArg, control, val );
+	}
+}
+
+
+// Reads whatever cached controls are due and returns when the next one
+// will be, or 0 if nothing is cached
+
+uint64_t
+oacamControlCacheRefresh ( oaCamera* camera )
+{
+	SHARED_STATE*				cameraInfo = camera->_private;
+	OA_CONTROL_CACHE*		cache = &cameraInfo->controlCache;
+	OA_CACHED_CONTROL*	entry;
+	oaControlValue			val;
+	uint64_t						now, next = 0;
+	unsigned int				interval;
+	int									modifier, baseVal, control;
+
+	if ( !__atomic_load_n ( &cache->numCached, __ATOMIC_RELAXED )) {
+		return 0;
+	}
+
+	for ( modifier = 0; modifier < OA_CAM_CTRL_MODIFIERS_LAST_P1; modifier++ ) {
+		for ( baseVal = 1; baseVal < OA_CAM_CTRL_LAST_P1; baseVal++ ) {
+			entry = &cache->entry[ modifier ][ baseVal ];
+			if (!( interval = __atomic_load_n ( &entry->interval,
+					__ATOMIC_RELAXED ))) {
+				continue;
+			}
+			now = oacamMonotonicTime();
+			if ( now >= entry->nextRefresh ) {
+				control = ( modifier << 8 ) | baseVal;
+				// readControl() stores the value in the cache itself
+				if ( camera->funcs.readControl ( camera, control, &val ) !=
+						OA_ERR_NONE ) {
+					oaLogWarning ( OA_LOG_CAMERA, "%s: can't read control %d",
+							__func__, control );
+				}
+				entry->nextRefresh = now + interval * 1000000ULL;
+			}
+			if ( !next || entry->nextRefresh < next ) {
+				next = entry->nextRefresh;
+			}
+		}
+	}
+	return next;
+}
+
+
+int
+oaCacheControl ( oaCamera* camera, int control, unsigned int interval )
+{
+	SHARED_STATE*				cameraInfo;
+	OA_CONTROL_CACHE*		cache;
+	OA_CACHED_CONTROL*	entry;
+	oaControlValue			val;
+	unsigned int				previous;
+	int									ret;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	cameraInfo = camera->_private;
+	cache = &cameraInfo->controlCache;
+	if (!( entry = _entry ( cameraInfo, control )) ||
+			!camera->OA_CAM_CTRL_TYPE( control )) {
+		return -OA_ERR_INVALID_CONTROL;
+	}
+
+	if ( interval ) {
+		// Prime the cache so a cached control can always be read
+		if (( ret = camera->funcs.readControl ( camera, control, &val )) !=
+				OA_ERR_NONE ) {
+			return ret;
+		}
+		if (( ret = oacamAsyncControlsStart ( camera )) != OA_ERR_NONE ) {
+			return ret;
+		}
+	}
+
+	pthread_mutex_lock ( &cache->mutex );
+	previous = entry->interval;
+	entry->nextRefresh = oacamMonotonicTime() + interval * 1000000ULL;
+	__atomic_store_n ( &entry->interval, interval, __ATOMIC_RELAXED );
+	if ( interval && !previous ) {
+		__atomic_add_fetch ( &cache->numCached, 1, __ATOMIC_RELAXED );
+	}
+	if ( !interval && previous ) {
+		__atomic_sub_fetch ( &cache->numCached, 1, __ATOMIC_RELAXED );
+	}
+	pthread_mutex_unlock ( &cache->mutex );
+
+	if ( interval ) {
+		oacamAsyncControlsWake ( cameraInfo );
+	}
+	return OA_ERR_NONE;
+}
+
+
+int
+oaReadCachedControl ( oaCamera* camera, int control, oaControlValue* val )
+{
+	OA_CACHED_CONTROL*	entry;
+	unsigned int				seq, valueType;
+	int64_t							value;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	if (!( entry = _entry ( camera->_private, control )) ||
+			!__atomic_load_n ( &entry->interval, __ATOMIC_RELAXED )) {
+		return -OA_ERR_INVALID_CONTROL;
+	}
+
+	do {
+		seq = __atomic_load_n ( &entry->seq, __ATOMIC_ACQUIRE );
+		valueType = __atomic_load_n ( &entry->valueType, __ATOMIC_RELAXED );
+		value = __atomic_load_n ( &entry->value, __ATOMIC_RELAXED );
+		__atomic_thread_fence ( __ATOMIC_ACQUIRE );
+	} while (( seq & 1 ) || seq != __atomic_load_n ( &entry->seq,
+			__ATOMIC_RELAXED ));
+
+	_setValue ( val, valueType, value );
+	return OA_ERR_NONE;
+}
+
+
+int
+oaSubscribeControl ( oaCamera* camera, int control,
+		oaControlChangeCallback callback, void* callbackArg )
+{
+	SHARED_STATE*				cameraInfo;
+	OA_CONTROL_CACHE*		cache;
+	int									ret = OA_ERR_NONE;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	cameraInfo = camera->_private;
+	cache = &cameraInfo->controlCache;
+	if ( !callback || !_entry ( cameraInfo, control )) {
+		return -OA_ERR_INVALID_CONTROL;
+	}
+
+	pthread_mutex_lock ( &cache->mutex );
+	if ( cache->numSubscriptions == OA_CONTROL_MAX_SUBSCRIPTIONS ) {
+		ret = -OA_ERR_OUT_OF_RANGE;
+	} else {
+		cache->subscription[ cache->numSubscriptions ].control = control;
+		cache->subscription[ cache->numSubscriptions ].callback = callback;
+		cache->subscription[ cache->numSubscriptions ].callbackArg =
+				callbackArg;
+		cache->numSubscriptions++;
+	}
+	pthread_mutex_unlock ( &cache->mutex );
+	return ret;
+}
+
+
+int
+oaUnsubscribeControl ( oaCamera* camera, int control,
+		oaControlChangeCallback callback, void* callbackArg )
+{
+	SHARED_STATE*				cameraInfo;
+	OA_CONTROL_CACHE*		cache;
+	unsigned int				i;
+	int									ret = -OA_ERR_INVALID_CONTROL;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	cameraInfo = camera->_private;
+	cache = &cameraInfo->controlCache;
+
+	pthread_mutex_lock ( &cache->mutex );
+	for ( i = 0; i < cache->numSubscriptions; i++ ) {
+		if ( cache->subscription[i].control == control &&
+				cache->subscription[i].callback == callback &&
+				cache->subscription[i].callbackArg == callbackArg ) {
+			cache->subscription[i] =
+					cache->subscription[ --cache->numSubscriptions ];
+			ret = OA_ERR_NONE;
+			break;
+		}
+	}
+	pthread_mutex_unlock ( &cache->mutex );
+	return ret;
+}
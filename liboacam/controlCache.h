@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *
+ * controlCache.h -- per-camera cache of control values
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_CONTROL_CACHE_H
+#define OA_CAMERA_CONTROL_CACHE_H
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+
+struct SHARED_STATE;
+
+// Each entry is a seqlock: the writer, holding mutex, makes seq odd while
+// it updates the value, so readers need no lock and simply retry if seq
+// was odd or changed under them.  interval is in milliseconds and is 0
+// for controls that aren't cached.
+
+typedef struct OA_CACHED_CONTROL {
+	unsigned int		seq;
+	unsigned int		valueType;
+	int64_t					value;
+	unsigned int		interval;
+	uint64_t				nextRefresh;
+} OA_CACHED_CONTROL;
+
+typedef struct OA_CONTROL_SUBSCRIPTION {
+	int											control;
+	oaControlChangeCallback	callback;
+	void*										callbackArg;
+} OA_CONTROL_SUBSCRIPTION;
+
+typedef struct OA_CONTROL_CACHE {
+	pthread_mutex_t						mutex;
+	OA_CACHED_CONTROL					entry[ OA_CAM_CTRL_MODIFIERS_LAST_P1 ][
+																OA_CAM_CTRL_LAST_P1 ];
+	unsigned int							numCached;
+	OA_CONTROL_SUBSCRIPTION		subscription[ OA_CONTROL_MAX_SUBSCRIPTIONS ];
+	unsigned int							numSubscriptions;
+} OA_CONTROL_CACHE;
+
+extern void			oacamControlCacheInit ( struct SHARED_STATE* );
+extern void			oacamControlCacheStore ( struct SHARED_STATE*, int,
+										oaControlValue* );
+extern uint64_t	oacamControlCacheRefresh ( oaCamera* );
+
+#endif	/* OA_CAMERA_CONTROL_CACHE_H */
@@ -0,0 +1,216 @@
+/*****************************************************************************
+ *
+ * multiCapture.c
+ *
+ * example program to capture synchronised frames from several cameras
+ *
+ * Copyright 2026
+ *   James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+#include <openastro/errno.h>
+
+// usage: multiCapture [-s seconds] [-t tolerance ms] [-o dir] [-p]
+//            camera-index ...
+//
+// Streams from every camera given at once, appending the raw frames for
+// each to its own file and writing one line per frame set to sets.csv
+// with each frame's timestamp and its offset from the earliest in the set.
+
+typedef struct {
+	unsigned int		numCameras;
+	FILE*						frameFile[ OA_CAM_GROUP_MAX ];
+	FILE*						setFile;
+	unsigned long		sets;
+} CAPTURE;
+
+void* handleFrameSet ( void*, oaFrameSet* );
+
+int
+main ( int argc, char* argv[] )
+{
+	oaCameraDevice**		cameraDevs;
+	oaCamera*						cameras[ OA_CAM_GROUP_MAX ];
+	oaCameraGroup*			group;
+	CAPTURE							capture;
+	char								path[ PATH_MAX + 1 ];
+	const char*					dir = ".";
+	unsigned int				seconds = 10, flags = 0, i;
+	double							toleranceMs = 5.0;
+	int									numCameras, index, c, ret = 1;
+
+	while (( c = getopt ( argc, argv, "s:t:o:p" )) != -1 ) {
+		switch ( c ) {
+			case 's':
+				seconds = atoi ( optarg );
+				break;
+			case 't':
+				toleranceMs = atof ( optarg );
+				break;
+			case 'o':
+				dir = optarg;
+				break;
+			case 'p':
+				flags |= OA_CAM_GROUP_PARTIAL;
+				break;
+			default:
+				fprintf ( stderr, "usage: %s [-s seconds] [-t tolerance ms] "
+						"[-o dir] [-p] camera-index ...\n", argv[0] );
+				return 1;
+		}
+	}
+	if ( optind >= argc || argc - optind > OA_CAM_GROUP_MAX ) {
+		fprintf ( stderr, "%s: give between 1 and %d camera indexes\n", argv[0],
+				OA_CAM_GROUP_MAX );
+		return 1;
+	}
+
+	memset ( &capture, 0, sizeof ( capture ));
+	memset ( cameras, 0, sizeof ( cameras ));
+
+	numCameras = oaGetCameras ( &cameraDevs, OA_CAM_FEATURE_STREAMING );
+	if ( numCameras <= 0 ) {
+		printf ( "no cameras supporting streaming are available\n" );
+		if ( !numCameras ) {
+			oaReleaseCameras ( cameraDevs );
+		}
+		return 1;
+	}
+
+	if (!( group = oaCreateCameraGroup())) {
+		oaReleaseCameras ( cameraDevs );
+		return 1;
+	}
+
+	// Cameras are opened one at a time, as some vendor SDKs are not happy
+	// being initialised from more than one thread at once
+
+	for ( i = 0; i < ( unsigned int ) ( argc - optind ); i++ ) {
+		index = atoi ( argv[ optind + i ]);
+		if ( index < 0 || index >= numCameras ) {
+			fprintf ( stderr, "no camera %d\n", index );
+			goto done;
+		}
+		if (!( cameras[i] = cameraDevs[ index ]->initCamera (
+				cameraDevs[ index ]))) {
+			fprintf ( stderr, "can't open %s\n", cameraDevs[ index ]->deviceName );
+			goto done;
+		}
+		capture.numCameras++;
+		if ( oaAddCameraToGroup ( group, cameras[i] ) != OA_ERR_NONE ) {
+			fprintf ( stderr, "can't add %s to group\n",
+					cameraDevs[ index ]->deviceName );
+			goto done;
+		}
+		snprintf ( path, PATH_MAX, "%s/camera%u.raw", dir, i );
+		if (!( capture.frameFile[i] = fopen ( path, "wb" ))) {
+			fprintf ( stderr, "can't write %s: %s\n", path, strerror ( errno ));
+			goto done;
+		}
+		printf ( "camera %u: %s\n", i, cameraDevs[ index ]->deviceName );
+	}
+
+	snprintf ( path, PATH_MAX, "%s/sets.csv", dir );
+	if (!( capture.setFile = fopen ( path, "w" ))) {
+		fprintf ( stderr, "can't write %s: %s\n", path, strerror ( errno ));
+		goto done;
+	}
+	fprintf ( capture.setFile, "set,spread_ns" );
+	for ( i = 0; i < capture.numCameras; i++ ) {
+		fprintf ( capture.setFile, ",timestamp%u,offset%u_ns", i, i );
+	}
+	fprintf ( capture.setFile, "\n" );
+
+	if ( oaStartCameraGroup ( group, ( uint64_t ) ( toleranceMs * 1000000 ),
+			handleFrameSet, &capture, flags ) != OA_ERR_NONE ) {
+		fprintf ( stderr, "can't start streaming\n" );
+		goto done;
+	}
+	sleep ( seconds );
+	( void ) oaStopCameraGroup ( group );
+
+	printf ( "%lu frame sets written, %llu frames unmatched\n", capture.sets,
+			( unsigned long long ) oaCameraGroupUnmatched ( group ));
+	ret = 0;
+
+done:
+	oaDestroyCameraGroup ( group );
+	for ( i = 0; i < OA_CAM_GROUP_MAX; i++ ) {
+		if ( capture.frameFile[i] ) {
+			fclose ( capture.frameFile[i] );
+		}
+		if ( cameras[i] ) {
+			cameras[i]->funcs.closeCamera ( cameras[i] );
+		}
+	}
+	if ( capture.setFile ) {
+		fclose ( capture.setFile );
+	}
+
+	// Release camera list
+	oaReleaseCameras ( cameraDevs );
+
+	return ret;
+}
+
+
+// Calls are never concurrent, so there's no need for locking here
+
+void*
+handleFrameSet ( void* args, oaFrameSet* set )
+{
+	CAPTURE*					capture = args;
+	FRAME_METADATA*		metadata;
+	unsigned int			i;
+
+	fprintf ( capture->setFile, "%llu,%llu",
+			( unsigned long long ) set->sequence,
+			( unsigned long long ) set->spreadNs );
+	for ( i = 0; i < capture->numCameras; i++ ) {
+		if ( set->frames[i] ) {
+			metadata = set->frames[i]->metadata;
+			fwrite ( set->frames[i]->buffer, set->frames[i]->length, 1,
+					capture->frameFile[i] );
+			fprintf ( capture->setFile, ",%llu,%llu",
+					( unsigned long long ) metadata->timestamp,
+					( unsigned long long ) ( metadata->timestamp - set->timestamp ));
+		} else {
+			fprintf ( capture->setFile, ",," );
+		}
+	}
+	fprintf ( capture->setFile, "\n" );
+	capture->sets++;
+
+	oaReleaseFrameSet ( set );
+	return 0;
+}
@@ -42,44 +42,33 @@ oacamDummyCallbackHandler ( void* param )
   oaCamera*		camera = param;
   DUMMY_STATE*		cameraInfo = camera->_private;
   CALLBACK*		callback;
-  int			exitThread = 0;
   void*			(*callbackFunc)( void*, void*, int, void* );
+  uint64_t		started;
 
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    exitThread = cameraInfo->stopCallbackThread;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-
-    if ( exitThread ) {
-      break;
-    } else {
-      // try to prevent busy-waiting
-      if ( oaDLListIsEmpty ( cameraInfo->callbackQueue )) {
-        pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-        pthread_cond_wait ( &cameraInfo->callbackQueued,
-            &cameraInfo->callbackQueueMutex );
-        pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-      }
-    }
-
-    callback = oaDLListRemoveFromHead ( cameraInfo->callbackQueue );
+    callback = oacamCallbackRingWait ( &cameraInfo->callbackRing );
     if ( callback ) {
       switch ( callback->callbackType ) {
         case OA_CALLBACK_NEW_FRAME:
-          callbackFunc = callback->callback;
-          callbackFunc ( callback->callbackArg, callback->buffer,
-              callback->bufferLen, 0 );
-          pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-          cameraInfo->buffersFree++;
-          pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+          if ( !oacamLeaseFrame (( SHARED_STATE* ) cameraInfo, callback,
+              callback->buffer )) {
+            callbackFunc = callback->callback;
+            started = oacamCallbackStarted (( SHARED_STATE* ) cameraInfo,
+                callback );
+            callbackFunc ( callback->callbackArg, callback->buffer,
+                callback->bufferLen, callback->metadata );
+            oacamCallbackFinished (( SHARED_STATE* ) cameraInfo, started );
+            OA_RELEASE_BUFFER ( cameraInfo );
+          }
           break;
         default:
           oaLogError ( OA_LOG_CAMERA, "%s: unexpected callback type %d",
               __func__, callback->callbackType );
           break;
       }
+      oacamCallbackRingRelease ( &cameraInfo->callbackRing );
     }
-  } while ( 1 );
+  } while ( callback );
 
   return 0;
 }
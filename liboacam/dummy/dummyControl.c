@@ -82,6 +82,14 @@ oaDummyCameraTestControl ( oaCamera* camera, int control,
       break;
     }
 
+    case OA_CAM_CTRL_FRAME_FORMAT:
+      val_s32 = val->discrete;
+      if ( val_s32 >= 0 && val_s32 < OA_PIX_FMT_LAST_P1 &&
+          camera->frameFormats[ val_s32 ] ) {
+        return OA_ERR_NONE;
+      }
+      break;
+
     // This lot are all boolean, so we'll take any value
     case OA_CAM_CTRL_HFLIP:
     case OA_CAM_CTRL_VFLIP:
@@ -27,8 +27,11 @@
 #include <oa_common.h>
 
 #include <pthread.h>
+#include <time.h>
+#include <math.h>
 
 #include <openastro/camera.h>
+#include <openastro/video/formats.h>
 #include <sys/time.h>
 
 #include "oacamprivate.h"
@@ -41,6 +44,13 @@ static int	_processSetControl ( oaCamera*, OA_COMMAND* );
 static int	_processGetControl ( oaCamera*, OA_COMMAND* );
 static int	_processStreamingStart ( DUMMY_STATE*, OA_COMMAND* );
 static int	_processStreamingStop ( DUMMY_STATE*, OA_COMMAND* );
+static int	_frameDue ( DUMMY_STATE* );
+static void	_deliverFrame ( oaCamera* );
+
+// While waiting for the next frame the thread still wakes this often to
+// look for commands
+#define	DUMMY_COMMAND_POLL_NS	10000000ULL
+#define	DUMMY_BUFFER_WAIT_NS	1000000ULL
 
 
 void*
@@ -50,8 +60,7 @@ oacamDummyController ( void* param )
   DUMMY_STATE*		cameraInfo = camera->_private;
   OA_COMMAND*		command;
   int			exitThread = 0;
-  int			resultCode, nextBuffer, buffersFree;
-  int			imageBufferLength;
+  int			resultCode;
   int			streaming = 0;
 
   do {
@@ -103,44 +112,13 @@ oacamDummyController ( void* param )
       }
     } while ( command );
 
-    if ( streaming ) {
-
-      pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-      imageBufferLength = cameraInfo->imageBufferLength;
-      pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+    pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+    streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
+    exitThread = cameraInfo->stopControllerThread;
+    pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
 
-      pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-      buffersFree = cameraInfo->buffersFree;
-      pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-
-      if ( buffersFree ) {
-        nextBuffer = cameraInfo->nextBuffer;
-
-        pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-        exitThread = cameraInfo->stopControllerThread;
-        pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
-
-        if ( !exitThread ) {
-          cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
-              OA_CALLBACK_NEW_FRAME;
-          cameraInfo->frameCallbacks[ nextBuffer ].callback =
-              cameraInfo->streamingCallback.callback;
-          cameraInfo->frameCallbacks[ nextBuffer ].callbackArg =
-              cameraInfo->streamingCallback.callbackArg;
-          cameraInfo->frameCallbacks[ nextBuffer ].buffer =
-              cameraInfo->buffers[ nextBuffer ].start;
-          cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
-              imageBufferLength;
-          oaDLListAddToTail ( cameraInfo->callbackQueue,
-              &cameraInfo->frameCallbacks[ nextBuffer ]);
-          pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-          cameraInfo->buffersFree--;
-          cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
-              cameraInfo->configuredBuffers;
-          pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-          pthread_cond_broadcast ( &cameraInfo->callbackQueued );
-        }
-      }
+    if ( streaming && !exitThread && _frameDue ( cameraInfo )) {
+      _deliverFrame ( camera );
     }
   } while ( !exitThread );
 
@@ -148,6 +126,117 @@ oacamDummyController ( void* param )
 }
 
 
+static uint64_t
+_frameInterval ( DUMMY_STATE* cameraInfo )
+{
+  uint64_t	interval;
+
+  if ( cameraInfo->scene.config.unthrottled ) {
+    return 0;
+  }
+  if ( cameraInfo->scene.config.frameRate > 0 ) {
+    return 1000000000.0 / cameraInfo->scene.config.frameRate;
+  }
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  interval = ( uint64_t ) cameraInfo->currentAbsoluteExposure * 1000;
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+  return interval;
+}
+
+
+// Returns non-zero when the next frame should be produced, having slept
+// for as much of the wait as can be done without leaving commands
+// unanswered.  A paced camera that has fallen behind (because rendering
+// is slower than the frame rate) picks up from now rather than trying to
+// deliver the missed frames in a burst.
+
+static int
+_frameDue ( DUMMY_STATE* cameraInfo )
+{
+  uint64_t	interval, now, wake;
+
+  now = oacamMonotonicTime();
+  if (!( interval = _frameInterval ( cameraInfo ))) {
+    if ( OA_BUFFERS_FREE ( cameraInfo )) {
+      return 1;
+    }
+    // Unthrottled frames wait for the application rather than dropping
+    oacamSleepUntil ( now + DUMMY_BUFFER_WAIT_NS );
+    return 0;
+  }
+
+  if ( now >= cameraInfo->nextFrameTime ) {
+    cameraInfo->nextFrameTime += interval;
+    if ( cameraInfo->nextFrameTime <= now ) {
+      cameraInfo->nextFrameTime = now + interval;
+    }
+    return 1;
+  }
+
+  wake = now + DUMMY_COMMAND_POLL_NS;
+  if ( wake > cameraInfo->nextFrameTime ) {
+    wake = cameraInfo->nextFrameTime;
+  }
+  oacamSleepUntil ( wake );
+  return 0;
+}
+
+
+static void
+_deliverFrame ( oaCamera* camera )
+{
+  DUMMY_STATE*		cameraInfo = camera->_private;
+  COMMON_INFO*		commonInfo = camera->_common;
+  FRAME_METADATA*	metadata;
+  int			nextBuffer, imageBufferLength, format;
+  uint32_t		exposure;
+  double		scale;
+
+  if ( !OA_BUFFERS_FREE ( cameraInfo )) {
+    // The sensor doesn't wait, so this frame is lost
+    OA_DROP_FRAME_NO_BUFFER (( SHARED_STATE* ) cameraInfo );
+    return;
+  }
+
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  imageBufferLength = cameraInfo->imageBufferLength;
+  exposure = cameraInfo->currentAbsoluteExposure;
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+  format = cameraInfo->currentFrameFormat;
+  nextBuffer = cameraInfo->nextBuffer;
+
+  // Signal is proportional to exposure, and gain is 20dB per 100 steps
+  scale = ( double ) exposure / commonInfo->OA_CAM_CTRL_DEF(
+      OA_CAM_CTRL_EXPOSURE_ABSOLUTE ) * pow ( 10.0, (( double )
+      cameraInfo->currentGain - commonInfo->OA_CAM_CTRL_DEF(
+      OA_CAM_CTRL_GAIN )) / 100.0 );
+  oacamDummySceneRender ( &cameraInfo->scene,
+      cameraInfo->buffers[ nextBuffer ].start, format, scale,
+      cameraInfo->currentBrightness / 256.0, cameraInfo->currentHFlip,
+      cameraInfo->currentVFlip );
+
+  metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
+  metadata->exposure = exposure;
+  metadata->exposureValid = 1;
+  metadata->gain = cameraInfo->currentGain;
+  metadata->gainValid = 1;
+  cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
+  cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
+      OA_CALLBACK_NEW_FRAME;
+  cameraInfo->frameCallbacks[ nextBuffer ].callback =
+      cameraInfo->streamingCallback.callback;
+  cameraInfo->frameCallbacks[ nextBuffer ].callbackArg =
+      cameraInfo->streamingCallback.callbackArg;
+  cameraInfo->frameCallbacks[ nextBuffer ].buffer =
+      cameraInfo->buffers[ nextBuffer ].start;
+  cameraInfo->frameCallbacks[ nextBuffer ].bufferLen = imageBufferLength;
+  oacamCallbackRingPush ( &cameraInfo->callbackRing,
+      &cameraInfo->frameCallbacks[ nextBuffer ]);
+  OA_CLAIM_BUFFER ( cameraInfo );
+  cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;
+}
+
+
 static int
 _processSetControl ( oaCamera* camera, OA_COMMAND* command )
 {
@@ -186,6 +275,15 @@ _processSetControl ( oaCamera* camera, OA_COMMAND* command )
 
     case OA_CAM_CTRL_VFLIP:
       cameraInfo->currentVFlip = val->boolean;
+      break;
+
+    case OA_CAM_CTRL_FRAME_FORMAT:
+      cameraInfo->currentFrameFormat = val->discrete;
+      pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+      cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
+          cameraInfo->maxResolutionY *
+          oaFrameFormats[ val->discrete ].bytesPerPixel;
+      pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
       break;
 
 		/* May do this one later
@@ -249,6 +347,11 @@ _processGetControl ( oaCamera* camera, OA_COMMAND* command )
       val->boolean = cameraInfo->currentVFlip;
 			break;
 
+    case OA_CAM_CTRL_FRAME_FORMAT:
+			val->valueType = OA_CTRL_TYPE_DISCRETE;
+      val->discrete = cameraInfo->currentFrameFormat;
+			break;
+
 		/* Maybe later
     case OA_CAM_CTRL_TEMP_SETPOINT:
 			val->valueType = OA_CTRL_TYPE_INT32;
@@ -281,6 +384,9 @@ _processStreamingStart ( DUMMY_STATE* cameraInfo, OA_COMMAND* command )
 
   cameraInfo->streamingCallback.callback = cb->callback;
   cameraInfo->streamingCallback.callbackArg = cb->callbackArg;
+  // The first frame arrives once a whole frame interval has elapsed
+  cameraInfo->nextFrameTime = oacamMonotonicTime() +
+      _frameInterval ( cameraInfo );
   pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
   cameraInfo->runMode = CAM_RUN_MODE_STREAMING;
   pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
@@ -0,0 +1,428 @@
+/*****************************************************************************
+ *
+ * dummyScene.c -- synthetic frame generator for the dummy cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <math.h>
+
+#include <openastro/camera.h>
+#include <openastro/demosaic.h>
+#include <openastro/errno.h>
+#include <openastro/util.h>
+#include <openastro/video/formats.h>
+
+#include "dummyScene.h"
+
+
+#define	DUMMY_FULL_WELL			20000.0f
+#define	DUMMY_MAX_PSF_SIGMA	16.0
+#define	DUMMY_MAX_PSF_WIDTH	(( int ) ( 8 * DUMMY_MAX_PSF_SIGMA ) + 3 )
+
+static oaDummyScene		sceneConfig = {
+	.scene				= OA_DUMMY_SCENE_DEFAULT,
+	.numStars			= 400,
+	.psfSigma			= 1.5,
+	.driftX				= 0.05,
+	.driftY				= 0.02,
+	.planetRadius	= 0,
+	.seeing				= 1.0,
+	.background		= 0.01,
+	.readNoise		= 8.0,
+	.shotNoise		= 1,
+	.frameRate		= 0,
+	.unthrottled	= 0,
+	.seed					= 0
+};
+
+// Colour filter site to channel ( 0 = R, 1 = G, 2 = B ) for each of the
+// 2x2 patterns, indexed by OA_DEMOSAIC_* - 1, then row and column
+
+static const unsigned char	cfaChannel[4][2][2] = {
+	{{ 0, 1 }, { 1, 2 }},		// RGGB
+	{{ 2, 1 }, { 1, 0 }},		// BGGR
+	{{ 1, 0 }, { 2, 1 }},		// GRBG
+	{{ 1, 2 }, { 0, 1 }}		// GBRG
+};
+
+
+int
+oaSetDummyScene ( const oaDummyScene* config )
+{
+	if ( !config || config->scene > OA_DUMMY_SCENE_FLAT ||
+			config->psfSigma <= 0 || config->psfSigma > DUMMY_MAX_PSF_SIGMA ||
+			config->planetRadius < 0 || config->seeing < 0 ||
+			config->background < 0 || config->readNoise < 0 ||
+			config->frameRate < 0 ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	sceneConfig = *config;
+	return OA_ERR_NONE;
+}
+
+
+void
+oaGetDummyScene ( oaDummyScene* config )
+{
+	if ( config ) {
+		*config = sceneConfig;
+	}
+}
+
+
+static inline uint64_t
+_random ( DUMMY_SCENE* scene )
+{
+	// xorshift64*
+	scene->rng ^= scene->rng >> 12;
+	scene->rng ^= scene->rng << 25;
+	scene->rng ^= scene->rng >> 27;
+	return scene->rng * 0x2545f4914f6cdd1dULL;
+}
+
+
+static inline double
+_uniform ( DUMMY_SCENE* scene )
+{
+	return ( _random ( scene ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+
+static inline float
+_gauss ( DUMMY_SCENE* scene )
+{
+	return scene->gauss[ _random ( scene ) >> ( 64 - DUMMY_GAUSS_TABLE_BITS )];
+}
+
+
+int
+oacamDummySceneInit ( DUMMY_SCENE* scene, int cameraType, unsigned int width,
+		unsigned int height )
+{
+	unsigned int	i;
+	double				u1, u2, u;
+
+	scene->config = sceneConfig;
+	scene->width = width;
+	scene->height = height;
+	scene->stars = 0;
+	scene->signal = 0;
+	scene->offsetX = scene->offsetY = 0;
+	scene->rng = scene->config.seed ? scene->config.seed : 0x9e3779b97f4a7c15ULL;
+	scene->type = scene->config.scene;
+	if ( OA_DUMMY_SCENE_DEFAULT == scene->type ) {
+		scene->type = cameraType ? OA_DUMMY_SCENE_STARS : OA_DUMMY_SCENE_PLANET;
+	}
+
+	// A table of normal deviates is plenty for noise and far cheaper
+	// than generating a fresh one for every pixel
+	for ( i = 0; i < DUMMY_GAUSS_TABLE_SIZE; i++ ) {
+		do {
+			u1 = _uniform ( scene );
+		} while ( u1 == 0 );
+		u2 = _uniform ( scene );
+		scene->gauss[i] = sqrt ( -2.0 * log ( u1 )) * cos ( 2 * M_PI * u2 );
+	}
+
+	if ( OA_DUMMY_SCENE_PLANET == scene->type ) {
+		scene->tint[0] = 1.0;
+		scene->tint[1] = 0.88;
+		scene->tint[2] = 0.7;
+	} else {
+		scene->tint[0] = scene->tint[1] = scene->tint[2] = 1.0;
+	}
+
+	if ( !width || !height ) {
+		return OA_ERR_NONE;
+	}
+
+	if (!( scene->signal = malloc ( width * height * sizeof ( float )))) {
+		oaLogError ( OA_LOG_CAMERA, "%s: malloc of scene failed", __func__ );
+		return -OA_ERR_MEM_ALLOC;
+	}
+
+	if ( OA_DUMMY_SCENE_STARS == scene->type && scene->config.numStars ) {
+		if (!( scene->stars = calloc ( scene->config.numStars,
+				sizeof ( DUMMY_STAR )))) {
+			oaLogError ( OA_LOG_CAMERA, "%s: calloc of stars failed", __func__ );
+			free (( void* ) scene->signal );
+			scene->signal = 0;
+			return -OA_ERR_MEM_ALLOC;
+		}
+		// Mostly faint stars, with the odd one bright enough to saturate
+		for ( i = 0; i < scene->config.numStars; i++ ) {
+			scene->stars[i].x = _uniform ( scene ) * width;
+			scene->stars[i].y = _uniform ( scene ) * height;
+			u = _uniform ( scene );
+			scene->stars[i].peak = 0.02 + 1.2 * u * u * u * u;
+		}
+	}
+
+	return OA_ERR_NONE;
+}
+
+
+void
+oacamDummySceneFree ( DUMMY_SCENE* scene )
+{
+	if ( scene->stars ) {
+		free (( void* ) scene->stars );
+		scene->stars = 0;
+	}
+	if ( scene->signal ) {
+		free (( void* ) scene->signal );
+		scene->signal = 0;
+	}
+}
+
+
+static double
+_wrap ( double v, double limit )
+{
+	v = fmod ( v, limit );
+	return ( v < 0 ) ? v + limit : v;
+}
+
+
+static void
+_addStar ( DUMMY_SCENE* scene, double cx, double cy, double peak )
+{
+	float		wx[ DUMMY_MAX_PSF_WIDTH ], wy[ DUMMY_MAX_PSF_WIDTH ];
+	double	sigma = scene->config.psfSigma;
+	double	k = -0.5 / ( sigma * sigma );
+	float*	row;
+	int			r, x0, x1, y0, y1, x, y;
+
+	r = ( int ) ceil ( 4 * sigma );
+	x0 = ( int ) floor ( cx ) - r;
+	x1 = ( int ) floor ( cx ) + r;
+	y0 = ( int ) floor ( cy ) - r;
+	y1 = ( int ) floor ( cy ) + r;
+	if ( x0 < 0 ) {
+		x0 = 0;
+	}
+	if ( y0 < 0 ) {
+		y0 = 0;
+	}
+	if ( x1 >= ( int ) scene->width ) {
+		x1 = scene->width - 1;
+	}
+	if ( y1 >= ( int ) scene->height ) {
+		y1 = scene->height - 1;
+	}
+	if ( x0 > x1 || y0 > y1 ) {
+		return;
+	}
+
+	// The profile is separable, so it only needs 2r+1 exponentials per axis
+	for ( x = x0; x <= x1; x++ ) {
+		wx[ x - x0 ] = peak * exp ( k * ( x + 0.5 - cx ) * ( x + 0.5 - cx ));
+	}
+	for ( y = y0; y <= y1; y++ ) {
+		wy[ y - y0 ] = exp ( k * ( y + 0.5 - cy ) * ( y + 0.5 - cy ));
+	}
+	for ( y = y0; y <= y1; y++ ) {
+		row = scene->signal + y * scene->width;
+		for ( x = x0; x <= x1; x++ ) {
+			row[x] += wx[ x - x0 ] * wy[ y - y0 ];
+		}
+	}
+}
+
+
+static void
+_addPlanet ( DUMMY_SCENE* scene, double cx, double cy )
+{
+	double	radius = scene->config.planetRadius;
+	double	dx, dy, r, mu, edge, band;
+	float*	row;
+	int			x0, x1, y0, y1, x, y;
+
+	if ( radius <= 0 ) {
+		radius = ( scene->width < scene->height ? scene->width :
+				scene->height ) / 6.0;
+	}
+
+	x0 = ( int ) floor ( cx - radius - 1 );
+	x1 = ( int ) ceil ( cx + radius + 1 );
+	y0 = ( int ) floor ( cy - radius - 1 );
+	y1 = ( int ) ceil ( cy + radius + 1 );
+	if ( x0 < 0 ) {
+		x0 = 0;
+	}
+	if ( y0 < 0 ) {
+		y0 = 0;
+	}
+	if ( x1 >= ( int ) scene->width ) {
+		x1 = scene->width - 1;
+	}
+	if ( y1 >= ( int ) scene->height ) {
+		y1 = scene->height - 1;
+	}
+
+	for ( y = y0; y <= y1; y++ ) {
+		row = scene->signal + y * scene->width;
+		dy = y + 0.5 - cy;
+		// Belts and zones parallel to the equator
+		band = 1.0 - 0.15 * ( 0.5 + 0.5 * cos ( dy / radius * M_PI * 7 ));
+		for ( x = x0; x <= x1; x++ ) {
+			dx = x + 0.5 - cx;
+			r = sqrt ( dx * dx + dy * dy );
+			if ( r < radius + 0.5 ) {
+				// Limb darkening, with the edge pixels partially covered
+				mu = ( r < radius ) ? sqrt ( 1.0 - ( r * r ) / ( radius * radius )) : 0;
+				edge = radius + 0.5 - r;
+				if ( edge > 1 ) {
+					edge = 1;
+				}
+				row[x] += 0.6 * ( 0.35 + 0.65 * mu ) * band * edge;
+			}
+		}
+	}
+}
+
+
+static void
+_drawScene ( DUMMY_SCENE* scene )
+{
+	unsigned int	i, n = scene->width * scene->height;
+	double				jx, jy, bg = scene->config.background;
+
+	jx = scene->config.seeing * _gauss ( scene );
+	jy = scene->config.seeing * _gauss ( scene );
+	scene->offsetX = _wrap ( scene->offsetX + scene->config.driftX,
+			scene->width );
+	scene->offsetY = _wrap ( scene->offsetY + scene->config.driftY,
+			scene->height );
+
+	for ( i = 0; i < n; i++ ) {
+		scene->signal[i] = bg;
+	}
+
+	switch ( scene->type ) {
+		case OA_DUMMY_SCENE_STARS:
+			for ( i = 0; i < scene->config.numStars; i++ ) {
+				_addStar ( scene,
+						_wrap ( scene->stars[i].x + scene->offsetX + jx, scene->width ),
+						_wrap ( scene->stars[i].y + scene->offsetY + jy, scene->height ),
+						scene->stars[i].peak );
+			}
+			break;
+		case OA_DUMMY_SCENE_PLANET:
+			_addPlanet ( scene,
+					_wrap ( scene->width / 2.0 + scene->offsetX + jx, scene->width ),
+					_wrap ( scene->height / 2.0 + scene->offsetY + jy, scene->height ));
+			break;
+	}
+}
+
+
+void
+oacamDummySceneRender ( DUMMY_SCENE* scene, void* buffer, int format,
+		double scale, double offset, int hflip, int vflip )
+{
+	frameFormatInfo*	fmt = &oaFrameFormats[ format ];
+	unsigned char*		p8 = buffer;
+	const float*			row;
+	float							readNoise, maxValue, s, v;
+	unsigned int			x, y, sx, c, nc, bps, little, pattern;
+	unsigned char			chans[3];
+	uint16_t					u;
+
+	if ( !scene->signal || !buffer ) {
+		return;
+	}
+
+	nc = 1;
+	pattern = 0;
+	if ( fmt->fullColour ) {
+		if ( format != OA_PIX_FMT_RGB24 && format != OA_PIX_FMT_BGR24 ) {
+			return;
+		}
+		nc = 3;
+	} else {
+		if ( fmt->rawColour ) {
+			if ( fmt->cfaPattern < OA_DEMOSAIC_RGGB ||
+					fmt->cfaPattern > OA_DEMOSAIC_GBRG ) {
+				return;
+			}
+			pattern = fmt->cfaPattern;
+		} else if ( !fmt->monochrome ) {
+			return;
+		}
+	}
+	if ( fmt->packed || ( fmt->bitsPerPixel != 8 * nc &&
+			fmt->bitsPerPixel != 16 * nc )) {
+		return;
+	}
+	bps = fmt->bitsPerPixel / nc / 8;
+	little = fmt->littleEndian;
+	maxValue = ( bps == 2 ) ? 65535.0f : 255.0f;
+	readNoise = scene->config.readNoise / 65535.0f;
+
+	_drawScene ( scene );
+
+	chans[0] = ( format == OA_PIX_FMT_BGR24 ) ? 2 : 0;
+	chans[1] = 1;
+	chans[2] = ( format == OA_PIX_FMT_BGR24 ) ? 0 : 2;
+
+	for ( y = 0; y < scene->height; y++ ) {
+		row = scene->signal + ( vflip ? scene->height - 1 - y : y ) *
+				scene->width;
+		for ( x = 0; x < scene->width; x++ ) {
+			sx = hflip ? scene->width - 1 - x : x;
+			s = row[ sx ] * scale;
+			for ( c = 0; c < nc; c++ ) {
+				if ( pattern ) {
+					v = s * scene->tint[ cfaChannel[ pattern - 1 ][ y & 1 ][ x & 1 ]];
+				} else if ( nc == 3 ) {
+					v = s * scene->tint[ chans[c] ];
+				} else {
+					v = s;
+				}
+				if ( scene->config.shotNoise && v > 0 ) {
+					v += sqrtf ( v / DUMMY_FULL_WELL ) * _gauss ( scene );
+				}
+				v += readNoise * _gauss ( scene ) + offset;
+				if ( v < 0 ) {
+					v = 0;
+				}
+				if ( v > 1 ) {
+					v = 1;
+				}
+				u = ( uint16_t ) ( v * maxValue + 0.5f );
+				if ( bps == 1 ) {
+					*p8++ = u;
+				} else if ( little ) {
+					*p8++ = u & 0xff;
+					*p8++ = u >> 8;
+				} else {
+					*p8++ = u >> 8;
+					*p8++ = u & 0xff;
+				}
+			}
+		}
+	}
+}
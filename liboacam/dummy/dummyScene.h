@@ -0,0 +1,67 @@
+/*****************************************************************************
+ *
+ * dummyScene.h -- synthetic frame generator for the dummy cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_DUMMY_SCENE_H
+#define OA_DUMMY_SCENE_H
+
+#include <stdint.h>
+
+#include <openastro/camera.h>
+
+#define	DUMMY_GAUSS_TABLE_BITS	12
+#define	DUMMY_GAUSS_TABLE_SIZE	( 1 << DUMMY_GAUSS_TABLE_BITS )
+
+typedef struct DUMMY_STAR {
+	float					x;
+	float					y;
+	float					peak;
+} DUMMY_STAR;
+
+typedef struct DUMMY_SCENE {
+	oaDummyScene	config;
+	unsigned int	type;
+	unsigned int	width;
+	unsigned int	height;
+	DUMMY_STAR*		stars;
+	float*				signal;
+	double				offsetX;
+	double				offsetY;
+	float					tint[3];
+	uint64_t			rng;
+	float					gauss[ DUMMY_GAUSS_TABLE_SIZE ];
+} DUMMY_SCENE;
+
+// scale is the signal multiplier for the current exposure and gain, and
+// offset a fraction of full scale added to every pixel.  Formats other
+// than 8 and 16-bit mono, 2x2 Bayer, RGB24 and BGR24 are not rendered.
+
+extern int		oacamDummySceneInit ( DUMMY_SCENE*, int, unsigned int,
+									unsigned int );
+extern void		oacamDummySceneFree ( DUMMY_SCENE* );
+extern void		oacamDummySceneRender ( DUMMY_SCENE*, void*, int, double,
+									double, int, int );
+
+#endif	/* OA_DUMMY_SCENE_H */
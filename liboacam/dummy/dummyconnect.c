@@ -94,54 +94,58 @@ oaDummyInitCamera ( oaCameraDevice* device )
   cameraInfo->buffers = 0;
   cameraInfo->configuredBuffers = 0;
 
-  multiplier = cameraInfo->cameraType ? 2 : 1;
+  // Buffers have room for the widest format on offer, which is RGB24 for
+  // the planetary camera and 16-bit mono for the DSO one
+  multiplier = cameraInfo->cameraType ? 2 : 3;
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
-      cameraInfo->maxResolutionY * multiplier;
-  cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffers failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
+      cameraInfo->maxResolutionY *
+      oaFrameFormats[ cameraInfo->currentFrameFormat ].bytesPerPixel;
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->maxResolutionX * cameraInfo->maxResolutionY *
+      multiplier ) != OA_ERR_NONE ) {
+    for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
+      if ( cameraInfo->frameSizes[j].sizes ) {
+        free (( void* ) cameraInfo->frameSizes[j].sizes );
       }
-      for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
-        if ( cameraInfo->frameSizes[j].sizes ) {
-          free (( void* ) cameraInfo->frameSizes[j].sizes );
-        }
+    }
+    FREE_DATA_STRUCTS;
+    return 0;
+  }
+
+  if ( oacamDummySceneInit ( &cameraInfo->scene, cameraInfo->cameraType,
+      cameraInfo->maxResolutionX, cameraInfo->maxResolutionY ) !=
+      OA_ERR_NONE ) {
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
+    for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
+      if ( cameraInfo->frameSizes[j].sizes ) {
+        free (( void* ) cameraInfo->frameSizes[j].sizes );
       }
-      FREE_DATA_STRUCTS;
-      return 0;
     }
+    FREE_DATA_STRUCTS;
+    return 0;
   }
-  cameraInfo->nextBuffer = 0;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamDummyController, ( void* ) camera )) {
-    for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-      free (( void* ) cameraInfo->buffers[i].start );
-    }
+    oacamDummySceneFree ( &cameraInfo->scene );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     for ( i = 1; i <= OA_MAX_BINNING; i++ ) {
       if ( cameraInfo->frameSizes[i].sizes )
         free (( void* ) cameraInfo->frameSizes[i].sizes );
     }
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
 
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamDummyCallbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -149,15 +153,14 @@ oaDummyInitCamera ( oaCameraDevice* device )
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
-    for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-      free (( void* ) cameraInfo->buffers[i].start );
-    }
+    oacamDummySceneFree ( &cameraInfo->scene );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     for ( i = 1; i <= OA_MAX_BINNING; i++ ) {
       if ( cameraInfo->frameSizes[i].sizes )
         free (( void* ) cameraInfo->frameSizes[i].sizes );
     }
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -202,25 +205,19 @@ oaDummyCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamDummySceneFree ( &cameraInfo->scene );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
       if ( cameraInfo->frameSizes[j].sizes )
         free (( void* ) cameraInfo->frameSizes[j].sizes );
     }
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
     free (( void* ) camera );
@@ -327,6 +324,11 @@ _initAstroCamera ( oaCamera* camera, DUMMY_STATE* cameraInfo,
 	switch ( cameraInfo->cameraType ) {
 		case 0:  // planetary
       camera->frameFormats[ OA_PIX_FMT_GRBG8 ] = 1;
+      camera->frameFormats[ OA_PIX_FMT_GRBG16LE ] = 1;
+      camera->frameFormats[ OA_PIX_FMT_GREY8 ] = 1;
+      camera->frameFormats[ OA_PIX_FMT_GREY16LE ] = 1;
+      camera->frameFormats[ OA_PIX_FMT_RGB24 ] = 1;
+      cameraInfo->currentFrameFormat = OA_PIX_FMT_GRBG8;
 			camera->features.flags |= OA_CAM_FEATURE_RAW_MODE;
 			cameraInfo->maxResolutionX = 1280;
 			cameraInfo->maxResolutionY = 960;
@@ -392,6 +394,9 @@ _initAstroCamera ( oaCamera* camera, DUMMY_STATE* cameraInfo,
 
 		case 1:  // DSO
       camera->frameFormats[ OA_PIX_FMT_GREY16BE ] = 16;
+      camera->frameFormats[ OA_PIX_FMT_GREY16LE ] = 1;
+      camera->frameFormats[ OA_PIX_FMT_GREY8 ] = 1;
+      cameraInfo->currentFrameFormat = OA_PIX_FMT_GREY16BE;
 			camera->features.flags |= OA_CAM_FEATURE_DEMOSAIC_MODE;
 			cameraInfo->maxResolutionX = 4656;
 			cameraInfo->maxResolutionY = 3250;
@@ -30,6 +30,7 @@
 #include <openastro/util.h>
 
 #include "sharedState.h"
+#include "dummyScene.h"
 
 
 typedef struct DUMMY_STATE {
@@ -39,8 +40,6 @@ typedef struct DUMMY_STATE {
 	int					numIsoOptions;
 	int					numShutterSpeedOptions;
 
-  // buffering for image transfers
-  frameBuffer*			buffers;
   // camera settings
   int			binMode;
   uint32_t		currentBrightness;
@@ -50,6 +49,10 @@ typedef struct DUMMY_STATE {
   uint32_t		currentVFlip;
   // image settings
 	int			binModes[16];
+	int			currentFrameFormat;
+	// synthetic frames
+	DUMMY_SCENE		scene;
+	uint64_t		nextFrameTime;
 } DUMMY_STATE;
 
 #endif	/* OA_DUMMY_STATE_H */
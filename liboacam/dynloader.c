@@ -0,0 +1,143 @@
+/*****************************************************************************
+ *
+ * dynloader.c -- shared lazy loading of vendor SDK libraries
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#if HAVE_LIBDL
+#if HAVE_DLFCN_H
+#include <dlfcn.h>
+#endif
+#if HAVE_LIMITS_H
+#include <limits.h>
+#endif
+
+#include <openastro/errno.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "dynloader.h"
+
+
+static void*
+_open ( const char* libName )
+{
+	void*		handle;
+	char		libPath[ PATH_MAX+1 ];
+#ifdef RETRY_SO_WITHOUT_PATH
+	int			tryWithoutPath = 1;
+#endif
+
+	*libPath = 0;
+	dlerror();
+	if ( installPathRoot ) {
+		( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
+	}
+#ifdef SHLIB_PATH
+	( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
+#endif
+#ifdef RETRY_SO_WITHOUT_PATH
+retry:
+#endif
+	( void ) strncat ( libPath, libName, PATH_MAX );
+
+	if (!( handle = dlopen ( libPath, RTLD_LAZY ))) {
+#ifdef RETRY_SO_WITHOUT_PATH
+		if ( tryWithoutPath ) {
+			tryWithoutPath = 0;
+			*libPath = 0;
+			goto retry;
+		}
+#endif
+		oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
+				libPath, dlerror());
+	}
+	return handle;
+}
+
+
+static int
+_resolve ( OA_DL_LIBRARY* lib, const OA_DL_SYMBOL* sym )
+{
+	char*		error;
+
+	for ( ; sym && sym->name; sym++ ) {
+		*sym->addr = dlsym ( lib->handle, sym->name );
+		if (( error = dlerror())) {
+			if ( sym->optional ) {
+				oaLogInfo ( OA_LOG_CAMERA, "%s: %s has no %s", __func__,
+						lib->libName, sym->name );
+				*sym->addr = 0;
+				continue;
+			}
+			oaLogError ( OA_LOG_CAMERA, "%s: %s DL error: %s", __func__,
+					lib->libName, error );
+			*sym->addr = 0;
+			return OA_ERR_SYMBOL_NOT_FOUND;
+		}
+	}
+	return OA_ERR_NONE;
+}
+
+
+int
+oacamDLLoad ( OA_DL_LIBRARY* lib, int level )
+{
+	int		ret = OA_ERR_NONE;
+
+	pthread_mutex_lock ( &lib->lock );
+
+	if ( !lib->handle ) {
+		if (!( lib->handle = _open ( lib->libName ))) {
+			pthread_mutex_unlock ( &lib->lock );
+			return OA_ERR_LIBRARY_NOT_FOUND;
+		}
+		lib->resolved = 0;
+	}
+
+	if ( lib->resolved < OA_DL_ENUMERATE ) {
+		if (( ret = _resolve ( lib, lib->enumSymbols )) != OA_ERR_NONE ) {
+			// Nothing from this library can be used, so let it go
+			dlclose ( lib->handle );
+			lib->handle = 0;
+			pthread_mutex_unlock ( &lib->lock );
+			return ret;
+		}
+		lib->resolved = OA_DL_ENUMERATE;
+	}
+
+	// A missing symbol here leaves enumeration usable, so the handle is
+	// kept open and the next attempt will simply try again
+	if ( level >= OA_DL_ALL && lib->resolved < OA_DL_ALL ) {
+		if (( ret = _resolve ( lib, lib->otherSymbols )) == OA_ERR_NONE ) {
+			lib->resolved = OA_DL_ALL;
+		}
+	}
+
+	pthread_mutex_unlock ( &lib->lock );
+	return ret;
+}
+
+#endif	/* HAVE_LIBDL */
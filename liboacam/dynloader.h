@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *
+ * dynloader.h -- shared lazy loading of vendor SDK libraries
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_DYNLOADER_H
+#define OA_DYNLOADER_H
+
+#include <pthread.h>
+
+// Vendor SDKs are opened on first use and their symbols resolved in two
+// stages.  Enumeration needs only the handful of calls that count and
+// describe the attached cameras, so those are resolved first.  The rest
+// of the table is resolved when a camera is actually initialised.  The
+// handle and resolved pointers are kept for the life of the process, so
+// later rescans cost nothing.
+//
+// Optional symbols are for calls that only some versions of an SDK
+// provide.  They are left null if missing and the driver has to check
+// for them itself.
+
+typedef struct OA_DL_SYMBOL {
+	void**				addr;
+	const char*		name;
+	int						optional;
+} OA_DL_SYMBOL;
+
+#define	OA_DL_SYM(s)		{ ( void** ) &p_##s, #s, 0 }
+#define	OA_DL_OPT_SYM(s)	{ ( void** ) &p_##s, #s, 1 }
+#define	OA_DL_END				{ 0, 0, 0 }
+
+#define	OA_DL_ENUMERATE		1
+#define	OA_DL_ALL					2
+
+typedef struct OA_DL_LIBRARY {
+	const char*					libName;
+	const OA_DL_SYMBOL*	enumSymbols;
+	const OA_DL_SYMBOL*	otherSymbols;
+	void*								handle;
+	int									resolved;
+	pthread_mutex_t			lock;
+} OA_DL_LIBRARY;
+
+#define	OA_DL_LIBRARY_INIT(n,e,o)	{ n, e, o, 0, 0, PTHREAD_MUTEX_INITIALIZER }
+
+extern int		oacamDLLoad ( OA_DL_LIBRARY*, int );
+
+#endif	/* OA_DYNLOADER_H */
@@ -161,8 +161,6 @@
 #define	EUVC_REG_CAMERA_TYPE	0x1a
 #define	EUVC_REG_FRAME_RATE	0x3a
 
-#define EUVC_NUM_TRANSFER_BUFS	100
-
 
 struct euvccam {
   unsigned int	productId;
@@ -1261,7 +1261,7 @@ oaEUVCInitCamera ( oaCameraDevice* device )
   // euvcUsbReadRegister call
 
   pthread_mutex_init ( &cameraInfo->usbMutex, 0 );
-  pthread_mutex_init ( &cameraInfo->videoCallbackMutex, 0 );
+  oacamUsbStreamInit ( &cameraInfo->usbStream );
   cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
 
   // Set up the status transfer and callback
@@ -1315,8 +1315,8 @@ oaEUVCInitCamera ( oaCameraDevice* device )
     return 0;
   }
 
-  pthread_create ( &cameraInfo->eventHandler, 0, _euvcEventHandler,
-      ( void* ) cameraInfo );
+  oacamCreateThread ( &cameraInfo->eventHandler, OA_CAM_THREAD_EVENTS,
+      _euvcEventHandler, ( void* ) cameraInfo );
 
   camera->interface = device->interface;
   cameraInfo->index = devInfo->devIndex;
@@ -1327,10 +1327,11 @@ oaEUVCInitCamera ( oaCameraDevice* device )
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY * cameraInfo->bytesPerPixel;
 
-  if (!( cameraInfo->buffers = calloc ( OA_CAM_BUFFERS,
-      sizeof ( frameBuffer )))) {
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength + OA_USB_STREAM_HEADROOM ) !=
+      OA_ERR_NONE ) {
     void* dummy;
-    oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffer array failed in %s",
+    oaLogError ( OA_LOG_CAMERA, "%s: buffer allocation failed in %s",
         __func__ );
 		libusb_cancel_transfer ( cameraInfo->statusTransfer );
     cameraInfo->stopCallbackThread = 1;
@@ -1357,59 +1358,16 @@ oaEUVCInitCamera ( oaCameraDevice* device )
   }
 	camera->features.flags |= OA_CAM_FEATURE_FIXED_FRAME_SIZES;
 
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-			void* dummy;
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-			libusb_cancel_transfer ( cameraInfo->statusTransfer );
-			cameraInfo->stopCallbackThread = 1;
-			pthread_join ( cameraInfo->eventHandler, &dummy );
-			libusb_free_transfer ( cameraInfo->statusTransfer );
-			libusb_free_config_descriptor ( deviceConfig );
-			if ( cameraInfo->reattachStreamIface ) {
-				libusb_attach_kernel_driver ( usbHandle,
-						cameraInfo->streamInterfaceNo );
-			}
-			libusb_release_interface ( usbHandle, cameraInfo->streamInterfaceNo );
-			if ( cameraInfo->reattachControlIface ) {
-				libusb_attach_kernel_driver ( usbHandle,
-						cameraInfo->controlInterfaceNo );
-			}
-			libusb_release_interface ( usbHandle, cameraInfo->controlInterfaceNo );
-			libusb_exit ( cameraInfo->usbContext );
-			for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
-				if ( cameraInfo->frameSizes[ j ].numSizes ) {
-					free (( void* ) cameraInfo->frameSizes[ j ].sizes );
-					free (( void* ) cameraInfo->frameInfo[ j ]);
-				}
-			}
-      free (( void* ) cameraInfo->buffers );
-      FREE_DATA_STRUCTS;
-      return 0;
-    }
-  }
-
-  cameraInfo->buffersFree = cameraInfo->configuredBuffers;
   cameraInfo->currentExposure = EUVC_DEFAULT_EXPOSURE * 1000;
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamEUVCcontroller, ( void* ) camera )) {
 		void* dummy;
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		libusb_cancel_transfer ( cameraInfo->statusTransfer );
 		cameraInfo->stopCallbackThread = 1;
 		pthread_join ( cameraInfo->eventHandler, &dummy );
@@ -1430,23 +1388,21 @@ oaEUVCInitCamera ( oaCameraDevice* device )
 				free (( void* ) cameraInfo->frameInfo[ j ]);
 			}
 		}
-    free (( void* ) cameraInfo->buffers );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
 
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamEUVCcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
     cameraInfo->stopControllerThread = 1;
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		libusb_cancel_transfer ( cameraInfo->statusTransfer );
 		cameraInfo->stopCallbackThread = 1;
 		pthread_join ( cameraInfo->eventHandler, &dummy );
@@ -1467,9 +1423,8 @@ oaEUVCInitCamera ( oaCameraDevice* device )
 				free (( void* ) cameraInfo->frameInfo[ j ]);
 			}
 		}
-    free (( void* ) cameraInfo->buffers );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -1528,11 +1483,13 @@ oaEUVCCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     pthread_join ( cameraInfo->eventHandler, &dummy );
 
+    oacamUsbStreamFree ( &cameraInfo->usbStream );
+
 		if ( cameraInfo->reattachStreamIface ) {
 			libusb_attach_kernel_driver ( cameraInfo->usbHandle,
 					cameraInfo->streamInterfaceNo );
@@ -1548,14 +1505,7 @@ oaEUVCCloseCamera ( oaCamera* camera )
     libusb_close ( cameraInfo->usbHandle );
     libusb_exit ( cameraInfo->usbContext );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
-    free (( void* ) cameraInfo->buffers );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
@@ -48,7 +48,7 @@ static int	_processSetROI ( oaCamera*, OA_COMMAND* );
 static int	_processStreamingStart ( oaCamera*, OA_COMMAND* );
 static int	_processStreamingStop ( EUVC_STATE*, OA_COMMAND* );
 static int      _processSetFrameInterval ( oaCamera*, OA_COMMAND* );
-static void	_processPayload ( oaCamera*, unsigned char*, unsigned int );
+static void	_processPayload ( void*, unsigned char*, unsigned int );
 static void	_releaseFrame ( EUVC_STATE* );
 static void	_doSetFrameRate ( EUVC_STATE*, unsigned int, unsigned int );
 
@@ -1134,101 +1134,12 @@ _processSetROI ( oaCamera* camera, OA_COMMAND* command )
 }
 
 
-libusb_transfer_cb_fn
-_euvcVideoStreamCallback ( struct libusb_transfer* transfer )
-{
-  oaCamera*	camera = transfer->user_data;
-  EUVC_STATE*	cameraInfo = camera->_private;
-  int		resubmit = 1, streaming;
-
-  switch ( transfer->status ) {
-
-    case LIBUSB_TRANSFER_COMPLETED:
-      if ( transfer->num_iso_packets == 0 ) { // bulk mode transfer
-        _processPayload ( camera, transfer->buffer, transfer->actual_length );
-      } else {
-        oaLogError ( OA_LOG_CAMERA, "%s: Unexpected isochronous transfer",
-						__func__ );
-      }
-      break;
-
-    case LIBUSB_TRANSFER_CANCELLED:
-    case LIBUSB_TRANSFER_ERROR:
-    case LIBUSB_TRANSFER_NO_DEVICE:
-    {
-      int i;
-
-      pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-
-      for ( i = 0; i < EUVC_NUM_TRANSFER_BUFS; i++ ) {
-        if ( cameraInfo->transfers[i] == transfer ) {
-          free ( transfer->buffer );
-          libusb_free_transfer ( transfer );
-          cameraInfo->transfers[i] = 0;
-          break;
-        }
-      }
-
-      if ( EUVC_NUM_TRANSFER_BUFS == i ) {
-        oaLogError ( OA_LOG_CAMERA, "%s: transfer %p not found; not freeing!",
-						__func__, transfer );
-      }
-
-      resubmit = 0;
-
-      pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-
-      break;
-    }
-    case LIBUSB_TRANSFER_TIMED_OUT:
-      break;
-
-    case LIBUSB_TRANSFER_STALL:
-    case LIBUSB_TRANSFER_OVERFLOW:
-      oaLogError ( OA_LOG_CAMERA, "%s: retrying transfer, status = %d (%s)",
-          __func__, transfer->status, libusb_error_name ( transfer->status ));
-      break;
-  }
-
-  if ( resubmit ) {
-    pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-    streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
-    if ( streaming ) {
-      libusb_submit_transfer ( transfer );
-    } else {
-      int i;
-      pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-      // Mark transfer deleted
-      for ( i = 0; i < EUVC_NUM_TRANSFER_BUFS; i++ ) {
-        if ( cameraInfo->transfers[i] == transfer ) {
-          oaLogError ( OA_LOG_CAMERA, "%s: Freeing orphan transfer %d (%p)",
-							__func__, i, transfer );
-          free ( transfer->buffer );
-          libusb_free_transfer ( transfer );
-          cameraInfo->transfers[i] = 0;
-        }
-      }
-      if ( EUVC_NUM_TRANSFER_BUFS == i ) {
-        oaLogError ( OA_LOG_CAMERA,
-						"%s: orphan transfer %p not found; not freeing!", __func__,
-						transfer );
-      }
-      pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-    }
-  }
-
-  return 0;
-}
-
-
 static int
 _processStreamingStart ( oaCamera* camera, OA_COMMAND* command )
 {
   EUVC_STATE*			cameraInfo = camera->_private;
   CALLBACK*			cb;
-  int				txId, ret, txBufferSize, numTxBuffers;
-  struct libusb_transfer*	transfer;
+  int				ret, txBufferSize;
 
   if ( cameraInfo->runMode != CAM_RUN_MODE_STOPPED ) {
     return -OA_ERR_INVALID_COMMAND;
@@ -1246,51 +1157,16 @@ _processStreamingStart ( oaCamera* camera, OA_COMMAND* command )
     txBufferSize *= 2.5;
   }
 #endif
-  // This is a guess based on experimentation
-  numTxBuffers = 200 * 1024 * 1024 / txBufferSize;
-  if ( numTxBuffers < 8 ) {
-    numTxBuffers = 8;
-  }
-  if ( numTxBuffers > 100 ) {
-    numTxBuffers = 100;
-  }
-  for ( txId = 0; txId < EUVC_NUM_TRANSFER_BUFS; txId++ ) {
-    if ( txId < numTxBuffers ) {
-      transfer = libusb_alloc_transfer(0);
-      cameraInfo->transfers[ txId ] = transfer;
-      if (!( cameraInfo->transferBuffers [ txId ] =
-          malloc ( txBufferSize ))) {
-        oaLogError ( OA_LOG_CAMERA, "%s: malloc failed.  Need to free buffer",
-						__func__ );
-        return -OA_ERR_SYSTEM_ERROR;
-      }
-      libusb_fill_bulk_transfer ( transfer, cameraInfo->usbHandle,
-          USB_BULK_EP_IN, cameraInfo->transferBuffers [ txId ],
-          txBufferSize, ( libusb_transfer_cb_fn ) _euvcVideoStreamCallback,
-          camera,
-          USB_BULK_TIMEOUT );
-    } else {
-      cameraInfo->transfers[ txId ] = 0;
-    }
-  }
-
-  for ( txId = 0; txId < numTxBuffers; txId++ ) {
-    if (( ret = libusb_submit_transfer ( cameraInfo->transfers [ txId ]))) {
-      break;
-    }
-  }
-
-  // free up any transfer buffers that we're not using
-  if ( ret && txId > 0 ) {
-    for ( ; txId < EUVC_NUM_TRANSFER_BUFS; txId++) {
-      if ( cameraInfo->transfers[ txId ] ) {
-        if ( cameraInfo->transfers[ txId ]->buffer ) {
-          free ( cameraInfo->transfers[ txId ]->buffer );
-        }
-        libusb_free_transfer ( cameraInfo->transfers[ txId ]);
-        cameraInfo->transfers[ txId ] = 0;
-      }
-    }
+  // Half the frame buffers are kept for transfers to land in and the
+  // rest for frames waiting on the application.  Each transfer carries a
+  // whole frame with its header landing in the space before the frame
+  cameraInfo->receivedBytes = 0;
+  if (( ret = oacamUsbStreamStart ( &cameraInfo->usbStream,
+      ( SHARED_STATE* ) cameraInfo, cameraInfo->usbHandle, USB_BULK_EP_IN,
+      USB_BULK_TIMEOUT, txBufferSize, cameraInfo->configuredBuffers / 2,
+      cameraInfo->imageBufferLength, OA_USB_STREAM_HEADROOM,
+      &cameraInfo->receivedBytes, _processPayload, camera )) != OA_ERR_NONE ) {
+    return ret;
   }
 
   pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
@@ -1304,7 +1180,7 @@ _processStreamingStart ( oaCamera* camera, OA_COMMAND* command )
 static int
 _processStreamingStop ( EUVC_STATE* cameraInfo, OA_COMMAND* command )
 {
-  int		queueEmpty, i, res, allReleased;
+  int		queueEmpty;
 
   if ( cameraInfo->runMode != CAM_RUN_MODE_STREAMING ) {
     return -OA_ERR_INVALID_COMMAND;
@@ -1314,32 +1190,7 @@ _processStreamingStop ( EUVC_STATE* cameraInfo, OA_COMMAND* command )
   cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
   pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
 
-  pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-  for ( i = 0; i < EUVC_NUM_TRANSFER_BUFS; i++ ) {
-    if ( cameraInfo->transfers[i] ) {
-      res = libusb_cancel_transfer ( cameraInfo->transfers[i] );
-      if ( res < 0 && res != LIBUSB_ERROR_NOT_FOUND ) {
-        free ( cameraInfo->transfers[i]->buffer );
-        libusb_free_transfer ( cameraInfo->transfers[i] );
-        cameraInfo->transfers[i] = 0;
-      }
-    }
-  }
-  pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-
-  do {
-    allReleased = 1;
-    for ( i = 0; i < EUVC_NUM_TRANSFER_BUFS && allReleased; i++ ) {
-      pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-      if ( cameraInfo->transfers[i] ) {
-        allReleased = 0;
-      }
-      pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-    }
-    if ( !allReleased ) {
-      usleep ( 100 ); // FIX ME -- lazy.  should use a pthread condition?
-    }
-  } while ( !allReleased );
+  oacamUsbStreamStop ( &cameraInfo->usbStream );
 
   // We wait here until the callback queue has drained otherwise a future
   // close of the camera could rip the image frame out from underneath the
@@ -1347,9 +1198,7 @@ _processStreamingStop ( EUVC_STATE* cameraInfo, OA_COMMAND* command )
 
   queueEmpty = 0;
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( OA_CAM_BUFFERS == cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    queueEmpty = ( cameraInfo->configuredBuffers == OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
     if ( !queueEmpty ) {
       usleep ( 100 );  // lazy.  should use a condition or something similar
     }
@@ -1392,12 +1241,14 @@ _processSetFrameInterval ( oaCamera* camera, OA_COMMAND* command )
 
 
 static void
-_processPayload ( oaCamera* camera, unsigned char* buffer, unsigned int len )
+_processPayload ( void* arg, unsigned char* buffer, unsigned int len )
 {
+  oaCamera*		camera = arg;
   EUVC_STATE*		cameraInfo = camera->_private;
   size_t		headerLength, dataLength;
   uint8_t		headerInfo;
   unsigned int		buffersFree;
+  unsigned char*	dest;
 
   if ( 0 == len ) {
     return;
@@ -1411,6 +1262,9 @@ _processPayload ( oaCamera* camera, unsigned char* buffer, unsigned int len )
     return;
   }
   dataLength = len - headerLength;
+  if ( headerLength != cameraInfo->usbStream.headroom ) {
+    oacamUsbStreamSetHeadroom ( &cameraInfo->usbStream, headerLength );
+  }
   if ( headerLength < 2 ) {
     headerInfo = 0;
   } else {
@@ -1430,14 +1284,18 @@ _processPayload ( oaCamera* camera, unsigned char* buffer, unsigned int len )
   }
 
   if ( dataLength > 0 ) {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    buffersFree = cameraInfo->buffersFree;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    buffersFree = OA_BUFFERS_FREE ( cameraInfo );
+    dest = oacamUsbStreamFrameStart ( &cameraInfo->usbStream,
+        cameraInfo->nextBuffer ) + cameraInfo->receivedBytes;
+    // The data normally arrives where it belongs.  If it hasn't, it can't
+    // be moved into a buffer that another transfer is yet to land in
     if ( buffersFree && ( cameraInfo->receivedBytes + dataLength ) <=
-        cameraInfo->imageBufferLength ) {
-      memcpy (( unsigned char* ) cameraInfo->buffers[
-          cameraInfo->nextBuffer ].start + cameraInfo->receivedBytes,
-          buffer + headerLength, dataLength );
+        cameraInfo->imageBufferLength && ( buffer + headerLength == dest ||
+        !oacamUsbStreamBufferBusy ( &cameraInfo->usbStream,
+        cameraInfo->nextBuffer ))) {
+      if ( buffer + headerLength != dest ) {
+        memmove ( dest, buffer + headerLength, dataLength );
+      }
       cameraInfo->receivedBytes += dataLength;
       if ( headerInfo & 0x2 ) { // EOF
         _releaseFrame ( cameraInfo );
@@ -1445,6 +1303,11 @@ _processPayload ( oaCamera* camera, unsigned char* buffer, unsigned int len )
     } else {
       pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
       cameraInfo->droppedFrames++;
+      if ( buffersFree ) {
+        OA_DROP_FRAME ( cameraInfo );
+      } else {
+        OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
+      }
       cameraInfo->receivedBytes = 0;
       pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
     }
@@ -1457,6 +1320,8 @@ _releaseFrame ( EUVC_STATE* cameraInfo )
 {
   int		nextBuffer = cameraInfo->nextBuffer;
 
+  cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+      oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
   cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
       OA_CALLBACK_NEW_FRAME;
   cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -1464,17 +1329,14 @@ _releaseFrame ( EUVC_STATE* cameraInfo )
   cameraInfo->frameCallbacks[ nextBuffer ].callbackArg =
       cameraInfo->streamingCallback.callbackArg;
   cameraInfo->frameCallbacks[ nextBuffer ].buffer =
-      cameraInfo->buffers[ nextBuffer ].start;
+      oacamUsbStreamFrameStart ( &cameraInfo->usbStream, nextBuffer );
   cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
       cameraInfo->imageBufferLength;
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  oaDLListAddToTail ( cameraInfo->callbackQueue,
+  oacamCallbackRingPush ( &cameraInfo->callbackRing,
       &cameraInfo->frameCallbacks[ nextBuffer ]);
-  cameraInfo->buffersFree--;
+  OA_CLAIM_BUFFER ( cameraInfo );
   cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;
   cameraInfo->receivedBytes = 0;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-  pthread_cond_broadcast ( &cameraInfo->callbackQueued );
 }
 
 
@@ -33,6 +33,7 @@
 #include <pthread.h>
 
 #include "sharedState.h"
+#include "usbStream.h"
 
 typedef struct EUVC_STATE {
 
@@ -60,9 +61,7 @@ typedef struct EUVC_STATE {
 	int							reattachStreamIface;
   // video mode settings
   // buffering for image transfers
-  frameBuffer*		buffers;
-  struct libusb_transfer* transfers[ EUVC_NUM_TRANSFER_BUFS ];
-  unsigned char*	transferBuffers[ EUVC_NUM_TRANSFER_BUFS ];
+  OA_USB_STREAM		usbStream;
   // camera status
   unsigned int          isColour;
   unsigned int          frameFormat;
@@ -96,7 +95,6 @@ typedef struct EUVC_STATE {
   pthread_mutex_t       usbMutex;
   pthread_t		eventHandler;
 
-  pthread_mutex_t	videoCallbackMutex;
 	// discrete auto exposure menu item ids
 	unsigned int		numAutoExposureItems;
 	int64_t					autoExposureMenuItems[8];
@@ -0,0 +1,574 @@
+/*****************************************************************************
+ *
+ * exposureSequence.c -- run sequences of exposures with changing settings
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#include <oa_common.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "exposureSequence.h"
+
+
+// A single shot exposure that hasn't been delivered this long after it
+// should have finished is assumed lost and is taken again
+
+#define	SHOT_TIMEOUT_NS		2000000000ULL
+#define	SHOT_RETRIES			3
+
+
+void
+oacamExposureSequenceInit ( SHARED_STATE* cameraInfo )
+{
+	OA_EXPOSURE_SEQUENCE*	seq = &cameraInfo->exposureSequence;
+
+	pthread_mutex_init ( &seq->mutex, 0 );
+	pthread_cond_init ( &seq->shotDone, 0 );
+}
+
+
+static int
+_fillValue ( oaCamera* camera, int control, int64_t value,
+		oaControlValue* val )
+{
+	OA_CLEAR ( *val );
+	val->valueType = camera->OA_CAM_CTRL_TYPE( control );
+	switch ( val->valueType ) {
+		case OA_CTRL_TYPE_INT32:
+			val->int32 = value;
+			break;
+		case OA_CTRL_TYPE_INT64:
+			val->int64 = value;
+			break;
+		default:
+			return -OA_ERR_INVALID_CONTROL;
+	}
+	return OA_ERR_NONE;
+}
+
+
+// Exposures are in microseconds
+
+static uint64_t
+_exposureNs ( OA_EXPOSURE_SEQUENCE* seq )
+{
+	return seq->exposure > 0 ? ( uint64_t ) seq->exposure * 1000 : 0;
+}
+
+
+// Called with the mutex held, for the first frame taken with a new step's
+// settings
+
+static void
+_recordSwitch ( OA_EXPOSURE_SEQUENCE* seq, uint64_t timestamp )
+{
+	oaExposureSequenceStatus*	status = &seq->status;
+	uint64_t									ns = 0;
+
+	if ( !seq->lastFrameAt ) {
+		return;
+	}
+	if ( timestamp > seq->lastFrameAt + _exposureNs ( seq )) {
+		ns = timestamp - seq->lastFrameAt - _exposureNs ( seq );
+	}
+	if ( !status->switches || ns < status->minSwitchNs ) {
+		status->minSwitchNs = ns;
+	}
+	if ( ns > status->maxSwitchNs ) {
+		status->maxSwitchNs = ns;
+	}
+	status->totalSwitchNs += ns;
+	status->switches++;
+}
+
+
+// Called with the mutex held.  Tags the frame with its place in the
+// sequence and moves on, returning a mask of the controls that need to
+// change for the next frame: 1 for the exposure and 2 for the gain.
+
+static int
+_frameTaken ( OA_EXPOSURE_SEQUENCE* seq, FRAME_METADATA* metadata,
+		uint64_t timestamp )
+{
+	oaExposureStep*		next;
+	int								changes = 0;
+
+	if ( metadata ) {
+		metadata->sequenceStepValid = 1;
+		metadata->sequenceStep = seq->step;
+		metadata->sequenceFrame = seq->frame;
+		metadata->sequenceLoop = seq->loop;
+		if ( !metadata->exposureValid && seq->exposure != OA_SEQ_UNCHANGED ) {
+			metadata->exposureValid = 1;
+			metadata->exposure = seq->exposure;
+		}
+		if ( !metadata->gainValid && seq->gain != OA_SEQ_UNCHANGED ) {
+			metadata->gainValid = 1;
+			metadata->gain = seq->gain;
+		}
+	}
+	seq->status.framesDelivered++;
+	seq->lastFrameAt = timestamp;
+
+	if ( ++seq->frame < seq->steps[ seq->step ].count ) {
+		return 0;
+	}
+
+	seq->frame = 0;
+	if ( ++seq->step == seq->numSteps ) {
+		seq->step = 0;
+		if ( ++seq->loop == seq->loops ) {
+			seq->status.running = 0;
+			return 0;
+		}
+	}
+
+	next = &seq->steps[ seq->step ];
+	if ( next->exposure != OA_SEQ_UNCHANGED && next->exposure != seq->exposure ) {
+		seq->exposure = next->exposure;
+		changes |= 1;
+	}
+	if ( next->gain != OA_SEQ_UNCHANGED && next->gain != seq->gain ) {
+		seq->gain = next->gain;
+		changes |= 2;
+	}
+	return changes;
+}
+
+
+static int
+_setControls ( oaCamera* camera, OA_EXPOSURE_SEQUENCE* seq, int changes )
+{
+	oaControlValue	val;
+	int							ret;
+
+	if ( changes & 1 ) {
+		if (( ret = _fillValue ( camera, OA_CAM_CTRL_EXPOSURE_ABSOLUTE,
+				seq->exposure, &val )) != OA_ERR_NONE ||
+				( ret = camera->funcs.setControl ( camera,
+				OA_CAM_CTRL_EXPOSURE_ABSOLUTE, &val, 0 )) != OA_ERR_NONE ) {
+			return ret;
+		}
+	}
+	if ( changes & 2 ) {
+		if (( ret = _fillValue ( camera, OA_CAM_CTRL_GAIN, seq->gain,
+				&val )) != OA_ERR_NONE || ( ret = camera->funcs.setControl ( camera,
+				OA_CAM_CTRL_GAIN, &val, 0 )) != OA_ERR_NONE ) {
+			return ret;
+		}
+	}
+	return OA_ERR_NONE;
+}
+
+
+static void
+_failed ( OA_EXPOSURE_SEQUENCE* seq, int err )
+{
+	oaLogError ( OA_LOG_CAMERA, "%s: sequence stopped, error %d", __func__,
+			err );
+	seq->status.error = err;
+	seq->status.running = 0;
+}
+
+
+// Streaming mode.  Changes are handed to the camera as asynchronous
+// control requests, so they are made by its own threads between frames
+// without the frame callback having to wait for them.
+
+static void
+_requestComplete ( void* arg, oaControlRequest* request, int control,
+		oaControlValue* value, int result )
+{
+	OA_EXPOSURE_SEQUENCE*	seq = arg;
+
+	pthread_mutex_lock ( &seq->mutex );
+	if ( seq->requestsPending ) {
+		if ( result != OA_ERR_NONE ) {
+			_failed ( seq, result );
+		}
+		if ( !--seq->requestsPending ) {
+			seq->appliedAt = oacamMonotonicTime();
+		}
+	}
+	pthread_mutex_unlock ( &seq->mutex );
+	oaReleaseControlRequest ( request );
+}
+
+
+static void
+_requestChanges ( oaCamera* camera, OA_EXPOSURE_SEQUENCE* seq, int changes )
+{
+	oaControlValue		val;
+	int								control, ret;
+
+	for ( control = 1; control <= 2; control++ ) {
+		if (!( changes & control )) {
+			continue;
+		}
+		if ( control == 1 ) {
+			ret = _fillValue ( camera, OA_CAM_CTRL_EXPOSURE_ABSOLUTE,
+					seq->exposure, &val );
+		} else {
+			ret = _fillValue ( camera, OA_CAM_CTRL_GAIN, seq->gain, &val );
+		}
+		if ( ret == OA_ERR_NONE && !oaSetControlAsync ( camera, control == 1 ?
+				OA_CAM_CTRL_EXPOSURE_ABSOLUTE : OA_CAM_CTRL_GAIN, &val,
+				_requestComplete, seq )) {
+			ret = -OA_ERR_MEM_ALLOC;
+		}
+		if ( ret != OA_ERR_NONE ) {
+			pthread_mutex_lock ( &seq->mutex );
+			_failed ( seq, ret );
+			seq->requestsPending--;
+			pthread_mutex_unlock ( &seq->mutex );
+		}
+	}
+}
+
+
+// A frame belongs to the new step once every change has been made and
+// the frame was started after that.  If the driver says what exposure it
+// used, that has to agree as well.
+
+static int
+_settled ( OA_EXPOSURE_SEQUENCE* seq, FRAME_METADATA* metadata,
+		uint64_t timestamp )
+{
+	if ( seq->requestsPending ) {
+		return 0;
+	}
+	if ( timestamp < seq->appliedAt + _exposureNs ( seq )) {
+		return 0;
+	}
+	if ( metadata && metadata->exposureValid &&
+			seq->exposure != OA_SEQ_UNCHANGED &&
+			metadata->exposure != seq->exposure ) {
+		return 0;
+	}
+	return 1;
+}
+
+
+static void*
+_streamedFrame ( void* arg, void* buffer, int length, void* data )
+{
+	SHARED_STATE*					cameraInfo = arg;
+	OA_EXPOSURE_SEQUENCE*	seq = &cameraInfo->exposureSequence;
+	FRAME_METADATA*				metadata = data;
+	uint64_t							timestamp;
+	int										changes;
+
+	timestamp = ( metadata && metadata->timestamp ) ? metadata->timestamp :
+			oacamMonotonicTime();
+
+	pthread_mutex_lock ( &seq->mutex );
+	if ( !seq->status.running ) {
+		pthread_mutex_unlock ( &seq->mutex );
+		return 0;
+	}
+	if ( seq->switching ) {
+		if ( !_settled ( seq, metadata, timestamp )) {
+			seq->status.transitionFrames++;
+			pthread_mutex_unlock ( &seq->mutex );
+			return 0;
+		}
+		seq->switching = 0;
+		_recordSwitch ( seq, timestamp );
+	}
+	if (( changes = _frameTaken ( seq, metadata, timestamp ))) {
+		seq->switching = 1;
+		seq->requestsPending = ( changes & 1 ) + (( changes & 2 ) >> 1 );
+	}
+	pthread_mutex_unlock ( &seq->mutex );
+
+	if ( changes ) {
+		_requestChanges ( seq->camera, seq, changes );
+	}
+	return seq->callback ( seq->callbackArg, buffer, length, data );
+}
+
+
+// Single shot mode.  The thread sets the controls and starts each
+// exposure in turn, so no frame is ever taken with the wrong settings.
+
+static void*
+_shotFrame ( void* arg, void* buffer, int length, void* data )
+{
+	SHARED_STATE*					cameraInfo = arg;
+	OA_EXPOSURE_SEQUENCE*	seq = &cameraInfo->exposureSequence;
+	FRAME_METADATA*				metadata = data;
+	uint64_t							timestamp;
+	int										deliver;
+
+	timestamp = ( metadata && metadata->timestamp ) ? metadata->timestamp :
+			oacamMonotonicTime();
+
+	pthread_mutex_lock ( &seq->mutex );
+	if (( deliver = seq->status.running )) {
+		if ( seq->switching ) {
+			seq->switching = 0;
+			_recordSwitch ( seq, timestamp );
+		}
+		if (( seq->nextChanges = _frameTaken ( seq, metadata, timestamp ))) {
+			seq->switching = 1;
+		}
+	}
+	pthread_mutex_unlock ( &seq->mutex );
+
+	if ( deliver ) {
+		( void ) seq->callback ( seq->callbackArg, buffer, length, data );
+	}
+
+	pthread_mutex_lock ( &seq->mutex );
+	seq->shotComplete = 1;
+	pthread_cond_signal ( &seq->shotDone );
+	pthread_mutex_unlock ( &seq->mutex );
+	return 0;
+}
+
+
+static void*
+_shotThread ( void* param )
+{
+	SHARED_STATE*					cameraInfo = param;
+	OA_EXPOSURE_SEQUENCE*	seq = &cameraInfo->exposureSequence;
+	oaCamera*							camera = seq->camera;
+	struct timespec				deadline;
+	uint64_t							timeout;
+	unsigned int					retries = 0;
+	int										changes = 0, ret;
+
+	pthread_mutex_lock ( &seq->mutex );
+	while ( !seq->stop && seq->status.running ) {
+		seq->shotComplete = 0;
+		pthread_mutex_unlock ( &seq->mutex );
+
+		if (( ret = _setControls ( camera, seq, changes )) == OA_ERR_NONE ) {
+			ret = camera->funcs.startExposure ( camera, _shotFrame, cameraInfo );
+		}
+		changes = 0;
+
+		pthread_mutex_lock ( &seq->mutex );
+		if ( ret != OA_ERR_NONE ) {
+			_failed ( seq, ret );
+			break;
+		}
+
+		// The condition variable runs on the wall clock
+		timeout = _exposureNs ( seq ) + SHOT_TIMEOUT_NS;
+		( void ) clock_gettime ( CLOCK_REALTIME, &deadline );
+		timeout += deadline.tv_nsec;
+		deadline.tv_sec += timeout / 1000000000ULL;
+		deadline.tv_nsec = timeout % 1000000000ULL;
+		ret = 0;
+		while ( !seq->shotComplete && !seq->stop && ret != ETIMEDOUT ) {
+			ret = pthread_cond_timedwait ( &seq->shotDone, &seq->mutex,
+					&deadline );
+		}
+		if ( !seq->shotComplete ) {
+			pthread_mutex_unlock ( &seq->mutex );
+			( void ) camera->funcs.abortExposure ( camera );
+			pthread_mutex_lock ( &seq->mutex );
+		}
+		if ( !seq->shotComplete ) {
+			if ( seq->stop ) {
+				break;
+			}
+			// Most likely the driver had no free buffer for the frame
+			seq->status.transitionFrames++;
+			if ( ++retries == SHOT_RETRIES ) {
+				_failed ( seq, -OA_ERR_CAMERA_IO );
+				break;
+			}
+			continue;
+		}
+		retries = 0;
+		changes = seq->nextChanges;
+	}
+	pthread_mutex_unlock ( &seq->mutex );
+	return 0;
+}
+
+
+int
+oaStartExposureSequence ( oaCamera* camera, const oaExposureStep* steps,
+		unsigned int numSteps, unsigned int loops, unsigned int flags,
+		void* (*callback)( void*, void*, int, void* ), void* callbackArg )
+{
+	SHARED_STATE*					cameraInfo;
+	OA_EXPOSURE_SEQUENCE*	seq;
+	unsigned int					i;
+	int										singleShot, ret;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	if ( !steps || !numSteps || numSteps > OA_SEQ_MAX_STEPS || !callback ||
+			( flags & ~( OA_SEQ_SINGLE_SHOT | OA_SEQ_STREAMING )) ||
+			flags == ( OA_SEQ_SINGLE_SHOT | OA_SEQ_STREAMING )) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	for ( i = 0; i < numSteps; i++ ) {
+		if ( !steps[i].count ) {
+			return -OA_ERR_OUT_OF_RANGE;
+		}
+		if ( steps[i].exposure != OA_SEQ_UNCHANGED &&
+				!camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_EXPOSURE_ABSOLUTE )) {
+			return -OA_ERR_INVALID_CONTROL;
+		}
+		if ( steps[i].gain != OA_SEQ_UNCHANGED &&
+				!camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_GAIN )) {
+			return -OA_ERR_INVALID_CONTROL;
+		}
+	}
+
+	if ( flags ) {
+		singleShot = ( flags & OA_SEQ_SINGLE_SHOT ) ? 1 : 0;
+	} else {
+		singleShot = ( camera->features.flags & OA_CAM_FEATURE_SINGLE_SHOT ) ?
+				1 : 0;
+	}
+	if ( singleShot &&
+			!( camera->features.flags & OA_CAM_FEATURE_SINGLE_SHOT )) {
+		return -OA_ERR_UNIMPLEMENTED;
+	}
+
+	cameraInfo = camera->_private;
+	seq = &cameraInfo->exposureSequence;
+	if ( seq->streaming || seq->threadStarted ||
+			camera->funcs.isStreaming ( camera )) {
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	pthread_mutex_lock ( &seq->mutex );
+	seq->camera = camera;
+	memcpy ( seq->steps, steps, numSteps * sizeof ( oaExposureStep ));
+	seq->numSteps = numSteps;
+	seq->loops = loops;
+	seq->callback = callback;
+	seq->callbackArg = callbackArg;
+	seq->stop = 0;
+	seq->step = seq->frame = seq->loop = 0;
+	seq->exposure = steps[0].exposure;
+	seq->gain = steps[0].gain;
+	seq->switching = 0;
+	seq->requestsPending = 0;
+	seq->lastFrameAt = 0;
+	OA_CLEAR ( seq->status );
+	seq->status.mode = singleShot ? OA_SEQ_SINGLE_SHOT : OA_SEQ_STREAMING;
+	pthread_mutex_unlock ( &seq->mutex );
+
+	if (( ret = _setControls ( camera, seq,
+			( seq->exposure != OA_SEQ_UNCHANGED ? 1 : 0 ) |
+			( seq->gain != OA_SEQ_UNCHANGED ? 2 : 0 ))) != OA_ERR_NONE ) {
+		return ret;
+	}
+
+	pthread_mutex_lock ( &seq->mutex );
+	seq->appliedAt = oacamMonotonicTime();
+	seq->status.running = 1;
+	pthread_mutex_unlock ( &seq->mutex );
+
+	if ( singleShot ) {
+		if ( pthread_create ( &seq->thread, 0, _shotThread, cameraInfo )) {
+			ret = -OA_ERR_SYSTEM_ERROR;
+		} else {
+			seq->threadStarted = 1;
+		}
+	} else {
+		if (( ret = camera->funcs.startStreaming ( camera, _streamedFrame,
+				cameraInfo )) == OA_ERR_NONE ) {
+			seq->streaming = 1;
+		}
+	}
+	if ( ret != OA_ERR_NONE ) {
+		pthread_mutex_lock ( &seq->mutex );
+		seq->status.running = 0;
+		pthread_mutex_unlock ( &seq->mutex );
+	}
+
+	return ret;
+}
+
+
+int
+oaStopExposureSequence ( oaCamera* camera )
+{
+	SHARED_STATE*					cameraInfo;
+	OA_EXPOSURE_SEQUENCE*	seq;
+	int										ret = OA_ERR_NONE;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	cameraInfo = camera->_private;
+	seq = &cameraInfo->exposureSequence;
+
+	pthread_mutex_lock ( &seq->mutex );
+	seq->stop = 1;
+	seq->status.running = 0;
+	pthread_cond_signal ( &seq->shotDone );
+	pthread_mutex_unlock ( &seq->mutex );
+
+	if ( seq->threadStarted ) {
+		( void ) pthread_join ( seq->thread, 0 );
+		seq->threadStarted = 0;
+	}
+	if ( seq->streaming ) {
+		ret = camera->funcs.stopStreaming ( camera );
+		seq->streaming = 0;
+	}
+	return ret;
+}
+
+
+int
+oaGetExposureSequenceStatus ( oaCamera* camera,
+		oaExposureSequenceStatus* status )
+{
+	SHARED_STATE*					cameraInfo;
+	OA_EXPOSURE_SEQUENCE*	seq;
+
+	if ( !camera || !status ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	cameraInfo = camera->_private;
+	seq = &cameraInfo->exposureSequence;
+
+	pthread_mutex_lock ( &seq->mutex );
+	*status = seq->status;
+	status->step = seq->step;
+	status->frame = seq->frame;
+	status->loop = seq->loop;
+	pthread_mutex_unlock ( &seq->mutex );
+	return OA_ERR_NONE;
+}
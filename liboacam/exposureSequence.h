@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *
+ * exposureSequence.h -- exposure sequence state
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+
+#ifndef OA_CAMERA_EXPOSURE_SEQUENCE_H
+#define OA_CAMERA_EXPOSURE_SEQUENCE_H
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+
+struct SHARED_STATE;
+
+// Everything from step onwards is protected by mutex.  When streaming,
+// switching is set from the end of one step until the first frame taken
+// with the next step's settings, and requestsPending counts the control
+// writes still to be completed by the camera.  appliedAt is the time the
+// last of those completed.  In single shot mode the frames are taken by
+// thread, which waits on shotDone for each one to be delivered and then
+// makes nextChanges.
+
+typedef struct OA_EXPOSURE_SEQUENCE {
+	pthread_mutex_t			mutex;
+	pthread_cond_t			shotDone;
+	oaCamera*						camera;
+	oaExposureStep			steps[ OA_SEQ_MAX_STEPS ];
+	unsigned int				numSteps;
+	unsigned int				loops;
+	void*								( *callback )( void*, void*, int, void* );
+	void*								callbackArg;
+	pthread_t						thread;
+	int									threadStarted;
+	int									streaming;
+	int									stop;
+	unsigned int				step;
+	unsigned int				frame;
+	unsigned int				loop;
+	int64_t							exposure;
+	int64_t							gain;
+	int									switching;
+	unsigned int				requestsPending;
+	uint64_t						appliedAt;
+	uint64_t						lastFrameAt;
+	int									shotComplete;
+	int									nextChanges;
+	oaExposureSequenceStatus	status;
+} OA_EXPOSURE_SEQUENCE;
+
+extern void	oacamExposureSequenceInit ( struct SHARED_STATE* );
+
+#endif	/* OA_CAMERA_EXPOSURE_SEQUENCE_H */
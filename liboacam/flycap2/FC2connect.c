@@ -124,6 +124,11 @@ oaFC2InitCamera ( oaCameraDevice* device )
   unsigned int			dataFormat, format;
   int				ret, numBinModes, maxBinMode;
 	void*			tmpPtr;
+	if ( _fc2InitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve SDK functions", __func__ );
+		return 0;
+	}
+
 
   if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
       sizeof ( FC2_STATE ), &commonInfo ) != OA_ERR_NONE ) {
@@ -1418,50 +1423,32 @@ oaFC2InitCamera ( oaCameraDevice* device )
   cameraInfo->buffers = 0;
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY * cameraInfo->maxBytesPerPixel;
-  cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
-  cameraInfo->metadataBuffers = calloc ( OA_CAM_BUFFERS,
-			sizeof ( FRAME_METADATA ));
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc of camera buffers failed",
-					__func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-			free (( void* ) cameraInfo->metadataBuffers );
-			free (( void* ) cameraInfo->buffers );
-      ( *p_fc2DestroyContext )( pgeContext );
-			for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
-				if ( cameraInfo->frameSizes[ j ].numSizes ) {
-					free (( void* ) cameraInfo->frameSizes[ j ].sizes );
-					if ( cameraInfo->frameModes[ j ] ) {
-						free (( void* ) cameraInfo->frameModes[ j ]);
-					}
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: buffer allocation failed", __func__ );
+    ( *p_fc2DestroyContext )( pgeContext );
+		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
+			if ( cameraInfo->frameSizes[ j ].numSizes ) {
+				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
+				if ( cameraInfo->frameModes[ j ] ) {
+					free (( void* ) cameraInfo->frameModes[ j ]);
 				}
 			}
-			if ( cameraInfo->triggerModes ) {
-				free (( void* ) cameraInfo->triggerModes );
-			}
-      free (( void* ) cameraInfo->metadataBuffers );
-      FREE_DATA_STRUCTS;
-      return 0;
-    }
+		}
+		if ( cameraInfo->triggerModes ) {
+			free (( void* ) cameraInfo->triggerModes );
+		}
+    FREE_DATA_STRUCTS;
+    return 0;
   }
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
   cameraInfo->nextBuffer = 0;
-  cameraInfo->configuredBuffers = OA_CAM_BUFFERS;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamFC2controller, ( void* ) camera )) {
     ( *p_fc2DestroyContext )( pgeContext );
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
@@ -1472,20 +1459,17 @@ oaFC2InitCamera ( oaCameraDevice* device )
 				}
 			}
 		}
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
-    free (( void* ) cameraInfo->metadataBuffers );
-		free (( void* ) cameraInfo->buffers );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		if ( cameraInfo->triggerModes ) {
 			free (( void* ) cameraInfo->triggerModes );
 		}
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamFC2callbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -1501,16 +1485,12 @@ oaFC2InitCamera ( oaCameraDevice* device )
 				}
 			}
 		}
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
-    free (( void* ) cameraInfo->metadataBuffers );
-		free (( void* ) cameraInfo->buffers );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		if ( cameraInfo->triggerModes ) {
 			free (( void* ) cameraInfo->triggerModes );
 		}
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -1561,14 +1541,12 @@ oaFC2CloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
   
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     ( *p_fc2DestroyContext )( cameraInfo->pgeContext );
 
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
     if ( cameraInfo->frameRates.numRates ) {
      free (( void* ) cameraInfo->frameRates.rates );
@@ -1584,10 +1562,8 @@ oaFC2CloseCamera ( oaCamera* camera )
 		}
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-    free (( void* ) cameraInfo->metadataBuffers );
-		free (( void* ) cameraInfo->buffers );
 		if ( cameraInfo->triggerModes ) {
 			free (( void* ) cameraInfo->triggerModes );
 		}
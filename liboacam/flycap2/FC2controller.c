@@ -144,23 +144,21 @@ _FC2FrameCallback ( fc2Image *frame, void *ptr )
   int								buffersFree, nextBuffer;
   unsigned int			dataLength;
 	fc2ImageMetadata	metadata;
+	FRAME_METADATA*		frameMetadata;
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
   if ( buffersFree && frame->dataSize ) {
     if (( dataLength = frame->dataSize ) > cameraInfo->imageBufferLength ) {
       dataLength = cameraInfo->imageBufferLength;
     }
     nextBuffer = cameraInfo->nextBuffer;
-		if ( !cameraInfo->haveFrameCounter || p_fc2GetImageMetadata ( frame,
-				&metadata ) != FC2_ERROR_OK ) {
-			cameraInfo->metadataBuffers[ nextBuffer ].frameCounterValid = 0;
-		} else {
-			cameraInfo->metadataBuffers[ nextBuffer ].frameCounter =
-					metadata.embeddedFrameCounter;
-			cameraInfo->metadataBuffers[ nextBuffer ].frameCounterValid = 1;
+		frameMetadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+				nextBuffer );
+		if ( cameraInfo->haveFrameCounter && p_fc2GetImageMetadata ( frame,
+				&metadata ) == FC2_ERROR_OK ) {
+			frameMetadata->frameCounter = metadata.embeddedFrameCounter;
+			frameMetadata->frameCounterValid = 1;
 		}
     ( void ) memcpy ( cameraInfo->buffers[ nextBuffer ].start, frame->pData,
         dataLength );
@@ -172,16 +170,16 @@ _FC2FrameCallback ( fc2Image *frame, void *ptr )
         cameraInfo->streamingCallback.callbackArg;
     cameraInfo->frameCallbacks[ nextBuffer ].buffer =
         cameraInfo->buffers[ nextBuffer ].start;
-    cameraInfo->frameCallbacks[ nextBuffer ].metadata =
-        &( cameraInfo->metadataBuffers[ nextBuffer ]);
+    cameraInfo->frameCallbacks[ nextBuffer ].metadata = frameMetadata;
     cameraInfo->frameCallbacks[ nextBuffer ].bufferLen = dataLength;
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    oaDLListAddToTail ( cameraInfo->callbackQueue,
+    oacamCallbackRingPush ( &cameraInfo->callbackRing,
         &cameraInfo->frameCallbacks[ nextBuffer ]);
-    cameraInfo->buffersFree--;
+    OA_CLAIM_BUFFER ( cameraInfo );
     cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+  } else if ( !buffersFree ) {
+    OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
+  } else {
+    OA_DROP_FRAME ( cameraInfo );
   }
 }
 
@@ -39,6 +39,7 @@
 #include <openastro/errno.h>
 #include <openastro/util.h>
 
+#include "dynloader.h"
 #include "FC2private.h"
 
 // Pointers to libflycapture functions so we can use them via libdl.
@@ -95,251 +96,65 @@ fc2Error							( *p_fc2GetEmbeddedImageInfo )( fc2Context,
 fc2Error							( *p_fc2SetEmbeddedImageInfo )( fc2Context,
 													fc2EmbeddedImageInfo* );
 
-static void*		_getDLSym ( void*, const char* );
-
-/**
- * Cycle through the list of cameras returned by the Flycapture library
- */
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( fc2CreateGigEContext ),
+	OA_DL_SYM( fc2DestroyContext ),
+	OA_DL_SYM( fc2DiscoverGigECameras ),
+	OA_DL_SYM( fc2GetNumOfCameras ),
+	OA_DL_SYM( fc2GetCameraFromIndex ),
+	OA_DL_SYM( fc2GetCameraFromIPAddress ),
+	OA_DL_SYM( fc2GetInterfaceTypeFromGuid ),
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( fc2Connect ),
+	OA_DL_SYM( fc2GetCameraInfo ),
+	OA_DL_SYM( fc2GetGigEImageBinningSettings ),
+	OA_DL_SYM( fc2GetGigEImageSettings ),
+	OA_DL_SYM( fc2GetGigEImageSettingsInfo ),
+	OA_DL_SYM( fc2GetProperty ),
+	OA_DL_SYM( fc2GetPropertyInfo ),
+	OA_DL_SYM( fc2GetStrobe ),
+	OA_DL_SYM( fc2GetStrobeInfo ),
+	OA_DL_SYM( fc2GetTriggerDelay ),
+	OA_DL_SYM( fc2GetTriggerDelayInfo ),
+	OA_DL_SYM( fc2GetTriggerMode ),
+	OA_DL_SYM( fc2GetTriggerModeInfo ),
+	OA_DL_SYM( fc2QueryGigEImagingMode ),
+	OA_DL_SYM( fc2ReadRegister ),
+	OA_DL_SYM( fc2SetGigEImageBinningSettings ),
+	OA_DL_SYM( fc2SetGigEImageSettings ),
+	OA_DL_SYM( fc2SetGigEImagingMode ),
+	OA_DL_SYM( fc2SetProperty ),
+	OA_DL_SYM( fc2SetStrobe ),
+	OA_DL_SYM( fc2SetTriggerDelay ),
+	OA_DL_SYM( fc2SetTriggerMode ),
+	OA_DL_SYM( fc2StartCaptureCallback ),
+	OA_DL_SYM( fc2StopCapture ),
+	OA_DL_SYM( fc2GetImageMetadata ),
+	OA_DL_SYM( fc2GetEmbeddedImageInfo ),
+	OA_DL_SYM( fc2SetEmbeddedImageInfo ),
+	OA_DL_END
+};
+
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libflycapture-c.so.2",
+		enumSymbols, otherSymbols );
+
+
+// Only the calls needed to enumerate cameras are resolved here
 
 int
 _fc2InitLibraryFunctionPointers ( void )
 {
-  static void*		libHandle = 0;
-	const char*			libName = "libflycapture-c.so.2";
-
-  if ( !libHandle ) {
-    if (!( libHandle = dlopen( libName, RTLD_LAZY ))) {
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libName, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-		dlerror();
-
-		if (!( *( void** )( &p_fc2Connect ) = _getDLSym ( libHandle,
-		    "fc2Connect" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2CreateGigEContext ) = _getDLSym ( libHandle,
-		    "fc2CreateGigEContext" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2DestroyContext ) = _getDLSym ( libHandle,
-		    "fc2DestroyContext" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2DiscoverGigECameras ) = _getDLSym ( libHandle,
-		    "fc2DiscoverGigECameras" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetCameraFromIndex ) = _getDLSym ( libHandle,
-		    "fc2GetCameraFromIndex" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetCameraFromIPAddress ) = _getDLSym ( libHandle,
-		    "fc2GetCameraFromIPAddress" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetCameraInfo ) = _getDLSym ( libHandle,
-		    "fc2GetCameraInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetGigEImageBinningSettings ) =
-		    _getDLSym ( libHandle, "fc2GetGigEImageBinningSettings" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetGigEImageSettings ) = _getDLSym ( libHandle,
-		    "fc2GetGigEImageSettings" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetGigEImageSettingsInfo ) = _getDLSym ( libHandle,
-		    "fc2GetGigEImageSettingsInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetInterfaceTypeFromGuid ) = _getDLSym ( libHandle,
-		    "fc2GetInterfaceTypeFromGuid" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetNumOfCameras ) = _getDLSym ( libHandle,
-		    "fc2GetNumOfCameras" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetProperty ) = _getDLSym ( libHandle,
-		    "fc2GetProperty" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetPropertyInfo ) = _getDLSym ( libHandle,
-		    "fc2GetPropertyInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetStrobe ) = _getDLSym ( libHandle,
-		    "fc2GetStrobe" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetStrobeInfo ) = _getDLSym ( libHandle,
-		    "fc2GetStrobeInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetTriggerDelay ) = _getDLSym ( libHandle,
-		    "fc2GetTriggerDelay" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetTriggerDelayInfo ) = _getDLSym ( libHandle,
-		    "fc2GetTriggerDelayInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetTriggerMode ) = _getDLSym ( libHandle,
-		    "fc2GetTriggerMode" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetTriggerModeInfo ) = _getDLSym ( libHandle,
-		    "fc2GetTriggerModeInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2QueryGigEImagingMode ) = _getDLSym ( libHandle,
-		    "fc2QueryGigEImagingMode" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2ReadRegister ) = _getDLSym ( libHandle,
-		    "fc2ReadRegister" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetGigEImageBinningSettings ) =
-		    _getDLSym ( libHandle, "fc2SetGigEImageBinningSettings" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetGigEImageSettings ) = _getDLSym ( libHandle,
-		    "fc2SetGigEImageSettings" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetGigEImagingMode ) = _getDLSym ( libHandle,
-		    "fc2SetGigEImagingMode" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetProperty ) = _getDLSym ( libHandle,
-		    "fc2SetProperty" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetStrobe ) = _getDLSym ( libHandle,
-		    "fc2SetStrobe" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetTriggerDelay ) = _getDLSym ( libHandle,
-		    "fc2SetTriggerDelay" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetTriggerMode ) = _getDLSym ( libHandle,
-		    "fc2SetTriggerMode" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2StartCaptureCallback ) = _getDLSym ( libHandle,
-		    "fc2StartCaptureCallback" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2StopCapture ) = _getDLSym ( libHandle,
-		    "fc2StopCapture" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetImageMetadata ) = _getDLSym ( libHandle,
-		    "fc2GetImageMetadata" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2GetEmbeddedImageInfo ) = _getDLSym ( libHandle,
-		    "fc2GetEmbeddedImageInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_fc2SetEmbeddedImageInfo ) = _getDLSym ( libHandle,
-		    "fc2SetEmbeddedImageInfo" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-	}
-
-  return OA_ERR_NONE;
+	return oacamDLLoad ( &lib, OA_DL_ENUMERATE );
 }
 
 
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+int
+_fc2InitAllLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
-
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libflycapture DL error: %s", __func__,
-				error );
-    addr = 0;
-  }
-
-  return addr;
+	return oacamDLLoad ( &lib, OA_DL_ALL );
 }
 
 #endif	/* HAVE_LIBDL */
@@ -28,6 +28,7 @@
 #define OA_FC2_PRIVATE_H
 
 extern int						_fc2InitLibraryFunctionPointers ( void );
+extern int						_fc2InitAllLibraryFunctionPointers ( void );
 
 extern fc2Error       ( *p_fc2Connect )( fc2Context, fc2PGRGuid* );
 extern fc2Error       ( *p_fc2CreateGigEContext )( fc2Context* );
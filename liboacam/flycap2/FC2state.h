@@ -44,9 +44,6 @@ typedef struct FC2_STATE {
   unsigned int		pixelFormats;
   int			bigEndian;
   unsigned int		availableBinModes;
-  // buffering for image transfers
-  frameBuffer*		buffers;
-	FRAME_METADATA*		metadataBuffers;
   // camera status
   int			colour;
   int			cfaPattern;
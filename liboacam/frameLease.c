@@ -0,0 +1,151 @@
+/*****************************************************************************
+ *
+ * frameLease.c -- zero-copy frame leases for streaming callbacks
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "frameLease.h"
+
+
+// Drivers still see an ordinary streaming callback.  Its address marks
+// the frames that should be leased rather than passed to it.
+
+static void*
+_leasedFrame ( void* state, void* buffer, int length, void* metadata )
+{
+	oaLogError ( OA_LOG_CAMERA, "%s: leased frame delivered without a lease",
+			__func__ );
+	return 0;
+}
+
+
+int
+oacamStartStreamingLeased ( oaCamera* camera,
+		void* (*callback)( void*, oaFrameLease* ), void* callbackArg )
+{
+	SHARED_STATE*			cameraInfo = camera->_private;
+	OA_FRAME_LEASES*	leases = &cameraInfo->frameLeases;
+	int								outstanding, ret;
+
+	oaLogInfo ( OA_LOG_CAMERA, "%s ( %p, %p, %p ): entered", __func__, camera,
+			callback, callbackArg );
+
+	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
+	outstanding = leases->issued - leases->retired;
+	if ( !outstanding ) {
+		leases->issued = leases->retired = 0;
+		leases->callback = callback;
+		leases->callbackArg = callbackArg;
+	}
+	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+
+	if ( outstanding ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: %d frames still leased", __func__,
+				outstanding );
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	ret = camera->funcs.startStreaming ( camera, _leasedFrame, cameraInfo );
+
+	oaLogInfo ( OA_LOG_CAMERA, "%s: exiting", __func__ );
+
+	return ret;
+}
+
+
+int
+oacamLeaseFrame ( SHARED_STATE* cameraInfo, CALLBACK* frame, void* buffer )
+{
+	OA_FRAME_LEASES*	leases = &cameraInfo->frameLeases;
+	oaFrameLease*			lease;
+	unsigned int			slot;
+	uint64_t					started;
+
+	if ( frame->callback != _leasedFrame ) {
+		return 0;
+	}
+
+	// There can never be more leases outstanding than buffers in the pool,
+	// so the slot cannot still be in use
+
+	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
+	slot = leases->issued % OA_CAM_MAX_BUFFERS;
+	lease = &leases->lease[ slot ];
+	lease->buffer = buffer;
+	lease->length = frame->bufferLen;
+	lease->metadata = frame->metadata;
+	lease->_state = cameraInfo;
+	lease->_slot = slot;
+	leases->frame[ slot ] = frame;
+	leases->held[ slot ] = 1;
+	leases->issued++;
+	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+
+	started = oacamCallbackStarted ( cameraInfo, frame );
+	leases->callback ( leases->callbackArg, lease );
+	oacamCallbackFinished ( cameraInfo, started );
+	return 1;
+}
+
+
+void
+oaReleaseFrameLease ( oaFrameLease* lease )
+{
+	SHARED_STATE*			cameraInfo = lease->_state;
+	OA_FRAME_LEASES*	leases = &cameraInfo->frameLeases;
+	unsigned int			slot;
+
+	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
+	if ( !leases->held[ lease->_slot ] ) {
+		pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+		oaLogWarning ( OA_LOG_CAMERA, "%s: lease %p is not held", __func__,
+				lease );
+		return;
+	}
+	leases->held[ lease->_slot ] = 0;
+
+	// Recycle in lease order, so that a driver handing out buffers
+	// round-robin never gets back one the application still holds
+
+	while ( leases->retired != leases->issued ) {
+		slot = leases->retired % OA_CAM_MAX_BUFFERS;
+		if ( leases->held[ slot ] ) {
+			break;
+		}
+		if ( leases->recycle ) {
+			leases->recycle ( cameraInfo, leases->frame[ slot ]);
+		}
+		OA_RELEASE_BUFFER ( cameraInfo );
+		leases->retired++;
+	}
+	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+}
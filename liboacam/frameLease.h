@@ -0,0 +1,54 @@
+/*****************************************************************************
+ *
+ * frameLease.h -- zero-copy frame leases for streaming callbacks
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_FRAME_LEASE_H
+#define OA_CAMERA_FRAME_LEASE_H
+
+#include <openastro/camera.h>
+#include <openastro/controller.h>
+
+struct SHARED_STATE;
+
+// Leases are issued by the callback thread and retired in the same order,
+// so for the driver a leased buffer looks like one its callback has not
+// yet returned from.  recycle, if set, hands the buffer back to the kernel
+// or SDK that owns it (eg. VIDIOC_QBUF) before the buffer is counted as
+// free again.
+
+typedef struct OA_FRAME_LEASES {
+	oaFrameLease		lease[ OA_CAM_MAX_BUFFERS ];
+	CALLBACK*				frame[ OA_CAM_MAX_BUFFERS ];
+	unsigned char		held[ OA_CAM_MAX_BUFFERS ];
+	unsigned int		issued;
+	unsigned int		retired;
+	void*						( *callback )( void*, oaFrameLease* );
+	void*						callbackArg;
+	void						( *recycle )( struct SHARED_STATE*, CALLBACK* );
+} OA_FRAME_LEASES;
+
+extern int	oacamLeaseFrame ( struct SHARED_STATE*, CALLBACK*, void* );
+
+#endif	/* OA_CAMERA_FRAME_LEASE_H */
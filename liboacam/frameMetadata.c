@@ -0,0 +1,64 @@
+/*****************************************************************************
+ *
+ * frameMetadata.c -- per-frame metadata filled in for the drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "frameMetadata.h"
+
+
+FRAME_METADATA*
+oacamStampFrame ( SHARED_STATE* cameraInfo, int slot )
+{
+	FRAME_METADATA*		metadata = &cameraInfo->frameMetadata[ slot ];
+	uint64_t					now = oacamMonotonicTime();
+	unsigned int			dropped;
+
+	dropped = __atomic_exchange_n ( &cameraInfo->framesDropped, 0,
+			__ATOMIC_RELAXED );
+
+	OA_CLEAR ( *metadata );
+	cameraInfo->frameSequence += dropped + 1;
+	metadata->sequence = cameraInfo->frameSequence;
+	metadata->timestamp = now;
+	metadata->droppedFrames = dropped;
+	return metadata;
+}
+
+
+void
+oacamResetFrameMetadata ( SHARED_STATE* cameraInfo )
+{
+	cameraInfo->frameSequence = 0;
+	__atomic_store_n ( &cameraInfo->framesDropped, 0, __ATOMIC_RELAXED );
+}
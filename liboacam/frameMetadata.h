@@ -0,0 +1,58 @@
+/*****************************************************************************
+ *
+ * frameMetadata.h -- per-frame metadata filled in for the drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_FRAME_METADATA_H
+#define OA_CAMERA_FRAME_METADATA_H
+
+#include <openastro/camera.h>
+
+struct SHARED_STATE;
+
+// The producer calls oacamStampFrame() for the buffer it is about to
+// queue, as close to dequeueing the frame as it can.  The returned block
+// has the sequence number, monotonic timestamp and drop count set and
+// everything else cleared, ready for the driver to add what its camera
+// reports.  Any frame the driver discards is counted so the next stamped
+// frame accounts for it: with OA_DROP_FRAME_NO_BUFFER() if it was lost for
+// want of a free buffer, or OA_DROP_FRAME() if it arrived damaged or the
+// camera, SDK or kernel reports losing it.
+
+extern FRAME_METADATA*	oacamStampFrame ( struct SHARED_STATE*, int );
+extern void							oacamResetFrameMetadata ( struct SHARED_STATE* );
+
+#define	OA_COUNT_DROPS(s,n,counter) \
+	do { \
+		unsigned int _n = ( n ); \
+		( void ) __atomic_add_fetch ( &( s )->framesDropped, _n, \
+				__ATOMIC_RELAXED ); \
+		( void ) __atomic_add_fetch ( &( s )->stats.counter, _n, \
+				__ATOMIC_RELAXED ); \
+	} while ( 0 )
+#define	OA_DROP_FRAMES(s,n)					OA_COUNT_DROPS(s,n,driverDrops)
+#define	OA_DROP_FRAME(s)						OA_DROP_FRAMES(s,1)
+#define	OA_DROP_FRAME_NO_BUFFER(s)	OA_COUNT_DROPS(s,1,bufferDrops)
+
+#endif	/* OA_CAMERA_FRAME_METADATA_H */
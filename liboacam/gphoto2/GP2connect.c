@@ -70,6 +70,12 @@ oaGP2InitCamera ( oaCameraDevice* device )
 	int								numCameras, i, j, ret, found = -1;
 	CameraWidget*			tempWidget;
 
+	if ( _gp2InitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve libgphoto2 functions",
+				__func__ );
+		return 0;
+	}
+
 	if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
 			sizeof ( GP2_STATE ), &commonInfo ) != OA_ERR_NONE ) {
 		return 0;
@@ -805,30 +811,37 @@ oaGP2InitCamera ( oaCameraDevice* device )
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
 
-  cameraInfo->nextBuffer = 0;
-  cameraInfo->configuredBuffers = OA_CAM_BUFFERS;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
-	for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-		cameraInfo->currentBufferLength[i] = 0;
+	// Frame sizes depend on the image format, so memory is allocated as
+	// each frame arrives
+	if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo, 0 ) != OA_ERR_NONE ) {
+		_gp2CloseCamera ( cameraInfo->handle, cameraInfo->ctx );
+		p_gp_list_unref ( cameraList );
+		p_gp_context_unref ( cameraInfo->ctx );
+		FREE_DATA_STRUCTS;
+    oaDLListDelete ( cameraInfo->commandQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
+    return 0;
 	}
-	cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamGP2controller, ( void* ) camera )) {
     oaLogError ( OA_LOG_CAMERA, "%s: controller thread creation failed",
 				__func__ );
 		_gp2CloseCamera ( cameraInfo->handle, cameraInfo->ctx );
 		p_gp_list_unref ( cameraList );
 		p_gp_context_unref ( cameraInfo->ctx );
+		oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		FREE_DATA_STRUCTS;
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return 0;
   }
 
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamGP2callbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -840,9 +853,10 @@ oaGP2InitCamera ( oaCameraDevice* device )
 		_gp2CloseCamera ( cameraInfo->handle, cameraInfo->ctx );
 		p_gp_list_unref ( cameraList );
 		p_gp_context_unref ( cameraInfo->ctx );
+		oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		FREE_DATA_STRUCTS;
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return 0;
   }
 
@@ -1013,7 +1027,6 @@ _GP2GuessManufacturer ( const char* mstring )
 int
 oaGP2CloseCamera ( oaCamera* camera )
 {
-  int		j;
   void*		dummy;
   GP2_STATE*	cameraInfo;
 
@@ -1027,25 +1040,18 @@ oaGP2CloseCamera ( oaCamera* camera )
 
 /*
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 */
 
 		_gp2CloseCamera ( cameraInfo->handle, cameraInfo->ctx );
 		p_gp_context_unref ( cameraInfo->ctx );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->currentBufferLength[j] ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
     free (( void* ) camera );
@@ -443,7 +443,6 @@ _handleCompletedExposure ( GP2_STATE* cameraInfo )
 	int									ret;
 	int									buffersFree, nextBuffer;
 	void*								data;
-	void*								ptr;
 	const char*					imageBuffer;
 	unsigned long				size;
 	const char*					mimeType;
@@ -507,29 +506,23 @@ _handleCompletedExposure ( GP2_STATE* cameraInfo )
 		return -OA_ERR_CAMERA_IO;
 	}
 
-	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-	buffersFree = cameraInfo->buffersFree;
-	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+	buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
 	if ( buffersFree && size > 0 ) {
 		nextBuffer = cameraInfo->nextBuffer;
-		if ( size > cameraInfo->currentBufferLength[ nextBuffer ]) {
-			if ( cameraInfo->currentBufferLength[ nextBuffer ] == 0 ) {
-				ptr = malloc ( size );
-			} else {
-				ptr = realloc ( cameraInfo->buffers[ nextBuffer ].start, size );
-			}
-			if ( !ptr ) {
+		if ( size > cameraInfo->buffers[ nextBuffer ].length ) {
+			if ( oacamResizeBuffer (( SHARED_STATE* ) cameraInfo, nextBuffer,
+					size ) != OA_ERR_NONE ) {
 				oaLogError ( OA_LOG_CAMERA,
 						"%s: failed to make bigger buffer for camera frame", __func__ );
 				return -OA_ERR_MEM_ALLOC;
 			}
-			cameraInfo->buffers[ nextBuffer ].start = ptr;
-			cameraInfo->currentBufferLength[ nextBuffer ] = size;
 		}
 
 		( void ) memcpy ( cameraInfo->buffers[ nextBuffer ].start, imageBuffer,
 				size );
+		cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+				oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
 		cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
 				OA_CALLBACK_NEW_FRAME;
 		cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -539,12 +532,12 @@ _handleCompletedExposure ( GP2_STATE* cameraInfo )
 		cameraInfo->frameCallbacks[ nextBuffer ].buffer =
 				cameraInfo->buffers[ nextBuffer ].start;
 		cameraInfo->frameCallbacks[ nextBuffer ].bufferLen = size;
-		pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-		oaDLListAddToTail ( cameraInfo->callbackQueue,
+		oacamCallbackRingPush ( &cameraInfo->callbackRing,
 				&cameraInfo->frameCallbacks[ nextBuffer ]);
-		cameraInfo->buffersFree--;
-		cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;		pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-		pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+		OA_CLAIM_BUFFER ( cameraInfo );
+		cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;
+	} else if ( size > 0 ) {
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
 	}
 
 	p_gp_file_free ( file );
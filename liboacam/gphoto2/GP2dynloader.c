@@ -41,6 +41,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "GP2private.h"
 
 
@@ -117,391 +118,86 @@ int					( *p_gp_file_get_data_and_size )( CameraFile*, const char**,
 int					( *p_gp_file_get_mime_type )( CameraFile*, const char** );
 
 #if HAVE_LIBDL && !HAVE_STATIC_LIBGPHOTO2
-static void*		_getDLSym ( void*, const char* );
-#endif
-
 
-int
-_gp2InitLibraryFunctionPointers ( void )
-{
-#if HAVE_LIBDL && !HAVE_STATIC_LIBGPHOTO2
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
+// Enumeration opens each camera to read its model name, so it needs rather
+// more of the library than most
+
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( gp_context_new ),
+	OA_DL_SYM( gp_context_unref ),
+	OA_DL_SYM( gp_list_new ),
+	OA_DL_SYM( gp_list_reset ),
+	OA_DL_SYM( gp_list_unref ),
+	OA_DL_SYM( gp_list_get_name ),
+	OA_DL_SYM( gp_list_get_value ),
+	OA_DL_SYM( gp_camera_autodetect ),
+	OA_DL_SYM( gp_camera_new ),
+	OA_DL_SYM( gp_camera_set_abilities ),
+	OA_DL_SYM( gp_camera_set_port_info ),
+	OA_DL_SYM( gp_camera_unref ),
+	OA_DL_SYM( gp_camera_init ),
+	OA_DL_SYM( gp_camera_exit ),
+	OA_DL_SYM( gp_camera_get_config ),
+	OA_DL_SYM( gp_context_set_error_func ),
+	OA_DL_SYM( gp_context_set_status_func ),
+	OA_DL_SYM( gp_context_set_message_func ),
+	OA_DL_SYM( gp_abilities_list_get_abilities ),
+	OA_DL_SYM( gp_abilities_list_load ),
+	OA_DL_SYM( gp_abilities_list_lookup_model ),
+	OA_DL_SYM( gp_abilities_list_new ),
+	OA_DL_SYM( gp_widget_get_child_by_name ),
+	OA_DL_SYM( gp_widget_get_child_by_label ),
+	OA_DL_SYM( gp_widget_get_type ),
+	OA_DL_SYM( gp_widget_get_value ),
+	OA_DL_SYM( gp_port_info_list_count ),
+	OA_DL_SYM( gp_port_info_list_free ),
+	OA_DL_SYM( gp_port_info_list_get_info ),
+	OA_DL_SYM( gp_port_info_list_load ),
+	OA_DL_SYM( gp_port_info_list_lookup_path ),
+	OA_DL_SYM( gp_port_info_list_new ),
+	OA_DL_SYM( gp_log_add_func ),
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( gp_list_free ),
+	OA_DL_SYM( gp_list_count ),
+	OA_DL_SYM( gp_camera_set_config ),
+	OA_DL_SYM( gp_camera_trigger_capture ),
+	OA_DL_SYM( gp_camera_wait_for_event ),
+	OA_DL_SYM( gp_camera_file_get ),
+	OA_DL_SYM( gp_context_set_cancel_func ),
+	OA_DL_SYM( gp_widget_get_name ),
+	OA_DL_SYM( gp_widget_count_choices ),
+	OA_DL_SYM( gp_widget_get_choice ),
+	OA_DL_SYM( gp_widget_set_value ),
+	OA_DL_SYM( gp_file_new ),
+	OA_DL_SYM( gp_file_free ),
+	OA_DL_SYM( gp_file_get_data_and_size ),
+	OA_DL_SYM( gp_file_get_mime_type ),
+	OA_DL_END
+};
 
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-  const char*		libName = "libgphoto2.dylib";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libgphoto2.dylib",
+		enumSymbols, otherSymbols );
 #else
-  const char*		libName = "libgphoto2.so.6";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libgphoto2.so.6",
+		enumSymbols, otherSymbols );
 #endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
 #endif
 
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
-#endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
-#endif
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libPath, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-	  if (!( *( void** )( &p_gp_context_new ) = _getDLSym ( libHandle,
-	      "gp_context_new" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_context_unref ) = _getDLSym ( libHandle,
-	      "gp_context_unref" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_list_new ) = _getDLSym ( libHandle,
-	      "gp_list_new" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_list_reset ) = _getDLSym ( libHandle,
-	      "gp_list_reset" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_list_free ) = _getDLSym ( libHandle,
-	      "gp_list_free" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_list_unref ) = _getDLSym ( libHandle,
-	      "gp_list_unref" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_list_count ) = _getDLSym ( libHandle,
-	      "gp_list_count" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_list_get_name ) = _getDLSym ( libHandle,
-	      "gp_list_get_name" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_list_get_value ) = _getDLSym ( libHandle,
-	      "gp_list_get_value" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_autodetect ) = _getDLSym ( libHandle,
-	      "gp_camera_autodetect" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_new ) = _getDLSym ( libHandle,
-	      "gp_camera_new" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_set_abilities ) = _getDLSym ( libHandle,
-	      "gp_camera_set_abilities" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_set_port_info ) = _getDLSym ( libHandle,
-	      "gp_camera_set_port_info" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_unref ) = _getDLSym ( libHandle,
-	      "gp_camera_unref" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_init ) = _getDLSym ( libHandle,
-	      "gp_camera_init" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_exit ) = _getDLSym ( libHandle,
-	      "gp_camera_exit" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_get_config ) = _getDLSym ( libHandle,
-	      "gp_camera_get_config" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_set_config ) = _getDLSym ( libHandle,
-	      "gp_camera_set_config" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	  if (!( *( void** )( &p_gp_camera_trigger_capture ) = _getDLSym ( libHandle,
-	      "gp_camera_trigger_capture" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_wait_for_event ) = _getDLSym ( libHandle,
-	      "gp_camera_wait_for_event" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_camera_file_get ) = _getDLSym ( libHandle,
-	      "gp_camera_file_get" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_context_set_error_func ) = _getDLSym ( libHandle,
-	      "gp_context_set_error_func" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_context_set_status_func ) = _getDLSym ( libHandle,
-	      "gp_context_set_status_func" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_context_set_cancel_func ) = _getDLSym ( libHandle,
-	      "gp_context_set_cancel_func" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_context_set_message_func ) =
-				_getDLSym ( libHandle, "gp_context_set_message_func" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_abilities_list_get_abilities ) =
-				_getDLSym ( libHandle, "gp_abilities_list_get_abilities" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_abilities_list_load ) = _getDLSym ( libHandle,
-	      "gp_abilities_list_load" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_abilities_list_lookup_model ) =
-				_getDLSym ( libHandle, "gp_abilities_list_lookup_model" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_abilities_list_new ) = _getDLSym ( libHandle,
-	      "gp_abilities_list_new" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_get_child_by_name ) =
-				_getDLSym ( libHandle, "gp_widget_get_child_by_name" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_get_child_by_label ) =
-				_getDLSym ( libHandle, "gp_widget_get_child_by_label" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_get_name ) = _getDLSym ( libHandle,
-	      "gp_widget_get_name" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_get_type ) = _getDLSym ( libHandle,
-	      "gp_widget_get_type" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_get_value ) = _getDLSym ( libHandle,
-	      "gp_widget_get_value" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_count_choices ) = _getDLSym ( libHandle,
-	      "gp_widget_count_choices" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_get_choice ) = _getDLSym ( libHandle,
-	      "gp_widget_get_choice" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_widget_set_value ) = _getDLSym ( libHandle,
-	      "gp_widget_set_value" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_port_info_list_count ) = _getDLSym ( libHandle,
-	      "gp_port_info_list_count" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_port_info_list_free ) = _getDLSym ( libHandle,
-	      "gp_port_info_list_free" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_port_info_list_get_info ) = _getDLSym ( libHandle,
-	      "gp_port_info_list_get_info" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_port_info_list_load ) = _getDLSym ( libHandle,
-	      "gp_port_info_list_load" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_port_info_list_lookup_path ) =
-				_getDLSym ( libHandle, "gp_port_info_list_lookup_path" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_port_info_list_new ) = _getDLSym ( libHandle,
-	      "gp_port_info_list_new" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_log_add_func ) = _getDLSym ( libHandle,
-	      "gp_log_add_func" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_file_new ) = _getDLSym ( libHandle,
-	      "gp_file_new" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_file_free ) = _getDLSym ( libHandle,
-	      "gp_file_free" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_file_get_data_and_size ) = _getDLSym ( libHandle,
-	      "gp_file_get_data_and_size" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_gp_file_get_mime_type ) = _getDLSym ( libHandle,
-	      "gp_file_get_mime_type" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	}
+
+static int
+_gp2Load ( int level )
+{
+#if HAVE_LIBDL && !HAVE_STATIC_LIBGPHOTO2
+	return oacamDLLoad ( &lib, level );
 #else
 #if HAVE_STATIC_LIBGPHOTO2
 
+	( void ) level;
+
 	p_gp_context_new = gp_context_new;
 	p_gp_context_unref = gp_context_unref;
 
@@ -557,30 +253,27 @@ retry:
 	p_gp_file_new = gp_file_new;
 	p_gp_file_free = gp_file_free;
 	p_gp_file_get_data_and_size = gp_file_get_data_and_size;
-	p_gp_file_get_data_and_size = gp_file_get_mime_type;
-
+	p_gp_file_get_mime_type = gp_file_get_mime_type;
+	return OA_ERR_NONE;
 #else
+	( void ) level;
 	return OA_ERR_LIBRARY_NOT_FOUND;
 #endif	/* HAVE_STATIC_LIBGPHOTO2 */
 #endif	/* HAVE_LIBDL && !HAVE_STATIC_LIBGPHOTO2 */
-	return OA_ERR_NONE;
 }
 
 
-#if HAVE_LIBDL && !HAVE_STATIC_LIBGPHOTO2
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+// Only the calls needed to enumerate cameras are resolved here
+
+int
+_gp2InitLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
+	return _gp2Load ( OA_DL_ENUMERATE );
+}
 
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libgphoto2 DL error: %s", __func__,
-				error );
-    addr = 0;
-  }
 
-  return addr;
+int
+_gp2InitAllLibraryFunctionPointers ( void )
+{
+	return _gp2Load ( OA_DL_ALL );
 }
-#endif /* HAVE_LIBDL && !HAVE_STATIC_LIBGPHOTO2 */
@@ -29,6 +29,7 @@
 
 
 extern int					_gp2InitLibraryFunctionPointers ( void );
+extern int					_gp2InitAllLibraryFunctionPointers ( void );
 
 extern int					_gp2OpenCamera ( Camera**, const char*, const char*,
 												GPContext* );
@@ -93,9 +93,6 @@ typedef struct GP2_STATE {
   int									currentFrameFormat;
   int									bytesPerPixel;
   int									maxBytesPerPixel;
-  // buffering for image transfers
-  frameBuffer*				buffers;
-  unsigned int				currentBufferLength[ OA_CAM_BUFFERS ];
   // handling exposures
   int									exposurePending;
   CALLBACK						exposureCallback;
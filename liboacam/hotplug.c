@@ -0,0 +1,219 @@
+/*****************************************************************************
+ *
+ * hotplug.c -- report USB devices being plugged in and unplugged
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+
+#if HAVE_LIBUDEV
+#include <poll.h>
+#include <libudev.h>
+#endif
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+
+#if HAVE_LIBUDEV
+
+// How often, in milliseconds, the monitor thread checks whether it has
+// been asked to stop
+#define	OA_HOTPLUG_POLL_MS		250
+
+static pthread_mutex_t		hotplugMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t					hotplugThread;
+static int								hotplugRunning = 0;
+static volatile int				hotplugStop = 0;
+static struct udev*				hotplugUdev = 0;
+static struct udev_monitor*	hotplugMonitor = 0;
+static void								( *hotplugCallback )( void*,
+															const oaHotplugEvent* );
+static void*							hotplugCallbackArg;
+
+
+static unsigned int
+_property ( struct udev_device* dev, const char* name, int base )
+{
+	const char*	value;
+
+	if (!( value = udev_device_get_property_value ( dev, name ))) {
+		return 0;
+	}
+	return strtoul ( value, 0, base );
+}
+
+
+static void
+_report ( struct udev_device* dev )
+{
+	oaHotplugEvent	event;
+	const char*			action;
+	const char*			product;
+	unsigned int		vid, pid;
+
+	if (!( action = udev_device_get_action ( dev ))) {
+		return;
+	}
+	OA_CLEAR ( event );
+	if ( !strcmp ( action, "add" )) {
+		event.event = OA_HOTPLUG_ADDED;
+	} else if ( !strcmp ( action, "remove" )) {
+		event.event = OA_HOTPLUG_REMOVED;
+	} else {
+		return;
+	}
+	event.busNumber = _property ( dev, "BUSNUM", 10 );
+	event.deviceAddress = _property ( dev, "DEVNUM", 10 );
+
+	// PRODUCT is "vid/pid/bcdDevice" in hex and, unlike the sysfs
+	// attributes, is still there when the device is removed
+
+	if (( product = udev_device_get_property_value ( dev, "PRODUCT" )) &&
+			sscanf ( product, "%x/%x/", &vid, &pid ) == 2 ) {
+		event.vendorId = vid;
+		event.productId = pid;
+	}
+
+	oaLogInfo ( OA_LOG_CAMERA, "%s: USB device %04x:%04x %s at %u:%u",
+			__func__, event.vendorId, event.productId, action, event.busNumber,
+			event.deviceAddress );
+	oaFlushCameraCache();
+	hotplugCallback ( hotplugCallbackArg, &event );
+}
+
+
+static void*
+_monitor ( void* arg )
+{
+	struct udev_device*	dev;
+	struct pollfd				pfd;
+
+	( void ) arg;
+	pfd.fd = udev_monitor_get_fd ( hotplugMonitor );
+	pfd.events = POLLIN;
+	while ( !hotplugStop ) {
+		pfd.revents = 0;
+		if ( poll ( &pfd, 1, OA_HOTPLUG_POLL_MS ) <= 0 ||
+				!( pfd.revents & POLLIN )) {
+			continue;
+		}
+		if (( dev = udev_monitor_receive_device ( hotplugMonitor ))) {
+			_report ( dev );
+			udev_device_unref ( dev );
+		}
+	}
+	return 0;
+}
+
+
+static void
+_release ( void )
+{
+	if ( hotplugMonitor ) {
+		udev_monitor_unref ( hotplugMonitor );
+		hotplugMonitor = 0;
+	}
+	if ( hotplugUdev ) {
+		udev_unref ( hotplugUdev );
+		hotplugUdev = 0;
+	}
+}
+
+#endif	/* HAVE_LIBUDEV */
+
+
+int
+oaStartCameraHotplug ( void ( *callback )( void*, const oaHotplugEvent* ),
+		void* callbackArg )
+{
+#if HAVE_LIBUDEV
+	int		ret = OA_ERR_NONE;
+
+	if ( !callback ) {
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	pthread_mutex_lock ( &hotplugMutex );
+	if ( hotplugRunning ) {
+		pthread_mutex_unlock ( &hotplugMutex );
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	if (!( hotplugUdev = udev_new())) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't get udev context", __func__ );
+		ret = -OA_ERR_SYSTEM_ERROR;
+	} else if (!( hotplugMonitor = udev_monitor_new_from_netlink ( hotplugUdev,
+			"udev" ))) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't create udev monitor", __func__ );
+		ret = -OA_ERR_SYSTEM_ERROR;
+	} else if ( udev_monitor_filter_add_match_subsystem_devtype (
+			hotplugMonitor, "usb", "usb_device" ) < 0 ||
+			udev_monitor_enable_receiving ( hotplugMonitor ) < 0 ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't enable udev monitor", __func__ );
+		ret = -OA_ERR_SYSTEM_ERROR;
+	}
+
+	if ( ret == OA_ERR_NONE ) {
+		hotplugCallback = callback;
+		hotplugCallbackArg = callbackArg;
+		hotplugStop = 0;
+		if ( pthread_create ( &hotplugThread, 0, _monitor, 0 )) {
+			oaLogError ( OA_LOG_CAMERA, "%s: can't create monitor thread",
+					__func__ );
+			ret = -OA_ERR_SYSTEM_ERROR;
+		} else {
+			hotplugRunning = 1;
+		}
+	}
+
+	if ( ret != OA_ERR_NONE ) {
+		_release();
+	}
+	pthread_mutex_unlock ( &hotplugMutex );
+	return ret;
+#else
+	( void ) callback;
+	( void ) callbackArg;
+	return -OA_ERR_UNIMPLEMENTED;
+#endif
+}
+
+
+void
+oaStopCameraHotplug ( void )
+{
+#if HAVE_LIBUDEV
+	pthread_mutex_lock ( &hotplugMutex );
+	if ( hotplugRunning ) {
+		hotplugStop = 1;
+		( void ) pthread_join ( hotplugThread, 0 );
+		_release();
+		hotplugRunning = 0;
+	}
+	pthread_mutex_unlock ( &hotplugMutex );
+#endif
+}
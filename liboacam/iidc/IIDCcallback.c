@@ -38,59 +38,56 @@
 #include "IIDCprivate.h"
 
 
+void
+oacamIIDCrequeueFrame ( SHARED_STATE* state, CALLBACK* callback )
+{
+  IIDC_STATE*		cameraInfo = ( IIDC_STATE* ) state;
+
+  // We can only requeue frames if we're still streaming
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  if ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) {
+    p_dc1394_capture_enqueue ( cameraInfo->iidcHandle, callback->buffer );
+  }
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+}
+
+
 void*
 oacamIIDCcallbackHandler ( void* param )
 {
   oaCamera*		camera = param;
   IIDC_STATE*		cameraInfo = camera->_private;
-  int			exitThread = 0;
   CALLBACK*		callback;
   void*			(*callbackFunc)( void*, void*, int, void* );
+  uint64_t		started;
   dc1394video_frame_t*	frameData;
 
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    exitThread = cameraInfo->stopCallbackThread;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-
-    if ( exitThread ) {
-      break;
-    } else {
-      // try to prevent busy-waiting
-      if ( oaDLListIsEmpty ( cameraInfo->callbackQueue )) {
-        pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-        pthread_cond_wait ( &cameraInfo->callbackQueued,
-            &cameraInfo->callbackQueueMutex );
-        pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-      }
-    }
-
-    callback = oaDLListRemoveFromHead ( cameraInfo->callbackQueue );
+    callback = oacamCallbackRingWait ( &cameraInfo->callbackRing );
     if ( callback ) {
       switch ( callback->callbackType ) {
         case OA_CALLBACK_NEW_FRAME:
-          callbackFunc = callback->callback;
           frameData = callback->buffer;
-          callbackFunc ( callback->callbackArg, frameData->image,
-              callback->bufferLen, 0 );
-          // We can only requeue frames if we're still streaming
-          pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-          if ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) {
-            p_dc1394_capture_enqueue ( cameraInfo->iidcHandle,
-								callback->buffer );
+          if ( !oacamLeaseFrame (( SHARED_STATE* ) cameraInfo, callback,
+              frameData->image )) {
+            callbackFunc = callback->callback;
+            started = oacamCallbackStarted (( SHARED_STATE* ) cameraInfo,
+                callback );
+            callbackFunc ( callback->callbackArg, frameData->image,
+                callback->bufferLen, callback->metadata );
+            oacamCallbackFinished (( SHARED_STATE* ) cameraInfo, started );
+            oacamIIDCrequeueFrame (( SHARED_STATE* ) cameraInfo, callback );
+            OA_RELEASE_BUFFER ( cameraInfo );
           }
-          pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
-          pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-          cameraInfo->buffersFree++;
-          pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
           break;
         default:
           oaLogError ( OA_LOG_CAMERA, "%s: unexpected callback type %d",
 							__func__, callback->callbackType );
           break;
       }
+      oacamCallbackRingRelease ( &cameraInfo->callbackRing );
     }
-  } while ( 1 );
+  } while ( callback );
 
   return 0;
 }
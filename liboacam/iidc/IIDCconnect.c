@@ -109,6 +109,11 @@ oaIIDCInitCamera ( oaCameraDevice* device )
   IIDC_STATE*		cameraInfo;
   COMMON_INFO*		commonInfo;
   dc1394framerates_t	framerates;
+	if ( _iidcInitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve SDK functions", __func__ );
+		return 0;
+	}
+
 
   if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
       sizeof ( IIDC_STATE ), &commonInfo ) != OA_ERR_NONE ) {
@@ -618,20 +623,23 @@ oaIIDCInitCamera ( oaCameraDevice* device )
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
-  cameraInfo->nextBuffer = 0;
-  cameraInfo->configuredBuffers = OA_CAM_BUFFERS;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
-
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+  cameraInfo->frameLeases.recycle = oacamIIDCrequeueFrame;
+  // libdc1394 owns the DMA ring, so only the count comes from the pool
+  oacamInitBufferPool (( SHARED_STATE* ) cameraInfo, oacamBufferPoolCount(),
+      0 );
+
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamIIDCcontroller, ( void* ) camera )) {
 		free (( void* ) cameraInfo->frameSizes[1].sizes );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamIIDCcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -640,7 +648,7 @@ oaIIDCInitCamera ( oaCameraDevice* device )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 		free (( void* ) cameraInfo->frameSizes[1].sizes );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -683,7 +691,7 @@ oaIIDCInitCamera ( oaCameraDevice* device )
     return 0;
   }
 
-  if ( p_dc1394_capture_setup ( iidcCam, OA_CAM_BUFFERS,
+  if ( p_dc1394_capture_setup ( iidcCam, oacamBufferPoolCount(),
       DC1394_CAPTURE_FLAGS_DEFAULT ) != DC1394_SUCCESS ) {
     oaLogError ( OA_LOG_CAMERA, "%s: dc1394_capture_setup failed", __func__ );
     FREE_DATA_STRUCTS;
@@ -1105,7 +1113,7 @@ oaIIDCCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
   
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     p_dc1394_camera_free ( cameraInfo->iidcHandle );
@@ -1116,7 +1124,7 @@ oaIIDCCloseCamera ( oaCamera* camera )
     free (( void* ) cameraInfo->frameSizes[1].sizes );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
     free (( void* ) camera->_common );
     free (( void* ) cameraInfo );
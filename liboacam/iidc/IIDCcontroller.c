@@ -131,9 +131,7 @@ oacamIIDCcontroller ( void* param )
         frameWait = 1000;
       }
 
-      pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-      buffersFree = cameraInfo->buffersFree;
-      pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+      buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
       if ( buffersFree ) {
         nextBuffer = cameraInfo->nextBuffer;
@@ -155,6 +153,8 @@ oacamIIDCcontroller ( void* param )
 
           if ( !exitThread ) {
             if ( haveFrame ) {
+              cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+                  oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
               cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
                   OA_CALLBACK_NEW_FRAME;
               cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -165,14 +165,11 @@ oacamIIDCcontroller ( void* param )
                   cameraInfo->currentFrame;
               cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
                   cameraInfo->currentFrame->image_bytes;
-              pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-              oaDLListAddToTail ( cameraInfo->callbackQueue,
+              oacamCallbackRingPush ( &cameraInfo->callbackRing,
                   &cameraInfo->frameCallbacks[ nextBuffer ]);
-              cameraInfo->buffersFree--;
+              OA_CLAIM_BUFFER ( cameraInfo );
               cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
                   cameraInfo->configuredBuffers;
-              pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-              pthread_cond_broadcast ( &cameraInfo->callbackQueued );
             } else {
               usleep ( frameWait );
 //            maxWaitTime -= frameWait;
@@ -859,7 +856,7 @@ _doCameraConfig ( IIDC_STATE* cameraInfo )
 
   if ( restart ) {
     if (( ret = p_dc1394_capture_setup ( cameraInfo->iidcHandle,
-        OA_CAM_BUFFERS, DC1394_CAPTURE_FLAGS_DEFAULT )) != DC1394_SUCCESS ) {
+        cameraInfo->configuredBuffers, DC1394_CAPTURE_FLAGS_DEFAULT )) != DC1394_SUCCESS ) {
       oaLogError ( OA_LOG_CAMERA, "%s: dc1394_capture_setup failed: %d",
 					__func__, ret );
       return -OA_ERR_CAMERA_IO;
@@ -891,7 +888,7 @@ _processStreamingStart ( IIDC_STATE* cameraInfo, OA_COMMAND* command )
   cameraInfo->streamingCallback.callbackArg = cb->callbackArg;
 
   if (( ret = p_dc1394_capture_setup ( cameraInfo->iidcHandle,
-      OA_CAM_BUFFERS, DC1394_CAPTURE_FLAGS_DEFAULT )) != DC1394_SUCCESS ) {
+      cameraInfo->configuredBuffers, DC1394_CAPTURE_FLAGS_DEFAULT )) != DC1394_SUCCESS ) {
     oaLogError ( OA_LOG_CAMERA, "%s: dc1394_capture_setup failed: %d",
 				__func__, ret );
     return -OA_ERR_SYSTEM_ERROR;
@@ -937,9 +934,7 @@ _processStreamingStop ( IIDC_STATE* cameraInfo, OA_COMMAND* command )
 
   queueEmpty = 0;
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( OA_CAM_BUFFERS == cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    queueEmpty = ( cameraInfo->configuredBuffers == OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
     if ( !queueEmpty ) {
       usleep ( 100 );
     }
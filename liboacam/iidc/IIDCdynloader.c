@@ -43,6 +43,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "IIDCprivate.h"
 
 
@@ -125,342 +126,76 @@ dc1394error_t		( *p_dc1394_format7_get_unit_size )( dc1394camera_t*,
 											dc1394video_mode_t, uint32_t*, uint32_t* );
 
 #if HAVE_LIBDL && !HAVE_STATIC_LIBDC1394
-static void*    _getDLSym ( void*, const char* );
-#endif
 
-int
-_iidcInitLibraryFunctionPointers ( void )
-{
-#if HAVE_LIBDL && !HAVE_STATIC_LIBDC1394
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( dc1394_new ),
+	OA_DL_SYM( dc1394_free ),
+	OA_DL_SYM( dc1394_camera_enumerate ),
+	OA_DL_SYM( dc1394_camera_free_list ),
+	OA_DL_SYM( dc1394_camera_new_unit ),
+	OA_DL_SYM( dc1394_camera_free ),
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( dc1394_camera_get_broadcast ),
+	OA_DL_SYM( dc1394_camera_reset ),
+	OA_DL_SYM( dc1394_capture_dequeue ),
+	OA_DL_SYM( dc1394_capture_enqueue ),
+	OA_DL_SYM( dc1394_capture_setup ),
+	OA_DL_SYM( dc1394_capture_stop ),
+	OA_DL_SYM( dc1394_external_trigger_set_mode ),
+	OA_DL_SYM( dc1394_external_trigger_set_polarity ),
+	OA_DL_SYM( dc1394_external_trigger_set_power ),
+	OA_DL_SYM( dc1394_feature_get_absolute_value ),
+	OA_DL_SYM( dc1394_feature_get ),
+	OA_DL_SYM( dc1394_feature_get_all ),
+	OA_DL_SYM( dc1394_feature_get_mode ),
+	OA_DL_SYM( dc1394_feature_get_value ),
+	OA_DL_SYM( dc1394_feature_set_absolute_control ),
+	OA_DL_SYM( dc1394_feature_set_absolute_value ),
+	OA_DL_SYM( dc1394_feature_set_mode ),
+	OA_DL_SYM( dc1394_feature_set_power ),
+	OA_DL_SYM( dc1394_feature_set_value ),
+	OA_DL_SYM( dc1394_feature_temperature_get_value ),
+	OA_DL_SYM( dc1394_feature_temperature_set_value ),
+	OA_DL_SYM( dc1394_feature_whitebalance_get_value ),
+	OA_DL_SYM( dc1394_feature_whitebalance_set_value ),
+	OA_DL_SYM( dc1394_format7_get_modeset ),
+	OA_DL_SYM( dc1394_format7_set_roi ),
+	OA_DL_SYM( dc1394_get_color_coding_from_video_mode ),
+	OA_DL_SYM( dc1394_get_image_size_from_video_mode ),
+	OA_DL_SYM( dc1394_video_get_supported_framerates ),
+	OA_DL_SYM( dc1394_video_get_supported_modes ),
+	OA_DL_SYM( dc1394_video_set_framerate ),
+	OA_DL_SYM( dc1394_video_set_iso_speed ),
+	OA_DL_SYM( dc1394_video_set_mode ),
+	OA_DL_SYM( dc1394_video_set_operation_mode ),
+	OA_DL_SYM( dc1394_video_set_transmission ),
+	OA_DL_SYM( dc1394_format7_get_unit_size ),
+	OA_DL_END
+};
+
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-  const char*		libName = "libdc1394.dylib";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libdc1394.dylib",
+		enumSymbols, otherSymbols );
 #else
-  const char*		libName = "libdc1394.so.22";
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
-#endif
-
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libdc1394.so.22",
+		enumSymbols, otherSymbols );
 #endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
 #endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
-#endif
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libPath, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-		if (!( *( void** )( &p_dc1394_camera_enumerate ) = _getDLSym ( libHandle,
-		    "dc1394_camera_enumerate" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_camera_free ) = _getDLSym ( libHandle,
-		    "dc1394_camera_free" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_camera_free_list ) = _getDLSym ( libHandle,
-		    "dc1394_camera_free_list" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_camera_get_broadcast ) = _getDLSym ( libHandle,
-		    "dc1394_camera_get_broadcast" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_camera_new_unit ) = _getDLSym ( libHandle,
-		    "dc1394_camera_new_unit" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_camera_reset ) = _getDLSym ( libHandle,
-		    "dc1394_camera_reset" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_capture_dequeue ) = _getDLSym ( libHandle,
-		    "dc1394_capture_dequeue" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_capture_enqueue ) = _getDLSym ( libHandle,
-		    "dc1394_capture_enqueue" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_capture_setup ) = _getDLSym ( libHandle,
-		    "dc1394_capture_setup" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_capture_stop ) = _getDLSym ( libHandle,
-		    "dc1394_capture_stop" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_external_trigger_set_mode ) =
-				_getDLSym ( libHandle, "dc1394_external_trigger_set_mode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_external_trigger_set_polarity ) =
-				_getDLSym ( libHandle, "dc1394_external_trigger_set_polarity" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_external_trigger_set_power ) =
-				_getDLSym ( libHandle, "dc1394_external_trigger_set_power" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_get_absolute_value ) =
-				_getDLSym ( libHandle, "dc1394_feature_get_absolute_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_get ) = _getDLSym ( libHandle,
-		    "dc1394_feature_get" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_get_all ) = _getDLSym ( libHandle,
-		    "dc1394_feature_get_all" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_get_mode ) = _getDLSym ( libHandle,
-		    "dc1394_feature_get_mode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_get_value ) = _getDLSym ( libHandle,
-		    "dc1394_feature_get_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_set_absolute_control ) =
-				_getDLSym ( libHandle, "dc1394_feature_set_absolute_control" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_set_absolute_value ) =
-				_getDLSym ( libHandle, "dc1394_feature_set_absolute_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_set_mode ) = _getDLSym ( libHandle,
-		    "dc1394_feature_set_mode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_set_power ) = _getDLSym ( libHandle,
-		    "dc1394_feature_set_power" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_set_value ) = _getDLSym ( libHandle,
-		    "dc1394_feature_set_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
 
-		if (!( *( void** )( &p_dc1394_feature_temperature_get_value ) =
-				_getDLSym ( libHandle, "dc1394_feature_temperature_get_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_temperature_set_value ) =
-				_getDLSym ( libHandle, "dc1394_feature_temperature_set_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_whitebalance_get_value ) =
-				_getDLSym ( libHandle, "dc1394_feature_whitebalance_get_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_feature_whitebalance_set_value ) =
-				_getDLSym ( libHandle, "dc1394_feature_whitebalance_set_value" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_format7_get_modeset ) = _getDLSym ( libHandle,
-		    "dc1394_format7_get_modeset" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_format7_set_roi ) = _getDLSym ( libHandle,
-		    "dc1394_format7_set_roi" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_free ) = _getDLSym ( libHandle,
-		    "dc1394_free" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_get_color_coding_from_video_mode ) =
-				_getDLSym ( libHandle, "dc1394_get_color_coding_from_video_mode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_get_image_size_from_video_mode ) =
-				_getDLSym ( libHandle, "dc1394_get_image_size_from_video_mode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_new ) = _getDLSym ( libHandle,
-		    "dc1394_new" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_video_get_supported_framerates ) =
-				_getDLSym ( libHandle, "dc1394_video_get_supported_framerates" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_video_get_supported_modes ) =
-				_getDLSym ( libHandle, "dc1394_video_get_supported_modes" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_video_set_framerate ) = _getDLSym ( libHandle,
-		    "dc1394_video_set_framerate" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_video_set_iso_speed ) = _getDLSym ( libHandle,
-		    "dc1394_video_set_iso_speed" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_video_set_mode ) = _getDLSym ( libHandle,
-		    "dc1394_video_set_mode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_video_set_operation_mode ) =
-				_getDLSym ( libHandle, "dc1394_video_set_operation_mode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_video_set_transmission ) =
-				_getDLSym ( libHandle, "dc1394_video_set_transmission" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_dc1394_format7_get_unit_size ) =
-				_getDLSym ( libHandle, "dc1394_format7_get_unit_size" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-	}
 
+static int
+_iidcLoad ( int level )
+{
+#if HAVE_LIBDL && !HAVE_STATIC_LIBDC1394
+	return oacamDLLoad ( &lib, level );
 #else
 #if HAVE_STATIC_LIBDC1394
 
+	( void ) level;
+
 	p_dc1394_camera_enumerate = dc1394_camera_enumerate;
 	p_dc1394_camera_free = dc1394_camera_free;
 	p_dc1394_camera_free_list = dc1394_camera_free_list;
@@ -508,28 +243,28 @@ retry:
 	p_dc1394_video_set_mode = dc1394_video_set_mode;
 	p_dc1394_video_set_operation_mode = dc1394_video_set_operation_mode;
 	p_dc1394_video_set_transmission = dc1394_video_set_transmission;
-
+	return OA_ERR_NONE;
 #else
+	( void ) level;
 	return OA_ERR_LIBRARY_NOT_FOUND;
 #endif	/* HAVE_STATIC_LIBDC1394 */
 #endif	/* HAVE_LIBDL && !HAVE_STATIC_LIBDC1394 */
-	return OA_ERR_NONE;
 }
 
-#if HAVE_LIBDL && !HAVE_STATIC_LIBDC1394
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+
+// Only the calls needed to enumerate cameras are resolved here
+
+int
+_iidcInitLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
+	return _iidcLoad ( OA_DL_ENUMERATE );
+}
 
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libdc1394 DL error: %s", __func__, error );
-    addr = 0;
-  }
 
-  return addr;
+int
+_iidcInitAllLibraryFunctionPointers ( void )
+{
+	return _iidcLoad ( OA_DL_ALL );
 }
-#endif
+
 #endif	/* HAVE_LIBDC1394 */
@@ -39,6 +39,8 @@ extern int		oaIIDCCameraGetControlRange ( oaCamera*, int,
 
 extern void*		oacamIIDCcontroller ( void* );
 extern void*		oacamIIDCcallbackHandler ( void* );
+struct SHARED_STATE;
+extern void		oacamIIDCrequeueFrame ( struct SHARED_STATE*, CALLBACK* );
 
 extern const FRAMESIZES* oaIIDCCameraGetFrameSizes ( oaCamera* );
 extern const FRAMERATES* oaIIDCCameraGetFrameRates ( oaCamera*, int, int );
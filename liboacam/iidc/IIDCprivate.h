@@ -28,6 +28,7 @@
 #define OA_IIDC_PRIVATE_H
 
 extern int							_iidcInitLibraryFunctionPointers ( void );
+extern int							_iidcInitAllLibraryFunctionPointers ( void );
 
 extern dc1394error_t		( *p_dc1394_camera_enumerate )( dc1394_t*,
 														dc1394camera_list_t ** );
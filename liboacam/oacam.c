@@ -30,6 +30,7 @@
 #if HAVE_LIMITS_H
 #include <limits.h> 
 #endif
+#include <pthread.h>
 #if HAVE_LIBFLYCAPTURE2
 #include <flycapture/C/FlyCapture2_C.h>
 #endif
@@ -41,6 +42,8 @@
 
 #include "oacamversion.h"
 #include "oacamprivate.h"
+#include "cameraCache.h"
+#include "cameraHooks.h"
 
 #if HAVE_LIBV4L2
 #include "v4l2/V4L2oacam.h"
@@ -122,6 +125,7 @@
 #if HAVE_PLAYERONE
 #include "playerone/POAoacam.h"
 #endif
+#include "replay/replayoacam.h"
 
 
 oaInterface	oaCameraInterfaces[] = {
@@ -460,52 +464,283 @@ oaInterface	oaCameraInterfaces[] = {
 		0,
 		OA_UDC_FLAG_NONE
 	},
+  {
+    OA_CAM_IF_REPLAY,
+    "Replay",
+    "REPLAY",
+    oaReplayGetCameras,
+    0,
+    OA_UDC_FLAG_NONE
+  },
   { 0, "", "", 0, 0, OA_UDC_FLAG_NONE }
 };
 
 
 char*               installPathRoot = 0;
-static CAMERA_LIST	list;
+static unsigned int	enumerationPolicy = OA_CAM_ENUM_PARALLEL;
+
+// Every list returned by oaGetCameras() is remembered until it is handed
+// back, so any number of callers can hold lists at once and each can be
+// released independently.  Whole enumerations are serialised by enumMutex,
+// which also protects the cache and the record of outstanding lists, so
+// no driver's enumerate function is ever entered twice at once.  Different
+// drivers' enumerators do run concurrently.  That is safe because the only
+// static state they keep is their SDK library handle, which the shared
+// loader guards with a per-library lock (aravis keeps its own), and those
+// using libusb directly each create a private context.  Devices in a list
+// built from the cache belong to the cache, so the cache is only flushed
+// or has lists replaced while no such list is held.
+
+typedef struct CAMERA_ENUMERATION {
+	CAMERA_LIST									list;
+	int													cached;
+	struct CAMERA_ENUMERATION*	next;
+} CAMERA_ENUMERATION;
+
+static pthread_mutex_t			enumMutex = PTHREAD_MUTEX_INITIALIZER;
+static CAMERA_ENUMERATION*	enumerations = 0;
+static unsigned int					cachedLists = 0;
+
+typedef struct {
+	int						interfaceIndex;
+	unsigned long	featureFlags;
+	CAMERA_LIST		devices;
+	int						result;
+} ENUM_JOB;
+
+
+static void*
+_enumerateInterface ( void* param )
+{
+	ENUM_JOB*			job = param;
+	oaInterface*	interface = &oaCameraInterfaces[ job->interfaceIndex ];
+
+	job->result = interface->enumerate ( &job->devices, job->featureFlags,
+			interface->flags );
+	oacamHookDevices ( &job->devices );
+	return 0;
+}
+
+
+int
+oaSetCameraEnumeration ( unsigned int policy )
+{
+	if ( policy & ~( OA_CAM_ENUM_PARALLEL | OA_CAM_ENUM_CACHE )) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	pthread_mutex_lock ( &enumMutex );
+	enumerationPolicy = policy;
+	if (!( policy & OA_CAM_ENUM_CACHE ) && !cachedLists ) {
+		oacamCameraCacheFlush();
+	}
+	pthread_mutex_unlock ( &enumMutex );
+	return OA_ERR_NONE;
+}
+
+
+void
+oaFlushCameraCache ( void )
+{
+	pthread_mutex_lock ( &enumMutex );
+	if ( !cachedLists ) {
+		oacamCameraCacheFlush();
+	}
+	pthread_mutex_unlock ( &enumMutex );
+}
+
+
+static int
+_enumerate ( CAMERA_ENUMERATION* enumeration, unsigned long featureFlags,
+		unsigned int policy )
+{
+	ENUM_JOB			jobs[ OA_CAM_IF_COUNT ];
+	CAMERA_LIST		lists[ OA_CAM_IF_COUNT ];
+	pthread_t			threads[ OA_CAM_IF_COUNT ];
+	unsigned char	running[ OA_CAM_IF_COUNT ];
+	unsigned char	stale[ OA_CAM_IF_COUNT ];
+	CAMERA_LIST*	list = &enumeration->list;
+	int						i, err, numStale, cacheable;
+	unsigned int	j;
+
+	cacheable = ( policy & OA_CAM_ENUM_CACHE ) ? 1 : 0;
+	if ( cacheable ) {
+		numStale = oacamCameraCacheLookup ( featureFlags, lists, stale );
+		// Replacing a cached list would free devices another caller still
+		// holds, so in that case everything is enumerated afresh instead
+		if ( numStale && cachedLists ) {
+			cacheable = 0;
+		}
+	}
+	if ( !cacheable ) {
+		for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+			OA_CLEAR ( lists[i] );
+			stale[i] = 1;
+		}
+	}
+
+	// Each interface fills its own list so they can run concurrently and
+	// still be merged in the order of oaCameraInterfaces[]
+	for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+		OA_CLEAR ( jobs[i] );
+		jobs[i].interfaceIndex = i;
+		jobs[i].featureFlags = featureFlags;
+		running[i] = 0;
+		if ( stale[i] && oaCameraInterfaces[i].interfaceType ) {
+			if (( policy & OA_CAM_ENUM_PARALLEL ) &&
+					!pthread_create ( &threads[i], 0, _enumerateInterface,
+					&jobs[i] )) {
+				running[i] = 1;
+			} else {
+				( void ) _enumerateInterface ( &jobs[i] );
+			}
+		}
+	}
+
+	err = OA_ERR_NONE;
+	for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+		if ( running[i] ) {
+			( void ) pthread_join ( threads[i], 0 );
+		}
+		// An interface whose SDK can't be loaded returns a positive error
+		// and just contributes no cameras
+		if ( stale[i] ) {
+			if ( err == OA_ERR_NONE && jobs[i].result < 0 ) {
+				err = jobs[i].result;
+			}
+			lists[i] = jobs[i].devices;
+		}
+	}
+
+	// The merged array is always allocated, even if empty, so that it
+	// identifies the list when it is released, and it is null-terminated
+	if ( err == OA_ERR_NONE ) {
+		err = _oaCheckCameraArraySize ( list );
+	}
+	for ( i = 0; err == OA_ERR_NONE && i < OA_CAM_IF_COUNT; i++ ) {
+		for ( j = 0; err == OA_ERR_NONE && j < lists[i].numCameras; j++ ) {
+			list->cameraList[ list->numCameras++ ] = lists[i].cameraList[j];
+			err = _oaCheckCameraArraySize ( list );
+		}
+	}
+	if ( err < 0 ) {
+		free (( void* ) list->cameraList );
+		list->cameraList = 0;
+		list->numCameras = list->maxCameras = 0;
+		for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+			if ( stale[i] ) {
+				_oaFreeCameraDeviceList ( &lists[i] );
+			}
+		}
+		return err;
+	}
+	list->cameraList[ list->numCameras ] = 0;
+
+	// With the cache enabled the devices belong to the cache and only the
+	// merged array is released by oaReleaseCameras()
+	if ( cacheable ) {
+		oacamCameraCacheStore ( featureFlags, lists, stale );
+		enumeration->cached = 1;
+		cachedLists++;
+	} else {
+		for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+			free (( void* ) lists[i].cameraList );
+		}
+	}
+
+	return list->numCameras;
+}
+
 
 int
 oaGetCameras( oaCameraDevice*** deviceList, unsigned long featureFlags )
 {
-  int           i, err;
-
-  list.cameraList = 0;
-  list.numCameras = list.maxCameras = 0;
-
-  for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
-    if ( oaCameraInterfaces[i].interfaceType ) {
-      if (( err = oaCameraInterfaces[i].enumerate ( &list, featureFlags,
-          oaCameraInterfaces[i].flags )) < 0 ) {
-				if ( err != OA_ERR_LIBRARY_NOT_FOUND && err !=
-						OA_ERR_SYMBOL_NOT_FOUND ) {
-					_oaFreeCameraDeviceList ( &list );
-					list.numCameras = 0;
-					list.cameraList = 0;
-					return err;
-				}
-      }
-    }
-  }
-  
-  *deviceList = list.cameraList;
-  return list.numCameras;
+	CAMERA_ENUMERATION*	enumeration;
+	int									ret;
+
+	if (!( enumeration = calloc ( 1, sizeof ( CAMERA_ENUMERATION )))) {
+		return -OA_ERR_MEM_ALLOC;
+	}
+
+	pthread_mutex_lock ( &enumMutex );
+	if (( ret = _enumerate ( enumeration, featureFlags,
+			enumerationPolicy )) >= 0 ) {
+		enumeration->next = enumerations;
+		enumerations = enumeration;
+		*deviceList = enumeration->list.cameraList;
+	}
+	pthread_mutex_unlock ( &enumMutex );
+
+	if ( ret < 0 ) {
+		free (( void* ) enumeration );
+	}
+	return ret;
+}
+
+
+/*
+ * Enumerate the cameras on just one interface, bypassing the cache, to
+ * find a camera again quickly after it has been replugged.  The devices
+ * belong to the caller, to be freed with _oaFreeCameraDeviceList().
+ */
+
+int
+oacamEnumerateInterface ( int interfaceType, CAMERA_LIST* list )
+{
+	ENUM_JOB		job;
+	int					i;
+
+	for ( i = 0; i < OA_CAM_IF_COUNT; i++ ) {
+		if ( oaCameraInterfaces[i].interfaceType == interfaceType &&
+				oaCameraInterfaces[i].enumerate ) {
+			break;
+		}
+	}
+	if ( i == OA_CAM_IF_COUNT ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+
+	OA_CLEAR ( job );
+	job.interfaceIndex = i;
+	pthread_mutex_lock ( &enumMutex );
+	( void ) _enumerateInterface ( &job );
+	pthread_mutex_unlock ( &enumMutex );
+
+	*list = job.devices;
+	return ( job.result < 0 ) ? job.result : ( int ) list->numCameras;
 }
 
 
 void
 oaReleaseCameras ( oaCameraDevice** deviceList )
 {
-  // This is a bit cack-handed because we don't know from the data
-  // passed in how many cameras were found last time so we have to
-  // consult a static global instead.
-
-  _oaFreeCameraDeviceList ( &list );
-  list.numCameras = 0;
-  list.cameraList = 0;
-  return;
+	CAMERA_ENUMERATION**	prev;
+	CAMERA_ENUMERATION*		enumeration;
+
+	pthread_mutex_lock ( &enumMutex );
+	for ( prev = &enumerations; *prev; prev = &( *prev )->next ) {
+		if (( *prev )->list.cameraList == deviceList ) {
+			break;
+		}
+	}
+	if (!( enumeration = *prev )) {
+		pthread_mutex_unlock ( &enumMutex );
+		oaLogWarning ( OA_LOG_CAMERA, "%s: %p is not a camera list", __func__,
+				deviceList );
+		return;
+	}
+	*prev = enumeration->next;
+
+	if ( enumeration->cached ) {
+		free (( void* ) enumeration->list.cameraList );
+		if ( !--cachedLists && !( enumerationPolicy & OA_CAM_ENUM_CACHE )) {
+			oacamCameraCacheFlush();
+		}
+	} else {
+		_oaFreeCameraDeviceList ( &enumeration->list );
+	}
+	pthread_mutex_unlock ( &enumMutex );
+
+	free (( void* ) enumeration );
 }
 
 
@@ -28,6 +28,9 @@
 #define OA_CAM_PRIVATE_H
 
 #include <oa_common.h>
+
+#include <pthread.h>
+
 #include <openastro/camera.h>
 #include <openastro/controller.h>
 
@@ -53,6 +56,8 @@ extern int64_t		oacamGetControlValue ( oaControlValue* );
 extern int				oacamSetControl ( oaCamera*, int, oaControlValue*, int );
 extern int				oacamStartStreaming ( oaCamera*, void* (*)(void*, void*,
 											int, void* ), void* );
+extern int				oacamStartStreamingLeased ( oaCamera*,
+											void* (*)(void*, oaFrameLease* ), void* );
 extern int				oacamIsStreaming ( oaCamera* );
 extern int				oacamStopStreaming ( oaCamera* );
 extern int				oacamStartExposure ( oaCamera*,
@@ -65,10 +70,15 @@ extern int				oacamSetFrameInterval ( oaCamera*, int, int );
 
 extern int				_oaCheckCameraArraySize ( CAMERA_LIST* );
 extern void				_oaFreeCameraDeviceList ( CAMERA_LIST* );
+extern int				oacamEnumerateInterface ( int, CAMERA_LIST* );
 extern int				_oaInitCameraStructs ( oaCamera**, void**, size_t,
 											COMMON_INFO**);
 extern int				oacamStartTimer ( uint64_t, void* );
 extern void				oacamAbortTimer ( void* );
+extern uint64_t			oacamMonotonicTime ( void );
+extern void				oacamSleepUntil ( uint64_t );
+extern int				oacamCreateThread ( pthread_t*, unsigned int,
+											void* (*)( void* ), void* );
 
 
 extern char*		installPathRoot;
@@ -91,7 +101,6 @@ extern char*		installPathRoot;
 	pthread_mutex_destroy ( &cameraInfo->commandQueueMutex ); \
 	pthread_mutex_destroy ( &cameraInfo->callbackQueueMutex ); \
 	pthread_mutex_destroy ( &cameraInfo->timerMutex ); \
-	pthread_cond_destroy ( &cameraInfo->callbackQueued ); \
 	pthread_cond_destroy ( &cameraInfo->commandQueued ); \
 	pthread_cond_destroy ( &cameraInfo->commandComplete ); \
 	pthread_cond_destroy ( &cameraInfo->timerState ); \
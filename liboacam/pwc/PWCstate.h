@@ -27,6 +27,8 @@
 #ifndef OA_PWC_STATE_H
 #define OA_PWC_STATE_H
 
+#include "sharedState.h"
+
 typedef struct PWC_STATE {
 
 #include "sharedDecs.h"
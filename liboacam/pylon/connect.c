@@ -109,6 +109,11 @@ oaPylonInitCamera ( oaCameraDevice* device )
 	 * probably down to me learning the two whilst trying to write the code
 	 * to get the camera to work.  I should come back and tidy it up later.
 	 */
+	if ( _pylonInitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve SDK functions", __func__ );
+		return 0;
+	}
+
 
   if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
       sizeof ( PYLON_STATE ), &commonInfo ) != OA_ERR_NONE ) {
@@ -1103,37 +1108,40 @@ oaPylonInitCamera ( oaCameraDevice* device )
 		}
 	}
 
-	cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
-	for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-		cameraInfo->buffers[i].start = 0;
+	// Frame memory is sized when streaming starts
+	if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo, 0 ) != OA_ERR_NONE ) {
+		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
+			if ( cameraInfo->frameSizes[ j ].numSizes ) {
+				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
+			}
+		}
+		FREE_DATA_STRUCTS;
+		CLOSE_PYLON;
+		return 0;
 	}
-	cameraInfo->configuredBuffers = 0;
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
-	cameraInfo->nextBuffer = 0;
-	cameraInfo->configuredBuffers = OA_CAM_BUFFERS;
-	cameraInfo->buffersFree = OA_CAM_BUFFERS;
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+	cameraInfo->frameLeases.recycle = oacamPylonRequeueFrame;
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamPylonController, ( void* ) camera )) {
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
 		}
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
-		free (( void* ) cameraInfo->buffers );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
 		CLOSE_PYLON;
     return 0;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamPylonCallbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -1145,12 +1153,9 @@ oaPylonInitCamera ( oaCameraDevice* device )
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
 		}
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
-		free (( void* ) cameraInfo->buffers );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
 		CLOSE_PYLON;
     return 0;
@@ -1201,14 +1206,12 @@ oaPylonCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
   
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     CLOSE_PYLON;
 
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
@@ -1217,9 +1220,8 @@ oaPylonCloseCamera ( oaCamera* camera )
 		}
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-		free (( void* ) cameraInfo->buffers );
     free (( void* ) camera->_common );
     free (( void* ) cameraInfo );
     free (( void* ) camera );
@@ -63,6 +63,7 @@ oacamPylonController ( void* param )
 	_Bool									haveFrame;
 	unsigned int					frameWait, bufferIdx = 0;
 	const unsigned char*	frame = 0;
+	FRAME_METADATA*				metadata;
 
   do {
     pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
@@ -129,9 +130,7 @@ oacamPylonController ( void* param )
 				frameWait = 100;
 			}
 
-			pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-			buffersFree = cameraInfo->buffersFree;
-			pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+			buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
 			if ( buffersFree ) {
 				nextBuffer = cameraInfo->nextBuffer;
@@ -165,6 +164,15 @@ oacamPylonController ( void* param )
 				}
 
 				if ( !exitThread && haveFrame ) {
+					metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+							nextBuffer );
+					if ( grab.Status == Grabbed ) {
+						metadata->hwTimestamp = grab.TimeStamp;
+						metadata->hwTimestampValid = 1;
+						metadata->frameCounter = grab.BlockID;
+						metadata->frameCounterValid = 1;
+					}
+					cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
 					cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
 							OA_CALLBACK_NEW_FRAME;
 					cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -175,14 +183,11 @@ oacamPylonController ( void* param )
 					cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
 							cameraInfo->imageBufferLength;
 					cameraInfo->frameCallbacks[ nextBuffer ].bufferIdx = bufferIdx;
-					pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-					oaDLListAddToTail ( cameraInfo->callbackQueue,
+					oacamCallbackRingPush ( &cameraInfo->callbackRing,
 							&cameraInfo->frameCallbacks[ nextBuffer ]);
-					cameraInfo->buffersFree--;
+					OA_CLAIM_BUFFER ( cameraInfo );
 					cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
 							cameraInfo->configuredBuffers;
-					pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-					pthread_cond_broadcast ( &cameraInfo->callbackQueued );
 				}
 			}
 		}
@@ -617,18 +622,18 @@ _doStart ( PYLON_STATE* cameraInfo )
 		return -OA_ERR_SYSTEM_ERROR;
 	}
 	if ( cameraInfo->imageBufferLength != payloadSize ) {
-		if ( cameraInfo->imageBufferLength < payloadSize ) {
-			for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-				if ( cameraInfo->buffers[i].start ) {
-					cameraInfo->buffers[i].start = 0;
+		if ( cameraInfo->bufferPool.bufferSize < payloadSize ) {
+			for ( i = 0; i < cameraInfo->bufferPool.count; i++ ) {
+				if ( oacamResizeBuffer (( SHARED_STATE* ) cameraInfo, i,
+						payloadSize ) != OA_ERR_NONE ) {
+					oaLogError ( OA_LOG_CAMERA, "%s: buffer allocation failed",
+							__func__ );
+					return -OA_ERR_MEM_ALLOC;
 				}
-				// FIX ME -- check for errors
-				cameraInfo->buffers[i].start = realloc (
-						cameraInfo->buffers[i].start, payloadSize );
 			}
 		}
 		if ( p_PylonStreamGrabberSetMaxNumBuffer ( cameraInfo->grabberHandle,
-				OA_CAM_BUFFERS ) != GENAPI_E_OK ) {
+				cameraInfo->bufferPool.count ) != GENAPI_E_OK ) {
 			oaLogError ( OA_LOG_CAMERA,
 					"%s: PylonStreamGrabberSetMaxNumBuffer() failed", __func__ );
 			// free buffers?
@@ -654,7 +659,7 @@ _doStart ( PYLON_STATE* cameraInfo )
 		return -OA_ERR_SYSTEM_ERROR;
 	}
 
-	for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
+	for ( i = 0; i < cameraInfo->bufferPool.count; i++ ) {
 		if (( res = p_PylonStreamGrabberRegisterBuffer ( cameraInfo->grabberHandle,
 				cameraInfo->buffers[i].start, payloadSize,
 				&( cameraInfo->bufferHandle[i] ))) != GENAPI_E_OK ) {
@@ -760,7 +765,7 @@ _doStop ( PYLON_STATE* cameraInfo )
 		}
 	} while ( ready );
 
-	for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
+	for ( i = 0; i < cameraInfo->bufferPool.count; i++ ) {
 		if ( p_PylonStreamGrabberDeregisterBuffer ( cameraInfo->grabberHandle,
 					cameraInfo->bufferHandle[i] ) != GENAPI_E_OK ) {
 			oaLogError ( OA_LOG_CAMERA,
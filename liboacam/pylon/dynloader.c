@@ -41,6 +41,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "private.h"
 
 // Pointers to SDK functions so we can use them via libdl.
@@ -163,452 +164,96 @@ GENAPIC_RESULT	( *p_PylonWaitObjectWait )( PYLON_WAITOBJECT_HANDLE,
 										uint32_t, _Bool* );
 
 #if HAVE_LIBDL
-static void*		_getDLSym ( void*, const char* );
-#endif
-
-/**
- * Cycle through the list of cameras returned by the Flycapture library
- */
 
-int
-_pylonInitLibraryFunctionPointers ( void )
-{
-#if HAVE_LIBDL
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( PylonInitialize ),
+	OA_DL_SYM( PylonTerminate ),
+	OA_DL_SYM( PylonEnumerateDevices ),
+	OA_DL_SYM( PylonCreateDeviceByIndex ),
+	OA_DL_SYM( PylonDeviceOpen ),
+	OA_DL_SYM( PylonDeviceClose ),
+	OA_DL_SYM( PylonDestroyDevice ),
+	OA_DL_SYM( PylonDeviceFeatureIsReadable ),
+	OA_DL_SYM( PylonDeviceFeatureToString ),
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( PylonDeviceFeatureIsAvailable ),
+	OA_DL_SYM( PylonDeviceFeatureFromString ),
+	OA_DL_SYM( PylonGetDeviceInfoHandle ),
+	OA_DL_SYM( PylonDeviceInfoGetNumProperties ),
+	OA_DL_SYM( PylonDeviceInfoGetPropertyName ),
+	OA_DL_SYM( PylonDeviceGetNodeMap ),
+	OA_DL_SYM( PylonDeviceSetBooleanFeature ),
+	OA_DL_SYM( PylonDeviceSetIntegerFeature ),
+	OA_DL_SYM( PylonDeviceSetFloatFeature ),
+	OA_DL_SYM( PylonDeviceGetBooleanFeature ),
+	OA_DL_SYM( PylonDeviceGetIntegerFeature ),
+	OA_DL_SYM( PylonDeviceGetFloatFeature ),
+	OA_DL_SYM( GenApiNodeMapGetNumNodes ),
+	OA_DL_SYM( GenApiNodeMapGetNodeByIndex ),
+	OA_DL_SYM( GenApiNodeMapGetNode ),
+	OA_DL_SYM( GenApiNodeGetName ),
+	OA_DL_SYM( GenApiNodeGetDisplayName ),
+	OA_DL_SYM( GenApiNodeGetDescription ),
+	OA_DL_SYM( GenApiNodeGetType ),
+	OA_DL_SYM( GenApiNodeIsReadable ),
+	OA_DL_SYM( GenApiNodeIsAvailable ),
+	OA_DL_SYM( GenApiNodeIsWritable ),
+	OA_DL_SYM( GenApiEnumerationGetEntryByName ),
+	OA_DL_SYM( GenApiEnumerationGetNumEntries ),
+	OA_DL_SYM( GenApiEnumerationGetEntryByIndex ),
+	OA_DL_SYM( GenApiCategoryGetNumFeatures ),
+	OA_DL_SYM( GenApiCategoryGetFeatureByIndex ),
+	OA_DL_SYM( GenApiIntegerGetMin ),
+	OA_DL_SYM( GenApiIntegerGetMax ),
+	OA_DL_SYM( GenApiIntegerGetInc ),
+	OA_DL_SYM( GenApiIntegerGetValue ),
+	OA_DL_SYM( GenApiFloatGetMin ),
+	OA_DL_SYM( GenApiFloatGetMax ),
+	OA_DL_SYM( GenApiFloatGetValue ),
+	OA_DL_SYM( GenApiNodeFromString ),
+	OA_DL_SYM( GenApiNodeToString ),
+	OA_DL_SYM( PylonDeviceGetNumStreamGrabberChannels ),
+	OA_DL_SYM( PylonDeviceGetStreamGrabber ),
+	OA_DL_SYM( PylonStreamGrabberOpen ),
+	OA_DL_SYM( PylonStreamGrabberGetWaitObject ),
+	OA_DL_SYM( PylonStreamGrabberSetMaxNumBuffer ),
+	OA_DL_SYM( PylonStreamGrabberGetPayloadSize ),
+	OA_DL_SYM( PylonStreamGrabberSetMaxBufferSize ),
+	OA_DL_SYM( PylonStreamGrabberPrepareGrab ),
+	OA_DL_SYM( PylonStreamGrabberRegisterBuffer ),
+	OA_DL_SYM( PylonStreamGrabberQueueBuffer ),
+	OA_DL_SYM( PylonStreamGrabberStartStreamingIfMandatory ),
+	OA_DL_SYM( PylonDeviceExecuteCommandFeature ),
+	OA_DL_SYM( PylonStreamGrabberStopStreamingIfMandatory ),
+	OA_DL_SYM( PylonStreamGrabberFlushBuffersToOutput ),
+	OA_DL_SYM( PylonStreamGrabberRetrieveResult ),
+	OA_DL_SYM( PylonStreamGrabberDeregisterBuffer ),
+	OA_DL_SYM( PylonStreamGrabberFinishGrab ),
+	OA_DL_SYM( PylonStreamGrabberClose ),
+	OA_DL_SYM( PylonWaitObjectWait ),
+	OA_DL_END
+};
 
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-  const char*		libName = "libpylonc.dylib";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libpylonc.dylib",
+		enumSymbols, otherSymbols );
 #else
-  const char*		libName = "/opt/pylon/lib/libpylonc.so";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "/opt/pylon/lib/libpylonc.so",
+		enumSymbols, otherSymbols );
 #endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
 #endif
 
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
-#endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
-#endif
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libPath, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-		if (!( *( void** )( &p_PylonInitialize ) = _getDLSym ( libHandle,
-		    "PylonInitialize" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonTerminate ) = _getDLSym ( libHandle,
-		    "PylonTerminate" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonEnumerateDevices ) = _getDLSym ( libHandle,
-		    "PylonEnumerateDevices" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonCreateDeviceByIndex ) = _getDLSym ( libHandle,
-		    "PylonCreateDeviceByIndex" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceOpen ) = _getDLSym ( libHandle,
-		    "PylonDeviceOpen" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceClose ) = _getDLSym ( libHandle,
-		    "PylonDeviceClose" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDestroyDevice ) = _getDLSym ( libHandle,
-		    "PylonDestroyDevice" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceFeatureIsReadable ) = _getDLSym ( libHandle,
-		    "PylonDeviceFeatureIsReadable" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceFeatureIsAvailable ) =
-				_getDLSym ( libHandle, "PylonDeviceFeatureIsAvailable" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceFeatureToString ) =
-		    _getDLSym ( libHandle, "PylonDeviceFeatureToString" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceFeatureFromString ) =
-		    _getDLSym ( libHandle, "PylonDeviceFeatureFromString" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonGetDeviceInfoHandle ) =
-		    _getDLSym ( libHandle, "PylonGetDeviceInfoHandle" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceInfoGetNumProperties ) =
-		    _getDLSym ( libHandle, "PylonDeviceInfoGetNumProperties" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceInfoGetPropertyName ) =
-		    _getDLSym ( libHandle, "PylonDeviceInfoGetPropertyName" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_PylonDeviceGetNodeMap ) =
-		    _getDLSym ( libHandle, "PylonDeviceGetNodeMap" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_PylonDeviceSetBooleanFeature ) =
-		    _getDLSym ( libHandle, "PylonDeviceSetBooleanFeature" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceSetIntegerFeature ) =
-		    _getDLSym ( libHandle, "PylonDeviceSetIntegerFeature" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceSetFloatFeature ) =
-		    _getDLSym ( libHandle, "PylonDeviceSetFloatFeature" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceGetBooleanFeature ) =
-		    _getDLSym ( libHandle, "PylonDeviceGetBooleanFeature" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceGetIntegerFeature ) =
-		    _getDLSym ( libHandle, "PylonDeviceGetIntegerFeature" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceGetFloatFeature ) =
-		    _getDLSym ( libHandle, "PylonDeviceGetFloatFeature" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_GenApiNodeMapGetNumNodes ) =
-		    _getDLSym ( libHandle, "GenApiNodeMapGetNumNodes" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeMapGetNodeByIndex ) =
-		    _getDLSym ( libHandle, "GenApiNodeMapGetNodeByIndex" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeMapGetNode ) =
-		    _getDLSym ( libHandle, "GenApiNodeMapGetNode" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeGetName ) =
-		    _getDLSym ( libHandle, "GenApiNodeGetName" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeGetDisplayName ) =
-		    _getDLSym ( libHandle, "GenApiNodeGetDisplayName" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeGetDescription ) =
-		    _getDLSym ( libHandle, "GenApiNodeGetDescription" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeGetType ) =
-		    _getDLSym ( libHandle, "GenApiNodeGetType" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeIsReadable ) =
-		    _getDLSym ( libHandle, "GenApiNodeIsReadable" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeIsAvailable ) =
-		    _getDLSym ( libHandle, "GenApiNodeIsAvailable" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeIsWritable ) =
-		    _getDLSym ( libHandle, "GenApiNodeIsWritable" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_GenApiEnumerationGetEntryByName ) =
-		    _getDLSym ( libHandle, "GenApiEnumerationGetEntryByName" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiEnumerationGetNumEntries ) =
-		    _getDLSym ( libHandle, "GenApiEnumerationGetNumEntries" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiEnumerationGetEntryByIndex ) =
-		    _getDLSym ( libHandle, "GenApiEnumerationGetEntryByIndex" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_GenApiCategoryGetNumFeatures ) =
-		    _getDLSym ( libHandle, "GenApiCategoryGetNumFeatures" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiCategoryGetFeatureByIndex ) =
-		    _getDLSym ( libHandle, "GenApiCategoryGetFeatureByIndex" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_GenApiIntegerGetMin ) =
-		    _getDLSym ( libHandle, "GenApiIntegerGetMin" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiIntegerGetMax ) =
-		    _getDLSym ( libHandle, "GenApiIntegerGetMax" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiIntegerGetInc ) =
-		    _getDLSym ( libHandle, "GenApiIntegerGetInc" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiIntegerGetValue ) =
-		    _getDLSym ( libHandle, "GenApiIntegerGetValue" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_GenApiFloatGetMin ) =
-		    _getDLSym ( libHandle, "GenApiFloatGetMin" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiFloatGetMax ) =
-		    _getDLSym ( libHandle, "GenApiFloatGetMax" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiFloatGetValue ) =
-		    _getDLSym ( libHandle, "GenApiFloatGetValue" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_GenApiNodeFromString ) =
-		    _getDLSym ( libHandle, "GenApiNodeFromString" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_GenApiNodeToString ) =
-		    _getDLSym ( libHandle, "GenApiNodeToString" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_PylonDeviceGetNumStreamGrabberChannels ) =
-		    _getDLSym ( libHandle, "PylonDeviceGetNumStreamGrabberChannels" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceGetStreamGrabber ) =
-		    _getDLSym ( libHandle, "PylonDeviceGetStreamGrabber" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberOpen ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberOpen" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberGetWaitObject ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberGetWaitObject" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberSetMaxNumBuffer ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberSetMaxNumBuffer" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberGetPayloadSize ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberGetPayloadSize" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberSetMaxBufferSize ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberSetMaxBufferSize" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberPrepareGrab ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberPrepareGrab" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberRegisterBuffer ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberRegisterBuffer" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberQueueBuffer ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberQueueBuffer" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberStartStreamingIfMandatory ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberStartStreamingIfMandatory" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonDeviceExecuteCommandFeature ) =
-		    _getDLSym ( libHandle, "PylonDeviceExecuteCommandFeature" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberStopStreamingIfMandatory ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberStopStreamingIfMandatory" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberFlushBuffersToOutput ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberFlushBuffersToOutput" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberRetrieveResult ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberRetrieveResult" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberDeregisterBuffer ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberDeregisterBuffer" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberFinishGrab ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberFinishGrab" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_PylonStreamGrabberClose ) =
-		    _getDLSym ( libHandle, "PylonStreamGrabberClose" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_PylonWaitObjectWait ) =
-		    _getDLSym ( libHandle, "PylonWaitObjectWait" ))) {
-		  dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-	}
-#else /* HAVE_LIBDL */
+
+static int
+_pylonLoad ( int level )
+{
+#if HAVE_LIBDL
+	return oacamDLLoad ( &lib, level );
+#else
+	( void ) level;
 
   p_PylonInitialize = PylonInitialize;
   p_PylonTerminate = PylonTerminate;
@@ -687,26 +332,22 @@ retry:
 	p_PylonStreamGrabberClose = PylonStreamGrabberClose;
 
 	p_PylonWaitObjectWait = PylonWaitObjectWait;
-
-#endif /* HAVE_LIBDL */
-
-  return OA_ERR_NONE;
+	return OA_ERR_NONE;
+#endif	/* HAVE_LIBDL */
 }
 
 
-#if HAVE_LIBDL
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+// Only the calls needed to enumerate cameras are resolved here
+
+int
+_pylonInitLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
+	return _pylonLoad ( OA_DL_ENUMERATE );
+}
 
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libpylonc DL error: %s", __func__, error );
-    addr = 0;
-  }
 
-  return addr;
+int
+_pylonInitAllLibraryFunctionPointers ( void )
+{
+	return _pylonLoad ( OA_DL_ALL );
 }
-#endif
@@ -47,6 +47,8 @@ extern int		oaPylonCameraTestROISize ( oaCamera*, unsigned int,
 
 extern void*		oacamPylonController ( void* );
 extern void*		oacamPylonCallbackHandler ( void* );
+struct SHARED_STATE;
+extern void		oacamPylonRequeueFrame ( struct SHARED_STATE*, CALLBACK* );
 
 extern const FRAMESIZES* oaPylonCameraGetFrameSizes ( oaCamera* );
 //extern const FRAMERATES* oaPylonCameraGetFrameRates ( oaCamera*, int, int );
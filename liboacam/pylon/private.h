@@ -28,6 +28,7 @@
 #define OA_PYLON_PRIVATE_H
 
 extern int						_pylonInitLibraryFunctionPointers ( void );
+extern int						_pylonInitAllLibraryFunctionPointers ( void );
 
 extern GENAPIC_RESULT	( *p_PylonInitialize )( void );
 extern GENAPIC_RESULT	( *p_PylonTerminate )( void );
@@ -41,15 +41,12 @@ typedef struct PYLON_STATE {
 	PYLON_DEVICE_HANDLE					deviceHandle;
 	PYLON_STREAMGRABBER_HANDLE	grabberHandle;
 	PYLON_WAITOBJECT_HANDLE			waitHandle;
-	PYLON_STREAMBUFFER_HANDLE		bufferHandle[ OA_CAM_BUFFERS ];
-	unsigned int								ctx[ OA_CAM_BUFFERS ];
+	PYLON_STREAMBUFFER_HANDLE		bufferHandle[ OA_CAM_MAX_BUFFERS ];
+	unsigned int								ctx[ OA_CAM_MAX_BUFFERS ];
 
   // video mode settings
   int			maxBytesPerPixel;
 
-  // buffering for image transfers
-  frameBuffer*		buffers;
-
   // camera status
   int			colour;
   int			cfaPattern;
@@ -55,7 +55,6 @@ static int		oaIMG132ECloseCamera ( oaCamera* );
 int
 _IMG132EInitCamera ( oaCamera* camera )
 {
-  int		i, j;
   QHY_STATE*	cameraInfo = camera->_private;
   COMMON_INFO*	commonInfo = camera->_common;
   void*		dummy;
@@ -152,12 +151,12 @@ _IMG132EInitCamera ( oaCamera* camera )
     return -OA_ERR_SYSTEM_ERROR;
   }
 
-  pthread_create ( &cameraInfo->eventHandler, 0, _img132eEventHandler,
-      ( void* ) cameraInfo );
+  oacamCreateThread ( &cameraInfo->eventHandler, OA_CAM_THREAD_EVENTS,
+      _img132eEventHandler, ( void* ) cameraInfo );
 
-  if (!( cameraInfo->buffers = calloc ( OA_CAM_BUFFERS,
-      sizeof ( frameBuffer )))) {
-    oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffer array failed",
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: buffer allocation failed",
 				__func__ );
     cameraInfo->stopCallbackThread = 1;
     pthread_join ( cameraInfo->eventHandler, &dummy );
@@ -165,66 +164,41 @@ _IMG132EInitCamera ( oaCamera* camera )
     return -OA_ERR_MEM_ALLOC;
   }
 
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffer failed",  __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-      cameraInfo->stopCallbackThread = 1;
-      pthread_join ( cameraInfo->eventHandler, &dummy );
-      free (( void* ) cameraInfo->buffers );
-      free (( void* ) cameraInfo->frameSizes[1].sizes );
-      return -OA_ERR_MEM_ALLOC;
-    }
-  }
-
-  cameraInfo->buffersFree = cameraInfo->configuredBuffers;
   cameraInfo->nextBuffer = 0;
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamIMG132Econtroller, ( void* ) camera )) {
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     cameraInfo->stopCallbackThread = 1;
     pthread_join ( cameraInfo->eventHandler, &dummy );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) camera->_common );
     free (( void* ) camera->_private );
     free (( void* ) camera );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return -OA_ERR_SYSTEM_ERROR;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamQHYcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
     cameraInfo->stopControllerThread = 1;
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     cameraInfo->stopCallbackThread = 1;
     pthread_join ( cameraInfo->eventHandler, &dummy );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) camera->_common );
     free (( void* ) camera->_private );
     free (( void* ) camera );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return -OA_ERR_SYSTEM_ERROR;
   }
 
@@ -250,7 +224,7 @@ oaIMG132ECameraGetFrameSizes ( oaCamera* camera )
 static int
 oaIMG132ECloseCamera ( oaCamera* camera )
 {
-  int		j, res;
+  int		res;
   QHY_STATE*	cameraInfo;
   void*		dummy;
 
@@ -276,27 +250,21 @@ oaIMG132ECloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
+    oacamUsbStreamFree ( &cameraInfo->usbStream );
     libusb_release_interface ( cameraInfo->usbHandle, 0 );
     libusb_close ( cameraInfo->usbHandle );
     libusb_exit ( cameraInfo->usbContext );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
     free (( void* ) cameraInfo->frameSizes[1].sizes );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
     free (( void* ) camera );
@@ -63,6 +63,4 @@
 #define CAM_QHY5RIIC    34
 #define CAM_QHY5HII     35
 
-#define QHY_NUM_TRANSFER_BUFS	16
-
 #endif	/* OA_QHY_H */
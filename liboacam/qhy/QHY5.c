@@ -52,7 +52,6 @@ static int      		oaQHY5CloseCamera ( oaCamera* );
 int
 _QHY5InitCamera ( oaCamera* camera )
 {
-  int		i, j;
   QHY_STATE*	cameraInfo = camera->_private;
   COMMON_INFO*	commonInfo = camera->_common;
 
@@ -119,73 +118,49 @@ _QHY5InitCamera ( oaCamera* camera )
 
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY;
-  if (!( cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof (
-      frameBuffer )))) {
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
     oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffers failed", __func__ );
     free (( void* ) cameraInfo->xferBuffer );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     return -OA_ERR_MEM_ALLOC;
   }
 
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc for buffer failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-      free ( cameraInfo->xferBuffer );
-      free (( void* ) cameraInfo->buffers );
-      free (( void* ) cameraInfo->frameSizes[1].sizes );
-      return -OA_ERR_MEM_ALLOC;
-    }
-  }
-
-  cameraInfo->buffersFree = cameraInfo->configuredBuffers;
   cameraInfo->nextBuffer = 0;
   cameraInfo->firstTimeSetup = 1;
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamQHY5controller, ( void* ) camera )) {
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
-    free (( void* ) cameraInfo->buffers );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     free ( cameraInfo->xferBuffer );
     free (( void* ) camera->_common );
     free (( void* ) camera->_private );
     free (( void* ) camera );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return -OA_ERR_SYSTEM_ERROR;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamQHYcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
     cameraInfo->stopControllerThread = 1;
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
-    free (( void* ) cameraInfo->buffers );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     free ( cameraInfo->xferBuffer );
     free (( void* ) camera->_common );
     free (( void* ) camera->_private );
     free (( void* ) camera );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return -OA_ERR_SYSTEM_ERROR;
   }
 
@@ -255,7 +230,6 @@ oaQHY5CameraGetFrameSizes ( oaCamera* camera )
 static int
 oaQHY5CloseCamera ( oaCamera* camera )
 {
-  int		j;
   void*		dummy;
   QHY_STATE*	cameraInfo;
 
@@ -268,28 +242,21 @@ oaQHY5CloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     libusb_release_interface ( cameraInfo->usbHandle, 0 );
     libusb_close ( cameraInfo->usbHandle );
     libusb_exit ( cameraInfo->usbContext );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
     free (( void* ) cameraInfo->frameSizes[1].sizes );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
     free (( void* ) cameraInfo->xferBuffer );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
     free (( void* ) camera );
@@ -55,7 +55,6 @@ static int		oaQHY5IICloseCamera ( oaCamera* );
 int
 _QHY5IIInitCamera ( oaCamera* camera )
 {
-  int		i, j;
   QHY_STATE*	cameraInfo = camera->_private;
   COMMON_INFO*	commonInfo = camera->_common;
   void		*dummy;
@@ -152,8 +151,8 @@ _QHY5IIInitCamera ( oaCamera* camera )
   camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_DROPPED ) = OA_CTRL_TYPE_READONLY;
   camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_DROPPED_RESET ) = OA_CTRL_TYPE_BUTTON;
 
-  pthread_create ( &cameraInfo->eventHandler, 0, _qhy5iiEventHandler,
-      ( void* ) cameraInfo );
+  oacamCreateThread ( &cameraInfo->eventHandler, OA_CAM_THREAD_EVENTS,
+      _qhy5iiEventHandler, ( void* ) cameraInfo );
 
   cameraInfo->buffers = 0;
   cameraInfo->configuredBuffers = 0;
@@ -164,75 +163,50 @@ _QHY5IIInitCamera ( oaCamera* camera )
   cameraInfo->imageBufferLength = 2 * ( cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY ) + QHY5II_EOF_LEN;
 
-  if (!( cameraInfo->buffers = calloc ( OA_CAM_BUFFERS,
-      sizeof ( frameBuffer )))) {
-    oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffer array failed", __func__ );
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: buffer allocation failed", __func__ );
     cameraInfo->stopCallbackThread = 1;
     pthread_join ( cameraInfo->eventHandler, &dummy );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     return -OA_ERR_MEM_ALLOC;
   }
 
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffer failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-      cameraInfo->stopCallbackThread = 1;
-      pthread_join ( cameraInfo->eventHandler, &dummy );
-      free (( void* ) cameraInfo->buffers );
-      free (( void* ) cameraInfo->frameSizes[1].sizes );
-      return -OA_ERR_MEM_ALLOC;
-    }
-  }
-
-  cameraInfo->buffersFree = cameraInfo->configuredBuffers;
   cameraInfo->nextBuffer = 0;
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamQHY5IIcontroller, ( void* ) camera )) {
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     cameraInfo->stopCallbackThread = 1;
     pthread_join ( cameraInfo->eventHandler, &dummy );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     free (( void* ) camera->_common );
     free (( void* ) camera->_private );
     free (( void* ) camera );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return -OA_ERR_SYSTEM_ERROR;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamQHYcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
     cameraInfo->stopControllerThread = 1;
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     cameraInfo->stopCallbackThread = 1;
     pthread_join ( cameraInfo->eventHandler, &dummy );
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     free (( void* ) camera->_common );
     free (( void* ) camera->_private );
     free (( void* ) camera );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     return -OA_ERR_SYSTEM_ERROR;
   }
 
@@ -261,7 +235,7 @@ oaQHY5IICameraGetFrameSizes ( oaCamera* camera )
 static int
 oaQHY5IICloseCamera ( oaCamera* camera )
 {
-  int		j, res;
+  int		res;
   QHY_STATE*	cameraInfo;
   void*		dummy;
 
@@ -287,29 +261,23 @@ oaQHY5IICloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     pthread_join ( cameraInfo->eventHandler, &dummy );
 
+    oacamUsbStreamFree ( &cameraInfo->usbStream );
     libusb_release_interface ( cameraInfo->usbHandle, 0 );
     libusb_close ( cameraInfo->usbHandle );
     libusb_exit ( cameraInfo->usbContext );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
     free (( void* ) cameraInfo->frameSizes[1].sizes );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
     free (( void* ) camera );
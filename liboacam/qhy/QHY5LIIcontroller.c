@@ -101,7 +101,7 @@ static void	_initialiseRegisters ( QHY_STATE* );
 static void	_setPLLRegister ( QHY_STATE*, unsigned int );
 static int	_abortFrame ( QHY_STATE* );
 static int	_doReadTemperature ( QHY_STATE* );
-static void     _processPayload ( oaCamera*, unsigned char*, unsigned int );
+static void     _processPayload ( void*, unsigned char*, unsigned int );
 static void     _releaseFrame ( QHY_STATE* );
 
 
@@ -818,100 +818,12 @@ _processGetControl ( QHY_STATE* cameraInfo, OA_COMMAND* command )
 }
 
 
-libusb_transfer_cb_fn
-_qhy5liiVideoStreamCallback ( struct libusb_transfer* transfer )
-{ 
-  oaCamera*     camera = transfer->user_data;
-  QHY_STATE*    cameraInfo = camera->_private;
-  int           resubmit = 1, streaming;
-
-  switch ( transfer->status ) {
-  
-    case LIBUSB_TRANSFER_COMPLETED:
-      if ( transfer->num_iso_packets == 0 ) { // bulk mode transfer
-        _processPayload ( camera, transfer->buffer, transfer->actual_length );
-      } else {
-        oaLogError ( OA_LOG_CAMERA, "%s: Unexpected isochronous transfer",
-						__func__ );
-      } 
-      break;
-    
-    case LIBUSB_TRANSFER_CANCELLED:
-    case LIBUSB_TRANSFER_ERROR:
-    case LIBUSB_TRANSFER_NO_DEVICE:
-    {
-      int i;
-
-      pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-
-      for ( i = 0; i < QHY_NUM_TRANSFER_BUFS; i++ ) {
-        if ( cameraInfo->transfers[i] == transfer ) {
-          free ( transfer->buffer );
-          libusb_free_transfer ( transfer );
-          cameraInfo->transfers[i] = 0;
-          break;
-        }
-      }
-
-      if ( QHY_NUM_TRANSFER_BUFS == i ) {
-        oaLogError ( OA_LOG_CAMERA, "%s: transfer %p not found; not freeing!",
-						__func__, transfer );
-      }
-
-      resubmit = 0;
-
-      pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-      break;
-    }
-    case LIBUSB_TRANSFER_TIMED_OUT:
-      break;
-
-    case LIBUSB_TRANSFER_STALL:
-    case LIBUSB_TRANSFER_OVERFLOW:
-      oaLogError ( OA_LOG_CAMERA, "%s: retrying transfer, status = %d (%s)",
-					__func__, transfer->status, libusb_error_name ( transfer->status ));
-      break;
-  }
-
-  if ( resubmit ) {
-    pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-    streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
-    if ( streaming ) {
-      libusb_submit_transfer ( transfer );
-    } else {
-      int i;
-      pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-      // Mark transfer deleted
-      for ( i = 0; i < QHY_NUM_TRANSFER_BUFS; i++ ) {
-        if ( cameraInfo->transfers[i] == transfer ) {
-          oaLogError ( OA_LOG_CAMERA, "%s: Freeing orphan transfer %d (%p)",
-							__func__, i, transfer );
-          free ( transfer->buffer );
-          libusb_free_transfer ( transfer );
-          cameraInfo->transfers[i] = 0;
-        }
-      }
-      if ( QHY_NUM_TRANSFER_BUFS == i ) {
-        oaLogError ( OA_LOG_CAMERA,
-						"%s: orphan transfer %p not found; not freeing!", __func__,
-            transfer );
-      }
-      pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-    }
-  }
-
-  return 0;
-}
-
-
 static int
 _processStreamingStart ( oaCamera* camera, OA_COMMAND* command )
 {
   QHY_STATE*			cameraInfo = camera->_private;
   CALLBACK*			cb;
-  int				txId, ret, txBufferSize, numTxBuffers;
-  struct libusb_transfer*	transfer;
+  int				ret;
   unsigned char	buf[1] = { 100 };
 
   if ( cameraInfo->runMode != CAM_RUN_MODE_STOPPED ) {
@@ -924,51 +836,15 @@ _processStreamingStart ( oaCamera* camera, OA_COMMAND* command )
     cameraInfo->streamingCallback.callbackArg = cb->callbackArg;
   }
 
-  txBufferSize = cameraInfo->captureLength;
-  // This is a guess
-  numTxBuffers = 8;
-  if ( numTxBuffers < 8 ) {
-    numTxBuffers = 8;
-  }
-  if ( numTxBuffers > 100 ) {
-    numTxBuffers = 100;
-  }
-  for ( txId = 0; txId < QHY_NUM_TRANSFER_BUFS; txId++ ) {
-    if ( txId < numTxBuffers ) {
-      transfer = libusb_alloc_transfer(0);
-      cameraInfo->transfers[ txId ] = transfer;
-      if (!( cameraInfo->transferBuffers [ txId ] =
-          malloc ( txBufferSize ))) {
-        oaLogError ( OA_LOG_CAMERA, "%s: malloc failed.  Need to free buffer",
-						__func__ );
-        return -OA_ERR_SYSTEM_ERROR;
-      }
-      libusb_fill_bulk_transfer ( transfer, cameraInfo->usbHandle,
-          QHY_BULK_ENDP_IN, cameraInfo->transferBuffers [ txId ],
-          txBufferSize, ( libusb_transfer_cb_fn ) _qhy5liiVideoStreamCallback,
-          camera, USB2_TIMEOUT );
-    } else {
-      cameraInfo->transfers[ txId ] = 0;
-    }
-  }
-
-  for ( txId = 0; txId < numTxBuffers; txId++ ) {
-    if (( ret = libusb_submit_transfer ( cameraInfo->transfers [ txId ]))) {
-      break;
-    }
-  }
-
-  // free up any transfer buffers that we're not using
-  if ( ret && txId > 0 ) {
-    for ( ; txId < QHY_NUM_TRANSFER_BUFS; txId++) {
-      if ( cameraInfo->transfers[ txId ] ) {
-        if ( cameraInfo->transfers[ txId ]->buffer ) {
-          free ( cameraInfo->transfers[ txId ]->buffer );
-        }
-        libusb_free_transfer ( cameraInfo->transfers[ txId ]);
-        cameraInfo->transfers[ txId ] = 0;
-      }
-    }
+  // Half the frame buffers are kept for transfers to land in and the
+  // rest for frames waiting on the application
+  cameraInfo->receivedBytes = 0;
+  if (( ret = oacamUsbStreamStart ( &cameraInfo->usbStream,
+      ( SHARED_STATE* ) cameraInfo, cameraInfo->usbHandle, QHY_BULK_ENDP_IN,
+      USB2_TIMEOUT, cameraInfo->captureLength,
+      cameraInfo->configuredBuffers / 2, cameraInfo->captureLength, 0,
+      &cameraInfo->receivedBytes, _processPayload, camera )) != OA_ERR_NONE ) {
+    return ret;
   }
 
   _usbControlMsg ( cameraInfo, QHY_CMD_DEFAULT_OUT, QHY_REQ_BEGIN_VIDEO,
@@ -985,7 +861,7 @@ _processStreamingStart ( oaCamera* camera, OA_COMMAND* command )
 static int
 _processStreamingStop ( QHY_STATE* cameraInfo, OA_COMMAND* command )
 {
-  int		queueEmpty, i, res, allReleased;
+  int		queueEmpty;
   unsigned char	buf[4] = { 0, 0, 0, 0 };
 
   if ( cameraInfo->runMode != CAM_RUN_MODE_STREAMING ) {
@@ -998,32 +874,7 @@ _processStreamingStop ( QHY_STATE* cameraInfo, OA_COMMAND* command )
   cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
   pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
 
-  pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-  for ( i = 0; i < QHY_NUM_TRANSFER_BUFS; i++ ) {
-    if ( cameraInfo->transfers[i] ) {
-      res = libusb_cancel_transfer ( cameraInfo->transfers[i] );
-      if ( res < 0 && res != LIBUSB_ERROR_NOT_FOUND ) {
-        free ( cameraInfo->transfers[i]->buffer );
-        libusb_free_transfer ( cameraInfo->transfers[i] );
-        cameraInfo->transfers[i] = 0;
-      }
-    }
-  }
-  pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-
-  do {
-    allReleased = 1;
-    for ( i = 0; i < QHY_NUM_TRANSFER_BUFS && allReleased; i++ ) {
-      pthread_mutex_lock ( &cameraInfo->videoCallbackMutex );
-      if ( cameraInfo->transfers[i] ) {
-        allReleased = 0;
-      }
-      pthread_mutex_unlock ( &cameraInfo->videoCallbackMutex );
-    }
-    if ( !allReleased ) {
-      usleep ( 100 ); // FIX ME -- lazy.  should use a pthread condition?
-    }
-  } while ( !allReleased );
+  oacamUsbStreamStop ( &cameraInfo->usbStream );
 
   // We wait here until the callback queue has drained otherwise a future
   // close of the camera could rip the image frame out from underneath the
@@ -1031,9 +882,7 @@ _processStreamingStop ( QHY_STATE* cameraInfo, OA_COMMAND* command )
 
   queueEmpty = 0;
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( OA_CAM_BUFFERS == cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    queueEmpty = ( cameraInfo->configuredBuffers == OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
     if ( !queueEmpty ) {
       usleep ( 10000 );
     }
@@ -1044,10 +893,12 @@ _processStreamingStop ( QHY_STATE* cameraInfo, OA_COMMAND* command )
 
 
 static void
-_processPayload ( oaCamera* camera, unsigned char* buffer, unsigned int len )
+_processPayload ( void* arg, unsigned char* buffer, unsigned int len )
 {
+  oaCamera*             camera = arg;
   QHY_STATE*            cameraInfo = camera->_private;
   unsigned int          buffersFree, dropFrame;
+  unsigned char*        dest;
   unsigned char*	p;
 
   if ( 0 == len ) {
@@ -1056,14 +907,18 @@ _processPayload ( oaCamera* camera, unsigned char* buffer, unsigned int len )
  
   dropFrame = 0;
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
+  dest = ( unsigned char* ) cameraInfo->buffers[
+      cameraInfo->nextBuffer ].start + cameraInfo->receivedBytes;
+  // The data normally arrives where it belongs.  If it hasn't, it can't
+  // be moved into a buffer that another transfer is yet to land in
   if ( buffersFree && ( cameraInfo->receivedBytes + len ) <=
-      cameraInfo->captureLength ) {
-    memcpy (( unsigned char* ) cameraInfo->buffers[
-        cameraInfo->nextBuffer ].start + cameraInfo->receivedBytes,
-        buffer, len );
+      cameraInfo->captureLength && ( buffer == dest ||
+      !oacamUsbStreamBufferBusy ( &cameraInfo->usbStream,
+      cameraInfo->nextBuffer ))) {
+    if ( buffer != dest ) {
+      memmove ( dest, buffer, len );
+    }
     cameraInfo->receivedBytes += len;
     // It seems that the last five bytes of the frame should be
     // 0xaa, 0x11, 0xcc, 0xee, 0xXX
@@ -1088,6 +943,11 @@ _processPayload ( oaCamera* camera, unsigned char* buffer, unsigned int len )
   if ( dropFrame ) {
     pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
     cameraInfo->droppedFrames++;
+    if ( buffersFree ) {
+      OA_DROP_FRAME ( cameraInfo );
+    } else {
+      OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
+    }
     cameraInfo->receivedBytes = 0;
     pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
   }
@@ -1098,7 +958,14 @@ static void
 _releaseFrame ( QHY_STATE* cameraInfo )
 {
   int           nextBuffer = cameraInfo->nextBuffer;
-
+  FRAME_METADATA*	metadata;
+
+  metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
+  metadata->exposure = cameraInfo->currentExposure;
+  metadata->exposureValid = 1;
+  metadata->gain = cameraInfo->currentGain;
+  metadata->gainValid = 1;
+  cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
   cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
       OA_CALLBACK_NEW_FRAME;
   cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -1109,14 +976,11 @@ _releaseFrame ( QHY_STATE* cameraInfo )
       cameraInfo->buffers[ nextBuffer ].start;
   cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
       cameraInfo->frameSize;
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  oaDLListAddToTail ( cameraInfo->callbackQueue,
+  oacamCallbackRingPush ( &cameraInfo->callbackRing,
       &cameraInfo->frameCallbacks[ nextBuffer ]);
-  cameraInfo->buffersFree--;
+  OA_CLAIM_BUFFER ( cameraInfo );
   cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;
   cameraInfo->receivedBytes = 0;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-  pthread_cond_broadcast ( &cameraInfo->callbackQueued );
 }
 
 
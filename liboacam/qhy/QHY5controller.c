@@ -63,6 +63,7 @@ oacamQHY5controller ( void* param )
   int			resultCode, streaming = 0;
   int			maxWaitTime, frameWait;
   int			nextBuffer, buffersFree;
+  FRAME_METADATA*	metadata;
   unsigned int		x, y;
   uint8_t*		s;
   uint8_t*		t;
@@ -137,9 +138,7 @@ oacamQHY5controller ( void* param )
       }
       if ( !exitThread ) {
         if ( !_doReadExposure ( cameraInfo )) {
-          pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-          buffersFree = cameraInfo->buffersFree;
-          pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+          buffersFree = OA_BUFFERS_FREE ( cameraInfo );
           pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
 					streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
           pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
@@ -155,6 +154,13 @@ oacamQHY5controller ( void* param )
               }
               startOfLine += QHY5_SENSOR_WIDTH;
             }
+            metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+                nextBuffer );
+            metadata->exposure = cameraInfo->currentExposure;
+            metadata->exposureValid = 1;
+            metadata->gain = cameraInfo->currentGain;
+            metadata->gainValid = 1;
+            cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
             cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
                 OA_CALLBACK_NEW_FRAME;
             cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -165,14 +171,13 @@ oacamQHY5controller ( void* param )
                 cameraInfo->buffers[ nextBuffer ].start;
             cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
                 cameraInfo->imageBufferLength;
-            pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-            oaDLListAddToTail ( cameraInfo->callbackQueue,
+            oacamCallbackRingPush ( &cameraInfo->callbackRing,
                 &cameraInfo->frameCallbacks[ nextBuffer ]);
-            cameraInfo->buffersFree--;
+            OA_CLAIM_BUFFER ( cameraInfo );
             cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
                 cameraInfo->configuredBuffers;
-            pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-            pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+          } else if ( streaming ) {
+            OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
           }
         }
       }
@@ -449,9 +454,7 @@ _processStreamingStop ( QHY_STATE* cameraInfo, OA_COMMAND* command )
 
   queueEmpty = 0;
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( OA_CAM_BUFFERS == cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    queueEmpty = ( cameraInfo->configuredBuffers == OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
     if ( !queueEmpty ) {
       usleep ( 10000 );
     }
@@ -499,6 +502,7 @@ _doReadExposure ( QHY_STATE* cameraInfo )
       USB2_TIMEOUT );
   if ( ret ) {
     cameraInfo->droppedFrames++;
+    OA_DROP_FRAME ( cameraInfo );
     return ret;
   }
   if ( readSize != cameraInfo->captureLength ) {
@@ -506,6 +510,7 @@ _doReadExposure ( QHY_STATE* cameraInfo )
 				"%s: readExposure: USB bulk transfer was short. %d != %d", __func__,
         readSize, cameraInfo->captureLength );
     cameraInfo->droppedFrames++;
+    OA_DROP_FRAME ( cameraInfo );
     return -OA_ERR_CAMERA_IO;
   }
   return OA_ERR_NONE;
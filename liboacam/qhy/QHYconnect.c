@@ -193,6 +193,8 @@ oaQHYInitCamera ( oaCameraDevice* device )
   // This probably isn't required any more
   pthread_mutex_init ( &cameraInfo->usbMutex, 0 );
 
+  oacamUsbStreamInit ( &cameraInfo->usbStream );
+
   cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
 
   switch ( cameraInfo->cameraType ) {
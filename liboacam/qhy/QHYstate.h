@@ -33,6 +33,7 @@
 #include <pthread.h>
 
 #include "sharedState.h"
+#include "usbStream.h"
 
 
 typedef struct QHY_STATE {
@@ -46,10 +47,8 @@ typedef struct QHY_STATE {
   // video mode settings
   unsigned int          currentFrameFormat;
   // buffering for image transfers
-  frameBuffer*     buffers;
   unsigned int          captureLength;
-  struct libusb_transfer* transfers [ QHY_NUM_TRANSFER_BUFS ];
-  uint8_t*		transferBuffers [ QHY_NUM_TRANSFER_BUFS ];
+  OA_USB_STREAM		usbStream;
   // camera status
   uint64_t		droppedFrames;
   unsigned int          isColour;
@@ -89,7 +88,6 @@ typedef struct QHY_STATE {
   // thread management
   pthread_mutex_t       usbMutex;
   pthread_t		eventHandler;
-  pthread_mutex_t	videoCallbackMutex;
 } QHY_STATE;
 
 #endif	/* OA_QHY_STATE_H */
@@ -40,6 +40,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "qhyccdprivate.h"
 
 // Pointers to libqhyccd functions so we can use them via libdl.
@@ -108,441 +109,81 @@ uint32_t				( *p_GetQHYCCDReadMode )( qhyccd_handle*, int32_t* );
 */
 uint32_t				( *p_SetQHYCCDDebayerOnOff )( qhyccd_handle*, bool );
 
-
-static void*		_getDLSym ( void*, const char* );
-
-/**
- * Cycle through the list of cameras returned by libqhyccd
- */
-
-int
-_qhyccdInitLibraryFunctionPointers ( void )
-{
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
-
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( InitQHYCCDResource ),
+	OA_DL_SYM( ReleaseQHYCCDResource ),
+	OA_DL_SYM( ScanQHYCCD ),
+	OA_DL_SYM( GetQHYCCDId ),
+	OA_DL_SYM( GetQHYCCDModel ),
+	OA_DL_SYM( EnableQHYCCDMessage ),
+	OA_DL_SYM( EnableQHYCCDLogFile ),
+	OA_DL_SYM( SetQHYCCDLogLevel ),
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-	char					firmwarePath[ PATH_MAX+1 ];
-  const char*		libName = "libqhyccd.dylib";
-#else
-  const char*		libName = "libqhyccd.so.21";
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
+	OA_DL_SYM( OSXInitQHYCCDFirmware ),
 #endif
-
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
-#endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
-#endif
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libPath, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-	  if (!( *( void** )( &p_SetQHYCCDLogLevel ) = _getDLSym ( libHandle,
-	      "SetQHYCCDLogLevel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_EnableQHYCCDMessage ) = _getDLSym ( libHandle,
-	      "EnableQHYCCDMessage" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_EnableQHYCCDLogFile ) = _getDLSym ( libHandle,
-	      "EnableQHYCCDLogFile" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetTimeStamp ) = _getDLSym ( libHandle,
-	      "GetTimeStamp" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_InitQHYCCDResource ) = _getDLSym ( libHandle,
-	      "InitQHYCCDResource" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_ReleaseQHYCCDResource ) = _getDLSym ( libHandle,
-	      "ReleaseQHYCCDResource" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_ScanQHYCCD ) = _getDLSym ( libHandle,
-	      "ScanQHYCCD" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDId ) = _getDLSym ( libHandle,
-	      "GetQHYCCDId" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDModel ) = _getDLSym ( libHandle,
-	      "GetQHYCCDModel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_OpenQHYCCD ) = _getDLSym ( libHandle,
-	      "OpenQHYCCD" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_CloseQHYCCD ) = _getDLSym ( libHandle,
-	      "CloseQHYCCD" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_SetQHYCCDStreamMode ) = _getDLSym ( libHandle,
-	      "SetQHYCCDStreamMode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_InitQHYCCD ) = _getDLSym ( libHandle,
-	      "InitQHYCCD" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_IsQHYCCDControlAvailable ) = _getDLSym ( libHandle,
-	      "IsQHYCCDControlAvailable" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_SetQHYCCDParam ) = _getDLSym ( libHandle,
-	      "SetQHYCCDParam" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDParam ) = _getDLSym ( libHandle,
-	      "GetQHYCCDParam" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDParamMinMaxStep ) = _getDLSym ( libHandle,
-	      "GetQHYCCDParamMinMaxStep" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_SetQHYCCDResolution ) = _getDLSym ( libHandle,
-	      "SetQHYCCDResolution" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDMemLength ) = _getDLSym ( libHandle,
-	      "GetQHYCCDMemLength" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_ExpQHYCCDSingleFrame ) = _getDLSym ( libHandle,
-	      "ExpQHYCCDSingleFrame" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDSingleFrame ) = _getDLSym ( libHandle,
-	      "GetQHYCCDSingleFrame" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_CancelQHYCCDExposing ) = _getDLSym ( libHandle,
-	      "CancelQHYCCDExposing" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_CancelQHYCCDExposingAndReadout ) = _getDLSym (
-				libHandle, "CancelQHYCCDExposingAndReadout" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_BeginQHYCCDLive ) = _getDLSym ( libHandle,
-	      "BeginQHYCCDLive" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDLiveFrame ) = _getDLSym ( libHandle,
-	      "GetQHYCCDLiveFrame" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_StopQHYCCDLive ) = _getDLSym ( libHandle,
-	      "StopQHYCCDLive" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_SetQHYCCDBinMode ) = _getDLSym ( libHandle,
-	      "SetQHYCCDBinMode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_SetQHYCCDBitsMode ) = _getDLSym ( libHandle,
-	      "SetQHYCCDBitsMode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_ControlQHYCCDTemp ) = _getDLSym ( libHandle,
-	      "ControlQHYCCDTemp" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_ControlQHYCCDGuide ) = _getDLSym ( libHandle,
-	      "ControlQHYCCDGuide" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_SetQHYCCDTrigerMode ) = _getDLSym ( libHandle,
-	      "SetQHYCCDTrigerMode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( GetTimeStamp ),
+	OA_DL_SYM( OpenQHYCCD ),
+	OA_DL_SYM( CloseQHYCCD ),
+	OA_DL_SYM( SetQHYCCDStreamMode ),
+	OA_DL_SYM( InitQHYCCD ),
+	OA_DL_SYM( IsQHYCCDControlAvailable ),
+	OA_DL_SYM( SetQHYCCDParam ),
+	OA_DL_SYM( GetQHYCCDParam ),
+	OA_DL_SYM( GetQHYCCDParamMinMaxStep ),
+	OA_DL_SYM( SetQHYCCDResolution ),
+	OA_DL_SYM( GetQHYCCDMemLength ),
+	OA_DL_SYM( ExpQHYCCDSingleFrame ),
+	OA_DL_SYM( GetQHYCCDSingleFrame ),
+	OA_DL_SYM( CancelQHYCCDExposing ),
+	OA_DL_SYM( CancelQHYCCDExposingAndReadout ),
+	OA_DL_SYM( BeginQHYCCDLive ),
+	OA_DL_SYM( GetQHYCCDLiveFrame ),
+	OA_DL_SYM( StopQHYCCDLive ),
+	OA_DL_SYM( SetQHYCCDBinMode ),
+	OA_DL_SYM( SetQHYCCDBitsMode ),
+	OA_DL_SYM( ControlQHYCCDTemp ),
+	OA_DL_SYM( ControlQHYCCDGuide ),
+	OA_DL_SYM( SetQHYCCDTrigerMode ),
+	OA_DL_SYM( GetQHYCCDChipInfo ),
+	OA_DL_SYM( GetQHYCCDEffectiveArea ),
+	OA_DL_SYM( GetQHYCCDOverScanArea ),
+	OA_DL_SYM( GetQHYCCDExposureRemaining ),
+	OA_DL_SYM( GetQHYCCDFWVersion ),
+	OA_DL_SYM( GetQHYCCDCameraStatus ),
+	OA_DL_SYM( GetQHYCCDShutterStatus ),
+	OA_DL_SYM( ControlQHYCCDShutter ),
+	OA_DL_SYM( GetQHYCCDHumidity ),
+	OA_DL_SYM( QHYCCDI2CTwoWrite ),
+	OA_DL_SYM( QHYCCDI2CTwoRead ),
+	OA_DL_SYM( GetQHYCCDReadingProgress ),
+	OA_DL_SYM( SetQHYCCDDebayerOnOff ),
+	OA_DL_END
+};
 
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-	  if (!( *( void** )( &p_OSXInitQHYCCDFirmware ) = _getDLSym ( libHandle,
-	      "OSXInitQHYCCDFirmware" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libqhyccd.dylib",
+		enumSymbols, otherSymbols );
+#else
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libqhyccd.so.21",
+		enumSymbols, otherSymbols );
 #endif
 
-	  if (!( *( void** )( &p_GetQHYCCDChipInfo ) = _getDLSym ( libHandle,
-	      "GetQHYCCDChipInfo" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDEffectiveArea ) = _getDLSym ( libHandle,
-	      "GetQHYCCDEffectiveArea" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDOverScanArea ) = _getDLSym ( libHandle,
-	      "GetQHYCCDOverScanArea" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDExposureRemaining ) = _getDLSym ( libHandle,
-	      "GetQHYCCDExposureRemaining" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDFWVersion ) = _getDLSym ( libHandle,
-	      "GetQHYCCDFWVersion" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDCameraStatus ) = _getDLSym ( libHandle,
-	      "GetQHYCCDCameraStatus" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
 
-	  if (!( *( void** )( &p_GetQHYCCDShutterStatus ) = _getDLSym ( libHandle,
-	      "GetQHYCCDShutterStatus" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
+// Only the calls needed to enumerate cameras are resolved here
 
-	  if (!( *( void** )( &p_ControlQHYCCDShutter ) = _getDLSym ( libHandle,
-	      "ControlQHYCCDShutter" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDHumidity ) = _getDLSym ( libHandle,
-	      "GetQHYCCDHumidity" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_QHYCCDI2CTwoWrite ) = _getDLSym ( libHandle,
-	      "QHYCCDI2CTwoWrite" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_QHYCCDI2CTwoRead ) = _getDLSym ( libHandle,
-	      "QHYCCDI2CTwoRead" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDReadingProgress ) = _getDLSym ( libHandle,
-	      "GetQHYCCDReadingProgress" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-		/*
-		 * This function isn't used and isn't present in some releases (4.0.1?) of
-		 * libqhyccd, so skip it for now
-		 *
-	  if (!( *( void** )( &p_GetQHYCCDNumberOfReadModes ) = _getDLSym ( libHandle,
-	      "GetQHYCCDNumberOfReadModes" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-		 */
-
-		/*
-		 * Ditto this one
-		 *
-	  if (!( *( void** )( &p_GetQHYCCDReadModeResolution ) =
-				_getDLSym ( libHandle, "GetQHYCCDReadModeResolution" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-		 */
-
-		/*
-		 * And this
-		 *
-	  if (!( *( void** )( &p_GetQHYCCDReadModeName ) = _getDLSym ( libHandle,
-	      "GetQHYCCDReadModeName" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-		 */
-
-		/*
-		 * And these two...
-		 *
-	  if (!( *( void** )( &p_SetQHYCCDReadMode ) = _getDLSym ( libHandle,
-	      "SetQHYCCDReadMode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &p_GetQHYCCDReadMode ) = _getDLSym ( libHandle,
-	      "GetQHYCCDReadMode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-		 */
-
-	  if (!( *( void** )( &p_SetQHYCCDDebayerOnOff ) = _getDLSym ( libHandle,
-	      "SetQHYCCDDebayerOnOff" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	}
-	
-  return OA_ERR_NONE;
+int
+_qhyccdInitLibraryFunctionPointers ( void )
+{
+	return oacamDLLoad ( &lib, OA_DL_ENUMERATE );
 }
 
 
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+int
+_qhyccdInitAllLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
-
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libqhyccd DL error: %s", __func__, error );
-    addr = 0;
-  }
-
-  return addr;
+	return oacamDLLoad ( &lib, OA_DL_ALL );
 }
@@ -116,6 +116,11 @@ oaQHYCCDInitCamera ( oaCameraDevice* device )
 	uint32_t					dummy, x, y;
 	CONTROL_ID				binning;
 
+	if ( _qhyccdInitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve SDK functions", __func__ );
+		return 0;
+	}
+
 	devInfo = device->_private;
 
   logenv = getenv("QHY_LOG_LEVEL");
@@ -425,30 +430,18 @@ oaQHYCCDInitCamera ( oaCameraDevice* device )
   cameraInfo->buffers = 0;
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY * maxBytesPerPixel;
-  cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffers failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-          cameraInfo->buffers[j].start = 0;
-        }
-      }
-			p_CloseQHYCCD ( handle );
-			p_ReleaseQHYCCDResource();
-			for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
-				if ( cameraInfo->frameSizes[ j ].numSizes ) {
-					free (( void* ) cameraInfo->frameSizes[ j ].sizes );
-				}
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: malloc of buffers failed", __func__ );
+		p_CloseQHYCCD ( handle );
+		p_ReleaseQHYCCDResource();
+		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
+			if ( cameraInfo->frameSizes[ j ].numSizes ) {
+				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
-			FREE_DATA_STRUCTS;
-      return 0;
-    }
+		}
+		FREE_DATA_STRUCTS;
+    return 0;
   }
 
 	if ( p_IsQHYCCDControlAvailable ( handle, CAM_GPS ) == QHYCCD_SUCCESS ) {
@@ -457,45 +450,39 @@ oaQHYCCDInitCamera ( oaCameraDevice* device )
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
   cameraInfo->nextBuffer = 0;
-  cameraInfo->configuredBuffers = OA_CAM_BUFFERS;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamQHYCCDcontroller, ( void* ) camera )) {
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-      cameraInfo->buffers[j].start = 0;
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
 		}
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamQHYCCDcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
     cameraInfo->stopControllerThread = 1;
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-      cameraInfo->buffers[j].start = 0;
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
 		}
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -541,20 +528,17 @@ oaQHYCCDCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
   
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     ( p_CloseQHYCCD ) ( cameraInfo->handle );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
     p_ReleaseQHYCCDResource();
 
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-      cameraInfo->buffers[j].start = 0;
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
@@ -143,9 +143,7 @@ oacamQHYCCDcontroller ( void* param )
         frameWait = 100;
       }
 
-      pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-      buffersFree = cameraInfo->buffersFree;
-      pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+      buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
       if ( buffersFree ) {
 				uint32_t	w, h, bpp, channels;
@@ -164,6 +162,8 @@ oacamQHYCCDcontroller ( void* param )
 
         if ( !exitThread ) {
 					if ( haveFrame ) {
+						cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+								oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
 						cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
 								OA_CALLBACK_NEW_FRAME;
 						cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -174,14 +174,11 @@ oacamQHYCCDcontroller ( void* param )
 								cameraInfo->buffers[ nextBuffer ].start;
 						cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
 								imageBufferLength;
-						oaDLListAddToTail ( cameraInfo->callbackQueue,
+						oacamCallbackRingPush ( &cameraInfo->callbackRing,
 								&cameraInfo->frameCallbacks[ nextBuffer ]);
-						pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-						cameraInfo->buffersFree--;
+						OA_CLAIM_BUFFER ( cameraInfo );
 						cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
 								cameraInfo->configuredBuffers;
-						pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-						pthread_cond_broadcast ( &cameraInfo->callbackQueued );
 					} else {
 						usleep ( frameWait );
 					}
@@ -637,9 +634,7 @@ _timerCallback ( void* param )
 	int									ret, buffersFree, nextBuffer;
 	unsigned int				xsize, ysize, bpp, channels;
 
-	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-	buffersFree = cameraInfo->buffersFree;
-	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+	buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
   if ( buffersFree ) {
     nextBuffer = cameraInfo->nextBuffer;
@@ -667,6 +662,8 @@ _timerCallback ( void* param )
 					ret );
 		}
 		cameraInfo->exposureInProgress = 0;
+    cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+        oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
     cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
         OA_CALLBACK_NEW_FRAME;
     cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -677,14 +674,11 @@ _timerCallback ( void* param )
         cameraInfo->buffers[ nextBuffer ].start;
     cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
         cameraInfo->imageBufferLength;
-    oaDLListAddToTail ( cameraInfo->callbackQueue,
+    oacamCallbackRingPush ( &cameraInfo->callbackRing,
         &cameraInfo->frameCallbacks[ nextBuffer ]);
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    cameraInfo->buffersFree--;
+    OA_CLAIM_BUFFER ( cameraInfo );
     cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
         cameraInfo->configuredBuffers;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
   } else {
 		if (( ret = p_CancelQHYCCDExposingAndReadout ( cameraInfo->handle )) !=
 				QHYCCD_SUCCESS ) {
@@ -693,5 +687,6 @@ _timerCallback ( void* param )
 					ret );
 		}
 		cameraInfo->exposureInProgress = 0;
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
 	}
 }
@@ -46,9 +46,6 @@ typedef struct qhyccdcam_STATE {
   int							has8Bit;
   int							has16Bit;
 
-  // buffering for image transfers
-  frameBuffer*		buffers;
-
   // camera status
   int			currentBitsPerPixel; // this may be redundant
   int			currentBytesPerPixel;
@@ -0,0 +1,454 @@
+/*****************************************************************************
+ *
+ * reconnect.c -- reopening a camera with its previous settings
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "reconnect.h"
+
+#define	OA_RECONNECT_POLL_MS	100
+
+
+static OA_RECONNECT*
+_reconnect ( oaCamera* camera )
+{
+	return &(( SHARED_STATE* ) camera->_private )->reconnect;
+}
+
+
+static const oaCameraFuncs*
+_next ( oaCamera* camera )
+{
+	return oacamHookNext ( camera, OA_HOOK_RECONNECT );
+}
+
+
+void
+oacamReconnectInit ( SHARED_STATE* cameraInfo )
+{
+	pthread_mutex_init ( &cameraInfo->reconnect.mutex, 0 );
+	cameraInfo->reconnect.enabled = 0;
+}
+
+
+static int
+_setControl ( oaCamera* camera, int control, oaControlValue* val,
+		int dontWait )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+	unsigned int	i;
+	int						ret;
+
+	if (( ret = _next ( camera )->setControl ( camera, control, val,
+			dontWait )) != OA_ERR_NONE ) {
+		return ret;
+	}
+
+	// Buttons are actions rather than settings and strings can't be kept
+	// without knowing who owns them
+
+	if ( val->valueType == OA_CTRL_TYPE_BUTTON ||
+			val->valueType == OA_CTRL_TYPE_STRING ||
+			val->valueType == OA_CTRL_TYPE_READONLY ) {
+		return ret;
+	}
+
+	pthread_mutex_lock ( &rc->mutex );
+	if ( !rc->enabled ) {
+		pthread_mutex_unlock ( &rc->mutex );
+		return ret;
+	}
+	for ( i = 0; i < rc->numControls; i++ ) {
+		if ( rc->controls[i].control == control ) {
+			rc->numControls--;
+			memmove ( &rc->controls[i], &rc->controls[ i + 1 ],
+					( rc->numControls - i ) * sizeof ( OA_RECONNECT_CONTROL ));
+			break;
+		}
+	}
+	if ( rc->numControls < OA_RECONNECT_MAX_CONTROLS ) {
+		rc->controls[ rc->numControls ].control = control;
+		rc->controls[ rc->numControls ].value = *val;
+		rc->numControls++;
+	}
+	pthread_mutex_unlock ( &rc->mutex );
+	return ret;
+}
+
+
+static int
+_setResolution ( oaCamera* camera, int x, int y )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+	int						ret;
+
+	if (( ret = _next ( camera )->setResolution ( camera, x, y )) ==
+			OA_ERR_NONE ) {
+		pthread_mutex_lock ( &rc->mutex );
+		rc->haveResolution = rc->enabled;
+		rc->xSize = x;
+		rc->ySize = y;
+		rc->haveROI = 0;
+		pthread_mutex_unlock ( &rc->mutex );
+	}
+	return ret;
+}
+
+
+static int
+_setROI ( oaCamera* camera, int x, int y )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+	int						ret;
+
+	if (( ret = _next ( camera )->setROI ( camera, x, y )) == OA_ERR_NONE ) {
+		pthread_mutex_lock ( &rc->mutex );
+		rc->haveROI = rc->enabled;
+		rc->roiX = x;
+		rc->roiY = y;
+		pthread_mutex_unlock ( &rc->mutex );
+	}
+	return ret;
+}
+
+
+static int
+_setFrameInterval ( oaCamera* camera, int numerator, int denominator )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+	int						ret;
+
+	if (( ret = _next ( camera )->setFrameInterval ( camera, numerator,
+			denominator )) == OA_ERR_NONE ) {
+		pthread_mutex_lock ( &rc->mutex );
+		rc->haveInterval = rc->enabled;
+		rc->intervalNum = numerator;
+		rc->intervalDen = denominator;
+		pthread_mutex_unlock ( &rc->mutex );
+	}
+	return ret;
+}
+
+
+static int
+_startStreaming ( oaCamera* camera,
+		void* ( *callback )( void*, void*, int, void* ), void* callbackArg )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+	int						ret;
+
+	if (( ret = _next ( camera )->startStreaming ( camera, callback,
+			callbackArg )) == OA_ERR_NONE ) {
+		pthread_mutex_lock ( &rc->mutex );
+		rc->streaming = rc->enabled;
+		rc->callback = callback;
+		rc->callbackArg = callbackArg;
+		rc->leasedCallback = 0;
+		pthread_mutex_unlock ( &rc->mutex );
+	}
+	return ret;
+}
+
+
+// Leased streaming is usually built on startStreaming() above, so the
+// record made there is overwritten once this one succeeds
+
+static int
+_startStreamingLeased ( oaCamera* camera,
+		void* ( *callback )( void*, oaFrameLease* ), void* callbackArg )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+	int						ret;
+
+	if (( ret = _next ( camera )->startStreamingLeased ( camera, callback,
+			callbackArg )) == OA_ERR_NONE ) {
+		pthread_mutex_lock ( &rc->mutex );
+		rc->streaming = rc->enabled;
+		rc->callback = 0;
+		rc->leasedCallback = callback;
+		rc->leasedCallbackArg = callbackArg;
+		pthread_mutex_unlock ( &rc->mutex );
+	}
+	return ret;
+}
+
+
+static int
+_stopStreaming ( oaCamera* camera )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+
+	pthread_mutex_lock ( &rc->mutex );
+	rc->streaming = 0;
+	pthread_mutex_unlock ( &rc->mutex );
+	return _next ( camera )->stopStreaming ( camera );
+}
+
+
+static int
+_closeCamera ( oaCamera* camera )
+{
+	OA_RECONNECT*	rc = _reconnect ( camera );
+
+	pthread_mutex_lock ( &rc->mutex );
+	rc->enabled = 0;
+	pthread_mutex_unlock ( &rc->mutex );
+	pthread_mutex_destroy ( &rc->mutex );
+	return _next ( camera )->closeCamera ( camera );
+}
+
+
+const oaCameraFuncs	oacamReconnectHooks = {
+	.closeCamera = _closeCamera,
+	.setControl = _setControl,
+	.setResolution = _setResolution,
+	.setROI = _setROI,
+	.setFrameInterval = _setFrameInterval,
+	.startStreaming = _startStreaming,
+	.startStreamingLeased = _startStreamingLeased,
+	.stopStreaming = _stopStreaming
+};
+
+
+int
+oaEnableCameraReconnect ( oaCamera* camera, oaCameraDevice* device )
+{
+	OA_RECONNECT*	rc;
+	DEVICE_INFO*	devInfo;
+
+	if ( !camera || !device || camera->interface != device->interface ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	rc = _reconnect ( camera );
+	if ( rc->enabled ) {
+		return OA_ERR_NONE;
+	}
+
+	rc->interface = device->interface;
+	( void ) strncpy ( rc->deviceName, device->deviceName, OA_MAX_NAME_LEN );
+	rc->deviceName[ OA_MAX_NAME_LEN ] = 0;
+	rc->vendorId = rc->productId = 0;
+	rc->deviceId[0] = 0;
+	if (( devInfo = device->_private )) {
+		rc->vendorId = devInfo->vendorId;
+		rc->productId = devInfo->productId;
+		( void ) strncpy ( rc->deviceId, devInfo->deviceId,
+				OA_MAX_DEVICEID_LEN );
+		rc->deviceId[ OA_MAX_DEVICEID_LEN ] = 0;
+	}
+	rc->numControls = 0;
+	rc->haveResolution = rc->haveROI = rc->haveInterval = 0;
+	rc->streaming = 0;
+	pthread_mutex_lock ( &rc->mutex );
+	rc->enabled = 1;
+	pthread_mutex_unlock ( &rc->mutex );
+	return OA_ERR_NONE;
+}
+
+
+// The device id is the most specific thing to go on when there is one,
+// otherwise the first device with the same name and USB ids will have to
+// do
+
+static oaCameraDevice*
+_findDevice ( OA_RECONNECT* rc, CAMERA_LIST* list )
+{
+	oaCameraDevice*	device;
+	DEVICE_INFO*		devInfo;
+	unsigned int		i;
+
+	for ( i = 0; i < list->numCameras; i++ ) {
+		device = list->cameraList[i];
+		if ( strcmp ( device->deviceName, rc->deviceName )) {
+			continue;
+		}
+		if (!( devInfo = device->_private )) {
+			return device;
+		}
+		if ( devInfo->vendorId != rc->vendorId ||
+				devInfo->productId != rc->productId ) {
+			continue;
+		}
+		if ( !rc->deviceId[0] || !strcmp ( devInfo->deviceId, rc->deviceId )) {
+			return device;
+		}
+	}
+	return 0;
+}
+
+
+static int
+_restore ( oaCamera* camera, OA_RECONNECT* saved, int softBinMode )
+{
+	OA_RECONNECT*	rc;
+	unsigned int	i;
+	int						ret;
+
+	if ( softBinMode >= 0 ) {
+		( void ) oaEnableSoftwareBinning ( camera, softBinMode );
+	}
+
+	// Carry the record over, so the new camera can be reconnected too
+
+	rc = _reconnect ( camera );
+	rc->interface = saved->interface;
+	( void ) strcpy ( rc->deviceName, saved->deviceName );
+	rc->vendorId = saved->vendorId;
+	rc->productId = saved->productId;
+	( void ) strcpy ( rc->deviceId, saved->deviceId );
+	rc->numControls = 0;
+	rc->haveResolution = rc->haveROI = rc->haveInterval = 0;
+	rc->streaming = 0;
+	pthread_mutex_lock ( &rc->mutex );
+	rc->enabled = 1;
+	pthread_mutex_unlock ( &rc->mutex );
+
+	if ( saved->haveResolution && ( ret = camera->funcs.setResolution ( camera,
+			saved->xSize, saved->ySize )) != OA_ERR_NONE ) {
+		oaLogWarning ( OA_LOG_CAMERA, "%s: can't restore size %dx%d: %d",
+				__func__, saved->xSize, saved->ySize, ret );
+	}
+	if ( saved->haveROI && ( ret = camera->funcs.setROI ( camera, saved->roiX,
+			saved->roiY )) != OA_ERR_NONE ) {
+		oaLogWarning ( OA_LOG_CAMERA, "%s: can't restore ROI %dx%d: %d",
+				__func__, saved->roiX, saved->roiY, ret );
+	}
+	if ( saved->haveInterval && ( ret = camera->funcs.setFrameInterval (
+			camera, saved->intervalNum, saved->intervalDen )) != OA_ERR_NONE ) {
+		oaLogWarning ( OA_LOG_CAMERA, "%s: can't restore frame interval: %d",
+				__func__, ret );
+	}
+	for ( i = 0; i < saved->numControls; i++ ) {
+		if (( ret = camera->funcs.setControl ( camera,
+				saved->controls[i].control, &saved->controls[i].value,
+				0 )) != OA_ERR_NONE ) {
+			oaLogWarning ( OA_LOG_CAMERA, "%s: can't restore control %d: %d",
+					__func__, saved->controls[i].control, ret );
+		}
+	}
+
+	if ( !saved->streaming ) {
+		return OA_ERR_NONE;
+	}
+	if ( saved->leasedCallback ) {
+		return camera->funcs.startStreamingLeased ( camera,
+				saved->leasedCallback, saved->leasedCallbackArg );
+	}
+	return camera->funcs.startStreaming ( camera, saved->callback,
+			saved->callbackArg );
+}
+
+
+oaCamera*
+oaReconnectCamera ( oaCamera* camera, unsigned int timeoutMs, int* error )
+{
+	SHARED_STATE*		cameraInfo;
+	OA_RECONNECT*		saved;
+	oaCameraDevice*	device;
+	oaCamera*				newCamera = 0;
+	CAMERA_LIST			list;
+	unsigned int		waited;
+	int							softBinMode = -1, ret;
+
+	*error = OA_ERR_NONE;
+	if ( !camera ) {
+		*error = -OA_ERR_INVALID_CAMERA;
+		return 0;
+	}
+	cameraInfo = camera->_private;
+	if ( !cameraInfo->reconnect.enabled ) {
+		*error = -OA_ERR_INVALID_COMMAND;
+		return 0;
+	}
+	if (!( saved = malloc ( sizeof ( OA_RECONNECT )))) {
+		*error = -OA_ERR_MEM_ALLOC;
+		return 0;
+	}
+
+	pthread_mutex_lock ( &cameraInfo->reconnect.mutex );
+	*saved = cameraInfo->reconnect;
+	pthread_mutex_unlock ( &cameraInfo->reconnect.mutex );
+	if ( cameraInfo->softBinning.enabled ) {
+		softBinMode = cameraInfo->softBinning.mode;
+	}
+
+	// The device may well have gone, so failures here don't matter.  The
+	// frame buffers are kept back in this record for the new camera to pick
+	// up
+
+	if ( saved->streaming ) {
+		( void ) _next ( camera )->stopStreaming ( camera );
+	}
+	saved->parked.buffers = 0;
+	oacamParkBuffers ( cameraInfo, &saved->parked );
+	( void ) camera->funcs.closeCamera ( camera );
+
+	for ( waited = 0;; waited += OA_RECONNECT_POLL_MS ) {
+		OA_CLEAR ( list );
+		if (( ret = oacamEnumerateInterface ( saved->interface, &list )) >= 0 &&
+				( device = _findDevice ( saved, &list ))) {
+			oacamOfferParkedBuffers ( &saved->parked );
+			if (!( newCamera = device->initCamera ( device ))) {
+				ret = -OA_ERR_CAMERA_IO;
+			}
+			oacamOfferParkedBuffers ( 0 );
+			_oaFreeCameraDeviceList ( &list );
+			break;
+		}
+		_oaFreeCameraDeviceList ( &list );
+		if ( waited >= timeoutMs ) {
+			ret = -OA_ERR_INVALID_CAMERA;
+			break;
+		}
+		usleep ( OA_RECONNECT_POLL_MS * 1000 );
+	}
+
+	if ( newCamera && ( ret = _restore ( newCamera, saved,
+			softBinMode )) != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't restart streaming: %d", __func__,
+				ret );
+	}
+
+	if ( !newCamera ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: %s did not come back: %d", __func__,
+				saved->deviceName, ret );
+	}
+	*error = ret;
+
+	// Anything not picked up by the new camera is no longer needed
+	if ( newCamera ) {
+		(( SHARED_STATE* ) newCamera->_private )->parkedBuffers = 0;
+	}
+	oacamFreeParkedBuffers ( &saved->parked );
+	free (( void* ) saved );
+	return newCamera;
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *
+ * reconnect.h -- record of camera settings for reconnection
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_RECONNECT_H
+#define OA_CAMERA_RECONNECT_H
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+
+#include "bufferPool.h"
+
+struct SHARED_STATE;
+
+#define	OA_RECONNECT_MAX_CONTROLS	\
+	( OA_CAM_CTRL_MODIFIERS_LAST_P1 * OA_CAM_CTRL_LAST_P1 )
+
+typedef struct OA_RECONNECT_CONTROL {
+	int							control;
+	oaControlValue	value;
+} OA_RECONNECT_CONTROL;
+
+// Once enabled, the reconnect layer over the camera functions records
+// here each change to the camera's setup and whether it is streaming.
+// The device is identified by the name, USB ids and device id it was
+// enumerated with, as its bus address will change if it is replugged.
+// Controls are kept in the order they were last set, as some only take
+// effect when another, such as an auto mode, already has the right value.
+
+typedef struct OA_RECONNECT {
+	int										enabled;
+	pthread_mutex_t				mutex;
+	int										interface;
+	char									deviceName[ OA_MAX_NAME_LEN+1 ];
+	unsigned short				vendorId;
+	unsigned short				productId;
+	char									deviceId[ OA_MAX_DEVICEID_LEN+1 ];
+	unsigned int					numControls;
+	OA_RECONNECT_CONTROL	controls[ OA_RECONNECT_MAX_CONTROLS ];
+	int										haveResolution;
+	int										xSize;
+	int										ySize;
+	int										haveROI;
+	int										roiX;
+	int										roiY;
+	int										haveInterval;
+	int										intervalNum;
+	int										intervalDen;
+	int										streaming;
+	void*									( *callback )( void*, void*, int, void* );
+	void*									callbackArg;
+	void*									( *leasedCallback )( void*, oaFrameLease* );
+	void*									leasedCallbackArg;
+	OA_PARKED_BUFFERS			parked;
+} OA_RECONNECT;
+
+extern void	oacamReconnectInit ( struct SHARED_STATE* );
+
+#endif	/* OA_CAMERA_RECONNECT_H */
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *
+ * replayCallback.c -- Replay camera callback handler
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+
+#include "oacamprivate.h"
+#include "unimplemented.h"
+#include "replayoacam.h"
+#include "replaystate.h"
+
+
+void*
+oacamReplayCallbackHandler ( void* param )
+{
+  oaCamera*		camera = param;
+  REPLAY_STATE*		cameraInfo = camera->_private;
+  CALLBACK*		callback;
+  void*			(*callbackFunc)( void*, void*, int, void* );
+  uint64_t		started;
+
+  do {
+    callback = oacamCallbackRingWait ( &cameraInfo->callbackRing );
+    if ( callback ) {
+      switch ( callback->callbackType ) {
+        case OA_CALLBACK_NEW_FRAME:
+          if ( !oacamLeaseFrame (( SHARED_STATE* ) cameraInfo, callback,
+              callback->buffer )) {
+            callbackFunc = callback->callback;
+            started = oacamCallbackStarted (( SHARED_STATE* ) cameraInfo,
+                callback );
+            callbackFunc ( callback->callbackArg, callback->buffer,
+                callback->bufferLen, callback->metadata );
+            oacamCallbackFinished (( SHARED_STATE* ) cameraInfo, started );
+            OA_RELEASE_BUFFER ( cameraInfo );
+          }
+          break;
+        default:
+          oaLogError ( OA_LOG_CAMERA, "%s: unexpected callback type %d",
+              __func__, callback->callbackType );
+          break;
+      }
+      oacamCallbackRingRelease ( &cameraInfo->callbackRing );
+    }
+  } while ( callback );
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+/*****************************************************************************
+ *
+ * replayControl.c -- control validation for replay cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+#include <openastro/camera.h>
+
+#include "oacamprivate.h"
+#include "replayoacam.h"
+#include "replaystate.h"
+
+
+int
+oaReplayCameraTestControl ( oaCamera* camera, int control,
+    oaControlValue* val )
+{
+  REPLAY_STATE*	cameraInfo = camera->_private;
+
+  if ( !camera->OA_CAM_CTRL_TYPE( control )) {
+    return -OA_ERR_INVALID_CONTROL;
+  }
+
+  if ( camera->OA_CAM_CTRL_TYPE( control ) != val->valueType ) {
+    return -OA_ERR_INVALID_CONTROL_TYPE;
+  }
+
+  switch ( control ) {
+    case OA_CAM_CTRL_FRAME_FORMAT:
+      if ( val->discrete == cameraInfo->source.format ) {
+        return OA_ERR_NONE;
+      }
+      break;
+
+    default:
+      oaLogError ( OA_LOG_CAMERA, "%s: Unrecognised control %d", __func__,
+          control );
+      return -OA_ERR_INVALID_CONTROL;
+      break;
+  }
+
+  return -OA_ERR_OUT_OF_RANGE;
+}
@@ -0,0 +1,333 @@
+/*****************************************************************************
+ *
+ * replayController.c -- main controller thread for replay cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#include <openastro/camera.h>
+#include <openastro/video/formats.h>
+
+#include "oacamprivate.h"
+#include "unimplemented.h"
+#include "replayoacam.h"
+#include "replaystate.h"
+
+
+static int	_processSetControl ( oaCamera*, OA_COMMAND* );
+static int	_processGetControl ( oaCamera*, OA_COMMAND* );
+static int	_processStreamingStart ( REPLAY_STATE*, OA_COMMAND* );
+static int	_processStreamingStop ( REPLAY_STATE*, OA_COMMAND* );
+static void	_rewind ( REPLAY_STATE* );
+static void	_scheduleFrame ( REPLAY_STATE* );
+static int	_frameDue ( REPLAY_STATE* );
+static void	_deliverFrame ( oaCamera* );
+
+// While waiting for the next frame the thread still wakes this often to
+// look for commands
+#define	REPLAY_COMMAND_POLL_NS	10000000ULL
+#define	REPLAY_BUFFER_WAIT_NS	1000000ULL
+
+
+void*
+oacamReplayController ( void* param )
+{
+  oaCamera*		camera = param;
+  REPLAY_STATE*		cameraInfo = camera->_private;
+  OA_COMMAND*		command;
+  int			exitThread = 0;
+  int			resultCode;
+  int			streaming = 0;
+
+  do {
+    pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+    exitThread = cameraInfo->stopControllerThread;
+    pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+    if ( exitThread ) {
+      break;
+    } else {
+      pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+      // stop us busy-waiting, which includes when the recording has ended
+      streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING &&
+          !cameraInfo->atEnd ) ? 1 : 0;
+      if ( !streaming && oaDLListIsEmpty ( cameraInfo->commandQueue )) {
+        pthread_cond_wait ( &cameraInfo->commandQueued,
+            &cameraInfo->commandQueueMutex );
+      }
+      pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+    }
+
+    do {
+      command = oaDLListRemoveFromHead ( cameraInfo->commandQueue );
+      if ( command ) {
+        switch ( command->commandType ) {
+          case OA_CMD_CONTROL_SET:
+            resultCode = _processSetControl ( camera, command );
+            break;
+          case OA_CMD_CONTROL_GET:
+            resultCode = _processGetControl ( camera, command );
+            break;
+          case OA_CMD_START_STREAMING:
+            resultCode = _processStreamingStart ( cameraInfo, command );
+            break;
+          case OA_CMD_STOP_STREAMING:
+            resultCode = _processStreamingStop ( cameraInfo, command );
+            break;
+          default:
+            resultCode = -OA_ERR_INVALID_CONTROL;
+            break;
+        }
+        if ( command->callback ) {
+					oaLogWarning ( OA_LOG_CAMERA, "%s: command has callback", __func__ );
+        } else {
+          pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+          command->completed = 1;
+          command->resultCode = resultCode;
+          pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+          pthread_cond_broadcast ( &cameraInfo->commandComplete );
+        }
+      }
+    } while ( command );
+
+    pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+    streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
+    exitThread = cameraInfo->stopControllerThread;
+    pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+
+    if ( streaming && !exitThread && !cameraInfo->atEnd &&
+        _frameDue ( cameraInfo )) {
+      _deliverFrame ( camera );
+    }
+  } while ( !exitThread );
+
+  return 0;
+}
+
+
+// Start playing from the first frame, with the recording's clock lined
+// up with now
+
+static void
+_rewind ( REPLAY_STATE* cameraInfo )
+{
+  cameraInfo->currentFrame = 0;
+  cameraInfo->atEnd = 0;
+  cameraInfo->wallBase = oacamMonotonicTime();
+  cameraInfo->recordedBase = oacamReplayFrameTime ( &cameraInfo->source, 0 );
+  cameraInfo->nextFrameTime = cameraInfo->wallBase;
+  cameraInfo->paced = !( cameraInfo->replayFlags & OA_REPLAY_MAX_RATE ) &&
+      ( cameraInfo->recordedBase || cameraInfo->frameRate > 0 );
+}
+
+
+// Work out when currentFrame is due.  Recorded timestamps win, with the
+// frame rate used for any frame whose timestamp is missing or runs
+// backwards.
+
+static void
+_scheduleFrame ( REPLAY_STATE* cameraInfo )
+{
+  uint64_t	recorded;
+
+  if ( !cameraInfo->paced ) {
+    return;
+  }
+  recorded = cameraInfo->recordedBase ? oacamReplayFrameTime (
+      &cameraInfo->source, cameraInfo->currentFrame ) : 0;
+  if ( recorded && recorded >= cameraInfo->recordedBase ) {
+    cameraInfo->nextFrameTime = cameraInfo->wallBase + ( recorded -
+        cameraInfo->recordedBase );
+  } else if ( cameraInfo->frameRate > 0 ) {
+    cameraInfo->nextFrameTime += 1000000000.0 / cameraInfo->frameRate;
+  }
+}
+
+
+// Returns non-zero when the next frame should be delivered, having slept
+// for as much of the wait as can be done without leaving commands
+// unanswered
+
+static int
+_frameDue ( REPLAY_STATE* cameraInfo )
+{
+  uint64_t	now, wake;
+
+  now = oacamMonotonicTime();
+  if ( !cameraInfo->paced ) {
+    if ( OA_BUFFERS_FREE ( cameraInfo )) {
+      return 1;
+    }
+    // Unpaced playback waits for the application rather than dropping
+    oacamSleepUntil ( now + REPLAY_BUFFER_WAIT_NS );
+    return 0;
+  }
+
+  if ( now >= cameraInfo->nextFrameTime ) {
+    return 1;
+  }
+
+  wake = now + REPLAY_COMMAND_POLL_NS;
+  if ( wake > cameraInfo->nextFrameTime ) {
+    wake = cameraInfo->nextFrameTime;
+  }
+  oacamSleepUntil ( wake );
+  return 0;
+}
+
+
+static void
+_deliverFrame ( oaCamera* camera )
+{
+  REPLAY_STATE*		cameraInfo = camera->_private;
+  FRAME_METADATA*	metadata;
+  void*			frame;
+  uint64_t		recorded;
+  unsigned int		n;
+  int			nextBuffer;
+
+  n = cameraInfo->currentFrame;
+  nextBuffer = cameraInfo->nextBuffer;
+
+  if ( !OA_BUFFERS_FREE ( cameraInfo )) {
+    // A paced recording doesn't wait, so this frame is lost
+    OA_DROP_FRAME_NO_BUFFER (( SHARED_STATE* ) cameraInfo );
+  } else if ( oacamReplayReadFrame ( &cameraInfo->source, n,
+      cameraInfo->buffers[ nextBuffer ].start, &frame ) != OA_ERR_NONE ) {
+    OA_DROP_FRAME (( SHARED_STATE* ) cameraInfo );
+  } else {
+    recorded = oacamReplayFrameTime ( &cameraInfo->source, n );
+    metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
+    metadata->frameCounter = n;
+    metadata->frameCounterValid = 1;
+    if ( recorded ) {
+      metadata->hwTimestamp = recorded;
+      metadata->hwTimestampValid = 1;
+    }
+    cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
+    cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
+        OA_CALLBACK_NEW_FRAME;
+    cameraInfo->frameCallbacks[ nextBuffer ].callback =
+        cameraInfo->streamingCallback.callback;
+    cameraInfo->frameCallbacks[ nextBuffer ].callbackArg =
+        cameraInfo->streamingCallback.callbackArg;
+    cameraInfo->frameCallbacks[ nextBuffer ].buffer = frame;
+    cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
+        cameraInfo->imageBufferLength;
+    oacamCallbackRingPush ( &cameraInfo->callbackRing,
+        &cameraInfo->frameCallbacks[ nextBuffer ]);
+    OA_CLAIM_BUFFER ( cameraInfo );
+    cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
+        cameraInfo->configuredBuffers;
+  }
+
+  if ( ++cameraInfo->currentFrame < cameraInfo->source.numFrames ) {
+    _scheduleFrame ( cameraInfo );
+  } else if ( cameraInfo->replayFlags & OA_REPLAY_LOOP ) {
+    _rewind ( cameraInfo );
+  } else {
+    oaLogInfo ( OA_LOG_CAMERA, "%s: end of recording after %u frames",
+        __func__, cameraInfo->source.numFrames );
+    cameraInfo->atEnd = 1;
+  }
+}
+
+
+static int
+_processSetControl ( oaCamera* camera, OA_COMMAND* command )
+{
+  REPLAY_STATE*		cameraInfo = camera->_private;
+  oaControlValue	*val = command->commandData;
+
+  switch ( command->controlId ) {
+
+    case OA_CAM_CTRL_FRAME_FORMAT:
+      if ( val->discrete != cameraInfo->source.format ) {
+        return -OA_ERR_OUT_OF_RANGE;
+      }
+      break;
+
+    default:
+      return -OA_ERR_INVALID_CONTROL;
+      break;
+  }
+  return OA_ERR_NONE;
+}
+
+
+static int
+_processGetControl ( oaCamera* camera, OA_COMMAND* command )
+{
+  REPLAY_STATE*		cameraInfo = camera->_private;
+  oaControlValue	*val = command->resultData;
+
+  switch ( command->controlId ) {
+
+    case OA_CAM_CTRL_FRAME_FORMAT:
+			val->valueType = OA_CTRL_TYPE_DISCRETE;
+      val->discrete = cameraInfo->source.format;
+			break;
+
+    default:
+      return -OA_ERR_INVALID_CONTROL;
+      break;
+  }
+  return OA_ERR_NONE;
+}
+
+
+static int
+_processStreamingStart ( REPLAY_STATE* cameraInfo, OA_COMMAND* command )
+{
+  CALLBACK*	cb = command->commandData;
+
+  if ( cameraInfo->runMode != CAM_RUN_MODE_STOPPED ) {
+    return -OA_ERR_INVALID_COMMAND;
+  }
+
+  cameraInfo->streamingCallback.callback = cb->callback;
+  cameraInfo->streamingCallback.callbackArg = cb->callbackArg;
+  // Every start plays the recording from the beginning
+  _rewind ( cameraInfo );
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  cameraInfo->runMode = CAM_RUN_MODE_STREAMING;
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+  return OA_ERR_NONE;
+}
+
+
+static int
+_processStreamingStop ( REPLAY_STATE* cameraInfo, OA_COMMAND* command )
+{
+  if ( cameraInfo->runMode != CAM_RUN_MODE_STREAMING ) {
+    return -OA_ERR_INVALID_COMMAND;
+  }
+
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+  return OA_ERR_NONE;
+}
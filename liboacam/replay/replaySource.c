@@ -0,0 +1,629 @@
+/*****************************************************************************
+ *
+ * replaySource.c -- SER, FITS and PNG frame sources for replay cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if HAVE_LIMITS_H
+#include <limits.h>
+#endif
+#if HAVE_LIBPNG
+#include <png.h>
+#endif
+
+#include <openastro/camera.h>
+#include <openastro/demosaic.h>
+#include <openastro/errno.h>
+#include <openastro/util.h>
+#include <openastro/SER.h>
+#include <openastro/video/formats.h>
+
+#include "replaySource.h"
+
+
+#define	SER_HEADER_LEN			178
+#define	FITS_BLOCK_LEN			2880
+#define	FITS_CARD_LEN				80
+
+// 100ns ticks from 0001-01-01 to the Unix epoch
+#define	SER_EPOCH_TICKS			621355968000000000LL
+
+typedef struct {
+	int						bitpix;
+	int						naxis;
+	unsigned int	width;
+	unsigned int	height;
+	int						bzero;
+	int						bayer;
+	int						xBayerOffset;
+	int						yBayerOffset;
+	int						bottomUp;
+	uint64_t			timestamp;
+	size_t				dataOffset;
+} FITS_INFO;
+
+
+static uint32_t
+_le32 ( const unsigned char* p )
+{
+	return p[0] | ( p[1] << 8 ) | ( p[2] << 16 ) | (( uint32_t ) p[3] << 24 );
+}
+
+
+static uint64_t
+_le64 ( const unsigned char* p )
+{
+	return _le32 ( p ) | (( uint64_t ) _le32 ( p + 4 ) << 32 );
+}
+
+
+static void*
+_mapFile ( const char* path, size_t* length )
+{
+	struct stat		st;
+	void*					m;
+	int						fd;
+
+	if (( fd = open ( path, O_RDONLY )) < 0 ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't open %s", __func__, path );
+		return 0;
+	}
+	if ( fstat ( fd, &st ) || st.st_size <= 0 ) {
+		close ( fd );
+		return 0;
+	}
+	// Private and writeable so an application that modifies a frame in
+	// place gets its own copy of the page rather than a fault
+	m = mmap ( 0, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+	close ( fd );
+	if ( MAP_FAILED == m ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't map %s, errno = %d", __func__,
+				path, errno );
+		return 0;
+	}
+	*length = st.st_size;
+	return m;
+}
+
+
+static int
+_serFormat ( uint32_t colour, uint32_t depth, uint32_t littleEndian )
+{
+	int		wide = ( depth > 8 );
+
+	// liboaSER and most other writers store 0 in the LittleEndian field
+	// for little-endian data, contrary to the name
+	switch ( colour ) {
+		case OA_SER_MONO:
+			return wide ? ( littleEndian ? OA_PIX_FMT_GREY16BE :
+					OA_PIX_FMT_GREY16LE ) : OA_PIX_FMT_GREY8;
+		case OA_SER_BAYER_RGGB:
+			return wide ? ( littleEndian ? OA_PIX_FMT_RGGB16BE :
+					OA_PIX_FMT_RGGB16LE ) : OA_PIX_FMT_RGGB8;
+		case OA_SER_BAYER_GRBG:
+			return wide ? ( littleEndian ? OA_PIX_FMT_GRBG16BE :
+					OA_PIX_FMT_GRBG16LE ) : OA_PIX_FMT_GRBG8;
+		case OA_SER_BAYER_GBRG:
+			return wide ? ( littleEndian ? OA_PIX_FMT_GBRG16BE :
+					OA_PIX_FMT_GBRG16LE ) : OA_PIX_FMT_GBRG8;
+		case OA_SER_BAYER_BGGR:
+			return wide ? ( littleEndian ? OA_PIX_FMT_BGGR16BE :
+					OA_PIX_FMT_BGGR16LE ) : OA_PIX_FMT_BGGR8;
+		case OA_SER_RGB:
+			return wide ? ( littleEndian ? OA_PIX_FMT_RGB48BE :
+					OA_PIX_FMT_RGB48LE ) : OA_PIX_FMT_RGB24;
+		case OA_SER_BGR:
+			return wide ? ( littleEndian ? OA_PIX_FMT_BGR48BE :
+					OA_PIX_FMT_BGR48LE ) : OA_PIX_FMT_BGR24;
+	}
+	return -1;
+}
+
+
+static int
+_openSER ( REPLAY_SOURCE* source, const char* path )
+{
+	const unsigned char*	h;
+	uint32_t							count, depth, planes;
+	size_t								available;
+
+	if (!( source->map = _mapFile ( path, &source->mapLength ))) {
+		return -OA_ERR_NOT_READABLE;
+	}
+	h = source->map;
+	if ( source->mapLength < SER_HEADER_LEN ||
+			memcmp ( h, "LUCAM-RECORDER", 14 )) {
+		oaLogError ( OA_LOG_CAMERA, "%s: %s is not a SER file", __func__, path );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	source->width = _le32 ( h + 26 );
+	source->height = _le32 ( h + 30 );
+	depth = _le32 ( h + 34 );
+	count = _le32 ( h + 38 );
+	if (( source->format = _serFormat ( _le32 ( h + 18 ), depth,
+			_le32 ( h + 22 ))) < 0 || !source->width || !source->height ||
+			depth < 1 || depth > 16 ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: unsupported SER layout in %s",
+				__func__, path );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+	planes = oaFrameFormats[ source->format ].fullColour ? 3 : 1;
+	source->frameSize = ( size_t ) source->width * source->height * planes *
+			( depth > 8 ? 2 : 1 );
+
+	// Believe the data actually present if the file was cut short
+	available = ( source->mapLength - SER_HEADER_LEN ) / source->frameSize;
+	source->numFrames = ( count < available ) ? count : available;
+	source->frames = source->map + SER_HEADER_LEN;
+	if ( count == source->numFrames && source->mapLength >= SER_HEADER_LEN +
+			count * source->frameSize + count * 8 ) {
+		source->timestamps = source->frames + count * source->frameSize;
+	}
+
+	( void ) madvise ( source->map, source->mapLength, MADV_SEQUENTIAL );
+	return source->numFrames ? OA_ERR_NONE : -OA_ERR_UNSUPPORTED_FORMAT;
+}
+
+
+static int
+_parseFITS ( const unsigned char* m, size_t length, FITS_INFO* info )
+{
+	char					card[ FITS_CARD_LEN + 1 ];
+	char*					value;
+	size_t				offset;
+	int						simple = 0, end = 0;
+
+	memset ( info, 0, sizeof ( FITS_INFO ));
+	card[ FITS_CARD_LEN ] = 0;
+	for ( offset = 0; !end && offset + FITS_CARD_LEN <= length;
+			offset += FITS_CARD_LEN ) {
+		memcpy ( card, m + offset, FITS_CARD_LEN );
+		value = ( card[8] == '=' ) ? card + 10 : 0;
+		if ( !strncmp ( card, "END     ", 8 )) {
+			end = 1;
+		} else if ( value ) {
+			if ( !strncmp ( card, "SIMPLE  ", 8 )) {
+				simple = ( strchr ( value, 'T' ) != 0 );
+			} else if ( !strncmp ( card, "BITPIX  ", 8 )) {
+				info->bitpix = atoi ( value );
+			} else if ( !strncmp ( card, "NAXIS   ", 8 )) {
+				info->naxis = atoi ( value );
+			} else if ( !strncmp ( card, "NAXIS1  ", 8 )) {
+				info->width = atoi ( value );
+			} else if ( !strncmp ( card, "NAXIS2  ", 8 )) {
+				info->height = atoi ( value );
+			} else if ( !strncmp ( card, "BZERO   ", 8 )) {
+				info->bzero = atof ( value );
+			} else if ( !strncmp ( card, "BAYERPAT", 8 )) {
+				info->bayer = 1;
+			} else if ( !strncmp ( card, "XBAYROFF", 8 )) {
+				info->xBayerOffset = atoi ( value ) & 1;
+			} else if ( !strncmp ( card, "YBAYROFF", 8 )) {
+				info->yBayerOffset = atoi ( value ) & 1;
+			} else if ( !strncmp ( card, "ROWORDER", 8 )) {
+				info->bottomUp = ( strstr ( value, "BOTTOM-UP" ) != 0 );
+			} else if ( !strncmp ( card, "OAMONOTS", 8 )) {
+				info->timestamp = strtoull ( value, 0, 10 );
+			}
+		}
+	}
+
+	info->dataOffset = ( offset + FITS_BLOCK_LEN - 1 ) / FITS_BLOCK_LEN *
+			FITS_BLOCK_LEN;
+	if ( !simple || !end || info->naxis != 2 || !info->width ||
+			!info->height || ( info->bitpix != 8 && info->bitpix != 16 )) {
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+	if ( info->dataOffset + ( size_t ) info->width * info->height *
+			( info->bitpix / 8 ) > length ) {
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+	return OA_ERR_NONE;
+}
+
+
+static int
+_fitsFormat ( FITS_INFO* info )
+{
+	// The offsets are from GRBG, as written by oacapture
+	static const int	bayer8[2][2] = {
+		{ OA_PIX_FMT_GRBG8, OA_PIX_FMT_RGGB8 },
+		{ OA_PIX_FMT_BGGR8, OA_PIX_FMT_GBRG8 }
+	};
+	static const int	bayer16[2][2] = {
+		{ OA_PIX_FMT_GRBG16BE, OA_PIX_FMT_RGGB16BE },
+		{ OA_PIX_FMT_BGGR16BE, OA_PIX_FMT_GBRG16BE }
+	};
+
+	if ( info->bayer ) {
+		return ( info->bitpix == 8 ) ?
+				bayer8[ info->yBayerOffset ][ info->xBayerOffset ] :
+				bayer16[ info->yBayerOffset ][ info->xBayerOffset ];
+	}
+	return ( info->bitpix == 8 ) ? OA_PIX_FMT_GREY8 : OA_PIX_FMT_GREY16BE;
+}
+
+
+static int
+_readFITS ( REPLAY_SOURCE* source, unsigned int n, void* buffer,
+		uint64_t* timestamp )
+{
+	FITS_INFO					info;
+	unsigned char*		m;
+	unsigned char*		t;
+	const unsigned char*	s;
+	size_t						length, rowLen;
+	unsigned int			y, x;
+	int								ret;
+
+	if (!( m = _mapFile ( source->files[n], &length ))) {
+		return -OA_ERR_NOT_READABLE;
+	}
+	if (( ret = _parseFITS ( m, length, &info )) != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't use %s", __func__,
+				source->files[n] );
+		munmap ( m, length );
+		return ret;
+	}
+
+	if ( timestamp ) {
+		*timestamp = info.timestamp;
+	}
+
+	if ( buffer ) {
+		if ( info.width != source->width || info.height != source->height ||
+				_fitsFormat ( &info ) != source->format ) {
+			oaLogError ( OA_LOG_CAMERA, "%s: %s doesn't match the first frame",
+					__func__, source->files[n] );
+			munmap ( m, length );
+			return -OA_ERR_INVALID_SIZE;
+		}
+		rowLen = ( size_t ) info.width * ( info.bitpix / 8 );
+		for ( y = 0; y < info.height; y++ ) {
+			s = m + info.dataOffset + ( info.bottomUp ?
+					info.height - 1 - y : y ) * rowLen;
+			t = ( unsigned char* ) buffer + y * rowLen;
+			memcpy ( t, s, rowLen );
+			// Unsigned 16-bit data is stored offset by 32768
+			if ( info.bitpix == 16 && info.bzero == 32768 ) {
+				for ( x = 0; x < rowLen; x += 2 ) {
+					t[x] ^= 0x80;
+				}
+			}
+		}
+	}
+
+	munmap ( m, length );
+	return OA_ERR_NONE;
+}
+
+
+#if HAVE_LIBPNG
+static int
+_readPNG ( REPLAY_SOURCE* source, unsigned int n, void* buffer )
+{
+	FILE*					fp;
+	png_structp		png;
+	png_infop			info;
+	png_bytep*		rows = 0;
+	png_uint_32		width, height;
+	int						depth, colour, format;
+	unsigned int	y;
+	size_t				rowLen;
+
+	if (!( fp = fopen ( source->files[n], "rb" ))) {
+		return -OA_ERR_NOT_READABLE;
+	}
+	if (!( png = png_create_read_struct ( PNG_LIBPNG_VER_STRING, 0, 0, 0 ))) {
+		fclose ( fp );
+		return -OA_ERR_MEM_ALLOC;
+	}
+	if (!( info = png_create_info_struct ( png ))) {
+		png_destroy_read_struct ( &png, 0, 0 );
+		fclose ( fp );
+		return -OA_ERR_MEM_ALLOC;
+	}
+	if ( setjmp ( png_jmpbuf ( png ))) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't decode %s", __func__,
+				source->files[n] );
+		png_destroy_read_struct ( &png, &info, 0 );
+		fclose ( fp );
+		if ( rows ) {
+			free (( void* ) rows );
+		}
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	png_init_io ( png, fp );
+	png_read_info ( png, info );
+	png_get_IHDR ( png, info, &width, &height, &depth, &colour, 0, 0, 0 );
+	if ( colour == PNG_COLOR_TYPE_PALETTE ) {
+		png_set_palette_to_rgb ( png );
+		depth = 8;
+	}
+	if ( colour == PNG_COLOR_TYPE_GRAY && depth < 8 ) {
+		png_set_expand_gray_1_2_4_to_8 ( png );
+		depth = 8;
+	}
+	png_set_strip_alpha ( png );
+	png_read_update_info ( png, info );
+
+	if ( colour & PNG_COLOR_MASK_COLOR ) {
+		format = ( depth > 8 ) ? OA_PIX_FMT_RGB48BE : OA_PIX_FMT_RGB24;
+	} else {
+		format = ( depth > 8 ) ? OA_PIX_FMT_GREY16BE : OA_PIX_FMT_GREY8;
+	}
+
+	if ( !buffer ) {
+		// Just finding out what the sequence holds
+		source->width = width;
+		source->height = height;
+		source->format = format;
+	} else if ( width != source->width || height != source->height ||
+			format != source->format ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: %s doesn't match the first frame",
+				__func__, source->files[n] );
+		png_destroy_read_struct ( &png, &info, 0 );
+		fclose ( fp );
+		return -OA_ERR_INVALID_SIZE;
+	} else {
+		if (!( rows = malloc ( height * sizeof ( png_bytep )))) {
+			png_destroy_read_struct ( &png, &info, 0 );
+			fclose ( fp );
+			return -OA_ERR_MEM_ALLOC;
+		}
+		rowLen = png_get_rowbytes ( png, info );
+		for ( y = 0; y < height; y++ ) {
+			rows[y] = ( png_bytep ) buffer + y * rowLen;
+		}
+		png_read_image ( png, rows );
+		png_read_end ( png, 0 );
+		free (( void* ) rows );
+	}
+
+	png_destroy_read_struct ( &png, &info, 0 );
+	fclose ( fp );
+	return OA_ERR_NONE;
+}
+#endif
+
+
+static int
+_sequenceType ( const char* name )
+{
+	const char*		dot;
+
+	if (!( dot = strrchr ( name, '.' ))) {
+		return 0;
+	}
+	if ( !strcasecmp ( dot, ".fits" ) || !strcasecmp ( dot, ".fit" ) ||
+			!strcasecmp ( dot, ".fts" )) {
+		return REPLAY_SOURCE_FITS;
+	}
+#if HAVE_LIBPNG
+	if ( !strcasecmp ( dot, ".png" )) {
+		return REPLAY_SOURCE_PNG;
+	}
+#endif
+	return 0;
+}
+
+
+static int
+_compareNames ( const void* a, const void* b )
+{
+	return strcmp ( *( char* const* ) a, *( char* const* ) b );
+}
+
+
+static int
+_openSequence ( REPLAY_SOURCE* source, const char* path )
+{
+	DIR*						dir;
+	struct dirent*	entry;
+	char**					files;
+	char*						name;
+	unsigned int		allocated = 0, n = 0;
+	int							type, ret;
+	FITS_INFO				info;
+	unsigned char*	m;
+	size_t					length;
+
+	if (!( dir = opendir ( path ))) {
+		// Not a directory, so a sequence of one
+		if (!( source->type = _sequenceType ( path ))) {
+			return -OA_ERR_UNSUPPORTED_FORMAT;
+		}
+		if (!( source->files = malloc ( sizeof ( char* ))) ||
+				!( source->files[0] = strdup ( path ))) {
+			return -OA_ERR_MEM_ALLOC;
+		}
+		source->numFrames = 1;
+	} else {
+		// The first recognised file decides whether this is FITS or PNG
+		while (( entry = readdir ( dir ))) {
+			if (!( type = _sequenceType ( entry->d_name ))) {
+				continue;
+			}
+			if ( !source->type ) {
+				source->type = type;
+			}
+			if ( type != source->type ) {
+				continue;
+			}
+			if ( n == allocated ) {
+				allocated = allocated ? allocated * 2 : 64;
+				if (!( files = realloc ( source->files,
+						allocated * sizeof ( char* )))) {
+					closedir ( dir );
+					return -OA_ERR_MEM_ALLOC;
+				}
+				source->files = files;
+			}
+			if (!( name = malloc ( strlen ( path ) + strlen ( entry->d_name ) +
+					2 ))) {
+				closedir ( dir );
+				return -OA_ERR_MEM_ALLOC;
+			}
+			( void ) sprintf ( name, "%s/%s", path, entry->d_name );
+			source->files[ n++ ] = name;
+			source->numFrames = n;
+		}
+		closedir ( dir );
+		if ( !n ) {
+			oaLogError ( OA_LOG_CAMERA, "%s: no FITS or PNG files in %s",
+					__func__, path );
+			return -OA_ERR_UNSUPPORTED_FORMAT;
+		}
+		qsort ( source->files, n, sizeof ( char* ), _compareNames );
+	}
+
+	// Geometry and format come from the first frame
+	if ( REPLAY_SOURCE_FITS == source->type ) {
+		if (!( m = _mapFile ( source->files[0], &length ))) {
+			return -OA_ERR_NOT_READABLE;
+		}
+		ret = _parseFITS ( m, length, &info );
+		munmap ( m, length );
+		if ( ret != OA_ERR_NONE ) {
+			return ret;
+		}
+		source->width = info.width;
+		source->height = info.height;
+		source->format = _fitsFormat ( &info );
+#if HAVE_LIBPNG
+	} else {
+		if (( ret = _readPNG ( source, 0, 0 )) != OA_ERR_NONE ) {
+			return ret;
+		}
+#endif
+	}
+	source->frameSize = ( size_t ) source->width * source->height *
+			oaFrameFormats[ source->format ].bytesPerPixel;
+	return OA_ERR_NONE;
+}
+
+
+int
+oacamReplayOpen ( REPLAY_SOURCE* source, const char* path )
+{
+	const char*		dot;
+	int						ret;
+
+	memset ( source, 0, sizeof ( REPLAY_SOURCE ));
+	dot = strrchr ( path, '.' );
+	if ( dot && !strcasecmp ( dot, ".ser" )) {
+		source->type = REPLAY_SOURCE_SER;
+		ret = _openSER ( source, path );
+	} else {
+		ret = _openSequence ( source, path );
+	}
+	if ( ret != OA_ERR_NONE ) {
+		oacamReplayClose ( source );
+	}
+	return ret;
+}
+
+
+void
+oacamReplayClose ( REPLAY_SOURCE* source )
+{
+	unsigned int		i;
+
+	if ( source->map ) {
+		munmap ( source->map, source->mapLength );
+	}
+	if ( source->files ) {
+		for ( i = 0; i < source->numFrames; i++ ) {
+			free (( void* ) source->files[i] );
+		}
+		free (( void* ) source->files );
+	}
+	memset ( source, 0, sizeof ( REPLAY_SOURCE ));
+}
+
+
+int
+oacamReplayNeedsBuffers ( REPLAY_SOURCE* source )
+{
+	return ( source->type != REPLAY_SOURCE_SER );
+}
+
+
+uint64_t
+oacamReplayFrameTime ( REPLAY_SOURCE* source, unsigned int n )
+{
+	uint64_t		t = 0;
+	int64_t			ticks;
+
+	switch ( source->type ) {
+		case REPLAY_SOURCE_SER:
+			if ( source->timestamps ) {
+				ticks = _le64 ( source->timestamps + n * 8 );
+				if ( ticks > SER_EPOCH_TICKS ) {
+					t = ( ticks - SER_EPOCH_TICKS ) * 100;
+				}
+			}
+			break;
+		case REPLAY_SOURCE_FITS:
+			( void ) _readFITS ( source, n, 0, &t );
+			break;
+	}
+	return t;
+}
+
+
+int
+oacamReplayReadFrame ( REPLAY_SOURCE* source, unsigned int n, void* buffer,
+		void** data )
+{
+	int		ret = -OA_ERR_UNSUPPORTED_FORMAT;
+
+	if ( n >= source->numFrames ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	switch ( source->type ) {
+		case REPLAY_SOURCE_SER:
+			*data = source->frames + n * source->frameSize;
+			return OA_ERR_NONE;
+		case REPLAY_SOURCE_FITS:
+			ret = _readFITS ( source, n, buffer, 0 );
+			break;
+#if HAVE_LIBPNG
+		case REPLAY_SOURCE_PNG:
+			ret = _readPNG ( source, n, buffer );
+			break;
+#endif
+	}
+	if ( OA_ERR_NONE == ret ) {
+		*data = buffer;
+	}
+	return ret;
+}
@@ -0,0 +1,65 @@
+/*****************************************************************************
+ *
+ * replaySource.h -- SER, FITS and PNG frame sources for replay cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_REPLAY_SOURCE_H
+#define OA_REPLAY_SOURCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define	REPLAY_SOURCE_SER		1
+#define	REPLAY_SOURCE_FITS	2
+#define	REPLAY_SOURCE_PNG		3
+
+typedef struct REPLAY_SOURCE {
+	int							type;
+	unsigned int		width;
+	unsigned int		height;
+	int							format;
+	size_t					frameSize;
+	unsigned int		numFrames;
+	// SER files are mapped whole and frames handed out from the mapping
+	unsigned char*	map;
+	size_t					mapLength;
+	unsigned char*	frames;
+	unsigned char*	timestamps;
+	// image sequences, one frame per file
+	char**					files;
+} REPLAY_SOURCE;
+
+// oacamReplayReadFrame() sets *data to the frame, which is either in the
+// SER mapping (and stays valid until the source is closed) or decoded
+// into the buffer passed, which must be frameSize bytes.  Timestamps are
+// in nanoseconds on the recording's own clock, and 0 when unknown.
+
+extern int		oacamReplayOpen ( REPLAY_SOURCE*, const char* );
+extern void		oacamReplayClose ( REPLAY_SOURCE* );
+extern int		oacamReplayNeedsBuffers ( REPLAY_SOURCE* );
+extern uint64_t	oacamReplayFrameTime ( REPLAY_SOURCE*, unsigned int );
+extern int		oacamReplayReadFrame ( REPLAY_SOURCE*, unsigned int, void*,
+									void** );
+
+#endif	/* OA_REPLAY_SOURCE_H */
@@ -0,0 +1,211 @@
+/*****************************************************************************
+ *
+ * replayconnect.c -- Initialise replay cameras
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+#include <openastro/video/formats.h>
+
+#include "oacamprivate.h"
+#include "unimplemented.h"
+#include "replayoacam.h"
+#include "replaystate.h"
+
+
+static void _replayInitFunctionPointers ( oaCamera* );
+
+/**
+ * Initialise a given camera device
+ */
+
+oaCamera*
+oaReplayInitCamera ( oaCameraDevice* device )
+{
+  oaCamera*		camera;
+  DEVICE_INFO*		devInfo;
+  REPLAY_STATE*		cameraInfo;
+  COMMON_INFO*		commonInfo;
+  size_t		bufferSize;
+
+	oaLogInfo ( OA_LOG_CAMERA, "%s ( %p ): entered", __func__, device );
+
+  if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
+      sizeof ( REPLAY_STATE ), &commonInfo ) != OA_ERR_NONE ) {
+    return 0;
+  }
+
+  ( void ) strcpy ( camera->deviceName, device->deviceName );
+  cameraInfo->initialised = 0;
+  devInfo = device->_private;
+
+  camera->interface = device->interface;
+  cameraInfo->index = devInfo->devIndex;
+  cameraInfo->cameraType = devInfo->devType;
+
+  OA_CLEAR ( camera->controlType );
+  OA_CLEAR ( camera->features );
+
+  _replayInitFunctionPointers ( camera );
+
+  cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
+
+  if ( oacamReplayOpen ( &cameraInfo->source, devInfo->sysPath ) !=
+      OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: can't replay %s", __func__,
+        devInfo->sysPath );
+    FREE_DATA_STRUCTS;
+    return 0;
+  }
+  oacamReplayGetOptions ( &cameraInfo->replayFlags, &cameraInfo->frameRate );
+
+  // The recording fixes everything, so the only control is the (single)
+  // frame format
+  camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_FRAME_FORMAT ) = OA_CTRL_TYPE_DISCRETE;
+  camera->frameFormats[ cameraInfo->source.format ] = 1;
+  if ( oaFrameFormats[ cameraInfo->source.format ].rawColour ) {
+    camera->features.flags |= OA_CAM_FEATURE_RAW_MODE;
+  }
+  camera->features.flags |= OA_CAM_FEATURE_STREAMING;
+  camera->features.flags |= OA_CAM_FEATURE_FIXED_FRAME_SIZES;
+
+  cameraInfo->maxResolutionX = cameraInfo->xSize = cameraInfo->source.width;
+  cameraInfo->maxResolutionY = cameraInfo->ySize = cameraInfo->source.height;
+  if (!( cameraInfo->frameSizes[1].sizes =
+      ( FRAMESIZE* ) malloc ( sizeof ( FRAMESIZE )))) {
+    oaLogError ( OA_LOG_CAMERA, "%s: malloc ( FRAMESIZE ) failed", __func__ );
+    oacamReplayClose ( &cameraInfo->source );
+    FREE_DATA_STRUCTS;
+    return 0;
+  }
+  cameraInfo->frameSizes[1].sizes[0].x = cameraInfo->source.width;
+  cameraInfo->frameSizes[1].sizes[0].y = cameraInfo->source.height;
+  cameraInfo->frameSizes[1].numSizes = 1;
+
+  // SER frames are handed out straight from the mapping, so the pool only
+  // needs memory for formats that have to be decoded
+  cameraInfo->imageBufferLength = cameraInfo->source.frameSize;
+  bufferSize = oacamReplayNeedsBuffers ( &cameraInfo->source ) ?
+      cameraInfo->source.frameSize : 0;
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo, bufferSize ) !=
+      OA_ERR_NONE ) {
+    free (( void* ) cameraInfo->frameSizes[1].sizes );
+    oacamReplayClose ( &cameraInfo->source );
+    FREE_DATA_STRUCTS;
+    return 0;
+  }
+
+  cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
+  cameraInfo->commandQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
+      oacamReplayController, ( void* ) camera )) {
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
+    free (( void* ) cameraInfo->frameSizes[1].sizes );
+    oacamReplayClose ( &cameraInfo->source );
+    oaDLListDelete ( cameraInfo->commandQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
+    FREE_DATA_STRUCTS;
+    return 0;
+  }
+
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
+      oacamReplayCallbackHandler, ( void* ) camera )) {
+
+    void* dummy;
+    cameraInfo->stopControllerThread = 1;
+    pthread_cond_broadcast ( &cameraInfo->commandQueued );
+    pthread_join ( cameraInfo->controllerThread, &dummy );
+
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
+    free (( void* ) cameraInfo->frameSizes[1].sizes );
+    oacamReplayClose ( &cameraInfo->source );
+    oaDLListDelete ( cameraInfo->commandQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
+    FREE_DATA_STRUCTS;
+    return 0;
+  }
+
+	oaLogInfo ( OA_LOG_CAMERA, "%s: exiting", __func__ );
+
+  return camera;
+}
+
+
+static void
+_replayInitFunctionPointers ( oaCamera* camera )
+{
+  camera->funcs.initCamera = oaReplayInitCamera;
+  camera->funcs.closeCamera = oaReplayCloseCamera;
+
+  camera->funcs.testControl = oaReplayCameraTestControl;
+  camera->funcs.getControlRange = oaReplayCameraGetControlRange;
+
+  camera->funcs.enumerateFrameSizes = oaReplayCameraGetFrameSizes;
+  camera->funcs.getFramePixelFormat = oaReplayCameraGetFramePixelFormat;
+}
+
+
+int
+oaReplayCloseCamera ( oaCamera* camera )
+{
+  void*		dummy;
+  REPLAY_STATE*	cameraInfo;
+
+  if ( camera ) {
+
+    cameraInfo = camera->_private;
+
+    cameraInfo->stopControllerThread = 1;
+    pthread_cond_broadcast ( &cameraInfo->commandQueued );
+    pthread_join ( cameraInfo->controllerThread, &dummy );
+
+    cameraInfo->stopCallbackThread = 1;
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
+    pthread_join ( cameraInfo->callbackThread, &dummy );
+
+    // Only unmapped once nothing can still be looking at a frame
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
+    free (( void* ) cameraInfo->frameSizes[1].sizes );
+    oacamReplayClose ( &cameraInfo->source );
+
+    oaDLListDelete ( cameraInfo->commandQueue, 1 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
+
+    free (( void* ) cameraInfo );
+    free (( void* ) camera->_common );
+    free (( void* ) camera );
+
+  } else {
+   return -OA_ERR_INVALID_CAMERA;
+  }
+  return OA_ERR_NONE;
+}
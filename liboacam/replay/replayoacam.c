@@ -0,0 +1,181 @@
+/*****************************************************************************
+ *
+ * replayoacam.c -- Replay camera source list and enumeration
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "unimplemented.h"
+#include "oacamprivate.h"
+#include "replayoacam.h"
+
+
+static pthread_mutex_t	sourceMutex = PTHREAD_MUTEX_INITIALIZER;
+static char*						sources[ OA_REPLAY_MAX_SOURCES ];
+static unsigned int			numSources = 0;
+static unsigned int			replayFlags = 0;
+static double						replayFrameRate = 0;
+
+
+int
+oaAddReplaySource ( const char* path )
+{
+	struct stat		st;
+	char*					copy;
+
+	if ( !path || stat ( path, &st )) {
+		return -OA_ERR_NOT_READABLE;
+	}
+	if (!( copy = strdup ( path ))) {
+		return -OA_ERR_MEM_ALLOC;
+	}
+	pthread_mutex_lock ( &sourceMutex );
+	if ( numSources == OA_REPLAY_MAX_SOURCES ) {
+		pthread_mutex_unlock ( &sourceMutex );
+		free (( void* ) copy );
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	sources[ numSources++ ] = copy;
+	pthread_mutex_unlock ( &sourceMutex );
+
+	// A cached enumeration wouldn't include the new camera
+	oaFlushCameraCache();
+	return OA_ERR_NONE;
+}
+
+
+void
+oaClearReplaySources ( void )
+{
+	unsigned int		i;
+
+	pthread_mutex_lock ( &sourceMutex );
+	for ( i = 0; i < numSources; i++ ) {
+		free (( void* ) sources[i] );
+		sources[i] = 0;
+	}
+	numSources = 0;
+	pthread_mutex_unlock ( &sourceMutex );
+	oaFlushCameraCache();
+}
+
+
+int
+oaSetReplayOptions ( unsigned int flags, double frameRate )
+{
+	if (( flags & ~( OA_REPLAY_MAX_RATE | OA_REPLAY_LOOP )) ||
+			frameRate < 0 ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	pthread_mutex_lock ( &sourceMutex );
+	replayFlags = flags;
+	replayFrameRate = frameRate;
+	pthread_mutex_unlock ( &sourceMutex );
+	return OA_ERR_NONE;
+}
+
+
+void
+oaGetReplayOptions ( unsigned int* flags, double* frameRate )
+{
+	pthread_mutex_lock ( &sourceMutex );
+	if ( flags ) {
+		*flags = replayFlags;
+	}
+	if ( frameRate ) {
+		*frameRate = replayFrameRate;
+	}
+	pthread_mutex_unlock ( &sourceMutex );
+}
+
+
+void
+oacamReplayGetOptions ( unsigned int* flags, double* frameRate )
+{
+	oaGetReplayOptions ( flags, frameRate );
+}
+
+
+int
+oaReplayGetCameras ( CAMERA_LIST* deviceList, unsigned long featureFlags,
+		int flags )
+{
+	unsigned int		i, found = 0;
+	int							ret;
+	oaCameraDevice*	dev;
+	DEVICE_INFO*		_private;
+	const char*			name;
+
+	pthread_mutex_lock ( &sourceMutex );
+	for ( i = 0; i < numSources; i++ ) {
+		if (!( dev = malloc ( sizeof ( oaCameraDevice )))) {
+			pthread_mutex_unlock ( &sourceMutex );
+			return -OA_ERR_MEM_ALLOC;
+		}
+		if (!( _private = malloc ( sizeof ( DEVICE_INFO )))) {
+			( void ) free (( void* ) dev );
+			pthread_mutex_unlock ( &sourceMutex );
+			return -OA_ERR_MEM_ALLOC;
+		}
+		oaLogDebug ( OA_LOG_CAMERA, "%s: allocated @ %p for camera device",
+				__func__, dev );
+		_oaInitCameraDeviceFunctionPointers ( dev );
+		dev->interface = OA_CAM_IF_REPLAY;
+		dev->_private = _private;
+		dev->initCamera = oaReplayInitCamera;
+
+		// Strip any trailing slash from a directory before taking its name
+		name = sources[i] + strlen ( sources[i] );
+		while ( name > sources[i] + 1 && name[-1] == '/' ) {
+			name--;
+		}
+		while ( name > sources[i] && name[-1] != '/' ) {
+			name--;
+		}
+		( void ) snprintf ( dev->deviceName, OA_MAX_NAME_LEN + 1,
+				"Replay: %s", name );
+		_private->devType = 0;
+		_private->devIndex = i;
+		( void ) strncpy ( _private->sysPath, sources[i], PATH_MAX );
+		_private->sysPath[ PATH_MAX ] = 0;
+
+		if (( ret = _oaCheckCameraArraySize ( deviceList )) < 0 ) {
+			( void ) free (( void* ) dev );
+			( void ) free (( void* ) _private );
+			pthread_mutex_unlock ( &sourceMutex );
+			return ret;
+		}
+		deviceList->cameraList[ deviceList->numCameras++ ] = dev;
+		found++;
+	}
+	pthread_mutex_unlock ( &sourceMutex );
+
+	return found;
+}
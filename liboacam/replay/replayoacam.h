@@ -0,0 +1,47 @@
+/*****************************************************************************
+ *
+ * replayoacam.h -- header for replay camera driver
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef REPLAY_OACAM_H
+#define REPLAY_OACAM_H
+
+extern int		oaReplayGetCameras ( CAMERA_LIST*, unsigned long, int );
+extern oaCamera*	oaReplayInitCamera ( oaCameraDevice* );
+extern int		oaReplayCloseCamera ( oaCamera* );
+
+extern int		oaReplayCameraTestControl ( oaCamera*, int,
+				oaControlValue* );
+extern int		oaReplayCameraGetControlRange ( oaCamera*, int,
+				int64_t*, int64_t*, int64_t*, int64_t* );
+
+extern void*		oacamReplayController ( void* );
+extern void*		oacamReplayCallbackHandler ( void* );
+
+extern const FRAMESIZES*	oaReplayCameraGetFrameSizes ( oaCamera* );
+extern int		oaReplayCameraGetFramePixelFormat ( oaCamera* );
+
+extern void		oacamReplayGetOptions ( unsigned int*, double* );
+
+#endif	/* REPLAY_OACAM_H */
@@ -0,0 +1,53 @@
+/*****************************************************************************
+ *
+ * replaystate.h -- Replay camera state header
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_REPLAY_STATE_H
+#define OA_REPLAY_STATE_H
+
+#include <openastro/util.h>
+
+#include "sharedState.h"
+#include "replaySource.h"
+
+
+typedef struct REPLAY_STATE {
+
+#include "sharedDecs.h"
+
+	REPLAY_SOURCE		source;
+	unsigned int		replayFlags;
+	double			frameRate;
+	// playback position
+	unsigned int		currentFrame;
+	int			paced;
+	int			atEnd;
+	uint64_t		nextFrameTime;
+	// wall clock and recording times of the frame pacing started from
+	uint64_t		wallBase;
+	uint64_t		recordedBase;
+} REPLAY_STATE;
+
+#endif	/* OA_REPLAY_STATE_H */
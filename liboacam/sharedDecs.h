@@ -40,8 +40,7 @@
   int								stopControllerThread;
   pthread_t					callbackThread;
   pthread_mutex_t		callbackQueueMutex;
-  pthread_cond_t		callbackQueued;
-  CALLBACK					frameCallbacks[ OA_CAM_BUFFERS ];
+  CALLBACK					frameCallbacks[ OA_CAM_MAX_BUFFERS ];
   int								stopCallbackThread;
 	pthread_t					timerThread;
 	pthread_cond_t		timerState;
@@ -51,17 +50,34 @@
 	int								timerActive;
   // queues for controls and callbacks
   DL_LIST						commandQueue;
-  DL_LIST						callbackQueue;
+  CALLBACK_RING			callbackRing;
+  OA_ASYNC_CONTROLS	asyncControls;
+  OA_CONTROL_CACHE	controlCache;
+  OA_SOFT_BINNING	softBinning;
+  OA_EXPOSURE_SEQUENCE	exposureSequence;
+  OA_RECONNECT		reconnect;
+  OA_BANDWIDTH_TUNER	bandwidthTuner;
+  // what each of the library's layers calls on to
+  oaCameraFuncs			hookNext[ OA_HOOK_COUNT ];
   // streaming
   CALLBACK					streamingCallback;
+  OA_FRAME_LEASES		frameLeases;
 	int								exposureInProgress;
 	int								abortExposure;
 	// shared buffer config
+  frameBuffer*			buffers;
+  OA_BUFFER_POOL		bufferPool;
+  OA_PARKED_BUFFERS*	parkedBuffers;
   int								configuredBuffers;
   unsigned char*		xferBuffer;
   unsigned int			imageBufferLength;
   int								nextBuffer;
   int								buffersFree;
+	// per-frame metadata
+	FRAME_METADATA		frameMetadata[ OA_CAM_MAX_BUFFERS ];
+	uint64_t					frameSequence;
+	unsigned int			framesDropped;
+	OA_CAMERA_STATS		stats;
 	// common image config
   unsigned int			maxResolutionX;
   unsigned int			maxResolutionY;
@@ -32,6 +32,19 @@
 
 #include <openastro/camera.h>
 
+#include "callbackRing.h"
+#include "bufferPool.h"
+#include "frameLease.h"
+#include "frameMetadata.h"
+#include "cameraStats.h"
+#include "asyncControl.h"
+#include "controlCache.h"
+#include "softBinning.h"
+#include "exposureSequence.h"
+#include "reconnect.h"
+#include "bandwidthTuner.h"
+#include "cameraHooks.h"
+
 
 typedef struct FRAME_BUFFER {
 	void*			start;
@@ -0,0 +1,559 @@
+/*****************************************************************************
+ *
+ * softBinning.c -- emulated binning for cameras that can't bin
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <openastro/camera.h>
+#include <openastro/errno.h>
+#include <openastro/util.h>
+#include <openastro/video.h>
+#include <openastro/video/formats.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "softBinning.h"
+
+
+static int64_t		binModes[] = { OA_BIN_MODE_NONE, OA_BIN_MODE_2x2,
+											OA_BIN_MODE_3x3, OA_BIN_MODE_4x4 };
+
+
+void
+oacamSoftBinningInit ( SHARED_STATE* cameraInfo )
+{
+	OA_CLEAR ( cameraInfo->softBinning );
+	cameraInfo->softBinning.factor = 1;
+	pthread_mutex_init ( &cameraInfo->softBinning.sizesMutex, 0 );
+}
+
+
+static OA_SOFT_BINNING*
+_binning ( oaCamera* camera )
+{
+	return &(( SHARED_STATE* ) camera->_private )->softBinning;
+}
+
+
+static const oaCameraFuncs*
+_next ( oaCamera* camera )
+{
+	return oacamHookNext ( camera, OA_HOOK_SOFT_BINNING );
+}
+
+
+// Until binning is enabled every call just goes straight through
+
+static int
+_enabled ( OA_SOFT_BINNING* binning )
+{
+	return __atomic_load_n ( &binning->enabled, __ATOMIC_ACQUIRE );
+}
+
+
+// ...and the binning control only exists while the format can be binned
+
+static int
+_binnable ( OA_SOFT_BINNING* binning )
+{
+	return _enabled ( binning ) &&
+			__atomic_load_n ( &binning->available, __ATOMIC_ACQUIRE );
+}
+
+
+/*
+ * Offer or withdraw the binning control to suit the camera's current
+ * frame format.  Binning is switched off when the format changes to one
+ * that can't be binned, so it isn't left on waiting for the format to
+ * change back.
+ */
+
+static void
+_checkFormat ( oaCamera* camera, OA_SOFT_BINNING* binning )
+{
+	oaControlValue	val;
+	int							available;
+
+	available = oaCanBinFormat ( _next ( camera )->getFramePixelFormat (
+			camera ));
+	if ( !available && __atomic_exchange_n ( &binning->factor, 1,
+			__ATOMIC_ACQ_REL ) > 1 ) {
+		val.valueType = OA_CTRL_TYPE_DISCRETE;
+		val.discrete = OA_BIN_MODE_NONE;
+		oacamControlCacheStore ( camera->_private, OA_CAM_CTRL_BINNING, &val );
+	}
+	camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_BINNING ) = available ?
+			OA_CTRL_TYPE_DISCRETE : 0;
+	__atomic_store_n ( &binning->available, available, __ATOMIC_RELEASE );
+}
+
+
+static int
+_binnedSize ( int format, unsigned int factor, unsigned int width,
+		unsigned int height, unsigned int* binnedWidth,
+		unsigned int* binnedHeight )
+{
+	oaImage		image;
+
+	image.data = 0;
+	image.width = width;
+	image.height = height;
+	image.stride = 0;
+	image.format = format;
+	image.originX = image.originY = 0;
+	return oaBinnedImageSize ( &image, factor, binnedWidth, binnedHeight );
+}
+
+
+static void*
+_binFrame ( OA_SOFT_BINNING* binning, void* buffer, int* length )
+{
+	oaImage				source, target;
+	unsigned int	factor, width, height, bpp;
+
+	factor = __atomic_load_n ( &binning->factor, __ATOMIC_ACQUIRE );
+	if ( factor < 2 ) {
+		return buffer;
+	}
+
+	// The application has been told to expect binned frames, so anything
+	// that isn't the whole unbinned frame (eg. a short read) can't be passed
+	// on as it is.  It goes through with no length, as a dropped frame.
+
+	bpp = oaFrameFormats[ binning->format ].bytesPerPixel;
+	if ( !oaCanBinFormat ( binning->format ) ||
+			*length != ( int ) ( binning->width * binning->height * bpp ) ||
+			_binnedSize ( binning->format, factor, binning->width,
+			binning->height, &width, &height ) < 0 ) {
+		*length = 0;
+		return buffer;
+	}
+	( void ) oaImageInit ( &source, buffer, binning->width, binning->height,
+			binning->format );
+	( void ) oaImageInit ( &target, buffer, width, height, binning->format );
+	*length = ( oaBinImage ( &source, &target, factor, binning->mode ) ==
+			OA_ERR_NONE ) ? ( int ) ( width * height * bpp ) : 0;
+	return buffer;
+}
+
+
+static void*
+_binnedCallback ( void* arg, void* buffer, int length, void* metadata )
+{
+	OA_SOFT_BINNING*	binning = arg;
+	void*							( *callback )( void*, void*, int, void* );
+
+	buffer = _binFrame ( binning, buffer, &length );
+	callback = binning->callback.callback;
+	return callback ( binning->callback.callbackArg, buffer, length, metadata );
+}
+
+
+static void*
+_binnedLeasedCallback ( void* arg, oaFrameLease* lease )
+{
+	OA_SOFT_BINNING*	binning = arg;
+
+	lease->buffer = _binFrame ( binning, lease->buffer, &lease->length );
+	return binning->leasedCallback ( binning->leasedCallbackArg, lease );
+}
+
+
+static int
+_startStreaming ( oaCamera* camera,
+		void* ( *callback )( void*, void*, int, void* ), void* callbackArg )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+
+	if ( !_enabled ( binning )) {
+		return _next ( camera )->startStreaming ( camera, callback, callbackArg );
+	}
+	_checkFormat ( camera, binning );
+	binning->format = _next ( camera )->getFramePixelFormat ( camera );
+	binning->callback.callback = callback;
+	binning->callback.callbackArg = callbackArg;
+	return _next ( camera )->startStreaming ( camera, _binnedCallback, binning );
+}
+
+
+static int
+_startStreamingLeased ( oaCamera* camera,
+		void* ( *callback )( void*, oaFrameLease* ), void* callbackArg )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+
+	if ( !_enabled ( binning )) {
+		return _next ( camera )->startStreamingLeased ( camera, callback,
+				callbackArg );
+	}
+	_checkFormat ( camera, binning );
+	binning->format = _next ( camera )->getFramePixelFormat ( camera );
+	binning->leasedCallback = callback;
+	binning->leasedCallbackArg = callbackArg;
+	return _next ( camera )->startStreamingLeased ( camera,
+			_binnedLeasedCallback, binning );
+}
+
+
+static int
+_startExposure ( oaCamera* camera,
+		void* ( *callback )( void*, void*, int, void* ), void* callbackArg )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+
+	if ( !_enabled ( binning )) {
+		return _next ( camera )->startExposure ( camera, callback, callbackArg );
+	}
+	_checkFormat ( camera, binning );
+	binning->format = _next ( camera )->getFramePixelFormat ( camera );
+	binning->callback.callback = callback;
+	binning->callback.callbackArg = callbackArg;
+	return _next ( camera )->startExposure ( camera, _binnedCallback, binning );
+}
+
+
+static int
+_checkBinMode ( oaControlValue* val )
+{
+	if ( val->valueType != OA_CTRL_TYPE_DISCRETE ) {
+		return -OA_ERR_INVALID_CONTROL_TYPE;
+	}
+	if ( val->discrete < OA_BIN_MODE_NONE || val->discrete > OA_BIN_MODE_4x4 ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	return OA_ERR_NONE;
+}
+
+
+static int
+_setControl ( oaCamera* camera, int control, oaControlValue* val,
+		int dontWait )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+	int								ret;
+
+	// Any control might change the frame format (the frame format control
+	// itself, obviously, but on some cameras bit depth or colour mode too),
+	// so it is checked again after each one
+
+	if ( control != OA_CAM_CTRL_BINNING || !_binnable ( binning )) {
+		ret = _next ( camera )->setControl ( camera, control, val, dontWait );
+		if ( ret == OA_ERR_NONE && control != OA_CAM_CTRL_BINNING &&
+				_enabled ( binning )) {
+			_checkFormat ( camera, binning );
+		}
+		return ret;
+	}
+	if (( ret = _checkBinMode ( val )) == OA_ERR_NONE ) {
+		__atomic_store_n ( &binning->factor,
+				OA_BIN_MODE_MULTIPLIER( val->discrete ), __ATOMIC_RELEASE );
+		oacamControlCacheStore ( camera->_private, control, val );
+	}
+	return ret;
+}
+
+
+static int
+_readControl ( oaCamera* camera, int control, oaControlValue* val )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+
+	if ( control != OA_CAM_CTRL_BINNING || !_binnable ( binning )) {
+		return _next ( camera )->readControl ( camera, control, val );
+	}
+	val->valueType = OA_CTRL_TYPE_DISCRETE;
+	val->discrete = __atomic_load_n ( &binning->factor, __ATOMIC_ACQUIRE );
+	return OA_ERR_NONE;
+}
+
+
+static int
+_testControl ( oaCamera* camera, int control, oaControlValue* val )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+
+	if ( control != OA_CAM_CTRL_BINNING || !_binnable ( binning )) {
+		return _next ( camera )->testControl ( camera, control, val );
+	}
+	return _checkBinMode ( val );
+}
+
+
+static int
+_getControlDiscreteSet ( oaCamera* camera, int control, int32_t* count,
+		int64_t** values )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+
+	if ( control != OA_CAM_CTRL_BINNING || !_binnable ( binning )) {
+		return _next ( camera )->getControlDiscreteSet ( camera, control, count,
+				values );
+	}
+	*count = sizeof ( binModes ) / sizeof ( binModes[0] );
+	*values = binModes;
+	return OA_ERR_NONE;
+}
+
+
+static void
+_binnedListSize ( const FRAMESIZE* full, int format, unsigned int factor,
+		unsigned int* x, unsigned int* y )
+{
+	if ( _binnedSize ( format, factor, full->x, full->y, x, y ) < 0 ) {
+		*x = full->x / factor;
+		*y = full->y / factor;
+	}
+}
+
+
+static int
+_sameSizes ( const FRAMESIZES* full, int format, unsigned int factor,
+		const OA_BINNED_SIZES* binned )
+{
+	unsigned int	i, x, y;
+
+	if ( binned->from != full || binned->format != format ||
+			binned->factor != factor ||
+			binned->sizes.numSizes != full->numSizes ) {
+		return 0;
+	}
+	for ( i = 0; i < full->numSizes; i++ ) {
+		_binnedListSize ( &full->sizes[i], format, factor, &x, &y );
+		if ( binned->sizes.sizes[i].x != x || binned->sizes.sizes[i].y != y ) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+
+static const FRAMESIZES*
+_enumerateFrameSizes ( oaCamera* camera )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+	const FRAMESIZES*	full;
+	OA_BINNED_SIZES*	binned;
+	FRAMESIZE*				sizes = 0;
+	unsigned int			factor, i;
+	int								format;
+
+	full = _next ( camera )->enumerateFrameSizes ( camera );
+	factor = __atomic_load_n ( &binning->factor, __ATOMIC_ACQUIRE );
+	if ( factor < 2 || !full ) {
+		return full;
+	}
+	format = _next ( camera )->getFramePixelFormat ( camera );
+
+	// The driver may rebuild its list in place when the format changes, so
+	// a list is only reused if it still matches what the driver offers
+
+	pthread_mutex_lock ( &binning->sizesMutex );
+	for ( binned = binning->binnedSizes; binned; binned = binned->next ) {
+		if ( _sameSizes ( full, format, factor, binned )) {
+			pthread_mutex_unlock ( &binning->sizesMutex );
+			return &binned->sizes;
+		}
+	}
+	if (!( binned = malloc ( sizeof ( OA_BINNED_SIZES ))) ||
+			( full->numSizes && !( sizes = malloc ( full->numSizes *
+			sizeof ( FRAMESIZE ))))) {
+		pthread_mutex_unlock ( &binning->sizesMutex );
+		free (( void* ) binned );
+		oaLogError ( OA_LOG_CAMERA, "%s: malloc failed", __func__ );
+		return full;
+	}
+	for ( i = 0; i < full->numSizes; i++ ) {
+		_binnedListSize ( &full->sizes[i], format, factor, &sizes[i].x,
+				&sizes[i].y );
+	}
+	binned->from = full;
+	binned->format = format;
+	binned->factor = factor;
+	binned->sizes.numSizes = full->numSizes;
+	binned->sizes.sizes = sizes;
+	binned->next = binning->binnedSizes;
+	binning->binnedSizes = binned;
+	pthread_mutex_unlock ( &binning->sizesMutex );
+	return &binned->sizes;
+}
+
+
+// Find the unbinned size that the given binned size was made from, so
+// raw colour sizes that lost a partial CFA cell map back to the size the
+// driver actually offers
+
+static void
+_unbinnedSize ( oaCamera* camera, unsigned int factor, int* x, int* y )
+{
+	const FRAMESIZES*	full;
+	unsigned int			i, bx, by;
+	int								format;
+
+	full = _next ( camera )->enumerateFrameSizes ( camera );
+	format = _next ( camera )->getFramePixelFormat ( camera );
+	for ( i = 0; full && i < full->numSizes; i++ ) {
+		if ( _binnedSize ( format, factor, full->sizes[i].x, full->sizes[i].y,
+				&bx, &by ) == OA_ERR_NONE && ( int ) bx == *x &&
+				( int ) by == *y ) {
+			*x = full->sizes[i].x;
+			*y = full->sizes[i].y;
+			return;
+		}
+	}
+	*x *= factor;
+	*y *= factor;
+}
+
+
+static int
+_setResolution ( oaCamera* camera, int x, int y )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+	unsigned int			factor;
+	int								ret;
+
+	if ( !_enabled ( binning )) {
+		return _next ( camera )->setResolution ( camera, x, y );
+	}
+	factor = __atomic_load_n ( &binning->factor, __ATOMIC_ACQUIRE );
+	if ( factor > 1 ) {
+		_unbinnedSize ( camera, factor, &x, &y );
+	}
+	if (( ret = _next ( camera )->setResolution ( camera, x, y )) ==
+			OA_ERR_NONE ) {
+		binning->width = x;
+		binning->height = y;
+	}
+	return ret;
+}
+
+
+static int
+_setROI ( oaCamera* camera, int x, int y )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+	unsigned int			factor;
+	int								ret;
+
+	if ( !_enabled ( binning )) {
+		return _next ( camera )->setROI ( camera, x, y );
+	}
+	factor = __atomic_load_n ( &binning->factor, __ATOMIC_ACQUIRE );
+	x *= factor;
+	y *= factor;
+	if (( ret = _next ( camera )->setROI ( camera, x, y )) == OA_ERR_NONE ) {
+		binning->width = x;
+		binning->height = y;
+	}
+	return ret;
+}
+
+
+static int
+_testROISize ( oaCamera* camera, unsigned int x, unsigned int y,
+		unsigned int* suggX, unsigned int* suggY )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+	unsigned int			factor;
+	int								ret;
+
+	if ( !_enabled ( binning )) {
+		return _next ( camera )->testROISize ( camera, x, y, suggX, suggY );
+	}
+	factor = __atomic_load_n ( &binning->factor, __ATOMIC_ACQUIRE );
+	ret = _next ( camera )->testROISize ( camera, x * factor, y * factor,
+			suggX, suggY );
+	if ( ret != OA_ERR_NONE ) {
+		*suggX /= factor;
+		*suggY /= factor;
+	}
+	return ret;
+}
+
+
+static int
+_closeCamera ( oaCamera* camera )
+{
+	OA_SOFT_BINNING*	binning = _binning ( camera );
+	OA_BINNED_SIZES*	binned;
+
+	while (( binned = binning->binnedSizes )) {
+		binning->binnedSizes = binned->next;
+		free (( void* ) binned->sizes.sizes );
+		free (( void* ) binned );
+	}
+	pthread_mutex_destroy ( &binning->sizesMutex );
+	return _next ( camera )->closeCamera ( camera );
+}
+
+
+const oaCameraFuncs	oacamSoftBinningHooks = {
+	.closeCamera = _closeCamera,
+	.readControl = _readControl,
+	.setControl = _setControl,
+	.testControl = _testControl,
+	.getControlDiscreteSet = _getControlDiscreteSet,
+	.enumerateFrameSizes = _enumerateFrameSizes,
+	.setResolution = _setResolution,
+	.setROI = _setROI,
+	.testROISize = _testROISize,
+	.startStreaming = _startStreaming,
+	.startStreamingLeased = _startStreamingLeased,
+	.startExposure = _startExposure
+};
+
+
+int
+oaEnableSoftwareBinning ( oaCamera* camera, int mode )
+{
+	SHARED_STATE*			cameraInfo;
+	OA_SOFT_BINNING*	binning;
+
+	if ( !camera ) {
+		return -OA_ERR_INVALID_CAMERA;
+	}
+	if ( mode != OA_BIN_SUM && mode != OA_BIN_AVERAGE ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	cameraInfo = camera->_private;
+	binning = &cameraInfo->softBinning;
+
+	if ( binning->enabled ) {
+		binning->mode = mode;
+		return OA_ERR_NONE;
+	}
+	if ( camera->OA_CAM_CTRL_TYPE( OA_CAM_CTRL_BINNING )) {
+		return -OA_ERR_IGNORED;
+	}
+
+	binning->mode = mode;
+	binning->factor = 1;
+	binning->width = cameraInfo->xSize;
+	binning->height = cameraInfo->ySize;
+
+	_checkFormat ( camera, binning );
+	__atomic_store_n ( &binning->enabled, 1, __ATOMIC_RELEASE );
+	return OA_ERR_NONE;
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *
+ * softBinning.h -- emulated binning for cameras that can't bin
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_SOFT_BINNING_H
+#define OA_CAMERA_SOFT_BINNING_H
+
+#include <pthread.h>
+
+#include <openastro/camera.h>
+#include <openastro/controller.h>
+
+struct SHARED_STATE;
+
+// Once enabled, the binning layer over the camera functions takes over
+// the binning control and adjusts frame sizes and frame delivery.  The
+// driver always works at the full, unbinned size: the sizes offered to
+// the application are the driver's divided by the binning factor, and
+// each frame is binned in place in the driver's buffer just before it is
+// handed to the application's callback.
+
+// Binning is only offered while the frame format is one that can be
+// binned.  Binned size lists are made from the driver's list for the
+// current format and binning factor, and each is kept until the camera is
+// closed so that a list already handed to the application stays valid.
+
+typedef struct OA_BINNED_SIZES {
+	const FRAMESIZES*				from;
+	int											format;
+	unsigned int						factor;
+	FRAMESIZES							sizes;
+	struct OA_BINNED_SIZES*	next;
+} OA_BINNED_SIZES;
+
+typedef struct OA_SOFT_BINNING {
+	int								enabled;
+	int								available;
+	int								mode;
+	unsigned int			factor;
+	int								format;
+	unsigned int			width;
+	unsigned int			height;
+	OA_BINNED_SIZES*	binnedSizes;
+	pthread_mutex_t		sizesMutex;
+	CALLBACK					callback;
+	void*							( *leasedCallback )( void*, oaFrameLease* );
+	void*							leasedCallbackArg;
+} OA_SOFT_BINNING;
+
+extern void	oacamSoftBinningInit ( struct SHARED_STATE* );
+
+#endif	/* OA_CAMERA_SOFT_BINNING_H */
@@ -49,6 +49,7 @@
 extern int						_spinFormatMap[ NUM_SPIN_FORMATS ];
 
 extern int						_spinInitLibraryFunctionPointers ( void );
+extern int						_spinInitAllLibraryFunctionPointers ( void );
 
 extern SPINNAKERC_API	( *p_spinSystemGetInstance )( spinSystem* );
 extern SPINNAKERC_API	( *p_spinCameraListClear )( spinCameraList );
@@ -159,6 +160,8 @@ extern SPINNAKERC_API ( *p_spinImageIsIncomplete )( spinImage, bool8_t* );
 extern SPINNAKERC_API ( *p_spinImageGetStatus )( spinImage, spinImageStatus* );
 extern SPINNAKERC_API	( *p_spinImageGetData )( spinImage, void** );
 extern SPINNAKERC_API	( *p_spinImageGetValidPayloadSize )( spinImage, size_t* );
+extern SPINNAKERC_API	( *p_spinImageGetTimeStamp )( spinImage, uint64_t* );
+extern SPINNAKERC_API	( *p_spinImageGetFrameID )( spinImage, uint64_t* );
 
 #define SPINNAKER_MAX_BUFF_LEN	256
 
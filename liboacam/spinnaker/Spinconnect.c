@@ -97,6 +97,11 @@ oaSpinInitCamera ( oaCameraDevice* device )
 	void*							tmpPtr;
 	spinError					err;
 	int64_t						enumValue;
+	if ( _spinInitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve SDK functions", __func__ );
+		return 0;
+	}
+
 
   if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
       sizeof ( SPINNAKER_STATE ), &commonInfo ) != OA_ERR_NONE ) {
@@ -489,75 +494,57 @@ oaSpinInitCamera ( oaCameraDevice* device )
   cameraInfo->buffers = 0;
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY * cameraInfo->maxBytesPerPixel;
-  cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: calloc for buffers failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-          cameraInfo->buffers[j].start = 0;
-        }
-      }
-			( void ) ( *p_spinCameraRelease )( cameraHandle );
-			( void ) ( *p_spinSystemReleaseInstance )( systemHandle );
-			for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
-				if ( cameraInfo->frameSizes[ j ].numSizes ) {
-					free (( void* ) cameraInfo->frameSizes[ j ].sizes );
-				}
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: calloc for buffers failed", __func__ );
+		( void ) ( *p_spinCameraRelease )( cameraHandle );
+		( void ) ( *p_spinSystemReleaseInstance )( systemHandle );
+		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
+			if ( cameraInfo->frameSizes[ j ].numSizes ) {
+				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
-			FREE_DATA_STRUCTS;
-      return 0;
-    }
+		}
+		FREE_DATA_STRUCTS;
+    return 0;
   }
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
   cameraInfo->nextBuffer = 0;
-  cameraInfo->configuredBuffers = OA_CAM_BUFFERS;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamSpinController, ( void* ) camera )) {
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-      cameraInfo->buffers[j].start = 0;
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
 		}
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 		( void ) ( *p_spinCameraRelease )( cameraHandle );
 		( void ) ( *p_spinSystemReleaseInstance )( systemHandle );
     FREE_DATA_STRUCTS;
     return 0;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamSpinCallbackHandler, ( void* ) camera )) {
 
     void* dummy;
     cameraInfo->stopControllerThread = 1;
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-      cameraInfo->buffers[j].start = 0;
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 		for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
 			if ( cameraInfo->frameSizes[ j ].numSizes ) {
 				free (( void* ) cameraInfo->frameSizes[ j ].sizes );
 			}
 		}
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 		( void ) ( *p_spinCameraRelease )( cameraHandle );
 		( void ) ( *p_spinSystemReleaseInstance )( systemHandle );
     FREE_DATA_STRUCTS;
@@ -3869,16 +3856,14 @@ oaSpinCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
   
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     ( void ) ( *p_spinCameraDeInit )( cameraInfo->cameraHandle );
 		( void ) ( *p_spinCameraRelease )( cameraInfo->cameraHandle );
 		( void ) ( *p_spinSystemReleaseInstance )( cameraInfo->systemHandle );
 
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
 		//if ( cameraInfo->frameRates.numRates ) {
 		//	free (( void* ) cameraInfo->frameRates.rates );
@@ -3894,10 +3879,9 @@ oaSpinCloseCamera ( oaCamera* camera )
 		}
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
     // free (( void* ) cameraInfo->metadataBuffers );
-		free (( void* ) cameraInfo->buffers );
 		//if ( cameraInfo->triggerModes ) {
 		//	free (( void* ) cameraInfo->triggerModes );
 		//}
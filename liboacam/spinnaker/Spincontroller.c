@@ -136,6 +136,8 @@ _SpinFrameCallback ( spinImage imageData, void *ptr )
   SPINNAKER_STATE*	cameraInfo = ptr;
   int								buffersFree, nextBuffer;
   size_t						dataLength;
+	FRAME_METADATA*		metadata;
+	uint64_t					frameId;
 
 	oaLogDebug ( OA_LOG_CAMERA, "%s: entered", __func__ );
 
@@ -147,7 +149,7 @@ _SpinFrameCallback ( spinImage imageData, void *ptr )
 		}
 		oaLogError ( OA_LOG_CAMERA, "%s: incomplete image; status %d, ignoring",
 				__func__, status );
-		// FIX ME -- add dropped count?
+		OA_DROP_FRAME ( cameraInfo );
 		return;
 	}
 
@@ -165,12 +167,20 @@ _SpinFrameCallback ( spinImage imageData, void *ptr )
 
 	oaLogDebug ( OA_LOG_CAMERA, "%s: data size = %ld", __func__, dataLength );
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
   if ( buffersFree ) {
     nextBuffer = cameraInfo->nextBuffer;
+		metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
+		if (( *p_spinImageGetTimeStamp )( imageData, &metadata->hwTimestamp ) ==
+				SPINNAKER_ERR_SUCCESS ) {
+			metadata->hwTimestampValid = 1;
+		}
+		if (( *p_spinImageGetFrameID )( imageData, &frameId ) ==
+				SPINNAKER_ERR_SUCCESS ) {
+			metadata->frameCounter = frameId;
+			metadata->frameCounterValid = 1;
+		}
     ( void ) memcpy ( cameraInfo->buffers[ nextBuffer ].start, frame,
         dataLength );
     cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
@@ -181,16 +191,14 @@ _SpinFrameCallback ( spinImage imageData, void *ptr )
         cameraInfo->streamingCallback.callbackArg;
     cameraInfo->frameCallbacks[ nextBuffer ].buffer =
         cameraInfo->buffers[ nextBuffer ].start;
-    cameraInfo->frameCallbacks[ nextBuffer ].metadata = 0;
-        // &( cameraInfo->metadataBuffers[ nextBuffer ]);
+    cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
     cameraInfo->frameCallbacks[ nextBuffer ].bufferLen = dataLength;
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    oaDLListAddToTail ( cameraInfo->callbackQueue,
+    oacamCallbackRingPush ( &cameraInfo->callbackRing,
         &cameraInfo->frameCallbacks[ nextBuffer ]);
-    cameraInfo->buffersFree--;
+    OA_CLAIM_BUFFER ( cameraInfo );
     cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+  } else {
+    OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
   }
 }
 
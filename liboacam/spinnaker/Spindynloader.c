@@ -39,6 +39,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "unimplemented.h"
 #include "Spinoacam.h"
 #include "Spin.h"
@@ -137,374 +138,128 @@ SPINNAKERC_API	( *p_spinImageIsIncomplete )( spinImage, bool8_t* );
 SPINNAKERC_API	( *p_spinImageGetStatus )( spinImage, spinImageStatus* );
 SPINNAKERC_API	( *p_spinImageGetData )( spinImage, void** );
 SPINNAKERC_API	( *p_spinImageGetValidPayloadSize )( spinImage, size_t* );
+SPINNAKERC_API	( *p_spinImageGetTimeStamp )( spinImage, uint64_t* );
+SPINNAKERC_API	( *p_spinImageGetFrameID )( spinImage, uint64_t* );
 
-static void*		_getDLSym ( void*, const char* );
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( spinSystemGetInstance ),
+	OA_DL_SYM( spinSystemReleaseInstance ),
+	OA_DL_SYM( spinSystemGetCameras ),
+	OA_DL_SYM( spinSystemGetInterfaces ),
+	OA_DL_SYM( spinCameraListClear ),
+	OA_DL_SYM( spinCameraListCreateEmpty ),
+	OA_DL_SYM( spinCameraListDestroy ),
+	OA_DL_SYM( spinCameraListGet ),
+	OA_DL_SYM( spinCameraListGetSize ),
+	OA_DL_SYM( spinCameraRelease ),
+	OA_DL_SYM( spinCameraGetTLDeviceNodeMap ),
+	OA_DL_SYM( spinInterfaceListClear ),
+	OA_DL_SYM( spinInterfaceListCreateEmpty ),
+	OA_DL_SYM( spinInterfaceListDestroy ),
+	OA_DL_SYM( spinInterfaceListGet ),
+	OA_DL_SYM( spinInterfaceListGetSize ),
+	OA_DL_SYM( spinInterfaceRelease ),
+	OA_DL_SYM( spinInterfaceGetCameras ),
+	OA_DL_SYM( spinInterfaceGetTLNodeMap ),
+	OA_DL_SYM( spinNodeMapGetNode ),
+	OA_DL_SYM( spinNodeIsAvailable ),
+	OA_DL_SYM( spinNodeIsReadable ),
+	OA_DL_SYM( spinStringGetValue ),
+	OA_DL_SYM( spinIntegerGetValue ),
+	OA_DL_SYM( spinEnumerationGetCurrentEntry ),
+	OA_DL_SYM( spinEnumerationEntryGetIntValue ),
+	OA_DL_END
+};
 
-/**
- * Cycle through the list of cameras returned by the Spinnaker library
- */
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( spinNodeMapGetNumNodes ),
+	OA_DL_SYM( spinNodeMapGetNodeByIndex ),
+	OA_DL_SYM( spinNodeIsImplemented ),
+	OA_DL_SYM( spinNodeIsWritable ),
+	OA_DL_SYM( spinEnumerationEntryGetEnumValue ),
+	OA_DL_SYM( spinEnumerationSetEnumValue ),
+	OA_DL_SYM( spinEnumerationSetIntValue ),
+	OA_DL_SYM( spinEnumerationEntryGetSymbolic ),
+	OA_DL_SYM( spinCameraGetNodeMap ),
+	OA_DL_SYM( spinCameraGetNodeMap ),
+	OA_DL_SYM( spinCategoryGetNumFeatures ),
+	OA_DL_SYM( spinCategoryGetFeatureByIndex ),
+	OA_DL_SYM( spinNodeGetType ),
+	OA_DL_SYM( spinNodeGetName ),
+	OA_DL_SYM( spinNodeGetDisplayName ),
+	OA_DL_SYM( spinCameraInit ),
+	OA_DL_SYM( spinCameraDeInit ),
+	OA_DL_SYM( spinCameraGetGuiXml ),
+	OA_DL_SYM( spinEnumerationGetNumEntries ),
+	OA_DL_SYM( spinEnumerationGetEntryByIndex ),
+	OA_DL_SYM( spinEnumerationGetEntryByName ),
+	OA_DL_SYM( spinNodeToString ),
+	OA_DL_SYM( spinIntegerGetMin ),
+	OA_DL_SYM( spinIntegerGetMax ),
+	OA_DL_SYM( spinIntegerGetInc ),
+	OA_DL_SYM( spinIntegerSetValue ),
+	OA_DL_SYM( spinBooleanGetValue ),
+	OA_DL_SYM( spinBooleanSetValue ),
+	OA_DL_SYM( spinFloatGetMin ),
+	OA_DL_SYM( spinFloatGetMax ),
+	OA_DL_SYM( spinFloatGetValue ),
+	OA_DL_SYM( spinFloatSetValue ),
+	OA_DL_SYM( spinCameraBeginAcquisition ),
+	OA_DL_SYM( spinCameraEndAcquisition ),
+#if HAVE_LIBSPINNAKER_V1
+	OA_DL_SYM( spinImageEventCreate ),
+	OA_DL_SYM( spinCameraRegisterImageEvent ),
+	OA_DL_SYM( spinCameraUnregisterImageEvent ),
+	OA_DL_SYM( spinImageEventDestroy ),
+#else
+	OA_DL_SYM( spinImageEventHandlerCreate ),
+	OA_DL_SYM( spinCameraRegisterImageEventHandler ),
+	OA_DL_SYM( spinCameraUnregisterImageEventHandler ),
+	OA_DL_SYM( spinImageEventHandlerDestroy ),
+#endif
+	OA_DL_SYM( spinImageIsIncomplete ),
+	OA_DL_SYM( spinImageGetStatus ),
+	OA_DL_SYM( spinImageGetData ),
+	OA_DL_SYM( spinImageGetValidPayloadSize ),
+	OA_DL_SYM( spinImageGetTimeStamp ),
+	OA_DL_SYM( spinImageGetFrameID ),
+	OA_DL_END
+};
 
-int
-_spinInitLibraryFunctionPointers ( void )
-{
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-  const char*		libName = "/usr/local/lib/libSpinnaker_C.dylib";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT (
+		"/usr/local/lib/libSpinnaker_C.dylib", enumSymbols, otherSymbols );
 #else
 #if HAVE_LIBSPINNAKER_V1
-  const char*		libName = "libSpinnaker_C.so.1";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libSpinnaker_C.so.1",
+		enumSymbols, otherSymbols );
 #else
 #if HAVE_LIBSPINNAKER_V2
-  const char*		libName = "libSpinnaker_C.so.2";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libSpinnaker_C.so.2",
+		enumSymbols, otherSymbols );
 #else
 #if HAVE_LIBSPINNAKER_V3
-  const char*		libName = "libSpinnaker_C.so.3";
-#endif
-#endif
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libSpinnaker_C.so.3",
+		enumSymbols, otherSymbols );
 #endif
 #endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
-#endif
-
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
 #endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
 #endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
 
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
-#endif
-			oaLogWarning ( OA_LOG_CAMERA, "%s: %s not loaded, error '%s'", __func__,
-					libPath, dlerror());
-	    return OA_ERR_LIBRARY_NOT_FOUND;
-	  }
 
-		if (!( *( void** )( &p_spinSystemGetInstance ) = _getDLSym ( libHandle,
-		    "spinSystemGetInstance" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraListClear ) = _getDLSym ( libHandle,
-		    "spinCameraListClear" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraListCreateEmpty ) = _getDLSym ( libHandle,
-		    "spinCameraListCreateEmpty" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraListDestroy ) = _getDLSym ( libHandle,
-		    "spinCameraListDestroy" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraListGetSize ) = _getDLSym ( libHandle,
-		    "spinCameraListGetSize" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceListClear ) = _getDLSym ( libHandle,
-		    "spinInterfaceListClear" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceListCreateEmpty ) = _getDLSym ( libHandle,
-		    "spinInterfaceListCreateEmpty" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceListDestroy ) = _getDLSym ( libHandle,
-		    "spinInterfaceListDestroy" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceListGetSize ) = _getDLSym ( libHandle,
-		    "spinInterfaceListGetSize" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinSystemGetCameras ) = _getDLSym ( libHandle,
-		    "spinSystemGetCameras" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinSystemGetInterfaces ) = _getDLSym ( libHandle,
-		    "spinSystemGetInterfaces" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinSystemReleaseInstance ) = _getDLSym ( libHandle,
-		    "spinSystemReleaseInstance" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceListGet ) = _getDLSym ( libHandle,
-		    "spinInterfaceListGet" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceRelease ) = _getDLSym ( libHandle,
-		    "spinInterfaceRelease" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceGetTLNodeMap ) = _getDLSym ( libHandle,
-		    "spinInterfaceGetTLNodeMap" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeMapGetNumNodes ) = _getDLSym ( libHandle,
-		    "spinNodeMapGetNumNodes" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeMapGetNode ) = _getDLSym ( libHandle,
-		    "spinNodeMapGetNode" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeMapGetNodeByIndex ) = _getDLSym ( libHandle,
-		    "spinNodeMapGetNodeByIndex" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeIsAvailable ) = _getDLSym ( libHandle,
-		    "spinNodeIsAvailable" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeIsImplemented ) = _getDLSym ( libHandle,
-		    "spinNodeIsImplemented" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeIsReadable ) = _getDLSym ( libHandle,
-		    "spinNodeIsReadable" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeIsWritable ) = _getDLSym ( libHandle,
-		    "spinNodeIsWritable" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinStringGetValue ) = _getDLSym ( libHandle,
-		    "spinStringGetValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationEntryGetEnumValue ) = _getDLSym (
-		    libHandle, "spinEnumerationEntryGetEnumValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationSetEnumValue ) = _getDLSym (
-		    libHandle, "spinEnumerationSetEnumValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationEntryGetIntValue ) = _getDLSym (
-		    libHandle, "spinEnumerationEntryGetIntValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationSetIntValue ) = _getDLSym (
-		    libHandle, "spinEnumerationSetIntValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationEntryGetSymbolic ) = _getDLSym (
-		    libHandle, "spinEnumerationEntryGetSymbolic" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinInterfaceGetCameras ) = _getDLSym ( libHandle,
-		    "spinInterfaceGetCameras" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraListGet ) = _getDLSym ( libHandle,
-		    "spinCameraListGet" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraGetTLDeviceNodeMap ) = _getDLSym ( libHandle,
-		    "spinCameraGetTLDeviceNodeMap" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraRelease ) = _getDLSym ( libHandle,
-		    "spinCameraRelease" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraGetNodeMap ) = _getDLSym ( libHandle,
-		    "spinCameraGetNodeMap" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraGetNodeMap ) = _getDLSym ( libHandle,
-		    "spinCameraGetNodeMap" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCategoryGetNumFeatures ) = _getDLSym ( libHandle,
-		    "spinCategoryGetNumFeatures" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCategoryGetFeatureByIndex ) = _getDLSym (
-		    libHandle, "spinCategoryGetFeatureByIndex" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeGetType ) = _getDLSym ( libHandle,
-		    "spinNodeGetType" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeGetName ) = _getDLSym ( libHandle,
-		    "spinNodeGetName" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeGetDisplayName ) = _getDLSym ( libHandle,
-		    "spinNodeGetDisplayName" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraInit ) = _getDLSym ( libHandle,
-		    "spinCameraInit" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraDeInit ) = _getDLSym ( libHandle,
-		    "spinCameraDeInit" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraGetGuiXml ) = _getDLSym ( libHandle,
-		    "spinCameraGetGuiXml" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationGetNumEntries ) = _getDLSym ( libHandle,
-		    "spinEnumerationGetNumEntries" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationGetEntryByIndex ) = _getDLSym (
-		    libHandle, "spinEnumerationGetEntryByIndex" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationGetEntryByName ) = _getDLSym (
-		    libHandle, "spinEnumerationGetEntryByName" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinEnumerationGetCurrentEntry ) = _getDLSym (
-		    libHandle, "spinEnumerationGetCurrentEntry" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinNodeToString ) = _getDLSym ( libHandle,
-		    "spinNodeToString" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinIntegerGetMin ) = _getDLSym ( libHandle,
-		    "spinIntegerGetMin" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinIntegerGetMax ) = _getDLSym ( libHandle,
-		    "spinIntegerGetMax" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinIntegerGetInc ) = _getDLSym ( libHandle,
-		    "spinIntegerGetInc" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinIntegerGetValue ) = _getDLSym ( libHandle,
-		    "spinIntegerGetValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinIntegerSetValue ) = _getDLSym ( libHandle,
-		    "spinIntegerSetValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinBooleanGetValue ) = _getDLSym ( libHandle,
-		    "spinBooleanGetValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinBooleanSetValue ) = _getDLSym ( libHandle,
-		    "spinBooleanSetValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinFloatGetMin ) = _getDLSym ( libHandle,
-		    "spinFloatGetMin" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinFloatGetMax ) = _getDLSym ( libHandle,
-		    "spinFloatGetMax" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinFloatGetValue ) = _getDLSym ( libHandle,
-		    "spinFloatGetValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinFloatSetValue ) = _getDLSym ( libHandle,
-		    "spinFloatSetValue" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraBeginAcquisition ) = _getDLSym ( libHandle,
-		    "spinCameraBeginAcquisition" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraEndAcquisition ) = _getDLSym ( libHandle,
-		    "spinCameraEndAcquisition" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-#if HAVE_LIBSPINNAKER_V1
-		if (!( *( void** )( &p_spinImageEventCreate ) = _getDLSym ( libHandle,
-		    "spinImageEventCreate" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraRegisterImageEvent ) =
-				_getDLSym ( libHandle, "spinCameraRegisterImageEvent" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraUnregisterImageEvent ) =
-				_getDLSym ( libHandle, "spinCameraUnregisterImageEvent" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinImageEventDestroy ) =
-				_getDLSym ( libHandle, "spinImageEventDestroy" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-#else
-		if (!( *( void** )( &p_spinImageEventHandlerCreate ) = _getDLSym ( libHandle,
-		    "spinImageEventHandlerCreate" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraRegisterImageEventHandler ) =
-				_getDLSym ( libHandle, "spinCameraRegisterImageEventHandler" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinCameraUnregisterImageEventHandler ) =
-				_getDLSym ( libHandle, "spinCameraUnregisterImageEventHandler" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinImageEventHandlerDestroy ) =
-				_getDLSym ( libHandle, "spinImageEventHandlerDestroy" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-#endif
-		if (!( *( void** )( &p_spinImageIsIncomplete ) = _getDLSym ( libHandle,
-		    "spinImageIsIncomplete" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinImageGetStatus ) =
-				_getDLSym ( libHandle, "spinImageGetStatus" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinImageGetData ) = _getDLSym ( libHandle,
-				"spinImageGetData" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-		if (!( *( void** )( &p_spinImageGetValidPayloadSize ) = _getDLSym (
-				libHandle, "spinImageGetValidPayloadSize" ))) {
-		  return -OA_ERR_SYMBOL_NOT_FOUND;
-		}
-	}
+// Only the calls needed to enumerate cameras are resolved here
 
-  return OA_ERR_NONE;
+int
+_spinInitLibraryFunctionPointers ( void )
+{
+	return oacamDLLoad ( &lib, OA_DL_ENUMERATE );
 }
 
 
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+int
+_spinInitAllLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
-
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: spinnaker DL error: %s", __func__, error );
-    addr = 0;
-  }
-
-  return addr;
+	return oacamDLLoad ( &lib, OA_DL_ALL );
 }
 
 #endif	/* HAVE_LIBDL */
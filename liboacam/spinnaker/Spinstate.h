@@ -61,8 +61,6 @@ typedef struct SPINNAKER_STATE {
 	int											maxBinning;
 	int											binningStep;
 
-	frameBuffer*						buffers;
-
 	int											triggerEnabled;
 	int											triggerDelayOn;
 	float										triggerDelayValue;
@@ -63,6 +63,11 @@ oaSVBInitCamera ( oaCameraDevice* device )
 
   oaLogInfo ( OA_LOG_CAMERA, "%s ( %p ): entered", __func__ );
 
+	if ( _svbInitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve SDK functions", __func__ );
+		return 0;
+	}
+
 	if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
 			sizeof ( SVB_STATE ), &commonInfo ) != OA_ERR_NONE ) {
 		return 0;
@@ -681,53 +686,39 @@ oaSVBInitCamera ( oaCameraDevice* device )
   multiplier = cameraInfo->maxBitDepth / 8;
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY * multiplier;
-  cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s: malloc for buffer failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-      for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
-        if ( cameraInfo->frameSizes[j].sizes ) {
-          free (( void* ) cameraInfo->frameSizes[j].sizes );
-        }
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s: malloc for buffer failed", __func__ );
+    for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
+      if ( cameraInfo->frameSizes[j].sizes ) {
+        free (( void* ) cameraInfo->frameSizes[j].sizes );
       }
-      free (( void* ) cameraInfo->buffers );
-      FREE_DATA_STRUCTS;
-      return 0;
     }
+    FREE_DATA_STRUCTS;
+    return 0;
   }
   cameraInfo->nextBuffer = 0;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamSVBcontroller, ( void* ) camera )) {
-    for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-      free (( void* ) cameraInfo->buffers[i].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     for ( i = 1; i <= OA_MAX_BINNING; i++ ) {
       if ( cameraInfo->frameSizes[i].sizes )
         free (( void* ) cameraInfo->frameSizes[i].sizes );
     }
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
-    free (( void* ) cameraInfo->buffers );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
 
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamSVBcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -735,16 +726,13 @@ oaSVBInitCamera ( oaCameraDevice* device )
     pthread_cond_broadcast ( &cameraInfo->commandQueued );
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
-    for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-      free (( void* ) cameraInfo->buffers[i].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     for ( i = 1; i <= OA_MAX_BINNING; i++ ) {
       if ( cameraInfo->frameSizes[i].sizes )
         free (( void* ) cameraInfo->frameSizes[i].sizes );
     }
-    free (( void* ) cameraInfo->buffers );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -792,27 +780,20 @@ oaSVBCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     p_SVBCloseCamera ( cameraInfo->cameraId );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     for ( j = 1; j <= OA_MAX_BINNING; j++ ) {
       if ( cameraInfo->frameSizes[j].sizes )
         free (( void* ) cameraInfo->frameSizes[j].sizes );
     }
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-    free (( void* ) cameraInfo->buffers );
 		free (( void* ) cameraInfo );
 		free (( void* ) camera->_common );
 		free (( void* ) camera );
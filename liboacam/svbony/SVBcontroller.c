@@ -59,7 +59,8 @@ oacamSVBcontroller ( void* param )
   OA_COMMAND*		command;
   int			exitThread = 0;
   int			resultCode, nextBuffer, buffersFree, frameWait;
-  int			imageBufferLength, haveFrame;
+  int			imageBufferLength, haveFrame, dropped;
+  FRAME_METADATA*	metadata;
 //int			maxWaitTime;
   int			streaming = 0;
 
@@ -141,9 +142,7 @@ oacamSVBcontroller ( void* param )
         frameWait = 100;
       }
 
-      pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-      buffersFree = cameraInfo->buffersFree;
-      pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+      buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
       if ( buffersFree ) {
         nextBuffer = cameraInfo->nextBuffer;
@@ -161,6 +160,28 @@ oacamSVBcontroller ( void* param )
           pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
 
           if ( !exitThread && haveFrame ) {
+            // The SDK's count of dropped frames restarts with each capture
+            if ( !p_SVBGetDroppedFrames ( cameraInfo->cameraId, &dropped )) {
+              if ( !cameraInfo->frameSequence ) {
+                cameraInfo->sdkDroppedFrames = 0;
+              }
+              if ( dropped > cameraInfo->sdkDroppedFrames ) {
+                OA_DROP_FRAMES ( cameraInfo, dropped -
+                    cameraInfo->sdkDroppedFrames );
+              }
+              cameraInfo->sdkDroppedFrames = dropped;
+            }
+            metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+                nextBuffer );
+            if ( !cameraInfo->autoExposure ) {
+              metadata->exposure = cameraInfo->currentAbsoluteExposure;
+              metadata->exposureValid = 1;
+            }
+            if ( !cameraInfo->autoGain ) {
+              metadata->gain = cameraInfo->currentGain;
+              metadata->gainValid = 1;
+            }
+            cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
             cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
                 OA_CALLBACK_NEW_FRAME;
             cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -171,14 +192,11 @@ oacamSVBcontroller ( void* param )
                 cameraInfo->buffers[ nextBuffer ].start;
             cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
                 imageBufferLength;
-            oaDLListAddToTail ( cameraInfo->callbackQueue,
+            oacamCallbackRingPush ( &cameraInfo->callbackRing,
                 &cameraInfo->frameCallbacks[ nextBuffer ]);
-            pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-            cameraInfo->buffersFree--;
+            OA_CLAIM_BUFFER ( cameraInfo );
             cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
                 cameraInfo->configuredBuffers;
-            pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-            pthread_cond_broadcast ( &cameraInfo->callbackQueued );
           }
 //      } while ( !exitThread && !haveFrame && maxWaitTime > 0 );
       }
@@ -937,9 +955,7 @@ retry:
 		return;
 	}
 
-	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-	buffersFree = cameraInfo->buffersFree;
-	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+	buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
   if ( buffersFree ) {
     nextBuffer = cameraInfo->nextBuffer;
@@ -955,6 +971,8 @@ retry:
 		}
 
 		cameraInfo->exposureInProgress = 0;
+    cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+        oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
     cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
         OA_CALLBACK_NEW_FRAME;
     cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -965,16 +983,14 @@ retry:
         cameraInfo->buffers[ nextBuffer ].start;
     cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
         cameraInfo->imageBufferLength;
-    oaDLListAddToTail ( cameraInfo->callbackQueue,
+    oacamCallbackRingPush ( &cameraInfo->callbackRing,
         &cameraInfo->frameCallbacks[ nextBuffer ]);
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    cameraInfo->buffersFree--;
+    OA_CLAIM_BUFFER ( cameraInfo );
     cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
         cameraInfo->configuredBuffers;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
   } else {
 		cameraInfo->exposureInProgress = 0;
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
 	}
 }
 #endif
@@ -43,6 +43,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "SVBprivate.h"
 
 
@@ -82,225 +83,62 @@ SVB_ERROR_CODE	( *p_SVBGetTriggerOutputIOConf )( int, SVB_TRIG_OUTPUT_PIN,
 SVB_ERROR_CODE	( *p_SVBGetSensorPixelSize )( int, float* );
 
 #if HAVE_LIBDL && !HAVE_STATIC_LIBSVBCAMERASDK
-static void*    _getDLSym ( void*, const char* );
-#endif
 
-int
-_svbInitLibraryFunctionPointers ( void )
-{
-#if HAVE_LIBDL && !HAVE_STATIC_LIBSVBCAMERASDK
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( SVBGetNumOfConnectedCameras ),
+	OA_DL_SYM( SVBGetCameraInfo ),
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( SVBGetCameraProperty ),
+	OA_DL_SYM( SVBOpenCamera ),
+	OA_DL_SYM( SVBCloseCamera ),
+	OA_DL_SYM( SVBGetNumOfControls ),
+	OA_DL_SYM( SVBGetControlCaps ),
+	OA_DL_SYM( SVBGetControlValue ),
+	OA_DL_SYM( SVBSetControlValue ),
+	OA_DL_SYM( SVBGetOutputImageType ),
+	OA_DL_SYM( SVBSetOutputImageType ),
+	OA_DL_SYM( SVBSetROIFormat ),
+	OA_DL_SYM( SVBGetROIFormat ),
+	OA_DL_SYM( SVBGetDroppedFrames ),
+	OA_DL_SYM( SVBStartVideoCapture ),
+	OA_DL_SYM( SVBStopVideoCapture ),
+	OA_DL_SYM( SVBGetVideoData ),
+	OA_DL_SYM( SVBGetSDKVersion ),
+	OA_DL_SYM( SVBGetCameraSupportMode ),
+	OA_DL_SYM( SVBGetCameraMode ),
+	OA_DL_SYM( SVBSetCameraMode ),
+	OA_DL_SYM( SVBSendSoftTrigger ),
+	OA_DL_SYM( SVBGetSerialNumber ),
+	OA_DL_SYM( SVBSetTriggerOutputIOConf ),
+	OA_DL_SYM( SVBGetTriggerOutputIOConf ),
+	OA_DL_END
+};
 
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-  const char*		libName = "libSVBCameraSDK.dylib";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libSVBCameraSDK.dylib",
+		enumSymbols, otherSymbols );
 #else
-  const char*		libName = "libSVBCameraSDK.so";
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libSVBCameraSDK.so",
+		enumSymbols, otherSymbols );
 #endif
-
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
 #endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
-#endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libPath, dlerror());
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
-#endif
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-		if (!( *( void** )( &p_SVBGetNumOfConnectedCameras ) = _getDLSym ( libHandle,
-		    "SVBGetNumOfConnectedCameras" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetCameraProperty ) = _getDLSym ( libHandle,
-		    "SVBGetCameraProperty" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBOpenCamera ) = _getDLSym ( libHandle,
-		    "SVBOpenCamera" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBCloseCamera ) = _getDLSym ( libHandle,
-		    "SVBCloseCamera" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetNumOfControls ) = _getDLSym ( libHandle,
-		    "SVBGetNumOfControls" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetControlCaps ) = _getDLSym ( libHandle,
-		    "SVBGetControlCaps" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetControlValue ) = _getDLSym ( libHandle,
-		    "SVBGetControlValue" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBSetControlValue ) = _getDLSym ( libHandle,
-		    "SVBSetControlValue" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetOutputImageType ) = _getDLSym ( libHandle,
-		    "SVBGetOutputImageType" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBSetOutputImageType ) = _getDLSym ( libHandle,
-		    "SVBSetOutputImageType" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBSetROIFormat ) = _getDLSym ( libHandle,
-		    "SVBSetROIFormat" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetROIFormat ) = _getDLSym ( libHandle,
-		    "SVBGetROIFormat" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetDroppedFrames ) = _getDLSym ( libHandle,
-		    "SVBGetDroppedFrames" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBStartVideoCapture ) = _getDLSym ( libHandle,
-		    "SVBStartVideoCapture" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBStopVideoCapture ) = _getDLSym ( libHandle,
-		    "SVBStopVideoCapture" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
 
-		if (!( *( void** )( &p_SVBGetVideoData ) = _getDLSym ( libHandle,
-		    "SVBGetVideoData" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetSDKVersion ) = _getDLSym ( libHandle,
-		    "SVBGetSDKVersion" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetCameraSupportMode ) = _getDLSym ( libHandle,
-		    "SVBGetCameraSupportMode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetCameraMode ) = _getDLSym ( libHandle,
-		    "SVBGetCameraMode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBSetCameraMode ) = _getDLSym ( libHandle,
-		    "SVBSetCameraMode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBSendSoftTrigger ) = _getDLSym ( libHandle,
-		    "SVBSendSoftTrigger" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetSerialNumber ) = _getDLSym ( libHandle,
-		    "SVBGetSerialNumber" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBSetTriggerOutputIOConf ) = _getDLSym ( libHandle,
-		    "SVBSetTriggerOutputIOConf" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_SVBGetTriggerOutputIOConf ) = _getDLSym ( libHandle,
-		    "SVBGetTriggerOutputIOConf" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-	}
 
+static int
+_svbLoad ( int level )
+{
+#if HAVE_LIBDL && !HAVE_STATIC_LIBSVBCAMERASDK
+	return oacamDLLoad ( &lib, level );
 #else
 #if HAVE_STATIC_LIBSVBCAMERASDK
 
+	( void ) level;
+
 	p_SVBGetNumOfConnectedCameras = SVBGetNumOfConnectedCameras;
+	p_SVBGetCameraInfo = SVBGetCameraInfo;
 	p_SVBGetCameraProperty = SVBGetCameraProperty;
 	p_SVBOpenCamera = SVBOpenCamera;
 	p_SVBCloseCamera = SVBCloseCamera;
@@ -316,8 +154,6 @@ retry:
 	p_SVBStartVideoCapture = SVBStartVideoCapture;
 	p_SVBStopVideoCapture = SVBStopVideoCapture;
 	p_SVBGetVideoData = SVBGetVideoData;
-//	p_SVBPulseGuideOn = SVBPulseGuideOn;
-//	p_SVBPulseGuideOff = SVBPulseGuideOff;
 	p_SVBGetSDKVersion = SVBGetSDKVersion;
 	p_SVBGetCameraSupportMode = SVBGetCameraSupportMode;
 	p_SVBGetCameraMode = SVBGetCameraMode;
@@ -326,29 +162,28 @@ retry:
 	p_SVBGetSerialNumber = SVBGetSerialNumber;
 	p_SVBSetTriggerOutputIOConf = SVBSetTriggerOutputIOConf;
 	p_SVBGetTriggerOutputIOConf = SVBGetTriggerOutputIOConf;
-
+	return OA_ERR_NONE;
 #else
+	( void ) level;
 	return OA_ERR_LIBRARY_NOT_FOUND;
 #endif	/* HAVE_STATIC_LIBSVBCAMERASDK */
 #endif	/* HAVE_LIBDL && !HAVE_STATIC_LIBSVBCAMERASDK */
-	return OA_ERR_NONE;
 }
 
-#if HAVE_LIBDL && !HAVE_STATIC_LIBSVBCAMERASDK
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+
+// Only the calls needed to enumerate cameras are resolved here
+
+int
+_svbInitLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
+	return _svbLoad ( OA_DL_ENUMERATE );
+}
 
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libSVBCameraSDK DL error: %s", __func__,
-				error );
-    addr = 0;
-  }
 
-  return addr;
+int
+_svbInitAllLibraryFunctionPointers ( void )
+{
+	return _svbLoad ( OA_DL_ALL );
 }
-#endif
+
 #endif	/* HAVE_LIBSVBCAMERASDK */
@@ -30,6 +30,7 @@
 #include <SVBCameraSDK.h>
 
 extern int							_svbInitLibraryFunctionPointers ( void );
+extern int							_svbInitAllLibraryFunctionPointers ( void );
 
 extern int							( *p_SVBGetNumOfConnectedCameras )( void ); 
 extern int							( *p_SVBGetProductIDs )( int* );
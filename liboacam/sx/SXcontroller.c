@@ -31,6 +31,7 @@
 
 #include <openastro/camera.h>
 #include <openastro/util.h>
+#include <openastro/video.h>
 #include <sys/time.h>
 
 #include "oacamprivate.h"
@@ -46,7 +47,7 @@ static int	_processSetResolution ( oaCamera*, OA_COMMAND* );
 static int	_processStreamingStart ( oaCamera*, OA_COMMAND* );
 static int	_processStreamingStop ( SX_STATE*, OA_COMMAND* );
 static int	_doStartExposure ( SX_STATE* );
-static int	_doReadExposure ( SX_STATE* );
+static int	_doReadExposure ( SX_STATE*, void* );
 
 static int	_clearFrame ( SX_STATE*, unsigned int );
 static int	_latchFrame ( SX_STATE*, unsigned int, unsigned int,
@@ -66,10 +67,7 @@ oacamSXcontroller ( void* param )
   int			streaming = 0;
   int			maxWaitTime, frameWait;
   int			nextBuffer, buffersFree;
-  unsigned char*	evenFrame;
-  unsigned char*	oddFrame;
-  unsigned char*	tgt;
-  unsigned int		halfFrameSize, rowLength, i, numRows;
+  FRAME_METADATA*	metadata;
 
   do {
     pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
@@ -143,37 +141,21 @@ oacamSXcontroller ( void* param )
       }
 
       if ( !exitThread ) {
-        if ( !_doReadExposure ( cameraInfo )) {
-          pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-          buffersFree = cameraInfo->buffersFree;
-          pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+        // The frame is read straight into the next buffer if there is one
+
+        buffersFree = OA_BUFFERS_FREE ( cameraInfo );
+        nextBuffer = cameraInfo->nextBuffer;
+        if ( !_doReadExposure ( cameraInfo, buffersFree ?
+            cameraInfo->buffers[ nextBuffer ].start : 0 )) {
           pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
 					streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
           pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
           if ( buffersFree && streaming ) {
-            nextBuffer = cameraInfo->nextBuffer;
-            if ( cameraInfo->isInterlaced ) {
-							if ( OA_BIN_MODE_NONE == cameraInfo->binMode ) {
-								rowLength = cameraInfo->xImageSize * cameraInfo->bytesPerPixel;
-								numRows = cameraInfo->yImageSize / 2;
-								halfFrameSize = rowLength * numRows;
-								evenFrame = cameraInfo->xferBuffer;
-								oddFrame = cameraInfo->xferBuffer + halfFrameSize;
-
-								tgt = cameraInfo->buffers[ nextBuffer ].start;
-								for ( i = 0; i < numRows; i++ ) {
-									memcpy ( tgt, oddFrame, rowLength );
-									tgt += rowLength;
-									oddFrame += rowLength;
-									memcpy ( tgt, evenFrame, rowLength );
-									tgt += rowLength;
-									evenFrame += rowLength;
-								}
-							} else {
-								memcpy ( cameraInfo->buffers[ nextBuffer ].start,
-										cameraInfo->xferBuffer, cameraInfo->actualImageLength );
-							}
-						}
+            metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+                nextBuffer );
+            metadata->exposure = cameraInfo->currentExposure;
+            metadata->exposureValid = 1;
+            cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
             cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
                 OA_CALLBACK_NEW_FRAME;
             cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -184,14 +166,13 @@ oacamSXcontroller ( void* param )
                 cameraInfo->buffers[ nextBuffer ].start;
             cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
 								cameraInfo->actualImageLength;
-            pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-            oaDLListAddToTail ( cameraInfo->callbackQueue,
+            oacamCallbackRingPush ( &cameraInfo->callbackRing,
                 &cameraInfo->frameCallbacks[ nextBuffer ]);
-            cameraInfo->buffersFree--;
+            OA_CLAIM_BUFFER ( cameraInfo );
             cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
                 cameraInfo->configuredBuffers;
-            pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-            pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+          } else if ( streaming ) {
+            OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
           }
         }
       }
@@ -375,9 +356,7 @@ _processStreamingStop ( SX_STATE* cameraInfo, OA_COMMAND* command )
 
   queueEmpty = 0;
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( OA_CAM_BUFFERS == cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    queueEmpty = ( cameraInfo->configuredBuffers == OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
     if ( !queueEmpty ) {
       usleep ( 100 );
     }
@@ -403,12 +382,21 @@ _doStartExposure ( SX_STATE* cameraInfo )
 }
 
 
+/*
+ * Read the exposure into "frame", or just drain it from the camera if
+ * there's no buffer to put it in.  Binned frames arrive with the fields
+ * already combined so they can be read into the frame buffer directly.
+ * Unbinned frames arrive a field at a time and are interleaved from the
+ * transfer buffer into the frame buffer in a single pass, odd field first.
+ */
+
 static int
-_doReadExposure ( SX_STATE* cameraInfo )
+_doReadExposure ( SX_STATE* cameraInfo, void* frame )
 {
   unsigned char*	evenFrame;
   unsigned char*	oddFrame;
-  int			halfFrameSize, rowLength, numRows;
+  int			halfFrameSize, rowLength, numRows, ret;
+  oaImage		evenField, oddField, target;
 
   _clearFrame ( cameraInfo, CCD_EXP_FLAGS_NOWIPE_FRAME );
  
@@ -430,12 +418,27 @@ _doReadExposure ( SX_STATE* cameraInfo )
 					cameraInfo->xImageSize, numRows, cameraInfo->xSubframeOffset,
 					cameraInfo->ySubframeOffset );
 			_readFrame ( cameraInfo, oddFrame, halfFrameSize );
+
+			if ( frame ) {
+				( void ) oaImageInit ( &evenField, evenFrame, cameraInfo->xImageSize,
+						numRows, cameraInfo->currentFrameFormat );
+				( void ) oaImageInit ( &oddField, oddFrame, cameraInfo->xImageSize,
+						numRows, cameraInfo->currentFrameFormat );
+				( void ) oaImageInit ( &target, frame, cameraInfo->xImageSize,
+						numRows * 2, cameraInfo->currentFrameFormat );
+				if (( ret = oaMergeFields ( &oddField, &evenField, &target,
+						OA_FIELDS_INTERLEAVE )) < 0 ) {
+					oaLogError ( OA_LOG_CAMERA, "%s: field merge failed: %d", __func__,
+							ret );
+					return ret;
+				}
+			}
 		} else {
 			_latchFrame ( cameraInfo, CCD_EXP_FLAGS_FIELD_BOTH,
 					cameraInfo->xSubframeSize, cameraInfo->ySubframeSize / 2,
 					cameraInfo->xSubframeOffset, cameraInfo->ySubframeOffset /
 					cameraInfo->binMode );
-			_readFrame ( cameraInfo, cameraInfo->xferBuffer,
+			_readFrame ( cameraInfo, frame ? frame : cameraInfo->xferBuffer,
 					cameraInfo->actualImageLength );
 		}
 	} else {
@@ -50,7 +50,6 @@ typedef struct SX_STATE {
   uint32_t		verticalFrontPorch;
   uint32_t		verticalBackPorch;
   // buffering for image transfers
-  frameBuffer*		buffers;
   unsigned int          actualImageLength;
   // camera status
   unsigned int          isColour;
@@ -0,0 +1,180 @@
+/*****************************************************************************
+ *
+ * threadPolicy.c -- scheduling, affinity and naming of camera threads
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+// pthread_setaffinity_np() and pthread_setname_np() are GNU extensions
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+
+
+static const char*			defaultNames[ OA_CAM_THREAD_ROLES ] = {
+	"oacam-control", "oacam-callback", "oacam-timer", "oacam-events"
+};
+
+static pthread_mutex_t				policyMutex = PTHREAD_MUTEX_INITIALIZER;
+static oaCameraThreadPolicy		policies[ OA_CAM_THREAD_ROLES ];
+
+
+int
+oaSetCameraThreadPolicy ( unsigned int role,
+		const oaCameraThreadPolicy* policy )
+{
+	if ( role >= OA_CAM_THREAD_ROLES ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	if ( policy && policy->scheduler > OA_THREAD_SCHED_RR ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+
+	pthread_mutex_lock ( &policyMutex );
+	if ( policy ) {
+		policies[ role ] = *policy;
+		policies[ role ].name[ OA_THREAD_NAME_LEN ] = 0;
+	} else {
+		OA_CLEAR ( policies[ role ] );
+	}
+	pthread_mutex_unlock ( &policyMutex );
+	return OA_ERR_NONE;
+}
+
+
+int
+oaGetCameraThreadPolicy ( unsigned int role, oaCameraThreadPolicy* policy )
+{
+	if ( role >= OA_CAM_THREAD_ROLES || !policy ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+
+	pthread_mutex_lock ( &policyMutex );
+	*policy = policies[ role ];
+	pthread_mutex_unlock ( &policyMutex );
+	return OA_ERR_NONE;
+}
+
+
+static int
+_setScheduler ( pthread_attr_t* attr, oaCameraThreadPolicy* policy )
+{
+	struct sched_param	param;
+	int									sched, min, max;
+
+	sched = ( policy->scheduler == OA_THREAD_SCHED_FIFO ) ? SCHED_FIFO :
+			SCHED_RR;
+	min = sched_get_priority_min ( sched );
+	max = sched_get_priority_max ( sched );
+	param.sched_priority = policy->priority;
+	if ( param.sched_priority < min ) {
+		param.sched_priority = min;
+	}
+	if ( param.sched_priority > max ) {
+		param.sched_priority = max;
+	}
+
+	if ( pthread_attr_setinheritsched ( attr, PTHREAD_EXPLICIT_SCHED ) ||
+			pthread_attr_setschedpolicy ( attr, sched ) ||
+			pthread_attr_setschedparam ( attr, &param )) {
+		return -OA_ERR_SYSTEM_ERROR;
+	}
+	return OA_ERR_NONE;
+}
+
+
+#ifdef __linux__
+static void
+_setAffinity ( pthread_t thread, uint64_t mask )
+{
+	cpu_set_t			cpus;
+	unsigned int	i;
+
+	CPU_ZERO ( &cpus );
+	for ( i = 0; i < 64 && i < CPU_SETSIZE; i++ ) {
+		if ( mask & (( uint64_t ) 1 << i )) {
+			CPU_SET ( i, &cpus );
+		}
+	}
+	if ( pthread_setaffinity_np ( thread, sizeof ( cpus ), &cpus )) {
+		oaLogWarning ( OA_LOG_CAMERA, "%s: unable to set CPU affinity %llx",
+				__func__, ( unsigned long long ) mask );
+	}
+}
+#endif
+
+
+// Used by the drivers in place of pthread_create() for the per-camera
+// threads so the policy for the thread's role is applied
+
+int
+oacamCreateThread ( pthread_t* thread, unsigned int role,
+		void* ( *func )( void* ), void* arg )
+{
+	oaCameraThreadPolicy	policy;
+	pthread_attr_t				attr;
+	int										ret;
+
+	if ( role >= OA_CAM_THREAD_ROLES ) {
+		return EINVAL;
+	}
+	( void ) oaGetCameraThreadPolicy ( role, &policy );
+
+	ret = -1;
+	if ( policy.scheduler != OA_THREAD_SCHED_DEFAULT ) {
+		if ( pthread_attr_init ( &attr )) {
+			return EAGAIN;
+		}
+		if ( _setScheduler ( &attr, &policy ) == OA_ERR_NONE ) {
+			ret = pthread_create ( thread, &attr, func, arg );
+		}
+		( void ) pthread_attr_destroy ( &attr );
+		if ( ret ) {
+			oaLogWarning ( OA_LOG_CAMERA,
+					"%s: real-time scheduling refused for %s thread, error %d",
+					__func__, defaultNames[ role ], ret );
+		}
+	}
+	if ( ret && ( ret = pthread_create ( thread, 0, func, arg ))) {
+		return ret;
+	}
+
+#ifdef __linux__
+	if ( policy.cpuMask ) {
+		_setAffinity ( *thread, policy.cpuMask );
+	}
+	( void ) pthread_setname_np ( *thread, *policy.name ? policy.name :
+			defaultNames[ role ] );
+#endif
+
+	return 0;
+}
@@ -29,6 +29,7 @@
 
 #include <pthread.h>
 #include <stdint.h>
+#include <time.h>
 
 #include <openastro/util.h>
 
@@ -60,8 +61,8 @@ oacamStartTimer ( uint64_t delayusec, void* param )
 	cameraInfo->timerEnd.tv_nsec = delayNanoSecs;
 
 	if ( !cameraInfo->stopControllerThread ) {
-		if ( pthread_create ( &( cameraInfo->timerThread ), 0, _oacamTimerThread,
-				( void* ) cameraInfo )) {
+		if ( oacamCreateThread ( &( cameraInfo->timerThread ),
+				OA_CAM_THREAD_TIMER, _oacamTimerThread, ( void* ) cameraInfo )) {
 			return -OA_ERR_SYSTEM_ERROR;
 		}
 		cameraInfo->timerActive = 1;
@@ -103,3 +104,48 @@ oacamAbortTimer ( void* param )
 
 	pthread_cond_signal ( &( cameraInfo->timerState ));
 }
+
+
+/*
+ * Nanoseconds on the monotonic clock, which frame timestamps and all of
+ * the library's own deadlines use
+ */
+
+uint64_t
+oacamMonotonicTime ( void )
+{
+	struct timespec		t;
+
+	( void ) clock_gettime ( CLOCK_MONOTONIC, &t );
+	return ( uint64_t ) t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+
+
+/*
+ * Sleep until the monotonic clock reaches "when".  Not every platform has
+ * clock_nanosleep() (macOS doesn't), so there the time left is slept
+ * instead, going round again if the sleep is interrupted.
+ */
+
+void
+oacamSleepUntil ( uint64_t when )
+{
+	struct timespec		t;
+#if defined(_POSIX_CLOCK_SELECTION) && _POSIX_CLOCK_SELECTION > 0
+
+	t.tv_sec = when / 1000000000ULL;
+	t.tv_nsec = when % 1000000000ULL;
+	while ( clock_nanosleep ( CLOCK_MONOTONIC, TIMER_ABSTIME, &t, 0 ) ==
+			EINTR );
+#else
+	uint64_t					now;
+
+	while (( now = oacamMonotonicTime()) < when ) {
+		t.tv_sec = ( when - now ) / 1000000000ULL;
+		t.tv_nsec = ( when - now ) % 1000000000ULL;
+		if ( nanosleep ( &t, 0 ) == 0 ) {
+			break;
+		}
+	}
+#endif
+}
@@ -194,10 +194,8 @@ TT_FUNC( _, FrameCallbackV1 )( const void *frame, const BITMAPINFOHEADER*
   int			buffersFree, bitsPerPixel;
   unsigned int		dataLength;
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
   bitsPerPixel = cameraInfo->currentBitsPerPixel;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
 
   if ( frame && buffersFree && bitmapHeader->biSizeImage ) {
     if (( dataLength = bitmapHeader->biSizeImage ) >
@@ -206,7 +204,11 @@ TT_FUNC( _, FrameCallbackV1 )( const void *frame, const BITMAPINFOHEADER*
     }
 		_completeCallback ( cameraInfo, frame, bitsPerPixel,
 				cameraInfo->nextBuffer, dataLength );
-  }
+  } else if ( frame && !buffersFree ) {
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
+  } else if ( frame ) {
+		OA_DROP_FRAME ( cameraInfo );
+	}
 }
 
 
@@ -217,15 +219,15 @@ TT_FUNC( _, FrameCallbackV2 )( const void *frame,
   TOUPTEK_STATE*	cameraInfo = ptr;
   int			buffersFree, bitsPerPixel;
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
   bitsPerPixel = cameraInfo->currentBitsPerPixel;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
 
   if ( frame && buffersFree ) {
 		_completeCallback ( cameraInfo, frame, bitsPerPixel,
 				cameraInfo->nextBuffer, cameraInfo->imageBufferLength );
-  }
+  } else if ( frame ) {
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
+	}
 }
 
 
@@ -1327,6 +1329,8 @@ _completeCallback ( TOUPTEK_STATE* cameraInfo, const void* frame,
 		}
 	}
 
+	cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+			oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
 	cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
 			OA_CALLBACK_NEW_FRAME;
 	cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -1336,14 +1340,11 @@ _completeCallback ( TOUPTEK_STATE* cameraInfo, const void* frame,
 	cameraInfo->frameCallbacks[ nextBuffer ].buffer =
 			cameraInfo->buffers[ nextBuffer ].start;
 	cameraInfo->frameCallbacks[ nextBuffer ].bufferLen = dataLength;
-	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-	oaDLListAddToTail ( cameraInfo->callbackQueue,
+	oacamCallbackRingPush ( &cameraInfo->callbackRing,
 			&cameraInfo->frameCallbacks[ nextBuffer ]);
-	cameraInfo->buffersFree--;
+	OA_CLAIM_BUFFER ( cameraInfo );
 	cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
 			cameraInfo->configuredBuffers;
-	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-	pthread_cond_broadcast ( &cameraInfo->callbackQueued );
 }
 
 
@@ -1355,12 +1356,10 @@ TT_FUNC( _, PullCallbackV1 )( unsigned int event, void* ptr )
 	int										bytesPerPixel, ret, abort;
   unsigned int					dataLength, height, width;
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
   bitsPerPixel = cameraInfo->currentBitsPerPixel;
   bytesPerPixel = cameraInfo->currentBytesPerPixel;
 	abort = cameraInfo->abortExposure;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
 
   if ( !abort && buffersFree && event == TT_DEFINE( EVENT_IMAGE )) {
     dataLength = cameraInfo->imageBufferLength;
@@ -1378,6 +1377,8 @@ TT_FUNC( _, PullCallbackV1 )( unsigned int event, void* ptr )
 		cameraInfo->exposureInProgress = 0;
 		_completeCallback ( cameraInfo, 0, bitsPerPixel, nextBuffer,
 				dataLength );
+	} else if ( !abort && event == TT_DEFINE( EVENT_IMAGE )) {
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
 	}
 }
 
@@ -1391,12 +1392,10 @@ TT_FUNC( _, PullCallbackV2 )( unsigned int event, void* ptr )
 	int										bytesPerPixel, ret, abort;
   unsigned int					dataLength;
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
   bitsPerPixel = cameraInfo->currentBitsPerPixel;
   bytesPerPixel = cameraInfo->currentBytesPerPixel;
 	abort = cameraInfo->abortExposure;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
 
   if ( !abort && buffersFree && event == TT_DEFINE( EVENT_IMAGE )) {
     dataLength = cameraInfo->imageBufferLength;
@@ -1414,6 +1413,8 @@ TT_FUNC( _, PullCallbackV2 )( unsigned int event, void* ptr )
 		cameraInfo->exposureInProgress = 0;
 		_completeCallback ( cameraInfo, 0, bitsPerPixel, nextBuffer,
 				dataLength );
+	} else if ( !abort && event == TT_DEFINE( EVENT_IMAGE )) {
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
 	}
 }
 
@@ -39,6 +39,7 @@
 
 #include "touptek-conf.h"
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "unimplemented.h"
 #include "touptekoacam.h"
 #include "touptekprivate.h"
@@ -215,927 +216,189 @@ void		( *TT_LIB_PTR( HotPlug ))( TT_FUNC_TYPE( P, HOTPLUG ), void* );
 // ..._write_UART(ToupcamT*, unsigned char const*, unsigned int)
 
 
-static void*		_getDLSym ( void*, const char* );
+#define	TT_DL_SYM(s)	{ ( void** ) &TT_LIB_PTR( s ), TT_LIB_PREFIX "_" #s, 0 }
+#define	TT_DL_OPT_SYM(s) { ( void** ) &TT_LIB_PTR( s ), TT_LIB_PREFIX "_" #s, 1 }
+
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	TT_DL_SYM( EnumV2 ),
+	TT_DL_SYM( Version ),
+	OA_DL_END
+};
+
+// Earlier libraries have only the original image calls and later ones may
+// have dropped them, so both versions are optional and checked for below
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	TT_DL_SYM( AwbInit ),
+	TT_DL_SYM( AwbOnePush ),
+	TT_DL_SYM( calc_ClarityFactor ),
+	TT_DL_SYM( Close ),
+	TT_DL_SYM( Flush ),
+	TT_DL_SYM( get_AEAuxRect ),
+	TT_DL_SYM( get_AutoExpoEnable ),
+	TT_DL_SYM( get_AutoExpoTarget ),
+	TT_DL_SYM( get_AWBAuxRect ),
+	TT_DL_SYM( get_Brightness ),
+	TT_DL_SYM( get_Chrome ),
+	TT_DL_SYM( get_Contrast ),
+	TT_DL_SYM( get_eSize ),
+	TT_DL_SYM( get_ExpoAGain ),
+	TT_DL_SYM( get_ExpoAGainRange ),
+	TT_DL_SYM( get_ExpoTime ),
+	TT_DL_SYM( get_ExpTimeRange ),
+	TT_DL_SYM( get_FwVersion ),
+	TT_DL_SYM( get_Gamma ),
+	TT_DL_SYM( get_HFlip ),
+	TT_DL_SYM( GetHistogram ),
+	TT_DL_SYM( get_Hue ),
+	TT_DL_SYM( get_HwVersion ),
+	TT_DL_SYM( get_HZ ),
+	TT_DL_SYM( get_LevelRange ),
+	TT_DL_SYM( get_MaxBitDepth ),
+	TT_DL_SYM( get_MaxSpeed ),
+	TT_DL_SYM( get_Mode ),
+	TT_DL_SYM( get_MonoMode ),
+	TT_DL_SYM( get_Negative ),
+	TT_DL_SYM( get_Option ),
+	TT_DL_SYM( get_ProductionDate ),
+	TT_DL_SYM( get_RawFormat ),
+	TT_DL_SYM( get_RealTime ),
+	TT_DL_SYM( get_Resolution ),
+	TT_DL_SYM( get_ResolutionNumber ),
+	TT_DL_SYM( get_ResolutionRatio ),
+	TT_DL_SYM( get_Roi ),
+	TT_DL_SYM( get_Saturation ),
+	TT_DL_SYM( get_SerialNumber ),
+	TT_DL_SYM( get_Size ),
+	TT_DL_SYM( get_Speed ),
+	TT_DL_SYM( get_StillResolution ),
+	TT_DL_SYM( get_StillResolutionNumber ),
+	TT_DL_SYM( get_Temperature ),
+	TT_DL_SYM( get_TempTint ),
+	TT_DL_SYM( get_VFlip ),
+	TT_DL_SYM( get_WhiteBalanceGain ),
+	TT_DL_SYM( HotPlug ),
+	TT_DL_SYM( LevelRangeAuto ),
+	TT_DL_SYM( Open ),
+	TT_DL_SYM( OpenByIndex ),
+	TT_DL_SYM( Pause ),
+	TT_DL_SYM( put_AEAuxRect ),
+	TT_DL_SYM( put_AutoExpoEnable ),
+	TT_DL_SYM( put_AutoExpoTarget ),
+	TT_DL_SYM( put_AWBAuxRect ),
+	TT_DL_SYM( put_Brightness ),
+	TT_DL_SYM( put_Chrome ),
+	TT_DL_SYM( put_Contrast ),
+	TT_DL_SYM( put_eSize ),
+	TT_DL_SYM( put_ExpoAGain ),
+	TT_DL_SYM( put_ExpoTime ),
+	TT_DL_SYM( put_Gamma ),
+	TT_DL_SYM( put_HFlip ),
+	TT_DL_SYM( put_Hue ),
+	TT_DL_SYM( put_HZ ),
+	TT_DL_SYM( put_LEDState ),
+	TT_DL_SYM( put_LevelRange ),
+	TT_DL_SYM( put_MaxAutoExpoTimeAGain ),
+	TT_DL_SYM( put_Mode ),
+	TT_DL_SYM( put_Negative ),
+	TT_DL_SYM( put_Option ),
+	TT_DL_SYM( put_RealTime ),
+	TT_DL_SYM( put_Roi ),
+	TT_DL_SYM( put_Saturation ),
+	TT_DL_SYM( put_Size ),
+	TT_DL_SYM( put_Speed ),
+	TT_DL_SYM( put_Temperature ),
+	TT_DL_SYM( put_TempTint ),
+	TT_DL_SYM( put_VFlip ),
+	TT_DL_SYM( put_WhiteBalanceGain ),
+	TT_DL_SYM( read_EEPROM ),
+	TT_DL_SYM( Snap ),
+	TT_DL_SYM( ST4PlusGuide ),
+	TT_DL_SYM( ST4PlusGuideState ),
+	TT_DL_SYM( StartPullModeWithCallback ),
+	TT_DL_SYM( Stop ),
+	TT_DL_SYM( Trigger ),
+	TT_DL_SYM( write_EEPROM ),
+#ifndef NO_V2_IMAGE_FUNCS
+	TT_DL_OPT_SYM( PullImageV2 ),
+	TT_DL_OPT_SYM( PullStillImageV2 ),
+	TT_DL_OPT_SYM( StartPushModeV2 ),
+#endif
+	TT_DL_OPT_SYM( PullImage ),
+	TT_DL_OPT_SYM( PullStillImage ),
+	TT_DL_OPT_SYM( StartPushMode ),
+	OA_DL_END
+};
+
+#if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "lib" TT_SOLIB ".dylib",
+		enumSymbols, otherSymbols );
+#else
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "lib" TT_SOLIB ".so.1",
+		enumSymbols, otherSymbols );
+#endif
+
 #ifdef	TT_PATCH_BINARY
 static void			_patchLibrary ( void* );
 #endif
 
 /**
- * Cycle through the list of cameras returned by the library
+ * Only the calls needed to enumerate cameras are resolved here
  */
 
 int
 TT_FUNC( _, InitLibraryFunctionPointers )( void )
 {
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
+	int							ret;
 #ifdef	TT_PATCH_BINARY
-	int							oalib;
-#endif
-
-#if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-  const char*		libName = "lib" TT_SOLIB ".dylib";
-#else
-  const char*		libName = "lib" TT_SOLIB ".so.1";
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
-#endif
-
-	*libPath = 0;
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
-#endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
-#endif
-      oaLogInfo ( OA_LOG_CAMERA, "%s: can't load %s: error '%s'", __func__,
-					libPath, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-	  dlerror();
-
-	  if (!( *( void** )( &TT_LIB_PTR( AwbInit )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_AwbInit" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( AwbOnePush )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_AwbOnePush" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( calc_ClarityFactor )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_calc_ClarityFactor" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( Close )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Close" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-		/*
-	  if (!( *( void** )( &TT_LIB_PTR( deBayerV2 )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_deBayerV2" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-		 */
-
-	  if (!( *( void** )( &TT_LIB_PTR( EnumV2 )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_EnumV2" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( Flush )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Flush" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_AEAuxRect )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_AEAuxRect" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_AutoExpoEnable )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_get_AutoExpoEnable" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_AutoExpoTarget )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_get_AutoExpoTarget" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_AWBAuxRect )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_AWBAuxRect" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Brightness )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Brightness" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Chrome )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Chrome" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Contrast )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Contrast" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_eSize )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_eSize" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_ExpoAGain )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_ExpoAGain" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_ExpoAGainRange )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_get_ExpoAGainRange" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_ExpoTime )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_ExpoTime" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_ExpTimeRange )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_ExpTimeRange" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( get_FanMaxSpeed )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_FanMaxSpeed" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Field )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Field" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_FwVersion )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_FwVersion" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Gamma )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Gamma" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_HFlip )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_HFlip" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( GetHistogram )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_GetHistogram" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Hue )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Hue" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_HwVersion )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_HwVersion" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_HZ )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_HZ" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_LevelRange )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_LevelRange" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_MaxBitDepth )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_MaxBitDepth" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_MaxSpeed )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_MaxSpeed" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Mode )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_MonoMode )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_MonoMode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Negative )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Negative" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Option )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Option" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( get_PixelSize )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_PixelSize" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_ProductionDate )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_get_ProductionDate" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_RawFormat )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_RawFormat" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_RealTime )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_RealTime" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Resolution )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Resolution" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_ResolutionNumber )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_get_ResolutionNumber" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_ResolutionRatio )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_get_ResolutionRatio" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Roi )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Roi" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( get_RoiMode )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_RoiMode" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Saturation )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Saturation" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_SerialNumber )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_get_SerialNumber" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Size )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Size" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Speed )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Speed" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_StillResolution )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_get_StillResolution" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_StillResolutionNumber )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_get_StillResolutionNumber" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_Temperature )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_Temperature" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_TempTint )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_TempTint" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_VFlip )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_VFlip" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( get_VignetAmountInt )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_get_VignetAmountInt" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_VignetEnable )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_get_VignetEnable" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_VignetMidPointInt )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_get_VignetMidPointInt" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
-
-	  if (!( *( void** )( &TT_LIB_PTR( get_WhiteBalanceGain )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_get_WhiteBalanceGain" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( HotPlug )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_HotPlug" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( LevelRangeAuto )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_LevelRangeAuto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( Open )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Open" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( OpenByIndex )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_OpenByIndex" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( Pause )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Pause" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-#ifndef NO_V2_IMAGE_FUNCS
-	  if (!( *( void** )( &TT_LIB_PTR( PullImageV2 )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_PullImageV2" ))) {
-#endif
-			// If this one is missing, perhaps we have vanilla PullImage from
-			// the earlier library versions?
-			TT_LIB_PTR( PullImageV2 ) = 0;
-			if (!( *( void** )( &TT_LIB_PTR( PullImage )) = _getDLSym ( libHandle,
-					TT_LIB_PREFIX "_PullImage" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-				return OA_ERR_SYMBOL_NOT_FOUND;
-			}
-#ifndef NO_V2_IMAGE_FUNCS
-	  }
-#endif
-
-#ifndef NO_V2_IMAGE_FUNCS
-	  if (!( *( void** )( &TT_LIB_PTR( PullStillImageV2 )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_PullStillImageV2" ))) {
-#endif
-			// If this one is missing, perhaps we have vanilla PullStillImage from
-			// the earlier library versions?
-			TT_LIB_PTR( PullStillImageV2 ) = 0;
-			if (!( *( void** )( &TT_LIB_PTR( PullStillImage )) =
-					_getDLSym ( libHandle, TT_LIB_PREFIX "_PullStillImage" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-				return OA_ERR_SYMBOL_NOT_FOUND;
-			}
-#ifndef NO_V2_IMAGE_FUNCS
-	  }
-#endif
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_AEAuxRect )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_AEAuxRect" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_AutoExpoEnable )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_put_AutoExpoEnable" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_AutoExpoTarget )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_put_AutoExpoTarget" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_AWBAuxRect )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_AWBAuxRect" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Brightness )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Brightness" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Chrome )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Chrome" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-		/*
-		 * Deprecated as of v39.<something>
-		 *
-	  if (!( *( void** )( &TT_LIB_PTR( put_ChromeCallback )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_put_ChromeCallback" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-		 */
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Contrast )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Contrast" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_eSize )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_eSize" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_ExpoAGain )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_ExpoAGain" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-		/*
-		 * Deprecated as of v39.<something>
-		 *
-	  if (!( *( void** )( &TT_LIB_PTR( put_ExpoCallback )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_ExpoCallback" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-		 */
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_ExpoTime )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_ExpoTime" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Gamma )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Gamma" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_HFlip )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_HFlip" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Hue )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Hue" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_HZ )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_HZ" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_LEDState )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_LEDState" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_LevelRange )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_LevelRange" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_MaxAutoExpoTimeAGain )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_put_MaxAutoExpoTimeAGain" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Mode )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Negative )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Negative" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Option )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Option" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_RealTime )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_RealTime" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Roi )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Roi" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( put_RoiMode )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_RoiMode" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Saturation )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Saturation" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Size )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Size" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Speed )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Speed" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_Temperature )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_Temperature" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_TempTint )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_TempTint" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_VFlip )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_VFlip" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( put_VignetAmountInt )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_put_VignetAmountInt" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_VignetEnable )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_put_VignetEnable" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_VignetMidPointInt )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_put_VignetMidPointInt" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
-
-	  if (!( *( void** )( &TT_LIB_PTR( put_WhiteBalanceGain )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_put_WhiteBalanceGain" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( read_EEPROM )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_read_EEPROM" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( read_UART )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_read_UART" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
-
-	  if (!( *( void** )( &TT_LIB_PTR( Snap )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Snap" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( ST4PlusGuide )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_ST4PlusGuide" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( ST4PlusGuideState )) =
-				_getDLSym ( libHandle, TT_LIB_PREFIX "_ST4PlusGuideState" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( StartPullModeWithCallback )) = _getDLSym (
-	      libHandle, TT_LIB_PREFIX "_StartPullModeWithCallback" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-#ifndef NO_V2_IMAGE_FUNCS
-	  if (!( *( void** )( &TT_LIB_PTR( StartPushModeV2 )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_StartPushModeV2" ))) {
-#endif
-			// If this one is missing, perhaps we have vanilla StartPushMode from
-			// the earlier library versions?
-			TT_LIB_PTR( StartPushModeV2 ) = 0;
-			if (!( *( void** )( &TT_LIB_PTR( StartPushMode )) =
-					_getDLSym ( libHandle, TT_LIB_PREFIX "_StartPushMode" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-				return OA_ERR_SYMBOL_NOT_FOUND;
-			}
-#ifndef NO_V2_IMAGE_FUNCS
-	  }
+	static int			patched = 0;
+	unsigned				( *p_Toupcam_EnumV2 )( TT_VAR_TYPE( DeviceV2* ));
 #endif
 
-	  if (!( *( void** )( &TT_LIB_PTR( Stop )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Stop" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( Trigger )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Trigger" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( Version )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_Version" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  if (!( *( void** )( &TT_LIB_PTR( write_EEPROM )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_write_EEPROM" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-
-	  /*
-	  if (!( *( void** )( &TT_LIB_PTR( write_UART )) = _getDLSym ( libHandle,
-	      TT_LIB_PREFIX "_write_UART" ))) {
-				dlclose ( libHandle );
-				libHandle = 0;
-	    return OA_ERR_SYMBOL_NOT_FOUND;
-	  }
-	   */
+	if (( ret = oacamDLLoad ( &lib, OA_DL_ENUMERATE )) != OA_ERR_NONE ) {
+		return ret;
+	}
 
 #ifdef	TT_PATCH_BINARY
-		oalib = !strcmp ( "32.13483.20181206", TT_LIB_PTR( Version()));
-	  if ( oalib ) {
-			unsigned				( *p_Toupcam_EnumV2 )( TT_VAR_TYPE( DeviceV2* ));
-			if (( *( void** )( &p_Toupcam_EnumV2 ) = _getDLSym ( libHandle,
-				  "_Z14Toupcam_EnumV2P13ToupcamDeviceV2" ))) {
+	pthread_mutex_lock ( &lib.lock );
+	if ( !patched ) {
+		patched = 1;
+		if ( !strcmp ( "32.13483.20181206", TT_LIB_PTR( Version()))) {
+			dlerror();
+			if (( *( void** )( &p_Toupcam_EnumV2 ) = dlsym ( lib.handle,
+					"_Z14Toupcam_EnumV2P13ToupcamDeviceV2" )) && !dlerror()) {
 				// Now comes the really ugly bit.  Patch the data section of the loaded
 				// Touptek library to match the new USB product IDs.  Actually, this
 				// probably even gives "ugly" a bad name.
 				_patchLibrary ( p_Toupcam_EnumV2 );
 			}
 		}
-#endif	/* TT_PATCH_BINARY */
 	}
-	
+	pthread_mutex_unlock ( &lib.lock );
+#endif	/* TT_PATCH_BINARY */
+
 	return OA_ERR_NONE;
 }
 
 
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+int
+TT_FUNC( _, InitAllLibraryFunctionPointers )( void )
 {
-  void* addr;
-  char* error;
+	int			ret;
 
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogWarning ( OA_LOG_CAMERA, "%s: lib" TT_SOLIB " DL error: %s", __func__,
-				error );
-    addr = 0;
-  }
+	if (( ret = oacamDLLoad ( &lib, OA_DL_ALL )) != OA_ERR_NONE ) {
+		return ret;
+	}
+
+	if (!( TT_LIB_PTR( PullImageV2 ) || TT_LIB_PTR( PullImage )) ||
+			!( TT_LIB_PTR( PullStillImageV2 ) || TT_LIB_PTR( PullStillImage )) ||
+			!( TT_LIB_PTR( StartPushModeV2 ) || TT_LIB_PTR( StartPushMode ))) {
+		oaLogError ( OA_LOG_CAMERA, "%s: lib" TT_SOLIB
+				" has neither version of an image function", __func__ );
+		return OA_ERR_SYMBOL_NOT_FOUND;
+	}
 
-  return addr;
+	return OA_ERR_NONE;
 }
 
 
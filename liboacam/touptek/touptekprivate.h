@@ -49,6 +49,7 @@
 #endif
 
 extern int				TT_FUNC( _, InitLibraryFunctionPointers )( void );
+extern int				TT_FUNC( _, InitAllLibraryFunctionPointers )( void );
 
 extern const char*	( *TT_LIB_PTR( Version ))();
 extern unsigned		( *TT_LIB_PTR( EnumV2 ))( TT_VAR_TYPE ( DeviceV2* ));
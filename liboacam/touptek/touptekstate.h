@@ -45,8 +45,6 @@ typedef struct Touptek_STATE {
   int			maxBytesPerPixel;
   float			currentBytesPerPixel;
   int			currentVideoFormat;
-  // buffering for image transfers
-  frameBuffer*	buffers;
   // camera status
   unsigned int		currentXResolution;
   unsigned int		currentYResolution;
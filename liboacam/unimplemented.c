@@ -212,6 +212,7 @@ _oaInitCameraFunctionPointers ( oaCamera* camera )
   camera->funcs.startStreaming = oacamStartStreaming;
   camera->funcs.stopStreaming = oacamStopStreaming;
   camera->funcs.isStreaming = oacamIsStreaming;
+  camera->funcs.startStreamingLeased = oacamStartStreamingLeased;
 
   camera->funcs.setResolution = oacamSetResolution;
   camera->funcs.setROI = oacamSetROI;
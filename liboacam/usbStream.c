@@ -0,0 +1,408 @@
+/*****************************************************************************
+ *
+ * usbStream.c -- persistent libusb bulk streaming shared by the USB drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+#include <libusb-1.0/libusb.h>
+
+#include <openastro/camera.h>
+#include <openastro/util.h>
+
+#include "oacamprivate.h"
+#include "sharedState.h"
+#include "usbStream.h"
+
+
+static void LIBUSB_CALL	_transferDone ( struct libusb_transfer* );
+
+
+void
+oacamUsbStreamInit ( OA_USB_STREAM* stream )
+{
+	pthread_mutex_init ( &stream->mutex, 0 );
+	pthread_cond_init ( &stream->idle, 0 );
+	stream->cameraInfo = 0;
+	stream->headroom = 0;
+	stream->allocated = 0;
+	stream->streaming = 0;
+	stream->inFlight = 0;
+}
+
+
+// Called with the stream mutex held.  Transfers complete in the order
+// they were submitted, so the next one's data comes after the data
+// already received and whatever the transfers still in flight bring.
+
+static int
+_landingFree ( OA_USB_STREAM* stream, unsigned int n, size_t landAt )
+{
+	OA_USB_TRANSFER*	t;
+	unsigned int			i;
+
+	for ( i = 0; i < stream->allocated; i++ ) {
+		t = &stream->transfers[i];
+		if ( t->active && t->landing == ( int ) n &&
+				t->landAt < landAt + stream->transferSize &&
+				landAt < t->landAt + stream->transferSize ) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+
+// The transfer is pointed at the place in the frame buffers where its
+// data is expected if that buffer is free and no other transfer is due
+// to land on the same bytes, and at its staging buffer if not.
+
+static int
+_submit ( OA_USB_STREAM* stream, OA_USB_TRANSFER* t )
+{
+	SHARED_STATE*		cameraInfo = stream->cameraInfo;
+	uint64_t				position, offset, slot;
+	size_t					dataLength, landAt;
+	unsigned int		n;
+	unsigned char*	target = 0;
+	int							ret;
+
+	// When a transfer can hold a whole frame the camera ends each one at
+	// the end of a frame, so every transfer in flight is good for the rest
+	// of one frame however much of it has arrived.  Otherwise the data is
+	// expected to follow on from what the transfers in flight asked for.
+
+	dataLength = stream->transferSize - stream->headroom;
+	if ( dataLength >= stream->frameLength ) {
+		position = stream->inFlight ? stream->inFlight * stream->frameLength :
+				*stream->received;
+	} else {
+		position = *stream->received + stream->pendingBytes;
+	}
+	slot = position / stream->frameLength;
+	offset = position % stream->frameLength;
+
+	// Drivers with payload headers only land transfers at the start of a
+	// frame, where the header goes in the space reserved for it rather than
+	// over data already assembled
+
+	if ( slot < ( uint64_t ) OA_BUFFERS_FREE ( cameraInfo ) &&
+			( !stream->frameOffset || !offset ) &&
+			stream->headroom <= stream->frameOffset + offset ) {
+		n = ( cameraInfo->nextBuffer + slot ) % cameraInfo->configuredBuffers;
+		landAt = stream->frameOffset + offset - stream->headroom;
+		if ( landAt + stream->transferSize <= cameraInfo->buffers[ n ].length &&
+				_landingFree ( stream, n, landAt )) {
+			target = ( unsigned char* ) cameraInfo->buffers[ n ].start + landAt;
+			t->landing = n;
+			t->landAt = landAt;
+			stream->landings[ n ]++;
+			stream->directTransfers++;
+		}
+	}
+
+	if ( !target ) {
+		if ( t->stagingSize < stream->transferSize ) {
+			free (( void* ) t->staging );
+			if (!( t->staging = malloc ( stream->transferSize ))) {
+				t->stagingSize = 0;
+				oaLogError ( OA_LOG_CAMERA, "%s: malloc of staging buffer failed",
+						__func__ );
+				return -OA_ERR_MEM_ALLOC;
+			}
+			t->stagingSize = stream->transferSize;
+		}
+		target = t->staging;
+		stream->stagedTransfers++;
+	}
+
+	// Counting the most the transfer can bring means data from the ones
+	// before never reaches past where a later one lands
+
+	t->requested = dataLength;
+	stream->pendingBytes += t->requested;
+
+	libusb_fill_bulk_transfer ( t->transfer, stream->handle, stream->endpoint,
+			target, stream->transferSize, _transferDone, t, stream->timeout );
+	if (( ret = libusb_submit_transfer ( t->transfer ))) {
+		stream->pendingBytes -= t->requested;
+		if ( t->landing >= 0 ) {
+			stream->landings[ t->landing ]--;
+			t->landing = -1;
+		}
+		oaLogError ( OA_LOG_CAMERA, "%s: submit failed, error %d (%s)",
+				__func__, ret, libusb_error_name ( ret ));
+		return -OA_ERR_CAMERA_IO;
+	}
+	t->active = 1;
+	stream->inFlight++;
+	return OA_ERR_NONE;
+}
+
+
+static void LIBUSB_CALL
+_transferDone ( struct libusb_transfer* transfer )
+{
+	OA_USB_TRANSFER*	t = transfer->user_data;
+	OA_USB_STREAM*		stream = t->stream;
+	int								resubmit = 0;
+
+	pthread_mutex_lock ( &stream->mutex );
+	stream->pendingBytes -= t->requested;
+	if ( t->landing >= 0 ) {
+		stream->landings[ t->landing ]--;
+		t->landing = -1;
+	}
+	pthread_mutex_unlock ( &stream->mutex );
+
+	switch ( transfer->status ) {
+
+		case LIBUSB_TRANSFER_COMPLETED:
+			if ( transfer->num_iso_packets == 0 ) { // bulk mode transfer
+				stream->payload ( stream->payloadArg, transfer->buffer,
+						transfer->actual_length );
+			} else {
+				oaLogError ( OA_LOG_CAMERA, "%s: Unexpected isochronous transfer",
+						__func__ );
+			}
+			resubmit = 1;
+			break;
+
+		case LIBUSB_TRANSFER_CANCELLED:
+		case LIBUSB_TRANSFER_ERROR:
+		case LIBUSB_TRANSFER_NO_DEVICE:
+			break;
+
+		case LIBUSB_TRANSFER_TIMED_OUT:
+			resubmit = 1;
+			break;
+
+		case LIBUSB_TRANSFER_STALL:
+		case LIBUSB_TRANSFER_OVERFLOW:
+			oaLogError ( OA_LOG_CAMERA, "%s: retrying transfer, status = %d (%s)",
+					__func__, transfer->status,
+					libusb_error_name ( transfer->status ));
+			resubmit = 1;
+			break;
+	}
+
+	pthread_mutex_lock ( &stream->mutex );
+	t->active = 0;
+	stream->inFlight--;
+	if ( resubmit && stream->streaming ) {
+		( void ) _submit ( stream, t );
+	}
+	if ( !stream->inFlight ) {
+		pthread_cond_broadcast ( &stream->idle );
+	}
+	pthread_mutex_unlock ( &stream->mutex );
+}
+
+
+int
+oacamUsbStreamStart ( OA_USB_STREAM* stream, SHARED_STATE* cameraInfo,
+		libusb_device_handle* handle, unsigned char endpoint,
+		unsigned int timeout, size_t transferSize, unsigned int numTransfers,
+		size_t frameLength, size_t frameOffset, unsigned int* received,
+		OA_USB_PAYLOAD_CB payload, void* payloadArg )
+{
+	OA_USB_TRANSFER*	t;
+	unsigned int			i;
+
+	if ( !transferSize || !frameLength ) {
+		return -OA_ERR_INVALID_SIZE;
+	}
+	if ( numTransfers < 1 ) {
+		numTransfers = 1;
+	}
+	if ( numTransfers > OA_USB_STREAM_MAX_TRANSFERS ) {
+		numTransfers = OA_USB_STREAM_MAX_TRANSFERS;
+	}
+
+	pthread_mutex_lock ( &stream->mutex );
+	if ( stream->streaming || stream->inFlight ) {
+		pthread_mutex_unlock ( &stream->mutex );
+		return -OA_ERR_INVALID_COMMAND;
+	}
+
+	// Transfers already allocated by an earlier stream are reused as they
+	// are, along with any staging buffers big enough for this one
+
+	for ( i = stream->allocated; i < numTransfers; i++ ) {
+		t = &stream->transfers[i];
+		if (!( t->transfer = libusb_alloc_transfer ( 0 ))) {
+			break;
+		}
+		t->stream = stream;
+		t->staging = 0;
+		t->stagingSize = 0;
+		t->landing = -1;
+		t->active = 0;
+		stream->allocated++;
+	}
+	if ( !stream->allocated ) {
+		pthread_mutex_unlock ( &stream->mutex );
+		oaLogError ( OA_LOG_CAMERA, "%s: libusb_alloc_transfer failed",
+				__func__ );
+		return -OA_ERR_MEM_ALLOC;
+	}
+	if ( numTransfers > stream->allocated ) {
+		numTransfers = stream->allocated;
+	}
+
+	stream->cameraInfo = cameraInfo;
+	stream->handle = handle;
+	stream->endpoint = endpoint;
+	stream->timeout = timeout;
+	stream->transferSize = transferSize;
+	stream->frameLength = frameLength;
+	stream->frameOffset = frameOffset;
+	if ( stream->headroom > frameOffset || stream->headroom >= transferSize ) {
+		stream->headroom = 0;
+	}
+	stream->received = received;
+	stream->payload = payload;
+	stream->payloadArg = payloadArg;
+	stream->numTransfers = numTransfers;
+	stream->pendingBytes = 0;
+	stream->directTransfers = stream->stagedTransfers = 0;
+	for ( i = 0; i < OA_CAM_MAX_BUFFERS; i++ ) {
+		stream->landings[i] = 0;
+	}
+	stream->streaming = 1;
+
+	for ( i = 0; i < numTransfers; i++ ) {
+		if ( _submit ( stream, &stream->transfers[i] ) != OA_ERR_NONE ) {
+			break;
+		}
+	}
+	if ( !stream->inFlight ) {
+		stream->streaming = 0;
+		pthread_mutex_unlock ( &stream->mutex );
+		return -OA_ERR_CAMERA_IO;
+	}
+	if ( i < numTransfers ) {
+		oaLogWarning ( OA_LOG_CAMERA, "%s: only %u of %u transfers submitted",
+				__func__, i, numTransfers );
+	}
+	pthread_mutex_unlock ( &stream->mutex );
+
+	return OA_ERR_NONE;
+}
+
+
+void
+oacamUsbStreamStop ( OA_USB_STREAM* stream )
+{
+	OA_USB_TRANSFER*	t;
+	unsigned int			i;
+	int								ret;
+
+	pthread_mutex_lock ( &stream->mutex );
+	stream->streaming = 0;
+	for ( i = 0; i < stream->allocated; i++ ) {
+		t = &stream->transfers[i];
+		if ( t->active ) {
+			ret = libusb_cancel_transfer ( t->transfer );
+			if ( ret < 0 && ret != LIBUSB_ERROR_NOT_FOUND ) {
+				// It isn't coming back
+				if ( t->landing >= 0 ) {
+					stream->landings[ t->landing ]--;
+					t->landing = -1;
+				}
+				stream->pendingBytes -= t->requested;
+				t->active = 0;
+				stream->inFlight--;
+			}
+		}
+	}
+	while ( stream->inFlight ) {
+		pthread_cond_wait ( &stream->idle, &stream->mutex );
+	}
+	oaLogDebug ( OA_LOG_CAMERA, "%s: %llu transfers landed in place, %llu staged",
+			__func__, ( unsigned long long ) stream->directTransfers,
+			( unsigned long long ) stream->stagedTransfers );
+	pthread_mutex_unlock ( &stream->mutex );
+}
+
+
+// Only for use once the event handler thread has gone, so any transfer
+// still active at this point will never complete and is left alone
+
+void
+oacamUsbStreamFree ( OA_USB_STREAM* stream )
+{
+	OA_USB_TRANSFER*	t;
+	unsigned int			i;
+
+	pthread_mutex_lock ( &stream->mutex );
+	stream->streaming = 0;
+	for ( i = 0; i < stream->allocated; i++ ) {
+		t = &stream->transfers[i];
+		if ( t->active ) {
+			oaLogWarning ( OA_LOG_CAMERA, "%s: transfer %u still active", __func__,
+					i );
+			continue;
+		}
+		libusb_free_transfer ( t->transfer );
+		free (( void* ) t->staging );
+		t->transfer = 0;
+		t->staging = 0;
+		t->stagingSize = 0;
+	}
+	stream->allocated = 0;
+	pthread_mutex_unlock ( &stream->mutex );
+}
+
+
+void
+oacamUsbStreamSetHeadroom ( OA_USB_STREAM* stream, size_t headroom )
+{
+	pthread_mutex_lock ( &stream->mutex );
+	if ( headroom <= stream->frameOffset && headroom < stream->transferSize ) {
+		stream->headroom = headroom;
+	}
+	pthread_mutex_unlock ( &stream->mutex );
+}
+
+
+int
+oacamUsbStreamBufferBusy ( OA_USB_STREAM* stream, unsigned int n )
+{
+	int		busy;
+
+	pthread_mutex_lock ( &stream->mutex );
+	busy = stream->landings[ n ] ? 1 : 0;
+	pthread_mutex_unlock ( &stream->mutex );
+	return busy;
+}
+
+
+unsigned char*
+oacamUsbStreamFrameStart ( OA_USB_STREAM* stream, unsigned int n )
+{
+	return ( unsigned char* ) stream->cameraInfo->buffers[ n ].start +
+			stream->frameOffset;
+}
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ *
+ * usbStream.h -- persistent libusb bulk streaming shared by the USB drivers
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OA_CAMERA_USB_STREAM_H
+#define OA_CAMERA_USB_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <libusb-1.0/libusb.h>
+
+#include <openastro/controller.h>
+
+#define	OA_USB_STREAM_MAX_TRANSFERS		100
+
+// Bytes reserved at the start of each frame buffer by drivers whose
+// payloads carry a header in front of the image data, so that a transfer
+// can land with its header in the reserved space and its data exactly
+// where the frame starts
+
+#define	OA_USB_STREAM_HEADROOM				64
+
+struct SHARED_STATE;
+struct OA_USB_STREAM;
+
+typedef void	( *OA_USB_PAYLOAD_CB )( void*, unsigned char*, unsigned int );
+
+typedef struct OA_USB_TRANSFER {
+	struct OA_USB_STREAM*			stream;
+	struct libusb_transfer*		transfer;
+	unsigned char*						staging;
+	size_t										stagingSize;
+	uint64_t									requested;
+	int												landing;
+	size_t										landAt;
+	int												active;
+} OA_USB_TRANSFER;
+
+typedef struct OA_USB_STREAM {
+	pthread_mutex_t						mutex;
+	pthread_cond_t						idle;
+	struct SHARED_STATE*			cameraInfo;
+	libusb_device_handle*			handle;
+	unsigned char							endpoint;
+	unsigned int							timeout;
+	OA_USB_PAYLOAD_CB					payload;
+	void*											payloadArg;
+	size_t										transferSize;
+	size_t										frameLength;
+	size_t										frameOffset;
+	size_t										headroom;
+	unsigned int*							received;
+	unsigned int							numTransfers;
+	unsigned int							allocated;
+	int												streaming;
+	unsigned int							inFlight;
+	uint64_t									pendingBytes;
+	unsigned int							landings[ OA_CAM_MAX_BUFFERS ];
+	uint64_t									directTransfers;
+	uint64_t									stagedTransfers;
+	OA_USB_TRANSFER						transfers[ OA_USB_STREAM_MAX_TRANSFERS ];
+} OA_USB_STREAM;
+
+// The transfers and their staging buffers live for as long as the camera
+// is open and are reused by every stream started on it.  Where the next
+// transfer's data is due to land in a free frame buffer the transfer is
+// pointed straight at that spot, otherwise it is read into its staging
+// buffer.  Either way the payload callback gets a pointer to the data and
+// only has to copy it when that isn't already where the frame is being
+// assembled, and it must not write into a buffer for which
+// oacamUsbStreamBufferBusy() is true.  The stream works out where data is
+// due from the driver's nextBuffer and count of bytes received, so both
+// are only changed from the payload callback while streaming.
+//
+// frameLength is the stride between frames in the stream, which must not
+// be more than the frame buffers hold.  frameOffset is where the frame
+// data starts in each buffer (OA_USB_STREAM_HEADROOM for drivers that
+// need it) and received points at the driver's count of bytes assembled
+// so far for the current frame.  oacamUsbStreamSetHeadroom() tells the
+// stream how long the payload headers are once the driver has seen one.
+
+extern void		oacamUsbStreamInit ( OA_USB_STREAM* );
+extern int		oacamUsbStreamStart ( OA_USB_STREAM*, struct SHARED_STATE*,
+									libusb_device_handle*, unsigned char, unsigned int,
+									size_t, unsigned int, size_t, size_t, unsigned int*,
+									OA_USB_PAYLOAD_CB, void* );
+extern void		oacamUsbStreamStop ( OA_USB_STREAM* );
+extern void		oacamUsbStreamFree ( OA_USB_STREAM* );
+extern void		oacamUsbStreamSetHeadroom ( OA_USB_STREAM*, size_t );
+extern int		oacamUsbStreamBufferBusy ( OA_USB_STREAM*, unsigned int );
+extern unsigned char*	oacamUsbStreamFrameStart ( OA_USB_STREAM*,
+									unsigned int );
+
+#endif	/* OA_CAMERA_USB_STREAM_H */
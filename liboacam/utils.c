@@ -129,11 +129,18 @@ _oaInitCameraStructs ( oaCamera** camera, void** state, size_t stateSize,
 	pthread_mutex_init ( &p_state->commandQueueMutex, 0 );
 	pthread_mutex_init ( &p_state->callbackQueueMutex, 0 );
 	pthread_mutex_init ( &p_state->timerMutex, 0 );
-	pthread_cond_init ( &p_state->callbackQueued, 0 );
 	pthread_cond_init ( &p_state->commandQueued, 0 );
 	pthread_cond_init ( &p_state->commandComplete, 0 );
 	pthread_cond_init ( &p_state->timerState, 0 );
 	p_state->timerActive = 0;
+	oacamAsyncControlsInit ( p_state );
+	oacamControlCacheInit ( p_state );
+	oacamSoftBinningInit ( p_state );
+	oacamCameraStatsInit ( p_state );
+	oacamExposureSequenceInit ( p_state );
+	oacamReconnectInit ( p_state );
+	oacamBandwidthTunerInit ( p_state );
+	oacamClaimParkedBuffers ( p_state );
 
 	return OA_ERR_NONE;
 }
@@ -188,6 +188,11 @@ oaUVCInitCamera ( oaCameraDevice* device )
   UVC_STATE*				cameraInfo;
   COMMON_INFO*				commonInfo;
 	void*							tmpPtr;
+	if ( _uvcInitAllLibraryFunctionPointers() != OA_ERR_NONE ) {
+		oaLogError ( OA_LOG_CAMERA, "%s: can't resolve SDK functions", __func__ );
+		return 0;
+	}
+
 
 	if ( _oaInitCameraStructs ( &camera, ( void* ) &cameraInfo,
 			sizeof ( UVC_STATE ), &commonInfo ) != OA_ERR_NONE ) {
@@ -1107,54 +1112,39 @@ oaUVCInitCamera ( oaCameraDevice* device )
   cameraInfo->buffers = 0;
   cameraInfo->imageBufferLength = cameraInfo->maxResolutionX *
       cameraInfo->maxResolutionY * cameraInfo->maxBytesPerPixel;
-  cameraInfo->buffers = calloc ( OA_CAM_BUFFERS, sizeof ( frameBuffer ));
-  for ( i = 0; i < OA_CAM_BUFFERS; i++ ) {
-    void* m = malloc ( cameraInfo->imageBufferLength );
-    if ( m ) {
-      cameraInfo->buffers[i].start = m;
-      cameraInfo->configuredBuffers++;
-    } else {
-      oaLogError ( OA_LOG_CAMERA, "%s malloc of buffers failed", __func__ );
-      if ( i ) {
-        for ( j = 0; j < i; j++ ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-      p_uvc_close ( uvcHandle );
-      p_uvc_exit ( cameraInfo->uvcContext );
-      free (( void* ) cameraInfo->frameSizes[1].sizes );
-      free (( void* ) cameraInfo->buffers );
-      FREE_DATA_STRUCTS;
-      return 0;
-    }
+  if ( oacamAllocBuffers (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->imageBufferLength ) != OA_ERR_NONE ) {
+    oaLogError ( OA_LOG_CAMERA, "%s malloc of buffers failed", __func__ );
+    p_uvc_close ( uvcHandle );
+    p_uvc_exit ( cameraInfo->uvcContext );
+    free (( void* ) cameraInfo->frameSizes[1].sizes );
+    FREE_DATA_STRUCTS;
+    return 0;
   }
 
   cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
   cameraInfo->nextBuffer = 0;
-  cameraInfo->configuredBuffers = OA_CAM_BUFFERS;
-  cameraInfo->buffersFree = OA_CAM_BUFFERS;
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamUVCcontroller, ( void* ) camera )) {
     p_uvc_close ( uvcHandle );
     p_uvc_exit ( cameraInfo->uvcContext );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     oaLogError ( OA_LOG_CAMERA, "%s: controller thread creation failed",
 				__func__ );
     return 0;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamUVCcallbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -1163,13 +1153,10 @@ oaUVCInitCamera ( oaCameraDevice* device )
     pthread_join ( cameraInfo->controllerThread, &dummy );
     p_uvc_close ( uvcHandle );
     p_uvc_exit ( cameraInfo->uvcContext );
-    for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-      free (( void* ) cameraInfo->buffers[j].start );
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
-    free (( void* ) cameraInfo->buffers );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     oaLogError ( OA_LOG_CAMERA, "%s: callback thread creation failed",
 				__func__ );
@@ -1308,7 +1295,6 @@ _getUVCControlValues ( oaCamera* camera, uvc_device_handle_t* uvcHandle,
 int
 oaUVCCloseCamera ( oaCamera* camera )
 {
-  int		j;
   void*		dummy;
   UVC_STATE*	cameraInfo;
 
@@ -1321,18 +1307,12 @@ oaUVCCloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     p_uvc_close ( cameraInfo->uvcHandle );
 
-    if ( cameraInfo->buffers ) {
-      for ( j = 0; j < OA_CAM_BUFFERS; j++ ) {
-        if ( cameraInfo->buffers[j].start ) {
-          free (( void* ) cameraInfo->buffers[j].start );
-        }
-      }
-    }
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
 
     if ( cameraInfo->frameRates.numRates ) {
      free (( void* ) cameraInfo->frameRates.rates );
@@ -1340,9 +1320,8 @@ oaUVCCloseCamera ( oaCamera* camera )
     free (( void* ) cameraInfo->frameSizes[1].sizes );
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
-    free (( void* ) cameraInfo->buffers );
     free (( void* ) cameraInfo );
     free (( void* ) camera->_common );
     free (( void* ) camera );
@@ -133,9 +133,7 @@ _UVCFrameCallback ( uvc_frame_t *frame, void *ptr )
   int		buffersFree, nextBuffer;
   unsigned int	dataLength;
 
-  pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-  buffersFree = cameraInfo->buffersFree;
-  pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+  buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
   if ( buffersFree && frame->data_bytes ) {
     if (( dataLength = frame->data_bytes ) > cameraInfo->currentFrameLength ) {
@@ -144,6 +142,8 @@ _UVCFrameCallback ( uvc_frame_t *frame, void *ptr )
     nextBuffer = cameraInfo->nextBuffer;
     ( void ) memcpy ( cameraInfo->buffers[ nextBuffer ].start, frame->data,
         dataLength );
+    cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+        oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
     cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
         OA_CALLBACK_NEW_FRAME;
     cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -153,13 +153,12 @@ _UVCFrameCallback ( uvc_frame_t *frame, void *ptr )
     cameraInfo->frameCallbacks[ nextBuffer ].buffer =
         cameraInfo->buffers[ nextBuffer ].start;
     cameraInfo->frameCallbacks[ nextBuffer ].bufferLen = dataLength;
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    oaDLListAddToTail ( cameraInfo->callbackQueue,
+    oacamCallbackRingPush ( &cameraInfo->callbackRing,
         &cameraInfo->frameCallbacks[ nextBuffer ]);
-    cameraInfo->buffersFree--;
+    OA_CLAIM_BUFFER ( cameraInfo );
     cameraInfo->nextBuffer = ( nextBuffer + 1 ) % cameraInfo->configuredBuffers;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+  } else if ( frame->data_bytes ) {
+    OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
   }
 }
 
@@ -841,9 +840,7 @@ _processStreamingStop ( UVC_STATE* cameraInfo, OA_COMMAND* command )
 
   queueEmpty = 0;
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( OA_CAM_BUFFERS == cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+    queueEmpty = ( cameraInfo->configuredBuffers == OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
     if ( !queueEmpty ) {
       usleep ( 100 );
     }
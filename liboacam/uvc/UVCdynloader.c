@@ -43,6 +43,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "UVCprivate.h"
 
 
@@ -176,952 +177,163 @@ uvc_frame_t* ( *p_uvc_allocate_frame )( size_t );
 void				( *p_uvc_free_frame )( uvc_frame_t* );
 
 #if HAVE_LIBDL && !HAVE_STATIC_LIBUVC
-static void*    _getDLSym ( void*, const char* );
-#endif
 
-int
-_uvcInitLibraryFunctionPointers ( void )
-{
-#if HAVE_LIBDL && !HAVE_STATIC_LIBUVC
-  static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( uvc_init ),
+	OA_DL_SYM( uvc_exit ),
+	OA_DL_SYM( uvc_get_device_list ),
+	OA_DL_SYM( uvc_free_device_list ),
+	OA_DL_SYM( uvc_get_device_descriptor ),
+	OA_DL_SYM( uvc_free_device_descriptor ),
+	OA_DL_SYM( uvc_get_bus_number ),
+	OA_DL_SYM( uvc_get_device_address ),
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( uvc_find_device ),
+	OA_DL_SYM( uvc_find_devices ),
+	OA_DL_SYM( uvc_open ),
+	OA_DL_SYM( uvc_close ),
+	OA_DL_SYM( uvc_get_device ),
+	OA_DL_SYM( uvc_get_libusb_handle ),
+	OA_DL_SYM( uvc_ref_device ),
+	OA_DL_SYM( uvc_unref_device ),
+	OA_DL_SYM( uvc_set_status_callback ),
+	OA_DL_SYM( uvc_set_button_callback ),
+	OA_DL_SYM( uvc_get_camera_terminal ),
+	OA_DL_SYM( uvc_get_input_terminals ),
+	OA_DL_SYM( uvc_get_output_terminals ),
+	OA_DL_SYM( uvc_get_selector_units ),
+	OA_DL_SYM( uvc_get_processing_units ),
+	OA_DL_SYM( uvc_get_extension_units ),
+	OA_DL_SYM( uvc_get_stream_ctrl_format_size ),
+	OA_DL_SYM( uvc_get_format_descs ),
+	OA_DL_SYM( uvc_probe_stream_ctrl ),
+	OA_DL_SYM( uvc_start_streaming ),
+	OA_DL_SYM( uvc_start_iso_streaming ),
+	OA_DL_SYM( uvc_stop_streaming ),
+	OA_DL_SYM( uvc_stream_open_ctrl ),
+	OA_DL_SYM( uvc_stream_ctrl ),
+	OA_DL_SYM( uvc_stream_start ),
+	OA_DL_SYM( uvc_stream_start_iso ),
+	OA_DL_SYM( uvc_stream_get_frame ),
+	OA_DL_SYM( uvc_stream_stop ),
+	OA_DL_SYM( uvc_stream_close ),
+	OA_DL_SYM( uvc_get_ctrl_len ),
+	OA_DL_SYM( uvc_get_ctrl ),
+	OA_DL_SYM( uvc_set_ctrl ),
+	OA_DL_SYM( uvc_get_power_mode ),
+	OA_DL_SYM( uvc_set_power_mode ),
+	OA_DL_SYM( uvc_get_scanning_mode ),
+	OA_DL_SYM( uvc_set_scanning_mode ),
+	OA_DL_SYM( uvc_get_ae_mode ),
+	OA_DL_SYM( uvc_set_ae_mode ),
+	OA_DL_SYM( uvc_get_ae_priority ),
+	OA_DL_SYM( uvc_set_ae_priority ),
+	OA_DL_SYM( uvc_get_exposure_abs ),
+	OA_DL_SYM( uvc_set_exposure_abs ),
+	OA_DL_SYM( uvc_get_exposure_rel ),
+	OA_DL_SYM( uvc_set_exposure_rel ),
+	OA_DL_SYM( uvc_get_focus_abs ),
+	OA_DL_SYM( uvc_set_focus_abs ),
+	OA_DL_SYM( uvc_get_focus_rel ),
+	OA_DL_SYM( uvc_set_focus_rel ),
+	OA_DL_SYM( uvc_get_focus_simple_range ),
+	OA_DL_SYM( uvc_set_focus_simple_range ),
+	OA_DL_SYM( uvc_get_focus_auto ),
+	OA_DL_SYM( uvc_set_focus_auto ),
+	OA_DL_SYM( uvc_get_iris_abs ),
+	OA_DL_SYM( uvc_set_iris_abs ),
+	OA_DL_SYM( uvc_get_iris_rel ),
+	OA_DL_SYM( uvc_set_iris_rel ),
+	OA_DL_SYM( uvc_get_zoom_abs ),
+	OA_DL_SYM( uvc_set_zoom_abs ),
+	OA_DL_SYM( uvc_get_zoom_rel ),
+	OA_DL_SYM( uvc_set_zoom_rel ),
+	OA_DL_SYM( uvc_get_pantilt_abs ),
+	OA_DL_SYM( uvc_set_pantilt_abs ),
+	OA_DL_SYM( uvc_get_pantilt_rel ),
+	OA_DL_SYM( uvc_set_pantilt_rel ),
+	OA_DL_SYM( uvc_get_roll_abs ),
+	OA_DL_SYM( uvc_set_roll_abs ),
+	OA_DL_SYM( uvc_get_roll_rel ),
+	OA_DL_SYM( uvc_set_roll_rel ),
+	OA_DL_SYM( uvc_get_privacy ),
+	OA_DL_SYM( uvc_set_privacy ),
+	OA_DL_SYM( uvc_get_digital_window ),
+	OA_DL_SYM( uvc_set_digital_window ),
+	OA_DL_SYM( uvc_get_digital_roi ),
+	OA_DL_SYM( uvc_set_digital_roi ),
+	OA_DL_SYM( uvc_get_backlight_compensation ),
+	OA_DL_SYM( uvc_set_backlight_compensation ),
+	OA_DL_SYM( uvc_get_brightness ),
+	OA_DL_SYM( uvc_set_brightness ),
+	OA_DL_SYM( uvc_get_contrast ),
+	OA_DL_SYM( uvc_set_contrast ),
+	OA_DL_SYM( uvc_get_contrast_auto ),
+	OA_DL_SYM( uvc_set_contrast_auto ),
+	OA_DL_SYM( uvc_get_gain ),
+	OA_DL_SYM( uvc_set_gain ),
+	OA_DL_SYM( uvc_get_power_line_frequency ),
+	OA_DL_SYM( uvc_set_power_line_frequency ),
+	OA_DL_SYM( uvc_get_hue ),
+	OA_DL_SYM( uvc_set_hue ),
+	OA_DL_SYM( uvc_get_hue_auto ),
+	OA_DL_SYM( uvc_set_hue_auto ),
+	OA_DL_SYM( uvc_get_saturation ),
+	OA_DL_SYM( uvc_set_saturation ),
+	OA_DL_SYM( uvc_get_sharpness ),
+	OA_DL_SYM( uvc_set_sharpness ),
+	OA_DL_SYM( uvc_get_gamma ),
+	OA_DL_SYM( uvc_set_gamma ),
+	OA_DL_SYM( uvc_get_white_balance_temperature ),
+	OA_DL_SYM( uvc_set_white_balance_temperature ),
+	OA_DL_SYM( uvc_get_white_balance_temperature_auto ),
+	OA_DL_SYM( uvc_set_white_balance_temperature_auto ),
+	OA_DL_SYM( uvc_get_white_balance_component ),
+	OA_DL_SYM( uvc_set_white_balance_component ),
+	OA_DL_SYM( uvc_get_white_balance_component_auto ),
+	OA_DL_SYM( uvc_set_white_balance_component_auto ),
+	OA_DL_SYM( uvc_get_digital_multiplier ),
+	OA_DL_SYM( uvc_set_digital_multiplier ),
+	OA_DL_SYM( uvc_get_digital_multiplier_limit ),
+	OA_DL_SYM( uvc_set_digital_multiplier_limit ),
+	OA_DL_SYM( uvc_get_analog_video_standard ),
+	OA_DL_SYM( uvc_set_analog_video_standard ),
+	OA_DL_SYM( uvc_get_analog_video_lock_status ),
+	OA_DL_SYM( uvc_set_analog_video_lock_status ),
+	OA_DL_SYM( uvc_get_input_select ),
+	OA_DL_SYM( uvc_set_input_select ),
+	OA_DL_SYM( uvc_perror ),
+	OA_DL_SYM( uvc_strerror ),
+	OA_DL_SYM( uvc_print_diag ),
+	OA_DL_SYM( uvc_print_stream_ctrl ),
+	OA_DL_SYM( uvc_allocate_frame ),
+	OA_DL_SYM( uvc_free_frame ),
+	OA_DL_END
+};
 
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-  const char*		libName = "libuvc.dylib";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libuvc.dylib",
+		enumSymbols, otherSymbols );
 #else
-  const char*		libName = "libuvc.so.0";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libuvc.so.0",
+		enumSymbols, otherSymbols );
 #endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
-#endif
-
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
-#endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
 #endif
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libPath, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-		if (!( *( void** )( &p_uvc_init ) = _getDLSym ( libHandle,
-				"uvc_init" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_exit ) = _getDLSym ( libHandle,
-				"uvc_exit" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_device_list ) = _getDLSym ( libHandle,
-				"uvc_get_device_list" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_free_device_list ) = _getDLSym ( libHandle,
-				"uvc_free_device_list" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_device_descriptor ) = _getDLSym ( libHandle,
-				"uvc_get_device_descriptor" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_free_device_descriptor ) = _getDLSym ( libHandle,
-				"uvc_free_device_descriptor" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_bus_number ) = _getDLSym ( libHandle,
-				"uvc_get_bus_number" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_device_address ) = _getDLSym ( libHandle,
-				"uvc_get_device_address" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_find_device ) = _getDLSym ( libHandle,
-				"uvc_find_device" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_find_devices ) = _getDLSym ( libHandle,
-				"uvc_find_devices" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_open ) = _getDLSym ( libHandle,
-				"uvc_open" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_close ) = _getDLSym ( libHandle,
-				"uvc_close" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_device ) = _getDLSym ( libHandle,
-				"uvc_get_device" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_libusb_handle ) = _getDLSym ( libHandle,
-				"uvc_get_libusb_handle" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_ref_device ) = _getDLSym ( libHandle,
-				"uvc_ref_device" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_unref_device ) = _getDLSym ( libHandle,
-				"uvc_unref_device" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_status_callback ) = _getDLSym ( libHandle,
-				"uvc_set_status_callback" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_button_callback ) = _getDLSym ( libHandle,
-				"uvc_set_button_callback" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_camera_terminal ) = _getDLSym ( libHandle,
-				"uvc_get_camera_terminal" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_input_terminals ) = _getDLSym ( libHandle,
-				"uvc_get_input_terminals" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_output_terminals ) = _getDLSym ( libHandle,
-				"uvc_get_output_terminals" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_selector_units ) = _getDLSym ( libHandle,
-				"uvc_get_selector_units" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_processing_units ) = _getDLSym ( libHandle,
-				"uvc_get_processing_units" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_extension_units ) = _getDLSym ( libHandle,
-				"uvc_get_extension_units" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_stream_ctrl_format_size ) =
-				_getDLSym ( libHandle, "uvc_get_stream_ctrl_format_size" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_format_descs ) = _getDLSym ( libHandle,
-				"uvc_get_format_descs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_probe_stream_ctrl ) = _getDLSym ( libHandle,
-				"uvc_probe_stream_ctrl" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_start_streaming ) = _getDLSym ( libHandle,
-				"uvc_start_streaming" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_start_iso_streaming ) = _getDLSym ( libHandle,
-				"uvc_start_iso_streaming" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stop_streaming ) = _getDLSym ( libHandle,
-				"uvc_stop_streaming" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stream_open_ctrl ) = _getDLSym ( libHandle,
-				"uvc_stream_open_ctrl" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stream_ctrl ) = _getDLSym ( libHandle,
-				"uvc_stream_ctrl" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stream_start ) = _getDLSym ( libHandle,
-				"uvc_stream_start" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stream_start_iso ) = _getDLSym ( libHandle,
-				"uvc_stream_start_iso" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stream_get_frame ) = _getDLSym ( libHandle,
-				"uvc_stream_get_frame" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stream_stop ) = _getDLSym ( libHandle,
-				"uvc_stream_stop" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_stream_close ) = _getDLSym ( libHandle,
-				"uvc_stream_close" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_ctrl_len ) = _getDLSym ( libHandle,
-				"uvc_get_ctrl_len" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_ctrl ) = _getDLSym ( libHandle,
-				"uvc_get_ctrl" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_ctrl ) = _getDLSym ( libHandle,
-				"uvc_set_ctrl" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_power_mode ) = _getDLSym ( libHandle,
-				"uvc_get_power_mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_power_mode ) = _getDLSym ( libHandle,
-				"uvc_set_power_mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_scanning_mode ) = _getDLSym ( libHandle,
-				"uvc_get_scanning_mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_scanning_mode ) = _getDLSym ( libHandle,
-				"uvc_set_scanning_mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_ae_mode ) = _getDLSym ( libHandle,
-				"uvc_get_ae_mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_ae_mode ) = _getDLSym ( libHandle,
-				"uvc_set_ae_mode" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_ae_priority ) = _getDLSym ( libHandle,
-				"uvc_get_ae_priority" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_ae_priority ) = _getDLSym ( libHandle,
-				"uvc_set_ae_priority" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_exposure_abs ) = _getDLSym ( libHandle,
-				"uvc_get_exposure_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_exposure_abs ) = _getDLSym ( libHandle,
-				"uvc_set_exposure_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_exposure_rel ) = _getDLSym ( libHandle,
-				"uvc_get_exposure_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_exposure_rel ) = _getDLSym ( libHandle,
-				"uvc_set_exposure_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_focus_abs ) = _getDLSym ( libHandle,
-				"uvc_get_focus_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_focus_abs ) = _getDLSym ( libHandle,
-				"uvc_set_focus_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_focus_rel ) = _getDLSym ( libHandle,
-				"uvc_get_focus_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_focus_rel ) = _getDLSym ( libHandle,
-				"uvc_set_focus_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_focus_simple_range ) = _getDLSym ( libHandle,
-				"uvc_get_focus_simple_range" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_focus_simple_range ) = _getDLSym ( libHandle,
-				"uvc_set_focus_simple_range" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_focus_auto ) = _getDLSym ( libHandle,
-				"uvc_get_focus_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_focus_auto ) = _getDLSym ( libHandle,
-				"uvc_set_focus_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_iris_abs ) = _getDLSym ( libHandle,
-				"uvc_get_iris_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_iris_abs ) = _getDLSym ( libHandle,
-				"uvc_set_iris_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_iris_rel ) = _getDLSym ( libHandle,
-				"uvc_get_iris_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_iris_rel ) = _getDLSym ( libHandle,
-				"uvc_set_iris_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_zoom_abs ) = _getDLSym ( libHandle,
-				"uvc_get_zoom_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_zoom_abs ) = _getDLSym ( libHandle,
-				"uvc_set_zoom_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
 
-		if (!( *( void** )( &p_uvc_get_zoom_rel ) = _getDLSym ( libHandle,
-				"uvc_get_zoom_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_zoom_rel ) = _getDLSym ( libHandle,
-				"uvc_set_zoom_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_pantilt_abs ) = _getDLSym ( libHandle,
-				"uvc_get_pantilt_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_pantilt_abs ) = _getDLSym ( libHandle,
-				"uvc_set_pantilt_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_pantilt_rel ) = _getDLSym ( libHandle,
-				"uvc_get_pantilt_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_pantilt_rel ) = _getDLSym ( libHandle,
-				"uvc_set_pantilt_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_roll_abs ) = _getDLSym ( libHandle,
-				"uvc_get_roll_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_roll_abs ) = _getDLSym ( libHandle,
-				"uvc_set_roll_abs" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_roll_rel ) = _getDLSym ( libHandle,
-				"uvc_get_roll_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_roll_rel ) = _getDLSym ( libHandle,
-				"uvc_set_roll_rel" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_privacy ) = _getDLSym ( libHandle,
-				"uvc_get_privacy" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_privacy ) = _getDLSym ( libHandle,
-				"uvc_set_privacy" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_digital_window ) = _getDLSym ( libHandle,
-				"uvc_get_digital_window" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_digital_window ) = _getDLSym ( libHandle,
-				"uvc_set_digital_window" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_digital_roi ) = _getDLSym ( libHandle,
-				"uvc_get_digital_roi" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_digital_roi ) = _getDLSym ( libHandle,
-				"uvc_set_digital_roi" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_backlight_compensation ) =
-				_getDLSym ( libHandle, "uvc_get_backlight_compensation" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_backlight_compensation ) =
-				_getDLSym ( libHandle, "uvc_set_backlight_compensation" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_brightness ) = _getDLSym ( libHandle,
-				"uvc_get_brightness" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_brightness ) = _getDLSym ( libHandle,
-				"uvc_set_brightness" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_contrast ) = _getDLSym ( libHandle,
-				"uvc_get_contrast" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_contrast ) = _getDLSym ( libHandle,
-				"uvc_set_contrast" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_contrast_auto ) = _getDLSym ( libHandle,
-				"uvc_get_contrast_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_contrast_auto ) = _getDLSym ( libHandle,
-				"uvc_set_contrast_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_gain ) = _getDLSym ( libHandle,
-				"uvc_get_gain" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_gain ) = _getDLSym ( libHandle,
-				"uvc_set_gain" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_power_line_frequency ) =
-				_getDLSym ( libHandle, "uvc_get_power_line_frequency" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_power_line_frequency ) =
-				_getDLSym ( libHandle, "uvc_set_power_line_frequency" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_hue ) = _getDLSym ( libHandle,
-				"uvc_get_hue" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_hue ) = _getDLSym ( libHandle,
-				"uvc_set_hue" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_hue_auto ) = _getDLSym ( libHandle,
-				"uvc_get_hue_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_hue_auto ) = _getDLSym ( libHandle,
-				"uvc_set_hue_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_saturation ) = _getDLSym ( libHandle,
-				"uvc_get_saturation" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_saturation ) = _getDLSym ( libHandle,
-				"uvc_set_saturation" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_sharpness ) = _getDLSym ( libHandle,
-				"uvc_get_sharpness" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_sharpness ) = _getDLSym ( libHandle,
-				"uvc_set_sharpness" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_gamma ) = _getDLSym ( libHandle,
-				"uvc_get_gamma" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_gamma ) = _getDLSym ( libHandle,
-				"uvc_set_gamma" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_white_balance_temperature ) =
-				_getDLSym ( libHandle, "uvc_get_white_balance_temperature" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_white_balance_temperature ) =
-				_getDLSym ( libHandle, "uvc_set_white_balance_temperature" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_white_balance_temperature_auto ) =
-				_getDLSym ( libHandle, "uvc_get_white_balance_temperature_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_white_balance_temperature_auto ) =
-				_getDLSym ( libHandle, "uvc_set_white_balance_temperature_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_white_balance_component ) =
-				_getDLSym ( libHandle, "uvc_get_white_balance_component" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_white_balance_component ) =
-				_getDLSym ( libHandle, "uvc_set_white_balance_component" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_white_balance_component_auto ) =
-				_getDLSym ( libHandle, "uvc_get_white_balance_component_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_white_balance_component_auto ) =
-				_getDLSym ( libHandle, "uvc_set_white_balance_component_auto" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_digital_multiplier ) =
-				_getDLSym ( libHandle, "uvc_get_digital_multiplier" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_digital_multiplier ) =
-				_getDLSym ( libHandle, "uvc_set_digital_multiplier" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_digital_multiplier_limit ) =
-				_getDLSym ( libHandle, "uvc_get_digital_multiplier_limit" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_digital_multiplier_limit ) =
-				_getDLSym ( libHandle, "uvc_set_digital_multiplier_limit" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_analog_video_standard ) =
-				_getDLSym ( libHandle, "uvc_get_analog_video_standard" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_analog_video_standard ) =
-				_getDLSym ( libHandle, "uvc_set_analog_video_standard" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_analog_video_lock_status ) =
-				_getDLSym ( libHandle, "uvc_get_analog_video_lock_status" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_analog_video_lock_status ) =
-				_getDLSym ( libHandle, "uvc_set_analog_video_lock_status" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_get_input_select ) = _getDLSym ( libHandle,
-				"uvc_get_input_select" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_set_input_select ) = _getDLSym ( libHandle,
-				"uvc_set_input_select" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_perror ) = _getDLSym ( libHandle,
-				"uvc_perror" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_strerror ) = _getDLSym ( libHandle,
-				"uvc_strerror" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_print_diag ) = _getDLSym ( libHandle,
-				"uvc_print_diag" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_print_stream_ctrl ) = _getDLSym ( libHandle,
-				"uvc_print_stream_ctrl" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_allocate_frame ) = _getDLSym ( libHandle,
-				"uvc_allocate_frame" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_uvc_free_frame ) = _getDLSym ( libHandle,
-				"uvc_free_frame" ))) {
-			dlclose ( libHandle );
-			libHandle = 0;
-			return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-	}
 
+static int
+_uvcLoad ( int level )
+{
+#if HAVE_LIBDL && !HAVE_STATIC_LIBUVC
+	return oacamDLLoad ( &lib, level );
 #else
 #if HAVE_STATIC_LIBUVC
 
+	( void ) level;
+
 	p_uvc_init = uvc_init;
 	p_uvc_exit = uvc_exit;
 	p_uvc_get_device_list = uvc_get_device_list;
@@ -1252,29 +464,28 @@ retry:
 	p_uvc_print_stream_ctrl = uvc_print_stream_ctrl;
 	p_uvc_allocate_frame = uvc_allocate_frame;
 	p_uvc_free_frame = uvc_free_frame;
-
+	return OA_ERR_NONE;
 #else
+	( void ) level;
 	return OA_ERR_LIBRARY_NOT_FOUND;
 #endif	/* HAVE_STATIC_LIBUVC */
 #endif	/* HAVE_LIBDL && !HAVE_STATIC_LIBUVC */
-	return OA_ERR_NONE;
 }
 
-#if HAVE_LIBDL && !HAVE_STATIC_LIBUVC
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+
+// Only the calls needed to enumerate cameras are resolved here
+
+int
+_uvcInitLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
+	return _uvcLoad ( OA_DL_ENUMERATE );
+}
 
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libuvc DL error: %s", __func__, error );
-    addr = 0;
-  }
 
-  return addr;
+int
+_uvcInitAllLibraryFunctionPointers ( void )
+{
+	return _uvcLoad ( OA_DL_ALL );
 }
-#endif
 
 #endif	/* HAVE_LIBUVC */
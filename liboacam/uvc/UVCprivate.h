@@ -30,6 +30,7 @@
 #include <libuvc/libuvc.h>
 
 extern int					_uvcInitLibraryFunctionPointers ( void );
+extern int					_uvcInitAllLibraryFunctionPointers ( void );
 
 extern uvc_error_t	( *p_uvc_init )( uvc_context_t**, struct libusb_context * );
 extern void				( *p_uvc_exit )( uvc_context_t* );
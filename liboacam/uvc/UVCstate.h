@@ -53,7 +53,6 @@ typedef struct UVC_STATE {
   const uvc_format_desc_t* frameFormatMap[ OA_PIX_FMT_LAST_P1 ];
   enum uvc_frame_format	frameFormatIdMap[ OA_PIX_FMT_LAST_P1 ];
   // buffering for image transfers
-  frameBuffer*			    buffers;
   unsigned int          currentFrameLength;
   // camera status
   unsigned int          isColour;
@@ -39,64 +39,63 @@
 #include "V4L2ioctl.h"
 
 
+void
+oacamV4L2requeueFrame ( SHARED_STATE* state, CALLBACK* callback )
+{
+  V4L2_STATE*		cameraInfo = ( V4L2_STATE* ) state;
+  int			streaming;
+
+  // We can only requeue frames if we're still streaming
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+  if ( streaming ) {
+    if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_QBUF, callback->buffer )) {
+			oaLogError ( OA_LOG_CAMERA, "%s: VIDIOC_QBUF failed", __func__ );
+    }
+  }
+}
+
+
 void*
 oacamV4L2callbackHandler ( void* param )
 {
   oaCamera*		camera = param;
   V4L2_STATE*		cameraInfo = camera->_private;
-  int			exitThread = 0, streaming;
   CALLBACK*		callback;
   void*			(*callbackFunc)( void*, void*, int, void* );
+  uint64_t		started;
   struct v4l2_buffer*	frameData;
 
 	oaLogInfo ( OA_LOG_CAMERA, "%s: thread started", __func__ );
 
   do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    exitThread = cameraInfo->stopCallbackThread;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-  
-    if ( exitThread ) {
-      break;
-    } else {
-      // try to prevent busy-waiting
-      if ( oaDLListIsEmpty ( cameraInfo->callbackQueue )) {
-        pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-        pthread_cond_wait ( &cameraInfo->callbackQueued,
-            &cameraInfo->callbackQueueMutex );
-        pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-      }
-    }
-
-    callback = oaDLListRemoveFromHead ( cameraInfo->callbackQueue );
+    callback = oacamCallbackRingWait ( &cameraInfo->callbackRing );
     if ( callback ) {
       switch ( callback->callbackType ) {
         case OA_CALLBACK_NEW_FRAME:
-          callbackFunc = callback->callback;
           frameData = callback->buffer;
-          callbackFunc ( callback->callbackArg,
-              cameraInfo->buffers[ frameData->index ].start,
-              callback->bufferLen, 0 );
-          // We can only requeue frames if we're still streaming
-          pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-          streaming = ( cameraInfo->runMode == CAM_RUN_MODE_STREAMING ) ? 1 : 0;
-          pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
-          if ( streaming ) {
-            if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_QBUF, frameData )) {
-							oaLogError ( OA_LOG_CAMERA, "%s: VIDIOC_DQBUF failed", __func__ );
-            }
+          if ( !oacamLeaseFrame (( SHARED_STATE* ) cameraInfo, callback,
+              cameraInfo->buffers[ frameData->index ].start )) {
+            callbackFunc = callback->callback;
+            started = oacamCallbackStarted (( SHARED_STATE* ) cameraInfo,
+                callback );
+            callbackFunc ( callback->callbackArg,
+                cameraInfo->buffers[ frameData->index ].start,
+                callback->bufferLen, callback->metadata );
+            oacamCallbackFinished (( SHARED_STATE* ) cameraInfo, started );
+            oacamV4L2requeueFrame (( SHARED_STATE* ) cameraInfo, callback );
+            OA_RELEASE_BUFFER ( cameraInfo );
           }
-          pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-          cameraInfo->buffersFree++;
-          pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
           break;
         default:
 					oaLogWarning ( OA_LOG_CAMERA, "%s: unexpected callback type %d",
               __func__, callback->callbackType );
           break;
       }
+      oacamCallbackRingRelease ( &cameraInfo->callbackRing );
     }
-  } while ( 1 );
+  } while ( callback );
 
 	oaLogInfo ( OA_LOG_CAMERA, "%s: exiting thread", __func__ );
 
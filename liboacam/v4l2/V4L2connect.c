@@ -1859,18 +1859,21 @@ oaV4L2InitCamera ( oaCameraDevice* device )
 
   cameraInfo->stopControllerThread = cameraInfo->stopCallbackThread = 0;
   cameraInfo->commandQueue = oaDLListCreate();
-  cameraInfo->callbackQueue = oaDLListCreate();
+  oacamCallbackRingInit ( &cameraInfo->callbackRing );
+  cameraInfo->frameLeases.recycle = oacamV4L2requeueFrame;
 
-  if ( pthread_create ( &( cameraInfo->controllerThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->controllerThread ),
+      OA_CAM_THREAD_CONTROLLER,
       oacamV4L2controller, ( void* ) camera )) {
     v4l2_close ( cameraInfo->fd );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
-  if ( pthread_create ( &( cameraInfo->callbackThread ), 0,
+  if ( oacamCreateThread ( &( cameraInfo->callbackThread ),
+      OA_CAM_THREAD_CALLBACK,
       oacamV4L2callbackHandler, ( void* ) camera )) {
 
     void* dummy;
@@ -1880,7 +1883,7 @@ oaV4L2InitCamera ( oaCameraDevice* device )
     v4l2_close ( cameraInfo->fd );
     free (( void* ) cameraInfo->frameSizes[1].sizes );
     oaDLListDelete ( cameraInfo->commandQueue, 0 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
     FREE_DATA_STRUCTS;
     return 0;
   }
@@ -1935,7 +1938,7 @@ oaV4L2CloseCamera ( oaCamera* camera )
     pthread_join ( cameraInfo->controllerThread, &dummy );
 
     cameraInfo->stopCallbackThread = 1;
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
+    oacamCallbackRingStop ( &cameraInfo->callbackRing );
     pthread_join ( cameraInfo->callbackThread, &dummy );
 
     if ( cameraInfo->fd >= 0 ) {
@@ -1946,7 +1949,7 @@ oaV4L2CloseCamera ( oaCamera* camera )
     }
 
     oaDLListDelete ( cameraInfo->commandQueue, 1 );
-    oaDLListDelete ( cameraInfo->callbackQueue, 0 );
+    oacamCallbackRingDestroy ( &cameraInfo->callbackRing );
 
     free (( void* ) camera->_common );
     free (( void* ) cameraInfo );
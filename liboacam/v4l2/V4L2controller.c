@@ -35,6 +35,9 @@
 #include <fcntl.h>
 #endif
 #include <sys/mman.h>
+#if HAVE_SYS_IOCTL_H
+#include <sys/ioctl.h>
+#endif
 #include <libv4l2.h>
 
 #include "oacamprivate.h"
@@ -61,6 +64,10 @@ static int	_getUserControl ( int, int );
 static int	_setExtendedControl ( int, int, oaControlValue* );
 static int	_doCameraConfig ( V4L2_STATE*, OA_COMMAND* );
 static int	_doStart ( V4L2_STATE* );
+static int	_userBuffers ( V4L2_STATE*, unsigned int, size_t );
+static int	_mapBuffers ( V4L2_STATE*, unsigned int, size_t );
+static void	_exportBuffers ( V4L2_STATE* );
+static void	_releaseBuffers ( V4L2_STATE* );
 
 
 void*
@@ -76,6 +83,7 @@ oacamV4L2controller ( void* param )
   struct timeval	tv;
   fd_set		fds;
   struct v4l2_buffer*	frame = 0;
+  FRAME_METADATA*	metadata;
   int			fd;
 
   // V4L2 cameras are a mixed bunch in terms of how they respond to
@@ -191,9 +199,7 @@ oacamV4L2controller ( void* param )
         frameWait = 1000;
       }
 
-      pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-      buffersFree = cameraInfo->buffersFree;
-      pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+      buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
       if ( buffersFree ) {
         nextBuffer = cameraInfo->nextBuffer;
@@ -215,7 +221,7 @@ oacamV4L2controller ( void* param )
             OA_CLEAR( cameraInfo->currentFrame[ nextBuffer ]);
             frame = &cameraInfo->currentFrame[ nextBuffer ];
             frame->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-            frame->memory = V4L2_MEMORY_MMAP;
+            frame->memory = cameraInfo->memoryType;
             frame->index = nextBuffer;
             if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_DQBUF, frame ) < 0 ) {
               perror ( "VIDIOC_DQBUF" );
@@ -229,6 +235,21 @@ oacamV4L2controller ( void* param )
 
         if ( !exitThread ) {
           if ( haveFrame ) {
+            // The kernel drops frames itself when we fall behind, which
+            // shows up as a gap in the driver's sequence numbers
+            if ( cameraInfo->frameSequence && frame->sequence >
+                cameraInfo->lastSequence + 1 ) {
+              OA_DROP_FRAMES ( cameraInfo, frame->sequence -
+                  cameraInfo->lastSequence - 1 );
+            }
+            cameraInfo->lastSequence = frame->sequence;
+            metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+                nextBuffer );
+            if ( cameraInfo->dmabufFd[ frame->index ] >= 0 ) {
+              metadata->dmabufFd = cameraInfo->dmabufFd[ frame->index ];
+              metadata->dmabufValid = 1;
+            }
+            cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
             cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
                 OA_CALLBACK_NEW_FRAME;
             cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -250,14 +271,11 @@ oacamV4L2controller ( void* param )
             	cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
 									t - ( uint8_t* ) cameraInfo->buffers[ frame->index ].start; 
 						}
-            pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-            oaDLListAddToTail ( cameraInfo->callbackQueue,
+            oacamCallbackRingPush ( &cameraInfo->callbackRing,
                 &cameraInfo->frameCallbacks[ nextBuffer ]);
-            cameraInfo->buffersFree--;
+            OA_CLAIM_BUFFER ( cameraInfo );
             cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
                 cameraInfo->configuredBuffers;
-            pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-            pthread_cond_broadcast ( &cameraInfo->callbackQueued );
           }
         }
       }
@@ -1211,10 +1229,8 @@ static int
 _doStart ( V4L2_STATE* cameraInfo )
 {
   struct v4l2_format		fmt;
-  struct v4l2_buffer		buf;
-  struct v4l2_requestbuffers	req;
   enum v4l2_buf_type		type;
-  unsigned int			m, n;
+  int				ret;
 
   OA_CLEAR ( fmt );
   fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -1251,19 +1267,165 @@ _doStart ( V4L2_STATE* cameraInfo )
   cameraInfo->excessStride = cameraInfo->strideLength -
 			cameraInfo->expectedStride;
 
-  OA_CLEAR( req );
+  // Capture straight into the application's buffer pool if the driver
+  // will take user memory, otherwise fall back to mapping the driver's
+  // own buffers
+
 #if V4L2_MEMORY_RESTRICTED
-  req.count = 3;
+  if (( ret = _mapBuffers ( cameraInfo, 3, fmt.fmt.pix.sizeimage ))) {
+    return ret;
+  }
 #else
-  req.count = OA_CAM_BUFFERS;
+  if ( _userBuffers ( cameraInfo, oacamBufferPoolCount(),
+      fmt.fmt.pix.sizeimage ) && ( ret = _mapBuffers ( cameraInfo,
+      oacamBufferPoolCount(), fmt.fmt.pix.sizeimage ))) {
+    return ret;
+  }
 #endif
+
+  type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_STREAMON, &type ) < 0 )  {
+    if ( -ENOSPC == errno ) {
+      oaLogError ( OA_LOG_CAMERA,
+					"%s: Insufficient bandwidth for camera on the USB bus", __func__ );
+    }
+    perror ( "VIDIOC_STREAMON" );
+    _releaseBuffers ( cameraInfo );
+    return -OA_ERR_SYSTEM_ERROR;
+  }
+
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  cameraInfo->runMode = CAM_RUN_MODE_STREAMING;
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+  return OA_ERR_NONE;
+}
+
+
+static int
+_processStreamingStop ( V4L2_STATE* cameraInfo, OA_COMMAND* command )
+{
+  int           	queueEmpty;
+  enum v4l2_buf_type	type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+
+  if ( cameraInfo->runMode != CAM_RUN_MODE_STREAMING ) {
+    return -OA_ERR_INVALID_COMMAND;
+  }
+
+  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
+  cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
+  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
+
+  if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_STREAMOFF, &type ) < 0 ) {
+    perror ( "VIDIOC_STREAMOFF" );
+  }
+
+  // We wait here until the callback queue has drained otherwise unmapping
+  // the buffers could rip the image frame out from underneath the callback
+
+  queueEmpty = 0;
+  do {
+    queueEmpty = ( cameraInfo->buffersGranted ==
+        OA_BUFFERS_FREE ( cameraInfo )) ? 1 : 0;
+    if ( !queueEmpty ) {
+      usleep ( 100 );
+    }
+  } while ( !queueEmpty );
+
+  if ( cameraInfo->configuredBuffers ) {
+    _releaseBuffers ( cameraInfo );
+  }
+  cameraInfo->configuredBuffers = cameraInfo->buffersFree = 0;
+
+  return OA_ERR_NONE;
+}
+
+
+/*
+ * Hand the driver buffers from the application's pool to capture into
+ * ( V4L2_MEMORY_USERPTR ).  The kernel may grant a different number of
+ * buffers to the number asked for, in which case the smaller of the two
+ * is used.  This fails without side effects if the driver, or libv4l2
+ * when it is converting the frame format, only does mmap'ed buffers.
+ */
+
+static int
+_userBuffers ( V4L2_STATE* cameraInfo, unsigned int count, size_t size )
+{
+  struct v4l2_requestbuffers	req;
+  struct v4l2_buffer		buf;
+  unsigned int			n;
+  long				pageSize;
+  int				ret;
+
+  OA_CLEAR( req );
+  req.count = count;
+  req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  req.memory = V4L2_MEMORY_USERPTR;
+  if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_REQBUFS, &req ) || !req.count ) {
+    oaLogInfo ( OA_LOG_CAMERA, "%s: user pointer buffers not available",
+        __func__ );
+    return -OA_ERR_UNSUPPORTED_FORMAT;
+  }
+  if ( req.count < count ) {
+    count = req.count;
+  }
+
+  // Some drivers pin user memory by the page, so keep every buffer on
+  // its own pages
+
+  if (( pageSize = sysconf ( _SC_PAGESIZE )) <= 0 ) {
+    pageSize = 4096;
+  }
+  size = ( size + pageSize - 1 ) & ~(( size_t ) pageSize - 1 );
+  if (( ret = oacamAllocDeviceBuffers (( SHARED_STATE* ) cameraInfo, count,
+      size, pageSize ))) {
+    req.count = 0;
+    ( void ) v4l2ioctl ( cameraInfo->fd, VIDIOC_REQBUFS, &req );
+    return ret;
+  }
+  cameraInfo->memoryType = V4L2_MEMORY_USERPTR;
+  cameraInfo->buffersGranted = count;
+
+  for ( n = 0; n < count; n++ ) {
+    cameraInfo->dmabufFd[ n ] = -1;
+    OA_CLEAR( buf );
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_USERPTR;
+    buf.index = n;
+    buf.m.userptr = ( unsigned long ) cameraInfo->buffers[ n ].start;
+    buf.length = cameraInfo->buffers[ n ].length;
+    if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_QBUF, &buf ) < 0 ) {
+      oaLogWarning ( OA_LOG_CAMERA, "%s: driver refused user buffer %u",
+          __func__, n );
+      _releaseBuffers ( cameraInfo );
+      return -OA_ERR_CAMERA_IO;
+    }
+  }
+
+  return OA_ERR_NONE;
+}
+
+
+static int
+_mapBuffers ( V4L2_STATE* cameraInfo, unsigned int count, size_t size )
+{
+  struct v4l2_requestbuffers	req;
+  struct v4l2_buffer		buf;
+  unsigned int			m, n;
+
+  OA_CLEAR( req );
+  req.count = count;
   req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
   req.memory = V4L2_MEMORY_MMAP;
   if ( v4l2ioctl( cameraInfo->fd, VIDIOC_REQBUFS, &req )) {
     perror ( "VIDIOC_REQBUFS v4l2ioctl failed" );
     return -OA_ERR_SYSTEM_ERROR;
   }
+  if ( req.count > OA_CAM_MAX_BUFFERS ) {
+    req.count = OA_CAM_MAX_BUFFERS;
+  }
   cameraInfo->buffersGranted = req.count;
+  cameraInfo->memoryType = V4L2_MEMORY_MMAP;
 
   cameraInfo->nextBuffer = 0;
   cameraInfo->configuredBuffers = 0;
@@ -1274,6 +1436,7 @@ _doStart ( V4L2_STATE* cameraInfo )
     return -OA_ERR_MEM_ALLOC;
   }
   for ( n = 0; n < req.count; n++ ) {
+    cameraInfo->dmabufFd[ n ] = -1;
     OA_CLEAR ( buf );
     buf.type = req.type;
     buf.memory = V4L2_MEMORY_MMAP;
@@ -1299,7 +1462,10 @@ _doStart ( V4L2_STATE* cameraInfo )
     }
     cameraInfo->configuredBuffers++;
   }
-  cameraInfo->buffersFree = cameraInfo->configuredBuffers;
+  // The driver may grant fewer buffers than asked for and owns the memory
+  oacamInitBufferPool (( SHARED_STATE* ) cameraInfo,
+      cameraInfo->configuredBuffers, size );
+  _exportBuffers ( cameraInfo );
 
   for ( n = 0; n < req.count; n++ ) {
     OA_CLEAR( buf );
@@ -1308,88 +1474,89 @@ _doStart ( V4L2_STATE* cameraInfo )
     buf.index = n;
     if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_QBUF, &buf ) < 0 ) {
       perror ( "init VIDIOC_QBUF" );
-      for ( m = 0; m < cameraInfo->configuredBuffers; m++ ) {
-        v4l2_munmap ( cameraInfo->buffers[ m ].start,
-            cameraInfo->buffers[ m ].length );
-      }
-      free (( void* ) cameraInfo->buffers );
+      _releaseBuffers ( cameraInfo );
       return -OA_ERR_SYSTEM_ERROR;
     }
   }
 
-  type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-  if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_STREAMON, &type ) < 0 )  {
-    if ( -ENOSPC == errno ) {
-      oaLogError ( OA_LOG_CAMERA,
-					"%s: Insufficient bandwidth for camera on the USB bus", __func__ );
-    }
-    perror ( "VIDIOC_STREAMON" );
-    for ( m = 0; m < cameraInfo->configuredBuffers; m++ ) {
-      v4l2_munmap ( cameraInfo->buffers[ m ].start,
-          cameraInfo->buffers[ m ].length );
-    }
-    free (( void* ) cameraInfo->buffers );
-    return -OA_ERR_SYSTEM_ERROR;
-  }
-
-  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-  cameraInfo->runMode = CAM_RUN_MODE_STREAMING;
-  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
   return OA_ERR_NONE;
 }
 
 
-static int
-_processStreamingStop ( V4L2_STATE* cameraInfo, OA_COMMAND* command )
+/*
+ * Export the mmap'ed buffers as dma-bufs so frames can be handed on by
+ * file descriptor.  That's only any use if the buffers hold the frames
+ * the application sees, so not when libv4l2 is converting them from some
+ * other format, which shows as the device itself having a different
+ * format to the one we asked libv4l2 for.
+ */
+
+static void
+_exportBuffers ( V4L2_STATE* cameraInfo )
 {
-  int           	queueEmpty;
-  unsigned int		n;
-  enum v4l2_buf_type	type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  struct v4l2_format		fmt;
+  struct v4l2_exportbuffer	exp;
+  int				n;
 
-  if ( cameraInfo->runMode != CAM_RUN_MODE_STREAMING ) {
-    return -OA_ERR_INVALID_COMMAND;
+  OA_CLEAR ( fmt );
+  fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  if ( ioctl ( cameraInfo->fd, VIDIOC_G_FMT, &fmt ) ||
+      fmt.fmt.pix.pixelformat != cameraInfo->currentV4L2Format ) {
+    return;
   }
 
-  pthread_mutex_lock ( &cameraInfo->commandQueueMutex );
-  cameraInfo->runMode = CAM_RUN_MODE_STOPPED;
-  pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
-
-  if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_STREAMOFF, &type ) < 0 ) {
-    perror ( "VIDIOC_STREAMOFF" );
+  for ( n = 0; n < cameraInfo->configuredBuffers; n++ ) {
+    OA_CLEAR ( exp );
+    exp.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    exp.index = n;
+    exp.flags = O_RDONLY | O_CLOEXEC;
+    if ( v4l2ioctl ( cameraInfo->fd, VIDIOC_EXPBUF, &exp )) {
+      oaLogInfo ( OA_LOG_CAMERA, "%s: dma-buf export not available",
+          __func__ );
+      return;
+    }
+    cameraInfo->dmabufFd[ n ] = exp.fd;
   }
+}
 
-  // We wait here until the callback queue has drained otherwise unmapping
-  // the buffers could rip the image frame out from underneath the callback
 
-  queueEmpty = 0;
-  do {
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    queueEmpty = ( cameraInfo->buffersGranted ==
-        cameraInfo->buffersFree ) ? 1 : 0;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-    if ( !queueEmpty ) {
-      usleep ( 100 );
-    }
-  } while ( !queueEmpty );
-
-  if ( cameraInfo->configuredBuffers ) {
+static void
+_releaseBuffers ( V4L2_STATE* cameraInfo )
+{
+  struct v4l2_requestbuffers	req;
+  int				n;
+
+  if ( V4L2_MEMORY_USERPTR == cameraInfo->memoryType ) {
+    // The driver must let go of the memory before it is freed
+    OA_CLEAR( req );
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_USERPTR;
+    ( void ) v4l2ioctl ( cameraInfo->fd, VIDIOC_REQBUFS, &req );
+    oacamFreeBuffers (( SHARED_STATE* ) cameraInfo );
+  } else {
     for ( n = 0; n < cameraInfo->configuredBuffers; n++ ) {
+      if ( cameraInfo->dmabufFd[ n ] >= 0 ) {
+        close ( cameraInfo->dmabufFd[ n ] );
+        cameraInfo->dmabufFd[ n ] = -1;
+      }
       v4l2_munmap ( cameraInfo->buffers[ n ].start,
           cameraInfo->buffers[ n ].length );
     }
-
     free (( void* ) cameraInfo->buffers );
+    cameraInfo->buffers = 0;
+    OA_CLEAR( req );
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+    ( void ) v4l2ioctl ( cameraInfo->fd, VIDIOC_REQBUFS, &req );
   }
   cameraInfo->configuredBuffers = cameraInfo->buffersFree = 0;
-
-  return OA_ERR_NONE;
 }
 
 
 static int
 _processGetMenuItem ( V4L2_STATE* cameraInfo, OA_COMMAND* command )
 {
-  static char		buff[ V4L2_MAX_MENU_ITEM_LENGTH + 1 ];
+  char*			buff = cameraInfo->menuItemLabel;
   struct v4l2_querymenu	menuItem;
   int*			indexp;
   int			control, index;
@@ -1399,7 +1566,7 @@ _processGetMenuItem ( V4L2_STATE* cameraInfo, OA_COMMAND* command )
   indexp = ( int* ) command->commandData;
   index = *indexp;
   retStr = buff;
-  OA_CLEAR ( buff );
+  memset ( buff, 0, sizeof ( cameraInfo->menuItemLabel ));
 
   // FIX ME -- need map of OA_CTRL to V4L2_CID values for this really
   if ( control != OA_CAM_CTRL_MODE_AUTO( OA_CAM_CTRL_WHITE_BALANCE ) &&
@@ -49,6 +49,8 @@ extern int		oaV4L2CameraGetControlDiscreteSet ( oaCamera*, int,
 
 extern void*		oacamV4L2controller ( void* );
 extern void*		oacamV4L2callbackHandler ( void* );
+struct SHARED_STATE;
+extern void		oacamV4L2requeueFrame ( struct SHARED_STATE*, CALLBACK* );
 
 extern const FRAMESIZES* oaV4L2CameraGetFrameSizes ( oaCamera* );
 extern const FRAMERATES* oaV4L2CameraGetFrameRates ( oaCamera*, int, int );
@@ -33,6 +33,7 @@
 #include <linux/limits.h>
 
 #include "sharedState.h"
+#include "V4L2.h"
 
 
 typedef struct V4L2_STATE {
@@ -46,9 +47,11 @@ typedef struct V4L2_STATE {
   uint32_t		currentFrameFormat;
   uint32_t		currentV4L2Format;
   // buffering for image transfers
-  frameBuffer*			buffers;
-  struct v4l2_buffer	currentFrame[ OA_CAM_BUFFERS ];
+  struct v4l2_buffer	currentFrame[ OA_CAM_MAX_BUFFERS ];
   unsigned int		buffersGranted;
+  uint32_t		memoryType;
+  int			dmabufFd[ OA_CAM_MAX_BUFFERS ];
+  uint32_t		lastSequence;
   // camera status
   int			colourDxK;
   int			monoDMK;
@@ -68,6 +71,8 @@ typedef struct V4L2_STATE {
   // discrete auto exposure menu item ids
   unsigned int		numAutoExposureItems;
   int64_t		autoExposureMenuItems[8];
+  // label returned by the most recent menu item query
+  char			menuItemLabel[ V4L2_MAX_MENU_ITEM_LENGTH + 1 ];
 
   // frame size configuration
   int32_t		framesizeType;
@@ -60,7 +60,8 @@ oacamZWASI2controller ( void* param )
   OA_COMMAND*		command;
   int			exitThread = 0;
   int			resultCode, nextBuffer, buffersFree, frameWait;
-  int			imageBufferLength, haveFrame;
+  int			imageBufferLength, haveFrame, dropped;
+  FRAME_METADATA*	metadata;
 //int			maxWaitTime;
   int			streaming = 0;
 
@@ -140,9 +141,7 @@ oacamZWASI2controller ( void* param )
         frameWait = 100;
       }
 
-      pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-      buffersFree = cameraInfo->buffersFree;
-      pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+      buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
       if ( buffersFree ) {
         nextBuffer = cameraInfo->nextBuffer;
@@ -160,6 +159,28 @@ oacamZWASI2controller ( void* param )
           pthread_mutex_unlock ( &cameraInfo->commandQueueMutex );
 
           if ( !exitThread && haveFrame ) {
+            // The SDK's count of dropped frames restarts with each capture
+            if ( !p_ASIGetDroppedFrames ( cameraInfo->cameraId, &dropped )) {
+              if ( !cameraInfo->frameSequence ) {
+                cameraInfo->sdkDroppedFrames = 0;
+              }
+              if ( dropped > cameraInfo->sdkDroppedFrames ) {
+                OA_DROP_FRAMES ( cameraInfo, dropped -
+                    cameraInfo->sdkDroppedFrames );
+              }
+              cameraInfo->sdkDroppedFrames = dropped;
+            }
+            metadata = oacamStampFrame (( SHARED_STATE* ) cameraInfo,
+                nextBuffer );
+            if ( !cameraInfo->autoExposure ) {
+              metadata->exposure = cameraInfo->currentAbsoluteExposure;
+              metadata->exposureValid = 1;
+            }
+            if ( !cameraInfo->autoGain ) {
+              metadata->gain = cameraInfo->currentGain;
+              metadata->gainValid = 1;
+            }
+            cameraInfo->frameCallbacks[ nextBuffer ].metadata = metadata;
             cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
                 OA_CALLBACK_NEW_FRAME;
             cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -170,14 +191,11 @@ oacamZWASI2controller ( void* param )
                 cameraInfo->buffers[ nextBuffer ].start;
             cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
                 imageBufferLength;
-            oaDLListAddToTail ( cameraInfo->callbackQueue,
+            oacamCallbackRingPush ( &cameraInfo->callbackRing,
                 &cameraInfo->frameCallbacks[ nextBuffer ]);
-            pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-            cameraInfo->buffersFree--;
+            OA_CLAIM_BUFFER ( cameraInfo );
             cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
                 cameraInfo->configuredBuffers;
-            pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-            pthread_cond_broadcast ( &cameraInfo->callbackQueued );
           }
 //      } while ( !exitThread && !haveFrame && maxWaitTime > 0 );
       }
@@ -926,9 +944,7 @@ retry:
 		return;
 	}
 
-	pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-	buffersFree = cameraInfo->buffersFree;
-	pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
+	buffersFree = OA_BUFFERS_FREE ( cameraInfo );
 
   if ( buffersFree ) {
     nextBuffer = cameraInfo->nextBuffer;
@@ -944,6 +960,8 @@ retry:
 		}
 
 		cameraInfo->exposureInProgress = 0;
+    cameraInfo->frameCallbacks[ nextBuffer ].metadata =
+        oacamStampFrame (( SHARED_STATE* ) cameraInfo, nextBuffer );
     cameraInfo->frameCallbacks[ nextBuffer ].callbackType =
         OA_CALLBACK_NEW_FRAME;
     cameraInfo->frameCallbacks[ nextBuffer ].callback =
@@ -954,15 +972,13 @@ retry:
         cameraInfo->buffers[ nextBuffer ].start;
     cameraInfo->frameCallbacks[ nextBuffer ].bufferLen =
         cameraInfo->imageBufferLength;
-    oaDLListAddToTail ( cameraInfo->callbackQueue,
+    oacamCallbackRingPush ( &cameraInfo->callbackRing,
         &cameraInfo->frameCallbacks[ nextBuffer ]);
-    pthread_mutex_lock ( &cameraInfo->callbackQueueMutex );
-    cameraInfo->buffersFree--;
+    OA_CLAIM_BUFFER ( cameraInfo );
     cameraInfo->nextBuffer = ( nextBuffer + 1 ) %
         cameraInfo->configuredBuffers;
-    pthread_mutex_unlock ( &cameraInfo->callbackQueueMutex );
-    pthread_cond_broadcast ( &cameraInfo->callbackQueued );
   } else {
 		cameraInfo->exposureInProgress = 0;
+		OA_DROP_FRAME_NO_BUFFER ( cameraInfo );
 	}
 }
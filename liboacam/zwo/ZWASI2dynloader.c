@@ -43,6 +43,7 @@
 #include <openastro/util.h>
 
 #include "oacamprivate.h"
+#include "dynloader.h"
 #include "ZWASI2private.h"
 
 
@@ -90,321 +91,73 @@ ASI_ERROR_CODE	( *p_ASIGetTriggerOutputIOConf )( int, ASI_TRIG_OUTPUT_PIN,
 										ASI_BOOL*, long*, long* );
 
 #if HAVE_LIBDL && !HAVE_STATIC_LIBASICAMERA2
-static void*    _getDLSym ( void*, const char* );
-#endif
 
-int
-_asiInitLibraryFunctionPointers ( void )
-{
-#if HAVE_LIBDL && !HAVE_STATIC_LIBASICAMERA2
-	static void*		libHandle = 0;
-	char						libPath[ PATH_MAX+1 ];
+static const OA_DL_SYMBOL	enumSymbols[] = {
+	OA_DL_SYM( ASIGetNumOfConnectedCameras ),
+	OA_DL_SYM( ASIGetCameraProperty ),
+	OA_DL_END
+};
+
+static const OA_DL_SYMBOL	otherSymbols[] = {
+	OA_DL_SYM( ASIGetProductIDs ),
+	OA_DL_SYM( ASIGetCameraPropertyByID ),
+	OA_DL_SYM( ASIOpenCamera ),
+	OA_DL_SYM( ASIInitCamera ),
+	OA_DL_SYM( ASICloseCamera ),
+	OA_DL_SYM( ASIGetNumOfControls ),
+	OA_DL_SYM( ASIGetControlCaps ),
+	OA_DL_SYM( ASIGetControlValue ),
+	OA_DL_SYM( ASISetControlValue ),
+	OA_DL_SYM( ASISetROIFormat ),
+	OA_DL_SYM( ASIGetROIFormat ),
+	OA_DL_SYM( ASISetStartPos ),
+	OA_DL_SYM( ASIGetStartPos ),
+	OA_DL_SYM( ASIGetDroppedFrames ),
+	OA_DL_SYM( ASIEnableDarkSubtract ),
+	OA_DL_SYM( ASIDisableDarkSubtract ),
+	OA_DL_SYM( ASIStartVideoCapture ),
+	OA_DL_SYM( ASIStopVideoCapture ),
+	OA_DL_SYM( ASIGetVideoData ),
+	OA_DL_SYM( ASIPulseGuideOn ),
+	OA_DL_SYM( ASIPulseGuideOff ),
+	OA_DL_SYM( ASIStartExposure ),
+	OA_DL_SYM( ASIStopExposure ),
+	OA_DL_SYM( ASIGetExpStatus ),
+	OA_DL_SYM( ASIGetDataAfterExp ),
+	OA_DL_SYM( ASIGetID ),
+	OA_DL_SYM( ASISetID ),
+	OA_DL_SYM( ASIGetGainOffset ),
+	OA_DL_SYM( ASIGetSDKVersion ),
+	OA_DL_SYM( ASIGetCameraSupportMode ),
+	OA_DL_SYM( ASIGetCameraMode ),
+	OA_DL_SYM( ASISetCameraMode ),
+	OA_DL_SYM( ASISendSoftTrigger ),
+	OA_DL_SYM( ASIGetSerialNumber ),
+	OA_DL_SYM( ASISetTriggerOutputIOConf ),
+	OA_DL_SYM( ASIGetTriggerOutputIOConf ),
+	OA_DL_END
+};
+
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
-	const char*			libName = "libASICamera2.dylib";
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libASICamera2.dylib",
+		enumSymbols, otherSymbols );
 #else
-	const char*			libName = "libASICamera2.so";
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-	int						tryWithoutPath = 1;
-#endif
-
-	*libPath = 0;
-	dlerror();
-  if ( !libHandle ) {
-		if ( installPathRoot ) {
-			( void ) strncpy ( libPath, installPathRoot, PATH_MAX );
-		}
-#ifdef SHLIB_PATH
-		( void ) strncat ( libPath, SHLIB_PATH, PATH_MAX );
-#endif
-#ifdef RETRY_SO_WITHOUT_PATH
-retry:
+static OA_DL_LIBRARY	lib = OA_DL_LIBRARY_INIT ( "libASICamera2.so",
+		enumSymbols, otherSymbols );
 #endif
-		( void ) strncat ( libPath, libName, PATH_MAX );
-
-    if (!( libHandle = dlopen ( libPath, RTLD_LAZY ))) {
-#ifdef RETRY_SO_WITHOUT_PATH
-			if ( tryWithoutPath ) {
-				tryWithoutPath = 0;
-				*libPath = 0;
-				goto retry;
-			}
 #endif
-      oaLogWarning ( OA_LOG_CAMERA, "%s: can't load %s, error '%s'", __func__,
-					libPath, dlerror());
-      return OA_ERR_LIBRARY_NOT_FOUND;
-    }
-
-		if (!( *( void** )( &p_ASIGetNumOfConnectedCameras ) = _getDLSym ( libHandle,
-		    "ASIGetNumOfConnectedCameras" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetProductIDs ) = _getDLSym ( libHandle,
-		    "ASIGetProductIDs" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetCameraProperty ) = _getDLSym ( libHandle,
-		    "ASIGetCameraProperty" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetCameraPropertyByID ) = _getDLSym ( libHandle,
-		    "ASIGetCameraPropertyByID" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIOpenCamera ) = _getDLSym ( libHandle,
-		    "ASIOpenCamera" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIInitCamera ) = _getDLSym ( libHandle,
-		    "ASIInitCamera" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASICloseCamera ) = _getDLSym ( libHandle,
-		    "ASICloseCamera" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetNumOfControls ) = _getDLSym ( libHandle,
-		    "ASIGetNumOfControls" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetControlCaps ) = _getDLSym ( libHandle,
-		    "ASIGetControlCaps" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetControlValue ) = _getDLSym ( libHandle,
-		    "ASIGetControlValue" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASISetControlValue ) = _getDLSym ( libHandle,
-		    "ASISetControlValue" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASISetROIFormat ) = _getDLSym ( libHandle,
-		    "ASISetROIFormat" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetROIFormat ) = _getDLSym ( libHandle,
-		    "ASIGetROIFormat" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASISetStartPos ) = _getDLSym ( libHandle,
-		    "ASISetStartPos" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetStartPos ) = _getDLSym ( libHandle,
-		    "ASIGetStartPos" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetDroppedFrames ) = _getDLSym ( libHandle,
-		    "ASIGetDroppedFrames" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIEnableDarkSubtract ) = _getDLSym ( libHandle,
-		    "ASIEnableDarkSubtract" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIDisableDarkSubtract ) = _getDLSym ( libHandle,
-		    "ASIDisableDarkSubtract" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIStartVideoCapture ) = _getDLSym ( libHandle,
-		    "ASIStartVideoCapture" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIStopVideoCapture ) = _getDLSym ( libHandle,
-		    "ASIStopVideoCapture" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetVideoData ) = _getDLSym ( libHandle,
-		    "ASIGetVideoData" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
 
-		if (!( *( void** )( &p_ASIPulseGuideOn ) = _getDLSym ( libHandle,
-		    "ASIPulseGuideOn" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIPulseGuideOff ) = _getDLSym ( libHandle,
-		    "ASIPulseGuideOff" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIStartExposure ) = _getDLSym ( libHandle,
-		    "ASIStartExposure" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIStopExposure ) = _getDLSym ( libHandle,
-		    "ASIStopExposure" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetExpStatus ) = _getDLSym ( libHandle,
-		    "ASIGetExpStatus" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetDataAfterExp ) = _getDLSym ( libHandle,
-		    "ASIGetDataAfterExp" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetID ) = _getDLSym ( libHandle,
-		    "ASIGetID" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASISetID ) = _getDLSym ( libHandle,
-		    "ASISetID" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetGainOffset ) = _getDLSym ( libHandle,
-		    "ASIGetGainOffset" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetSDKVersion ) = _getDLSym ( libHandle,
-		    "ASIGetSDKVersion" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetCameraSupportMode ) = _getDLSym ( libHandle,
-		    "ASIGetCameraSupportMode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetCameraMode ) = _getDLSym ( libHandle,
-		    "ASIGetCameraMode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASISetCameraMode ) = _getDLSym ( libHandle,
-		    "ASISetCameraMode" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASISendSoftTrigger ) = _getDLSym ( libHandle,
-		    "ASISendSoftTrigger" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetSerialNumber ) = _getDLSym ( libHandle,
-		    "ASIGetSerialNumber" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASISetTriggerOutputIOConf ) = _getDLSym ( libHandle,
-		    "ASISetTriggerOutputIOConf" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-
-		if (!( *( void** )( &p_ASIGetTriggerOutputIOConf ) = _getDLSym ( libHandle,
-		    "ASIGetTriggerOutputIOConf" ))) {
-		  dlclose ( libHandle );
-		  libHandle = 0;
-		  return OA_ERR_SYMBOL_NOT_FOUND;
-		}
-	}
 
+static int
+_asiLoad ( int level )
+{
+#if HAVE_LIBDL && !HAVE_STATIC_LIBASICAMERA2
+	return oacamDLLoad ( &lib, level );
 #else
 #if HAVE_STATIC_LIBASICAMERA2
 
+	( void ) level;
+
 	p_ASIGetNumOfConnectedCameras = ASIGetNumOfConnectedCameras;
 	p_ASIGetProductIDs = ASIGetProductIDs;
 	p_ASIGetCameraProperty = ASIGetCameraProperty;
@@ -443,29 +196,28 @@ retry:
 	p_ASIGetSerialNumber = ASIGetSerialNumber;
 	p_ASISetTriggerOutputIOConf = ASISetTriggerOutputIOConf;
 	p_ASIGetTriggerOutputIOConf = ASIGetTriggerOutputIOConf;
-
+	return OA_ERR_NONE;
 #else
+	( void ) level;
 	return OA_ERR_LIBRARY_NOT_FOUND;
 #endif	/* HAVE_STATIC_LIBASICAMERA2 */
 #endif	/* HAVE_LIBDL && !HAVE_STATIC_LIBASICAMERA2 */
-	return OA_ERR_NONE;
 }
 
-#if HAVE_LIBDL && !HAVE_STATIC_LIBASICAMERA2
-static void*
-_getDLSym ( void* libHandle, const char* symbol )
+
+// Only the calls needed to enumerate cameras are resolved here
+
+int
+_asiInitLibraryFunctionPointers ( void )
 {
-  void* addr;
-  char* error;
+	return _asiLoad ( OA_DL_ENUMERATE );
+}
 
-  addr = dlsym ( libHandle, symbol );
-  if (( error = dlerror())) {
-    oaLogError ( OA_LOG_CAMERA, "%s: libASICamera2 DL error: %s",
-				__func__, error );
-    addr = 0;
-  }
 
-  return addr;
+int
+_asiInitAllLibraryFunctionPointers ( void )
+{
+	return _asiLoad ( OA_DL_ALL );
 }
-#endif
+
 #endif	/* HAVE_LIBASI2 */
@@ -30,6 +30,7 @@
 #include <ASICamera2.h>
 
 extern int							_asiInitLibraryFunctionPointers ( void );
+extern int							_asiInitAllLibraryFunctionPointers ( void );
 
 extern int							( *p_ASIGetNumOfConnectedCameras )( void ); 
 extern int							( *p_ASIGetProductIDs )( int* );
@@ -47,8 +47,6 @@ typedef struct ZWASI_STATE {
   int32_t		currentMode;
   int32_t		maxBitDepth;
   int32_t		greyscaleMode;
-  // buffering for image transfers
-  frameBuffer*	buffers;
   // camera settings
   int			binMode;
   // control values
@@ -80,6 +78,8 @@ typedef struct ZWASI_STATE {
   uint32_t		fanEnabled;
   uint32_t		patternAdjust;
   uint32_t		dewHeater;
+  // streaming status
+  int			sdkDroppedFrames;
 } ZWASI_STATE;
 
 #endif	/* OA_ZWASI_STATE_H */
@@ -27,6 +27,9 @@
 
 #include <oa_common.h>
 #include <openastro/demosaic.h>
+#include <openastro/errno.h>
+#include <openastro/image.h>
+#include <openastro/video/formats.h>
 
 #include "nearestNeighbour.h"
 #include "bilinear.h"
@@ -64,6 +67,82 @@ oademosaic ( void* source, void* target, int xSize, int ySize, int bitDepth,
 }
 
 
+/*
+ * Demosaic between image descriptors.  The CFA pattern is taken from the
+ * source format if OA_DEMOSAIC_AUTO is given, which also makes views
+ * starting on odd rows or columns of a frame demosaic correctly.  The
+ * algorithms need contiguous data, so padded images are copied through
+ * temporary buffers.
+ */
+
+int
+oademosaicImage ( const oaImage* source, oaImage* target, int cfaPattern,
+		int method )
+{
+	oaImage		packedSource, packedTarget;
+	void*			sourceBuffer = 0;
+	void*			targetBuffer = 0;
+	int				bitDepth, targetFormat, ret;
+
+	if ( !oaFrameFormats[ source->format ].rawColour ||
+			oaFrameFormats[ source->format ].packed ) {
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+	if ( OA_DEMOSAIC_AUTO == cfaPattern ) {
+		cfaPattern = oaFrameFormats[ source->format ].cfaPattern;
+	}
+	bitDepth = oaFrameFormats[ source->format ].bytesPerPixel > 1 ? 16 : 8;
+	targetFormat = OA_DEMOSAIC_FMT ( source->format );
+	if ( !targetFormat ) {
+		// the 10/12/14-bit raw formats aren't covered by OA_DEMOSAIC_FMT
+		targetFormat = oaFrameFormats[ source->format ].littleEndian ?
+				OA_PIX_FMT_RGB48LE : OA_PIX_FMT_RGB48BE;
+	}
+	if ( source->width != target->width || source->height != target->height ) {
+		return -OA_ERR_INVALID_SIZE;
+	}
+
+	packedSource = *source;
+	if ( !oaImageIsPacked ( source )) {
+		if (!( sourceBuffer = malloc ( oaImageRowLength ( source ) *
+				source->height ))) {
+			return -OA_ERR_MEM_ALLOC;
+		}
+		( void ) oaImageInit ( &packedSource, sourceBuffer, source->width,
+				source->height, source->format );
+		( void ) oaImageCopy ( source, &packedSource );
+	}
+
+	target->format = targetFormat;
+	packedTarget = *target;
+	if ( !oaImageIsPacked ( target )) {
+		if (!( targetBuffer = malloc ( oaImageRowLength ( target ) *
+				target->height ))) {
+			if ( sourceBuffer ) {
+				free ( sourceBuffer );
+			}
+			return -OA_ERR_MEM_ALLOC;
+		}
+		( void ) oaImageInit ( &packedTarget, targetBuffer, target->width,
+				target->height, targetFormat );
+	}
+
+	ret = oademosaic ( packedSource.data, packedTarget.data, source->width,
+			source->height, bitDepth, cfaPattern, method );
+
+	if ( targetBuffer ) {
+		if ( !ret ) {
+			( void ) oaImageCopy ( &packedTarget, target );
+		}
+		free ( targetBuffer );
+	}
+	if ( sourceBuffer ) {
+		free ( sourceBuffer );
+	}
+	return ret;
+}
+
+
 const char*
 oademosaicMethodName ( int method )
 {
@@ -28,6 +28,7 @@
 #include <oa_common.h>
 
 #include <openastro/imgproc.h>
+#include <openastro/image.h>
 #include <openastro/demosaic.h>
 #include <openastro/errno.h>
 #include <openastro/util.h>
@@ -228,3 +229,33 @@ oaFocusScore ( void* source, void* target, int xSize, int ySize,
   // FIX ME -- return more meaningful error
   return -1;
 }
+
+
+/*
+ * Score an image that may have padded rows or be a view into a larger
+ * frame.  The scoring needs a contiguous frame, so anything else is
+ * copied first.
+ */
+
+int
+oaFocusScoreImage ( const oaImage* image )
+{
+	oaImage		packed;
+	void*			buffer;
+	int				ret;
+
+	if ( oaImageIsPacked ( image )) {
+		return oaFocusScore ( image->data, 0, image->width, image->height,
+				image->format );
+	}
+
+	if (!( buffer = malloc ( oaImageRowLength ( image ) * image->height ))) {
+		return -OA_ERR_MEM_ALLOC;
+	}
+	( void ) oaImageInit ( &packed, buffer, image->width, image->height,
+			image->format );
+	( void ) oaImageCopy ( image, &packed );
+	ret = oaFocusScore ( buffer, 0, packed.width, packed.height, packed.format );
+	free ( buffer );
+	return ret;
+}
@@ -29,10 +29,21 @@
 #include <openastro/errno.h>
 #include <openastro/util.h>
 #include <openastro/imgproc.h>
+#include <openastro/image.h>
 #include <openastro/video/formats.h>
 
 #include "imgstack.h"
 
+#define	STACK_SUM									1
+#define	STACK_MEAN								2
+#define	STACK_MEDIAN							3
+#define	STACK_MAXIMUM							4
+#define	STACK_KAPPA_SIGMA					5
+#define	STACK_MEDIAN_KAPPA_SIGMA	6
+
+static int	_stackImages ( const oaImage*, unsigned int, oaImage*, int,
+								double );
+
 
 int
 oaStackSum ( void** frameArray, unsigned int numFrames, void* target,
@@ -235,3 +246,132 @@ oaStackMedianKappaSigma ( void** frameArray, unsigned int numFrames,
 			frameFormat );
 	return -OA_ERR_UNSUPPORTED_FORMAT;
 }
+
+
+int
+oaStackSumImage ( const oaImage* frames, unsigned int numFrames,
+		oaImage* target )
+{
+	return _stackImages ( frames, numFrames, target, STACK_SUM, 0 );
+}
+
+
+int
+oaStackMeanImage ( const oaImage* frames, unsigned int numFrames,
+		oaImage* target )
+{
+	return _stackImages ( frames, numFrames, target, STACK_MEAN, 0 );
+}
+
+
+int
+oaStackMedianImage ( const oaImage* frames, unsigned int numFrames,
+		oaImage* target )
+{
+	return _stackImages ( frames, numFrames, target, STACK_MEDIAN, 0 );
+}
+
+
+int
+oaStackMaximumImage ( const oaImage* frames, unsigned int numFrames,
+		oaImage* target )
+{
+	return _stackImages ( frames, numFrames, target, STACK_MAXIMUM, 0 );
+}
+
+
+int
+oaStackKappaSigmaImage ( const oaImage* frames, unsigned int numFrames,
+		oaImage* target, double kappa )
+{
+	return _stackImages ( frames, numFrames, target, STACK_KAPPA_SIGMA,
+			kappa );
+}
+
+
+int
+oaStackMedianKappaSigmaImage ( const oaImage* frames, unsigned int numFrames,
+		oaImage* target, double kappa )
+{
+	return _stackImages ( frames, numFrames, target, STACK_MEDIAN_KAPPA_SIGMA,
+			kappa );
+}
+
+
+/*
+ * Every stacking method works on each pixel independently, so frames with
+ * padded rows or views into larger frames can be stacked a row at a time
+ * rather than having to be copied into contiguous buffers first
+ */
+
+static int
+_stackImages ( const oaImage* frames, unsigned int numFrames,
+		oaImage* target, int method, double kappa )
+{
+	void**				rows;
+	unsigned int	i, y, numRows, length;
+	int						packed, ret = OA_ERR_NONE;
+
+	if ( !numFrames ) {
+		return -OA_ERR_INVALID_SIZE;
+	}
+
+	packed = oaImageIsPacked ( target );
+	for ( i = 0; i < numFrames; i++ ) {
+		if ( frames[i].width != target->width ||
+				frames[i].height != target->height ||
+				frames[i].format != target->format ) {
+			oaLogError ( OA_LOG_IMGPROC, "%s: frame %d does not match target",
+					__func__, i );
+			return -OA_ERR_INVALID_SIZE;
+		}
+		packed &= oaImageIsPacked ( &frames[i] );
+	}
+
+	if (!( rows = malloc ( numFrames * sizeof ( void* )))) {
+		return -OA_ERR_MEM_ALLOC;
+	}
+
+	if ( packed ) {
+		numRows = 1;
+		length = oaImageRowLength ( target ) * target->height;
+	} else {
+		numRows = target->height;
+		length = oaImageRowLength ( target );
+	}
+
+	for ( y = 0; y < numRows && ret >= 0; y++ ) {
+		for ( i = 0; i < numFrames; i++ ) {
+			rows[i] = oaImageRow ( &frames[i], y );
+		}
+		switch ( method ) {
+			case STACK_SUM:
+				ret = oaStackSum ( rows, numFrames, oaImageRow ( target, y ), length,
+						target->format );
+				break;
+			case STACK_MEAN:
+				ret = oaStackMean ( rows, numFrames, oaImageRow ( target, y ),
+						length, target->format );
+				break;
+			case STACK_MEDIAN:
+				ret = oaStackMedian ( rows, numFrames, oaImageRow ( target, y ),
+						length, target->format );
+				break;
+			case STACK_MAXIMUM:
+				ret = oaStackMaximum ( rows, numFrames, oaImageRow ( target, y ),
+						length, target->format );
+				break;
+			case STACK_KAPPA_SIGMA:
+				ret = oaStackKappaSigma ( rows, numFrames, oaImageRow ( target, y ),
+						length, kappa, target->format );
+				break;
+			case STACK_MEDIAN_KAPPA_SIGMA:
+				ret = oaStackMedianKappaSigma ( rows, numFrames,
+						oaImageRow ( target, y ), length, kappa, target->format );
+				break;
+		}
+	}
+
+	free (( void* ) rows );
+	return ret;
+}
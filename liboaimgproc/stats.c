@@ -0,0 +1,631 @@
+/*****************************************************************************
+ *
+ * stats.c -- single-pass frame statistics
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <openastro/demosaic.h>
+#include <openastro/errno.h>
+#include <openastro/image.h>
+#include <openastro/imgproc.h>
+#include <openastro/video/formats.h>
+#include <openastro/util.h>
+
+
+// Every pixel visited only increments a histogram bin.  Min, max, mean,
+// variance, saturation and the median are then all derived from the
+// full-resolution histograms, which are far smaller than the frame, so
+// there is only ever one pass over the image data.  The scatter into the
+// histograms can't be vectorised, but for 16-bit data the byte order
+// conversion and the range of values present can, and knowing that range
+// means only the occupied part of each 64K-entry histogram has to be
+// cleared and scanned afterwards.
+
+#define	FULL_RANGE						65536
+#define	SUB_HISTOGRAMS				4
+
+// Samples of a 16-bit row converted at a time.  A multiple of both two
+// and three so CFA and RGB rows split on pixel boundaries
+
+#define	DECODE_CHUNK					3072
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define	HOST_LITTLE_ENDIAN	0
+#else
+#define	HOST_LITTLE_ENDIAN	1
+#endif
+
+static void	_histogram8 ( const uint8_t*, unsigned int, unsigned int,
+								unsigned int, uint32_t** );
+static void	_histogram16 ( const uint8_t*, unsigned int, unsigned int,
+								unsigned int, int, uint32_t**, unsigned int*, unsigned int* );
+static void	_histogram8Mono ( const uint8_t*, unsigned int, uint32_t* );
+static void	_decode16 ( const uint8_t*, unsigned int, int, uint16_t*,
+								unsigned int*, unsigned int* );
+static void	_deriveStats ( const uint32_t*, unsigned int, unsigned int,
+								unsigned int, oaChannelStats* );
+static void	_medianMAD ( const uint32_t*, unsigned int, unsigned int,
+								unsigned long, oaChannelStats* );
+
+
+oaFrameStats*
+oaFrameStatsCreate ( void )
+{
+	oaFrameStats*		stats;
+
+	if (!( stats = calloc ( 1, sizeof ( oaFrameStats )))) {
+		return 0;
+	}
+	// Zeroed once here.  After that only the bins a frame used are cleared
+	if (!( stats->fullHistograms = calloc ( OA_STATS_MAX_CHANNELS *
+			FULL_RANGE, sizeof ( uint32_t ))) ||
+			!( stats->scratch = malloc (( FULL_RANGE + SUB_HISTOGRAMS * 256 ) *
+			sizeof ( uint32_t )))) {
+		free (( void* ) stats->fullHistograms );
+		free (( void* ) stats );
+		return 0;
+	}
+	return stats;
+}
+
+
+void
+oaFrameStatsDestroy ( oaFrameStats* stats )
+{
+	if ( stats ) {
+		free (( void* ) stats->fullHistograms );
+		free (( void* ) stats->binnedHistograms );
+		free (( void* ) stats->scratch );
+		free (( void* ) stats );
+	}
+}
+
+
+/*
+ * Compute histograms, min, max, mean, variance and the number of
+ * saturated samples for each channel of a frame, and optionally the
+ * median and median absolute deviation.  Only every "subsample"th pixel
+ * of every "subsample"th row is visited (0 or 1 for all of them).  "bins"
+ * is the number of histogram bins per channel, rounded down to a power of
+ * two, or 0 for one bin per possible value.  With OA_STATS_SPLIT_CFA,
+ * Bayer frames are split into red, green and blue channels.
+ */
+
+int
+oaFrameStatsCompute ( oaFrameStats* stats, const oaImage* image,
+		unsigned int bins, unsigned int subsample, int flags )
+{
+	frameFormatInfo*	info = &oaFrameFormats[ image->format ];
+	uint32_t*					histograms[4];
+	uint32_t*					h;
+	unsigned int			range, bits, bpp, channels, c, v, y, shift, lo, hi;
+	unsigned int			map[4] = { 0, 0, 0, 0 };
+	unsigned long			count;
+	const uint8_t*		row;
+
+	bpp = info->bytesPerPixel;
+	if ( info->planar || info->packed || info->lumChrom || info->hasAlpha ||
+			!OA_WHOLE_BYTES_PER_PIXEL( image->format ) || !bpp || bpp > 6 ) {
+		oaLogError ( OA_LOG_IMGPROC, "%s: unsupported format %d", __func__,
+				image->format );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	channels = 1;
+	if ( info->fullColour ) {
+		if ( bpp != 3 && bpp != 6 ) {
+			oaLogError ( OA_LOG_IMGPROC, "%s: unsupported format %d", __func__,
+					image->format );
+			return -OA_ERR_UNSUPPORTED_FORMAT;
+		}
+		channels = 3;
+		bpp /= 3;
+		map[0] = 0;
+		map[1] = 1;
+		map[2] = 2;
+		if ( OA_PIX_FMT_BGR24 == image->format ||
+				OA_PIX_FMT_BGR48BE == image->format ||
+				OA_PIX_FMT_BGR48LE == image->format ) {
+			map[0] = 2;
+			map[2] = 0;
+		}
+	} else {
+		if ( bpp > 2 ) {
+			oaLogError ( OA_LOG_IMGPROC, "%s: unsupported format %d", __func__,
+					image->format );
+			return -OA_ERR_UNSUPPORTED_FORMAT;
+		}
+		if (( flags & OA_STATS_SPLIT_CFA ) && info->rawColour ) {
+			// map[] gives the colour of ( x & 1 ) + 2 * ( y & 1 )
+			channels = 3;
+			switch ( info->cfaPattern ) {
+				case OA_DEMOSAIC_RGGB:
+					map[0] = 0; map[1] = 1; map[2] = 1; map[3] = 2;
+					break;
+				case OA_DEMOSAIC_BGGR:
+					map[0] = 2; map[1] = 1; map[2] = 1; map[3] = 0;
+					break;
+				case OA_DEMOSAIC_GRBG:
+					map[0] = 1; map[1] = 0; map[2] = 2; map[3] = 1;
+					break;
+				case OA_DEMOSAIC_GBRG:
+					map[0] = 1; map[1] = 2; map[2] = 0; map[3] = 1;
+					break;
+				default:
+					channels = 1;
+					break;
+			}
+		}
+	}
+
+	bits = info->bitsPerPixel / ( info->fullColour ? 3 : 1 );
+	range = ( 1 == bpp ) ? 256 : FULL_RANGE;
+	if ( !bits || bits > 16 ) {
+		bits = 8 * bpp;
+	}
+
+	stats->format = image->format;
+	stats->channels = channels;
+	stats->maxValue = ( 1 << bits ) - 1;
+	if ( subsample < 1 ) {
+		subsample = 1;
+	}
+	// An odd step visits both colours of each row of a CFA pattern
+	if ( channels == 3 && !info->fullColour && !( subsample & 1 )) {
+		subsample++;
+	}
+	stats->subsample = subsample;
+
+	for ( c = 0; c < OA_STATS_MAX_CHANNELS; c++ ) {
+		histograms[c] = stats->fullHistograms + c * FULL_RANGE;
+		( void ) memset ( histograms[c] + stats->usedMin, 0,
+				( stats->usedMax - stats->usedMin + 1 ) * sizeof ( uint32_t ));
+	}
+
+	// 8-bit histograms are small enough to scan in full
+	lo = 0;
+	hi = range - 1;
+	if ( 2 == bpp ) {
+		lo = range - 1;
+		hi = 0;
+	}
+
+	if ( 1 == bpp && 1 == channels && 1 == subsample ) {
+		( void ) memset ( stats->scratch, 0, SUB_HISTOGRAMS * 256 *
+				sizeof ( uint32_t ));
+		for ( y = 0; y < image->height; y++ ) {
+			_histogram8Mono ( oaImageRow ( image, y ), image->width,
+					stats->scratch );
+		}
+		for ( v = 0; v < 256; v++ ) {
+			histograms[0][v] = stats->scratch[v] + stats->scratch[ 256 + v ] +
+					stats->scratch[ 512 + v ] + stats->scratch[ 768 + v ];
+		}
+	} else {
+		for ( y = 0; y < image->height; y += subsample ) {
+			uint32_t*	rowHistograms[3];
+			row = oaImageRow ( image, y );
+			if ( info->fullColour ) {
+				rowHistograms[0] = histograms[ map[0]];
+				rowHistograms[1] = histograms[ map[1]];
+				rowHistograms[2] = histograms[ map[2]];
+			} else {
+				rowHistograms[0] = histograms[ map[ 2 * ( y & 1 )]];
+				rowHistograms[1] = histograms[ map[ 2 * ( y & 1 ) + 1 ]];
+			}
+			if ( 1 == bpp ) {
+				_histogram8 ( row, image->width, subsample,
+						info->fullColour ? 3 : 1, rowHistograms );
+			} else {
+				_histogram16 ( row, image->width, subsample,
+						info->fullColour ? 3 : 1, info->littleEndian, rowHistograms,
+						&lo, &hi );
+			}
+		}
+	}
+
+	if ( lo > hi ) {
+		lo = hi = 0;
+	}
+	stats->usedMin = lo;
+	stats->usedMax = hi;
+
+	count = 0;
+	for ( c = 0; c < channels; c++ ) {
+		_deriveStats ( histograms[c], lo, hi, stats->maxValue,
+				&stats->channel[c] );
+		count += stats->channel[c].count;
+	}
+
+	// Combine the channels for the whole-frame figures
+
+	stats->all = stats->channel[0];
+	if ( channels > 1 ) {
+		double	sumSq = 0;
+		stats->all.histogram = 0;
+		stats->all.count = count;
+		stats->all.mean = 0;
+		stats->all.saturated = 0;
+		for ( c = 0; c < channels; c++ ) {
+			oaChannelStats* s = &stats->channel[c];
+			if ( s->count && s->min < stats->all.min ) {
+				stats->all.min = s->min;
+			}
+			if ( s->max > stats->all.max ) {
+				stats->all.max = s->max;
+			}
+			stats->all.mean += s->mean * s->count;
+			sumSq += ( s->variance + s->mean * s->mean ) * s->count;
+			stats->all.saturated += s->saturated;
+		}
+		if ( count ) {
+			stats->all.mean /= count;
+			stats->all.variance = sumSq / count - stats->all.mean *
+					stats->all.mean;
+		}
+	}
+
+	stats->medianValid = 0;
+	if ( flags & OA_STATS_MEDIAN ) {
+		for ( c = 0; c < channels; c++ ) {
+			_medianMAD ( histograms[c], lo, hi, stats->channel[c].count,
+					&stats->channel[c] );
+		}
+		if ( channels > 1 ) {
+			h = stats->scratch;
+			for ( v = lo; v <= hi; v++ ) {
+				h[v] = histograms[0][v] + histograms[1][v] + histograms[2][v];
+			}
+			_medianMAD ( h, lo, hi, count, &stats->all );
+		} else {
+			stats->all.median = stats->channel[0].median;
+			stats->all.mad = stats->channel[0].mad;
+		}
+		stats->medianValid = 1;
+	}
+
+	// Reduce to the requested number of bins over the range of the format's
+	// bit depth.  Values above that range go in the top bin.
+
+	shift = 0;
+	if ( bins ) {
+		while (( 1U << ( bits - shift )) > bins && shift < bits ) {
+			shift++;
+		}
+	}
+	stats->binShift = shift;
+	if ( !shift ) {
+		stats->bins = range;
+		for ( c = 0; c < channels; c++ ) {
+			stats->channel[c].histogram = histograms[c];
+		}
+		if ( 1 == channels ) {
+			stats->all.histogram = histograms[0];
+		}
+		return OA_ERR_NONE;
+	}
+
+	stats->bins = 1 << ( bits - shift );
+	if ( stats->binnedSize < channels * stats->bins ) {
+		uint32_t*	binned;
+		if (!( binned = realloc ( stats->binnedHistograms,
+				OA_STATS_MAX_CHANNELS * stats->bins * sizeof ( uint32_t )))) {
+			return -OA_ERR_MEM_ALLOC;
+		}
+		stats->binnedHistograms = binned;
+		stats->binnedSize = OA_STATS_MAX_CHANNELS * stats->bins;
+	}
+	for ( c = 0; c < channels; c++ ) {
+		unsigned int	b;
+		h = stats->binnedHistograms + c * stats->bins;
+		( void ) memset ( h, 0, stats->bins * sizeof ( uint32_t ));
+		for ( v = lo; v <= hi; v++ ) {
+			b = v >> shift;
+			h[ b < stats->bins ? b : stats->bins - 1 ] += histograms[c][v];
+		}
+		stats->channel[c].histogram = h;
+	}
+	if ( 1 == channels ) {
+		stats->all.histogram = stats->channel[0].histogram;
+	}
+
+	return OA_ERR_NONE;
+}
+
+
+/*
+ * Consecutive pixels often have the same value, which serialises
+ * increments of the same histogram bin.  Spreading them across four
+ * histograms that are summed afterwards avoids that.
+ */
+
+static void
+_histogram8Mono ( const uint8_t* row, unsigned int width, uint32_t* sub )
+{
+	unsigned int	x = 0;
+
+	for ( ; x + 4 <= width; x += 4 ) {
+		sub[ row[x]]++;
+		sub[ 256 + row[x+1]]++;
+		sub[ 512 + row[x+2]]++;
+		sub[ 768 + row[x+3]]++;
+	}
+	for ( ; x < width; x++ ) {
+		sub[ row[x]]++;
+	}
+}
+
+
+// histograms[] holds the histogram for each sample of a pixel in order,
+// or for the even and odd pixels of a CFA row
+
+static void
+_histogram8 ( const uint8_t* row, unsigned int width, unsigned int step,
+		unsigned int samples, uint32_t** histograms )
+{
+	unsigned int	x;
+
+	if ( 3 == samples ) {
+		for ( x = 0; x < width; x += step ) {
+			const uint8_t* p = row + x * 3;
+			histograms[0][ p[0]]++;
+			histograms[1][ p[1]]++;
+			histograms[2][ p[2]]++;
+		}
+		return;
+	}
+	for ( x = 0; x < width; x += step ) {
+		histograms[ x & 1 ][ row[x]]++;
+	}
+}
+
+
+// lo and hi are widened to take in every value counted
+
+static void
+_histogram16 ( const uint8_t* row, unsigned int width, unsigned int step,
+		unsigned int samples, int littleEndian, uint32_t** histograms,
+		unsigned int* lo, unsigned int* hi )
+{
+	uint16_t			buffer[ DECODE_CHUNK ];
+	unsigned int	x, s, n, total;
+
+	// Whole rows are converted to host order a chunk at a time, which can be
+	// done with SIMD, leaving just the scatter for each sample
+	if ( 1 == step ) {
+		total = width * samples;
+		for ( ; total; total -= n, row += n * 2 ) {
+			n = total < DECODE_CHUNK ? total : DECODE_CHUNK;
+			_decode16 ( row, n, littleEndian != HOST_LITTLE_ENDIAN, buffer, lo,
+					hi );
+			if ( 3 == samples ) {
+				for ( x = 0; x < n; x += 3 ) {
+					histograms[0][ buffer[x]]++;
+					histograms[1][ buffer[x+1]]++;
+					histograms[2][ buffer[x+2]]++;
+				}
+			} else {
+				for ( x = 0; x + 2 <= n; x += 2 ) {
+					histograms[0][ buffer[x]]++;
+					histograms[1][ buffer[x+1]]++;
+				}
+				if ( x < n ) {
+					histograms[0][ buffer[x]]++;
+				}
+			}
+		}
+		return;
+	}
+
+	for ( x = 0; x < width; x += step ) {
+		const uint8_t* p = row + x * samples * 2;
+		for ( s = 0; s < samples; s++, p += 2 ) {
+			unsigned int v = littleEndian ? p[0] | ( p[1] << 8 ) :
+					( p[0] << 8 ) | p[1];
+			histograms[ samples == 3 ? s : ( x & 1 )][v]++;
+			if ( v < *lo ) {
+				*lo = v;
+			}
+			if ( v > *hi ) {
+				*hi = v;
+			}
+		}
+	}
+}
+
+
+/*
+ * Copy "count" 16-bit samples to host byte order, widening lo and hi to
+ * the range of the values seen
+ */
+
+static void
+_decode16 ( const uint8_t* source, unsigned int count, int swap,
+		uint16_t* target, unsigned int* lo, unsigned int* hi )
+{
+	unsigned int	i = 0, min = *lo, max = *hi;
+	uint16_t			v;
+
+#if defined(__SSE2__)
+	// SSE2 only has signed 16-bit min and max, so the values are offset
+	// by 0x8000 to compare them
+	const __m128i	bias = _mm_set1_epi16 (( short ) 0x8000 );
+	__m128i				vmin = _mm_set1_epi16 ( 0x7fff );
+	__m128i				vmax = _mm_set1_epi16 (( short ) 0x8000 );
+	int16_t				lanes[ 16 ];
+	unsigned int	j;
+
+	if ( count >= 8 ) {
+		for ( ; i + 8 <= count; i += 8 ) {
+			__m128i s = _mm_loadu_si128 (( const __m128i* )( source + i * 2 ));
+			if ( swap ) {
+				s = _mm_or_si128 ( _mm_slli_epi16 ( s, 8 ), _mm_srli_epi16 ( s, 8 ));
+			}
+			_mm_storeu_si128 (( __m128i* )( target + i ), s );
+			s = _mm_xor_si128 ( s, bias );
+			vmin = _mm_min_epi16 ( vmin, s );
+			vmax = _mm_max_epi16 ( vmax, s );
+		}
+		_mm_storeu_si128 (( __m128i* ) lanes, _mm_xor_si128 ( vmin, bias ));
+		_mm_storeu_si128 (( __m128i* )( lanes + 8 ), _mm_xor_si128 ( vmax,
+				bias ));
+		for ( j = 0; j < 8; j++ ) {
+			if (( uint16_t ) lanes[j] < min ) {
+				min = ( uint16_t ) lanes[j];
+			}
+			if (( uint16_t ) lanes[ j + 8 ] > max ) {
+				max = ( uint16_t ) lanes[ j + 8 ];
+			}
+		}
+	}
+#elif defined(__ARM_NEON)
+	uint16x8_t		vmin = vdupq_n_u16 ( 0xffff );
+	uint16x8_t		vmax = vdupq_n_u16 ( 0 );
+	uint16_t			lanes[ 16 ];
+	unsigned int	j;
+
+	if ( count >= 8 ) {
+		for ( ; i + 8 <= count; i += 8 ) {
+			uint16x8_t s = vld1q_u16 (( const uint16_t* )( source + i * 2 ));
+			if ( swap ) {
+				s = vreinterpretq_u16_u8 ( vrev16q_u8 ( vreinterpretq_u8_u16 ( s )));
+			}
+			vst1q_u16 ( target + i, s );
+			vmin = vminq_u16 ( vmin, s );
+			vmax = vmaxq_u16 ( vmax, s );
+		}
+		vst1q_u16 ( lanes, vmin );
+		vst1q_u16 ( lanes + 8, vmax );
+		for ( j = 0; j < 8; j++ ) {
+			if ( lanes[j] < min ) {
+				min = lanes[j];
+			}
+			if ( lanes[ j + 8 ] > max ) {
+				max = lanes[ j + 8 ];
+			}
+		}
+	}
+#endif
+	for ( ; i < count; i++ ) {
+		( void ) memcpy ( &v, source + i * 2, 2 );
+		if ( swap ) {
+			v = ( v >> 8 ) | ( v << 8 );
+		}
+		target[i] = v;
+		if ( v < min ) {
+			min = v;
+		}
+		if ( v > max ) {
+			max = v;
+		}
+	}
+	*lo = min;
+	*hi = max;
+}
+
+
+// Only bins lo to hi (inclusive) can be non-zero
+
+static void
+_deriveStats ( const uint32_t* histogram, unsigned int lo, unsigned int hi,
+		unsigned int maxValue, oaChannelStats* stats )
+{
+	uint64_t			sum = 0, sumSq = 0;
+	unsigned long	count = 0, saturated = 0;
+	unsigned int	v, min = hi + 1, max = 0;
+
+	for ( v = lo; v <= hi; v++ ) {
+		if ( histogram[v] ) {
+			if ( v < min ) {
+				min = v;
+			}
+			max = v;
+			count += histogram[v];
+			sum += ( uint64_t ) v * histogram[v];
+			sumSq += ( uint64_t ) v * v * histogram[v];
+			if ( v >= maxValue ) {
+				saturated += histogram[v];
+			}
+		}
+	}
+
+	stats->histogram = 0;
+	stats->count = count;
+	stats->min = count ? min : 0;
+	stats->max = max;
+	stats->saturated = saturated;
+	stats->mean = stats->variance = 0;
+	stats->median = stats->mad = 0;
+	if ( count ) {
+		stats->mean = ( double ) sum / count;
+		stats->variance = ( double ) sumSq / count - stats->mean * stats->mean;
+		if ( stats->variance < 0 ) {
+			stats->variance = 0;
+		}
+	}
+}
+
+
+static void
+_medianMAD ( const uint32_t* histogram, unsigned int lo, unsigned int hi,
+		unsigned long count, oaChannelStats* stats )
+{
+	unsigned long	half, total;
+	unsigned int	v, d;
+
+	stats->median = stats->mad = 0;
+	if ( !count ) {
+		return;
+	}
+
+	half = ( count + 1 ) / 2;
+	total = 0;
+	for ( v = lo; v < hi; v++ ) {
+		if (( total += histogram[v] ) >= half ) {
+			break;
+		}
+	}
+	stats->median = v;
+
+	// Widen a window around the median until it holds half the samples
+
+	total = histogram[v];
+	for ( d = 0; total < half; ) {
+		d++;
+		if ( d <= v - lo ) {
+			total += histogram[ v - d ];
+		}
+		if ( v + d <= hi ) {
+			total += histogram[ v + d ];
+		}
+	}
+	stats->mad = d;
+}
@@ -0,0 +1,394 @@
+/*****************************************************************************
+ *
+ * bin.c -- software binning of frames
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <openastro/errno.h>
+#include <openastro/image.h>
+#include <openastro/video.h>
+#include <openastro/video/formats.h>
+#include <openastro/util.h>
+
+#include "threads.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define	HOST_LITTLE_ENDIAN	0
+#else
+#define	HOST_LITTLE_ENDIAN	1
+#endif
+
+typedef struct {
+	const oaImage*	source;
+	oaImage*				target;
+	unsigned int		factor;
+	unsigned int		samplesPerPixel;
+	unsigned int		sampleSize;
+	unsigned int		cfa;
+	unsigned int		swap;
+	unsigned int		average;
+	uint32_t				maxValue;
+} binBands;
+
+static int	_binSetup ( const oaImage*, unsigned int, binBands* );
+static int	_binBand ( void*, unsigned int, unsigned int );
+static void	_accumulate8 ( uint32_t*, const uint8_t*, unsigned int );
+static void	_accumulate16 ( uint32_t*, const uint8_t*, unsigned int,
+								unsigned int );
+
+
+/*
+ * Binning works on uncompressed frames of one or three 8- or 16-bit
+ * samples per pixel, with every pixel stored whole
+ */
+
+int
+oaCanBinFormat ( int format )
+{
+	frameFormatInfo*	fmt;
+	unsigned int			bpp, samplesPerPixel, sampleSize;
+
+	if ( format <= 0 || format >= OA_PIX_FMT_LAST_P1 ) {
+		return 0;
+	}
+	fmt = &oaFrameFormats[ format ];
+	if ( fmt->planar || fmt->packed || fmt->lumChrom || fmt->hasAlpha ||
+			fmt->useLibraw || !fmt->lossless ||
+			!OA_WHOLE_BYTES_PER_PIXEL( format )) {
+		return 0;
+	}
+	bpp = fmt->bytesPerPixel;
+	samplesPerPixel = fmt->fullColour ? 3 : 1;
+	sampleSize = bpp / samplesPerPixel;
+	return (( sampleSize == 1 || sampleSize == 2 ) &&
+			sampleSize * samplesPerPixel == bpp ) ? 1 : 0;
+}
+
+
+/*
+ * Work out the size of the image that binning "source" by "factor" in
+ * each direction gives.  Raw colour images are binned a CFA cell at a
+ * time so that the result is still a mosaic with the same pattern, which
+ * means they lose any partial cell at the right and bottom edges.
+ */
+
+int
+oaBinnedImageSize ( const oaImage* source, unsigned int factor,
+		unsigned int* width, unsigned int* height )
+{
+	binBands	bands;
+	int				ret;
+
+	if (( ret = _binSetup ( source, factor, &bands )) < 0 ) {
+		return ret;
+	}
+	if ( bands.cfa ) {
+		*width = source->width / ( 2 * factor ) * 2;
+		*height = source->height / ( 2 * factor ) * 2;
+	} else {
+		*width = source->width / factor;
+		*height = source->height / factor;
+	}
+	return OA_ERR_NONE;
+}
+
+
+/*
+ * Bin "source" by "factor" (2 to 4) into "target", either summing the
+ * binned pixels (saturating at the largest value the format can hold) or
+ * averaging them.  For raw colour frames each output pixel combines the
+ * pixels of the same colour from a block of factor x factor CFA cells.
+ * The target must already have the size given by oaBinnedImageSize()
+ * and its format is set to that of the source.
+ *
+ * The target may share its data with the source as long as the strides
+ * are the same or the target rows are packed, in which case the work is
+ * done in a single thread, top to bottom, so that no source row is
+ * overwritten before it has been read.
+ */
+
+int
+oaBinImage ( const oaImage* source, oaImage* target, unsigned int factor,
+		int mode )
+{
+	binBands			bands;
+	unsigned int	width, height;
+	int						ret;
+
+	if (( ret = oaBinnedImageSize ( source, factor, &width, &height )) < 0 ) {
+		return ret;
+	}
+	if ( target->width != width || target->height != height ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: target is %ux%u, need %ux%u", __func__,
+				target->width, target->height, width, height );
+		return -OA_ERR_INVALID_SIZE;
+	}
+	if ( mode != OA_BIN_SUM && mode != OA_BIN_AVERAGE ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+
+	( void ) _binSetup ( source, factor, &bands );
+	bands.target = target;
+	bands.average = ( mode == OA_BIN_AVERAGE ) ? 1 : 0;
+	target->format = source->format;
+	target->originX = source->originX / factor;
+	target->originY = source->originY / factor;
+	if ( bands.cfa ) {
+		target->originX &= ~1U;
+		target->originY &= ~1U;
+	}
+
+	if ( target->data == source->data ) {
+		if ( target->stride > source->stride ) {
+			return -OA_ERR_INVALID_SIZE;
+		}
+		return _binBand ( &bands, 0, height );
+	}
+	return oaVideoRunBands ( height, ( unsigned long ) source->width *
+			source->height, 1, _binBand, &bands );
+}
+
+
+static int
+_binSetup ( const oaImage* source, unsigned int factor, binBands* bands )
+{
+	frameFormatInfo*	fmt = &oaFrameFormats[ source->format ];
+
+	if ( factor < 2 || factor > OA_BIN_MAX_FACTOR ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+
+	if ( !oaCanBinFormat ( source->format )) {
+		oaLogError ( OA_LOG_VIDEO, "%s: Unable to bin format %d", __func__,
+				source->format );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	memset ( bands, 0, sizeof ( binBands ));
+	bands->source = source;
+	bands->factor = factor;
+	bands->samplesPerPixel = fmt->fullColour ? 3 : 1;
+	bands->sampleSize = ( unsigned int ) fmt->bytesPerPixel /
+			bands->samplesPerPixel;
+	bands->cfa = fmt->rawColour ? 1 : 0;
+	bands->swap = ( bands->sampleSize == 2 &&
+			fmt->littleEndian != HOST_LITTLE_ENDIAN ) ? 1 : 0;
+	bands->maxValue = ( bands->sampleSize == 1 ) ? 0xff : 0xffff;
+	return OA_ERR_NONE;
+}
+
+
+/*
+ * Each output row is made by first adding the source rows that contribute
+ * to it into a row of 32-bit totals, which is where almost all of the
+ * work is and is done with vector instructions where possible, and then
+ * adding up each output pixel's columns from those totals.
+ */
+
+static int
+_binBand ( void* arg, unsigned int start, unsigned int end )
+{
+	binBands*				bands = arg;
+	const oaImage*	source = bands->source;
+	oaImage*				target = bands->target;
+	unsigned int		n = bands->factor, spp = bands->samplesPerPixel;
+	unsigned int		rowSamples, outSamples, cellWidth, divisor, x, y, c, i, j;
+	unsigned int		r;
+	uint32_t*				totals;
+	uint32_t				sum;
+	uint16_t				v;
+	uint8_t*				t;
+
+	if ( bands->cfa ) {
+		rowSamples = target->width * n;
+		cellWidth = 2 * n;
+	} else {
+		rowSamples = target->width * n * spp;
+		cellWidth = n;
+	}
+	if (!( totals = malloc ( rowSamples * sizeof ( uint32_t )))) {
+		return -OA_ERR_MEM_ALLOC;
+	}
+	divisor = n * n;
+
+	for ( y = start; y < end; y++ ) {
+		memset ( totals, 0, rowSamples * sizeof ( uint32_t ));
+		for ( j = 0; j < n; j++ ) {
+			if ( bands->cfa ) {
+				r = ( y / 2 ) * cellWidth + 2 * j + ( y & 1 );
+			} else {
+				r = y * n + j;
+			}
+			if ( bands->sampleSize == 1 ) {
+				_accumulate8 ( totals, oaImageRow ( source, r ), rowSamples );
+			} else {
+				_accumulate16 ( totals, oaImageRow ( source, r ), rowSamples,
+						bands->swap );
+			}
+		}
+
+		// Reduce the totals to one per output sample, in place, as no output
+		// sample lands after any of the totals it's made from
+
+		outSamples = target->width * spp;
+		if ( bands->cfa ) {
+			for ( x = 0; x < outSamples; x++ ) {
+				const uint32_t* s = totals + ( x / 2 ) * cellWidth + ( x & 1 );
+				for ( sum = 0, i = 0; i < n; i++ ) {
+					sum += s[ 2 * i ];
+				}
+				totals[x] = sum;
+			}
+		} else if ( spp == 1 && n == 2 ) {
+			for ( x = 0; x < outSamples; x++ ) {
+				totals[x] = totals[ 2 * x ] + totals[ 2 * x + 1 ];
+			}
+		} else {
+			for ( x = 0; x < target->width; x++ ) {
+				for ( c = 0; c < spp; c++ ) {
+					const uint32_t* s = totals + x * n * spp + c;
+					for ( sum = 0, i = 0; i < n; i++ ) {
+						sum += s[ i * spp ];
+					}
+					totals[ x * spp + c ] = sum;
+				}
+			}
+		}
+
+		if ( bands->average ) {
+			for ( x = 0; x < outSamples; x++ ) {
+				totals[x] = ( totals[x] + divisor / 2 ) / divisor;
+			}
+		} else {
+			for ( x = 0; x < outSamples; x++ ) {
+				if ( totals[x] > bands->maxValue ) {
+					totals[x] = bands->maxValue;
+				}
+			}
+		}
+
+		t = oaImageRow ( target, y );
+		if ( bands->sampleSize == 1 ) {
+			for ( x = 0; x < outSamples; x++ ) {
+				t[x] = totals[x];
+			}
+		} else {
+			uint16_t* t16 = ( uint16_t* ) t;
+			for ( x = 0; x < outSamples; x++ ) {
+				v = totals[x];
+				t16[x] = bands->swap ? ( v >> 8 ) | ( v << 8 ) : v;
+			}
+		}
+	}
+
+	free ( totals );
+	return OA_ERR_NONE;
+}
+
+
+static void
+_accumulate8 ( uint32_t* totals, const uint8_t* row, unsigned int count )
+{
+	unsigned int	i = 0;
+
+#if defined(__SSE2__)
+	const __m128i	zero = _mm_setzero_si128();
+	for ( ; i + 16 <= count; i += 16 ) {
+		__m128i v = _mm_loadu_si128 (( const __m128i* )( row + i ));
+		__m128i lo = _mm_unpacklo_epi8 ( v, zero );
+		__m128i hi = _mm_unpackhi_epi8 ( v, zero );
+		__m128i* a = ( __m128i* )( totals + i );
+		_mm_storeu_si128 ( a, _mm_add_epi32 ( _mm_loadu_si128 ( a ),
+				_mm_unpacklo_epi16 ( lo, zero )));
+		_mm_storeu_si128 ( a + 1, _mm_add_epi32 ( _mm_loadu_si128 ( a + 1 ),
+				_mm_unpackhi_epi16 ( lo, zero )));
+		_mm_storeu_si128 ( a + 2, _mm_add_epi32 ( _mm_loadu_si128 ( a + 2 ),
+				_mm_unpacklo_epi16 ( hi, zero )));
+		_mm_storeu_si128 ( a + 3, _mm_add_epi32 ( _mm_loadu_si128 ( a + 3 ),
+				_mm_unpackhi_epi16 ( hi, zero )));
+	}
+#elif defined(__ARM_NEON)
+	for ( ; i + 16 <= count; i += 16 ) {
+		uint8x16_t v = vld1q_u8 ( row + i );
+		uint16x8_t lo = vmovl_u8 ( vget_low_u8 ( v ));
+		uint16x8_t hi = vmovl_u8 ( vget_high_u8 ( v ));
+		uint32_t* a = totals + i;
+		vst1q_u32 ( a, vaddw_u16 ( vld1q_u32 ( a ), vget_low_u16 ( lo )));
+		vst1q_u32 ( a + 4, vaddw_u16 ( vld1q_u32 ( a + 4 ),
+				vget_high_u16 ( lo )));
+		vst1q_u32 ( a + 8, vaddw_u16 ( vld1q_u32 ( a + 8 ),
+				vget_low_u16 ( hi )));
+		vst1q_u32 ( a + 12, vaddw_u16 ( vld1q_u32 ( a + 12 ),
+				vget_high_u16 ( hi )));
+	}
+#endif
+	for ( ; i < count; i++ ) {
+		totals[i] += row[i];
+	}
+}
+
+
+static void
+_accumulate16 ( uint32_t* totals, const uint8_t* row, unsigned int count,
+		unsigned int swap )
+{
+	unsigned int	i = 0;
+	uint16_t			v;
+
+	if ( !swap ) {
+#if defined(__SSE2__)
+		const __m128i	zero = _mm_setzero_si128();
+		for ( ; i + 8 <= count; i += 8 ) {
+			__m128i s = _mm_loadu_si128 (( const __m128i* )( row + i * 2 ));
+			__m128i* a = ( __m128i* )( totals + i );
+			_mm_storeu_si128 ( a, _mm_add_epi32 ( _mm_loadu_si128 ( a ),
+					_mm_unpacklo_epi16 ( s, zero )));
+			_mm_storeu_si128 ( a + 1, _mm_add_epi32 ( _mm_loadu_si128 ( a + 1 ),
+					_mm_unpackhi_epi16 ( s, zero )));
+		}
+#elif defined(__ARM_NEON)
+		for ( ; i + 8 <= count; i += 8 ) {
+			uint16x8_t s = vld1q_u16 (( const uint16_t* )( row + i * 2 ));
+			uint32_t* a = totals + i;
+			vst1q_u32 ( a, vaddw_u16 ( vld1q_u32 ( a ), vget_low_u16 ( s )));
+			vst1q_u32 ( a + 4, vaddw_u16 ( vld1q_u32 ( a + 4 ),
+					vget_high_u16 ( s )));
+		}
+#endif
+	}
+	for ( ; i < count; i++ ) {
+		( void ) memcpy ( &v, row + i * 2, 2 );
+		if ( swap ) {
+			v = ( v >> 8 ) | ( v << 8 );
+		}
+		totals[i] += v;
+	}
+}
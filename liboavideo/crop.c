@@ -28,25 +28,70 @@
 #include <openastro/errno.h>
 #include <openastro/video.h>
 
+#include "threads.h"
+
+
+typedef struct {
+	uint8_t*			source;
+	uint8_t*			target;
+	unsigned int	origRowLength;
+	unsigned int	cropRowLength;
+} cropBands;
+
+static int	_cropBand ( void*, unsigned int, unsigned int );
+
+
 int
 oaInplaceCrop ( void* data, unsigned int xSize, unsigned int ySize,
 		unsigned int cropX, unsigned int cropY, int bpp )
 {
   uint8_t*			source;
-  uint8_t*			startOfRow;
   uint8_t*			target = ( uint8_t* ) data;
-  unsigned int	origRowLength, cropRowLength, i;
+  unsigned int	origRowLength, cropRowLength;
+  cropBands			bands;
 
   origRowLength = xSize * bpp;
   cropRowLength = cropX * bpp;
-  startOfRow = target + ( ySize - cropY ) / 2 * origRowLength +
+  source = target + ( ySize - cropY ) / 2 * origRowLength +
       ( xSize - cropX ) / 2 * bpp;
+
+  // If the cropped image ends before the first row of the crop area then
+  // no row overwrites another and the rows can be copied in any order,
+  // so the work can be shared between threads
+  if (( size_t ) cropRowLength * cropY <= ( size_t )( source - target )) {
+    bands.source = source;
+    bands.target = target;
+    bands.origRowLength = origRowLength;
+    bands.cropRowLength = cropRowLength;
+    return oaVideoRunBands ( cropY, ( unsigned long ) cropX * cropY, 1,
+        _cropBand, &bands );
+  }
+
   while ( cropY-- ) {
-    source = startOfRow;
-    for ( i = 0; i < cropRowLength; i++ ) {
-      *target++ = *source++;
-    }
-    startOfRow += origRowLength;
+    // rows can overlap when the crop is only slightly narrower than the
+    // original, so this has to be a memmove()
+    ( void ) memmove ( target, source, cropRowLength );
+    target += cropRowLength;
+    source += origRowLength;
+  }
+
+	return OA_ERR_NONE;
+}
+
+
+static int
+_cropBand ( void* arg, unsigned int start, unsigned int end )
+{
+  cropBands*		bands = arg;
+  uint8_t*			source;
+  uint8_t*			target;
+
+  source = bands->source + ( size_t ) start * bands->origRowLength;
+  target = bands->target + ( size_t ) start * bands->cropRowLength;
+  for ( ; start < end; start++ ) {
+    ( void ) memcpy ( target, source, bands->cropRowLength );
+    target += bands->cropRowLength;
+    source += bands->origRowLength;
   }
 
 	return OA_ERR_NONE;
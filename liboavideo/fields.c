@@ -0,0 +1,252 @@
+/*****************************************************************************
+ *
+ * fields.c -- merging of interlaced fields into frames
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <openastro/errno.h>
+#include <openastro/image.h>
+#include <openastro/video.h>
+#include <openastro/video/formats.h>
+#include <openastro/util.h>
+
+#include "threads.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define	HOST_LITTLE_ENDIAN	0
+#else
+#define	HOST_LITTLE_ENDIAN	1
+#endif
+
+typedef struct {
+	const oaImage*	fields[2];
+	oaImage*				target;
+	unsigned int		rowLength;
+	unsigned int		samples;
+	unsigned int		sampleSize;
+	unsigned int		swap;
+	int							mode;
+} fieldBands;
+
+static int	_mergeBand ( void*, unsigned int, unsigned int );
+static void	_sum8 ( uint8_t*, const uint8_t*, const uint8_t*, unsigned int );
+static void	_sum16 ( uint8_t*, const uint8_t*, const uint8_t*, unsigned int,
+								unsigned int );
+
+
+/*
+ * Combine the two fields of an interlaced frame into "target".  With
+ * OA_FIELDS_INTERLEAVE the rows of "first" become rows 0, 2, 4... of the
+ * target and those of "second" rows 1, 3, 5..., so "first" may have one
+ * row more than "second" and the target must be as tall as both together.
+ * With OA_FIELDS_SUM each target row is the saturated sum of the matching
+ * rows of the two fields, which is the 2x vertical bin of the interleaved
+ * frame, and all three images must be the same height.
+ *
+ * Both fields must have the same format and width as each other and as
+ * the target, which is given the format of the fields.  Each target row is
+ * written exactly once, straight from the field rows, so the merge is a
+ * single pass over the frame.  The target must not share any data with
+ * either field.
+ */
+
+int
+oaMergeFields ( const oaImage* first, const oaImage* second, oaImage* target,
+		int mode )
+{
+	frameFormatInfo*	fmt;
+	fieldBands				bands;
+	unsigned int			bpp, spp;
+
+	if ( mode != OA_FIELDS_INTERLEAVE && mode != OA_FIELDS_SUM ) {
+		return -OA_ERR_OUT_OF_RANGE;
+	}
+	if ( first->format != second->format ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: fields have formats %d and %d", __func__,
+				first->format, second->format );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+	if ( first->width != second->width || target->width != first->width ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: widths %u, %u and %u differ", __func__,
+				first->width, second->width, target->width );
+		return -OA_ERR_INVALID_SIZE;
+	}
+	if ( OA_FIELDS_INTERLEAVE == mode ) {
+		if (( first->height != second->height &&
+				first->height != second->height + 1 ) ||
+				target->height != first->height + second->height ) {
+			oaLogError ( OA_LOG_VIDEO, "%s: cannot interleave %u and %u rows into "
+					"%u", __func__, first->height, second->height, target->height );
+			return -OA_ERR_INVALID_SIZE;
+		}
+	} else {
+		if ( first->height != second->height ||
+				target->height != first->height ) {
+			oaLogError ( OA_LOG_VIDEO, "%s: cannot sum %u and %u rows into %u",
+					__func__, first->height, second->height, target->height );
+			return -OA_ERR_INVALID_SIZE;
+		}
+	}
+
+	fmt = &oaFrameFormats[ first->format ];
+	bpp = fmt->bytesPerPixel;
+	if ( fmt->planar || fmt->packed ||
+			!OA_WHOLE_BYTES_PER_PIXEL( first->format )) {
+		oaLogError ( OA_LOG_VIDEO, "%s: Unable to merge fields of format %d",
+				__func__, first->format );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	memset ( &bands, 0, sizeof ( fieldBands ));
+	bands.fields[0] = first;
+	bands.fields[1] = second;
+	bands.target = target;
+	bands.mode = mode;
+	bands.rowLength = oaImageRowLength ( first );
+
+	// Summing has to know what the samples are, interleaving just moves rows
+
+	if ( OA_FIELDS_SUM == mode ) {
+		spp = fmt->fullColour ? 3 : 1;
+		bands.sampleSize = bpp / spp;
+		if ( fmt->lumChrom || ( bands.sampleSize != 1 &&
+				bands.sampleSize != 2 ) || bands.sampleSize * spp != bpp ) {
+			oaLogError ( OA_LOG_VIDEO, "%s: Unable to sum fields of format %d",
+					__func__, first->format );
+			return -OA_ERR_UNSUPPORTED_FORMAT;
+		}
+		bands.samples = first->width * spp;
+		bands.swap = ( bands.sampleSize == 2 &&
+				fmt->littleEndian != HOST_LITTLE_ENDIAN ) ? 1 : 0;
+	}
+
+	target->format = first->format;
+	target->originX = first->originX;
+	target->originY = ( OA_FIELDS_INTERLEAVE == mode ) ? first->originY * 2 :
+			first->originY;
+
+	return oaVideoRunBands ( target->height, ( unsigned long ) target->width *
+			target->height, 1, _mergeBand, &bands );
+}
+
+
+static int
+_mergeBand ( void* arg, unsigned int start, unsigned int end )
+{
+	fieldBands*		bands = arg;
+	unsigned int	y;
+
+	if ( OA_FIELDS_INTERLEAVE == bands->mode ) {
+		for ( y = start; y < end; y++ ) {
+			( void ) memcpy ( oaImageRow ( bands->target, y ),
+					oaImageRow ( bands->fields[ y & 1 ], y / 2 ), bands->rowLength );
+		}
+		return OA_ERR_NONE;
+	}
+
+	for ( y = start; y < end; y++ ) {
+		if ( bands->sampleSize == 1 ) {
+			_sum8 ( oaImageRow ( bands->target, y ),
+					oaImageRow ( bands->fields[0], y ),
+					oaImageRow ( bands->fields[1], y ), bands->samples );
+		} else {
+			_sum16 ( oaImageRow ( bands->target, y ),
+					oaImageRow ( bands->fields[0], y ),
+					oaImageRow ( bands->fields[1], y ), bands->samples, bands->swap );
+		}
+	}
+	return OA_ERR_NONE;
+}
+
+
+static void
+_sum8 ( uint8_t* target, const uint8_t* a, const uint8_t* b,
+		unsigned int count )
+{
+	unsigned int	i = 0, s;
+
+#if defined(__SSE2__)
+	for ( ; i + 16 <= count; i += 16 ) {
+		_mm_storeu_si128 (( __m128i* )( target + i ), _mm_adds_epu8 (
+				_mm_loadu_si128 (( const __m128i* )( a + i )),
+				_mm_loadu_si128 (( const __m128i* )( b + i ))));
+	}
+#elif defined(__ARM_NEON)
+	for ( ; i + 16 <= count; i += 16 ) {
+		vst1q_u8 ( target + i, vqaddq_u8 ( vld1q_u8 ( a + i ),
+				vld1q_u8 ( b + i )));
+	}
+#endif
+	for ( ; i < count; i++ ) {
+		s = a[i] + b[i];
+		target[i] = ( s > 0xff ) ? 0xff : s;
+	}
+}
+
+
+static void
+_sum16 ( uint8_t* target, const uint8_t* a, const uint8_t* b,
+		unsigned int count, unsigned int swap )
+{
+	unsigned int	i = 0;
+	uint16_t			va, vb, v;
+	uint32_t			s;
+
+	if ( !swap ) {
+#if defined(__SSE2__)
+		for ( ; i + 8 <= count; i += 8 ) {
+			_mm_storeu_si128 (( __m128i* )( target + i * 2 ), _mm_adds_epu16 (
+					_mm_loadu_si128 (( const __m128i* )( a + i * 2 )),
+					_mm_loadu_si128 (( const __m128i* )( b + i * 2 ))));
+		}
+#elif defined(__ARM_NEON)
+		for ( ; i + 8 <= count; i += 8 ) {
+			vst1q_u16 (( uint16_t* )( target + i * 2 ), vqaddq_u16 (
+					vld1q_u16 (( const uint16_t* )( a + i * 2 )),
+					vld1q_u16 (( const uint16_t* )( b + i * 2 ))));
+		}
+#endif
+	}
+	for ( ; i < count; i++ ) {
+		( void ) memcpy ( &va, a + i * 2, 2 );
+		( void ) memcpy ( &vb, b + i * 2, 2 );
+		if ( swap ) {
+			va = ( va >> 8 ) | ( va << 8 );
+			vb = ( vb >> 8 ) | ( vb << 8 );
+		}
+		s = ( uint32_t ) va + vb;
+		v = ( s > 0xffff ) ? 0xffff : s;
+		if ( swap ) {
+			v = ( v >> 8 ) | ( v << 8 );
+		}
+		( void ) memcpy ( target + i * 2, &v, 2 );
+	}
+}
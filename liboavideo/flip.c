@@ -28,231 +28,141 @@
 #include <oa_common.h>
 
 #include <openastro/errno.h>
+#include <openastro/image.h>
 #include <openastro/video.h>
 #include <openastro/video/formats.h>
 #include <openastro/util.h>
 
+#include "rotate.h"
+#include "threads.h"
 
-static void		_processFlip8Bit ( uint8_t*, unsigned int, unsigned int, int );
-static void		_processFlip16Bit ( uint8_t*, unsigned int, unsigned int, int );
-static void		_processFlip24BitColour ( uint8_t*, unsigned int, unsigned int,
-		int );
 
+typedef struct {
+	oaImage*			image;
+	int						axis;
+	unsigned int	bpp;
+} flipBands;
+
+static int		_processFlipInPlace ( oaImage*, int );
+static int		_flipBand ( void*, unsigned int, unsigned int );
+
+
+/*
+ * Flip a tightly-packed image in place.  Raw colour frames are flipped
+ * as they stand, so the caller needs to be aware that the CFA pattern
+ * of the flipped frame may differ (oaFlipImageView() and oaFlipImageCopy()
+ * handle this).
+ */
 
 int
 oaFlipImage ( void* imageData, unsigned int xSize, unsigned int ySize,
 		int format, int axis )
 {
-  uint8_t* data = ( uint8_t* ) imageData;
-  int assumedFormat = format;
-
-  // fake up a format for mosaic frames here as properly flipping a
-  // mosaicked frame would be quite hairy
+	oaImage		image;
+	int				ret;
 
-  if ( oaFrameFormats[ format ].rawColour ) {
-    if ( oaFrameFormats[ format ].bitsPerPixel == 8 ) {
-      assumedFormat = OA_PIX_FMT_GREY8;
-    } else {
-      if ( oaFrameFormats[ format ].bitsPerPixel == 16 ) {
-        assumedFormat = OA_PIX_FMT_GREY16BE;
-      } else {
-        oaLogError ( OA_LOG_VIDEO,
-						"%s: No flipping idea how to handle format %d", __func__, format );
-				return OA_ERR_UNIMPLEMENTED;
-      }
-    }
-  }
-
-  switch ( assumedFormat ) {
-    case OA_PIX_FMT_GREY8:
-      _processFlip8Bit ( data, xSize, ySize, axis );
-      break;
-    case OA_PIX_FMT_GREY16BE:
-    case OA_PIX_FMT_GREY16LE:
-      _processFlip16Bit ( data, xSize, ySize, axis );
-      break;
-    case OA_PIX_FMT_RGB24:
-    case OA_PIX_FMT_BGR24:
-      _processFlip24BitColour ( data, xSize, ySize, axis );
-      break;
-    default:
-      oaLogError ( OA_LOG_VIDEO, "%s: Unable to flip format %d", __func__,
-					format );
-			return OA_ERR_UNIMPLEMENTED;
-      break;
-  }
-
-	return OA_ERR_NONE;
+	if (( ret = oaImageInit ( &image, imageData, xSize, ySize, format ))) {
+		return ret;
+	}
+	return _processFlipInPlace ( &image, axis );
 }
 
 
-static void
-_processFlip8Bit ( uint8_t* imageData, unsigned int xSize, unsigned int ySize,
-		int axis )
-{
-	unsigned int length = xSize * ySize;
+/*
+ * Flip an image described by an oaImage in place.  Padded rows and views
+ * into larger frames are handled, and for raw colour frames the format is
+ * updated to describe the CFA pattern of the flipped image.
+ */
 
-  if (( OA_FLIP_X | OA_FLIP_Y ) == axis ) {
-    uint8_t* p1 = imageData;
-    uint8_t* p2 = imageData + length - 1;
-    uint8_t s;
-    while ( p1 < p2 ) {
-      s = *p1;
-      *p1++ = *p2;
-      *p2-- = s;
-    }
-  } else {
-    if ( OA_FLIP_X == axis ) {
-      uint8_t* p1;
-      uint8_t* p2;
-      uint8_t s;
-      unsigned int y;
-      for ( y = 0; y < ySize; y++ ) {
-        p1 = imageData + y * xSize;
-        p2 = p1 + xSize - 1;
-        while ( p1 < p2 ) {
-          s = *p1;
-          *p1++ = *p2;
-          *p2-- = s;
-        }
-      }
-    }
-    if ( OA_FLIP_Y == axis ) {
-      uint8_t* p1;
-      uint8_t* p2;
-      uint8_t s;
-      unsigned int x, y;
-      p1 = imageData;
-      for ( y = ySize - 1; y >= ySize / 2; y-- ) {
-        p2 = imageData + y * xSize;
-        for ( x = 0; x < xSize; x++ ) {
-          s = *p1;
-          *p1++ = *p2;
-          *p2++ = s;
-        }
-      }
-    }
-  }
+int
+oaFlipImageView ( oaImage* image, int axis )
+{
+	int		ret, format;
+
+	if (( format = oaCFAFormatAtOffset ( image->format,
+			( axis & OA_FLIP_X ) ? image->width - 1 : 0,
+			( axis & OA_FLIP_Y ) ? image->height - 1 : 0 )) < 0 ) {
+		return format;
+	}
+
+	if (( ret = _processFlipInPlace ( image, axis )) == OA_ERR_NONE ) {
+		image->format = format;
+	}
+	return ret;
 }
 
 
-static void
-_processFlip16Bit ( uint8_t* imageData, unsigned int xSize, unsigned int ySize,
-		int axis )
-{
-	unsigned int length = xSize * ySize * 2;
+/*
+ * Rows are reversed into a temporary row and copied back, and the X and Y
+ * flips are done in the same pass over the image when both are wanted.
+ * For a Y flip the bands handed to each thread are pairs of rows to be
+ * swapped rather than rows of the image.
+ */
 
-  if (( OA_FLIP_X | OA_FLIP_Y ) == axis ) {
-    uint8_t* p1 = imageData;
-    uint8_t* p2 = imageData + length - 2;
-    uint8_t s;
-    while ( p1 < p2 ) {
-      s = *p1;
-      *p1++ = *p2;
-      *p2++ = s;
-      s = *p1;
-      *p1++ = *p2;
-      *p2 = s;
-      p2 -= 3;
-    }
-  } else {
-    if ( OA_FLIP_X == axis ) {
-      uint8_t* p1;
-      uint8_t* p2;
-      uint8_t s;
-      unsigned int y;
-      for ( y = 0; y < ySize; y++ ) {
-        p1 = imageData + y * xSize * 2;
-        p2 = p1 + ( xSize - 1 ) * 2;
-        while ( p1 < p2 ) {
-          s = *p1;
-          *p1++ = *p2;
-          *p2++ = s;
-          s = *p1;
-          *p1++ = *p2;
-          *p2 = s;
-          p2 -= 3;
-        }
-      }
-    }
-    if ( OA_FLIP_Y == axis ) {
-      uint8_t* p1;
-      uint8_t* p2;
-      uint8_t s;
-      unsigned int x, y;
-      p1 = imageData;
-      for ( y = ySize - 1; y > ySize / 2; y-- ) {
-        p2 = imageData + y * xSize * 2;
-        for ( x = 0; x < xSize * 2; x++ ) {
-          s = *p1;
-          *p1++ = *p2;
-          *p2++ = s;
-        }
-      }
-    }
-  }
+static int
+_processFlipInPlace ( oaImage* image, int axis )
+{
+	flipBands			bands;
+	unsigned int	bpp;
+
+	bpp = oaFrameFormats[ image->format ].bytesPerPixel;
+	if ( oaFrameFormats[ image->format ].planar ||
+			oaFrameFormats[ image->format ].packed ||
+			oaFrameFormats[ image->format ].lumChrom ||
+			!OA_WHOLE_BYTES_PER_PIXEL( image->format )) {
+		oaLogError ( OA_LOG_VIDEO, "%s: Unable to flip format %d", __func__,
+				image->format );
+		return -OA_ERR_UNIMPLEMENTED;
+	}
+	if ( !( axis & ( OA_FLIP_X | OA_FLIP_Y ))) {
+		return OA_ERR_NONE;
+	}
+
+	bands.image = image;
+	bands.axis = axis;
+	bands.bpp = bpp;
+	return oaVideoRunBands (( axis & OA_FLIP_Y ) ? ( image->height + 1 ) / 2 :
+			image->height, ( unsigned long ) image->width * image->height, 1,
+			_flipBand, &bands );
 }
 
 
-static void
-_processFlip24BitColour ( uint8_t* imageData, unsigned int xSize,
-		unsigned int ySize, int axis )
+static int
+_flipBand ( void* arg, unsigned int start, unsigned int end )
 {
-	unsigned int length = xSize * ySize * 3;
-
-  if (( OA_FLIP_X | OA_FLIP_Y ) == axis ) {
-    uint8_t* p1 = imageData;
-    uint8_t* p2 = imageData + length - 3;
-    uint8_t s;
-    while ( p1 < p2 ) {
-      s = *p1;
-      *p1++ = *p2;
-      *p2++ = s;
-      s = *p1;
-      *p1++ = *p2;
-      *p2++ = s;
-      s = *p1;
-      *p1++ = *p2;
-      *p2 = s;
-      p2 -= 5;
-    }
-  } else {
-    if ( OA_FLIP_X == axis ) {
-      uint8_t* p1;
-      uint8_t* p2;
-      uint8_t s;
-      unsigned int y;
-      for ( y = 0; y < ySize; y++ ) {
-        p1 = imageData + y * xSize * 3;
-        p2 = p1 + ( xSize - 1 ) * 3;
-        while ( p1 < p2 ) {
-          s = *p1;
-          *p1++ = *p2;
-          *p2++ = s;
-          s = *p1;
-          *p1++ = *p2;
-          *p2++ = s;
-          s = *p1;
-          *p1++ = *p2;
-          *p2 = s;
-          p2 -= 5;
-        }
-      }
-    }
-    if ( OA_FLIP_Y == axis ) {
-      uint8_t* p1;
-      uint8_t* p2;
-      uint8_t s;
-      unsigned int x, y;
-      p1 = imageData;
-      for ( y = ySize - 1; y > ySize / 2; y-- ) {
-        p2 = imageData + y * xSize * 3;
-        for ( x = 0; x < xSize * 3; x++ ) {
-          s = *p1;
-          *p1++ = *p2;
-          *p2++ = s;
-        }
-      }
-    }
-  }
+	flipBands*		bands = arg;
+	oaImage*			image = bands->image;
+	unsigned int	bpp = bands->bpp, rowLength, y;
+	uint8_t*			p1;
+	uint8_t*			p2;
+	uint8_t*			tmp;
+
+	rowLength = oaImageRowLength ( image );
+	if (!( tmp = malloc ( rowLength ))) {
+		return -OA_ERR_MEM_ALLOC;
+	}
+
+	for ( y = start; y < end; y++ ) {
+		p1 = oaImageRow ( image, y );
+		p2 = oaImageRow ( image, image->height - 1 - y );
+		if (!( bands->axis & OA_FLIP_Y ) || p1 == p2 ) {
+			// X flip only, or the middle row of an odd-height Y flip
+			if ( bands->axis & OA_FLIP_X ) {
+				oaReverseRow ( p1, tmp, image->width, bpp );
+				( void ) memcpy ( p1, tmp, rowLength );
+			}
+			continue;
+		}
+		if ( bands->axis & OA_FLIP_X ) {
+			oaReverseRow ( p1, tmp, image->width, bpp );
+			oaReverseRow ( p2, p1, image->width, bpp );
+		} else {
+			( void ) memcpy ( tmp, p1, rowLength );
+			( void ) memcpy ( p1, p2, rowLength );
+		}
+		( void ) memcpy ( p2, tmp, rowLength );
+	}
+
+	free (( void* ) tmp );
+	return OA_ERR_NONE;
 }
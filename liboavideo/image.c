@@ -0,0 +1,307 @@
+/*****************************************************************************
+ *
+ * image.c -- image descriptor and zero-copy view handling
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <openastro/errno.h>
+#include <openastro/image.h>
+#include <openastro/demosaic.h>
+#include <openastro/video.h>
+#include <openastro/video/formats.h>
+#include <openastro/util.h>
+
+
+static int		_canViewFormat ( int, unsigned int, unsigned int );
+static int		_cfaPatternAtOffset ( int, unsigned int, unsigned int );
+
+
+int
+oaImageInit ( oaImage* image, void* data, unsigned int xSize,
+		unsigned int ySize, int format )
+{
+	unsigned int	rowLength;
+
+	if ( format <= 0 || format >= OA_PIX_FMT_LAST_P1 ) {
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+	rowLength = xSize * oaFrameFormats[ format ].bytesPerPixel;
+	return oaImageInitStrided ( image, data, xSize, ySize, rowLength, format );
+}
+
+
+int
+oaImageInitStrided ( oaImage* image, void* data, unsigned int xSize,
+		unsigned int ySize, unsigned int stride, int format )
+{
+	if ( format <= 0 || format >= OA_PIX_FMT_LAST_P1 ) {
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	image->data = data;
+	image->width = xSize;
+	image->height = ySize;
+	image->stride = stride;
+	image->format = format;
+	image->originX = image->originY = 0;
+
+	if ( stride < oaImageRowLength ( image )) {
+		oaLogError ( OA_LOG_VIDEO, "%s: stride %u too short for %u pixels",
+				__func__, stride, xSize );
+		return -OA_ERR_INVALID_SIZE;
+	}
+	if ( stride != oaImageRowLength ( image ) &&
+			oaFrameFormats[ format ].planar ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: planar format %d cannot be strided",
+				__func__, format );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	return OA_ERR_NONE;
+}
+
+
+unsigned int
+oaImageRowLength ( const oaImage* image )
+{
+	return image->width * oaFrameFormats[ image->format ].bytesPerPixel;
+}
+
+
+int
+oaImageIsPacked ( const oaImage* image )
+{
+	return ( image->stride == oaImageRowLength ( image )) ? 1 : 0;
+}
+
+
+/*
+ * Create a view of a rectangle within an existing image without copying
+ * any data.  If the view starts on an odd row or column of a raw colour
+ * frame then the format of the view is changed to reflect the CFA pattern
+ * seen from its top left corner.
+ */
+
+int
+oaImageSubView ( const oaImage* parent, oaImage* view, unsigned int x,
+		unsigned int y, unsigned int xSize, unsigned int ySize )
+{
+	int						format;
+	unsigned int	offset;
+
+	if ( x + xSize > parent->width || y + ySize > parent->height ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: view %ux%u@%u,%u outside %ux%u image",
+				__func__, xSize, ySize, x, y, parent->width, parent->height );
+		return -OA_ERR_INVALID_SIZE;
+	}
+	if ( !_canViewFormat ( parent->format, x, xSize )) {
+		oaLogError ( OA_LOG_VIDEO, "%s: can't create view of format %d at %u",
+				__func__, parent->format, x );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+	if (( format = oaCFAFormatAtOffset ( parent->format, x, y )) < 0 ) {
+		return format;
+	}
+
+	offset = x * oaFrameFormats[ parent->format ].bytesPerPixel;
+	view->data = oaImageRow ( parent, y ) + offset;
+	view->width = xSize;
+	view->height = ySize;
+	view->stride = parent->stride;
+	view->format = format;
+	view->originX = parent->originX + x;
+	view->originY = parent->originY + y;
+
+	return OA_ERR_NONE;
+}
+
+
+/*
+ * Create a view of the centre of an image, as oaInplaceCrop() would, but
+ * without moving any of the data
+ */
+
+int
+oaImageCentredView ( const oaImage* parent, oaImage* view,
+		unsigned int xSize, unsigned int ySize )
+{
+	if ( xSize > parent->width || ySize > parent->height ) {
+		return -OA_ERR_INVALID_SIZE;
+	}
+	return oaImageSubView ( parent, view, ( parent->width - xSize ) / 2,
+			( parent->height - ySize ) / 2, xSize, ySize );
+}
+
+
+/*
+ * Copy the pixels from one image to another, which must already have the
+ * same dimensions.  The rows are moved with memmove() so that an image
+ * may be packed down on top of itself, as when cropping in place.  The
+ * target format is set to that of the source.
+ */
+
+int
+oaImageCopy ( const oaImage* source, oaImage* target )
+{
+	unsigned int	rowLength, y;
+
+	if ( source->width != target->width || source->height != target->height ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: image sizes differ", __func__ );
+		return -OA_ERR_INVALID_SIZE;
+	}
+
+	target->format = source->format;
+	rowLength = oaImageRowLength ( source );
+	if ( source->stride == rowLength && target->stride == rowLength ) {
+		if ( source->data != target->data ) {
+			( void ) memmove ( target->data, source->data,
+					( size_t ) rowLength * source->height );
+		}
+		return OA_ERR_NONE;
+	}
+
+	for ( y = 0; y < source->height; y++ ) {
+		( void ) memmove ( oaImageRow ( target, y ), oaImageRow ( source, y ),
+				rowLength );
+	}
+	return OA_ERR_NONE;
+}
+
+
+/*
+ * Return the frame format that has the same bit depth and layout as
+ * "format", but with the CFA pattern that would be seen starting from
+ * position ( x, y ) in a frame of the given format
+ */
+
+int
+oaCFAFormatAtOffset ( int format, unsigned int x, unsigned int y )
+{
+	int		pattern;
+
+	if ( !oaFrameFormats[ format ].rawColour || !(( x | y ) & 1 )) {
+		return format;
+	}
+
+	if (( pattern = _cfaPatternAtOffset ( oaFrameFormats[ format ].cfaPattern,
+			x, y )) < 0 ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: can't shift CFA pattern of format %d",
+				__func__, format );
+		return pattern;
+	}
+
+	return oaCFAFormatForPattern ( format, pattern );
+}
+
+
+/*
+ * Return the raw colour frame format with the same bit depth and layout
+ * as "format", but with the given CFA pattern
+ */
+
+int
+oaCFAFormatForPattern ( int format, int pattern )
+{
+	int		i;
+
+	for ( i = 1; i < OA_PIX_FMT_LAST_P1; i++ ) {
+		if ( oaFrameFormats[i].rawColour &&
+				oaFrameFormats[i].cfaPattern == ( unsigned int ) pattern &&
+				oaFrameFormats[i].bitsPerPixel ==
+				oaFrameFormats[ format ].bitsPerPixel &&
+				oaFrameFormats[i].bytesPerPixel ==
+				oaFrameFormats[ format ].bytesPerPixel &&
+				oaFrameFormats[i].littleEndian ==
+				oaFrameFormats[ format ].littleEndian &&
+				oaFrameFormats[i].packed == oaFrameFormats[ format ].packed ) {
+			return i;
+		}
+	}
+
+	return -OA_ERR_UNSUPPORTED_FORMAT;
+}
+
+
+static int
+_cfaPatternAtOffset ( int pattern, unsigned int x, unsigned int y )
+{
+	if ( x & 1 ) {
+		switch ( pattern ) {
+			case OA_DEMOSAIC_RGGB:
+				pattern = OA_DEMOSAIC_GRBG;
+				break;
+			case OA_DEMOSAIC_GRBG:
+				pattern = OA_DEMOSAIC_RGGB;
+				break;
+			case OA_DEMOSAIC_BGGR:
+				pattern = OA_DEMOSAIC_GBRG;
+				break;
+			case OA_DEMOSAIC_GBRG:
+				pattern = OA_DEMOSAIC_BGGR;
+				break;
+			default:
+				return -OA_ERR_UNSUPPORTED_FORMAT;
+		}
+	}
+	if ( y & 1 ) {
+		switch ( pattern ) {
+			case OA_DEMOSAIC_RGGB:
+				pattern = OA_DEMOSAIC_GBRG;
+				break;
+			case OA_DEMOSAIC_GBRG:
+				pattern = OA_DEMOSAIC_RGGB;
+				break;
+			case OA_DEMOSAIC_BGGR:
+				pattern = OA_DEMOSAIC_GRBG;
+				break;
+			case OA_DEMOSAIC_GRBG:
+				pattern = OA_DEMOSAIC_BGGR;
+				break;
+			default:
+				return -OA_ERR_UNSUPPORTED_FORMAT;
+		}
+	}
+	return pattern;
+}
+
+
+static int
+_canViewFormat ( int format, unsigned int x, unsigned int xSize )
+{
+	float		bpp = oaFrameFormats[ format ].bytesPerPixel;
+
+	if ( oaFrameFormats[ format ].planar || bpp != ( unsigned int ) bpp ) {
+		return 0;
+	}
+
+	// Packed YUV formats share chroma between pairs of pixels, so the
+	// view must start and end on a pixel pair
+
+	if ( oaFrameFormats[ format ].lumChrom ) {
+		return (( x | xSize ) & 1 ) ? 0 : 1;
+	}
+
+	return oaFrameFormats[ format ].packed ? 0 : 1;
+}
@@ -27,6 +27,8 @@
 
 #include <oa_common.h>
 
+#include <openastro/errno.h>
+#include <openastro/image.h>
 #include <openastro/video.h>
 #include <openastro/video/formats.h>
 #include <openastro/util.h>
@@ -35,11 +37,73 @@
 #include "to8Bit.h"
 #include "unpack.h"
 #include "alpha.h"
+#include "threads.h"
 
 
+typedef struct {
+  uint8_t*			source;
+  uint8_t*			target;
+  unsigned int	sourceRowLength;
+  unsigned int	targetRowLength;
+  int						xSize;
+  int						sourceFormat;
+  int						targetFormat;
+} convertBands;
+
+static int	_convertFrame ( void*, void*, int, int, int, int );
+static int	_convertBand ( void*, unsigned int, unsigned int );
+static int	_convertImageBand ( void*, unsigned int, unsigned int );
+
+
+/*
+ * Large frames in formats where each row is held separately from the
+ * others are converted in bands of rows across the thread pool
+ */
+
 int
 oaconvert ( void* source, void* target, int xSize, int ySize, int sourceFormat,
     int targetFormat )
+{
+  convertBands	bands;
+  float					sourceRowLength, targetRowLength;
+
+  sourceRowLength = xSize * oaFrameFormats[ sourceFormat ].bytesPerPixel;
+  targetRowLength = xSize * oaFrameFormats[ targetFormat ].bytesPerPixel;
+  if ( ySize < 2 || oaFrameFormats[ sourceFormat ].planar ||
+      oaFrameFormats[ targetFormat ].planar ||
+      sourceRowLength != ( unsigned int ) sourceRowLength ||
+      targetRowLength != ( unsigned int ) targetRowLength ) {
+    return _convertFrame ( source, target, xSize, ySize, sourceFormat,
+        targetFormat );
+  }
+
+  bands.source = source;
+  bands.target = target;
+  bands.sourceRowLength = sourceRowLength;
+  bands.targetRowLength = targetRowLength;
+  bands.xSize = xSize;
+  bands.sourceFormat = sourceFormat;
+  bands.targetFormat = targetFormat;
+  return oaVideoRunBands ( ySize, ( unsigned long ) xSize * ySize, 2,
+      _convertBand, &bands );
+}
+
+
+static int
+_convertBand ( void* arg, unsigned int start, unsigned int end )
+{
+  convertBands*	bands = arg;
+
+  return _convertFrame ( bands->source + ( size_t ) start *
+      bands->sourceRowLength, bands->target + ( size_t ) start *
+      bands->targetRowLength, bands->xSize,
+      end - start, bands->sourceFormat, bands->targetFormat );
+}
+
+
+static int
+_convertFrame ( void* source, void* target, int xSize, int ySize,
+    int sourceFormat, int targetFormat )
 {
   int		result = -1;
   unsigned int	length;
@@ -377,3 +441,62 @@ oaconvert ( void* source, void* target, int xSize, int ySize, int sourceFormat,
 
   return result;
 }
+
+
+/*
+ * Convert between image descriptors.  If either image has padded rows the
+ * conversion is done a row at a time, which only works for formats where
+ * each row can be converted independently of the others.
+ */
+
+int
+oaconvertImage ( const oaImage* source, oaImage* target )
+{
+  oaImage*			images[2];
+
+  if ( source->width != target->width || source->height != target->height ) {
+    oaLogError ( OA_LOG_VIDEO, "%s: image sizes differ", __func__ );
+    return -OA_ERR_INVALID_SIZE;
+  }
+
+  if ( oaImageIsPacked ( source ) && oaImageIsPacked ( target )) {
+    return oaconvert ( source->data, target->data, source->width,
+        source->height, source->format, target->format );
+  }
+
+  if ( oaFrameFormats[ source->format ].planar ||
+      oaFrameFormats[ target->format ].planar ||
+      oaFrameFormats[ source->format ].bytesPerPixel !=
+      ( unsigned int ) oaFrameFormats[ source->format ].bytesPerPixel ||
+      oaFrameFormats[ target->format ].bytesPerPixel !=
+      ( unsigned int ) oaFrameFormats[ target->format ].bytesPerPixel ) {
+    oaLogError ( OA_LOG_VIDEO, "%s: can't convert format %d row by row",
+        __func__, source->format );
+    return -OA_ERR_UNSUPPORTED_FORMAT;
+  }
+
+  images[0] = ( oaImage* ) source;
+  images[1] = target;
+  return oaVideoRunBands ( source->height,
+      ( unsigned long ) source->width * source->height, 2, _convertImageBand,
+      images );
+}
+
+
+static int
+_convertImageBand ( void* arg, unsigned int start, unsigned int end )
+{
+  oaImage**			images = arg;
+  unsigned int	y;
+  int						result;
+
+  for ( y = start; y < end; y++ ) {
+    if (( result = _convertFrame ( oaImageRow ( images[0], y ),
+        oaImageRow ( images[1], y ), images[0]->width, 1, images[0]->format,
+        images[1]->format )) < 0 ) {
+      return result;
+    }
+  }
+
+  return OA_ERR_NONE;
+}
@@ -0,0 +1,377 @@
+/*****************************************************************************
+ *
+ * rotate.c -- out-of-place flip, rotate and transpose
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <openastro/demosaic.h>
+#include <openastro/errno.h>
+#include <openastro/image.h>
+#include <openastro/video.h>
+#include <openastro/video/formats.h>
+#include <openastro/util.h>
+
+#include "rotate.h"
+#include "threads.h"
+
+// Transposing walks the source image a column at a time, so it's done in
+// square tiles small enough that the tile's source rows stay in L1 cache
+
+#define	TILE_SIZE		32
+
+typedef struct {
+	const oaImage*	source;
+	oaImage*				target;
+	int							transform;
+	unsigned int		bpp;
+} rotateBands;
+
+static void	_reverse8 ( const uint8_t*, uint8_t*, unsigned int );
+static void	_reverse16 ( const uint8_t*, uint8_t*, unsigned int );
+static void	_reverse32 ( const uint8_t*, uint8_t*, unsigned int );
+static int	_transposedFormat ( int );
+static int	_flipCopyBand ( void*, unsigned int, unsigned int );
+static int	_transposeBand ( void*, unsigned int, unsigned int );
+
+
+/*
+ * Copy an image from source to target, flipping it in X and/or Y and
+ * optionally transposing it at the same time, so frames that need
+ * flipping don't have to be copied first and then flipped in place.
+ * Rotations are given as combinations of transpose and flip (see
+ * OA_ROTATE_* in video.h).  The target must already have the right
+ * dimensions and its format is set to that of the source, adjusted for
+ * the change in CFA pattern for raw colour frames.
+ */
+
+int
+oaFlipImageCopy ( const oaImage* source, oaImage* target, int transform )
+{
+	rotateBands		bands;
+	unsigned int	bpp, targetWidth, targetHeight;
+	int						format;
+
+	bpp = oaFrameFormats[ source->format ].bytesPerPixel;
+	if ( oaFrameFormats[ source->format ].planar ||
+			oaFrameFormats[ source->format ].packed ||
+			oaFrameFormats[ source->format ].lumChrom ||
+			bpp != oaFrameFormats[ source->format ].bytesPerPixel || bpp > 8 ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: Unable to flip format %d", __func__,
+				source->format );
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	format = source->format;
+	targetWidth = source->width;
+	targetHeight = source->height;
+	if ( transform & OA_FLIP_TRANSPOSE ) {
+		if (( format = _transposedFormat ( format )) < 0 ) {
+			return format;
+		}
+		targetWidth = source->height;
+		targetHeight = source->width;
+	}
+	if ( target->width != targetWidth || target->height != targetHeight ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: target is %ux%u, need %ux%u", __func__,
+				target->width, target->height, targetWidth, targetHeight );
+		return -OA_ERR_INVALID_SIZE;
+	}
+	if (( format = oaCFAFormatAtOffset ( format,
+			( transform & OA_FLIP_X ) ? targetWidth - 1 : 0,
+			( transform & OA_FLIP_Y ) ? targetHeight - 1 : 0 )) < 0 ) {
+		return format;
+	}
+	target->format = format;
+
+	bands.source = source;
+	bands.target = target;
+	bands.transform = transform;
+	bands.bpp = bpp;
+
+	// Transposed bands are whole rows of tiles so that no tile is split
+	// between threads
+
+	if ( transform & OA_FLIP_TRANSPOSE ) {
+		return oaVideoRunBands ( targetHeight,
+				( unsigned long ) targetWidth * targetHeight, TILE_SIZE,
+				_transposeBand, &bands );
+	}
+	return oaVideoRunBands ( targetHeight,
+			( unsigned long ) targetWidth * targetHeight, 1, _flipCopyBand,
+			&bands );
+}
+
+
+static int
+_flipCopyBand ( void* arg, unsigned int start, unsigned int end )
+{
+	rotateBands*		bands = arg;
+	const oaImage*	source = bands->source;
+	unsigned int		rowLength, y;
+
+	rowLength = oaImageRowLength ( source );
+	for ( y = start; y < end; y++ ) {
+		const uint8_t* s = oaImageRow ( source, ( bands->transform & OA_FLIP_Y ) ?
+				source->height - 1 - y : y );
+		uint8_t* t = oaImageRow ( bands->target, y );
+		if ( bands->transform & OA_FLIP_X ) {
+			oaReverseRow ( s, t, source->width, bands->bpp );
+		} else {
+			( void ) memcpy ( t, s, rowLength );
+		}
+	}
+
+	return OA_ERR_NONE;
+}
+
+
+/*
+ * Copy a row of "width" pixels of "bpp" bytes each from source to
+ * target, reversing the order of the pixels
+ */
+
+void
+oaReverseRow ( const uint8_t* source, uint8_t* target, unsigned int width,
+		unsigned int bpp )
+{
+	const uint8_t*	s;
+	unsigned int		i;
+
+	switch ( bpp ) {
+		case 1:
+			_reverse8 ( source, target, width );
+			return;
+		case 2:
+			_reverse16 ( source, target, width );
+			return;
+		case 4:
+			_reverse32 ( source, target, width );
+			return;
+	}
+
+	// 24- and 48-bit pixels don't map neatly onto vector registers, but
+	// a fixed-size memcpy() per pixel is still cheap
+
+	s = source + ( width - 1 ) * bpp;
+	if ( bpp == 3 ) {
+		for ( i = 0; i < width; i++, s -= 3, target += 3 ) {
+			( void ) memcpy ( target, s, 3 );
+		}
+		return;
+	}
+	if ( bpp == 6 ) {
+		for ( i = 0; i < width; i++, s -= 6, target += 6 ) {
+			( void ) memcpy ( target, s, 6 );
+		}
+		return;
+	}
+	for ( i = 0; i < width; i++, s -= bpp, target += bpp ) {
+		( void ) memcpy ( target, s, bpp );
+	}
+}
+
+
+static void
+_reverse8 ( const uint8_t* source, uint8_t* target, unsigned int width )
+{
+	const uint8_t*	s = source + width;
+	unsigned int		i = 0;
+
+#if defined(__SSE2__)
+	for ( ; i + 16 <= width; i += 16 ) {
+		__m128i v;
+		s -= 16;
+		v = _mm_loadu_si128 (( const __m128i* ) s );
+		v = _mm_or_si128 ( _mm_slli_epi16 ( v, 8 ), _mm_srli_epi16 ( v, 8 ));
+		v = _mm_shufflelo_epi16 ( v, _MM_SHUFFLE ( 0, 1, 2, 3 ));
+		v = _mm_shufflehi_epi16 ( v, _MM_SHUFFLE ( 0, 1, 2, 3 ));
+		v = _mm_shuffle_epi32 ( v, _MM_SHUFFLE ( 1, 0, 3, 2 ));
+		_mm_storeu_si128 (( __m128i* )( target + i ), v );
+	}
+#elif defined(__ARM_NEON)
+	for ( ; i + 16 <= width; i += 16 ) {
+		uint8x16_t v;
+		s -= 16;
+		v = vrev64q_u8 ( vld1q_u8 ( s ));
+		vst1q_u8 ( target + i, vextq_u8 ( v, v, 8 ));
+	}
+#endif
+	for ( ; i < width; i++ ) {
+		target[i] = *--s;
+	}
+}
+
+
+static void
+_reverse16 ( const uint8_t* source, uint8_t* target, unsigned int width )
+{
+	const uint8_t*	s = source + width * 2;
+	unsigned int		i = 0;
+
+#if defined(__SSE2__)
+	for ( ; i + 8 <= width; i += 8 ) {
+		__m128i v;
+		s -= 16;
+		v = _mm_loadu_si128 (( const __m128i* ) s );
+		v = _mm_shufflelo_epi16 ( v, _MM_SHUFFLE ( 0, 1, 2, 3 ));
+		v = _mm_shufflehi_epi16 ( v, _MM_SHUFFLE ( 0, 1, 2, 3 ));
+		v = _mm_shuffle_epi32 ( v, _MM_SHUFFLE ( 1, 0, 3, 2 ));
+		_mm_storeu_si128 (( __m128i* )( target + i * 2 ), v );
+	}
+#elif defined(__ARM_NEON)
+	for ( ; i + 8 <= width; i += 8 ) {
+		uint16x8_t v;
+		s -= 16;
+		v = vrev64q_u16 ( vld1q_u16 (( const uint16_t* ) s ));
+		vst1q_u16 (( uint16_t* )( target + i * 2 ), vextq_u16 ( v, v, 4 ));
+	}
+#endif
+	for ( ; i < width; i++ ) {
+		s -= 2;
+		( void ) memcpy ( target + i * 2, s, 2 );
+	}
+}
+
+
+static void
+_reverse32 ( const uint8_t* source, uint8_t* target, unsigned int width )
+{
+	const uint8_t*	s = source + width * 4;
+	unsigned int		i = 0;
+
+#if defined(__SSE2__)
+	for ( ; i + 4 <= width; i += 4 ) {
+		__m128i v;
+		s -= 16;
+		v = _mm_loadu_si128 (( const __m128i* ) s );
+		v = _mm_shuffle_epi32 ( v, _MM_SHUFFLE ( 0, 1, 2, 3 ));
+		_mm_storeu_si128 (( __m128i* )( target + i * 4 ), v );
+	}
+#elif defined(__ARM_NEON)
+	for ( ; i + 4 <= width; i += 4 ) {
+		uint32x4_t v;
+		s -= 16;
+		v = vrev64q_u32 ( vld1q_u32 (( const uint32_t* ) s ));
+		vst1q_u32 (( uint32_t* )( target + i * 4 ), vextq_u32 ( v, v, 2 ));
+	}
+#endif
+	for ( ; i < width; i++ ) {
+		s -= 4;
+		( void ) memcpy ( target + i * 4, s, 4 );
+	}
+}
+
+
+/*
+ * Transpose rows start to end - 1 of the target from the source, then
+ * flip the result as requested.  The target pixel at ( x, y ) comes from
+ * source pixel ( y, x ) before the flips are taken into account.
+ */
+
+#define	TRANSPOSE_TILE(type) \
+	for ( ty = start; ty < end; ty += TILE_SIZE ) { \
+		yEnd = ( ty + TILE_SIZE < end ) ? ty + TILE_SIZE : end; \
+		for ( tx = 0; tx < target->width; tx += TILE_SIZE ) { \
+			xEnd = ( tx + TILE_SIZE < target->width ) ? tx + TILE_SIZE : \
+					target->width; \
+			for ( y = ty; y < yEnd; y++ ) { \
+				type* t = ( type* ) oaImageRow ( target, y ) + tx; \
+				sx = flipY ? source->width - 1 - y : y; \
+				for ( x = tx; x < xEnd; x++ ) { \
+					sy = flipX ? source->height - 1 - x : x; \
+					*t++ = *(( const type* ) oaImageRow ( source, sy ) + sx ); \
+				} \
+			} \
+		} \
+	}
+
+static int
+_transposeBand ( void* arg, unsigned int start, unsigned int end )
+{
+	rotateBands*		bands = arg;
+	const oaImage*	source = bands->source;
+	oaImage*				target = bands->target;
+	unsigned int		bpp = bands->bpp, tx, ty, x, y, xEnd, yEnd, sx, sy;
+	int							flipX = ( bands->transform & OA_FLIP_X ) ? 1 : 0;
+	int							flipY = ( bands->transform & OA_FLIP_Y ) ? 1 : 0;
+
+	switch ( bpp ) {
+		case 1:
+			TRANSPOSE_TILE ( uint8_t );
+			return OA_ERR_NONE;
+		case 2:
+			TRANSPOSE_TILE ( uint16_t );
+			return OA_ERR_NONE;
+		case 4:
+			TRANSPOSE_TILE ( uint32_t );
+			return OA_ERR_NONE;
+	}
+
+	for ( ty = start; ty < end; ty += TILE_SIZE ) {
+		yEnd = ( ty + TILE_SIZE < end ) ? ty + TILE_SIZE : end;
+		for ( tx = 0; tx < target->width; tx += TILE_SIZE ) {
+			xEnd = ( tx + TILE_SIZE < target->width ) ? tx + TILE_SIZE :
+					target->width;
+			for ( y = ty; y < yEnd; y++ ) {
+				uint8_t* t = oaImageRow ( target, y ) + tx * bpp;
+				sx = flipY ? source->width - 1 - y : y;
+				for ( x = tx; x < xEnd; x++, t += bpp ) {
+					sy = flipX ? source->height - 1 - x : x;
+					( void ) memcpy ( t, oaImageRow ( source, sy ) + sx * bpp, bpp );
+				}
+			}
+		}
+	}
+	return OA_ERR_NONE;
+}
+
+
+// Transposing a 2x2 CFA cell swaps the two off-diagonal colours
+
+static int
+_transposedFormat ( int format )
+{
+	if ( !oaFrameFormats[ format ].rawColour ) {
+		return format;
+	}
+	switch ( oaFrameFormats[ format ].cfaPattern ) {
+		case OA_DEMOSAIC_RGGB:
+		case OA_DEMOSAIC_BGGR:
+			return format;
+		case OA_DEMOSAIC_GRBG:
+			return oaCFAFormatForPattern ( format, OA_DEMOSAIC_GBRG );
+		case OA_DEMOSAIC_GBRG:
+			return oaCFAFormatForPattern ( format, OA_DEMOSAIC_GRBG );
+	}
+	oaLogError ( OA_LOG_VIDEO, "%s: can't transpose CFA pattern of format %d",
+			__func__, format );
+	return -OA_ERR_UNSUPPORTED_FORMAT;
+}
@@ -0,0 +1,33 @@
+/*****************************************************************************
+ *
+ * rotate.h -- flip/rotate kernel declarations
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#ifndef OPENASTRO_VIDEO_ROTATE_H
+#define OPENASTRO_VIDEO_ROTATE_H
+
+extern void	oaReverseRow ( const uint8_t*, uint8_t*, unsigned int,
+								unsigned int );
+
+#endif	/* OPENASTRO_VIDEO_ROTATE_H */
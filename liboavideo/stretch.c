@@ -0,0 +1,457 @@
+/*****************************************************************************
+ *
+ * stretch.c -- histogram-driven 16-bit to 8-bit stretch
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <math.h>
+
+#include <openastro/demosaic.h>
+#include <openastro/errno.h>
+#include <openastro/video.h>
+#include <openastro/video/formats.h>
+#include <openastro/video/stretch.h>
+#include <openastro/util.h>
+
+#include "threads.h"
+
+
+// The statistics for the auto stretch come from every fifth sample of
+// every third row.  Both steps are odd so all the colours of a CFA
+// pattern or RGB pixel get sampled.
+
+#define	ROW_SAMPLE_STEP		3
+#define	SAMPLE_STEP				5
+
+#define	MAD_TO_SIGMA			1.4826
+
+// Auto-stretch statistics have to move by more than this before the LUT
+// is worth rebuilding
+
+#define	STATS_TOLERANCE(m)	(( m ) / 1024 + 1 )
+
+typedef struct {
+	const uint8_t*	source;
+	uint8_t*				target;
+	const uint8_t*	lut;
+	unsigned int		rowSamples;
+	int							littleEndian;
+} stretchBands;
+
+static void	_frameStatistics ( oaStretch*, const uint8_t*, unsigned int,
+								unsigned int, int, unsigned int*, unsigned int* );
+static void	_buildLUT ( oaStretch* );
+static int	_stretchBand ( void*, unsigned int, unsigned int );
+static double	_midtonesTransfer ( double, double );
+
+
+void
+oaStretchDefaultParams ( oaStretchParams* params )
+{
+	params->mode = OA_STRETCH_LINEAR;
+	params->blackPoint = 0.0;
+	params->whitePoint = 1.0;
+	params->asinhStretch = 10.0;
+	params->autoBackground = 0.25;
+	params->autoShadowClip = -2.8;
+}
+
+
+oaStretch*
+oaStretchCreate ( const oaStretchParams* params )
+{
+	oaStretch*	stretch;
+
+	if (!( stretch = calloc ( 1, sizeof ( oaStretch )))) {
+		return 0;
+	}
+	if (!( stretch->histogram = malloc ( 65536 * sizeof ( uint32_t )))) {
+		free (( void* ) stretch );
+		return 0;
+	}
+	if ( params ) {
+		stretch->params = *params;
+	} else {
+		oaStretchDefaultParams ( &stretch->params );
+	}
+	return stretch;
+}
+
+
+void
+oaStretchDestroy ( oaStretch* stretch )
+{
+	if ( stretch ) {
+		free (( void* ) stretch->histogram );
+		free (( void* ) stretch );
+	}
+}
+
+
+void
+oaStretchSetParams ( oaStretch* stretch, const oaStretchParams* params )
+{
+	if ( memcmp ( &stretch->params, params, sizeof ( oaStretchParams ))) {
+		stretch->params = *params;
+		stretch->lutValid = 0;
+	}
+}
+
+
+/*
+ * Supply the median and MAD of the next frame to be stretched (from
+ * oaFrameStatsCompute(), say) so the auto stretch doesn't have to
+ * compute them itself
+ */
+
+void
+oaStretchSetStatistics ( oaStretch* stretch, unsigned int median,
+		unsigned int mad )
+{
+	stretch->suppliedMedian = median;
+	stretch->suppliedMAD = mad;
+	stretch->haveStatistics = 1;
+}
+
+
+/*
+ * Return the 8-bit format that a 16-bit (per channel) format stretches to
+ */
+
+int
+oaStretchOutputFormat ( int format )
+{
+	if ( oaFrameFormats[ format ].packed ||
+			oaFrameFormats[ format ].bytesPerPixel !=
+			( oaFrameFormats[ format ].fullColour ? 6 : 2 )) {
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	if ( oaFrameFormats[ format ].monochrome ) {
+		return OA_PIX_FMT_GREY8;
+	}
+
+	if ( oaFrameFormats[ format ].rawColour ) {
+		switch ( oaFrameFormats[ format ].cfaPattern ) {
+			case OA_DEMOSAIC_RGGB:
+				return OA_PIX_FMT_RGGB8;
+			case OA_DEMOSAIC_BGGR:
+				return OA_PIX_FMT_BGGR8;
+			case OA_DEMOSAIC_GRBG:
+				return OA_PIX_FMT_GRBG8;
+			case OA_DEMOSAIC_GBRG:
+				return OA_PIX_FMT_GBRG8;
+			case OA_DEMOSAIC_CMYG:
+				return OA_PIX_FMT_CMYG8;
+			case OA_DEMOSAIC_MCGY:
+				return OA_PIX_FMT_MCGY8;
+			case OA_DEMOSAIC_YGCM:
+				return OA_PIX_FMT_YGCM8;
+			case OA_DEMOSAIC_GYMC:
+				return OA_PIX_FMT_GYMC8;
+		}
+		return -OA_ERR_UNSUPPORTED_FORMAT;
+	}
+
+	switch ( format ) {
+		case OA_PIX_FMT_RGB30BE:
+		case OA_PIX_FMT_RGB30LE:
+		case OA_PIX_FMT_RGB36BE:
+		case OA_PIX_FMT_RGB36LE:
+		case OA_PIX_FMT_RGB42BE:
+		case OA_PIX_FMT_RGB42LE:
+		case OA_PIX_FMT_RGB48BE:
+		case OA_PIX_FMT_RGB48LE:
+			return OA_PIX_FMT_RGB24;
+		case OA_PIX_FMT_BGR48BE:
+		case OA_PIX_FMT_BGR48LE:
+			return OA_PIX_FMT_BGR24;
+	}
+	return -OA_ERR_UNSUPPORTED_FORMAT;
+}
+
+
+/*
+ * Stretch a 16-bit mono, raw colour or RGB frame to 8 bits through the
+ * LUT, rebuilding the LUT first if anything it depends on has changed.
+ * Samples are scaled to the bit depth of the format, so 12-bit data
+ * fills the output range rather than just the bottom sixteenth of it.
+ * Source and target may be the same buffer.  Returns the 8-bit format of
+ * the target or -OA_ERR_*.
+ */
+
+int
+oaStretchFrame ( oaStretch* stretch, const void* source, void* target,
+		unsigned int xSize, unsigned int ySize, int format )
+{
+	stretchBands	bands;
+	unsigned int	channels, bits, maxValue, median, mad, tolerance;
+	int						outputFormat;
+
+	if (( outputFormat = oaStretchOutputFormat ( format )) < 0 ) {
+		oaLogError ( OA_LOG_VIDEO, "%s: can't stretch format %d", __func__,
+				format );
+		return outputFormat;
+	}
+
+	channels = oaFrameFormats[ format ].fullColour ? 3 : 1;
+	bits = oaFrameFormats[ format ].bitsPerPixel / channels;
+	maxValue = ( bits && bits < 16 ) ? ( 1 << bits ) - 1 : 65535;
+	if ( maxValue != stretch->maxValue ) {
+		stretch->maxValue = maxValue;
+		stretch->lutValid = 0;
+	}
+
+	bands.source = source;
+	bands.target = target;
+	bands.rowSamples = xSize * channels;
+	bands.littleEndian = oaFrameFormats[ format ].littleEndian;
+
+	if ( OA_STRETCH_AUTO == stretch->params.mode ) {
+		if ( stretch->haveStatistics ) {
+			median = stretch->suppliedMedian;
+			mad = stretch->suppliedMAD;
+			stretch->haveStatistics = 0;
+		} else {
+			_frameStatistics ( stretch, source, bands.rowSamples, ySize,
+					bands.littleEndian, &median, &mad );
+		}
+		tolerance = STATS_TOLERANCE ( maxValue );
+		if ( abs (( int ) median - ( int ) stretch->median ) >
+				( int ) tolerance || abs (( int ) mad - ( int ) stretch->mad ) >
+				( int ) tolerance ) {
+			stretch->lutValid = 0;
+		}
+		if ( !stretch->lutValid ) {
+			stretch->median = median;
+			stretch->mad = mad;
+		}
+	}
+
+	if ( !stretch->lutValid ) {
+		_buildLUT ( stretch );
+	}
+	bands.lut = stretch->lut;
+
+	// Converting in place only works if rows are processed in order
+	if ( source == target ) {
+		return _stretchBand ( &bands, 0, ySize ) ? -OA_ERR_SYSTEM_ERROR :
+				outputFormat;
+	}
+	if ( oaVideoRunBands ( ySize, ( unsigned long ) xSize * ySize, 1,
+			_stretchBand, &bands )) {
+		return -OA_ERR_SYSTEM_ERROR;
+	}
+	return outputFormat;
+}
+
+
+static int
+_stretchBand ( void* arg, unsigned int start, unsigned int end )
+{
+	stretchBands*		bands = arg;
+	const uint8_t*	lut = bands->lut;
+	const uint8_t*	s;
+	uint8_t*				t;
+	size_t					i, n;
+
+	s = bands->source + ( size_t ) start * bands->rowSamples * 2;
+	t = bands->target + ( size_t ) start * bands->rowSamples;
+	n = ( size_t )( end - start ) * bands->rowSamples;
+
+	// Unlike the passes in stats.c and fields.c this is one table lookup
+	// per sample.  SSE2 and NEON have no gather, and their table lookups
+	// (NEON's vqtbl4q_u8 at most) index 64 bytes, not a 64K LUT, so a
+	// vector version would still do the lookups one lane at a time.  Four
+	// independent lookups per iteration keep the loads from queueing
+	// behind each other instead, and the LUT (64K, mostly in L2) serves
+	// every stretch mode the same way.
+
+	i = 0;
+	if ( bands->littleEndian ) {
+		for ( ; i + 4 <= n; i += 4, s += 8 ) {
+			t[i] = lut[ s[0] | ( s[1] << 8 ) ];
+			t[i+1] = lut[ s[2] | ( s[3] << 8 ) ];
+			t[i+2] = lut[ s[4] | ( s[5] << 8 ) ];
+			t[i+3] = lut[ s[6] | ( s[7] << 8 ) ];
+		}
+		for ( ; i < n; i++, s += 2 ) {
+			t[i] = lut[ s[0] | ( s[1] << 8 ) ];
+		}
+	} else {
+		for ( ; i + 4 <= n; i += 4, s += 8 ) {
+			t[i] = lut[ ( s[0] << 8 ) | s[1] ];
+			t[i+1] = lut[ ( s[2] << 8 ) | s[3] ];
+			t[i+2] = lut[ ( s[4] << 8 ) | s[5] ];
+			t[i+3] = lut[ ( s[6] << 8 ) | s[7] ];
+		}
+		for ( ; i < n; i++, s += 2 ) {
+			t[i] = lut[ ( s[0] << 8 ) | s[1] ];
+		}
+	}
+
+	return OA_ERR_NONE;
+}
+
+
+/*
+ * Find the median and median absolute deviation of a subsample of the
+ * frame from a histogram of sample values.  Values above the maximum for
+ * the bit depth are counted as the maximum.
+ */
+
+static void
+_frameStatistics ( oaStretch* stretch, const uint8_t* source,
+		unsigned int rowSamples, unsigned int rows, int littleEndian,
+		unsigned int* median, unsigned int* mad )
+{
+	uint32_t*				histogram = stretch->histogram;
+	unsigned int		maxValue = stretch->maxValue;
+	unsigned int		x, y, v, half, total, count;
+	const uint8_t*	s;
+
+	( void ) memset ( histogram, 0, ( maxValue + 1 ) * sizeof ( uint32_t ));
+	total = 0;
+	for ( y = 0; y < rows; y += ROW_SAMPLE_STEP ) {
+		s = source + ( size_t ) y * rowSamples * 2;
+		for ( x = 0; x < rowSamples; x += SAMPLE_STEP ) {
+			v = littleEndian ? s[ x * 2 ] | ( s[ x * 2 + 1 ] << 8 ) :
+					( s[ x * 2 ] << 8 ) | s[ x * 2 + 1 ];
+			histogram[ v > maxValue ? maxValue : v ]++;
+			total++;
+		}
+	}
+
+	*median = *mad = 0;
+	if ( !total ) {
+		return;
+	}
+
+	half = ( total + 1 ) / 2;
+	count = 0;
+	for ( v = 0; v <= maxValue; v++ ) {
+		if (( count += histogram[v] ) >= half ) {
+			break;
+		}
+	}
+	*median = v;
+
+	// Widen a window around the median until it holds half the samples
+
+	count = histogram[ v ];
+	for ( x = 0; count < half; ) {
+		x++;
+		if ( x <= v ) {
+			count += histogram[ v - x ];
+		}
+		if ( v + x <= maxValue ) {
+			count += histogram[ v + x ];
+		}
+	}
+	*mad = x;
+}
+
+
+static void
+_buildLUT ( oaStretch* stretch )
+{
+	oaStretchParams*	params = &stretch->params;
+	unsigned int			maxValue = stretch->maxValue, v;
+	double						x, black, white, range, midtones, sigma, scale;
+
+	black = params->blackPoint;
+	white = params->whitePoint;
+	midtones = 0.5;
+	scale = 1.0;
+
+	if ( OA_STRETCH_AUTO == params->mode ) {
+		// Clip the shadows a few MADs below the median and then pick the
+		// midtones balance that puts the median at the target background
+		sigma = MAD_TO_SIGMA * stretch->mad / maxValue;
+		black = ( double ) stretch->median / maxValue +
+				params->autoShadowClip * sigma;
+		if ( black < 0.0 ) {
+			black = 0.0;
+		}
+		white = 1.0;
+		x = ( double ) stretch->median / maxValue - black;
+		if ( black < 1.0 && x > 0.0 ) {
+			midtones = _midtonesTransfer ( params->autoBackground,
+					x / ( 1.0 - black ));
+		}
+	}
+	if ( OA_STRETCH_ASINH == params->mode && params->asinhStretch > 0.0 ) {
+		scale = 1.0 / asinh ( params->asinhStretch );
+	}
+
+	range = white - black;
+	if ( range <= 0.0 ) {
+		range = 1.0 / maxValue;
+	}
+	for ( v = 0; v <= maxValue; v++ ) {
+		x = (( double ) v / maxValue - black ) / range;
+		if ( x <= 0.0 ) {
+			x = 0.0;
+		} else if ( x >= 1.0 ) {
+			x = 1.0;
+		} else {
+			switch ( params->mode ) {
+				case OA_STRETCH_ASINH:
+					if ( params->asinhStretch > 0.0 ) {
+						x = asinh ( params->asinhStretch * x ) * scale;
+					}
+					break;
+				case OA_STRETCH_AUTO:
+					x = _midtonesTransfer ( midtones, x );
+					break;
+			}
+		}
+		stretch->lut[v] = x * 255.0 + 0.5;
+	}
+	( void ) memset ( stretch->lut + maxValue + 1, stretch->lut[ maxValue ],
+			65535 - maxValue );
+
+	stretch->lutValid = 1;
+	stretch->lutRebuilds++;
+}
+
+
+/*
+ * The midtones transfer function maps 0 to 0, 1 to 1 and m to 0.5.  It is
+ * its own inverse in the sense that MTF ( MTF ( m, x ), x ) == m, which is
+ * how the midtones balance for the auto stretch is found.
+ */
+
+static double
+_midtonesTransfer ( double m, double x )
+{
+	if ( x <= 0.0 ) {
+		return 0.0;
+	}
+	if ( x >= 1.0 ) {
+		return 1.0;
+	}
+	return ( m - 1.0 ) * x / (( 2.0 * m - 1.0 ) * x - m );
+}
@@ -0,0 +1,273 @@
+/*****************************************************************************
+ *
+ * threads.c -- thread pool for splitting frame processing into row bands
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <pthread.h>
+
+#include <openastro/errno.h>
+#include <openastro/video.h>
+#include <openastro/util.h>
+
+#include "threads.h"
+
+
+// Frames smaller than this many pixels are always processed by the calling
+// thread because the cost of handing out the work outweighs the gain
+
+#define	DEFAULT_THREAD_THRESHOLD	( 1024 * 1024 )
+#define	MAX_VIDEO_THREADS					64
+
+static void*		_bandWorker ( void* );
+
+static pthread_mutex_t	dispatchMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t	poolMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t		bandQueued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t		bandsComplete = PTHREAD_COND_INITIALIZER;
+
+static pthread_t				workers[ MAX_VIDEO_THREADS ];
+static unsigned int			numWorkers = 0;
+static unsigned int			threadThreshold = DEFAULT_THREAD_THRESHOLD;
+static int							stopWorkers = 0;
+
+// The job currently being processed.  Only changed with poolMutex held
+
+static oaVideoBandFunc	jobFunc = 0;
+static void*						jobArg = 0;
+static unsigned int			jobRows = 0;
+static unsigned int			jobBandRows = 0;
+static unsigned int			jobBands = 0;
+static unsigned int			nextBand = 0;
+static unsigned int			bandsDone = 0;
+static int							jobResult = OA_ERR_NONE;
+
+
+/*
+ * Set the number of threads used to process large frames, including the
+ * calling thread.  1 (the default) processes everything in the calling
+ * thread and 0 uses one thread per online CPU.
+ */
+
+int
+oaSetVideoThreads ( unsigned int threads )
+{
+	unsigned int	i;
+	int						ret = OA_ERR_NONE;
+#ifdef _SC_NPROCESSORS_ONLN
+	long					cpus;
+#endif
+
+	if ( !threads ) {
+		threads = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+		if (( cpus = sysconf ( _SC_NPROCESSORS_ONLN )) > 1 ) {
+			threads = cpus;
+		}
+#endif
+	}
+	if ( threads > MAX_VIDEO_THREADS ) {
+		threads = MAX_VIDEO_THREADS;
+	}
+
+	// Holding the dispatch mutex means no job can be running while the
+	// pool is resized
+
+	pthread_mutex_lock ( &dispatchMutex );
+
+	if ( numWorkers ) {
+		pthread_mutex_lock ( &poolMutex );
+		stopWorkers = 1;
+		pthread_cond_broadcast ( &bandQueued );
+		pthread_mutex_unlock ( &poolMutex );
+		for ( i = 0; i < numWorkers; i++ ) {
+			( void ) pthread_join ( workers[i], 0 );
+		}
+		numWorkers = 0;
+		stopWorkers = 0;
+	}
+
+	for ( i = 0; i < threads - 1; i++ ) {
+		if ( pthread_create ( &workers[i], 0, _bandWorker, 0 )) {
+			oaLogError ( OA_LOG_VIDEO, "%s: only able to start %u of %u threads",
+					__func__, i + 1, threads );
+			ret = -OA_ERR_SYSTEM_ERROR;
+			break;
+		}
+		numWorkers++;
+	}
+
+	pthread_mutex_unlock ( &dispatchMutex );
+	return ret;
+}
+
+
+unsigned int
+oaGetVideoThreads ( void )
+{
+	unsigned int	threads;
+
+	pthread_mutex_lock ( &dispatchMutex );
+	threads = numWorkers + 1;
+	pthread_mutex_unlock ( &dispatchMutex );
+	return threads;
+}
+
+
+/*
+ * Set the frame size in pixels at or above which work is split between
+ * threads
+ */
+
+void
+oaSetVideoThreadThreshold ( unsigned int pixels )
+{
+	pthread_mutex_lock ( &poolMutex );
+	threadThreshold = pixels;
+	pthread_mutex_unlock ( &poolMutex );
+}
+
+
+unsigned int
+oaGetVideoThreadThreshold ( void )
+{
+	unsigned int	pixels;
+
+	pthread_mutex_lock ( &poolMutex );
+	pixels = threadThreshold;
+	pthread_mutex_unlock ( &poolMutex );
+	return pixels;
+}
+
+
+/*
+ * Call func for rows 0 to rows - 1 of a frame of the given number of
+ * pixels, split into bands that are processed in parallel if the frame is
+ * large enough and the pool is free.  Bands other than the last are a
+ * multiple of "align" rows so callers can keep CFA cells or tiles intact.
+ * The calling thread processes bands too, and this returns once they are
+ * all complete with the first error returned by func, if any.
+ */
+
+int
+oaVideoRunBands ( unsigned int rows, unsigned long pixels, unsigned int align,
+		oaVideoBandFunc func, void* arg )
+{
+	unsigned int	band, start, end, threads;
+	int						ret;
+
+	if ( !rows ) {
+		return OA_ERR_NONE;
+	}
+	if ( !align ) {
+		align = 1;
+	}
+
+	// If another thread is already using the pool then don't wait for it
+
+	if ( pthread_mutex_trylock ( &dispatchMutex )) {
+		return func ( arg, 0, rows );
+	}
+
+	pthread_mutex_lock ( &poolMutex );
+	threads = numWorkers + 1;
+	if ( threads < 2 || pixels < threadThreshold || rows < 2 * align ) {
+		pthread_mutex_unlock ( &poolMutex );
+		pthread_mutex_unlock ( &dispatchMutex );
+		return func ( arg, 0, rows );
+	}
+
+	jobBandRows = ( rows + threads - 1 ) / threads;
+	jobBandRows = ( jobBandRows + align - 1 ) / align * align;
+	jobBands = ( rows + jobBandRows - 1 ) / jobBandRows;
+	jobFunc = func;
+	jobArg = arg;
+	jobRows = rows;
+	nextBand = 0;
+	bandsDone = 0;
+	jobResult = OA_ERR_NONE;
+	pthread_cond_broadcast ( &bandQueued );
+
+	while ( nextBand < jobBands ) {
+		band = nextBand++;
+		pthread_mutex_unlock ( &poolMutex );
+		start = band * jobBandRows;
+		end = ( start + jobBandRows < rows ) ? start + jobBandRows : rows;
+		ret = func ( arg, start, end );
+		pthread_mutex_lock ( &poolMutex );
+		if ( ret && !jobResult ) {
+			jobResult = ret;
+		}
+		bandsDone++;
+	}
+	while ( bandsDone < jobBands ) {
+		pthread_cond_wait ( &bandsComplete, &poolMutex );
+	}
+
+	ret = jobResult;
+	jobFunc = 0;
+	jobBands = 0;
+	pthread_mutex_unlock ( &poolMutex );
+	pthread_mutex_unlock ( &dispatchMutex );
+	return ret;
+}
+
+
+static void*
+_bandWorker ( void* param )
+{
+	unsigned int		band, start, end;
+	oaVideoBandFunc	func;
+	void*						arg;
+	int							ret;
+
+	pthread_mutex_lock ( &poolMutex );
+	while ( 1 ) {
+		while ( !stopWorkers && nextBand >= jobBands ) {
+			pthread_cond_wait ( &bandQueued, &poolMutex );
+		}
+		if ( stopWorkers ) {
+			break;
+		}
+		band = nextBand++;
+		func = jobFunc;
+		arg = jobArg;
+		start = band * jobBandRows;
+		end = ( start + jobBandRows < jobRows ) ? start + jobBandRows : jobRows;
+		pthread_mutex_unlock ( &poolMutex );
+
+		ret = func ( arg, start, end );
+
+		pthread_mutex_lock ( &poolMutex );
+		if ( ret && !jobResult ) {
+			jobResult = ret;
+		}
+		if ( ++bandsDone == jobBands ) {
+			pthread_cond_signal ( &bandsComplete );
+		}
+	}
+	pthread_mutex_unlock ( &poolMutex );
+	return 0;
+}
@@ -0,0 +1,262 @@
+/*****************************************************************************
+ *
+ * cameraDiagnostics.cc -- display camera throughput and latency statistics
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <QtGui>
+
+#include "commonState.h"
+#include "cameraDiagnostics.h"
+
+
+CameraDiagnostics::CameraDiagnostics ( QWidget* parent ) : QWidget ( parent,
+		Qt::Window )
+{
+  QStringList	histograms;
+
+  histograms << tr ( "Dequeue to callback" ) << tr ( "Callback duration" );
+
+  setWindowTitle ( tr ( "Camera Diagnostics" ));
+
+  deliveredLabel = new QLabel ( this );
+  rateLabel = new QLabel ( this );
+  driverDropLabel = new QLabel ( this );
+  bufferDropLabel = new QLabel ( this );
+  elapsedLabel = new QLabel ( this );
+
+  countGrid = new QGridLayout();
+  countGrid->addWidget ( new QLabel ( tr ( "Frames delivered" ), this ), 0, 0 );
+  countGrid->addWidget ( deliveredLabel, 0, 1 );
+  countGrid->addWidget ( new QLabel ( tr ( "Frames per second" ), this ),
+      1, 0 );
+  countGrid->addWidget ( rateLabel, 1, 1 );
+  countGrid->addWidget ( new QLabel ( tr ( "Dropped by camera/driver" ),
+      this ), 2, 0 );
+  countGrid->addWidget ( driverDropLabel, 2, 1 );
+  countGrid->addWidget ( new QLabel ( tr ( "Dropped, no free buffer" ),
+      this ), 3, 0 );
+  countGrid->addWidget ( bufferDropLabel, 3, 1 );
+  countGrid->addWidget ( new QLabel ( tr ( "Seconds since reset" ), this ),
+      4, 0 );
+  countGrid->addWidget ( elapsedLabel, 4, 1 );
+  countGrid->setColumnStretch ( 2, 1 );
+
+  latencyGrid = new QGridLayout();
+  latencyGrid->addWidget ( new QLabel ( tr ( "Mean" ), this ), 0, 1 );
+  latencyGrid->addWidget ( new QLabel ( tr ( "50%" ), this ), 0, 2 );
+  latencyGrid->addWidget ( new QLabel ( tr ( "95%" ), this ), 0, 3 );
+  latencyGrid->addWidget ( new QLabel ( tr ( "99%" ), this ), 0, 4 );
+  latencyGrid->addWidget ( new QLabel ( tr ( "Max" ), this ), 0, 5 );
+  for ( int i = 0; i < DIAG_HISTOGRAMS; i++ ) {
+    latencyGrid->addWidget ( new QLabel ( histograms[i], this ), i+1, 0 );
+    meanLabel[i] = new QLabel ( this );
+    latencyGrid->addWidget ( meanLabel[i], i+1, 1 );
+    p50Label[i] = new QLabel ( this );
+    latencyGrid->addWidget ( p50Label[i], i+1, 2 );
+    p95Label[i] = new QLabel ( this );
+    latencyGrid->addWidget ( p95Label[i], i+1, 3 );
+    p99Label[i] = new QLabel ( this );
+    latencyGrid->addWidget ( p99Label[i], i+1, 4 );
+    maxLabel[i] = new QLabel ( this );
+    latencyGrid->addWidget ( maxLabel[i], i+1, 5 );
+  }
+
+  resetButton = new QPushButton ( tr ( "Reset" ), this );
+  connect ( resetButton, SIGNAL( clicked()), this, SLOT( resetStats()));
+  closeButton = new QPushButton ( tr ( "Close" ), this );
+  connect ( closeButton, SIGNAL( clicked()), this, SLOT( close()));
+
+  buttonBox = new QHBoxLayout();
+  buttonBox->addStretch ( 1 );
+  buttonBox->addWidget ( resetButton );
+  buttonBox->addWidget ( closeButton );
+
+  vbox = new QVBoxLayout();
+  vbox->addLayout ( countGrid );
+  vbox->addSpacing ( 10 );
+  vbox->addLayout ( latencyGrid );
+  vbox->addStretch ( 1 );
+  vbox->addLayout ( buttonBox );
+  setLayout ( vbox );
+
+  updateStats();
+
+  timer = new QTimer ( this );
+  connect ( timer, SIGNAL( timeout()), this, SLOT( updateStats()));
+  timer->start ( 1000 );
+}
+
+
+CameraDiagnostics::~CameraDiagnostics()
+{
+  timer->stop();
+  // FIX ME -- delete widgets
+}
+
+
+QString
+CameraDiagnostics::formatLatency ( uint64_t ns )
+{
+  if ( ns < 10000 ) {
+    return QString::number ( ns / 1000.0, 'f', 1 ) + " us";
+  }
+  if ( ns < 10000000 ) {
+    return QString::number ( ns / 1000 ) + " us";
+  }
+  return QString::number ( ns / 1000000 ) + " ms";
+}
+
+
+void
+CameraDiagnostics::updateStats ( void )
+{
+  oaCameraStats		stats;
+  const oaLatencyHistogram*	hist[ DIAG_HISTOGRAMS ];
+  double		seconds;
+
+  if ( !commonState.camera || !commonState.camera->isInitialised() ||
+      commonState.camera->getStats ( &stats ) != OA_ERR_NONE ) {
+    deliveredLabel->setText ( "-" );
+    rateLabel->setText ( "-" );
+    driverDropLabel->setText ( "-" );
+    bufferDropLabel->setText ( "-" );
+    elapsedLabel->setText ( "-" );
+    for ( int i = 0; i < DIAG_HISTOGRAMS; i++ ) {
+      meanLabel[i]->setText ( "-" );
+      p50Label[i]->setText ( "-" );
+      p95Label[i]->setText ( "-" );
+      p99Label[i]->setText ( "-" );
+      maxLabel[i]->setText ( "-" );
+    }
+    resetButton->setEnabled ( 0 );
+    return;
+  }
+
+  resetButton->setEnabled ( 1 );
+  seconds = stats.elapsedNs / 1e9;
+  deliveredLabel->setText ( QString::number (
+      static_cast<qulonglong>( stats.framesDelivered )));
+  rateLabel->setText ( seconds > 0 ? QString::number (
+      stats.framesDelivered / seconds, 'f', 1 ) : "-" );
+  driverDropLabel->setText ( QString::number (
+      static_cast<qulonglong>( stats.driverDrops )));
+  bufferDropLabel->setText ( QString::number (
+      static_cast<qulonglong>( stats.bufferDrops )));
+  elapsedLabel->setText ( QString::number ( seconds, 'f', 0 ));
+
+  hist[0] = &stats.queueLatency;
+  hist[1] = &stats.callbackDuration;
+  for ( int i = 0; i < DIAG_HISTOGRAMS; i++ ) {
+    if ( !hist[i]->count ) {
+      meanLabel[i]->setText ( "-" );
+      p50Label[i]->setText ( "-" );
+      p95Label[i]->setText ( "-" );
+      p99Label[i]->setText ( "-" );
+      maxLabel[i]->setText ( "-" );
+      continue;
+    }
+    meanLabel[i]->setText ( formatLatency ( hist[i]->totalNs /
+        hist[i]->count ));
+    p50Label[i]->setText ( formatLatency ( oaLatencyPercentile ( hist[i],
+        0.5 )));
+    p95Label[i]->setText ( formatLatency ( oaLatencyPercentile ( hist[i],
+        0.95 )));
+    p99Label[i]->setText ( formatLatency ( oaLatencyPercentile ( hist[i],
+        0.99 )));
+    maxLabel[i]->setText ( formatLatency ( hist[i]->maxNs ));
+  }
+}
+
+
+void
+CameraDiagnostics::resetStats ( void )
+{
+  if ( commonState.camera && commonState.camera->isInitialised()) {
+    commonState.camera->resetStats();
+  }
+  updateStats();
+}
+
+
+// Summary values first, then the raw histogram buckets, so the file can
+// be loaded straight into a spreadsheet or plotted
+
+int
+CameraDiagnostics::writeCSV ( const QString& filename,
+    const oaCameraStats* stats )
+{
+  const oaLatencyHistogram*	hist[ DIAG_HISTOGRAMS ];
+  const char*		names[ DIAG_HISTOGRAMS ] = { "queue_latency",
+      "callback_duration" };
+  uint64_t		limit;
+
+  QFile file ( filename );
+  if ( !file.open ( QIODevice::WriteOnly | QIODevice::Text )) {
+    return -1;
+  }
+  QTextStream out ( &file );
+
+  hist[0] = &stats->queueLatency;
+  hist[1] = &stats->callbackDuration;
+
+  out << "statistic,value\n";
+  out << "frames_delivered," <<
+      static_cast<qulonglong>( stats->framesDelivered ) << "\n";
+  out << "driver_drops," << static_cast<qulonglong>( stats->driverDrops ) <<
+      "\n";
+  out << "buffer_drops," << static_cast<qulonglong>( stats->bufferDrops ) <<
+      "\n";
+  out << "elapsed_s," << QString::number ( stats->elapsedNs / 1e9, 'f', 3 ) <<
+      "\n";
+  for ( int i = 0; i < DIAG_HISTOGRAMS; i++ ) {
+    out << names[i] << "_mean_us," << ( hist[i]->count ? QString::number (
+        hist[i]->totalNs / hist[i]->count / 1000.0, 'f', 1 ) : "" ) << "\n";
+    out << names[i] << "_p50_us," << QString::number ( oaLatencyPercentile (
+        hist[i], 0.5 ) / 1000.0, 'f', 1 ) << "\n";
+    out << names[i] << "_p95_us," << QString::number ( oaLatencyPercentile (
+        hist[i], 0.95 ) / 1000.0, 'f', 1 ) << "\n";
+    out << names[i] << "_p99_us," << QString::number ( oaLatencyPercentile (
+        hist[i], 0.99 ) / 1000.0, 'f', 1 ) << "\n";
+    out << names[i] << "_max_us," << QString::number ( hist[i]->maxNs /
+        1000.0, 'f', 1 ) << "\n";
+  }
+
+  out << "\nbucket_limit_us," << names[0] << "," << names[1] << "\n";
+  for ( unsigned int b = 0; b < OA_LATENCY_BUCKETS; b++ ) {
+    limit = oaLatencyBucketLimit ( b );
+    if ( limit == UINT64_MAX ) {
+      out << "inf";
+    } else {
+      out << static_cast<qulonglong>( limit / 1000 );
+    }
+    out << "," << static_cast<qulonglong>( hist[0]->bucket[b] ) << "," <<
+        static_cast<qulonglong>( hist[1]->bucket[b] ) << "\n";
+  }
+
+  out.flush();
+  file.close();
+  return file.error() == QFile::NoError ? 0 : -1;
+}
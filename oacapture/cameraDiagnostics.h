@@ -0,0 +1,79 @@
+/*****************************************************************************
+ *
+ * cameraDiagnostics.h -- class declaration
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <oa_common.h>
+
+#include <QtGlobal>
+#if QT_VERSION >= 0x050000
+#include <QtWidgets>
+#endif
+#include <QtCore>
+#include <QtGui>
+
+extern "C" {
+#include <openastro/camera.h>
+}
+
+#define DIAG_HISTOGRAMS		2
+
+
+class CameraDiagnostics : public QWidget
+{
+  Q_OBJECT
+
+  public:
+    			CameraDiagnostics ( QWidget* );
+    			~CameraDiagnostics();
+
+    static int		writeCSV ( const QString&, const oaCameraStats* );
+
+  private:
+    QGridLayout*	countGrid;
+    QGridLayout*	latencyGrid;
+    QVBoxLayout*	vbox;
+    QHBoxLayout*	buttonBox;
+    QPushButton*	resetButton;
+    QPushButton*	closeButton;
+    QLabel*		deliveredLabel;
+    QLabel*		rateLabel;
+    QLabel*		driverDropLabel;
+    QLabel*		bufferDropLabel;
+    QLabel*		elapsedLabel;
+    QLabel*		meanLabel[ DIAG_HISTOGRAMS ];
+    QLabel*		p50Label[ DIAG_HISTOGRAMS ];
+    QLabel*		p95Label[ DIAG_HISTOGRAMS ];
+    QLabel*		p99Label[ DIAG_HISTOGRAMS ];
+    QLabel*		maxLabel[ DIAG_HISTOGRAMS ];
+    QTimer*		timer;
+
+    static QString	formatLatency ( uint64_t );
+
+  public slots:
+    void		updateStats ( void );
+    void		resetStats ( void );
+};
@@ -687,6 +687,9 @@ CaptureWidget::doStartRecording ( int autorunFlag )
   if ( state.histogramOn ) {
     state.histogramWidget->resetStats();
   }
+  if ( generalConf.saveCameraStats ) {
+    commonState.camera->resetStats();
+  }
 
   if ( timerConf.timerEnabled && commonState.timer &&
 			commonState.timer->isInitialised()) {
@@ -831,6 +834,9 @@ CaptureWidget::doStopRecording ( void )
   if ( generalConf.saveCaptureSettings && outputHandler ) {
     writeSettings ( outputHandler );
   }
+  if ( generalConf.saveCameraStats && outputHandler ) {
+    writeCameraStats ( outputHandler );
+  }
   closeOutputHandler();
 
 	// Disable trigger mode at this point if it would have been enabled when
@@ -1428,6 +1434,22 @@ CaptureWidget::updateFromConfig ( void )
 }
 
 
+void
+CaptureWidget::writeCameraStats ( OutputHandler* out )
+{
+  oaCameraStats	stats;
+
+  if ( commonState.camera->getStats ( &stats ) != OA_ERR_NONE ) {
+    return;
+  }
+  QString statsFile = out->getRecordingBasename();
+  statsFile += "-stats.csv";
+  if ( CameraDiagnostics::writeCSV ( statsFile, &stats )) {
+    qWarning() << "Unable to write camera statistics to" << statsFile;
+  }
+}
+
+
 void
 CaptureWidget::writeSettings ( OutputHandler* out )
 {
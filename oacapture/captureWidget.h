@@ -81,6 +81,7 @@ class CaptureWidget : public QGroupBox
   private:
     void		doStartRecording ( int );
     void		writeSettings ( OutputHandler* );
+    void		writeCameraStats ( OutputHandler* );
     QComboBox*		limitTypeMenu;
     QComboBox*		countFramesMenu;
     QComboBox*		countSecondsMenu;
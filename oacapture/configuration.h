@@ -81,6 +81,9 @@ typedef struct
   int			preview;
   int			nightMode;
 
+  // camera thread scheduling
+  oaCameraThreadPolicy	threadPolicy[ OA_CAM_THREAD_ROLES ];
+
 } CONFIG;
 
 extern CONFIG		config;
@@ -1283,7 +1283,8 @@ ControlWidget::updateExposure ( int value )
     cameraConf.CONTROL_VALUE( OA_CAM_CTRL_EXPOSURE_ABSOLUTE ) = usecValue;
     SET_PROFILE_CONTROL( OA_CAM_CTRL_EXPOSURE_ABSOLUTE, usecValue );
     // convert value back to microseconds from milliseconds
-    commonState.camera->setControl ( OA_CAM_CTRL_EXPOSURE_ABSOLUTE, usecValue );
+    commonState.camera->setControlAsync ( OA_CAM_CTRL_EXPOSURE_ABSOLUTE,
+        usecValue );
     if ( !commonState.camera->hasFrameRateSupport()) {
       theoreticalFPSNumerator = usecValue;
       theoreticalFPSDenominator = 1000000;
@@ -1301,7 +1302,7 @@ ControlWidget::updateExposure ( int value )
     }
   } else {
     state.cameraWidget->clearFPSMaxValue();
-    commonState.camera->setControl ( OA_CAM_CTRL_EXPOSURE_UNSCALED, value );
+    commonState.camera->setControlAsync ( OA_CAM_CTRL_EXPOSURE_UNSCALED, value );
     cameraConf.CONTROL_VALUE( OA_CAM_CTRL_EXPOSURE_UNSCALED ) = value;
     SET_PROFILE_CONTROL( OA_CAM_CTRL_EXPOSURE_UNSCALED, value );
     if ( state.settingsWidget ) {
@@ -1369,7 +1370,7 @@ ControlWidget::updateGain ( int value )
   if ( !ignoreGainChanges ) {
     cameraConf.CONTROL_VALUE( OA_CAM_CTRL_GAIN ) = value;
     SET_PROFILE_CONTROL( OA_CAM_CTRL_GAIN, value );
-    commonState.camera->setControl ( OA_CAM_CTRL_GAIN, value );
+    commonState.camera->setControlAsync ( OA_CAM_CTRL_GAIN, value );
     if ( state.settingsWidget ) {
       state.settingsWidget->updateControl ( OA_CAM_CTRL_GAIN, value );
     }
@@ -1386,7 +1387,7 @@ ControlWidget::updateSelectableControl ( int control )
     SET_PROFILE_CONTROL( control, value );
 		// If we're in auto mode then there's no need to call setControl
 		if ( !cameraConf.CONTROL_VALUE( OA_CAM_CTRL_MODE_AUTO ( control ))) {
-			commonState.camera->setControl ( control, value );
+			commonState.camera->setControlAsync ( control, value );
 		}
     if ( state.settingsWidget ) {
       state.settingsWidget->updateControl ( control, value );
@@ -35,6 +35,7 @@ extern "C" {
 
 #include <openastro/filterwheel.h>
 #include <openastro/demosaic.h>
+#include <openastro/video/stretch.h>
 }
 
 #include "focusOverlay.h"
@@ -136,6 +137,8 @@ MainWindow::MainWindow ( QString configFile )
   commonState.captureIndex = 0;
   state.settingsWidget = nullptr;
   state.advancedSettings = nullptr;
+  state.threadSettings = nullptr;
+  state.cameraDiagnostics = nullptr;
   colourDialog = nullptr;
 
   // need to do this to prevent access attempts before creation
@@ -338,6 +341,7 @@ MainWindow::readConfig ( QString configFile )
     generalConf.tempsInC = 1;
     generalConf.reticleStyle = 1;
     generalConf.displayFPS = 15;
+    generalConf.displayStretch = OA_STRETCH_AUTO;
 
     config.showHistogram = 0;
     config.autoAlign = 0;
@@ -389,6 +393,7 @@ MainWindow::readConfig ( QString configFile )
     autorunConf.autorunCount = 0;
     autorunConf.autorunDelay = 0;
     generalConf.saveCaptureSettings = 1;
+    generalConf.saveCameraStats = 0;
 
 #if defined(__APPLE__) && defined(__MACH__) && TARGET_OS_MAC == 1
     captureConf.windowsCompatibleAVI = 1;
@@ -458,6 +463,8 @@ MainWindow::readConfig ( QString configFile )
 				"separateControls", 0 ).toInt();
     generalConf.saveCaptureSettings = settings->value ( "saveCaptureSettings",
         1 ).toInt();
+    generalConf.saveCameraStats = settings->value ( "saveCameraStats",
+        0 ).toInt();
 
     captureConf.windowsCompatibleAVI = settings->value (
 				"windowsCompatibleAVI", 0 ).toInt();
@@ -559,6 +566,8 @@ MainWindow::readConfig ( QString configFile )
 				"display/displayFPS", 15 ).toInt();
     // fix a problem with existing configs
     if ( !generalConf.displayFPS ) { generalConf.displayFPS = 15; }
+    generalConf.displayStretch = settings->value ( "display/stretch",
+				OA_STRETCH_AUTO ).toInt();
 
     histogramConf.splitHistogram = settings->value (
 				"histogram/split", 0 ).toInt();
@@ -581,6 +590,21 @@ MainWindow::readConfig ( QString configFile )
     generalConf.reticleStyle = settings->value ( "reticle/style",
         RETICLE_CIRCLE ).toInt();
 
+    int numThreads = settings->beginReadArray ( "cameraThreads" );
+    for ( int i = 0; i < numThreads && i < OA_CAM_THREAD_ROLES; i++ ) {
+      settings->setArrayIndex ( i );
+      config.threadPolicy[i].cpuMask = settings->value ( "cpuMask",
+          0 ).toULongLong();
+      config.threadPolicy[i].scheduler = settings->value ( "scheduler",
+          OA_THREAD_SCHED_DEFAULT ).toInt();
+      config.threadPolicy[i].priority = settings->value ( "priority",
+          0 ).toInt();
+      ( void ) strncpy ( config.threadPolicy[i].name, settings->value (
+          "name", "" ).toString().toStdString().c_str(), OA_THREAD_NAME_LEN );
+      ( void ) oaSetCameraThreadPolicy ( i, &config.threadPolicy[i] );
+    }
+    settings->endArray();
+
     // Give up on earlier versions of this data.  It's too complicated to
     // sort out
     if ( version >= 7 ) {
@@ -1026,6 +1050,7 @@ MainWindow::writeConfig ( QString configFile )
   settings->setValue ( "separateControls", generalConf.separateControls );
   settings->setValue ( "saveCaptureSettings",
 			generalConf.saveCaptureSettings );
+  settings->setValue ( "saveCameraStats", generalConf.saveCameraStats );
 
   settings->setValue ( "windowsCompatibleAVI",
 			captureConf.windowsCompatibleAVI );
@@ -1098,6 +1123,7 @@ MainWindow::writeConfig ( QString configFile )
   settings->setValue ( "display/preview", config.preview );
   settings->setValue ( "display/nightMode", config.nightMode );
   settings->setValue ( "display/displayFPS", generalConf.displayFPS );
+  settings->setValue ( "display/stretch", generalConf.displayStretch );
 
   settings->setValue ( "histogram/split", histogramConf.splitHistogram );
   settings->setValue ( "histogram/onTop", histogramConf.histogramOnTop );
@@ -1112,6 +1138,17 @@ MainWindow::writeConfig ( QString configFile )
 
   settings->setValue ( "reticle/style", generalConf.reticleStyle );
 
+  settings->beginWriteArray ( "cameraThreads" );
+  for ( int i = 0; i < OA_CAM_THREAD_ROLES; i++ ) {
+    settings->setArrayIndex ( i );
+    settings->setValue ( "cpuMask",
+        ( qulonglong ) config.threadPolicy[i].cpuMask );
+    settings->setValue ( "scheduler", config.threadPolicy[i].scheduler );
+    settings->setValue ( "priority", config.threadPolicy[i].priority );
+    settings->setValue ( "name", config.threadPolicy[i].name );
+  }
+  settings->endArray();
+
   settings->beginWriteArray ( "controls" );
   for ( int i = 1; i < OA_CAM_CTRL_LAST_P1; i++ ) {
     settings->setArrayIndex ( i-1 );
@@ -1543,20 +1580,11 @@ MainWindow::createMenus ( void )
   settingsMenu->addAction ( falseColour );
   settingsMenu->addAction ( timer );
 
-  // For the moment we only add the advanced menu if there are filter
-  // wheels with user-configurable interfaces
-
-  int requireAdvanced = 0;
-  for ( int i = 1; i < OA_FW_IF_COUNT && !requireAdvanced; i++ ) {
-    if ( oaFilterWheelInterfaces[ i ].userConfigFlags ) {
-      requireAdvanced = 1;
-    }
-  }
+  // The advanced menu always has at least the PTR timers and camera
+  // thread settings
 
-  if ( requireAdvanced ) {
-    advancedMenu = menuBar()->addMenu ( tr ( "&Advanced" ));
-    doAdvancedMenu();
-  }
+  advancedMenu = menuBar()->addMenu ( tr ( "&Advanced" ));
+  doAdvancedMenu();
 
   // help menu
 
@@ -1942,7 +1970,7 @@ MainWindow::setDroppedFrames()
 			!commonState.camera->hasControl ( OA_CAM_CTRL_DROPPED )) {
 		return;
 	}
-  dropped = commonState.camera->readControl ( OA_CAM_CTRL_DROPPED );
+  dropped = commonState.camera->readCachedControl ( OA_CAM_CTRL_DROPPED );
   stringVal.setNum ( dropped );
   droppedValue->setText ( stringVal );
 }
@@ -2932,6 +2960,18 @@ MainWindow::doAdvancedMenu( void )
   advancedMenu->addAction ( advancedActions[ totalActions ]);
   connect ( advancedActions[ totalActions ], SIGNAL( triggered()),
       this, SLOT( advancedPTRHandler()));
+  totalActions++;
+
+  advancedActions.append ( new QAction ( tr ( "Camera threads" ), this ));
+  advancedMenu->addAction ( advancedActions[ totalActions ]);
+  connect ( advancedActions[ totalActions ], SIGNAL( triggered()),
+      this, SLOT( threadSettingsHandler()));
+  totalActions++;
+
+  advancedActions.append ( new QAction ( tr ( "Camera diagnostics" ), this ));
+  advancedMenu->addAction ( advancedActions[ totalActions ]);
+  connect ( advancedActions[ totalActions ], SIGNAL( triggered()),
+      this, SLOT( cameraDiagnosticsHandler()));
 }
 
 
@@ -2972,6 +3012,48 @@ MainWindow::advancedClosed ( void )
 }
 
 
+void
+MainWindow::threadSettingsHandler ( void )
+{
+  if ( !state.threadSettings ) {
+    state.threadSettings = new ThreadSettings ( this );
+    state.threadSettings->setAttribute ( Qt::WA_DeleteOnClose );
+    connect ( state.threadSettings, SIGNAL( destroyed ( QObject* )), this,
+        SLOT ( threadSettingsClosed()));
+  }
+
+  state.threadSettings->show();
+}
+
+
+void
+MainWindow::threadSettingsClosed ( void )
+{
+  state.threadSettings = nullptr;
+}
+
+
+void
+MainWindow::cameraDiagnosticsHandler ( void )
+{
+  if ( !state.cameraDiagnostics ) {
+    state.cameraDiagnostics = new CameraDiagnostics ( this );
+    state.cameraDiagnostics->setAttribute ( Qt::WA_DeleteOnClose );
+    connect ( state.cameraDiagnostics, SIGNAL( destroyed ( QObject* )), this,
+        SLOT ( cameraDiagnosticsClosed()));
+  }
+
+  state.cameraDiagnostics->show();
+}
+
+
+void
+MainWindow::cameraDiagnosticsClosed ( void )
+{
+  state.cameraDiagnostics = nullptr;
+}
+
+
 void
 MainWindow::closeAdvancedWindow ( void )
 {
@@ -260,6 +260,10 @@ class MainWindow : public QMainWindow
     void		advancedPTRHandler ( void );
     void		closeAdvancedWindow ( void );
     void		advancedClosed ( void );
+    void		threadSettingsHandler ( void );
+    void		threadSettingsClosed ( void );
+    void		cameraDiagnosticsHandler ( void );
+    void		cameraDiagnosticsClosed ( void );
     void		doColouriseSettings ( void );
     void		setCapturedFrames ( unsigned int );
     void		setDroppedFrames ( void );
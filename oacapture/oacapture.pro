@@ -47,7 +47,9 @@ HEADERS += camera.h \
            demosaicSettings.h \
            timerSettings.h \
            fitsSettings.h \
-           occultationWidget.h
+           occultationWidget.h \
+           threadSettings.h \
+           cameraDiagnostics.h
 
 SOURCES += camera.cc \
            cameraWidget.cc \
@@ -76,6 +78,8 @@ SOURCES += camera.cc \
            demosaicSettings.cc \
            timerSettings.cc \
            fitsSettings.cc \
-           occultationWidget.h
+           occultationWidget.h \
+           threadSettings.cc \
+           cameraDiagnostics.cc
 
 TRANSLATIONS += translations/oacapture_es.ts
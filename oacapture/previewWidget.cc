@@ -37,12 +37,14 @@
 
 extern "C" {
 #include <pthread.h>
+#include <time.h>
 
 #include <openastro/camera.h>
 #include <openastro/demosaic.h>
 #include <openastro/video.h>
 #include <openastro/imgproc.h>
 #include <openastro/video/formats.h>
+#include <openastro/video/stretch.h>
 }
 
 #include "commonState.h"
@@ -82,6 +84,9 @@ PreviewWidget::PreviewWidget ( QWidget* parent ) : QFrame ( parent )
   expectedSize = commonConfig.imageSizeX * commonConfig.imageSizeY *
       oaFrameFormats[ videoFramePixelFormat ].bytesPerPixel;
   demosaic = commonConfig.demosaic;
+  stretchMode = generalConf.displayStretch;
+  stretch = oaStretchCreate ( 0 );
+  frameStats = oaFrameStatsCreate();
 
   int r = config.currentColouriseColour.red();
   int g = config.currentColouriseColour.green();
@@ -117,6 +122,8 @@ PreviewWidget::~PreviewWidget()
     free ( writeImageBuffer[0] );
     free ( writeImageBuffer[1] );
   }
+  oaStretchDestroy ( stretch );
+  oaFrameStatsDestroy ( frameStats );
 }
 
 
@@ -386,6 +393,15 @@ PreviewWidget::setDisplayFPS ( int fps )
 }
 
 
+void
+PreviewWidget::setDisplayStretch ( int mode )
+{
+  // picked up by reduceTo8Bit() on the next frame so the LUT is only ever
+  // touched from the callback thread
+  stretchMode = mode;
+}
+
+
 // FIX ME -- could combine this with beginRecording() ?
 void
 PreviewWidget::setFirstFrameTime ( void )
@@ -537,8 +553,17 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
     if ( self->flipX || self->flipY ) {
 			int axis = ( self->flipX ? OA_FLIP_X : 0 ) | ( self->flipY ?
 					OA_FLIP_Y : 0 );
-      oaFlipImage ( previewBuffer, commonConfig.imageSizeX,
-					commonConfig.imageSizeY, previewPixelFormat, axis );
+			oaImage source, target;
+			currentPreviewBuffer = NEXT_FREE_BUFFER ( currentPreviewBuffer );
+			oaImageInit ( &source, previewBuffer, commonConfig.imageSizeX,
+					commonConfig.imageSizeY, previewPixelFormat );
+			oaImageInit ( &target, self->previewImageBuffer[ currentPreviewBuffer ],
+					commonConfig.imageSizeX, commonConfig.imageSizeY,
+					previewPixelFormat );
+      if ( !oaFlipImageCopy ( &source, &target, axis )) {
+				previewBuffer = self->previewImageBuffer [ currentPreviewBuffer ];
+				previewPixelFormat = target.format;
+			}
     }
   } else {
 
@@ -562,48 +587,92 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
 
     // do a vertical/horizontal flip if required
     if ( self->flipX || self->flipY ) {
-      // this is going to make a mess for data we intend to demosaic.
-      // the user will have to deal with that
+      // raw colour frames have their format adjusted to match the new
+      // position of the CFA pattern.  That can't happen to raw frames
+      // being recorded though, as the output was opened with the camera's
+      // pattern, so those are written as they are and only the preview
+      // is flipped
 			int axis = ( self->flipX ? OA_FLIP_X : 0 ) | ( self->flipY ?
 					OA_FLIP_Y : 0 );
-			if ( -1 == currentWriteBuffer ) {
-				( void ) memcpy ( self->writeImageBuffer[0], writeBuffer, length );
-				currentWriteBuffer = 0;
+			int flipWrite = !( self->recordingInProgress &&
+					oaFrameFormats[ writePixelFormat ].rawColour &&
+					!demosaicConf.demosaicOutput );
+			oaImage source, target;
+			oaImageInit ( &source, writeBuffer, commonConfig.imageSizeX,
+					commonConfig.imageSizeY, writePixelFormat );
+			if ( flipWrite ) {
+				currentWriteBuffer = NEXT_FREE_BUFFER ( currentWriteBuffer );
+				oaImageInit ( &target, self->writeImageBuffer[ currentWriteBuffer ],
+						commonConfig.imageSizeX, commonConfig.imageSizeY,
+						writePixelFormat );
+				// flip straight from the frame into the write buffer
+				if ( oaFlipImageCopy ( &source, &target, axis )) {
+					( void ) memcpy ( self->writeImageBuffer[ currentWriteBuffer ],
+							writeBuffer, length );
+				} else {
+					previewPixelFormat = writePixelFormat = target.format;
+				}
+				// both preview and write will come from this buffer for the
+				// time being.  This may change later on
+				previewBuffer = self->writeImageBuffer[ currentWriteBuffer ];
+				writeBuffer = self->writeImageBuffer[ currentWriteBuffer ];
 			} else {
-				currentWriteBuffer = !currentWriteBuffer;
+				currentPreviewBuffer = NEXT_FREE_BUFFER ( currentPreviewBuffer );
+				oaImageInit ( &target,
+						self->previewImageBuffer[ currentPreviewBuffer ],
+						commonConfig.imageSizeX, commonConfig.imageSizeY,
+						writePixelFormat );
+				if ( !oaFlipImageCopy ( &source, &target, axis )) {
+					previewBuffer = self->previewImageBuffer[ currentPreviewBuffer ];
+					previewPixelFormat = target.format;
+				}
 			}
-			// this is an in-place flip
-      oaFlipImage ( self->writeImageBuffer[ currentWriteBuffer ],
-					commonConfig.imageSizeX, commonConfig.imageSizeY, writePixelFormat,
-					axis );
-      // both preview and write will come from this buffer for the
-      // time being.  This may change later on
-      previewBuffer = self->writeImageBuffer[ currentWriteBuffer ];
-      writeBuffer = self->writeImageBuffer[ currentWriteBuffer ];
     }
   }
 
-  if (( !oaFrameFormats[ previewPixelFormat ].fullColour &&
+  ( void ) gettimeofday ( &t, 0 );
+  unsigned long now = static_cast<unsigned long>( t.tv_sec ) * 1000 +
+      static_cast<unsigned long>( t.tv_usec ) / 1000;
+
+  OutputHandler* output = nullptr;
+  if ( !state->pauseEnabled ) {
+    // This should be thread-safe
+    output = state->captureWidget->getOutputHandler();
+  }
+
+  int reduce = ( !oaFrameFormats[ previewPixelFormat ].fullColour &&
       oaFrameFormats[ previewPixelFormat ].bytesPerPixel > 1 ) ||
       ( oaFrameFormats[ previewPixelFormat ].fullColour &&
-      oaFrameFormats[ previewPixelFormat ].bytesPerPixel > 3 )) {
+      oaFrameFormats[ previewPixelFormat ].bytesPerPixel > 3 );
+
+  // One set of statistics for the frame serves the auto stretch, the
+  // histogram and the FITS header.  The FITS header needs every pixel
+  // counted, the others only a sample of them
+  int autoStretch = reduce && OA_STRETCH_AUTO == self->stretchMode;
+  int histogramDue = state->histogramOn &&
+      now - self->fpsCalcPeriodStartTime > 1000;
+  int fullStats = output && self->recordingInProgress &&
+      output->usesFrameStats;
+  const oaFrameStats* stats = nullptr;
+  if ( autoStretch || histogramDue || fullStats ) {
+    stats = self->computeFrameStats ( writeBuffer, writePixelFormat,
+        autoStretch, fullStats );
+  }
+  const oaFrameStats* writeStats = fullStats ? stats : nullptr;
+  // Once the frame being written has been cropped or demosaiced the
+  // statistics no longer describe it, so neither the FITS header nor the
+  // histogram (which shows the written frame) can use them
+  int statsMatchWrite = 1;
+
+  if ( reduce ) {
     currentPreviewBuffer = NEXT_FREE_BUFFER (  currentPreviewBuffer );
-		// FIX ME -- this would surely be more efficient if it weren't done
-		// in place and the reduction used to effect the memcpy?
-    ( void ) memcpy ( self->previewImageBuffer[ currentPreviewBuffer ],
-        previewBuffer, length );
-    // Do this reduction "in place"
-    previewPixelFormat = self->reduceTo8Bit (
+    previewPixelFormat = self->reduceTo8Bit ( previewBuffer,
         self->previewImageBuffer[ currentPreviewBuffer ],
-        self->previewImageBuffer[ currentPreviewBuffer ],
-        commonConfig.imageSizeX, commonConfig.imageSizeY, previewPixelFormat );
+        commonConfig.imageSizeX, commonConfig.imageSizeY, previewPixelFormat,
+        stats );
     previewBuffer = self->previewImageBuffer [ currentPreviewBuffer ];
   }
 
-  ( void ) gettimeofday ( &t, 0 );
-  unsigned long now = static_cast<unsigned long>( t.tv_sec ) * 1000 +
-      static_cast<unsigned long>( t.tv_usec ) / 1000;
-
   int cfaPattern = demosaicConf.cfaPattern;
   if ( OA_DEMOSAIC_AUTO == cfaPattern &&
       oaFrameFormats[ previewPixelFormat ].rawColour ) {
@@ -707,13 +776,10 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
     }
   }
 
-  OutputHandler* output = nullptr;
   int actualX, actualY;
   actualX = commonConfig.imageSizeX;
   actualY = commonConfig.imageSizeY;
   if ( !state->pauseEnabled ) {
-    // This should be thread-safe
-    output = state->captureWidget->getOutputHandler();
     if ( output && self->recordingInProgress ) {
       if ( self->setNewFirstFrameTime ) {
         state->firstFrameTime = now;
@@ -738,6 +804,7 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
         actualY = commonState->cropSizeY;
         length = actualX * actualY *
             oaFrameFormats[ pixelFormat ].bytesPerPixel;
+        statsMatchWrite = 0;
       }
       if ( demosaicConf.demosaicOutput &&
           oaFrameFormats[ writePixelFormat ].rawColour ) {
@@ -759,6 +826,7 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
           writeBuffer = self->previewImageBuffer[0];
         }
         writePixelFormat = OA_DEMOSAIC_FMT ( writePixelFormat );
+        statsMatchWrite = 0;
       }
       // These calls should be thread-safe
 			TIMER_METADATA	timerData;
@@ -781,14 +849,27 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
         comment = commentStr;
         ( void ) snprintf ( comment, 64, "Timer frame index: %d\n", ts->index );
       } else {
-				QDateTime now = QDateTime::currentDateTimeUtc();
-				// QString dateStr = now.toString ( Qt::ISODate );
-				QString dateStr = now.toString ( "yyyy-MM-ddThh:mm:ss.zzz" );
+				QDateTime frameTime = QDateTime::currentDateTimeUtc();
+				FRAME_METADATA* frameData = static_cast<FRAME_METADATA*>( metadata );
+				if ( frameData && frameData->sequence ) {
+					// Backdate to when the driver dequeued the frame so the time
+					// it spent queued for us doesn't end up in the timestamp
+					struct timespec mono;
+					( void ) clock_gettime ( CLOCK_MONOTONIC, &mono );
+					int64_t queued = ( int64_t )( mono.tv_sec * 1000000000ULL +
+							mono.tv_nsec - frameData->timestamp ) / 1000000;
+					if ( queued > 0 ) {
+						frameTime = frameTime.addMSecs ( -queued );
+					}
+				}
+				// QString dateStr = frameTime.toString ( Qt::ISODate );
+				QString dateStr = frameTime.toString ( "yyyy-MM-ddThh:mm:ss.zzz" );
 				( void ) strncpy ( timestampStr,
 						dateStr.toStdString().c_str(), sizeof ( timestampStr ) - 1);
         timestamp = timestampStr;
         comment = nullptr;
       }
+      output->setFrameStats ( statsMatchWrite ? writeStats : nullptr );
       if ( output->addFrame ( writeBuffer, timestamp,
           // This call should be thread-safe
           state->controlWidget->getCurrentExposure(), comment,
@@ -819,8 +900,12 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
 
     if ( state->histogramOn ) {
       // This call should be thread-safe
-      state->histogramWidget->process ( writeBuffer, actualX, actualY,
-          length, writePixelFormat );
+      if ( stats && statsMatchWrite ) {
+        state->histogramWidget->process ( stats );
+      } else {
+        state->histogramWidget->process ( writeBuffer, actualX, actualY,
+            length, writePixelFormat );
+      }
       doHistogram = 1;
     }
   }
@@ -908,75 +993,70 @@ PreviewWidget::updatePreview ( void* args, void* imageData, int length,
 
 unsigned int
 PreviewWidget::reduceTo8Bit ( void* sourceData, void* targetData, int xSize,
-    int ySize, int format )
+    int ySize, int format, const oaFrameStats* stats )
 {
-  int	outputFormat = 0;
-
-  if ( oaFrameFormats[ format ].monochrome ) {
-    outputFormat = OA_PIX_FMT_GREY8;
-  } else {
-    if ( oaFrameFormats[ format ].rawColour &&
-        !oaFrameFormats[ format ].packed ) {
-      switch ( oaFrameFormats[ format ].cfaPattern ) {
-        case OA_DEMOSAIC_RGGB:
-          outputFormat = OA_PIX_FMT_RGGB8;
-          break;
-        case OA_DEMOSAIC_BGGR:
-          outputFormat = OA_PIX_FMT_BGGR8;
-          break;
-        case OA_DEMOSAIC_GRBG:
-          outputFormat = OA_PIX_FMT_GRBG8;
-          break;
-        case OA_DEMOSAIC_GBRG:
-          outputFormat = OA_PIX_FMT_GBRG8;
-          break;
-        case OA_DEMOSAIC_CMYG:
-          outputFormat = OA_PIX_FMT_CMYG8;
-          break;
-        case OA_DEMOSAIC_MCGY:
-          outputFormat = OA_PIX_FMT_MCGY8;
-          break;
-        case OA_DEMOSAIC_YGCM:
-          outputFormat = OA_PIX_FMT_YGCM8;
-          break;
-        case OA_DEMOSAIC_GYMC:
-          outputFormat = OA_PIX_FMT_GYMC8;
-          break;
-      }
-    } else {
-      switch ( format ) {
-        case OA_PIX_FMT_RGB30BE:
-        case OA_PIX_FMT_RGB30LE:
-        case OA_PIX_FMT_RGB36BE:
-        case OA_PIX_FMT_RGB36LE:
-        case OA_PIX_FMT_RGB42BE:
-        case OA_PIX_FMT_RGB42LE:
-        case OA_PIX_FMT_RGB48BE:
-        case OA_PIX_FMT_RGB48LE:
-          outputFormat = OA_PIX_FMT_RGB24;
-          break;
-        case OA_PIX_FMT_BGR48BE:
-        case OA_PIX_FMT_BGR48LE:
-          outputFormat = OA_PIX_FMT_BGR24;
-          break;
-      }
-    }
+  int			outputFormat;
+  int			mode = stretchMode;
+  oaStretchParams	params;
+
+  if ( stretch->params.mode != mode ) {
+    oaStretchDefaultParams ( &params );
+    params.mode = mode;
+    oaStretchSetParams ( stretch, &params );
+  }
+  if ( OA_STRETCH_AUTO == mode && stats && stats->medianValid ) {
+    oaStretchSetStatistics ( stretch, stats->all.median, stats->all.mad );
   }
 
-  if ( outputFormat ) {
-    if ( oaconvert ( sourceData, targetData, xSize, ySize, format,
-        outputFormat ) < 0 ) {
-      qWarning() << "Unable to convert format" << format << "to format" <<
-          outputFormat;
-    }
-  } else {
-      qWarning() << "Can't handle 8-bit reduction of format" << format;
+  // Stretch through a LUT scaled to the bit depth of the format rather
+  // than just dropping the low byte, so 10- and 12-bit frames are visible
+  if (( outputFormat = oaStretchFrame ( stretch, sourceData, targetData,
+      xSize, ySize, format )) < 0 ) {
+    qWarning() << "Can't handle 8-bit reduction of format" << format;
+    return 0;
   }
 
   return outputFormat;
 }
 
 
+/*
+ * Compute the statistics for a frame that the histogram, auto stretch
+ * and FITS output share, with the median if it's wanted for the auto
+ * stretch and every pixel counted if it's wanted for the FITS header.
+ * Returns nullptr for formats the statistics can't be computed for.
+ */
+
+const oaFrameStats*
+PreviewWidget::computeFrameStats ( void* data, int format, int median,
+    int fullFrame )
+{
+  oaImage	image;
+  unsigned int	subsample = 1;
+  int		flags = HistogramWidget::statsFlags();
+
+  // The histogram has its own fallback for formats like these
+  if ( !frameStats || oaFrameFormats[ format ].lumChrom ||
+      oaFrameFormats[ format ].packed || oaFrameFormats[ format ].planar ||
+      oaFrameFormats[ format ].hasAlpha ) {
+    return nullptr;
+  }
+  if ( median ) {
+    flags |= OA_STATS_MEDIAN;
+  }
+  if ( !fullFrame ) {
+    subsample = HistogramWidget::statsSubsample ( commonConfig.imageSizeX,
+        commonConfig.imageSizeY );
+  }
+  if ( oaImageInit ( &image, data, commonConfig.imageSizeX,
+      commonConfig.imageSizeY, format ) ||
+      oaFrameStatsCompute ( frameStats, &image, 256, subsample, flags )) {
+    return nullptr;
+  }
+  return frameStats;
+}
+
+
 const char*
 PreviewWidget::getTimerResultCode ( void )
 {
@@ -39,6 +39,8 @@ extern "C" {
 #include <pthread.h>
 
 #include <openastro/camera.h>
+#include <openastro/imgproc.h>
+#include <openastro/video/stretch.h>
 }
 
 #include "configuration.h"
@@ -62,6 +64,7 @@ class PreviewWidget : public QFrame
     void		enableDemosaic ( int );
     void		enableScreenUpdates ( int );
     void		setDisplayFPS ( int );
+    void		setDisplayStretch ( int );
     static void*	updatePreview ( void*, void*, int, void* );
     void		setFirstFrameTime ( void );
     void		beginRecording ( void );
@@ -125,7 +128,12 @@ class PreviewWidget : public QFrame
     int			focusScore;
 		char		lastTimerResultCode[64];
 
-    unsigned int	reduceTo8Bit ( void*, void*, int, int, int );
+    unsigned int	reduceTo8Bit ( void*, void*, int, int, int,
+			    const oaFrameStats* );
+    const oaFrameStats*	computeFrameStats ( void*, int, int, int );
+    oaStretch*		stretch;
+    int			stretchMode;
+    oaFrameStats*	frameStats;
     void		mousePressEvent ( QMouseEvent* );
     void		mouseMoveEvent ( QMouseEvent* );
     void		mouseReleaseEvent ( QMouseEvent* );
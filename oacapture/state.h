@@ -37,6 +37,8 @@
 #include "settingsWidget.h"
 #include "focusOverlay.h"
 #include "advancedSettings.h"
+#include "threadSettings.h"
+#include "cameraDiagnostics.h"
 #include "occultationWidget.h"
 
 
@@ -55,6 +57,8 @@ typedef struct
   HistogramWidget*	histogramWidget;
   SettingsWidget*	settingsWidget;
   AdvancedSettings*	advancedSettings;
+  ThreadSettings*	threadSettings;
+  CameraDiagnostics*	cameraDiagnostics;
   FocusOverlay*		focusOverlay;
 
   int			autorunEnabled;
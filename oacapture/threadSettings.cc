@@ -0,0 +1,208 @@
+/*****************************************************************************
+ *
+ * threadSettings.cc -- scheduling settings for camera threads
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#include <oa_common.h>
+
+#include <QtGui>
+
+#include "configuration.h"
+#include "threadSettings.h"
+
+
+ThreadSettings::ThreadSettings ( QWidget* parent ) : QWidget ( parent,
+		Qt::Window )
+{
+  QStringList	roles, schedulers;
+
+  roles << tr ( "Controller" ) << tr ( "Callback" ) << tr ( "Timer" ) <<
+      tr ( "USB events" );
+  schedulers << tr ( "Default" ) << tr ( "FIFO" ) << tr ( "Round robin" );
+
+  setWindowTitle ( tr ( "Camera Thread Settings" ));
+
+  grid = new QGridLayout();
+  grid->addWidget ( new QLabel ( tr ( "Thread" ), this ), 0, 0 );
+  grid->addWidget ( new QLabel ( tr ( "CPUs" ), this ), 0, 1 );
+  grid->addWidget ( new QLabel ( tr ( "Scheduler" ), this ), 0, 2 );
+  grid->addWidget ( new QLabel ( tr ( "Priority" ), this ), 0, 3 );
+  grid->addWidget ( new QLabel ( tr ( "Name" ), this ), 0, 4 );
+
+  for ( int i = 0; i < OA_CAM_THREAD_ROLES; i++ ) {
+    grid->addWidget ( new QLabel ( roles[i], this ), i+1, 0 );
+
+    cpuInput[i] = new QLineEdit ( this );
+    cpuInput[i]->setPlaceholderText ( tr ( "any" ));
+    cpuInput[i]->setToolTip ( tr ( "CPU numbers, eg. 2,3 or 4-7" ));
+    cpuInput[i]->setText ( cpuMaskToString ( config.threadPolicy[i].cpuMask ));
+    grid->addWidget ( cpuInput[i], i+1, 1 );
+
+    schedulerMenu[i] = new QComboBox ( this );
+    schedulerMenu[i]->addItems ( schedulers );
+    schedulerMenu[i]->setCurrentIndex ( config.threadPolicy[i].scheduler );
+    grid->addWidget ( schedulerMenu[i], i+1, 2 );
+
+    priorityInput[i] = new QSpinBox ( this );
+    priorityInput[i]->setRange ( 1, 99 );
+    priorityInput[i]->setValue ( config.threadPolicy[i].priority ?
+        config.threadPolicy[i].priority : 50 );
+    priorityInput[i]->setEnabled ( config.threadPolicy[i].scheduler !=
+        OA_THREAD_SCHED_DEFAULT );
+    grid->addWidget ( priorityInput[i], i+1, 3 );
+
+    nameInput[i] = new QLineEdit ( this );
+    nameInput[i]->setMaxLength ( OA_THREAD_NAME_LEN );
+    nameInput[i]->setText ( config.threadPolicy[i].name );
+    grid->addWidget ( nameInput[i], i+1, 4 );
+
+    connect ( cpuInput[i], SIGNAL( textEdited ( const QString& )), this,
+        SLOT ( settingsChanged()));
+    connect ( schedulerMenu[i], SIGNAL( currentIndexChanged ( int )), this,
+        SLOT ( settingsChanged()));
+    connect ( priorityInput[i], SIGNAL( valueChanged ( int )), this,
+        SLOT ( settingsChanged()));
+    connect ( nameInput[i], SIGNAL( textEdited ( const QString& )), this,
+        SLOT ( settingsChanged()));
+  }
+
+  note = new QLabel ( tr ( "Changes take effect when a camera is next "
+      "connected.  Real-time scheduling needs suitable privileges (eg. "
+      "an rtprio limit) and is otherwise ignored." ), this );
+  note->setWordWrap ( true );
+
+  closeButton = new QPushButton ( tr ( "Close" ), this );
+  connect ( closeButton, SIGNAL( clicked()), this, SLOT( close()));
+  saveButton = new QPushButton ( tr ( "Save" ), this );
+  saveButton->setEnabled ( 0 );
+  connect ( saveButton, SIGNAL( clicked()), this, SLOT ( saveSettings()));
+
+  buttonBox = new QHBoxLayout();
+  buttonBox->addStretch ( 1 );
+  buttonBox->addWidget ( closeButton );
+  buttonBox->addWidget ( saveButton );
+
+  vbox = new QVBoxLayout();
+  vbox->addLayout ( grid );
+  vbox->addWidget ( note );
+  vbox->addStretch ( 1 );
+  vbox->addLayout ( buttonBox );
+  setLayout ( vbox );
+}
+
+
+ThreadSettings::~ThreadSettings()
+{
+  // FIX ME -- delete widgets
+}
+
+
+void
+ThreadSettings::settingsChanged ( void )
+{
+  uint64_t	mask;
+  int		valid = 1;
+
+  for ( int i = 0; i < OA_CAM_THREAD_ROLES; i++ ) {
+    priorityInput[i]->setEnabled ( schedulerMenu[i]->currentIndex() !=
+        OA_THREAD_SCHED_DEFAULT );
+    if ( stringToCPUMask ( cpuInput[i]->text(), &mask ) < 0 ) {
+      valid = 0;
+    }
+  }
+  saveButton->setEnabled ( valid );
+}
+
+
+void
+ThreadSettings::saveSettings ( void )
+{
+  oaCameraThreadPolicy	policy;
+
+  for ( int i = 0; i < OA_CAM_THREAD_ROLES; i++ ) {
+    ( void ) stringToCPUMask ( cpuInput[i]->text(), &policy.cpuMask );
+    policy.scheduler = schedulerMenu[i]->currentIndex();
+    policy.priority = priorityInput[i]->value();
+    ( void ) strncpy ( policy.name,
+        nameInput[i]->text().toStdString().c_str(), OA_THREAD_NAME_LEN );
+    policy.name[ OA_THREAD_NAME_LEN ] = 0;
+    config.threadPolicy[i] = policy;
+    ( void ) oaSetCameraThreadPolicy ( i, &policy );
+  }
+  saveButton->setEnabled ( 0 );
+}
+
+
+QString
+ThreadSettings::cpuMaskToString ( uint64_t mask )
+{
+  QStringList	cpus;
+  int		first, last;
+
+  for ( first = 0; first < 64; first = last + 1 ) {
+    if (!( mask & (( uint64_t ) 1 << first ))) {
+      last = first;
+      continue;
+    }
+    for ( last = first; last < 63 && ( mask & (( uint64_t ) 1 << ( last + 1 )));
+        last++ );
+    if ( last == first ) {
+      cpus.append ( QString::number ( first ));
+    } else {
+      cpus.append ( QString ( "%1-%2" ).arg ( first ).arg ( last ));
+    }
+  }
+  return cpus.join ( "," );
+}
+
+
+int
+ThreadSettings::stringToCPUMask ( const QString& str, uint64_t* mask )
+{
+  QStringList	ranges = str.split ( "," );
+  int		first, last;
+  bool		ok1, ok2;
+
+  *mask = 0;
+  for ( int i = 0; i < ranges.count(); i++ ) {
+    if ( ranges[i].trimmed().isEmpty()) {
+      continue;
+    }
+    QStringList	ends = ranges[i].trimmed().split ( "-" );
+    first = last = ends[0].toInt ( &ok1 );
+    ok2 = true;
+    if ( ends.count() == 2 ) {
+      last = ends[1].toInt ( &ok2 );
+    }
+    if ( !ok1 || !ok2 || ends.count() > 2 || first < 0 || last > 63 ||
+        first > last ) {
+      *mask = 0;
+      return -1;
+    }
+    for ( ; first <= last; first++ ) {
+      *mask |= ( uint64_t ) 1 << first;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *
+ * threadSettings.h -- class declaration
+ *
+ * Copyright 2026 James Fidell (james@openastroproject.org)
+ *
+ * License:
+ *
+ * This file is part of the Open Astro Project.
+ *
+ * The Open Astro Project is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * The Open Astro Project is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with the Open Astro Project.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <oa_common.h>
+
+#include <QtGlobal>
+#if QT_VERSION >= 0x050000
+#include <QtWidgets>
+#endif
+#include <QtCore>
+#include <QtGui>
+
+extern "C" {
+#include <openastro/camera.h>
+}
+
+
+class ThreadSettings : public QWidget
+{
+  Q_OBJECT
+
+  public:
+    			ThreadSettings ( QWidget* );
+    			~ThreadSettings();
+
+    static QString	cpuMaskToString ( uint64_t );
+    static int		stringToCPUMask ( const QString&, uint64_t* );
+
+  private:
+    QGridLayout*	grid;
+    QVBoxLayout*	vbox;
+    QHBoxLayout*	buttonBox;
+    QLabel*		note;
+    QPushButton*	closeButton;
+    QPushButton*	saveButton;
+    QLineEdit*		cpuInput[ OA_CAM_THREAD_ROLES ];
+    QComboBox*		schedulerMenu[ OA_CAM_THREAD_ROLES ];
+    QSpinBox*		priorityInput[ OA_CAM_THREAD_ROLES ];
+    QLineEdit*		nameInput[ OA_CAM_THREAD_ROLES ];
+
+  public slots:
+    void		settingsChanged ( void );
+    void		saveSettings ( void );
+};
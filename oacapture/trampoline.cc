@@ -215,6 +215,13 @@ t_setDisplayFPS ( int num )
 }
 
 
+void
+t_setDisplayStretch ( int mode )
+{
+  state.previewWidget->setDisplayStretch ( mode );
+}
+
+
 void
 t_enableTIFFCapture ( int val )
 { 
@@ -371,6 +378,7 @@ trampolineFuncs trampolines = {
   t_reloadProfiles,
   t_resetTemperatureLabel,
   t_setDisplayFPS,
+  t_setDisplayStretch,
   t_enableTIFFCapture,
   t_enableMOVCapture,
   t_enablePNGCapture,
@@ -906,7 +906,7 @@ CameraControls::updateSliderControl ( int control )
 	}
   cameraConf.CONTROL_VALUE( control ) = value;
   SET_PROFILE_CONTROL( control, value );
-  commonState.camera->setControl ( control, value );
+  commonState.camera->setControlAsync ( control, value );
 }
 
 
@@ -1378,7 +1378,8 @@ CameraControls::setBatteryLevel ( void )
 
   if ( controlType[OA_CAM_CTRL_MODIFIER_STD][ OA_CAM_CTRL_BATTERY_LEVEL ] ==
 			OA_CTRL_TYPE_READONLY ) {
-		v = commonState.camera->readControl ( OA_CAM_CTRL_BATTERY_LEVEL );
+		v = commonState.camera->readCachedControl (
+				OA_CAM_CTRL_BATTERY_LEVEL );
 		batteryLevel->setValue ( v );
 	}
 }
@@ -35,6 +35,7 @@ extern "C" {
 
 #include <openastro/filterwheel.h>
 #include <openastro/demosaic.h>
+#include <openastro/video/stretch.h>
 }
 
 #include "commonState.h"
@@ -387,6 +388,7 @@ MainWindow::readConfig ( QString configFile )
 
     generalConf.tempsInC = 1;
     generalConf.reticleStyle = 1;
+    generalConf.displayStretch = OA_STRETCH_AUTO;
 #ifdef OACAPTURE
     config.displayFPS = 15;
 
@@ -668,6 +670,8 @@ MainWindow::readConfig ( QString configFile )
 
     generalConf.reticleStyle = settings->value ( "reticle/style",
         RETICLE_CIRCLE ).toInt();
+    generalConf.displayStretch = settings->value ( "display/stretch",
+        OA_STRETCH_AUTO ).toInt();
 
     // Give up on earlier versions of this data.  It's too complicated to
     // sort out
@@ -1199,6 +1203,7 @@ MainWindow::writeConfig ( QString configFile )
   settings->setValue ( "demosaic/cfaPattern", demosaicConf.cfaPattern );
 
   settings->setValue ( "reticle/style", generalConf.reticleStyle );
+  settings->setValue ( "display/stretch", generalConf.displayStretch );
 
   settings->beginWriteArray ( "controls" );
   for ( int i = 1; i < OA_CAM_CTRL_LAST_P1; i++ ) {
@@ -30,7 +30,9 @@
 #include <QApplication>
 
 extern "C" {
+#include <openastro/camera.h>
 #include <openastro/util.h>
+#include <openastro/video.h>
 }
 
 #include "captureSettings.h"
@@ -121,6 +123,22 @@ main ( int argc, char* argv[] )
 		QCoreApplication::translate ( "main", "filename" ), "-" );
 	parser.addOption ( debugLogOption );
 
+	QCommandLineOption replayOption ( "replay",
+		QCoreApplication::translate ( "main",
+			"Offer a SER file or FITS/PNG directory as a camera" ),
+		QCoreApplication::translate ( "main", "path" ));
+	parser.addOption ( replayOption );
+
+	QCommandLineOption replayMaxRateOption ( "replay-max-rate",
+		QCoreApplication::translate ( "main",
+			"Replay frames as fast as possible rather than as recorded" ));
+	parser.addOption ( replayMaxRateOption );
+
+	QCommandLineOption replayLoopOption ( "replay-loop",
+		QCoreApplication::translate ( "main",
+			"Restart replayed recordings when they finish" ));
+	parser.addOption ( replayLoopOption );
+
 	// Process the actual command line arguments given by the user
 	parser.process ( app );
 
@@ -163,6 +181,17 @@ main ( int argc, char* argv[] )
 	configFile = parser.value ( configFileOption );
 	debugLog = parser.value ( debugLogOption );
 
+	QStringList replaySources = parser.values ( replayOption );
+	for ( j = 0; j < replaySources.size(); j++ ) {
+		if ( oaAddReplaySource ( replaySources[j].toStdString().c_str()) !=
+				OA_ERR_NONE ) {
+			qWarning() << "Cannot replay: " << replaySources[j];
+		}
+	}
+	( void ) oaSetReplayOptions (
+			( parser.isSet ( replayMaxRateOption ) ? OA_REPLAY_MAX_RATE : 0 ) |
+			( parser.isSet ( replayLoopOption ) ? OA_REPLAY_LOOP : 0 ), 0 );
+
 #else
 
   // FIX ME -- This all a bit cack-handed.  Find a better way to do it when
@@ -208,6 +237,9 @@ main ( int argc, char* argv[] )
 		exit ( 1 );
 	}
 
+	// Large frames are converted and flipped using all available CPUs
+	( void ) oaSetVideoThreads ( 0 );
+
   MainWindow mainWindow ( configFile );
   mainWindow.show();
 
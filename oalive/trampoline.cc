@@ -221,6 +221,13 @@ t_setDisplayFPS ( int num )
 }
 
 
+void
+t_setDisplayStretch ( int mode )
+{
+	state.viewWidget->setDisplayStretch ( mode );
+}
+
+
 void
 t_enableTIFFCapture ( int val __attribute__((unused)))
 {
@@ -352,6 +359,7 @@ trampolineFuncs trampolines = {
 	t_reloadProfiles,
 	t_resetTemperatureLabel,
 	t_setDisplayFPS,
+	t_setDisplayStretch,
 	t_enableTIFFCapture,
 	t_enableMOVCapture,
 	t_enablePNGCapture,
@@ -45,6 +45,7 @@ extern "C" {
 #include <openastro/video.h>
 #include <openastro/imgproc.h>
 #include <openastro/video/formats.h>
+#include <openastro/video/stretch.h>
 }
 
 #include "commonState.h"
@@ -87,6 +88,9 @@ ViewWidget::ViewWidget ( QWidget* parent ) : QFrame ( parent )
 	rgbBufferSize = 0;
 	abortProcessing = 0;
 	secondForFrameCount = 0;
+	stretchMode = generalConf.displayStretch;
+	stretch = oaStretchCreate ( 0 );
+	frameStats = oaFrameStatsCreate();
 
   int r = config.currentColouriseColour.red();
   int g = config.currentColouriseColour.green();
@@ -169,6 +173,9 @@ ViewWidget::~ViewWidget()
 	if ( rgbBuffer ) {
 		free ( static_cast<void*>( rgbBuffer ));
 	}
+
+	oaStretchDestroy ( stretch );
+	oaFrameStatsDestroy ( frameStats );
 }
 
 
@@ -433,6 +440,15 @@ ViewWidget::setDisplayFPS ( int fps )
 }
 
 
+void
+ViewWidget::setDisplayStretch ( int mode )
+{
+  // picked up by reduceTo8Bit() on the next frame so the LUT is only ever
+  // touched from the callback thread
+  stretchMode = mode;
+}
+
+
 void
 ViewWidget::setMonoPalette ( QColor colour )
 {
@@ -553,8 +569,18 @@ ViewWidget::addImage ( void* args, void* imageData, int length, void* metadata )
     if ( self->flipX || self->flipY ) {
 			int axis = ( self->flipX ? OA_FLIP_X : 0 ) | ( self->flipY ?
 					OA_FLIP_Y : 0 );
-      oaFlipImage ( self->viewBuffer, commonConfig.imageSizeX,
-					commonConfig.imageSizeY, self->viewPixelFormat, axis );
+			oaImage source, target;
+			self->currentViewBuffer = NEXT_FREE_BUFFER ( self->currentViewBuffer );
+			oaImageInit ( &source, self->viewBuffer, commonConfig.imageSizeX,
+					commonConfig.imageSizeY, self->viewPixelFormat );
+			oaImageInit ( &target,
+					self->viewImageBuffer[ self->currentViewBuffer ],
+					commonConfig.imageSizeX, commonConfig.imageSizeY,
+					self->viewPixelFormat );
+      if ( !oaFlipImageCopy ( &source, &target, axis )) {
+				self->viewBuffer = self->viewImageBuffer [ self->currentViewBuffer ];
+				self->viewPixelFormat = target.format;
+			}
     }
   } else {
 
@@ -578,24 +604,27 @@ ViewWidget::addImage ( void* args, void* imageData, int length, void* metadata )
 
     // do a vertical/horizontal flip if required
     if ( self->flipX || self->flipY ) {
-      // this is going to make a mess for data we intend to demosaic.
-      // the user will have to deal with that
+      // raw colour frames have their format adjusted to match the new
+      // position of the CFA pattern.  Only the view takes the flipped
+      // format: it is what gets demosaicked and saved, whereas the write
+      // buffer keeps the frame and format as the camera sent them
 			int axis = ( self->flipX ? OA_FLIP_X : 0 ) | ( self->flipY ?
 					OA_FLIP_Y : 0 );
-			if ( -1 == self->currentWriteBuffer ) {
-				( void ) memcpy ( self->writeImageBuffer[0], writeBuffer, length );
-				self->currentWriteBuffer = 0;
+			oaImage source, target;
+			self->currentWriteBuffer = NEXT_FREE_BUFFER ( self->currentWriteBuffer );
+			oaImageInit ( &source, writeBuffer, commonConfig.imageSizeX,
+					commonConfig.imageSizeY, writePixelFormat );
+			oaImageInit ( &target,
+					self->writeImageBuffer[ self->currentWriteBuffer ],
+					commonConfig.imageSizeX, commonConfig.imageSizeY, writePixelFormat );
+			// flip straight from the frame into the spare write buffer
+      if ( oaFlipImageCopy ( &source, &target, axis )) {
+				( void ) memcpy ( self->writeImageBuffer[ self->currentWriteBuffer ],
+						writeBuffer, length );
 			} else {
-				self->currentWriteBuffer = !self->currentWriteBuffer;
+				self->viewPixelFormat = target.format;
 			}
-			// this is an in-place flip
-      oaFlipImage ( self->writeImageBuffer[ self->currentWriteBuffer ],
-					commonConfig.imageSizeX, commonConfig.imageSizeY, writePixelFormat,
-					axis );
-      // both preview and write will come from this buffer for the
-      // time being.  This may change later on
       self->viewBuffer = self->writeImageBuffer[ self->currentWriteBuffer ];
-      writeBuffer = self->writeImageBuffer[ self->currentWriteBuffer ];
     }
   }
 
@@ -654,7 +683,28 @@ ViewWidget::addImage ( void* args, void* imageData, int length, void* metadata )
 	}
 
   outputFrame = state->controlsWidget->getFrameOutputHandler();
+  outputProcessed = state->controlsWidget->getProcessedOutputHandler();
+
+  // Both outputs write this frame, and without stacking it's also what
+  // gets stretched for display, so one set of statistics can serve them
+  // all.  The FITS header needs every pixel counted.  The histogram is
+  // of the processed display image, so it computes its own.
+  int autoStretch = OA_STACK_NONE == state->stackingMethod &&
+      OA_STRETCH_AUTO == self->stretchMode &&
+      (( !oaFrameFormats[ self->viewPixelFormat ].fullColour &&
+      oaFrameFormats[ self->viewPixelFormat ].bytesPerPixel > 1 ) ||
+      ( oaFrameFormats[ self->viewPixelFormat ].fullColour &&
+      oaFrameFormats[ self->viewPixelFormat ].bytesPerPixel > 3 ));
+  int fullStats = ( outputFrame && outputFrame->usesFrameStats ) ||
+      ( outputProcessed && outputProcessed->usesFrameStats );
+  const oaFrameStats* stats = nullptr;
+  if ( autoStretch || fullStats ) {
+    stats = self->computeFrameStats ( self->viewBuffer, self->viewPixelFormat,
+        autoStretch, fullStats );
+  }
+
   if ( outputFrame ) {
+    outputFrame->setFrameStats ( fullStats ? stats : nullptr );
 		QDateTime now = QDateTime::currentDateTimeUtc();
 		// QString dateStr = now.toString ( Qt::ISODate );
 		QString dateStr = now.toString ( "yyyy-MM-ddThh:mm:ss.zzz" );
@@ -721,8 +771,8 @@ ViewWidget::addImage ( void* args, void* imageData, int length, void* metadata )
 			break;
 	}
 
-  outputProcessed = state->controlsWidget->getProcessedOutputHandler();
   if ( outputProcessed ) {
+    outputProcessed->setFrameStats ( fullStats ? stats : nullptr );
 		QDateTime now = QDateTime::currentDateTimeUtc();
 		// QString dateStr = now.toString ( Qt::ISODate );
 		QString dateStr = now.toString ( "yyyy-MM-ddThh:mm:ss.zzz" );
@@ -742,7 +792,7 @@ ViewWidget::addImage ( void* args, void* imageData, int length, void* metadata )
     // Do this reduction "in place"
     self->viewPixelFormat = self->reduceTo8Bit ( self->originalBuffer,
 				self->originalBuffer, commonConfig.imageSizeX, commonConfig.imageSizeY,
-				self->viewPixelFormat );
+				self->viewPixelFormat, autoStretch ? stats : nullptr );
   }
   self->viewBuffer = self->originalBuffer;
 
@@ -853,75 +903,69 @@ ViewWidget::restart()
 
 unsigned int
 ViewWidget::reduceTo8Bit ( void* sourceData, void* targetData, int xSize,
-    int ySize, int format )
+    int ySize, int format, const oaFrameStats* stats )
 {
-  int   outputFormat = 0;
-
-  if ( oaFrameFormats[ format ].monochrome ) {
-    outputFormat = OA_PIX_FMT_GREY8;
-  } else {
-    if ( oaFrameFormats[ format ].rawColour &&
-        !oaFrameFormats[ format ].packed ) {
-      switch ( oaFrameFormats[ format ].cfaPattern ) {
-        case OA_DEMOSAIC_RGGB:
-          outputFormat = OA_PIX_FMT_RGGB8;
-          break;
-        case OA_DEMOSAIC_BGGR:
-          outputFormat = OA_PIX_FMT_BGGR8;
-          break;
-        case OA_DEMOSAIC_GRBG:
-          outputFormat = OA_PIX_FMT_GRBG8;
-          break;
-        case OA_DEMOSAIC_GBRG:
-          outputFormat = OA_PIX_FMT_GBRG8;
-          break;
-        case OA_DEMOSAIC_CMYG:
-          outputFormat = OA_PIX_FMT_CMYG8;
-          break;
-        case OA_DEMOSAIC_MCGY:
-          outputFormat = OA_PIX_FMT_MCGY8;
-          break;
-        case OA_DEMOSAIC_YGCM:
-          outputFormat = OA_PIX_FMT_YGCM8;
-          break;
-        case OA_DEMOSAIC_GYMC:
-          outputFormat = OA_PIX_FMT_GYMC8;
-          break;
-      }
-    } else {
-      switch ( format ) {
-        case OA_PIX_FMT_RGB30BE:
-        case OA_PIX_FMT_RGB30LE:
-        case OA_PIX_FMT_RGB36BE:
-        case OA_PIX_FMT_RGB36LE:
-        case OA_PIX_FMT_RGB42BE:
-        case OA_PIX_FMT_RGB42LE:
-        case OA_PIX_FMT_RGB48BE:
-        case OA_PIX_FMT_RGB48LE:
-          outputFormat = OA_PIX_FMT_RGB24;
-          break;
-        case OA_PIX_FMT_BGR48BE:
-        case OA_PIX_FMT_BGR48LE:
-          outputFormat = OA_PIX_FMT_BGR24;
-          break;
-      }
-    }
+  int			outputFormat;
+  int			mode = stretchMode;
+  oaStretchParams	params;
+
+  if ( stretch->params.mode != mode ) {
+    oaStretchDefaultParams ( &params );
+    params.mode = mode;
+    oaStretchSetParams ( stretch, &params );
+  }
+  if ( OA_STRETCH_AUTO == mode && stats && stats->medianValid ) {
+    oaStretchSetStatistics ( stretch, stats->all.median, stats->all.mad );
   }
 
-  if ( outputFormat ) {
-    if ( oaconvert ( sourceData, targetData, xSize, ySize, format,
-        outputFormat ) < 0 ) {
-      qWarning() << "Unable to convert format" << format << "to format" <<
-          outputFormat;
-    }
-  } else {
-      qWarning() << "Can't handle 8-bit reduction of format" << format;
+  // Stretch through a LUT scaled to the bit depth of the format rather
+  // than just dropping the low byte, so 10- and 12-bit frames are visible
+  if (( outputFormat = oaStretchFrame ( stretch, sourceData, targetData,
+      xSize, ySize, format )) < 0 ) {
+    qWarning() << "Can't handle 8-bit reduction of format" << format;
+    return 0;
   }
 
   return outputFormat;
 }
 
 
+/*
+ * Compute the statistics for a frame that the auto stretch and FITS
+ * output share, with the median if it's wanted for the auto stretch and
+ * every pixel counted if it's wanted for the FITS header.  Returns
+ * nullptr for formats the statistics can't be computed for.
+ */
+
+const oaFrameStats*
+ViewWidget::computeFrameStats ( void* data, int format, int median,
+    int fullFrame )
+{
+  oaImage	image;
+  unsigned int	subsample = 1;
+  int		flags = 0;
+
+  if ( !frameStats || oaFrameFormats[ format ].lumChrom ||
+      oaFrameFormats[ format ].packed || oaFrameFormats[ format ].planar ||
+      oaFrameFormats[ format ].hasAlpha ) {
+    return nullptr;
+  }
+  if ( median ) {
+    flags |= OA_STATS_MEDIAN;
+  }
+  if ( !fullFrame ) {
+    subsample = HistogramWidget::statsSubsample ( commonConfig.imageSizeX,
+        commonConfig.imageSizeY );
+  }
+  if ( oaImageInit ( &image, data, commonConfig.imageSizeX,
+      commonConfig.imageSizeY, format ) ||
+      oaFrameStatsCompute ( frameStats, &image, 256, subsample, flags )) {
+    return nullptr;
+  }
+  return frameStats;
+}
+
+
 void
 ViewWidget::setBlackLevel ( int val )
 {
@@ -37,6 +37,8 @@
 
 extern "C" {
 #include <openastro/camera.h>
+#include <openastro/imgproc.h>
+#include <openastro/video/stretch.h>
 }
 
 #include "configuration.h"
@@ -63,6 +65,7 @@ class ViewWidget : public QFrame
     void		setEnabled ( int );
     void		enableScreenUpdates ( int );
     void		setDisplayFPS ( int );
+    void		setDisplayStretch ( int );
     void		setFirstFrameTime ( void );
     void		beginRecording ( void );
     void		forceRecordingStop ( void );
@@ -149,7 +152,12 @@ class ViewWidget : public QFrame
     unsigned int	nextFrame;
 		unsigned int	maxFrames;
 
-    unsigned int	reduceTo8Bit ( void*, void*, int, int, int );
+    unsigned int	reduceTo8Bit ( void*, void*, int, int, int,
+			    const oaFrameStats* );
+    const oaFrameStats*	computeFrameStats ( void*, int, int, int );
+    oaStretch*		stretch;
+    int			stretchMode;
+    oaFrameStats*	frameStats;
     void		mousePressEvent ( QMouseEvent* );
     void		mouseMoveEvent ( QMouseEvent* );
     void		mouseReleaseEvent ( QMouseEvent* );